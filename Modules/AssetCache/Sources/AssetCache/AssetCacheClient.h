@@ -38,12 +38,15 @@ public:
     void DumpStats() const;
 
 private:
+    AssetCache::Error AddChunksSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value);
+    AssetCache::Error AddContentChunksSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value);
     AssetCache::Error WaitRequest();
     AssetCache::Error CheckStatusSynchronously();
     void ProcessNetwork();
 
     //ClientNetProxyListener
     void OnAddedToCache(const AssetCache::CacheItemKey& key, bool added) override;
+    void OnMissingChunksReceived(const AssetCache::CacheItemKey& key, const Vector<uint32>& missingChunks) override;
     void OnReceivedFromCache(const AssetCache::CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) override;
     void OnRemovedFromCache(const AssetCache::CacheItemKey& key, bool removed) override;
     void OnCacheCleared(bool cleared) override;
@@ -119,11 +122,15 @@ private:
             serializedData->Truncate(0);
             chunksSent = 0;
             chunksOverall = 0;
+            missingChunks.clear();
+            completedByChunkList = false;
         }
 
         ScopedPtr<DynamicMemoryFile> serializedData;
         uint32 chunksSent = 0;
         uint32 chunksOverall = 0;
+        Vector<uint32> missingChunks; // indices of content chunks which server doesn't have
+        bool completedByChunkList = false; // server had all chunks and answered chunk list with final status
     };
 
     struct Stats
@@ -138,6 +145,8 @@ private:
         uint32 addRequestsFailedCount = 0;
         uint32 addRequestsTimeoutCount = 0;
         uint32 addRequestsSucceedCount = 0;
+        uint64 addBytesOverall = 0;
+        uint64 addBytesSent = 0;
 
         uint32 incorrectPacketsCount = 0;
     };
@@ -28,9 +28,18 @@ enum ePacketID : uint8
     PACKET_REMOVE_RESPONSE,
     PACKET_CLEAR_REQUEST,
     PACKET_CLEAR_RESPONSE,
+    PACKET_ADD_CHUNK_LIST_REQUEST,
+    PACKET_ADD_CHUNK_LIST_RESPONSE,
     PACKET_COUNT
 };
 
+// Optional features of server, reported by status response
+enum eServerCapabilities : uint32
+{
+    CAPABILITY_CONTENT_CHUNKS = 1 << 0 // server stores values by content chunks and accepts PACKET_ADD_CHUNK_LIST_REQUEST,
+    // it is answered by PACKET_ADD_CHUNK_LIST_RESPONSE with missing chunks or by PACKET_ADD_CHUNK_RESPONSE if no chunks are needed
+};
+
 String PacketToString(ePacketID packet);
 
 enum class Error : int32
@@ -3,6 +3,7 @@
 #include "AssetCache/CacheItemKey.h"
 #include "AssetCache/CachedItemValue.h"
 #include "AssetCache/AssetCacheConstants.h"
+#include "AssetCache/ChunkSplitter.h"
 
 #include <FileSystem/DynamicMemoryFile.h>
 
@@ -99,6 +100,39 @@ public:
     AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
 };
 
+//////////////////////////////////////////////////////////////////////////
+// List of content chunks of serialized value. Server answers with indices of chunks it doesn't have,
+// client sends them with AddChunkRequestPacket where chunkNumber is index in list.
+class AddChunkListRequestPacket : public CachePacket
+{
+public:
+    AddChunkListRequestPacket();
+    AddChunkListRequestPacket(const CacheItemKey& key, uint64 dataSize, const Vector<ChunkSplitter::ContentChunk>& chunks);
+
+protected:
+    bool DeserializeFromBuffer(File* file) override;
+
+public:
+    CacheItemKey key;
+    uint64 dataSize = 0;
+    Vector<ChunkSplitter::ContentChunk> chunks;
+};
+
+//////////////////////////////////////////////////////////////////////////
+class AddChunkListResponsePacket : public CachePacket
+{
+public:
+    AddChunkListResponsePacket();
+    AddChunkListResponsePacket(const CacheItemKey& key, const Vector<uint32>& missingChunks);
+
+protected:
+    bool DeserializeFromBuffer(File* file) override;
+
+public:
+    CacheItemKey key;
+    Vector<uint32> missingChunks;
+};
+
 //////////////////////////////////////////////////////////////////////////
 class AddResponsePacket : public CachePacket
 {
@@ -164,9 +198,13 @@ protected:
 struct StatusResponsePacket : public CachePacket
 {
     StatusResponsePacket();
+    StatusResponsePacket(uint32 capabilities);
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
+
+public:
+    uint32 capabilities = 0; // combination of eServerCapabilities
 };
 
 //////////////////////////////////////////////////////////////////////////
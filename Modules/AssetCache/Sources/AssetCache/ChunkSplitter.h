@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Base/BaseTypes.h>
+#include <Utils/MD5.h>
 
 namespace DAVA
 {
@@ -10,6 +11,19 @@ namespace ChunkSplitter
 {
 uint32 GetNumberOfChunks(uint64 overallSize);
 Vector<uint8> GetChunk(const Vector<uint8>& dataVector, uint32 chunkNumber);
+
+struct ContentChunk
+{
+    MD5::MD5Digest hash;
+    uint32 size = 0;
+};
+
+/**
+    Split data into chunks with boundaries defined by content (gear rolling hash), chunks follow each other without gaps.
+    Modification of several bytes changes only chunks around modified bytes, so values which differ slightly
+    between revisions share most of their chunks.
+*/
+Vector<ContentChunk> SplitByContent(const uint8* data, size_t size);
 }
 } // namespace AssetCache
 } // namespace DAVA
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "AssetCache/ChunkSplitter.h"
+
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+/**
+    Content addressed storage of data chunks. Each chunk is stored once in file named by its hash
+    and is shared between all cache entries which reference it. Chunk file is deleted when last reference is released.
+*/
+class ChunkStorage final
+{
+public:
+    using ContentChunk = ChunkSplitter::ContentChunk;
+
+    void SetFolder(const FilePath& folder);
+    void Clear();
+
+    bool Has(const MD5::MD5Digest& hash) const;
+
+    /**
+        Store chunk if it wasn't stored and add reference. Count of bytes newly occupied on disk is added to `occupiedSize`.
+        Returns false if chunk can't be written, reference isn't added in that case
+    */
+    bool Put(const ContentChunk& chunk, const uint8* data, uint64& occupiedSize);
+
+    /** Release reference to chunk. Returns count of bytes freed on disk */
+    uint64 Release(const ContentChunk& chunk);
+
+    /** Append chunk data to `data`. Returns false if chunk can't be read */
+    bool Read(const ContentChunk& chunk, Vector<uint8>& data) const;
+
+    /** Register references of existing chunk file, used to restore storage state on loading */
+    uint64 Restore(const ContentChunk& chunk);
+
+    /** Count of references to chunk, zero if chunk isn't stored */
+    uint32 GetRefCount(const MD5::MD5Digest& hash) const;
+
+    struct DigestHasher
+    {
+        size_t operator()(const MD5::MD5Digest& digest) const;
+    };
+
+private:
+    struct ChunkInfo
+    {
+        uint32 size = 0;
+        uint32 refCount = 0;
+    };
+
+    FilePath CreateChunkPath(const MD5::MD5Digest& hash) const;
+
+    FilePath folder;
+    UnorderedMap<MD5::MD5Digest, ChunkInfo, DigestHasher> chunks;
+};
+} // namespace AssetCache
+} // namespace DAVA
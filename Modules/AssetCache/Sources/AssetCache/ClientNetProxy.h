@@ -2,6 +2,7 @@
 
 #include "AssetCache/Connection.h"
 #include "AssetCache/CacheItemKey.h"
+#include "AssetCache/ChunkSplitter.h"
 
 #include <Base/BaseTypes.h>
 #include <Network/IChannel.h>
@@ -27,6 +28,7 @@ public:
 
     virtual void OnClientProxyStateChanged(){};
     virtual void OnAddedToCache(const CacheItemKey& key, bool added){};
+    virtual void OnMissingChunksReceived(const CacheItemKey& key, const Vector<uint32>& missingChunks){};
     virtual void OnReceivedFromCache(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData){};
     virtual void OnRemovedFromCache(const CacheItemKey& key, bool removed){};
     virtual void OnCacheCleared(bool cleared){};
@@ -48,10 +50,12 @@ public:
     void DisconnectBlocked();
 
     bool ChannelIsOpened() const;
+    uint32 GetServerCapabilities() const;
 
     // requests to sent on server
     bool RequestServerStatus();
     bool RequestAddNextChunk(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    bool RequestAddChunkList(const CacheItemKey& key, uint64 dataSize, const Vector<ChunkSplitter::ContentChunk>& chunks);
     bool RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber);
     bool RequestWarmingUp(const CacheItemKey& key);
     bool RequestRemoveData(const CacheItemKey& key);
@@ -80,6 +84,7 @@ private:
     std::shared_ptr<Net::AddressResolver> addressResolver;
     std::shared_ptr<Connection> netClient;
     std::shared_ptr<Net::IChannel> openedChannel;
+    uint32 serverCapabilities = 0;
 
     Set<ClientNetProxyListener*> listeners;
 };
@@ -89,6 +94,11 @@ inline bool ClientNetProxy::ChannelIsOpened() const
     return (openedChannel != nullptr);
 }
 
+inline uint32 ClientNetProxy::GetServerCapabilities() const
+{
+    return serverCapabilities;
+}
+
 inline Connection* ClientNetProxy::GetConnection() const
 {
     return netClient.get();
@@ -98,6 +98,32 @@ AssetCache::Error AssetCacheClient::CheckStatusSynchronously()
 }
 
 AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value)
+{
+    AssetCache::Error resultCode = ((client.GetServerCapabilities() & AssetCache::CAPABILITY_CONTENT_CHUNKS) != 0) ?
+    AddContentChunksSynchronously(key, value) :
+    AddChunksSynchronously(key, value);
+
+    { //process stats
+        ++stats.addRequestsCount;
+        switch (resultCode)
+        {
+        case AssetCache::Error::NO_ERRORS:
+            ++stats.addRequestsSucceedCount;
+            break;
+        case AssetCache::Error::OPERATION_TIMEOUT:
+            ++stats.addRequestsTimeoutCount;
+            break;
+
+        default:
+            ++stats.addRequestsFailedCount;
+            break;
+        }
+    }
+
+    return resultCode;
+}
+
+AssetCache::Error AssetCacheClient::AddChunksSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value)
 {
     uint64 dataSizeOverall = 0;
     uint32 chunksOverall = 0;
@@ -141,23 +167,107 @@ AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::Ca
         }
     }
 
-    { //process stats
-        ++stats.addRequestsCount;
-        switch (resultCode)
+    stats.addBytesOverall += dataSizeOverall;
+    stats.addBytesSent += dataSizeOverall;
+
+    return resultCode;
+}
+
+AssetCache::Error AssetCacheClient::AddContentChunksSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value)
+{
+    uint64 dataSizeOverall = 0;
+    Vector<AssetCache::ChunkSplitter::ContentChunk> chunks;
+    {
+        LockGuard<Mutex> guard(requestLocker);
+        request = Request(AssetCache::PACKET_ADD_CHUNK_LIST_REQUEST, key);
+        addFilesRequest.Reset();
+        value.Serialize(addFilesRequest.serializedData);
+
+        const Vector<uint8>& data = addFilesRequest.serializedData->GetDataVector();
+        dataSizeOverall = data.size();
+        chunks = AssetCache::ChunkSplitter::SplitByContent(data.data(), data.size());
+    }
+
+    // Send list of chunks and wait for indices of chunks that are absent on server
+    AssetCache::Error resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+    bool requestSent = client.RequestAddChunkList(key, dataSizeOverall, chunks);
+    if (requestSent)
+    {
+        resultCode = WaitRequest();
+    }
+
+    Vector<uint32> missingChunks;
+    bool completed = false;
+    {
+        // request is switched to chunks without gap, so no response can be lost between two states
+        LockGuard<Mutex> guard(requestLocker);
+        missingChunks.swap(addFilesRequest.missingChunks);
+        completed = addFilesRequest.completedByChunkList;
+        if (resultCode == AssetCache::Error::NO_ERRORS && completed == false)
         {
-        case AssetCache::Error::NO_ERRORS:
-            ++stats.addRequestsSucceedCount;
-            break;
-        case AssetCache::Error::OPERATION_TIMEOUT:
-            ++stats.addRequestsTimeoutCount;
+            request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
+        }
+        else
+        {
+            request.Reset();
+        }
+    }
+
+    if (resultCode != AssetCache::Error::NO_ERRORS)
+    {
+        return resultCode;
+    }
+
+    if (completed)
+    {
+        Logger::FrameworkDebug("Added to cache by content chunks: all %llu bytes were already on server", dataSizeOverall);
+        stats.addBytesOverall += dataSizeOverall;
+        return resultCode;
+    }
+
+    Vector<uint64> chunkOffsets(chunks.size(), 0);
+    for (size_t i = 1; i < chunks.size(); ++i)
+    {
+        chunkOffsets[i] = chunkOffsets[i - 1] + chunks[i - 1].size;
+    }
+
+    // Missing chunks are sent one after another, server confirms whole value once
+    uint64 bytesSent = 0;
+    const uint32 chunksOverall = static_cast<uint32>(chunks.size());
+    const Vector<uint8>& data = addFilesRequest.serializedData->GetDataVector();
+    for (uint32 chunkIndex : missingChunks)
+    {
+        if (chunkIndex >= chunksOverall)
+        {
+            Logger::Error("Server requested wrong chunk #%u, overall %u chunks", chunkIndex, chunksOverall);
+            resultCode = AssetCache::Error::WRONG_CHUNK;
             break;
+        }
 
-        default:
-            ++stats.addRequestsFailedCount;
+        Vector<uint8>::const_iterator chunkBegin = data.begin() + static_cast<size_t>(chunkOffsets[chunkIndex]);
+        Vector<uint8> chunkData(chunkBegin, chunkBegin + chunks[chunkIndex].size);
+        if (client.RequestAddNextChunk(key, dataSizeOverall, chunksOverall, chunkIndex, chunkData) == false)
+        {
+            resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
             break;
         }
+        bytesSent += chunkData.size();
+    }
+
+    if (resultCode == AssetCache::Error::NO_ERRORS)
+    {
+        resultCode = WaitRequest();
     }
 
+    {
+        LockGuard<Mutex> guard(requestLocker);
+        request.Reset();
+    }
+
+    Logger::FrameworkDebug("Added to cache by content chunks: %llu of %llu bytes were sent", bytesSent, dataSizeOverall);
+    stats.addBytesOverall += dataSizeOverall;
+    stats.addBytesSent += bytesSent;
+
     return resultCode;
 }
 
@@ -379,6 +489,31 @@ void AssetCacheClient::OnAddedToCache(const AssetCache::CacheItemKey& key, bool
         request.recieved = true;
         request.processingRequest = false;
     }
+    else if ((request.requestID == AssetCache::PACKET_ADD_CHUNK_LIST_REQUEST) && request.key == key)
+    {
+        // server has all chunks of value and added it, or rejected chunk list
+        addFilesRequest.completedByChunkList = true;
+        request.result = (added) ? AssetCache::Error::NO_ERRORS : AssetCache::Error::SERVER_ERROR;
+        request.recieved = true;
+        request.processingRequest = false;
+    }
+    else
+    {
+        //skip this request, because it was canceled by timeout
+    }
+}
+
+void AssetCacheClient::OnMissingChunksReceived(const AssetCache::CacheItemKey& key, const Vector<uint32>& missingChunks)
+{
+    LockGuard<Mutex> guard(requestLocker);
+
+    if ((request.requestID == AssetCache::PACKET_ADD_CHUNK_LIST_REQUEST) && request.key == key)
+    {
+        addFilesRequest.missingChunks = missingChunks;
+        request.result = AssetCache::Error::NO_ERRORS;
+        request.recieved = true;
+        request.processingRequest = false;
+    }
     else
     {
         //skip this request, because it was canceled by timeout
@@ -562,6 +697,8 @@ void AssetCacheClient::DumpStats() const
                 Logger::Info("  timeout: %d", stats.addRequestsTimeoutCount);
             if (stats.addRequestsFailedCount > 0)
                 Logger::Info("  failed: %d", stats.addRequestsFailedCount);
+            if (stats.addBytesOverall > 0)
+                Logger::Info("  sent: %llu of %llu bytes", stats.addBytesSent, stats.addBytesOverall);
 
             DVASSERT(stats.addRequestsCount == (stats.addRequestsFailedCount + stats.addRequestsTimeoutCount + stats.addRequestsSucceedCount));
         }
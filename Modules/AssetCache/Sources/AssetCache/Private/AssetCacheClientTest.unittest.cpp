@@ -0,0 +1,143 @@
+#include "AssetCache/AssetCache.h"
+#include "AssetCache/AssetCacheClient.h"
+#include "AssetCache/ChunkStorage.h"
+
+#include <FileSystem/FileSystem.h>
+#include <Network/NetCore.h>
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace AssetCacheClientTestDetails
+{
+/** Server which stores values by content chunks the same way as AssetCacheServer does */
+class ChunkServer final : public AssetCache::ServerNetProxyListener
+{
+public:
+    ChunkServer(const FilePath& folder)
+        : proxy(Net::NetCore::Instance()->GetNetEventsDispatcher())
+    {
+        storage.SetFolder(folder);
+        proxy.SetListener(this);
+        proxy.Listen(AssetCache::ASSET_SERVER_PORT);
+    }
+
+    ~ChunkServer()
+    {
+        proxy.SetListener(nullptr);
+        proxy.Disconnect();
+    }
+
+    void OnStatusRequested(const std::shared_ptr<Net::IChannel>& channel) override
+    {
+        proxy.SendStatus(channel, AssetCache::CAPABILITY_CONTENT_CHUNKS);
+    }
+
+    void OnAddChunkListToCache(const std::shared_ptr<Net::IChannel>& channel, const AssetCache::CacheItemKey& key, uint64 dataSize, const Vector<AssetCache::ChunkSplitter::ContentChunk>& chunks) override
+    {
+        pendingChunks = chunks;
+        Vector<uint32> missingChunks;
+        for (uint32 i = 0; i < static_cast<uint32>(chunks.size()); ++i)
+        {
+            if (storage.Has(chunks[i].hash) == false)
+            {
+                missingChunks.push_back(i);
+            }
+        }
+
+        if (missingChunks.empty())
+        {
+            ++addedWithoutChunksCount;
+            proxy.SendAddedToCache(channel, key, true);
+        }
+        else
+        {
+            pendingChunksCount = static_cast<uint32>(missingChunks.size());
+            proxy.SendMissingChunks(channel, key, missingChunks);
+        }
+    }
+
+    void OnAddChunkToCache(const std::shared_ptr<Net::IChannel>& channel, const AssetCache::CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) override
+    {
+        ++receivedChunksCount;
+
+        uint64 occupiedSize = 0;
+        bool stored = chunkNumber < pendingChunks.size() && storage.Put(pendingChunks[chunkNumber], chunkData.data(), occupiedSize);
+        if (stored == false || --pendingChunksCount == 0)
+        {
+            proxy.SendAddedToCache(channel, key, stored);
+        }
+    }
+
+    void OnChunkRequestedFromCache(const std::shared_ptr<Net::IChannel>& channel, const AssetCache::CacheItemKey& key, uint32 chunkNumber) override
+    {
+    }
+    void OnRemoveFromCache(const std::shared_ptr<Net::IChannel>& channel, const AssetCache::CacheItemKey& key) override
+    {
+    }
+    void OnClearCache(const std::shared_ptr<Net::IChannel>& channel) override
+    {
+    }
+    void OnWarmingUp(const std::shared_ptr<Net::IChannel>& channel, const AssetCache::CacheItemKey& key) override
+    {
+    }
+
+    uint32 receivedChunksCount = 0;
+    uint32 addedWithoutChunksCount = 0;
+
+private:
+    AssetCache::ServerNetProxy proxy;
+    AssetCache::ChunkStorage storage;
+    Vector<AssetCache::ChunkSplitter::ContentChunk> pendingChunks;
+    uint32 pendingChunksCount = 0;
+};
+}
+
+DAVA_TESTCLASS (AssetCacheClientTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("AssetCacheClient.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    const FilePath storageFolder = "~doc:/AssetCacheClientTest/";
+
+    DAVA_TEST (AddStoredValueTest)
+    {
+        using namespace AssetCache;
+
+        FileSystem::Instance()->DeleteDirectory(storageFolder);
+        AssetCacheClientTestDetails::ChunkServer server(storageFolder);
+
+        CacheItemKey key;
+        key.fill(0x42);
+
+        std::shared_ptr<Vector<uint8>> data = std::make_shared<Vector<uint8>>(512 * 1024);
+        for (size_t i = 0; i < data->size(); ++i)
+        {
+            (*data)[i] = static_cast<uint8>((i * 7919) >> 5);
+        }
+        CachedItemValue value;
+        value.Add("data.bin", data);
+        value.UpdateValidationData();
+
+        AssetCacheClient client;
+        AssetCacheClient::ConnectionParams params;
+        params.timeoutms = 10 * 1000;
+        TEST_VERIFY(client.ConnectSynchronously(params) == Error::NO_ERRORS);
+
+        TEST_VERIFY(client.AddToCacheSynchronously(key, value) == Error::NO_ERRORS);
+        const uint32 chunksCount = server.receivedChunksCount;
+        TEST_VERIFY(chunksCount > 0);
+        TEST_VERIFY(server.addedWithoutChunksCount == 0);
+
+        // all chunks are on server, so value is confirmed right after chunk list
+        TEST_VERIFY(client.AddToCacheSynchronously(key, value) == Error::NO_ERRORS);
+        TEST_VERIFY(server.receivedChunksCount == chunksCount);
+        TEST_VERIFY(server.addedWithoutChunksCount == 1);
+
+        client.Disconnect();
+        FileSystem::Instance()->DeleteDirectory(storageFolder);
+    }
+};
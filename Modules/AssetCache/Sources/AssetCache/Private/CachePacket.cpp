@@ -128,6 +128,10 @@ std::unique_ptr<CachePacket> CachePacket::CreateByType(ePacketID type)
         return std::unique_ptr<CachePacket>(new ClearRequestPacket());
     case PACKET_CLEAR_RESPONSE:
         return std::unique_ptr<CachePacket>(new ClearResponsePacket());
+    case PACKET_ADD_CHUNK_LIST_REQUEST:
+        return std::unique_ptr<CachePacket>(new AddChunkListRequestPacket());
+    case PACKET_ADD_CHUNK_LIST_RESPONSE:
+        return std::unique_ptr<CachePacket>(new AddChunkListResponsePacket());
     default:
     {
         Logger::Error("[CachePacket::%s] Wrong packet type: %d", __FUNCTION__, type);
@@ -203,6 +207,100 @@ AddChunkRequestPacket::AddChunkRequestPacket()
 {
 }
 
+//////////////////////////////////////////////////////////////////////////
+AddChunkListRequestPacket::AddChunkListRequestPacket(const CacheItemKey& key_, uint64 dataSize_, const Vector<ChunkSplitter::ContentChunk>& chunks_)
+    : CachePacket(PACKET_ADD_CHUNK_LIST_REQUEST, CREATE_SENDING_BUFFER)
+{
+    WriteHeader(serializationBuffer);
+
+    uint32 chunksCount = static_cast<uint32>(chunks_.size());
+
+    serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
+    serializationBuffer->Write(&dataSize_, sizeof(dataSize_));
+    serializationBuffer->Write(&chunksCount, sizeof(chunksCount));
+    for (const ChunkSplitter::ContentChunk& chunk : chunks_)
+    {
+        serializationBuffer->Write(chunk.hash.digest.data(), MD5::MD5Digest::DIGEST_SIZE);
+        serializationBuffer->Write(&chunk.size, sizeof(chunk.size));
+    }
+}
+
+AddChunkListRequestPacket::AddChunkListRequestPacket()
+    : CachePacket(PACKET_ADD_CHUNK_LIST_REQUEST, DO_NOT_CREATE_SENDING_BUFFER)
+{
+}
+
+bool AddChunkListRequestPacket::DeserializeFromBuffer(File* buffer)
+{
+    using namespace CachePacketDetails;
+
+    uint32 chunksCount = 0;
+    if (!ReadFromBuffer(buffer, key) || !ReadFromBuffer(buffer, dataSize) || !ReadFromBuffer(buffer, chunksCount))
+    {
+        return false;
+    }
+
+    // count comes from network, so it is validated against received data before allocation
+    const uint64 chunkEntrySize = MD5::MD5Digest::DIGEST_SIZE + sizeof(uint32);
+    if (static_cast<uint64>(chunksCount) * chunkEntrySize > buffer->GetSize() - buffer->GetPos())
+    {
+        Logger::Error("[AddChunkListRequestPacket::%s] Wrong chunks count %u", __FUNCTION__, chunksCount);
+        return false;
+    }
+
+    chunks.resize(chunksCount);
+    for (ChunkSplitter::ContentChunk& chunk : chunks)
+    {
+        if (!ReadFromBuffer(buffer, chunk.hash.digest) || !ReadFromBuffer(buffer, chunk.size))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+AddChunkListResponsePacket::AddChunkListResponsePacket(const CacheItemKey& key_, const Vector<uint32>& missingChunks_)
+    : CachePacket(PACKET_ADD_CHUNK_LIST_RESPONSE, CREATE_SENDING_BUFFER)
+{
+    WriteHeader(serializationBuffer);
+
+    uint32 missingCount = static_cast<uint32>(missingChunks_.size());
+
+    serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
+    serializationBuffer->Write(&missingCount, sizeof(missingCount));
+    if (missingCount > 0)
+    {
+        serializationBuffer->Write(missingChunks_.data(), missingCount * sizeof(uint32));
+    }
+}
+
+AddChunkListResponsePacket::AddChunkListResponsePacket()
+    : CachePacket(PACKET_ADD_CHUNK_LIST_RESPONSE, DO_NOT_CREATE_SENDING_BUFFER)
+{
+}
+
+bool AddChunkListResponsePacket::DeserializeFromBuffer(File* buffer)
+{
+    using namespace CachePacketDetails;
+
+    uint32 missingCount = 0;
+    if (!ReadFromBuffer(buffer, key) || !ReadFromBuffer(buffer, missingCount))
+    {
+        return false;
+    }
+
+    const uint64 missingSize = static_cast<uint64>(missingCount) * sizeof(uint32);
+    if (missingSize > buffer->GetSize() - buffer->GetPos())
+    {
+        Logger::Error("[AddChunkListResponsePacket::%s] Wrong missing chunks count %u", __FUNCTION__, missingCount);
+        return false;
+    }
+
+    missingChunks.resize(missingCount);
+    return (missingCount == 0) || (buffer->Read(missingChunks.data(), static_cast<uint32>(missingSize)) == missingSize);
+}
+
 //////////////////////////////////////////////////////////////////////////
 AddResponsePacket::AddResponsePacket(const CacheItemKey& key_, bool added_)
     : CachePacket(PACKET_ADD_RESPONSE, CREATE_SENDING_BUFFER)
@@ -295,8 +393,20 @@ StatusResponsePacket::StatusResponsePacket()
     WriteHeader(serializationBuffer);
 }
 
+StatusResponsePacket::StatusResponsePacket(uint32 capabilities_)
+    : CachePacket(PACKET_STATUS_RESPONSE, CREATE_SENDING_BUFFER)
+{
+    WriteHeader(serializationBuffer);
+    serializationBuffer->Write(&capabilities_, sizeof(capabilities_));
+}
+
 bool StatusResponsePacket::DeserializeFromBuffer(File* file)
 {
+    // capabilities are absent in responses of older servers
+    if (file->GetPos() < file->GetSize())
+    {
+        return (file->Read(&capabilities) == sizeof(capabilities));
+    }
     return true;
 }
 
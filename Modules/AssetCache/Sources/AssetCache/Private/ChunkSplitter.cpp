@@ -8,6 +8,61 @@ namespace ChunkSplitter
 {
 const uint32 CHUNK_SIZE_IN_BYTES = 5 * 1024 * 1024;
 
+const size_t CONTENT_CHUNK_MIN_SIZE = 16 * 1024;
+const size_t CONTENT_CHUNK_MAX_SIZE = 256 * 1024;
+// high bits of gear hash depend on last 64 bytes, 16 bits give 64Kb average distance between boundaries
+const uint64 CONTENT_CHUNK_BOUNDARY_MASK = 0xFFFFull << 48;
+
+namespace ChunkSplitterDetails
+{
+// Table should be the same on all machines, so it is generated by splitmix64 from fixed seed
+const Array<uint64, 256>& GetGearTable()
+{
+    static const Array<uint64, 256> table = []() {
+        Array<uint64, 256> result;
+        uint64 state = 0xACCA;
+        for (uint64& value : result)
+        {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64 z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            value = z ^ (z >> 31);
+        }
+        return result;
+    }();
+    return table;
+}
+
+size_t FindChunkEnd(const uint8* data, size_t size)
+{
+    if (size <= CONTENT_CHUNK_MIN_SIZE)
+    {
+        return size;
+    }
+
+    const Array<uint64, 256>& gear = GetGearTable();
+    const size_t maxSize = std::min(size, CONTENT_CHUNK_MAX_SIZE);
+
+    uint64 hash = 0;
+    for (size_t i = CONTENT_CHUNK_MIN_SIZE - 64; i < CONTENT_CHUNK_MIN_SIZE; ++i)
+    { // warm up hash window, so boundary doesn't depend on data before minimal chunk size
+        hash = (hash << 1) + gear[data[i]];
+    }
+
+    for (size_t i = CONTENT_CHUNK_MIN_SIZE; i < maxSize; ++i)
+    {
+        hash = (hash << 1) + gear[data[i]];
+        if ((hash & CONTENT_CHUNK_BOUNDARY_MASK) == 0)
+        {
+            return i + 1;
+        }
+    }
+
+    return maxSize;
+}
+}
+
 uint32 GetNumberOfChunks(uint64 overallSize)
 {
     return static_cast<uint32>((overallSize + CHUNK_SIZE_IN_BYTES - 1) / CHUNK_SIZE_IN_BYTES);
@@ -26,6 +81,27 @@ Vector<uint8> GetChunk(const Vector<uint8>& dataVector, uint32 chunkNumber)
         return Vector<uint8>();
     }
 }
+
+Vector<ContentChunk> SplitByContent(const uint8* data, size_t size)
+{
+    Vector<ContentChunk> chunks;
+    chunks.reserve(size / CONTENT_CHUNK_MIN_SIZE + 1);
+
+    size_t offset = 0;
+    while (offset < size)
+    {
+        size_t chunkSize = ChunkSplitterDetails::FindChunkEnd(data + offset, size - offset);
+
+        ContentChunk chunk;
+        chunk.size = static_cast<uint32>(chunkSize);
+        MD5::ForData(data + offset, chunk.size, chunk.hash);
+        chunks.push_back(chunk);
+
+        offset += chunkSize;
+    }
+
+    return chunks;
+}
 }
 } // namespace AssetCache
 } // namespace DAVA
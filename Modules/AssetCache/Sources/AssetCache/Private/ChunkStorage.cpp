@@ -0,0 +1,148 @@
+#include "AssetCache/ChunkStorage.h"
+
+#include <Base/ScopedPtr.h>
+#include <Debug/DVAssert.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+size_t ChunkStorage::DigestHasher::operator()(const MD5::MD5Digest& digest) const
+{
+    // digest bytes are uniformly distributed, so first bytes are enough for hashing
+    size_t hash = 0;
+    Memcpy(&hash, digest.digest.data(), sizeof(hash));
+    return hash;
+}
+
+void ChunkStorage::SetFolder(const FilePath& folder_)
+{
+    DVASSERT(chunks.empty());
+
+    folder = folder_;
+    folder.MakeDirectoryPathname();
+}
+
+void ChunkStorage::Clear()
+{
+    chunks.clear();
+}
+
+bool ChunkStorage::Has(const MD5::MD5Digest& hash) const
+{
+    return chunks.count(hash) != 0;
+}
+
+bool ChunkStorage::Put(const ContentChunk& chunk, const uint8* data, uint64& occupiedSize)
+{
+    auto found = chunks.find(chunk.hash);
+    if (found != chunks.end())
+    {
+        DVASSERT(found->second.size == chunk.size);
+        ++found->second.refCount;
+        return true;
+    }
+
+    FilePath chunkPath = CreateChunkPath(chunk.hash);
+    FileSystem::Instance()->CreateDirectory(chunkPath.GetDirectory(), true);
+
+    bool written = false;
+    {
+        ScopedPtr<File> file(File::Create(chunkPath, File::CREATE | File::WRITE));
+        written = file && file->Write(data, chunk.size) == chunk.size;
+    }
+
+    if (written == false)
+    {
+        Logger::Error("[ChunkStorage::%s] Cannot write chunk %s", __FUNCTION__, chunkPath.GetStringValue().c_str());
+        FileSystem::Instance()->DeleteFile(chunkPath);
+        return false;
+    }
+
+    ChunkInfo& info = chunks[chunk.hash];
+    info.size = chunk.size;
+    info.refCount = 1;
+    occupiedSize += chunk.size;
+    return true;
+}
+
+uint64 ChunkStorage::Release(const ContentChunk& chunk)
+{
+    auto found = chunks.find(chunk.hash);
+    if (found == chunks.end())
+    {
+        return 0;
+    }
+
+    DVASSERT(found->second.refCount > 0);
+    if (--found->second.refCount > 0)
+    {
+        return 0;
+    }
+
+    uint64 freedSize = found->second.size;
+    chunks.erase(found);
+    FileSystem::Instance()->DeleteFile(CreateChunkPath(chunk.hash));
+    return freedSize;
+}
+
+bool ChunkStorage::Read(const ContentChunk& chunk, Vector<uint8>& data) const
+{
+    if (Has(chunk.hash) == false)
+    {
+        return false;
+    }
+
+    ScopedPtr<File> file(File::Create(CreateChunkPath(chunk.hash), File::OPEN | File::READ));
+    if (!file || file->GetSize() != chunk.size)
+    {
+        return false;
+    }
+
+    size_t offset = data.size();
+    data.resize(offset + chunk.size);
+    if (file->Read(data.data() + offset, chunk.size) != chunk.size)
+    {
+        data.resize(offset);
+        return false;
+    }
+
+    return true;
+}
+
+uint64 ChunkStorage::Restore(const ContentChunk& chunk)
+{
+    auto found = chunks.find(chunk.hash);
+    if (found != chunks.end())
+    {
+        ++found->second.refCount;
+        return 0;
+    }
+
+    if (FileSystem::Instance()->IsFile(CreateChunkPath(chunk.hash)) == false)
+    {
+        return 0;
+    }
+
+    ChunkInfo& info = chunks[chunk.hash];
+    info.size = chunk.size;
+    info.refCount = 1;
+    return chunk.size;
+}
+
+uint32 ChunkStorage::GetRefCount(const MD5::MD5Digest& hash) const
+{
+    auto found = chunks.find(hash);
+    return found != chunks.end() ? found->second.refCount : 0;
+}
+
+FilePath ChunkStorage::CreateChunkPath(const MD5::MD5Digest& hash) const
+{
+    String hashString = MD5::HashToString(hash);
+    return folder + (hashString.substr(0, 2) + "/" + hashString.substr(2));
+}
+} // namespace AssetCache
+} // namespace DAVA
@@ -0,0 +1,183 @@
+#include "AssetCache/ChunkSplitter.h"
+#include "AssetCache/ChunkStorage.h"
+
+#include <Base/ScopedPtr.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace ChunkStorageTestDetails
+{
+Vector<uint8> GenerateData(size_t size, uint32 seed)
+{
+    Vector<uint8> data(size);
+    uint32 state = seed;
+    for (uint8& value : data)
+    {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<uint8>(state >> 24);
+    }
+    return data;
+}
+
+Set<String> GetChunkHashes(const Vector<AssetCache::ChunkSplitter::ContentChunk>& chunks)
+{
+    Set<String> hashes;
+    for (const AssetCache::ChunkSplitter::ContentChunk& chunk : chunks)
+    {
+        hashes.insert(MD5::HashToString(chunk.hash));
+    }
+    return hashes;
+}
+}
+
+DAVA_TESTCLASS (ChunkStorageTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("ChunkSplitter.cpp")
+    DECLARE_COVERED_FILES("ChunkStorage.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    const FilePath storageFolder = "~doc:/ChunkStorageTest/";
+
+    ChunkStorageTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(storageFolder);
+        FileSystem::Instance()->CreateDirectory(storageFolder, true);
+    }
+
+    ~ChunkStorageTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(storageFolder);
+    }
+
+    DAVA_TEST (SplitByContentTest)
+    {
+        using namespace AssetCache;
+
+        const Vector<uint8> data = ChunkStorageTestDetails::GenerateData(4 * 1024 * 1024, 1);
+        Vector<ChunkSplitter::ContentChunk> chunks = ChunkSplitter::SplitByContent(data.data(), data.size());
+        TEST_VERIFY(chunks.size() > 1);
+
+        // chunks cover whole data without gaps and hashes match content
+        size_t offset = 0;
+        for (const ChunkSplitter::ContentChunk& chunk : chunks)
+        {
+            MD5::MD5Digest hash;
+            MD5::ForData(data.data() + offset, chunk.size, hash);
+            TEST_VERIFY(hash == chunk.hash);
+            offset += chunk.size;
+        }
+        TEST_VERIFY(offset == data.size());
+
+        // bytes inserted into the middle change only chunks around them
+        Vector<uint8> modified = data;
+        const Vector<uint8> inserted = ChunkStorageTestDetails::GenerateData(100, 2);
+        modified.insert(modified.begin() + modified.size() / 2, inserted.begin(), inserted.end());
+        Vector<ChunkSplitter::ContentChunk> modifiedChunks = ChunkSplitter::SplitByContent(modified.data(), modified.size());
+
+        Set<String> hashes = ChunkStorageTestDetails::GetChunkHashes(chunks);
+        Set<String> modifiedHashes = ChunkStorageTestDetails::GetChunkHashes(modifiedChunks);
+        size_t sharedCount = 0;
+        for (const String& hash : modifiedHashes)
+        {
+            sharedCount += hashes.count(hash);
+        }
+        TEST_VERIFY(sharedCount + 2 >= chunks.size());
+    }
+
+    DAVA_TEST (DeduplicationTest)
+    {
+        using namespace AssetCache;
+
+        const Vector<uint8> data = ChunkStorageTestDetails::GenerateData(1024, 3);
+        ChunkSplitter::ContentChunk chunk;
+        chunk.size = static_cast<uint32>(data.size());
+        MD5::ForData(data.data(), chunk.size, chunk.hash);
+
+        ChunkStorage storage;
+        storage.SetFolder(storageFolder + "dedup/");
+        TEST_VERIFY(storage.Has(chunk.hash) == false);
+
+        // same chunk is stored once and referenced twice
+        uint64 occupiedSize = 0;
+        TEST_VERIFY(storage.Put(chunk, data.data(), occupiedSize));
+        TEST_VERIFY(occupiedSize == data.size());
+        TEST_VERIFY(storage.Put(chunk, data.data(), occupiedSize));
+        TEST_VERIFY(occupiedSize == data.size());
+        TEST_VERIFY(storage.GetRefCount(chunk.hash) == 2);
+
+        Vector<uint8> readData;
+        TEST_VERIFY(storage.Read(chunk, readData));
+        TEST_VERIFY(readData == data);
+
+        // chunk file is deleted with last reference only
+        TEST_VERIFY(storage.Release(chunk) == 0);
+        TEST_VERIFY(storage.Has(chunk.hash));
+        readData.clear();
+        TEST_VERIFY(storage.Read(chunk, readData));
+
+        TEST_VERIFY(storage.Release(chunk) == data.size());
+        TEST_VERIFY(storage.Has(chunk.hash) == false);
+        TEST_VERIFY(storage.GetRefCount(chunk.hash) == 0);
+        readData.clear();
+        TEST_VERIFY(storage.Read(chunk, readData) == false);
+        TEST_VERIFY(readData.empty());
+        TEST_VERIFY(storage.Release(chunk) == 0);
+    }
+
+    DAVA_TEST (RestoreTest)
+    {
+        using namespace AssetCache;
+
+        const Vector<uint8> data = ChunkStorageTestDetails::GenerateData(2048, 4);
+        ChunkSplitter::ContentChunk chunk;
+        chunk.size = static_cast<uint32>(data.size());
+        MD5::ForData(data.data(), chunk.size, chunk.hash);
+
+        const FilePath folder = storageFolder + "restore/";
+        {
+            ChunkStorage storage;
+            storage.SetFolder(folder);
+            uint64 occupiedSize = 0;
+            TEST_VERIFY(storage.Put(chunk, data.data(), occupiedSize));
+        }
+
+        // references of entries loaded from database are restored, chunk is counted once
+        ChunkStorage storage;
+        storage.SetFolder(folder);
+        TEST_VERIFY(storage.Restore(chunk) == data.size());
+        TEST_VERIFY(storage.Restore(chunk) == 0);
+        TEST_VERIFY(storage.GetRefCount(chunk.hash) == 2);
+        TEST_VERIFY(storage.Release(chunk) == 0);
+        TEST_VERIFY(storage.Release(chunk) == data.size());
+    }
+
+    DAVA_TEST (WriteFailureTest)
+    {
+        using namespace AssetCache;
+
+        const Vector<uint8> data = ChunkStorageTestDetails::GenerateData(512, 5);
+        ChunkSplitter::ContentChunk chunk;
+        chunk.size = static_cast<uint32>(data.size());
+        MD5::ForData(data.data(), chunk.size, chunk.hash);
+
+        // storage folder is occupied by file, so chunk can't be written
+        const FilePath blocker = storageFolder + "blocker";
+        {
+            ScopedPtr<File> file(File::Create(blocker, File::CREATE | File::WRITE));
+            TEST_VERIFY(file);
+        }
+
+        ChunkStorage storage;
+        storage.SetFolder(blocker);
+        uint64 occupiedSize = 0;
+        TEST_VERIFY(storage.Put(chunk, data.data(), occupiedSize) == false);
+        TEST_VERIFY(occupiedSize == 0);
+        TEST_VERIFY(storage.Has(chunk.hash) == false);
+    }
+};
@@ -108,6 +108,17 @@ bool ClientNetProxy::RequestAddNextChunk(const CacheItemKey& key, uint64 dataSiz
     return false;
 }
 
+bool ClientNetProxy::RequestAddChunkList(const CacheItemKey& key, uint64 dataSize, const Vector<ChunkSplitter::ContentChunk>& chunks)
+{
+    if (openedChannel)
+    {
+        AddChunkListRequestPacket packet(key, dataSize, chunks);
+        return packet.SendTo(openedChannel);
+    }
+
+    return false;
+}
+
 bool ClientNetProxy::RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber)
 {
     //Logger::FrameworkDebug("Requesting chunk #%u", chunkNumber);
@@ -169,6 +180,7 @@ void ClientNetProxy::OnChannelClosed(const std::shared_ptr<DAVA::Net::IChannel>&
     Logger::FrameworkDebug("Connection closed");
     DVASSERT(openedChannel == channel);
     openedChannel = nullptr;
+    serverCapabilities = 0;
     StateChanged();
 }
 
@@ -217,8 +229,16 @@ void ClientNetProxy::OnPacketReceived(const std::shared_ptr<DAVA::Net::IChannel>
                     listener->OnReceivedFromCache(p->key, p->dataSize, p->numOfChunks, p->chunkNumber, p->chunkData);
                 return;
             }
+            case PACKET_ADD_CHUNK_LIST_RESPONSE:
+            {
+                AddChunkListResponsePacket* p = static_cast<AddChunkListResponsePacket*>(packet.get());
+                for (ClientNetProxyListener* listener : listeners)
+                    listener->OnMissingChunksReceived(p->key, p->missingChunks);
+                return;
+            }
             case PACKET_STATUS_RESPONSE:
             {
+                serverCapabilities = static_cast<StatusResponsePacket*>(packet.get())->capabilities;
                 //Logger::FrameworkDebug("Response is received: server status is OK");
                 for (ClientNetProxyListener* listener : listeners)
                     listener->OnServerStatusReceived();
@@ -61,6 +61,12 @@ void ServerNetProxy::OnPacketReceived(const std::shared_ptr<Net::IChannel>& chan
                 listener->OnAddChunkToCache(channel, p->key, p->dataSize, p->numOfChunks, p->chunkNumber, p->chunkData);
                 return;
             }
+            case PACKET_ADD_CHUNK_LIST_REQUEST:
+            {
+                AddChunkListRequestPacket* p = static_cast<AddChunkListRequestPacket*>(packet.get());
+                listener->OnAddChunkListToCache(channel, p->key, p->dataSize, p->chunks);
+                return;
+            }
             case PACKET_GET_CHUNK_REQUEST:
             {
                 GetChunkRequestPacket* p = static_cast<GetChunkRequestPacket*>(packet.get());
@@ -127,6 +133,17 @@ bool ServerNetProxy::SendAddedToCache(const std::shared_ptr<Net::IChannel>& chan
     return false;
 }
 
+bool ServerNetProxy::SendMissingChunks(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, const Vector<uint32>& missingChunks)
+{
+    if (channel)
+    {
+        AddChunkListResponsePacket packet(key, missingChunks);
+        return packet.SendTo(channel);
+    }
+
+    return false;
+}
+
 bool ServerNetProxy::SendRemovedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool removed)
 {
     if (channel)
@@ -160,11 +177,11 @@ bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, co
     return false;
 }
 
-bool ServerNetProxy::SendStatus(const std::shared_ptr<Net::IChannel>& channel)
+bool ServerNetProxy::SendStatus(const std::shared_ptr<Net::IChannel>& channel, uint32 capabilities)
 {
     if (channel)
     {
-        StatusResponsePacket packet;
+        StatusResponsePacket packet(capabilities);
         return packet.SendTo(channel);
     }
 
@@ -4,6 +4,7 @@
 
 #include "AssetCache/Connection.h"
 #include "AssetCache/CacheItemKey.h"
+#include "AssetCache/ChunkSplitter.h"
 
 #include <Base/BaseTypes.h>
 #include <Network/IChannel.h>
@@ -20,6 +21,7 @@ public:
     virtual ~ServerNetProxyListener() = default;
 
     virtual void OnAddChunkToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) = 0;
+    virtual void OnAddChunkListToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, const Vector<ChunkSplitter::ContentChunk>& chunks) = 0;
     virtual void OnChunkRequestedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint32 chunkNumber) = 0;
     virtual void OnRemoveFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key) = 0;
     virtual void OnClearCache(const std::shared_ptr<Net::IChannel>& channel) = 0;
@@ -44,10 +46,11 @@ public:
     uint16 GetListenPort() const;
 
     bool SendAddedToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool added);
+    bool SendMissingChunks(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, const Vector<uint32>& missingChunks);
     bool SendRemovedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool removed);
     bool SendCleared(const std::shared_ptr<Net::IChannel>& channel, bool cleared);
     bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
-    bool SendStatus(const std::shared_ptr<Net::IChannel>& channel);
+    bool SendStatus(const std::shared_ptr<Net::IChannel>& channel, uint32 capabilities = 0);
 
     //Net::IChannelListener
     // Channel is open (underlying transport has connection) and can receive and send data through IChannel interface
@@ -50,7 +50,6 @@ public:
 
 private:
     // IChannelListener
-    void OnPacketSent(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) override;
     void OnPacketDelivered(const std::shared_ptr<IChannel>& channel, uint32 packetId) override;
 
     // LoggerOutput
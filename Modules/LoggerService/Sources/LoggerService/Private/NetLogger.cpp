@@ -52,12 +52,6 @@ void NetLogger::ChannelOpen()
     SendNextRecord(); // start sending log records if any
 }
 
-void NetLogger::OnPacketSent(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length)
-{
-    // Record has been sent and buffer can be deleted
-    delete[] static_cast<const char8*>(buffer);
-}
-
 void NetLogger::OnPacketDelivered(const std::shared_ptr<IChannel>& channel, uint32 packetId)
 {
     // Record has been got by other side so we can remove that record
@@ -87,9 +81,10 @@ void NetLogger::SendNextRecord()
         const char* levelStr = Logger::GetLogLevelString(record.level);
 
         size_t n = timeStr.size() + 1 + strlen(levelStr) + 1 + record.message.size();
-        char8* buf = new char8[n + 1]; // this will be deleted in OnChannelSendComplete callback
-        Snprintf(buf, n + 1, "%s %s %s", timeStr.c_str(), levelStr, record.message.c_str());
-        Send(buf, n - 1); // remove trailing '\n'
+        Vector<uint8> buf(n + 1);
+        Snprintf(reinterpret_cast<char8*>(buf.data()), n + 1, "%s %s %s", timeStr.c_str(), levelStr, record.message.c_str());
+        buf.resize(n - 1); // remove trailing '\n'
+        Send(SharedBuffer(std::move(buf))); // network keeps buffer until it has been sent
     }
 }
 
@@ -47,6 +47,7 @@ public:
     static const String Mode;
 
     static const String SaveNormals;
+    static const String OptimizeMeshes;
     static const String CopyConverted;
     static const String SetCompression;
     static const String SetPreset;
@@ -65,10 +66,15 @@ public:
 
     static const String Validate;
     static const String Count;
+    static const String LodRatio;
+    static const String LodMaxError;
 
     static const String Tag;
     static const String TagList;
 
+    static const String Api;
+    static const String Threads;
+
     static const String MakeNameForGPU(eGPUFamily gpuFamily);
 };
 
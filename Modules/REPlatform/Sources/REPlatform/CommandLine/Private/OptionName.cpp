@@ -41,6 +41,7 @@ const String OptionName::HDTextures("-hd");
 const String OptionName::Mode("-mode");
 
 const String OptionName::SaveNormals("-saveNormals");
+const String OptionName::OptimizeMeshes("-optimizeMeshes");
 const String OptionName::CopyConverted("-copyconverted");
 const String OptionName::SetCompression("-setcompression");
 const String OptionName::SetPreset("-setpreset");
@@ -59,10 +60,15 @@ const String OptionName::Camera("-camera");
 
 const String OptionName::Validate("-validate");
 const String OptionName::Count("-count");
+const String OptionName::LodRatio("-lodratio");
+const String OptionName::LodMaxError("-lodmaxerror");
 
 const String OptionName::Tag("-tag");
 const String OptionName::TagList("-taglist");
 
+const String OptionName::Api("-api");
+const String OptionName::Threads("-threads");
+
 const String OptionName::MakeNameForGPU(eGPUFamily gpuFamily)
 {
     return ("-" + GPUFamilyDescriptor::GetGPUName(gpuFamily));
@@ -4,6 +4,7 @@
 #include "REPlatform/Global/StringConstants.h"
 
 #include <TArc/Utils/RhiEmptyFrame.h>
+#include <Animation/AnimationClipCompressor.h>
 #include <AssetCache/AssetCacheClient.h>
 
 #include <Engine/Engine.h>
@@ -16,6 +17,7 @@
 #include <Particles/ParticleEmitter.h>
 #include <Particles/ParticleLayer.h>
 #include <Platform/Process.h>
+#include <Render/3D/MeshOptimizer.h>
 #include <Render/GPUFamilyDescriptor.h>
 #include <Render/Highlevel/Heightmap.h>
 #include <Render/Highlevel/Landscape.h>
@@ -470,7 +472,8 @@ bool SceneExporter::ExportSceneObject(const ExportedObject& sceneObject)
     AssetCache::CacheItemKey cacheKey;
     if (cacheClient != nullptr && cacheClient->IsConnected())
     { //request Scene from cache
-        SceneExporterCache::CalculateSceneKey(scenePathname, sceneObject.relativePathname, cacheKey, static_cast<uint32>(exportingParams.optimizeOnExport));
+        uint32 optimizationFlags = static_cast<uint32>(exportingParams.optimizeOnExport) | (static_cast<uint32>(exportingParams.optimizeMeshes) << 1);
+        SceneExporterCache::CalculateSceneKey(scenePathname, sceneObject.relativePathname, cacheKey, optimizationFlags);
 
         AssetCache::CachedItemValue retrievedData;
         AssetCache::Error requested = cacheClient->RequestFromCacheSynchronously(cacheKey, &retrievedData);
@@ -978,6 +981,14 @@ bool SceneExporter::ExportScene(Scene* scene, const FilePath& scenePathname, con
 
     CollectObjects(scene, exportedObjects);
 
+    if (exportingParams.optimizeMeshes)
+    {
+        MeshOptimizer::Statistics stats = MeshOptimizer::OptimizeMeshesRecursive(scene, MeshOptimizer::Options());
+        Logger::Info("[SceneExporter] %s: optimized %u polygon groups, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %u vertices removed",
+                     scenePathname.GetAbsolutePathname().c_str(), stats.optimizedGroupsCount,
+                     stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr, stats.removedVertexCount);
+    }
+
     // save scene to new place
     FilePath tempSceneName = FilePath::CreateWithNewExtension(scenePathname, ".exported.sc2");
     scene->SaveScene(tempSceneName, exportingParams.optimizeOnExport);
@@ -1005,7 +1016,7 @@ bool SceneExporter::ExportObjects(const ExportedObjectCollection& exportedObject
     MakeFunction(this, &SceneExporter::CopyObject), // heightmap
     MakeFunction(this, &SceneExporter::CopyObject), // emitter config
     MakeFunction(this, &SceneExporter::ExportSlotObject), //slot config
-    MakeFunction(this, &SceneExporter::CopyObject), //anim clip
+    MakeFunction(this, &SceneExporter::ExportAnimationClipObject), //anim clip
     } };
 
     // divide objects into different collections
@@ -1144,6 +1155,28 @@ bool SceneExporter::CopyFileToOutput(const FilePath& fromPath, const Params::Out
     return CopyFile(fromPath, output.dataFolder + relativePathname);
 }
 
+bool SceneExporter::ExportAnimationClipObject(const ExportedObject& object)
+{
+    using namespace DAVA;
+
+    if (exportingParams.optimizeOnExport == false)
+    {
+        return CopyObject(object);
+    }
+
+    bool filesExported = true;
+
+    FilePath fromPath = exportingParams.dataSourceFolder + object.relativePathname;
+    for (const Params::Output& output : exportingParams.outputs)
+    {
+        FilePath toPath = output.dataFolder + object.relativePathname;
+        GetEngineContext()->fileSystem->CreateDirectory(toPath.GetDirectory(), true);
+        filesExported = AnimationClipCompressor::Compress(fromPath, toPath, AnimationClipCompressor::Settings()) && filesExported;
+    }
+
+    return filesExported;
+}
+
 bool SceneExporter::CopyObject(const ExportedObject& object)
 {
     using namespace DAVA;
@@ -77,6 +77,7 @@ public:
         String filenamesTag;
 
         bool optimizeOnExport = false;
+        bool optimizeMeshes = false;
     };
 
     SceneExporter() = default;
@@ -94,6 +95,7 @@ private:
     bool ExportTextureObjectTagged(const ExportedObject& object);
     bool ExportTextureObject(const ExportedObject& object);
     bool ExportSlotObject(const ExportedObject& object);
+    bool ExportAnimationClipObject(const ExportedObject& object);
     bool CopyObject(const ExportedObject& object);
 
     bool ExportSceneFileInternal(const FilePath& scenePathname, const FilePath& outScenePathname, Vector<ExportedObjectCollection>& exportedObjects); //without cache
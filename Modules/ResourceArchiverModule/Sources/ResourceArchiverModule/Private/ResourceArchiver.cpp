@@ -6,6 +6,7 @@
 #include <FileSystem/File.h>
 #include <FileSystem/FilePath.h>
 #include <FileSystem/FileList.h>
+#include <FileSystem/Private/PackArchive.h>
 #include <FileSystem/Private/PackFormatSpec.h>
 #include <FileSystem/Private/PackMetaData.h>
 #include <Utils/UTF8Utils.h>
@@ -19,6 +20,10 @@
 #include <Logger/Logger.h>
 #include <Engine/Engine.h>
 #include <Job/JobManager.h>
+#include <Concurrency/ConditionVariable.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
+#include <Concurrency/UniqueLock.h>
 
 #include <sqlite_modern_cpp.h>
 #include <algorithm>
@@ -442,9 +447,171 @@ const Compressor* GetCompressor(Compressor::Type compressorType)
     }
 }
 
+/**
+    Previous version of archive, compressed blocks of files which weren't changed since are copied from it
+    instead of compressing sources again.
+*/
+class BasePack
+{
+public:
+    bool Open(const FilePath& packPath)
+    {
+        file.Set(File::Create(packPath, File::OPEN | File::READ));
+        if (!file)
+        {
+            Logger::Error("Can't open base pack %s", packPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        try
+        {
+            archive.reset(new PackArchive(file, packPath));
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("Can't read base pack %s: %s", packPath.GetAbsolutePathname().c_str(), ex.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    /** Load compressed block of `archivePath` if it is stored with same original data and compression type. Thread safe */
+    bool LoadBlock(const String& archivePath, uint32 originalCrc32, uint32 originalSize, Compressor::Type compressionType, PackFormat::FileTableEntry& fileEntry, Vector<uint8>& block)
+    {
+        DVASSERT(archive);
+
+        uint32 index = archive->GetFileIndex(archivePath);
+        if (index == std::numeric_limits<uint32>::max())
+        {
+            return false;
+        }
+
+        const PackFormat::FileTableEntry& baseEntry = archive->GetPackFile().filesTable.data.files[index];
+        if (baseEntry.originalCrc32 != originalCrc32 || baseEntry.originalSize != originalSize)
+        {
+            return false;
+        }
+
+        // files which were not compressible are stored uncompressed
+        if (baseEntry.type != compressionType && baseEntry.type != Compressor::Type::None)
+        {
+            return false;
+        }
+
+        block.resize(baseEntry.compressedSize);
+        if (baseEntry.compressedSize > 0)
+        {
+            LockGuard<Mutex> lock(fileMutex);
+            if (!file->Seek(baseEntry.startPosition, File::SEEK_FROM_START) || file->Read(block.data(), baseEntry.compressedSize) != baseEntry.compressedSize)
+            {
+                return false;
+            }
+        }
+
+        if (CRC32::ForBuffer(block.data(), block.size()) != baseEntry.compressedCrc32)
+        {
+            return false;
+        }
+
+        fileEntry = baseEntry;
+        return true;
+    }
+
+private:
+    RefPtr<File> file;
+    std::unique_ptr<PackArchive> archive;
+    Mutex fileMutex;
+};
+
+bool PrepareFileData(const CollectedFile& collectedFile,
+                     const Compressor* compressor,
+                     const Compressor::Type compressionType,
+                     BasePack* basePack,
+                     bool dummyFileData,
+                     PackFormat::FileTableEntry& fileEntry,
+                     Vector<uint8>& useBuffer,
+                     bool& reusedFromBasePack)
+{
+    Vector<uint8> origFileBuffer;
+    Vector<uint8> compressedFileBuffer;
+    uint32 originalCrc32 = 0;
+
+    bool useCompressedBuffer = (compressionType != Compressor::Type::None);
+    Compressor::Type useCompression = compressionType;
+
+    reusedFromBasePack = false;
+
+    if (dummyFileData)
+    {
+        origFileBuffer.resize(1);
+        origFileBuffer[0] = 0;
+        originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
+
+        useCompressedBuffer = false;
+        useCompression = Compressor::Type::None;
+    }
+    else
+    {
+        if (!FileSystem::Instance()->ReadFileContents(collectedFile.absPath, origFileBuffer))
+        {
+            Logger::Error("Can't read contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
+        if (basePack != nullptr)
+        {
+            if (basePack->LoadBlock(collectedFile.archivePath, originalCrc32, static_cast<uint32>(origFileBuffer.size()), compressionType, fileEntry, useBuffer))
+            {
+                reusedFromBasePack = true;
+                return true;
+            }
+        }
+
+        if (origFileBuffer.empty())
+        {
+            useCompressedBuffer = false;
+            useCompression = Compressor::Type::None;
+        }
+
+        if (useCompressedBuffer)
+        {
+            if (!compressor->Compress(origFileBuffer, compressedFileBuffer))
+            {
+                Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
+                return false;
+            }
+
+            if (compressedFileBuffer.size() < origFileBuffer.size())
+            {
+                useCompressedBuffer = true;
+            }
+            else
+            {
+                useCompressedBuffer = false;
+                useCompression = Compressor::Type::None;
+            }
+        }
+    }
+
+    fileEntry.startPosition = 0; // later fill this field
+    fileEntry.originalSize = static_cast<uint32>(origFileBuffer.size());
+    fileEntry.originalCrc32 = originalCrc32;
+    fileEntry.type = useCompression;
+
+    useBuffer = std::move(useCompressedBuffer ? compressedFileBuffer : origFileBuffer);
+    fileEntry.compressedSize = static_cast<uint32>(useBuffer.size());
+    fileEntry.compressedCrc32 = CRC32::ForBuffer(useBuffer.data(), useBuffer.size());
+
+    return true;
+}
+
 bool Pack(const Vector<CollectedFile>& collectedFiles,
           const DAVA::Compressor::Type compressionType,
           const FilePath& metaDb,
+          const FilePath& basePackPath,
+          uint64 maxBytesInFlight,
           File* outputFile,
           bool dummyFileData)
 {
@@ -493,138 +660,152 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
         return false;
     }
 
+    std::unique_ptr<BasePack> basePack;
+    if (!basePackPath.IsEmpty() && !dummyFileData)
+    {
+        basePack.reset(new BasePack());
+        if (!basePack->Open(basePackPath))
+        {
+            Logger::Warning("All files will be compressed from sources");
+            basePack.reset();
+        }
+    }
+
     const size_t numOfFiles = collectedFiles.size();
     PackFormat::PackFile packFile;
     packFile.filesTable.data.files.resize(numOfFiles);
-    Vector<Vector<uint8>> useBuffers;
-    useBuffers.resize(numOfFiles);
+
+    // Files are read and compressed on worker threads and written to output strictly in order of collectedFiles.
+    // Jobs are started ahead of writing position while size of sources being processed fits into maxBytesInFlight.
+    struct PackedFile
+    {
+        Vector<uint8> data;
+        uint64 sourceSize = 0;
+        bool ready = false;
+        bool succeeded = false;
+        bool reused = false;
+    };
+    Vector<PackedFile> packedFiles(numOfFiles);
+    Mutex packedFilesMutex;
+    ConditionVariable packedFileReady;
+    size_t finishedJobsCount = 0;
+
+    const size_t MAX_JOBS_IN_FLIGHT = 512; // JobManager keeps no more than 1024 jobs in queue
+    uint64 bytesInFlight = 0;
+    size_t nextJobIndex = 0;
 
     FileSystem* fs = FileSystem::Instance();
     JobManager* jobManager = GetEngineContext()->jobManager;
     DVASSERT(jobManager != nullptr);
 
-    std::atomic<uint32> countLoadedFiles{ 0 };
+    bool succeeded = true;
+    uint32 reusedFilesCount = 0;
 
-    for (uint32 fileIndex = 0; fileIndex < numOfFiles; ++fileIndex)
+    // write all compressed content to output file and set startPosition fileEntry
+    for (size_t fileIndex = 0, dataOffset = 0; fileIndex < numOfFiles; ++fileIndex)
     {
-        jobManager->CreateWorkerJob([&, fileIndex]()
-                                    {
-                                        const CollectedFile& collectedFile = collectedFiles[fileIndex];
-                                        PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
-
-                                        Vector<uint8> origFileBuffer;
-                                        Vector<uint8> compressedFileBuffer;
-
-                                        bool useCompressedBuffer = (compressionType != Compressor::Type::None);
-                                        Compressor::Type useCompression = compressionType;
+        while (nextJobIndex < numOfFiles && (nextJobIndex == fileIndex || (bytesInFlight < maxBytesInFlight && nextJobIndex - fileIndex < MAX_JOBS_IN_FLIGHT)))
+        {
+            const size_t jobIndex = nextJobIndex++;
 
-                                        if (dummyFileData)
-                                        {
-                                            origFileBuffer.resize(1);
-                                            origFileBuffer[0] = 0;
+            PackedFile& packedFile = packedFiles[jobIndex];
+            if (dummyFileData || !fs->GetFileSize(collectedFiles[jobIndex].absPath, packedFile.sourceSize))
+            {
+                packedFile.sourceSize = 1;
+            }
+            bytesInFlight += packedFile.sourceSize;
 
-                                            useCompressedBuffer = false;
-                                            useCompression = Compressor::Type::None;
-                                        }
-                                        else
+            jobManager->CreateWorkerJob([&, jobIndex]()
                                         {
-                                            if (!fs->ReadFileContents(collectedFile.absPath, origFileBuffer))
+                                            Vector<uint8> useBuffer;
+                                            bool reused = false;
+                                            bool prepared = PrepareFileData(collectedFiles[jobIndex], compressor, compressionType, basePack.get(), dummyFileData,
+                                                                            packFile.filesTable.data.files[jobIndex], useBuffer, reused);
                                             {
-                                                Logger::Error("Can't read contents of: ", collectedFile.absPath.GetAbsolutePathname().c_str());
-                                                return;
-                                            }
-
-                                            if (origFileBuffer.empty())
-                                            {
-                                                useCompressedBuffer = false;
-                                                useCompression = Compressor::Type::None;
+                                                LockGuard<Mutex> lock(packedFilesMutex);
+                                                PackedFile& result = packedFiles[jobIndex];
+                                                result.data = std::move(useBuffer);
+                                                result.succeeded = prepared;
+                                                result.reused = reused;
+                                                result.ready = true;
+                                                ++finishedJobsCount;
+                                                // notified under lock, because waiting thread may destroy condition right after wake up
+                                                packedFileReady.NotifyAll();
                                             }
+                                        });
+        }
 
-                                            if (useCompressedBuffer)
-                                            {
-                                                if (!compressor->Compress(origFileBuffer, compressedFileBuffer))
-                                                {
-                                                    Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
-                                                    return;
-                                                }
-
-                                                if (compressedFileBuffer.size() < origFileBuffer.size())
-                                                {
-                                                    useCompressedBuffer = true;
-                                                }
-                                                else
-                                                {
-                                                    useCompressedBuffer = false;
-                                                    useCompression = Compressor::Type::None;
-                                                }
-                                            }
-                                        }
+        PackedFile& packedFile = packedFiles[fileIndex];
+        Vector<uint8> useBuffer;
+        {
+            UniqueLock<Mutex> lock(packedFilesMutex);
+            packedFileReady.Wait(lock, [&packedFile]() { return packedFile.ready; });
+            useBuffer = std::move(packedFile.data);
+        }
+        bytesInFlight -= packedFile.sourceSize;
 
-                                        Vector<uint8>& useBuffer = (useCompressedBuffer ? compressedFileBuffer : origFileBuffer);
+        if (!packedFile.succeeded)
+        {
+            succeeded = false;
+            break;
+        }
 
-                                        fileEntry.startPosition = 0; // later fill this field
-                                        fileEntry.originalSize = static_cast<uint32>(origFileBuffer.size());
-                                        fileEntry.compressedSize = static_cast<uint32>(useBuffer.size());
-                                        fileEntry.type = useCompression;
-                                        fileEntry.compressedCrc32 = CRC32::ForBuffer(useBuffer.data(), useBuffer.size());
-                                        fileEntry.originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
-                                        if (!meta)
-                                        {
-                                            fileEntry.metaIndex = 0; // do it or your crc32 randomly change on same files
-                                        }
-                                        else
-                                        {
-                                            // we have PackArchive with vector of FileInfo's
-                                            // from PackArchive we can get fileIndex
-                                            // with fileIndex from PackMetaData we can get packIndex
-                                            // and later use metaIndex(packIndex) directly from FileInfo
-                                            // files table example
-                                            //|--------------------------------------|
-                                            //|file_path(sorted)----------|pack_index|
-                                            //|3d/gfx/uber_file.pvr       |         0|
-                                            //|--------------------------------------|
-                                            // packs table example
-                                            //|--------------------------------------|
-                                            //|pack_index|pack_name-----|pack_dep----|
-                                            //|         0|group_pack_1  |group_pack_0|
-                                            //|--------------------------------------|
-                                            // so packIndex(metaIndex) is duplicated in FileInfo's for now.
-                                            fileEntry.metaIndex = meta->GetPackIndexForFile(fileIndex);
-                                        }
-                                        useBuffers[fileIndex] = std::move(useBuffer);
-                                        ++countLoadedFiles;
-                                    });
-
-        //HACK wait jobs executed (internaly 1024 max jobs)
-        if (fileIndex > 0 && fileIndex % 1000 == 0)
-        {
-            jobManager->WaitWorkerJobs();
-        }
-    } // end for fileIndex
-
-    jobManager->WaitWorkerJobs();
-
-    if (numOfFiles != countLoadedFiles)
-    {
-        return false;
-    }
+        if (packedFile.reused)
+        {
+            ++reusedFilesCount;
+        }
 
-    // write all compressed content to output file and set startPosition fileEntry
-    for (size_t fileIndex = 0, dataOffset = 0; fileIndex < numOfFiles; ++fileIndex)
-    {
         PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
         fileEntry.startPosition = dataOffset;
+        if (!meta)
+        {
+            fileEntry.metaIndex = 0; // do it or your crc32 randomly change on same files
+        }
+        else
+        {
+            // we have PackArchive with vector of FileInfo's
+            // from PackArchive we can get fileIndex
+            // with fileIndex from PackMetaData we can get packIndex
+            // and later use metaIndex(packIndex) directly from FileInfo
+            // files table example
+            //|--------------------------------------|
+            //|file_path(sorted)----------|pack_index|
+            //|3d/gfx/uber_file.pvr       |         0|
+            //|--------------------------------------|
+            // packs table example
+            //|--------------------------------------|
+            //|pack_index|pack_name-----|pack_dep----|
+            //|         0|group_pack_1  |group_pack_0|
+            //|--------------------------------------|
+            // so packIndex(metaIndex) is duplicated in FileInfo's for now.
+            fileEntry.metaIndex = meta->GetPackIndexForFile(static_cast<uint32>(fileIndex));
+        }
 
-        const Vector<uint8>& useBuffer = useBuffers[fileIndex];
         if (!WriteRawData(outputFile, useBuffer))
         {
             Logger::Error("can't write buffer to output file");
-            return false;
+            succeeded = false;
+            break;
         }
         dataOffset += useBuffer.size();
     }
-    useBuffers.clear();
-    useBuffers.shrink_to_fit(); // free memory
+
+    // jobs reference local state, so they should be finished even if packing is failed
+    {
+        UniqueLock<Mutex> lock(packedFilesMutex);
+        packedFileReady.Wait(lock, [&finishedJobsCount, nextJobIndex]() { return finishedJobsCount == nextJobIndex; });
+    }
+    packedFiles.clear();
+
+    if (!succeeded)
+    {
+        return false;
+    }
+
+    if (basePack)
+    {
+        Logger::Info("%u of %u files are reused from base pack %s", reusedFilesCount, static_cast<uint32>(numOfFiles), basePackPath.GetAbsolutePathname().c_str());
+    }
 
     Vector<uint8> metaBytes;
     if (meta)
@@ -718,8 +899,10 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     return true;
 }
 
-bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type compressionType, const FilePath& archivePath, const FilePath& metaDb, bool dummyFileData)
+bool Pack(const Vector<CollectedFile>& collectedFiles, const Params& params)
 {
+    const FilePath& archivePath = params.archivePath;
+
     ScopedPtr<File> outputFile(File::Create(archivePath, File::CREATE | File::WRITE));
     if (!outputFile)
     {
@@ -727,7 +910,7 @@ bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type co
         return false;
     }
 
-    if (!Pack(collectedFiles, compressionType, metaDb, outputFile, dummyFileData))
+    if (!Pack(collectedFiles, params.compressionType, params.metaDbPath, params.basePackPath, params.maxBytesInFlight, outputFile, params.dummyFileData))
     {
         outputFile.reset();
         if (!FileSystem::Instance()->DeleteFile(archivePath))
@@ -756,7 +939,7 @@ bool CreateArchive(const Params& params)
         return false;
     }
 
-    if (Pack(collectedFiles, params.compressionType, params.archivePath, params.metaDbPath, params.dummyFileData))
+    if (Pack(collectedFiles, params))
     {
         return true;
     }
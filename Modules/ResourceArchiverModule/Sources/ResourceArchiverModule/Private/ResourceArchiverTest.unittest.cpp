@@ -0,0 +1,165 @@
+#include "ResourceArchiverModule/ResourceArchiver.h"
+
+#include <Base/Exception.h>
+#include <Base/ScopedPtr.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/ResourceArchive.h>
+#include <Utils/StringFormat.h>
+
+#include <sqlite_modern_cpp.h>
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace ResourceArchiverTestDetails
+{
+const uint32 FILES_COUNT = 32;
+
+String GetRelativePath(uint32 index)
+{
+    return Format("dir%u/file%u.txt", index % 3, index);
+}
+
+// half of files are well compressible text, other half is noise
+Vector<uint8> GenerateContent(uint32 index, uint32 version)
+{
+    Vector<uint8> content(512 + index * 97);
+    uint32 state = index * 31 + version * 7919 + 1;
+    for (size_t i = 0; i < content.size(); ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        content[i] = (index % 2 == 0) ? static_cast<uint8>('a' + (i + version) % 16) : static_cast<uint8>(state >> 24);
+    }
+    return content;
+}
+
+void WriteContent(const FilePath& path, const Vector<uint8>& content)
+{
+    FileSystem::Instance()->CreateDirectory(path.GetDirectory(), true);
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    TEST_VERIFY(file && file->Write(content.data(), static_cast<uint32>(content.size())) == content.size());
+}
+
+void GenerateMetaDB(const FilePath& metaDbPath)
+{
+    FileSystem::Instance()->DeleteFile(metaDbPath);
+
+    sqlite::database db(metaDbPath.GetAbsolutePathname());
+    db << "CREATE TABLE IF NOT EXISTS files (path TEXT PRIMARY KEY, pack_index INTEGER NOT NULL);";
+    db << "CREATE TABLE IF NOT EXISTS packs (\"index\" INTEGER PRIMARY KEY, name TEXT UNIQUE, dependency TEXT NOT NULL);";
+
+    for (uint32 i = 0; i < FILES_COUNT; ++i)
+    {
+        db << "INSERT INTO files (path, pack_index) VALUES (?, ?);"
+           << GetRelativePath(i)
+           << static_cast<int32>(i % 2);
+    }
+
+    db << "INSERT INTO packs (\"index\", name, dependency) VALUES (?, ?, ?);"
+       << 0
+       << "pack0"
+       << "";
+    db << "INSERT INTO packs (\"index\", name, dependency) VALUES (?, ?, ?);"
+       << 1
+       << "pack1"
+       << "0";
+}
+}
+
+DAVA_TESTCLASS (ResourceArchiverTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("ResourceArchiver.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    const FilePath testFolder = "~doc:/ResourceArchiverTest/";
+    const FilePath sourceFolder = "~doc:/ResourceArchiverTest/source/";
+    const FilePath unpackFolder = "~doc:/ResourceArchiverTest/unpacked/";
+
+    ResourceArchiverTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(testFolder);
+        FileSystem::Instance()->CreateDirectory(sourceFolder, true);
+    }
+
+    ~ResourceArchiverTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(testFolder);
+    }
+
+    DAVA_TEST (RepackWithBaseTest)
+    {
+        using namespace ResourceArchiverTestDetails;
+
+        for (uint32 i = 0; i < FILES_COUNT; ++i)
+        {
+            WriteContent(sourceFolder + GetRelativePath(i), GenerateContent(i, 0));
+        }
+
+        ResourceArchiver::Params params;
+        params.compressionType = Compressor::Type::Lz4HC;
+        params.baseDirPath = sourceFolder;
+        params.metaDbPath = testFolder + "meta.db";
+        params.archivePath = testFolder + "base.dvpk";
+        params.maxBytesInFlight = 4 * 1024; // keep only few files in flight to check ordered writing
+        GenerateMetaDB(params.metaDbPath);
+        TEST_VERIFY(ResourceArchiver::CreateArchive(params));
+
+        // change every fourth file, others should be copied from base pack
+        for (uint32 i = 0; i < FILES_COUNT; i += 4)
+        {
+            WriteContent(sourceFolder + GetRelativePath(i), GenerateContent(i, 1));
+        }
+
+        params.basePackPath = params.archivePath;
+        params.archivePath = testFolder + "repacked.dvpk";
+        TEST_VERIFY(ResourceArchiver::CreateArchive(params));
+
+        try
+        {
+            ResourceArchive baseArchive(params.basePackPath);
+            ResourceArchive archive(params.archivePath);
+            TEST_VERIFY(archive.GetFilesInfo().size() == FILES_COUNT);
+
+            for (uint32 i = 0; i < FILES_COUNT; ++i)
+            {
+                const String relativePath = GetRelativePath(i);
+                const Vector<uint8> expected = GenerateContent(i, (i % 4 == 0) ? 1 : 0);
+
+                Vector<uint8> content;
+                TEST_VERIFY(archive.LoadFile(relativePath, content));
+                TEST_VERIFY(content == expected);
+
+                const ResourceArchive::FileInfo* info = archive.GetFileInfo(relativePath);
+                const ResourceArchive::FileInfo* baseInfo = baseArchive.GetFileInfo(relativePath);
+                TEST_VERIFY(info != nullptr && baseInfo != nullptr);
+                if (info != nullptr && baseInfo != nullptr)
+                {
+                    TEST_VERIFY((info->originalCrc32 == baseInfo->originalCrc32) == (i % 4 != 0));
+                }
+            }
+
+            TEST_VERIFY(archive.UnpackToFolder(unpackFolder));
+            for (uint32 i = 0; i < FILES_COUNT; ++i)
+            {
+                const Vector<uint8> expected = GenerateContent(i, (i % 4 == 0) ? 1 : 0);
+
+                ScopedPtr<File> file(File::Create(unpackFolder + GetRelativePath(i), File::OPEN | File::READ));
+                TEST_VERIFY(file);
+                if (file)
+                {
+                    Vector<uint8> content(static_cast<size_t>(file->GetSize()));
+                    file->Read(content.data(), static_cast<uint32>(content.size()));
+                    TEST_VERIFY(content == expected);
+                }
+            }
+        }
+        catch (Exception& ex)
+        {
+            TEST_VERIFY_WITH_MESSAGE(false, ex.what());
+        }
+    }
+};
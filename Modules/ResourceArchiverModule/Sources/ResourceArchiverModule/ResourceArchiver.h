@@ -13,6 +13,8 @@ struct Params
     FilePath archivePath;
     FilePath baseDirPath;
     FilePath metaDbPath;
+    FilePath basePackPath; //!< previous version of archive built with same compression type, compressed data of unchanged files is copied from it
+    uint64 maxBytesInFlight = 512 * 1024 * 1024; //!< max size of sources being read and compressed ahead of writing position
     bool dummyFileData = false;
 };
 
@@ -3,9 +3,13 @@
 #include "TexturePacker/TexturePacker.h"
 
 #include <CommandLine/CommandLineParser.h>
+#include <Concurrency/ConditionVariable.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Thread.h>
 #include <Engine/Engine.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/FileList.h>
+#include <Job/JobManager.h>
 #include <Utils/StringUtils.h>
 #include <Platform/DeviceInfo.h>
 #include <Time/DateTime.h>
@@ -16,6 +20,7 @@
 #include <Render/GPUFamilyDescriptor.h>
 #include <Platform/Process.h>
 #include <Render/TextureDescriptor.h>
+#include <Render/Image/ImageSystem.h>
 #include <Logger/Logger.h>
 
 namespace DAVA
@@ -92,6 +97,23 @@ bool IsBasenameContainsTag(const String& basename, const String& tag)
     }
     return isTagged;
 }
+
+/** Estimate memory occupied by decoded image, images are read in RGBA8888 format for packing */
+uint64 EstimateImageMemorySize(const FilePath& path, const String& ext)
+{
+    FilePath imagePath = path;
+    if (CompareCaseInsensitive(ext, ".pngdef") == 0)
+    {
+        imagePath = FilePath::CreateWithNewExtension(path, ".png");
+    }
+    else if (CompareCaseInsensitive(ext, ".psd") != 0 && TextureDescriptor::IsSupportedTextureExtension(ext) == false)
+    {
+        return 0;
+    }
+
+    ImageInfo info = ImageSystem::GetImageInfo(imagePath);
+    return static_cast<uint64>(info.width) * info.height * 4;
+}
 } // namespace ResourcePacker2DDetails
 
 String ResourcePacker2D::GetProcessFolderName()
@@ -170,6 +192,23 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
     {
         packAlgorithms.push_back(PackingAlgorithm::ALG_BASIC);
     }
+    else if (CompareCaseInsensitive(alg, "skyline") == 0)
+    {
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_MIN_WASTE);
+    }
+    else if (CompareCaseInsensitive(alg, "best") == 0)
+    {
+        // slowest one: every algorithm is tried with every sprites order
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT);
+        packAlgorithms.push_back(PackingAlgorithm::ALG_SKYLINE_MIN_WASTE);
+        sortOrders = { SpriteSortOrder::AREA, SpriteSortOrder::MAX_SIDE, SpriteSortOrder::HEIGHT, SpriteSortOrder::WIDTH, SpriteSortOrder::PERIMETER };
+    }
     else
     {
         AddError(Format("Unknown algorithm: '%s'", alg.c_str()));
@@ -227,7 +266,10 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
         }
     }
 
+    packTasks.clear();
     PackRecursively(inputGfxDirectory, outputGfxDirectory, packAlgorithms);
+    PackDirectories(packAlgorithms);
+    packTasks.clear();
 
     // Put latest md5 after convertation
     RecalculateDirMD5(outputGfxDirectory, processDirectoryPath + gfxDirName + ".md5", true);
@@ -375,8 +417,6 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         return;
     }
 
-    uint64 packTime = SystemTimer::GetMs();
-
     String inputRelativePath = inputDir.GetRelativePathname(rootDirectory);
     FilePath processDir = rootDirectory + GetProcessFolderName() + inputRelativePath;
     FileSystem::Instance()->CreateDirectory(processDir, true);
@@ -417,6 +457,10 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     {
         packingParams += String("PackerAlgorithm = ") + GlobalEnumMap<DAVA::PackingAlgorithm>::Instance()->ToString(static_cast<int>(algorithm));
     }
+    for (SpriteSortOrder order : sortOrders)
+    {
+        packingParams += Format("PackerSortOrder = %d", static_cast<int32>(order));
+    }
 
     if (tag.empty() == false)
     {
@@ -535,130 +579,27 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
             bool needRepack = (false == GetFilesFromCache(cacheKey, inputDir, outputDir));
             if (needRepack)
             {
-                // read textures margins settings
-                bool useTwoSideMargin = CommandLineParser::Instance()->IsFlagSet("--add2sidepixel");
-                uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
-                if (CommandLineParser::Instance()->IsFlagSet("--add0pixel"))
-                    marginInPixels = 0;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add1pixel"))
-                    marginInPixels = 1;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add2pixel"))
-                    marginInPixels = 2;
-                else if (CommandLineParser::Instance()->IsFlagSet("--add4pixel"))
-                    marginInPixels = 4;
-
-                uint32 maxTextureSize = GetMaxTextureSize();
-
-                bool withAlpha = CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha");
-                bool useLayerNames = CommandLineParser::Instance()->IsFlagSet("--useLayerNames");
-                bool verbose = CommandLineParser::Instance()->GetVerbose();
-
-                if (clearOutputDirectory)
+                PackDirectoryTask task;
+                task.inputDir = inputDir;
+                task.outputDir = outputDir;
+                task.processDir = processDir;
+                task.flags = currentFlags;
+                task.mergedFlags = mergedFlags;
+
+                task.cacheKey = cacheKey;
+                task.files.reserve(pickedFiles.size());
+                for (const PickedFile& file : pickedFiles)
                 {
-                    FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
+                    PackDirectoryTask::File taskFile;
+                    taskFile.path = fileList->GetPathname(file.index);
+                    taskFile.name = file.name;
+                    taskFile.ext = file.ext;
+                    taskFile.outName = file.outName;
+                    taskFile.outBasename = file.outBasename;
+                    task.imagesMemorySize += ResourcePacker2DDetails::EstimateImageMemorySize(taskFile.path, taskFile.ext);
+                    task.files.push_back(std::move(taskFile));
                 }
-
-                DefinitionFile::Collection definitionFileList;
-                Vector<PickedFile*> justCopyList;
-                definitionFileList.reserve(pickedFiles.size());
-                for (PickedFile& file : pickedFiles)
-                {
-                    if (cancelled)
-                    {
-                        break;
-                    }
-
-                    DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
-
-                    bool shouldAcceptFile = false;
-
-                    FilePath path = fileList->GetPathname(file.index);
-                    if (CompareCaseInsensitive(file.ext, ".psd") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPSD(path, processDir, maxTextureSize,
-                                                            withAlpha, useLayerNames, verbose, file.outBasename);
-                    }
-                    else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPNGDef(path, processDir, file.outBasename);
-                    }
-                    else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
-                    {
-                        shouldAcceptFile = defFile->LoadImage(path, processDir, file.outBasename);
-                    }
-                    else
-                    {
-                        justCopyList.push_back(&file);
-                    }
-
-                    if (shouldAcceptFile)
-                    {
-                        definitionFileList.push_back(defFile);
-                    }
-                }
-
-                if (!definitionFileList.empty())
-                {
-                    TexturePacker packer;
-                    packer.SetConvertQuality(quality);
-
-                    if (isLightmapsPacking)
-                    {
-                        packer.SetUseOnlySquareTextures();
-                        packer.SetMaxTextureSize(2048);
-                    }
-                    else
-                    {
-                        if (CommandLineParser::Instance()->IsFlagSet("--square"))
-                        {
-                            packer.SetUseOnlySquareTextures();
-                        }
-                        packer.SetMaxTextureSize(maxTextureSize);
-                    }
-
-                    packer.SetTwoSideMargin(useTwoSideMargin);
-                    packer.SetTexturesMargin(marginInPixels);
-                    packer.SetAlgorithms(packAlgorithms);
-                    packer.SetTexturePostfix(texturePostfix);
-
-                    if (CommandLineParser::Instance()->IsFlagSet("--split"))
-                    {
-                        packer.PackToTexturesSeparate(outputDir, definitionFileList, requestedGPUs);
-                    }
-                    else
-                    {
-                        packer.PackToTextures(outputDir, definitionFileList, requestedGPUs);
-                    }
-
-                    Set<String> currentErrors = packer.GetErrors();
-                    if (!currentErrors.empty())
-                    {
-                        errors.insert(currentErrors.begin(), currentErrors.end());
-                    }
-                }
-
-                for (const PickedFile* file : justCopyList)
-                {
-                    FilePath srcPath = inputDir + file->name;
-                    FilePath destPath = outputDir + file->outName;
-                    if (!FileSystem::Instance()->CopyFile(srcPath, destPath))
-                    {
-                        Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
-                    }
-                }
-
-                packTime = SystemTimer::GetMs() - packTime;
-
-                if (Engine::Instance()->IsConsoleMode())
-                {
-                    Logger::Info("[%u files packed with flags: %s]", static_cast<uint32>(definitionFileList.size()), mergedFlags.c_str());
-                }
-
-                const char* result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
-                Logger::Info("[%s - %.2lf secs] - %s", inputDir.GetAbsolutePathname().c_str(),
-                             static_cast<float64>(packTime) / 1000.0, result);
-
-                AddFilesToCache(cacheKey, inputDir, outputDir);
+                packTasks.push_back(std::move(task));
             }
         }
         else if (outputDirModified || inputDirModified)
@@ -696,6 +637,222 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     }
 }
 
+void ResourcePacker2D::PackDirectories(const Vector<PackingAlgorithm>& packAlgorithms)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 threadsCount = (maxThreads == 0) ? static_cast<uint32>(Max(DeviceInfo::GetCpuCount(), 1)) : maxThreads;
+    threadsCount = Min(threadsCount, static_cast<uint32>(packTasks.size()));
+
+    if (threadsCount <= 1 || jobManager == nullptr)
+    {
+        for (const PackDirectoryTask& task : packTasks)
+        {
+            PackDirectory(task, packAlgorithms, false);
+        }
+    }
+    else
+    {
+        // few large directories are packed faster when algorithms are tried simultaneously
+        bool parallelAlgorithms = (packTasks.size() < threadsCount * 2);
+
+        Mutex tasksMutex;
+        ConditionVariable tasksCondition;
+        size_t nextTask = 0;
+        uint64 imagesInFlightSize = 0;
+
+        // directories and packing algorithms share JobManager workers, so CPU isn't oversubscribed
+        jobManager->ParallelFor(threadsCount, [&](uint32) {
+            while (true)
+            {
+                size_t taskIndex = 0;
+                {
+                    UniqueLock<Mutex> lock(tasksMutex);
+                    // task is started when its images fit into the limit or when nothing else is packed
+                    tasksCondition.Wait(lock, [&]() {
+                        return nextTask == packTasks.size() || imagesInFlightSize == 0 || imagesInFlightSize + packTasks[nextTask].imagesMemorySize <= maxImagesInFlightSize;
+                    });
+
+                    if (nextTask == packTasks.size())
+                    {
+                        break;
+                    }
+
+                    taskIndex = nextTask++;
+                    imagesInFlightSize += packTasks[taskIndex].imagesMemorySize;
+                }
+
+                if (cancelled == false)
+                {
+                    PackDirectory(packTasks[taskIndex], packAlgorithms, parallelAlgorithms);
+                }
+
+                {
+                    LockGuard<Mutex> lock(tasksMutex);
+                    imagesInFlightSize -= packTasks[taskIndex].imagesMemorySize;
+                }
+                tasksCondition.NotifyAll();
+            }
+
+            // worker threads are reused by other jobs, so their directory flags shouldn't stay
+            if (Thread::IsMainThread() == false)
+            {
+                CommandLineParser::Instance()->ClearFlags();
+            }
+        });
+    }
+
+    // cache client isn't thread safe, so results are uploaded after packing in order of directories
+    for (const PackDirectoryTask& task : packTasks)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+        AddFilesToCache(task.cacheKey, task.inputDir, task.outputDir);
+    }
+}
+
+void ResourcePacker2D::PackDirectory(const PackDirectoryTask& task, const Vector<PackingAlgorithm>& packAlgorithms, bool parallelAlgorithms)
+{
+    uint64 packTime = SystemTimer::GetMs();
+
+    // flags are set for current thread only, main thread flags remain unchanged for other threads
+    CommandLineParser::Instance()->SetFlags(task.flags);
+
+    const FilePath& inputDir = task.inputDir;
+    const FilePath& outputDir = task.outputDir;
+    const FilePath& processDir = task.processDir;
+
+    // read textures margins settings
+    bool useTwoSideMargin = CommandLineParser::Instance()->IsFlagSet("--add2sidepixel");
+    uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
+    if (CommandLineParser::Instance()->IsFlagSet("--add0pixel"))
+        marginInPixels = 0;
+    else if (CommandLineParser::Instance()->IsFlagSet("--add1pixel"))
+        marginInPixels = 1;
+    else if (CommandLineParser::Instance()->IsFlagSet("--add2pixel"))
+        marginInPixels = 2;
+    else if (CommandLineParser::Instance()->IsFlagSet("--add4pixel"))
+        marginInPixels = 4;
+
+    uint32 maxTextureSize = GetMaxTextureSize();
+
+    bool withAlpha = CommandLineParser::Instance()->IsFlagSet("--disableCropAlpha");
+    bool useLayerNames = CommandLineParser::Instance()->IsFlagSet("--useLayerNames");
+    bool verbose = CommandLineParser::Instance()->GetVerbose();
+
+    if (clearOutputDirectory)
+    {
+        FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
+    }
+
+    DefinitionFile::Collection definitionFileList;
+    Vector<const PackDirectoryTask::File*> justCopyList;
+    definitionFileList.reserve(task.files.size());
+    for (const PackDirectoryTask::File& file : task.files)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+
+        DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
+
+        bool shouldAcceptFile = false;
+
+        const FilePath& path = file.path;
+        if (CompareCaseInsensitive(file.ext, ".psd") == 0)
+        {
+            shouldAcceptFile = defFile->LoadPSD(path, processDir, maxTextureSize,
+                                                withAlpha, useLayerNames, verbose, file.outBasename);
+        }
+        else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
+        {
+            shouldAcceptFile = defFile->LoadPNGDef(path, processDir, file.outBasename);
+        }
+        else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
+        {
+            shouldAcceptFile = defFile->LoadImage(path, processDir, file.outBasename);
+        }
+        else
+        {
+            justCopyList.push_back(&file);
+        }
+
+        if (shouldAcceptFile)
+        {
+            definitionFileList.push_back(defFile);
+        }
+    }
+
+    if (!definitionFileList.empty())
+    {
+        TexturePacker packer;
+        packer.SetConvertQuality(quality);
+
+        if (isLightmapsPacking)
+        {
+            packer.SetUseOnlySquareTextures();
+            packer.SetMaxTextureSize(2048);
+        }
+        else
+        {
+            if (CommandLineParser::Instance()->IsFlagSet("--square"))
+            {
+                packer.SetUseOnlySquareTextures();
+            }
+            packer.SetMaxTextureSize(maxTextureSize);
+        }
+
+        packer.SetTwoSideMargin(useTwoSideMargin);
+        packer.SetTexturesMargin(marginInPixels);
+        packer.SetAlgorithms(packAlgorithms);
+        if (sortOrders.empty() == false)
+        {
+            packer.SetSortOrders(sortOrders);
+        }
+        packer.SetTexturePostfix(texturePostfix);
+        packer.SetParallelAlgorithms(parallelAlgorithms);
+
+        if (CommandLineParser::Instance()->IsFlagSet("--split"))
+        {
+            packer.PackToTexturesSeparate(outputDir, definitionFileList, requestedGPUs);
+        }
+        else
+        {
+            packer.PackToTextures(outputDir, definitionFileList, requestedGPUs);
+        }
+
+        Set<String> currentErrors = packer.GetErrors();
+        if (!currentErrors.empty())
+        {
+            LockGuard<Mutex> lock(errorsMutex);
+            errors.insert(currentErrors.begin(), currentErrors.end());
+        }
+    }
+
+    for (const PackDirectoryTask::File* file : justCopyList)
+    {
+        FilePath srcPath = inputDir + file->name;
+        FilePath destPath = outputDir + file->outName;
+        if (!FileSystem::Instance()->CopyFile(srcPath, destPath))
+        {
+            Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
+        }
+    }
+
+    packTime = SystemTimer::GetMs() - packTime;
+
+    if (Engine::Instance()->IsConsoleMode())
+    {
+        Logger::Info("[%u files packed with flags: %s]", static_cast<uint32>(definitionFileList.size()), task.mergedFlags.c_str());
+    }
+
+    const char* result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
+    Logger::Info("[%s - %.2lf secs] - %s", inputDir.GetAbsolutePathname().c_str(),
+                 static_cast<float64>(packTime) / 1000.0, result);
+}
+
 void ResourcePacker2D::SetCacheClient(AssetCacheClient* cacheClient_, const String& comment)
 {
     cacheClient = cacheClient_;
@@ -728,6 +885,16 @@ void ResourcePacker2D::SetIgnoresFile(const String& ignoresPath)
     ignoresListPath = ignoresPath;
 }
 
+void ResourcePacker2D::SetMaxThreads(uint32 count)
+{
+    maxThreads = count;
+}
+
+void ResourcePacker2D::SetMaxImagesInFlightSize(uint64 size)
+{
+    maxImagesInFlightSize = size;
+}
+
 bool ResourcePacker2D::GetFilesFromCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath)
 {
 #ifdef __DAVAENGINE_WIN_UAP__
@@ -829,6 +996,8 @@ const Set<String>& ResourcePacker2D::GetErrors() const
 void ResourcePacker2D::AddError(const String& errorMsg)
 {
     Logger::Error(errorMsg.c_str());
+
+    LockGuard<Mutex> lock(errorsMutex);
     errors.insert(errorMsg);
 }
 
@@ -118,7 +118,9 @@ void TexturePacker::SaveResultSheets(const FilePath& outputPath, const char* bas
     Vector<ImageExt> finalImages(packResult.resultSheets.size());
     for (uint32 i = 0; i < finalImages.size(); ++i)
     {
-        finalImages[i].Create(packResult.resultSheets[i]->GetRect().dx, packResult.resultSheets[i]->GetRect().dy);
+        const std::unique_ptr<SpritesheetLayout>& sheet = packResult.resultSheets[i];
+        finalImages[i].Create(sheet->GetRect().dx, sheet->GetRect().dy);
+        Logger::FrameworkDebug("* Texture %u: %dx%d, occupancy %.1f%%", i, sheet->GetRect().dx, sheet->GetRect().dy, sheet->GetOccupancy() * 100.f);
     }
 
     for (const RectanglePacker::SpriteIndexedData& spriteIndexedData : packResult.resultIndexedSprites)
@@ -3,9 +3,11 @@
 
 #include "TextureCompression/TextureConverter.h"
 #include "Math/RectanglePacker/Spritesheet.h"
+#include "Math/RectanglePacker/RectanglePacker.h"
 #include "AssetCache/AssetCacheClient.h"
 
 #include <Base/BaseTypes.h>
+#include <Concurrency/Mutex.h>
 #include <Render/RenderBase.h>
 #include <FileSystem/FilePath.h>
 
@@ -40,6 +42,18 @@ public:
     void SetAllTags(const Vector<String>& tags);
     void SetIgnoresFile(const String& ignoresPath);
 
+    /**
+        Set count of directories packed simultaneously. 0 means count of CPU cores, 1 means serial packing.
+        Changed directories are found and taken from cache by calling thread, then they are packed independently
+        on JobManager worker threads, so result doesn't depend on threads count.
+    */
+    void SetMaxThreads(uint32 count);
+    /**
+        Limit summary size of decoded RGBA8888 source images of directories which are packed simultaneously.
+        Size is estimated from image headers. Directory with larger images is packed only when no other directory is packed.
+    */
+    void SetMaxImagesInFlightSize(uint64 size);
+
     void PackResources(const Vector<eGPUFamily>& forGPUs);
 
     const Set<String>& GetErrors() const;
@@ -57,7 +71,30 @@ private:
 
     void AddError(const String& errorMsg);
 
+    struct PackDirectoryTask
+    {
+        struct File
+        {
+            FilePath path;
+            String name;
+            String ext;
+            String outName;
+            String outBasename;
+        };
+
+        FilePath inputDir;
+        FilePath outputDir;
+        FilePath processDir;
+        Vector<String> flags;
+        String mergedFlags;
+        Vector<File> files;
+        uint64 imagesMemorySize = 0; // estimated size of decoded images
+        AssetCache::CacheItemKey cacheKey;
+    };
+
     void PackRecursively(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& flags = Vector<String>());
+    void PackDirectories(const Vector<PackingAlgorithm>& packAlgorithms);
+    void PackDirectory(const PackDirectoryTask& task, const Vector<PackingAlgorithm>& packAlgorithms, bool parallelAlgorithms);
 
     bool GetFilesFromCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
     bool AddFilesToCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
@@ -88,6 +125,12 @@ private:
     Vector<String> allTags;
 
     Set<String> errors;
+    Mutex errorsMutex;
+
+    Vector<PackDirectoryTask> packTasks;
+    Vector<SpriteSortOrder> sortOrders;
+    uint32 maxThreads = 0;
+    uint64 maxImagesInFlightSize = 512 * 1024 * 1024;
 
     std::atomic<bool> cancelled = { false };
 };
@@ -55,8 +55,10 @@ public:
     void SetUseOnlySquareTextures(bool value = true);
     void SetMaxTextureSize(uint32 maxTextureSize);
     void SetAlgorithms(const Vector<PackingAlgorithm>& algorithms);
+    void SetSortOrders(const Vector<SpriteSortOrder>& orders);
     void SetTwoSideMargin(bool val = true);
     void SetTexturesMargin(uint32 margin);
+    void SetParallelAlgorithms(bool value);
     const Set<String>& GetErrors() const;
 
 private:
@@ -114,6 +116,10 @@ inline void TexturePacker::SetAlgorithms(const Vector<PackingAlgorithm>& value)
 {
     rectanglePacker.SetAlgorithms(value);
 }
+inline void TexturePacker::SetSortOrders(const Vector<SpriteSortOrder>& value)
+{
+    rectanglePacker.SetSortOrders(value);
+}
 inline void TexturePacker::SetTwoSideMargin(bool value)
 {
     rectanglePacker.SetTwoSideMargin(value);
@@ -122,4 +128,8 @@ inline void TexturePacker::SetTexturesMargin(uint32 value)
 {
     rectanglePacker.SetTexturesMargin(value);
 }
+inline void TexturePacker::SetParallelAlgorithms(bool value)
+{
+    rectanglePacker.SetParallelAlgorithms(value);
+}
 };
@@ -3,7 +3,9 @@
 #include "PrintHelpers.h"
 
 #include <AssetCache/CachedItemValue.h>
+#include <AssetCache/ChunkSplitter.h>
 
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/File.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/KeyedArchive.h>
@@ -13,7 +15,8 @@
 #include <Logger/Logger.h>
 
 const DAVA::String CacheDB::DB_FILE_NAME = "cache.dat";
-const DAVA::uint32 CacheDB::VERSION = 1;
+const DAVA::String CacheDB::CHUNKS_FOLDER_NAME = "chunks/";
+const DAVA::uint32 CacheDB::VERSION = 2; // 2: values are stored in chunk storage, 1: values are stored as folders with files
 
 CacheDB::CacheDB(CacheDBOwner& _owner)
     : owner(_owner)
@@ -48,6 +51,7 @@ void CacheDB::UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint6
 
         cacheRootFolder = newCacheRootFolder;
         cacheSettings = cacheRootFolder + DB_FILE_NAME;
+        chunkStorage.SetFolder(cacheRootFolder + CHUNKS_FOLDER_NAME);
 
         Load();
         fullCacheChanged = true;
@@ -102,7 +106,8 @@ void CacheDB::Load()
         return;
     }
 
-    if (header->GetUInt32("version") != VERSION)
+    DAVA::uint32 version = header->GetUInt32("version");
+    if (version != VERSION && version != 1)
     {
         DVASSERT(false, "cachedb file version is changed. Versions load functions should be implemented");
         return;
@@ -130,7 +135,17 @@ void CacheDB::Load()
         ServerCacheEntry entry;
         entry.Deserialize(itemArchieve);
 
-        occupiedSize += entry.GetValue().GetSize();
+        if (entry.GetChunks().empty())
+        {
+            occupiedSize += entry.GetValue().GetSize();
+        }
+        else
+        {
+            for (const DAVA::AssetCache::ChunkSplitter::ContentChunk& chunk : entry.GetChunks())
+            {
+                occupiedSize += chunkStorage.Restore(chunk);
+            }
+        }
         fullCache[key] = std::move(entry);
     }
 
@@ -149,6 +164,7 @@ void CacheDB::Unload()
 
     fastCache.clear();
     fullCache.clear();
+    chunkStorage.Clear();
     occupiedSize = 0;
     NotifySizeChanged();
 }
@@ -240,9 +256,17 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
         entry = FindInFullCache(key);
         if (nullptr != entry)
         {
-            const DAVA::FilePath path = CreateFolderPath(key);
+            bool fetched = false;
+            if (entry->GetChunks().empty())
+            {
+                fetched = entry->Fetch(CreateFolderPath(key));
+            }
+            else
+            {
+                fetched = entry->Fetch(chunkStorage);
+            }
 
-            if (true == entry->Fetch(path))
+            if (true == fetched)
             {
                 InsertInFastCache(key, entry);
             }
@@ -301,13 +325,13 @@ void CacheDB::ClearStorage()
     ReduceFullCacheToSize(0);
 }
 
-void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, const DAVA::AssetCache::CachedItemValue& value)
+bool CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, const DAVA::AssetCache::CachedItemValue& value)
 {
     ServerCacheEntry entry(value);
-    Insert(key, std::forward<ServerCacheEntry>(entry));
+    return Insert(key, std::forward<ServerCacheEntry>(entry));
 }
 
-void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry)
+bool CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry)
 {
     if (entry.GetValue().GetSize() > maxStorageSize)
     {
@@ -315,7 +339,7 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
         {
             DAVA::Logger::Warning("Inserted data size %llu is bigger than max storage size %llu", entry.GetValue().GetSize(), maxStorageSize);
         }
-        return;
+        return false;
     }
 
     auto found = fullCache.find(key);
@@ -327,10 +351,33 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     DAVA::Logger::Debug("Inserting into cache: key %s", Brief(key).c_str());
     fullCache[key] = std::move(entry);
     ServerCacheEntry* insertedEntry = &fullCache[key];
-    DAVA::FilePath savedPath = CreateFolderPath(key);
-    insertedEntry->GetValue().ExportToFolder(savedPath);
+
+    // serialized value is stored by content chunks, so values sharing data with already stored ones occupy only difference
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> serializedData(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+    insertedEntry->GetValue().Serialize(serializedData);
+    const DAVA::Vector<DAVA::uint8>& data = serializedData->GetDataVector();
+
+    DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk> chunks = DAVA::AssetCache::ChunkSplitter::SplitByContent(data.data(), data.size());
+    const DAVA::uint8* chunkData = data.data();
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (chunkStorage.Put(chunks[i], chunkData, occupiedSize) == false)
+        {
+            // entry isn't published with chunks which are absent on disk
+            for (size_t j = 0; j < i; ++j)
+            {
+                occupiedSize -= chunkStorage.Release(chunks[j]);
+            }
+            fullCache.erase(key);
+            NotifySizeChanged();
+            dbStateChanged = true;
+            DAVA::Logger::Error("Cannot store data of key %s", Brief(key).c_str());
+            return false;
+        }
+        chunkData += chunks[i].size;
+    }
+    insertedEntry->SetChunks(std::move(chunks));
     insertedEntry->UpdateAccessTimestamp();
-    occupiedSize += insertedEntry->GetValue().GetSize();
     NotifySizeChanged();
 
     InsertInFastCache(key, insertedEntry);
@@ -342,6 +389,7 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     }
 
     dbStateChanged = true;
+    return true;
 }
 
 void CacheDB::InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry)
@@ -409,10 +457,21 @@ void CacheDB::RemoveFromFullCache(const CacheMap::iterator& it)
 {
     DVASSERT(it != fullCache.end());
 
-    DAVA::FilePath dataPath = CreateFolderPath(it->first);
-    DAVA::FileSystem::Instance()->DeleteDirectory(dataPath);
+    DAVA::uint64 itemSize = 0;
+    if (it->second.GetChunks().empty())
+    {
+        DAVA::FilePath dataPath = CreateFolderPath(it->first);
+        DAVA::FileSystem::Instance()->DeleteDirectory(dataPath);
+        itemSize = it->second.GetValue().GetSize();
+    }
+    else
+    {
+        for (const DAVA::AssetCache::ChunkSplitter::ContentChunk& chunk : it->second.GetChunks())
+        {
+            itemSize += chunkStorage.Release(chunk);
+        }
+    }
 
-    DAVA::uint64 itemSize = it->second.GetValue().GetSize();
     DVASSERT(itemSize <= occupiedSize);
     occupiedSize -= itemSize;
     DAVA::Logger::Debug("Removing from full cache: key %s", Brief(it->first).c_str());
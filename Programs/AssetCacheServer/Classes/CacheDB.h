@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AssetCache/CacheItemKey.h>
+#include <AssetCache/ChunkStorage.h>
 
 #include <Base/BaseTypes.h>
 #include <FileSystem/FilePath.h>
@@ -25,6 +26,7 @@ struct CacheDBOwner
 class CacheDB final
 {
     static const DAVA::String DB_FILE_NAME;
+    static const DAVA::String CHUNKS_FOLDER_NAME;
     static const DAVA::uint32 VERSION;
 
     using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
@@ -41,7 +43,7 @@ public:
 
     ServerCacheEntry* Get(const DAVA::AssetCache::CacheItemKey& key);
 
-    void Insert(const DAVA::AssetCache::CacheItemKey& key, const DAVA::AssetCache::CachedItemValue& value);
+    bool Insert(const DAVA::AssetCache::CacheItemKey& key, const DAVA::AssetCache::CachedItemValue& value);
     bool Remove(const DAVA::AssetCache::CacheItemKey& key);
     void ClearStorage();
     void UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key);
@@ -51,10 +53,12 @@ public:
     const DAVA::uint64 GetAvailableSize() const;
     const DAVA::uint64 GetOccupiedSize() const;
 
+    const DAVA::AssetCache::ChunkStorage& GetChunkStorage() const;
+
     void Update();
 
 private:
-    void Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry);
+    bool Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry);
 
     DAVA::FilePath CreateFolderPath(const DAVA::AssetCache::CacheItemKey& key) const;
 
@@ -87,7 +91,7 @@ private:
     DAVA::uint64 maxStorageSize = 0; //maximum cache size
     DAVA::uint32 maxItemsInMemory = 0; //count of items in memory, to use for fast access
 
-    DAVA::uint64 occupiedSize = 0; //used by CacheItemValues
+    DAVA::uint64 occupiedSize = 0; //used by CacheItemValues, chunks shared by several values are counted once
     DAVA::uint64 nextItemID = 0; //item counter, used as last access time token
 
     DAVA::uint64 autoSaveTimeout = 0;
@@ -95,6 +99,7 @@ private:
 
     FastCacheMap fastCache; //runtime, week storage
     CacheMap fullCache; //stored on disk, strong storage
+    DAVA::AssetCache::ChunkStorage chunkStorage; //content of values, stored on disk
 
     std::atomic<bool> dbStateChanged; //flag about changes in db
 };
@@ -113,3 +118,8 @@ inline const DAVA::uint64 CacheDB::GetOccupiedSize() const
 {
     return occupiedSize;
 }
+
+inline const DAVA::AssetCache::ChunkStorage& CacheDB::GetChunkStorage() const
+{
+    return chunkStorage;
+}
@@ -1,9 +1,17 @@
 #include "ServerCacheEntry.h"
 
+#include <AssetCache/ChunkStorage.h>
+
+#include "FileSystem/DynamicMemoryFile.h"
 #include "FileSystem/KeyedArchive.h"
 
 #include "Debug/DVAssert.h"
 
+namespace ServerCacheEntryDetails
+{
+const DAVA::int32 CHUNK_RECORD_SIZE = DAVA::MD5::MD5Digest::DIGEST_SIZE + sizeof(DAVA::uint32);
+}
+
 ServerCacheEntry::ServerCacheEntry()
 {
 }
@@ -15,6 +23,7 @@ ServerCacheEntry::ServerCacheEntry(const DAVA::AssetCache::CachedItemValue& _val
 
 ServerCacheEntry::ServerCacheEntry(ServerCacheEntry&& right)
     : value(std::move(right.value))
+    , chunks(std::move(right.chunks))
     , accessTimestamp(right.accessTimestamp)
 {
 }
@@ -24,6 +33,7 @@ ServerCacheEntry& ServerCacheEntry::operator=(ServerCacheEntry&& right)
     if (this != &right)
     {
         value = std::move(right.value);
+        chunks = std::move(right.chunks);
         accessTimestamp = right.accessTimestamp;
     }
 
@@ -44,6 +54,19 @@ void ServerCacheEntry::Serialize(DAVA::KeyedArchive* archieve) const
     DAVA::ScopedPtr<DAVA::KeyedArchive> valueArchieve(new DAVA::KeyedArchive());
     value.Serialize(valueArchieve, false);
     archieve->SetArchive("value", valueArchieve);
+
+    if (chunks.empty() == false)
+    {
+        DAVA::Vector<DAVA::uint8> chunksData(chunks.size() * ServerCacheEntryDetails::CHUNK_RECORD_SIZE);
+        DAVA::uint8* record = chunksData.data();
+        for (const DAVA::AssetCache::ChunkSplitter::ContentChunk& chunk : chunks)
+        {
+            Memcpy(record, chunk.hash.digest.data(), DAVA::MD5::MD5Digest::DIGEST_SIZE);
+            Memcpy(record + DAVA::MD5::MD5Digest::DIGEST_SIZE, &chunk.size, sizeof(chunk.size));
+            record += ServerCacheEntryDetails::CHUNK_RECORD_SIZE;
+        }
+        archieve->SetByteArray("chunks", chunksData.data(), static_cast<DAVA::int32>(chunksData.size()));
+    }
 }
 
 void ServerCacheEntry::Deserialize(DAVA::KeyedArchive* archieve)
@@ -55,6 +78,26 @@ void ServerCacheEntry::Deserialize(DAVA::KeyedArchive* archieve)
     DAVA::KeyedArchive* valueArchieve = archieve->GetArchive("value");
     DVASSERT(valueArchieve);
     value.Deserialize(valueArchieve);
+
+    chunks.clear();
+    DAVA::int32 chunksDataSize = archieve->GetByteArraySize("chunks");
+    const DAVA::uint8* record = archieve->GetByteArray("chunks");
+    if (chunksDataSize > 0 && record != nullptr)
+    {
+        DVASSERT(chunksDataSize % ServerCacheEntryDetails::CHUNK_RECORD_SIZE == 0);
+        chunks.resize(chunksDataSize / ServerCacheEntryDetails::CHUNK_RECORD_SIZE);
+        for (DAVA::AssetCache::ChunkSplitter::ContentChunk& chunk : chunks)
+        {
+            Memcpy(chunk.hash.digest.data(), record, DAVA::MD5::MD5Digest::DIGEST_SIZE);
+            Memcpy(&chunk.size, record + DAVA::MD5::MD5Digest::DIGEST_SIZE, sizeof(chunk.size));
+            record += ServerCacheEntryDetails::CHUNK_RECORD_SIZE;
+        }
+    }
+}
+
+void ServerCacheEntry::SetChunks(DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk>&& chunks_)
+{
+    chunks = std::move(chunks_);
 }
 
 bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder)
@@ -62,6 +105,30 @@ bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder)
     return value.Fetch(folder);
 }
 
+bool ServerCacheEntry::Fetch(const DAVA::AssetCache::ChunkStorage& storage)
+{
+    DVASSERT(chunks.empty() == false);
+
+    DAVA::Vector<DAVA::uint8> serializedData;
+    for (const DAVA::AssetCache::ChunkSplitter::ContentChunk& chunk : chunks)
+    {
+        if (storage.Read(chunk, serializedData) == false)
+        {
+            return false;
+        }
+    }
+
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> file(DAVA::DynamicMemoryFile::Create(std::move(serializedData), DAVA::File::OPEN | DAVA::File::READ, DAVA::FilePath()));
+    DAVA::AssetCache::CachedItemValue fetchedValue;
+    if (fetchedValue.Deserialize(file) == false || fetchedValue.IsFetched() == false)
+    {
+        return false;
+    }
+
+    value = std::move(fetchedValue);
+    return true;
+}
+
 void ServerCacheEntry::Free()
 {
     value.Free();
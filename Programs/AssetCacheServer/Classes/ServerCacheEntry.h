@@ -1,12 +1,17 @@
 #pragma once
 
 #include <AssetCache/CachedItemValue.h>
+#include <AssetCache/ChunkSplitter.h>
 #include <Base/BaseTypes.h>
 #include <chrono>
 
 namespace DAVA
 {
 class KeyedArchive;
+namespace AssetCache
+{
+class ChunkStorage;
+}
 }
 
 class ServerCacheEntry final
@@ -33,11 +38,16 @@ public:
 
     DAVA::AssetCache::CachedItemValue& GetValue();
 
+    void SetChunks(DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk>&& chunks);
+    const DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk>& GetChunks() const;
+
     bool Fetch(const DAVA::FilePath& folder);
+    bool Fetch(const DAVA::AssetCache::ChunkStorage& storage);
     void Free();
 
 private:
     DAVA::AssetCache::CachedItemValue value;
+    DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk> chunks; // serialized value split by content, empty for entries stored as folder with files
 
 private:
     DAVA::uint64 accessTimestamp = 0;
@@ -57,3 +67,8 @@ inline DAVA::AssetCache::CachedItemValue& ServerCacheEntry::GetValue()
 {
     return value;
 }
+
+inline const DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk>& ServerCacheEntry::GetChunks() const
+{
+    return chunks;
+}
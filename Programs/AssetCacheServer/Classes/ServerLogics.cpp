@@ -25,6 +25,12 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
     DAVA::List<DataAddTask>::iterator it = GetOrCreateAddTask(channel, key);
     DataAddTask& task = *it;
 
+    if (task.contentChunks.empty() == false)
+    {
+        OnAddContentChunkToCache(it, chunkNumber, chunkData);
+        return;
+    }
+
     auto DiscardTask = [&]()
     {
         DAVA::Logger::Debug("Sending 'add data chunk failed' response");
@@ -92,34 +98,213 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
             return;
         }
 
-        AssetCache::CachedItemValue value;
-        task.receivedData->Seek(0, File::SEEK_FROM_START);
-        value.Deserialize(task.receivedData);
-        if (value.IsEmpty() || !value.IsValid())
+        if (InsertReceivedData(task) == false)
         {
-            Error("Received data is empty or invalid");
+            DiscardTask();
             return;
         }
 
-        AssetCache::CachedItemValue::Description description = value.GetDescription();
-        description.addingChain += "/" + serverName;
-        value.SetDescription(description);
+        dataAddTasks.erase(it);
+    }
+
+    DAVA::Logger::Debug("Sending 'chunk successfully added' response");
+    serverProxy->SendAddedToCache(channel, key, true);
+}
+
+void ServerLogics::OnAddChunkListToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, const DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk>& chunks)
+{
+    hasIncomingRequestsRecently = true;
+
+    using namespace DAVA;
+
+    DAVA::List<DataAddTask>::iterator it = GetOrCreateAddTask(channel, key);
+    DataAddTask& task = *it;
 
-        if (value.GetSize() > dataBase->GetStorageSize())
+    auto Error = [&](const char* err)
+    {
+        Logger::Error("Wrong request: %s. Client %p, key %s", err, channel.get(), Brief(key).c_str());
+        serverProxy->SendAddedToCache(channel, key, false);
+        dataAddTasks.erase(it);
+    };
+
+    Logger::Debug("Receiving add chunk list request: key %s, %llu bytes, %u chunks", Brief(key).c_str(), dataSize, static_cast<uint32>(chunks.size()));
+
+    if (task.chunksOverall != 0 || task.bytesOverall != 0 || task.contentChunks.empty() == false)
+    {
+        Error("add data info was already received with given key and channel");
+        return;
+    }
+
+    uint64 chunksSize = 0;
+    for (const AssetCache::ChunkSplitter::ContentChunk& chunk : chunks)
+    {
+        chunksSize += chunk.size;
+    }
+
+    if (dataSize == 0 || chunks.empty() || chunksSize != dataSize)
+    {
+        Error("data size doesn't match chunks");
+        return;
+    }
+
+    if (dataSize > dataBase->GetStorageSize())
+    {
+        Logger::Warning("Inserted data size %llu is bigger than max storage size %llu", dataSize, dataBase->GetStorageSize());
+        Error("data is too big");
+        return;
+    }
+
+    const AssetCache::ChunkStorage& chunkStorage = dataBase->GetChunkStorage();
+
+    Vector<uint32> missingChunks;
+    UnorderedMap<MD5::MD5Digest, uint32, AssetCache::ChunkStorage::DigestHasher> firstOccurrences;
+    firstOccurrences.reserve(chunks.size());
+    task.contentChunksExpected.resize(chunks.size(), false);
+    task.contentChunksFirstOccurrence.resize(chunks.size());
+    for (uint32 i = 0, count = static_cast<uint32>(chunks.size()); i < count; ++i)
+    {
+        // same chunk may occur several times in value, it is requested once
+        auto inserted = firstOccurrences.emplace(chunks[i].hash, i);
+        task.contentChunksFirstOccurrence[i] = inserted.first->second;
+        if (inserted.second && chunkStorage.Has(chunks[i].hash) == false)
         {
-            Logger::Warning("Inserted data size %u is bigger than max storage size %u", value.GetSize(), dataBase->GetStorageSize());
-            DiscardTask();
-            return;
+            missingChunks.push_back(i);
+            task.contentChunksExpected[i] = true;
         }
+    }
 
-        dataBase->Insert(key, value);
+    task.contentChunks = chunks;
+    task.contentChunksData.resize(chunks.size());
+    task.bytesOverall = static_cast<size_t>(dataSize);
+    task.chunksOverall = static_cast<uint32>(missingChunks.size());
+
+    if (missingChunks.empty())
+    {
+        // all chunks are stored already, so final status is sent instead of missing chunks
+        bool inserted = InsertReceivedData(task);
+        Logger::Debug("Sending 'add data' response without chunks: %s", inserted ? "added" : "failed");
+        serverProxy->SendAddedToCache(channel, key, inserted);
         dataAddTasks.erase(it);
-        dataRemoteAddTasks.emplace(key, DataRemoteAddTask());
-        DAVA::Logger::Debug("Adding remote add task. Tasks now: %u", dataRemoteAddTasks.size());
+        return;
     }
 
-    DAVA::Logger::Debug("Sending 'chunk successfully added' response");
-    serverProxy->SendAddedToCache(channel, key, true);
+    Logger::Debug("Sending missing chunks: %u of %u", task.chunksOverall, static_cast<uint32>(chunks.size()));
+    serverProxy->SendMissingChunks(channel, key, missingChunks);
+}
+
+void ServerLogics::OnAddContentChunkToCache(DAVA::List<DataAddTask>::iterator it, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunkData)
+{
+    using namespace DAVA;
+
+    DataAddTask& task = *it;
+    std::shared_ptr<Net::IChannel> channel = task.channel;
+    AssetCache::CacheItemKey key = task.key;
+
+    auto Error = [&](const char* err)
+    {
+        Logger::Error("Wrong request: %s. Client %p, key %s chunk#%u", err, channel.get(), Brief(key).c_str(), chunkNumber);
+        serverProxy->SendAddedToCache(channel, key, false);
+        dataAddTasks.erase(it);
+    };
+
+    if (chunkNumber >= task.contentChunks.size() || task.contentChunksExpected[chunkNumber] == false)
+    {
+        Error("chunk was not requested");
+        return;
+    }
+
+    const AssetCache::ChunkSplitter::ContentChunk& chunk = task.contentChunks[chunkNumber];
+    if (chunkData.size() != chunk.size)
+    {
+        Error(Format("chunk of %u bytes was expected", chunk.size).c_str());
+        return;
+    }
+
+    MD5::MD5Digest hash;
+    MD5::ForData(chunkData.data(), static_cast<uint32>(chunkData.size()), hash);
+    if (!(hash == chunk.hash))
+    {
+        Error("chunk hash mismatch");
+        return;
+    }
+
+    task.contentChunksExpected[chunkNumber] = false;
+    task.contentChunksData[chunkNumber] = chunkData;
+    task.bytesReceived += chunkData.size();
+    ++task.chunksReceived;
+
+    if (task.chunksReceived == task.chunksOverall)
+    {
+        bool inserted = InsertReceivedData(task);
+        Logger::Debug("Sending 'add data' response: %s", inserted ? "added" : "failed");
+        serverProxy->SendAddedToCache(channel, key, inserted);
+        dataAddTasks.erase(it);
+    }
+}
+
+bool ServerLogics::InsertReceivedData(DataAddTask& task)
+{
+    using namespace DAVA;
+
+    if (task.contentChunks.empty() == false)
+    { // assemble serialized value from received chunks and chunks found in storage
+        const AssetCache::ChunkStorage& chunkStorage = dataBase->GetChunkStorage();
+
+        Vector<uint8> data;
+        data.reserve(task.bytesOverall);
+        for (size_t i = 0; i < task.contentChunks.size(); ++i)
+        {
+            const AssetCache::ChunkSplitter::ContentChunk& chunk = task.contentChunks[i];
+            if (task.contentChunksData[i].empty() == false)
+            {
+                data.insert(data.end(), task.contentChunksData[i].begin(), task.contentChunksData[i].end());
+                continue;
+            }
+
+            uint32 receivedIndex = task.contentChunksFirstOccurrence[i];
+            if (receivedIndex < i && task.contentChunksData[receivedIndex].empty() == false)
+            {
+                data.insert(data.end(), task.contentChunksData[receivedIndex].begin(), task.contentChunksData[receivedIndex].end());
+            }
+            else if (chunkStorage.Read(chunk, data) == false)
+            {
+                Logger::Error("Chunk #%u of key %s is absent in storage", static_cast<uint32>(i), Brief(task.key).c_str());
+                return false;
+            }
+        }
+
+        task.receivedData->Truncate(0);
+        task.receivedData->Write(data.data(), static_cast<uint32>(data.size()));
+        task.contentChunksData.clear();
+    }
+
+    AssetCache::CachedItemValue value;
+    task.receivedData->Seek(0, File::SEEK_FROM_START);
+    value.Deserialize(task.receivedData);
+    if (value.IsEmpty() || !value.IsValid())
+    {
+        Logger::Error("Received data is empty or invalid. Client %p, key %s", task.channel.get(), Brief(task.key).c_str());
+        return false;
+    }
+
+    AssetCache::CachedItemValue::Description description = value.GetDescription();
+    description.addingChain += "/" + serverName;
+    value.SetDescription(description);
+
+    if (value.GetSize() > dataBase->GetStorageSize())
+    {
+        Logger::Warning("Inserted data size %u is bigger than max storage size %u", value.GetSize(), dataBase->GetStorageSize());
+        return false;
+    }
+
+    if (dataBase->Insert(task.key, value) == false)
+    {
+        return false;
+    }
+
+    dataRemoteAddTasks.emplace(task.key, DataRemoteAddTask());
+    DAVA::Logger::Debug("Adding remote add task. Tasks now: %u", dataRemoteAddTasks.size());
+    return true;
 }
 
 DAVA::List<ServerLogics::DataAddTask>::iterator ServerLogics::GetOrCreateAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key)
@@ -274,7 +459,7 @@ void ServerLogics::OnStatusRequested(const std::shared_ptr<DAVA::Net::IChannel>&
     hasIncomingRequestsRecently = true;
 
     DAVA::Logger::Debug("Received status request from channel %p", channel.get());
-    serverProxy->SendStatus(channel);
+    serverProxy->SendStatus(channel, DAVA::AssetCache::CAPABILITY_CONTENT_CHUNKS);
 }
 
 void ServerLogics::OnChannelClosed(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::char8*)
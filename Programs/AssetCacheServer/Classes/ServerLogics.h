@@ -18,6 +18,7 @@ public:
 
     //ServerNetProxyListener
     void OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, DAVA::uint32 numOfChunks, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunkData) override;
+    void OnAddChunkListToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, const DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk>& chunks) override;
     void OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkNumber) override;
     void OnRemoveFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key) override;
     void OnClearCache(const std::shared_ptr<DAVA::Net::IChannel>& channel) override;
@@ -71,6 +72,12 @@ private:
         size_t bytesOverall = 0;
         DAVA::uint32 chunksReceived = 0;
         DAVA::uint32 chunksOverall = 0;
+
+        // content chunks of value, filled for deduplicated adding only
+        DAVA::Vector<DAVA::AssetCache::ChunkSplitter::ContentChunk> contentChunks;
+        DAVA::Vector<DAVA::Vector<DAVA::uint8>> contentChunksData; // received data of missing chunks, empty for chunks taken from storage
+        DAVA::Vector<bool> contentChunksExpected;
+        DAVA::Vector<DAVA::uint32> contentChunksFirstOccurrence; // index of first chunk with the same hash
     };
 
     struct DataRemoteAddTask
@@ -95,6 +102,8 @@ private:
     bool IsRemoteServerConnected() const;
 
     DAVA::List<DataAddTask>::iterator GetOrCreateAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key);
+    void OnAddContentChunkToCache(DAVA::List<DataAddTask>::iterator taskIt, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunkData);
+    bool InsertReceivedData(DataAddTask& task);
     DataGetMap::iterator GetOrCreateGetTask(const DAVA::AssetCache::CacheItemKey& key);
     void RequestNextChunk(DataGetMap::iterator it);
     void SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk);
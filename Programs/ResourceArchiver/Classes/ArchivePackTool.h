@@ -27,4 +27,6 @@ private:
     DAVA::String packFileName;
     DAVA::String baseDir;
     DAVA::String metaDbPath;
+    DAVA::String basePackPath;
+    DAVA::uint64 maxMemorySize = 0;
 };
@@ -13,6 +13,8 @@ const DAVA::String Compression = "-compression";
 const DAVA::String BaseDir = "-basedir";
 const DAVA::String MetaDbFile = "-metadb";
 const DAVA::String DummyFileData = "-dummyFileData";
+const DAVA::String BasePack = "-basepack";
+const DAVA::String MaxMemory = "-maxmemory";
 }
 
 ArchivePackTool::ArchivePackTool()
@@ -23,6 +25,8 @@ ArchivePackTool::ArchivePackTool()
     options.AddOption(OptionNames::Compression, VariantType(String("lz4hc")), "default compression method, lz4hc - default");
     options.AddOption(OptionNames::BaseDir, VariantType(String("")), "source base directory");
     options.AddOption(OptionNames::MetaDbFile, VariantType(String("")), "sqlite db with metadata");
+    options.AddOption(OptionNames::BasePack, VariantType(String("")), "previous version of packfile, compressed data of unchanged files is copied from it");
+    options.AddOption(OptionNames::MaxMemory, VariantType(static_cast<uint32>(512)), "max size of source data in megabytes being compressed at the same time, 512 - default");
     options.AddOption(OptionNames::DummyFileData, VariantType(false), "write dummy single-byte files instead of actual file data, useful if you are interested in pack footer only");
     options.AddArgument("packfile");
 }
@@ -41,6 +45,14 @@ bool ArchivePackTool::ConvertOptionsToParamsInternal()
     compressionType = static_cast<Compressor::Type>(type);
 
     dummyFileData = options.GetOption(OptionNames::DummyFileData).AsBool();
+    basePackPath = options.GetOption(OptionNames::BasePack).AsString();
+
+    maxMemorySize = static_cast<uint64>(options.GetOption(OptionNames::MaxMemory).AsUInt32()) * 1024 * 1024;
+    if (maxMemorySize == 0)
+    {
+        Logger::Error("%s - param should be greater than zero", OptionNames::MaxMemory.c_str());
+        return false;
+    }
 
     baseDir = options.GetOption(OptionNames::BaseDir).AsString();
     if (baseDir.empty())
@@ -75,6 +87,11 @@ int ArchivePackTool::ProcessInternal()
     params.baseDirPath = (baseDir.empty() ? FileSystem::Instance()->GetCurrentWorkingDirectory() : baseDir);
     params.metaDbPath = metaDbPath;
     params.dummyFileData = dummyFileData;
+    params.maxBytesInFlight = maxMemorySize;
+    if (!basePackPath.empty())
+    {
+        params.basePackPath = basePackPath;
+    }
 
     if (!CreateArchive(params))
     {
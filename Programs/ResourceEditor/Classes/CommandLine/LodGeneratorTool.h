@@ -0,0 +1,32 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+
+#include <Render/3D/MeshSimplifier.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class LodGeneratorTool : public DAVA::CommandLineModule
+{
+public:
+    LodGeneratorTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void BeforeDestroyedInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::FilePath inFolder;
+    DAVA::FilePath dataSourceFolder;
+    DAVA::String filename;
+    DAVA::String foldername;
+
+    DAVA::MeshSimplifier::LodOptions lodOptions;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(LodGeneratorTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<LodGeneratorTool>::Begin()[DAVA::M::CommandName("-lodgenerator")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
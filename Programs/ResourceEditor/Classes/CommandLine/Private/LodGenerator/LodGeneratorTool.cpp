@@ -0,0 +1,152 @@
+#include "Classes/CommandLine/LodGeneratorTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+#include <REPlatform/CommandLine/SceneConsoleHelper.h>
+#include <REPlatform/DataNodes/ProjectManagerData.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Base/ScopedPtr.h>
+#include <FileSystem/FileList.h>
+#include <Logger/Logger.h>
+#include <Scene3D/Scene.h>
+#include <Time/SystemTimer.h>
+
+namespace LodGeneratorToolDetail
+{
+void CollectScenes(const DAVA::FilePath& folderPathname, DAVA::Vector<DAVA::FilePath>& scenes)
+{
+    using namespace DAVA;
+
+    DVASSERT(folderPathname.IsDirectoryPathname());
+
+    ScopedPtr<FileList> fileList(new FileList(folderPathname));
+    for (uint32 i = 0, count = fileList->GetCount(); i < count; ++i)
+    {
+        const FilePath& pathname = fileList->GetPathname(i);
+        if (fileList->IsDirectory(i))
+        {
+            if (!fileList->IsNavigationDirectory(i))
+            {
+                CollectScenes(pathname, scenes);
+            }
+        }
+        else if (pathname.IsEqualToExtension(".sc2") && pathname.GetAbsolutePathname().find(".exported.sc2") == String::npos)
+        {
+            scenes.push_back(pathname);
+        }
+    }
+}
+}
+
+LodGeneratorTool::LodGeneratorTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-lodgenerator")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::InDir, VariantType(String("")), "Path for Project/DataSource/3d/ folder");
+    options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Filename from DataSource/3d/ for lod generation");
+    options.AddOption(OptionName::ProcessDir, VariantType(String("")), "Foldername from DataSource/3d/ for lod generation");
+    options.AddOption(OptionName::Count, VariantType(uint32(2)), "Count of generated lods");
+    options.AddOption(OptionName::LodRatio, VariantType(0.5f), "Triangles ratio between neighbouring lods");
+    options.AddOption(OptionName::LodMaxError, VariantType(0.02f), "Max geometric error of the last lod relative to mesh size");
+}
+
+bool LodGeneratorTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    inFolder = options.GetOption(OptionName::InDir).AsString();
+    if (inFolder.IsEmpty())
+    {
+        Logger::Error("[LodGeneratorTool] Input folder was not selected");
+        return false;
+    }
+    inFolder.MakeDirectoryPathname();
+
+    dataSourceFolder = ProjectManagerData::GetDataSourcePath(inFolder);
+    if (dataSourceFolder.IsEmpty())
+    {
+        Logger::Error("[LodGeneratorTool] DataSource folder was not found");
+        return false;
+    }
+
+    filename = options.GetOption(OptionName::ProcessFile).AsString();
+    foldername = options.GetOption(OptionName::ProcessDir).AsString();
+    if (filename.empty() == foldername.empty())
+    {
+        Logger::Error("[LodGeneratorTool] Either filename or foldername should be selected");
+        return false;
+    }
+
+    lodOptions.lodCount = options.GetOption(OptionName::Count).AsUInt32();
+    lodOptions.lodRatio = options.GetOption(OptionName::LodRatio).AsFloat();
+    lodOptions.maxError = options.GetOption(OptionName::LodMaxError).AsFloat();
+    if (lodOptions.lodCount == 0 || lodOptions.lodRatio <= 0.f || lodOptions.lodRatio >= 1.f)
+    {
+        Logger::Error("[LodGeneratorTool] Wrong lods parameters: count should be positive, ratio should be in (0, 1) range");
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult LodGeneratorTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    FilePath::AddResourcesFolder(dataSourceFolder);
+
+    Vector<FilePath> scenes;
+    if (filename.empty() == false)
+    {
+        scenes.push_back(inFolder + filename);
+    }
+    else
+    {
+        FilePath folderPathname = inFolder + foldername;
+        folderPathname.MakeDirectoryPathname();
+        LodGeneratorToolDetail::CollectScenes(folderPathname, scenes);
+    }
+
+    // scenes are loaded one by one, geometry of each scene is simplified on all worker threads
+    for (const FilePath& scenePathname : scenes)
+    {
+        int64 startTime = SystemTimer::GetMs();
+
+        ScopedPtr<Scene> scene(new Scene());
+        if (SceneFileV2::ERROR_NO_ERROR != scene->LoadScene(scenePathname))
+        {
+            Logger::Error("[LodGeneratorTool] Can't open scene %s", scenePathname.GetAbsolutePathname().c_str());
+            continue;
+        }
+
+        uint32 objectsCount = MeshSimplifier::GenerateLodsRecursive(scene, lodOptions);
+        if (objectsCount > 0)
+        {
+            scene->SaveScene(scenePathname, false);
+        }
+
+        Logger::Info("[LodGeneratorTool] %s: lods generated for %u objects in %lld ms", scenePathname.GetAbsolutePathname().c_str(), objectsCount, SystemTimer::GetMs() - startTime);
+    }
+
+    FilePath::RemoveResourcesFolder(dataSourceFolder);
+
+    return DAVA::ConsoleModule::eFrameResult::FINISHED;
+}
+
+void LodGeneratorTool::BeforeDestroyedInternal()
+{
+    DAVA::SceneConsoleHelper::FlushRHI();
+}
+
+void LodGeneratorTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-lodgenerator -indir /Users/SmokeTest/DataSource/3d/ -processfile Objects/tank.sc2");
+    DAVA::Logger::Info("\t-lodgenerator -indir /Users/SmokeTest/DataSource/3d/ -processdir Objects/ -count 3 -lodratio 0.4 -lodmaxerror 0.05");
+}
+
+DECL_TARC_MODULE(LodGeneratorTool);
@@ -227,6 +227,7 @@ SceneExporterTool::SceneExporterTool(const DAVA::Vector<DAVA::String>& commandLi
     options.AddOption(OptionName::GPU, VariantType(String("origin")), "GPU family: PowerVR_iOS, PowerVR_Android, tegra, mali, adreno, origin, dx11. Can be multiple: -gpu mali,adreno,origin", true);
 
     options.AddOption(OptionName::SaveNormals, VariantType(false), "Disable removing of normals from vertexes");
+    options.AddOption(OptionName::OptimizeMeshes, VariantType(false), "Optimize meshes for vertex cache, overdraw and vertex fetch");
     options.AddOption(OptionName::HDTextures, VariantType(false), "Use 0-mip level as texture.hd.ext");
 
     options.AddOption(OptionName::Tag, VariantType(String("")), "Tag for filenames, example: .china. Will export texture.china.tex instead of texture.tex");
@@ -316,6 +317,7 @@ bool SceneExporterTool::PostInitInternal()
 
     const bool saveNormals = options.GetOption(OptionName::SaveNormals).AsBool();
     exportingParams.optimizeOnExport = !saveNormals;
+    exportingParams.optimizeMeshes = options.GetOption(OptionName::OptimizeMeshes).AsBool();
 
     useAssetCache = options.GetOption(OptionName::UseAssetCache).AsBool();
     if (useAssetCache)
@@ -439,6 +441,8 @@ void SceneExporterTool::ShowHelpInternal()
     DAVA::Logger::Info("\t-sceneexporter -texture -indir /Users/SmokeTest/DataSource/3d/ -outdir /Users/SmokeTest/Data/3d/ -processdir Maps/ -gpu adreno");
     DAVA::Logger::Info("\t-sceneexporter -scene -indir /Users/SmokeTest/DataSource/3d/ -output /Users/config.yaml -processdir Maps/");
 
+    DAVA::Logger::Info("\t-sceneexporter -scene -indir /Users/SmokeTest/DataSource/3d/ -outdir /Users/SmokeTest/Data/3d/ -processfile Maps/scene.sc2 -gpu adreno -optimizeMeshes");
+
     DAVA::Logger::Info("\t-sceneexporter -scene -indir /Users/SmokeTest/DataSource/3d/ -outdir /Users/SmokeTest/Data/3d/ -processfilelist /Users/files.txt -gpu adreno");
     DAVA::Logger::Info("\t-sceneexporter -texture -indir /Users/SmokeTest/DataSource/3d/ -outdir /Users/SmokeTest/Data/3d/ -processfilelist /Users/files.txt -gpu adreno,PowerVR_iOS -useCache -ip 127.0.0.1");
     DAVA::Logger::Info("\t-sceneexporter -texture -indir /Users/SmokeTest/DataSource/3d/ -output /Users/config.yaml -processfilelist /Users/files.txt -useCache -ip 127.0.0.1");
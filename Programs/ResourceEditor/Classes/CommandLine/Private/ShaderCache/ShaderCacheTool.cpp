@@ -0,0 +1,450 @@
+#include "Classes/CommandLine/ShaderCacheTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <AssetCache/AssetCache.h>
+#include <Base/ScopedPtr.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
+#include <Concurrency/Thread.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Platform/DeviceInfo.h>
+#include <Render/RHI/rhi_ShaderSource.h>
+#include <Time/DateTime.h>
+#include <Time/SystemTimer.h>
+#include <Utils/MD5.h>
+#include <Utils/StringFormat.h>
+#include <Utils/StringUtils.h>
+#include <Utils/UTF8Utils.h>
+#include <Utils/Utils.h>
+
+namespace ShaderCacheToolDetail
+{
+struct Variant
+{
+    DAVA::String shaderName;
+    DAVA::Vector<DAVA::String> defines; // name, value, name, value... sorted by name as ShaderDescriptorCache does
+};
+
+struct ShaderSourceText
+{
+    DAVA::String vertexProgText;
+    DAVA::String fragmentProgText;
+};
+
+struct TranslationJob
+{
+    const DAVA::String* sourceText = nullptr;
+    DAVA::String sourcePath;
+    const Variant* variant = nullptr;
+    rhi::ProgType progType = rhi::PROG_VERTEX;
+    rhi::Api api = rhi::RHI_GLES2;
+    DAVA::String key;
+};
+
+const DAVA::Array<std::pair<const char*, rhi::Api>, 4> apiNames =
+{ {
+{ "dx11", rhi::RHI_DX11 },
+{ "dx9", rhi::RHI_DX9 },
+{ "gles2", rhi::RHI_GLES2 },
+{ "metal", rhi::RHI_METAL },
+} };
+
+bool ParseApis(const DAVA::String& apiList, DAVA::Vector<rhi::Api>& apis)
+{
+    DAVA::Vector<DAVA::String> tokens;
+    DAVA::Split(apiList, ",", tokens);
+    for (const DAVA::String& token : tokens)
+    {
+        auto found = std::find_if(apiNames.begin(), apiNames.end(), [&token](const std::pair<const char*, rhi::Api>& api) {
+            return token == api.first;
+        });
+
+        if (found == apiNames.end())
+        {
+            DAVA::Logger::Error("[ShaderCacheTool] Unknown api %s", token.c_str());
+            return false;
+        }
+        apis.push_back(found->second);
+    }
+    return !apis.empty();
+}
+
+bool LoadVariants(const DAVA::FilePath& listPath, DAVA::Vector<Variant>& variants)
+{
+    using namespace DAVA;
+
+    ScopedPtr<File> file(File::Create(listPath, File::OPEN | File::READ));
+    if (!file)
+    {
+        Logger::Error("[ShaderCacheTool] Can't open variants list %s", listPath.GetStringValue().c_str());
+        return false;
+    }
+
+    while (!file->IsEof())
+    {
+        String line = StringUtils::Trim(file->ReadLine());
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        Vector<String> tokens;
+        Split(line, " \t", tokens);
+
+        Variant variant;
+        variant.shaderName = tokens[0];
+
+        Map<String, String> sortedDefines;
+        for (size_t i = 1; i < tokens.size(); ++i)
+        {
+            size_t separator = tokens[i].find('=');
+            if (separator == String::npos)
+            {
+                Logger::Error("[ShaderCacheTool] Wrong define %s in line '%s'", tokens[i].c_str(), line.c_str());
+                return false;
+            }
+            sortedDefines[tokens[i].substr(0, separator)] = tokens[i].substr(separator + 1);
+        }
+
+        for (const auto& define : sortedDefines)
+        {
+            variant.defines.push_back(define.first);
+            variant.defines.push_back(define.second);
+        }
+
+        variants.push_back(std::move(variant));
+    }
+
+    return true;
+}
+
+bool LoadText(const DAVA::FilePath& path, DAVA::String& text)
+{
+    using namespace DAVA;
+
+    ScopedPtr<File> file(File::Create(path, File::OPEN | File::READ));
+    if (!file)
+    {
+        Logger::Error("[ShaderCacheTool] Can't open shader source %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    text.resize(static_cast<size_t>(file->GetSize()));
+    return file->Read(&text[0], static_cast<uint32>(text.size())) == text.size();
+}
+
+DAVA::AssetCache::CacheItemKey GetCacheItemKey(const DAVA::String& translationKey)
+{
+    using namespace DAVA;
+
+    AssetCache::CacheItemKey key;
+
+    MD5::MD5Digest translationDigest;
+    MD5::CharToHash(translationKey.c_str(), translationDigest);
+    key.SetPrimaryKey(translationDigest);
+
+    // translation key already covers format version, api and source, secondary key separates translated shaders from other items
+    static const String params = "ResourceEditor ShaderCache";
+    MD5::MD5Digest paramsDigest;
+    MD5::ForData(reinterpret_cast<const uint8*>(params.data()), static_cast<uint32>(params.size()), paramsDigest);
+    key.SetSecondaryKey(paramsDigest);
+
+    return key;
+}
+}
+
+ShaderCacheTool::ShaderCacheTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-shadercache")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::ProcessFileList, VariantType(String("")), "Full pathname of the list of shader variants, e.g. ~doc:/ShaderVariants.txt saved by application");
+    options.AddOption(OptionName::OutDir, VariantType(String("")), "Full pathname of the translated shaders cache folder");
+    options.AddOption(OptionName::ResourceDir, VariantType(String("")), "Full pathname of the Data folder with shaders, ~res:/ is used by default");
+    options.AddOption(OptionName::Api, VariantType(String("dx11,gles2,metal")), "Comma separated list of target apis: dx11, dx9, gles2, metal");
+    options.AddOption(OptionName::Threads, VariantType(static_cast<uint32>(0)), "Count of translating threads, 0 means count of CPU cores");
+
+    options.AddOption(OptionName::UseAssetCache, VariantType(false), "Enables using AssetCache for translated shaders");
+    options.AddOption(OptionName::AssetCacheIP, VariantType(AssetCache::GetLocalHost()), "ip of adress of Asset Cache Server");
+    options.AddOption(OptionName::AssetCachePort, VariantType(static_cast<uint32>(AssetCache::ASSET_SERVER_PORT)), "port of adress of Asset Cache Server");
+    options.AddOption(OptionName::AssetCacheTimeout, VariantType(static_cast<uint32>(1)), "timeout for caching operations");
+}
+
+bool ShaderCacheTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    variantsListPath = options.GetOption(OptionName::ProcessFileList).AsString();
+    if (variantsListPath.IsEmpty())
+    {
+        Logger::Error("[ShaderCacheTool] List of shader variants was not selected");
+        return false;
+    }
+
+    cacheFolder = options.GetOption(OptionName::OutDir).AsString();
+    if (cacheFolder.IsEmpty())
+    {
+        Logger::Error("[ShaderCacheTool] Cache folder was not selected");
+        return false;
+    }
+    cacheFolder.MakeDirectoryPathname();
+
+    resourceFolder = options.GetOption(OptionName::ResourceDir).AsString();
+    if (!resourceFolder.IsEmpty())
+    {
+        resourceFolder.MakeDirectoryPathname();
+    }
+
+    if (!ShaderCacheToolDetail::ParseApis(options.GetOption(OptionName::Api).AsString(), apis))
+    {
+        Logger::Error("[ShaderCacheTool] Target apis were not selected");
+        return false;
+    }
+
+    threadsCount = options.GetOption(OptionName::Threads).AsUInt32();
+    if (threadsCount == 0)
+    {
+        threadsCount = static_cast<uint32>(Max(DeviceInfo::GetCpuCount(), 1));
+    }
+
+    useAssetCache = options.GetOption(OptionName::UseAssetCache).AsBool();
+    if (useAssetCache)
+    {
+        connectionsParams.ip = options.GetOption(OptionName::AssetCacheIP).AsString();
+        connectionsParams.port = static_cast<uint16>(options.GetOption(OptionName::AssetCachePort).AsUInt32());
+        connectionsParams.timeoutms = options.GetOption(OptionName::AssetCacheTimeout).AsUInt32() * 1000; //ms
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult ShaderCacheTool::OnFrameInternal()
+{
+    using namespace DAVA;
+    using namespace ShaderCacheToolDetail;
+
+    int64 startTime = SystemTimer::GetMs();
+
+    Vector<Variant> variants;
+    if (!LoadVariants(variantsListPath, variants))
+    {
+        result = Result(Result::RESULT_ERROR, Format("Can't load %s", variantsListPath.GetStringValue().c_str()));
+        return DAVA::ConsoleModule::eFrameResult::FINISHED;
+    }
+
+    if (!resourceFolder.IsEmpty())
+    {
+        FilePath::AddResourcesFolder(resourceFolder);
+    }
+    rhi::ShaderSourceCache::SetTranslationCacheDirectory(cacheFolder);
+
+    // collect unique translations, different variants may give the same pre-processed text
+    Map<String, ShaderSourceText> sources;
+    Vector<TranslationJob> jobs;
+    Set<String> keys;
+    uint32 failedCount = 0;
+    for (const Variant& variant : variants)
+    {
+        auto sourceIt = sources.find(variant.shaderName);
+        if (sourceIt == sources.end())
+        {
+            ShaderSourceText& text = sources[variant.shaderName];
+            bool loaded = LoadText(variant.shaderName + "-vp.sl", text.vertexProgText);
+            loaded = LoadText(variant.shaderName + "-fp.sl", text.fragmentProgText) && loaded;
+            if (!loaded)
+            {
+                text.vertexProgText.clear();
+                text.fragmentProgText.clear();
+            }
+            sourceIt = sources.find(variant.shaderName);
+        }
+
+        if (sourceIt->second.vertexProgText.empty())
+        {
+            ++failedCount;
+            continue;
+        }
+
+        for (rhi::Api api : apis)
+        {
+            for (rhi::ProgType progType : { rhi::PROG_VERTEX, rhi::PROG_FRAGMENT })
+            {
+                TranslationJob job;
+                job.variant = &variant;
+                job.progType = progType;
+                job.api = api;
+                job.sourceText = (progType == rhi::PROG_VERTEX) ? &sourceIt->second.vertexProgText : &sourceIt->second.fragmentProgText;
+                job.sourcePath = variant.shaderName + ((progType == rhi::PROG_VERTEX) ? "-vp.sl" : "-fp.sl");
+
+                std::vector<char> text;
+                if (!rhi::ShaderSource::PreProcess(job.sourceText->c_str(), variant.defines, &text))
+                {
+                    Logger::Error("[ShaderCacheTool] Can't pre-process %s", job.sourcePath.c_str());
+                    ++failedCount;
+                    continue;
+                }
+
+                job.key = rhi::ShaderSourceCache::GetTranslationKey(progType, api, text);
+                if (keys.insert(job.key).second)
+                {
+                    jobs.push_back(std::move(job));
+                }
+            }
+        }
+    }
+
+    AssetCacheClient cacheClient;
+    AssetCache::CachedItemValue::Description cacheItemDescription;
+    if (useAssetCache)
+    {
+        AssetCache::Error connected = cacheClient.ConnectSynchronously(connectionsParams);
+        if (connected == AssetCache::Error::NO_ERRORS)
+        {
+            DateTime timeNow = DateTime::Now();
+            cacheItemDescription.machineName = UTF8Utils::EncodeToUTF8(DeviceInfo::GetName());
+            cacheItemDescription.creationDate = UTF8Utils::EncodeToUTF8(timeNow.GetLocalizedDate()) + "_" + UTF8Utils::EncodeToUTF8(timeNow.GetLocalizedTime());
+            cacheItemDescription.comment = "Resource Editor. Translate shaders";
+        }
+        else
+        {
+            Logger::Warning("[ShaderCacheTool] Can't connect to AssetCache (%s)", AssetCache::ErrorToString(connected).c_str());
+            useAssetCache = false;
+            cacheClient.Disconnect();
+        }
+    }
+
+    // cache client isn't thread safe, so missing translations are requested and uploaded from this thread
+    uint32 localCount = 0;
+    uint32 receivedCount = 0;
+    Vector<const TranslationJob*> pendingJobs;
+    for (const TranslationJob& job : jobs)
+    {
+        if (FileSystem::Instance()->Exists(rhi::ShaderSourceCache::GetTranslationPath(job.key)))
+        {
+            ++localCount;
+            continue;
+        }
+
+        if (useAssetCache)
+        {
+            AssetCache::CachedItemValue retrievedData;
+            if (cacheClient.RequestFromCacheSynchronously(GetCacheItemKey(job.key), &retrievedData) == AssetCache::Error::NO_ERRORS && retrievedData.ExportToFolder(cacheFolder))
+            {
+                ++receivedCount;
+                continue;
+            }
+        }
+
+        pendingJobs.push_back(&job);
+    }
+
+    Mutex jobsMutex;
+    size_t nextJob = 0;
+    Vector<const TranslationJob*> translatedJobs;
+    auto workerProc = [&]()
+    {
+        while (true)
+        {
+            const TranslationJob* job = nullptr;
+            {
+                LockGuard<Mutex> lock(jobsMutex);
+                if (nextJob == pendingJobs.size())
+                {
+                    break;
+                }
+                job = pendingJobs[nextJob++];
+            }
+
+            rhi::ShaderSource* source = rhi::ShaderSourceCache::Translate(job->sourcePath.c_str(), job->progType, job->sourceText->c_str(), job->variant->defines, job->api);
+            bool translated = (source != nullptr) && FileSystem::Instance()->Exists(rhi::ShaderSourceCache::GetTranslationPath(job->key));
+            SafeDelete(source);
+
+            LockGuard<Mutex> lock(jobsMutex);
+            if (translated)
+            {
+                translatedJobs.push_back(job);
+            }
+            else
+            {
+                Logger::Error("[ShaderCacheTool] Can't translate %s for api %u", job->sourcePath.c_str(), static_cast<uint32>(job->api));
+                ++failedCount;
+            }
+        }
+    };
+
+    uint32 workersCount = Min(threadsCount, static_cast<uint32>(pendingJobs.size()));
+    if (workersCount <= 1)
+    {
+        workerProc();
+    }
+    else
+    {
+        Vector<Thread*> threads;
+        threads.reserve(workersCount);
+        for (uint32 i = 0; i < workersCount; ++i)
+        {
+            Thread* thread = Thread::Create(workerProc);
+            thread->SetName(Format("ShaderCacheTool %u", i).c_str());
+            thread->Start();
+            threads.push_back(thread);
+        }
+
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+    }
+
+    if (useAssetCache)
+    {
+        for (const TranslationJob* job : translatedJobs)
+        {
+            AssetCache::CachedItemValue value;
+            value.Add(rhi::ShaderSourceCache::GetTranslationPath(job->key));
+            value.UpdateValidationData();
+            value.SetDescription(cacheItemDescription);
+
+            AssetCache::Error added = cacheClient.AddToCacheSynchronously(GetCacheItemKey(job->key), value);
+            if (added != AssetCache::Error::NO_ERRORS)
+            {
+                Logger::Warning("[ShaderCacheTool] Can't add %s to AssetCache (%s)", job->key.c_str(), AssetCache::ErrorToString(added).c_str());
+            }
+        }
+        cacheClient.Disconnect();
+    }
+
+    rhi::ShaderSourceCache::SetTranslationCacheDirectory(FilePath());
+    if (!resourceFolder.IsEmpty())
+    {
+        FilePath::RemoveResourcesFolder(resourceFolder);
+    }
+
+    Logger::Info("Shaders: %u, up to date: %u, received from AssetCache: %u, translated: %u, failed: %u",
+                 static_cast<uint32>(jobs.size()), localCount, receivedCount, static_cast<uint32>(translatedJobs.size()), failedCount);
+    Logger::Info("Translation time: %.2lf sec", static_cast<float64>(SystemTimer::GetMs() - startTime) / 1000.0);
+
+    if (failedCount > 0)
+    {
+        result = Result(Result::RESULT_ERROR, Format("Can't translate %u shaders", failedCount));
+    }
+
+    return DAVA::ConsoleModule::eFrameResult::FINISHED;
+}
+
+void ShaderCacheTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-shadercache -processfilelist /Users/SmokeTest/ShaderVariants.txt -outdir /Users/SmokeTest/ShaderCache/");
+    DAVA::Logger::Info("\t-shadercache -processfilelist /Users/SmokeTest/ShaderVariants.txt -outdir /Users/SmokeTest/ShaderCache/ -resdir /Users/SmokeTest/Data/ -api gles2,metal -threads 8");
+    DAVA::Logger::Info("\t-shadercache -processfilelist /Users/SmokeTest/ShaderVariants.txt -outdir /Users/SmokeTest/ShaderCache/ -useCache -ip 127.0.0.1");
+}
+
+DECL_TARC_MODULE(ShaderCacheTool);
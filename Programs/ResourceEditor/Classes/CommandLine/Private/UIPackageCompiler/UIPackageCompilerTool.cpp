@@ -0,0 +1,85 @@
+#include "Classes/CommandLine/UIPackageCompilerTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <UI/UIBinaryPackageLoader.h>
+#include <UI/UIPackageCompiler.h>
+#include <Utils/StringFormat.h>
+
+UIPackageCompilerTool::UIPackageCompilerTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-uicompiler")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::File, VariantType(String("")), "Full pathname of the yaml package");
+    options.AddOption(OptionName::Folder, VariantType(String("")), "Full pathname of the folder with yaml packages");
+}
+
+bool UIPackageCompilerTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    filename = options.GetOption(OptionName::File).AsString();
+    foldername = options.GetOption(OptionName::Folder).AsString();
+
+    if (filename.IsEmpty() && foldername.IsEmpty())
+    {
+        Logger::Error("Neither package nor folder was selected");
+        return false;
+    }
+
+    if (!foldername.IsEmpty())
+    {
+        foldername.MakeDirectoryPathname();
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult UIPackageCompilerTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    Vector<FilePath> packages;
+    if (!filename.IsEmpty())
+    {
+        packages.push_back(filename);
+    }
+    else
+    {
+        for (const FilePath& path : FileSystem::Instance()->EnumerateFilesInDirectory(foldername))
+        {
+            if (path.IsEqualToExtension(".yaml"))
+            {
+                packages.push_back(path);
+            }
+        }
+    }
+
+    UIPackageCompiler compiler;
+    for (const FilePath& package : packages)
+    {
+        if (!compiler.CompilePackage(package, UIBinaryPackageLoader::GetBinaryPackagePath(package)))
+        {
+            result = Result(Result::RESULT_ERROR, Format("Can't compile %s", package.GetStringValue().c_str()));
+        }
+    }
+
+    Logger::Info("Compiled %u UI packages", static_cast<uint32>(packages.size()));
+    return DAVA::ConsoleModule::eFrameResult::FINISHED;
+}
+
+void UIPackageCompilerTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-uicompiler -file /Users/SmokeTest/Data/UI/Screen.yaml");
+    DAVA::Logger::Info("\t-uicompiler -folder /Users/SmokeTest/Data/UI/");
+}
+
+DECL_TARC_MODULE(UIPackageCompilerTool);
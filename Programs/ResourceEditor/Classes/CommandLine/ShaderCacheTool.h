@@ -0,0 +1,34 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+#include <AssetCache/AssetCacheClient.h>
+#include <Render/RHI/rhi_Type.h>
+
+class ShaderCacheTool : public DAVA::CommandLineModule
+{
+public:
+    ShaderCacheTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+protected:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::FilePath variantsListPath;
+    DAVA::FilePath cacheFolder;
+    DAVA::FilePath resourceFolder;
+    DAVA::Vector<rhi::Api> apis;
+    DAVA::uint32 threadsCount = 0;
+
+    bool useAssetCache = false;
+    DAVA::AssetCacheClient::ConnectionParams connectionsParams;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(ShaderCacheTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<ShaderCacheTool>::Begin()[DAVA::M::CommandName("-shadercache")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
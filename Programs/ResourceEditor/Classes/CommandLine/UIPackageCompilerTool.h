@@ -0,0 +1,25 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class UIPackageCompilerTool : public DAVA::CommandLineModule
+{
+public:
+    UIPackageCompilerTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+protected:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::FilePath filename;
+    DAVA::FilePath foldername;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(UIPackageCompilerTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<UIPackageCompilerTool>::Begin()[DAVA::M::CommandName("-uicompiler")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
@@ -1013,6 +1013,9 @@ void SceneInfo::RefreshVegetationInfoSection()
             SetChild("Quadtree leaf count", totalLeafCount, header);
 
             SetChild("RenderBatch count", metrics.renderBatchCount, header);
+            SetChild("Instanced cell count", metrics.instancedCellCount, header);
+            SetChild("Culling time, ms", metrics.cullingTime, header);
+            SetChild("Prepare time, ms", metrics.prepareTime, header);
 
             for (uint32 layerIndex = 0; layerIndex < COUNT_OF(POLY_PER_LOD_PER_LAYER_HEADER); ++layerIndex)
             {
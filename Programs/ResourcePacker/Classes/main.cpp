@@ -32,6 +32,7 @@ void PrintUsage()
     printf("\t-t - asset cache timeout\n");
     printf("\t-postifx - trailing part of texture name\n");
     printf("\t-output - output folder for .../Project/Data/Gfx/\n");
+    printf("\t-threads - count of threads for packing directories, 0 is count of CPU cores (default), 1 is serial packing\n");
 
     printf("\n");
     printf("ResourcePacker [src_dir] - will pack resources from src_dir\n");
@@ -138,6 +139,12 @@ void ProcessRecourcePacker(Engine& e)
     resourcePacker.SetTag(CommandLineParser::GetCommandParam("-tag"));
     resourcePacker.SetIgnoresFile(CommandLineParser::GetCommandParam("-ignore"));
 
+    String threadsStr = CommandLineParser::GetCommandParam("-threads");
+    if (!threadsStr.empty())
+    {
+        resourcePacker.SetMaxThreads(static_cast<uint32>(atoi(threadsStr.c_str())));
+    }
+
     if (CommandLineParser::CommandIsFound(String("-md5mode")))
     {
         resourcePacker.RecalculateMD5ForOutputDir();
@@ -0,0 +1,227 @@
+#include "Animation/AnimationClip.h"
+#include "Animation/AnimationClipCompressor.h"
+#include "Animation/AnimationTrack.h"
+#include "Base/BaseMath.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Time/SystemTimer.h"
+#include "Utils/CRC32.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace AnimationClipCompressorTestDetail
+{
+template <class T>
+void WriteToBuffer(Vector<uint8>& buffer, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void WriteToBuffer(Vector<uint8>& buffer, const String& string)
+{
+    buffer.insert(buffer.end(), string.c_str(), string.c_str() + string.length() + 1);
+    buffer.resize((buffer.size() + 3) & ~size_t(3), 0);
+}
+
+void WriteChannelHeader(Vector<uint8>& buffer, AnimationTrack::eChannelTarget target, uint8 dimension, AnimationChannel::eInterpolation interpolation, uint32 keyCount)
+{
+    WriteToBuffer(buffer, uint8(target));
+    WriteToBuffer(buffer, uint8(0));
+    WriteToBuffer(buffer, uint16(0));
+    WriteToBuffer(buffer, AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE);
+    WriteToBuffer(buffer, dimension);
+    WriteToBuffer(buffer, uint8(interpolation));
+    WriteToBuffer(buffer, uint16(AnimationChannel::COMPRESSION_NONE));
+    WriteToBuffer(buffer, keyCount);
+}
+
+// clip with one track: moving position, rotation around Z and constant scale, sampled at 30 fps
+void CreateClip(const FilePath& path, uint32 keyCount)
+{
+    const float32 frameTime = 1.f / 30.f;
+    float32 duration = frameTime * (keyCount - 1);
+
+    Vector<uint8> data;
+    WriteToBuffer(data, duration);
+    WriteToBuffer(data, uint32(1));
+    WriteToBuffer(data, String("joint_uid"));
+    WriteToBuffer(data, String("joint"));
+
+    WriteToBuffer(data, AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE);
+    WriteToBuffer(data, uint32(3));
+
+    WriteChannelHeader(data, AnimationTrack::CHANNEL_TARGET_POSITION, 3, AnimationChannel::INTERPOLATION_LINEAR, keyCount);
+    for (uint32 k = 0; k < keyCount; ++k)
+    {
+        float32 time = k * frameTime;
+        WriteToBuffer(data, time);
+        WriteToBuffer(data, Vector3(std::sin(time * 3.f), time * 2.f, 1.f));
+    }
+
+    WriteChannelHeader(data, AnimationTrack::CHANNEL_TARGET_ORIENTATION, 4, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR, keyCount);
+    for (uint32 k = 0; k < keyCount; ++k)
+    {
+        float32 time = k * frameTime;
+        Quaternion q;
+        q.Construct(Vector3(0.f, 0.f, 1.f), time * 1.5f);
+        WriteToBuffer(data, time);
+        WriteToBuffer(data, q);
+    }
+
+    WriteChannelHeader(data, AnimationTrack::CHANNEL_TARGET_SCALE, 1, AnimationChannel::INTERPOLATION_LINEAR, keyCount);
+    for (uint32 k = 0; k < keyCount; ++k)
+    {
+        WriteToBuffer(data, k * frameTime);
+        WriteToBuffer(data, 1.f);
+    }
+
+    WriteToBuffer(data, uint32(1));
+    WriteToBuffer(data, String("marker"));
+    WriteToBuffer(data, duration * 0.5f);
+
+    AnimationClip::FileHeader header;
+    header.signature = AnimationClip::ANIMATION_CLIP_FILE_SIGNATURE;
+    header.version = 1;
+    header.crc32 = CRC32::ForBuffer(data.data(), data.size());
+    header.dataSize = uint32(data.size());
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    file->Write(&header);
+    file->Write(data.data(), header.dataSize);
+}
+}
+
+DAVA_TESTCLASS (AnimationClipCompressorTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("AnimationClipCompressor.cpp")
+    DECLARE_COVERED_FILES("AnimationChannel.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    const FilePath rawPath = "~doc:/AnimationClipCompressorTest/raw.anim";
+    const FilePath compressedPath = "~doc:/AnimationClipCompressorTest/compressed.anim";
+
+    AnimationClipCompressorTest()
+    {
+        FileSystem::Instance()->CreateDirectory(rawPath.GetDirectory(), true);
+    }
+
+    ~AnimationClipCompressorTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(rawPath.GetDirectory());
+    }
+
+    DAVA_TEST (CompressedClipTest)
+    {
+        AnimationClipCompressorTestDetail::CreateClip(rawPath, 61);
+
+        AnimationClipCompressor::Settings settings;
+        TEST_VERIFY(AnimationClipCompressor::Compress(rawPath, compressedPath, settings));
+
+        uint64 rawSize = 0;
+        uint64 compressedSize = 0;
+        FileSystem::Instance()->GetFileSize(rawPath, rawSize);
+        FileSystem::Instance()->GetFileSize(compressedPath, compressedSize);
+        TEST_VERIFY(compressedSize < rawSize / 2);
+
+        ScopedPtr<AnimationClip> rawClip(AnimationClip::Load(rawPath));
+        ScopedPtr<AnimationClip> compressedClip(AnimationClip::Load(compressedPath));
+        TEST_VERIFY(rawClip && compressedClip);
+        TEST_VERIFY(compressedClip->GetTrackCount() == 1);
+        TEST_VERIFY(compressedClip->GetMarkerCount() == 1);
+        TEST_VERIFY(strcmp(compressedClip->GetMarkerName(0), "marker") == 0);
+        TEST_VERIFY(FLOAT_EQUAL(compressedClip->GetDuration(), rawClip->GetDuration()));
+
+        const AnimationTrack* rawTrack = rawClip->FindTrack("joint_uid");
+        const AnimationTrack* compressedTrack = compressedClip->FindTrack("joint_uid");
+        TEST_VERIFY(rawTrack != nullptr && compressedTrack != nullptr);
+        TEST_VERIFY(compressedTrack->GetChannelsCount() == rawTrack->GetChannelsCount());
+
+        const uint32 dataSize = AnimationTrack::CHANNEL_TARGET_COUNT * AnimationChannel::MAX_DIMENSION;
+        Array<float32, dataSize> rawData;
+        Array<float32, dataSize> compressedData;
+
+        // evaluate out of clip range and backwards to check key lookup
+        float32 maxError = 0.f;
+        for (float32 time = 2.5f; time > -0.5f; time -= 0.0137f)
+        {
+            rawTrack->EvaluateChannels(time, rawData.data(), dataSize);
+            compressedTrack->EvaluateChannels(time, compressedData.data(), dataSize);
+
+            for (uint32 c = 0; c < rawTrack->GetChannelsCount(); ++c)
+            {
+                for (uint32 d = 0; d < rawTrack->GetChannelValueSize(c); ++d)
+                {
+                    uint32 i = c * AnimationChannel::MAX_DIMENSION + d;
+                    maxError = Max(maxError, Abs(rawData[i] - compressedData[i]));
+                }
+            }
+        }
+        TEST_VERIFY(maxError < 0.002f);
+    }
+
+    DAVA_TEST (MalformedTrackTest)
+    {
+        using namespace AnimationClipCompressorTestDetail;
+
+        // more channels than targets
+        {
+            Vector<uint8> data;
+            WriteToBuffer(data, AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE);
+            WriteToBuffer(data, uint32(AnimationTrack::CHANNEL_TARGET_COUNT + 1));
+
+            AnimationTrack track;
+            TEST_VERIFY(track.Bind(data.data()) == 0);
+            TEST_VERIFY(track.GetChannelsCount() == 0);
+        }
+
+        // unknown channel target
+        {
+            Vector<uint8> data;
+            WriteToBuffer(data, AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE);
+            WriteToBuffer(data, uint32(1));
+            WriteChannelHeader(data, AnimationTrack::eChannelTarget(AnimationTrack::CHANNEL_TARGET_COUNT), 1, AnimationChannel::INTERPOLATION_LINEAR, 1);
+            WriteToBuffer(data, 0.f);
+            WriteToBuffer(data, 1.f);
+
+            AnimationTrack track;
+            TEST_VERIFY(track.Bind(data.data()) == 0);
+            TEST_VERIFY(track.GetChannelsCount() == 0);
+        }
+    }
+
+    DAVA_TEST (EvaluationPerformanceTest)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        AnimationClipCompressorTestDetail::CreateClip(rawPath, 3000);
+        AnimationClipCompressor::Compress(rawPath, compressedPath, AnimationClipCompressor::Settings());
+
+        ScopedPtr<AnimationClip> rawClip(AnimationClip::Load(rawPath));
+        ScopedPtr<AnimationClip> compressedClip(AnimationClip::Load(compressedPath));
+
+        const uint32 dataSize = AnimationTrack::CHANNEL_TARGET_COUNT * AnimationChannel::MAX_DIMENSION;
+        Array<float32, dataSize> data;
+
+        // random access, like many characters playing the same clip with different phases
+        const int32 count = 1000000;
+        float32 duration = rawClip->GetDuration();
+
+        int64 begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+            rawClip->GetTrack(0)->EvaluateChannels(float32((i * 7919) % 1000) * 0.001f * duration, data.data(), dataSize);
+        Logger::Info("raw clip: %lld ms", SystemTimer::GetMs() - begin);
+
+        begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+            compressedClip->GetTrack(0)->EvaluateChannels(float32((i * 7919) % 1000) * 0.001f * duration, data.data(), dataSize);
+        Logger::Info("compressed clip: %lld ms", SystemTimer::GetMs() - begin);
+#endif
+    }
+};
@@ -0,0 +1,89 @@
+#include "Base/FrameArena.h"
+#include "Concurrency/Thread.h"
+
+#include "UnitTests/UnitTests.h"
+
+DAVA_TESTCLASS (FrameArenaTest)
+{
+    DAVA_TEST (AllocateAndResetTest)
+    {
+        using namespace DAVA;
+
+        FrameArena arena(1024);
+
+        void* a = arena.Allocate(100, 16);
+        void* b = arena.Allocate(8, 64);
+        TEST_VERIFY(a != nullptr && b != nullptr);
+        TEST_VERIFY(reinterpret_cast<uintptr_t>(a) % 16 == 0);
+        TEST_VERIFY(reinterpret_cast<uintptr_t>(b) % 64 == 0);
+        TEST_VERIFY(arena.GetUsedSize() == 108);
+
+        // allocation which doesn't fit into page
+        void* c = arena.Allocate(4000);
+        TEST_VERIFY(c != nullptr);
+        TEST_VERIFY(arena.GetReservedSize() > 4000);
+
+        size_t reserved = arena.GetReservedSize();
+        arena.Reset();
+        TEST_VERIFY(arena.GetUsedSize() == 0);
+        TEST_VERIFY(arena.GetPeakSize() == 4108);
+        TEST_VERIFY(arena.GetReservedSize() == reserved);
+
+        // pages were merged, so the same data fits without new pages
+        arena.Allocate(100, 16);
+        arena.Allocate(8, 64);
+        arena.Allocate(4000);
+        TEST_VERIFY(arena.GetReservedSize() == reserved);
+    }
+
+    DAVA_TEST (FrameVectorTest)
+    {
+        using namespace DAVA;
+
+        FrameArena arena;
+        FrameArenaAllocator<int32> allocator(&arena);
+        FrameVector<int32> v(allocator);
+        for (int32 i = 0; i < 1000; ++i)
+        {
+            v.push_back(i);
+        }
+
+        TEST_VERIFY(v.size() == 1000);
+        TEST_VERIFY(v[999] == 999);
+        TEST_VERIFY(arena.GetUsedSize() >= 1000 * sizeof(int32));
+
+        FrameArena* threadArena = FrameArena::GetThreadArena();
+        TEST_VERIFY(threadArena != nullptr);
+        TEST_VERIFY(threadArena == FrameArena::GetThreadArena());
+
+        FrameVector<uint16> indices;
+        indices.assign(64, uint16(1));
+        TEST_VERIFY(indices.size() == 64);
+    }
+
+    DAVA_TEST (ReleaseThreadArenaTest)
+    {
+        using namespace DAVA;
+
+        size_t reservedBeforeRelease = 0;
+        size_t reservedAfterRelease = 0;
+
+        // use own thread, so arena of test thread isn't touched
+        Thread* thread = Thread::Create([&]() {
+            FrameArena::GetThreadArena()->Allocate(1000);
+            reservedBeforeRelease = FrameArena::GetThreadArena()->GetReservedSize();
+
+            FrameArena::ReleaseThreadArena();
+            reservedAfterRelease = FrameArena::GetThreadArena()->GetReservedSize();
+
+            // arena created again is freed on thread exit
+            FrameArena::GetThreadArena()->Allocate(1000);
+        });
+        thread->Start();
+        thread->Join();
+        SafeRelease(thread);
+
+        TEST_VERIFY(reservedBeforeRelease >= 1000);
+        TEST_VERIFY(reservedAfterRelease == 0);
+    }
+};
@@ -1,5 +1,6 @@
 #include "Logger/Logger.h"
 #include "Functional/Signal.h"
+#include "Time/SystemTimer.h"
 #include "UnitTests/UnitTests.h"
 
 // =======================================================================================================================================
@@ -609,4 +610,104 @@ DAVA_TESTCLASS (FunctionBindSignalTest)
             TEST_VERIFY(localCount == 2);
         }
     }
+
+    DAVA_TEST (TestSignalConnections)
+    {
+        using namespace DAVA;
+
+        // slots are invoked in group order, there are more slots than
+        // signal can store in-place
+        {
+            Signal<Vector<int>&> signal;
+            signal.Connect([](Vector<int>& v) { v.push_back(2); }, Signal<Vector<int>&>::Group::Low);
+            signal.Connect([](Vector<int>& v) { v.push_back(1); });
+            signal.Connect([](Vector<int>& v) { v.push_back(0); }, Signal<Vector<int>&>::Group::High);
+            signal.Connect([](Vector<int>& v) { v.push_back(11); });
+            signal.Connect([](Vector<int>& v) { v.push_back(22); }, Signal<Vector<int>&>::Group::Low);
+            signal.Connect([](Vector<int>& v) { v.push_back(111); });
+
+            Vector<int> order;
+            signal.Emit(order);
+            TEST_VERIFY(order == Vector<int>({ 0, 1, 11, 111, 2, 22 }));
+        }
+
+        // slots connected during emission are invoked starting from the next emission
+        {
+            Signal<> signal;
+            int count = 0;
+            Token token;
+            token = signal.Connect([&]() {
+                count++;
+                signal.Connect([&count]() { count += 10; });
+                signal.Disconnect(token);
+            });
+
+            signal.Emit();
+            TEST_VERIFY(count == 1);
+
+            signal.Emit();
+            TEST_VERIFY(count == 11);
+        }
+
+        // same tracked object in several connections
+        {
+            Signal<int> signal;
+            TestObjA* obj = new TestObjA();
+
+            signal.Connect(obj, &TestObjA::Slot1);
+            Token token = signal.Connect([obj](int v) { obj->Slot2(v); });
+            signal.Track(token, obj);
+
+            signal.Emit(1);
+            TEST_VERIFY(obj->v1 == 1 && obj->v2 == 1);
+
+            // signal should still watch `obj` through remaining connection
+            signal.Disconnect(token);
+            delete obj;
+            signal.Emit(2); // <-- this shouldn't crash
+        }
+    }
+
+    DAVA_TEST (SignalEmitPerformance)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        using namespace DAVA;
+
+        const uint32 emitCount = 10000000;
+
+        for (uint32 slotsCount : { 1, 4, 16 })
+        {
+            Signal<int> signal;
+            Vector<Function<void(int)>> functions;
+
+            int64 sum = 0;
+            for (uint32 i = 0; i < slotsCount; ++i)
+            {
+                signal.Connect([&sum](int v) { sum += v; });
+                functions.emplace_back([&sum](int v) { sum += v; });
+            }
+
+            int64 begin = SystemTimer::GetMs();
+            for (uint32 i = 0; i < emitCount; ++i)
+            {
+                signal.Emit(int(i));
+            }
+            int64 signalTime = SystemTimer::GetMs() - begin;
+
+            begin = SystemTimer::GetMs();
+            for (uint32 i = 0; i < emitCount; ++i)
+            {
+                for (const Function<void(int)>& fn : functions)
+                {
+                    fn(int(i));
+                }
+            }
+            int64 functionsTime = SystemTimer::GetMs() - begin;
+
+            Logger::Info("%u slots: Signal::Emit %lld ms, Function calls %lld ms, sum = %lld", slotsCount, signalTime, functionsTime, sum);
+        }
+#endif
+    }
 };
@@ -128,4 +128,73 @@ DAVA_TESTCLASS (GeometryOctTreeTest)
             SafeRelease(geometry);
         }
     }
+
+    DAVA_TEST (BatchQueriesTest)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 20.0f },
+            { FastName("segments.y"), 20.0f },
+            { FastName("segments.z"), 20.0f }
+        };
+
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), options);
+        geometry->GenerateGeometryOctTree();
+        GeometryOctTree* geoOctTree = geometry->GetGeometryOctTree();
+
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float32> distribution(-1.0f, 2.0f);
+        auto randomVector = [&]() { return Vector3(distribution(generator), distribution(generator), distribution(generator)); };
+
+        const uint32 raysCount = 101; // last packet is incomplete
+        Vector<Ray3> rays;
+        for (uint32 i = 0; i < raysCount; ++i)
+        {
+            Vector3 origin = randomVector();
+            rays.emplace_back(origin, randomVector() - origin);
+        }
+        rays.emplace_back(Vector3(0.0f, 0.0f, -1.0f), Vector3(0.0f, 0.0f, 2.0f)); // axis parallel ray along box edge
+
+        Vector<GeometryOctTree::RayHit> hits(rays.size());
+        uint32 hitCount = geoOctTree->IntersectionWithRays(rays.data(), static_cast<uint32>(rays.size()), hits.data());
+
+        uint32 expectedHitCount = 0;
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            float32 resultT;
+            uint32 triIndex;
+            bool isIntersection = geoOctTree->IntersectionWithRay(Ray3Optimized(rays[i].origin, rays[i].direction), resultT, triIndex);
+            TEST_VERIFY(isIntersection == (hits[i].triangleIndex != static_cast<uint32>(-1)));
+            if (isIntersection)
+            {
+                TEST_VERIFY(FLOAT_EQUAL_EPS(resultT, hits[i].t, 0.0001f));
+                ++expectedHitCount;
+            }
+        }
+        TEST_VERIFY(hitCount == expectedHitCount);
+        TEST_VERIFY(FLOAT_EQUAL(hits.back().t, 0.5f));
+
+        Vector<AABBox3> boxes;
+        for (uint32 i = 0; i < 20; ++i)
+        {
+            AABBox3 box;
+            box.AddPoint(randomVector());
+            box.AddPoint(randomVector());
+            boxes.push_back(box);
+        }
+
+        Vector<uint16> triangles;
+        Vector<GeometryOctTree::BoxQueryResult> results(boxes.size());
+        geoOctTree->GetTrianglesInBoxes(boxes.data(), static_cast<uint32>(boxes.size()), triangles, results.data());
+
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            Vector<uint16> expectedTriangles;
+            geoOctTree->GetTrianglesInBox(boxes[i], expectedTriangles);
+
+            auto begin = triangles.begin() + results[i].offset;
+            TEST_VERIFY(Vector<uint16>(begin, begin + results[i].count) == expectedTriangles);
+        }
+
+        SafeRelease(geometry);
+    }
 };
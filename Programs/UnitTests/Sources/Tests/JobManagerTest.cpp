@@ -87,6 +87,34 @@ DAVA_TESTCLASS (JobManagerTest)
         // ...
     }
 
+    DAVA_TEST (TestParallelFor)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        // unrelated job which is blocked until ParallelFor is finished
+        Semaphore blockingJobSem;
+        std::atomic<bool> blockingJobFinished{ false };
+        jobManager->CreateWorkerJob([&blockingJobSem, &blockingJobFinished]() {
+            blockingJobSem.Wait();
+            blockingJobFinished = true;
+        });
+
+        Vector<std::atomic<uint32>> executions(JOBS_COUNT);
+        jobManager->ParallelFor(JOBS_COUNT, [&executions](uint32 index) {
+            ++executions[index];
+        });
+
+        TEST_VERIFY(blockingJobFinished == false);
+        for (const std::atomic<uint32>& count : executions)
+        {
+            TEST_VERIFY(count == 1);
+        }
+
+        blockingJobSem.Post();
+        jobManager->WaitWorkerJobs();
+        TEST_VERIFY(blockingJobFinished == true);
+    }
+
     void ThreadFunc(JobManagerTestData * data)
     {
         for (uint32 i = 0; i < JOBS_COUNT; i++)
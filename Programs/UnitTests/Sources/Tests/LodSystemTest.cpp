@@ -0,0 +1,164 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Scene3D/Lod/LodComponent.h"
+#include "Scene3D/Lod/LodSystem.h"
+
+using namespace DAVA;
+
+namespace LodSystemTestDetails
+{
+// every next layer is twice as far, so doubled distance selects next layer
+const float32 LOD_DISTANCES[LodComponent::MAX_LOD_LAYERS] = { 10.f, 20.f, 40.f, 80.f };
+
+// distances out of 5% lods overlap even being doubled or halved, last one is beyond all layers
+const float32 LAYER_DISTANCES[] = { 7.f, 14.f, 28.f, 56.f, 200.f };
+
+const AABBox3 OBJECT_BOX(Vector3(-1.f, -1.f, -1.f), Vector3(1.f, 1.f, 1.f));
+
+Entity* CreateLodEntity(Scene* scene)
+{
+    ScopedPtr<RenderObject> renderObject(new RenderObject());
+    renderObject->SetAABBox(OBJECT_BOX);
+
+    LodComponent* lod = new LodComponent();
+    for (int32 i = 0; i < LodComponent::MAX_LOD_LAYERS; ++i)
+    {
+        lod->SetLodLayerDistance(i, LOD_DISTANCES[i]);
+    }
+
+    Entity* entity = new Entity();
+    entity->AddComponent(new RenderComponent(renderObject));
+    entity->AddComponent(lod);
+    scene->AddNode(entity);
+    entity->Release();
+    return entity;
+}
+
+// camera zoom factor scales distances, so entity is placed where scaled distance is `distance`
+void SetDistance(Entity* entity, Camera* camera, float32 distance)
+{
+    entity->GetComponent<TransformComponent>()->SetLocalTranslation(Vector3(distance / camera->GetZoomFactor(), 0.f, 0.f));
+}
+
+int32 GetLod(Entity* entity)
+{
+    return entity->GetComponent<LodComponent>()->GetCurrentLod();
+}
+}
+
+DAVA_TESTCLASS (LodSystemTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("LodSystem.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    ScopedPtr<Scene> scene;
+    ScopedPtr<Camera> camera;
+
+    LodSystemTest()
+        : scene(new Scene())
+        , camera(new Camera())
+    {
+        camera->SetupPerspective(70.f, 1.f, 1.f, 5000.f);
+        camera->SetPosition(Vector3(0.f, 0.f, 0.f));
+        scene->AddCamera(camera);
+        scene->SetCurrentCamera(camera);
+    }
+
+    DAVA_TEST (DistanceAndScreenSizeTest)
+    {
+        using namespace LodSystemTestDetails;
+
+        Vector<Entity*> entities;
+        for (float32 distance : LAYER_DISTANCES)
+        {
+            Entity* entity = CreateLodEntity(scene);
+            SetDistance(entity, camera, distance);
+            entities.push_back(entity);
+        }
+
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[0]) == 0);
+        TEST_VERIFY(GetLod(entities[1]) == 1);
+        TEST_VERIFY(GetLod(entities[2]) == 2);
+        TEST_VERIFY(GetLod(entities[3]) == 3);
+        TEST_VERIFY(GetLod(entities[4]) == LodComponent::INVALID_LOD_LAYER);
+
+        // objects are two times smaller than reference object, so they look like twice as far
+        const float32 objectRadius = OBJECT_BOX.GetSize().Length() * 0.5f;
+        scene->lodSystem->SetScreenSizeReferenceRadius(objectRadius * 2.f);
+        scene->lodSystem->SetLodSelectionMode(LodSystem::LOD_SELECTION_SCREEN_SIZE);
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[0]) == 1);
+        TEST_VERIFY(GetLod(entities[1]) == 2);
+        TEST_VERIFY(GetLod(entities[2]) == 3);
+        TEST_VERIFY(GetLod(entities[3]) == LodComponent::INVALID_LOD_LAYER);
+        TEST_VERIFY(GetLod(entities[4]) == LodComponent::INVALID_LOD_LAYER);
+
+        // and two times bigger objects look like twice as near
+        scene->lodSystem->SetScreenSizeReferenceRadius(objectRadius * 0.5f);
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[0]) == 0);
+        TEST_VERIFY(GetLod(entities[1]) == 0);
+        TEST_VERIFY(GetLod(entities[2]) == 1);
+        TEST_VERIFY(GetLod(entities[3]) == 2);
+        TEST_VERIFY(GetLod(entities[4]) == LodComponent::INVALID_LOD_LAYER);
+
+        scene->lodSystem->SetLodSelectionMode(LodSystem::LOD_SELECTION_DISTANCE);
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[0]) == 0);
+        TEST_VERIFY(GetLod(entities[1]) == 1);
+        TEST_VERIFY(GetLod(entities[2]) == 2);
+        TEST_VERIFY(GetLod(entities[3]) == 3);
+        TEST_VERIFY(GetLod(entities[4]) == LodComponent::INVALID_LOD_LAYER);
+
+        for (Entity* entity : entities)
+        {
+            scene->RemoveNode(entity);
+        }
+    }
+
+    DAVA_TEST (RemoveFromMiddleTest)
+    {
+        using namespace LodSystemTestDetails;
+
+        Vector<Entity*> entities;
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            Entity* entity = CreateLodEntity(scene);
+            SetDistance(entity, camera, LAYER_DISTANCES[i]);
+            entities.push_back(entity);
+        }
+
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[1]) == 1);
+
+        // last entity is moved into place of removed one in packed arrays
+        ScopedPtr<Entity> removed(SafeRetain(entities[1]));
+        scene->RemoveNode(removed);
+        entities.erase(entities.begin() + 1);
+        TEST_VERIFY(GetLod(removed) == LodComponent::INVALID_LOD_LAYER);
+
+        SetDistance(entities[0], camera, LAYER_DISTANCES[3]);
+        SetDistance(entities[2], camera, LAYER_DISTANCES[0]);
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[0]) == 3);
+        TEST_VERIFY(GetLod(entities[1]) == 2);
+        TEST_VERIFY(GetLod(entities[2]) == 0);
+
+        // removing of last entity doesn't move anything
+        scene->RemoveNode(entities[2]);
+        entities.pop_back();
+        SetDistance(entities[1], camera, LAYER_DISTANCES[1]);
+        scene->Update(0.016f);
+        TEST_VERIFY(GetLod(entities[0]) == 3);
+        TEST_VERIFY(GetLod(entities[1]) == 1);
+
+        for (Entity* entity : entities)
+        {
+            scene->RemoveNode(entity);
+        }
+    }
+};
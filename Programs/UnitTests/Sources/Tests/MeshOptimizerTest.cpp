@@ -0,0 +1,173 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/3D/MeshOptimizer.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace MeshOptimizerTestDetails
+{
+const int32 GRID_SIZE = 40;
+
+// Grid of GRID_SIZE x GRID_SIZE quads with shuffled triangles. Each quad has own vertices if `splitQuads` is true.
+PolygonGroup* CreateGrid(bool splitQuads)
+{
+    const int32 quadsCount = GRID_SIZE * GRID_SIZE;
+    const int32 vertexCount = splitQuads ? quadsCount * 4 : (GRID_SIZE + 1) * (GRID_SIZE + 1);
+
+    PolygonGroup* group = new PolygonGroup();
+    group->AllocateData(EVF_VERTEX, vertexCount, quadsCount * 6);
+
+    Vector<Array<uint16, 3>> triangles;
+    for (int32 y = 0; y < GRID_SIZE; ++y)
+    {
+        for (int32 x = 0; x < GRID_SIZE; ++x)
+        {
+            uint16 corners[4];
+            for (int32 c = 0; c < 4; ++c)
+            {
+                int32 cx = x + (c & 1);
+                int32 cy = y + (c >> 1);
+                int32 vertex = splitQuads ? (y * GRID_SIZE + x) * 4 + c : cy * (GRID_SIZE + 1) + cx;
+                group->SetCoord(vertex, Vector3(float32(cx), float32(cy), 0.f));
+                corners[c] = uint16(vertex);
+            }
+
+            triangles.push_back({ { corners[0], corners[1], corners[2] } });
+            triangles.push_back({ { corners[1], corners[3], corners[2] } });
+        }
+    }
+
+    std::mt19937 generator(42);
+    std::shuffle(triangles.begin(), triangles.end(), generator);
+
+    for (size_t t = 0; t < triangles.size(); ++t)
+    {
+        for (int32 k = 0; k < 3; ++k)
+        {
+            group->SetIndex(int32(t * 3 + k), int16(triangles[t][k]));
+        }
+    }
+
+    return group;
+}
+
+using Triangle = Array<Vector3, 3>;
+
+// Triangles of `group` as sorted list of coordinates, each triangle starts from its smallest vertex to keep winding
+Vector<Triangle> GetTriangles(PolygonGroup* group)
+{
+    auto lessVertex = [](const Vector3& l, const Vector3& r) {
+        return (l.x < r.x) || (l.x == r.x && l.y < r.y);
+    };
+
+    Vector<Triangle> triangles(group->GetIndexCount() / 3);
+    for (size_t t = 0; t < triangles.size(); ++t)
+    {
+        Triangle& triangle = triangles[t];
+        for (int32 k = 0; k < 3; ++k)
+        {
+            int32 index = 0;
+            group->GetIndex(int32(t * 3 + k), index);
+            group->GetCoord(index, triangle[k]);
+        }
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end(), lessVertex), triangle.end());
+    }
+
+    std::sort(triangles.begin(), triangles.end(), [&lessVertex](const Triangle& l, const Triangle& r) {
+        return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end(), lessVertex);
+    });
+    return triangles;
+}
+}
+
+DAVA_TESTCLASS (MeshOptimizerTest)
+{
+    DAVA_TEST (AnalyzeVertexCacheTest)
+    {
+        const uint16 indices[] = { 0, 1, 2, 2, 1, 3, 0, 1, 2 };
+
+        MeshOptimizer::VertexCacheStatistics stats = MeshOptimizer::AnalyzeVertexCache(indices, 9, 4, 16);
+        TEST_VERIFY(stats.triangleCount == 3);
+        TEST_VERIFY(stats.transformedVertexCount == 4);
+        TEST_VERIFY(FLOAT_EQUAL(stats.atvr, 1.f));
+
+        // cache of 2 entries: every vertex of triangle evicts earlier ones
+        stats = MeshOptimizer::AnalyzeVertexCache(indices, 9, 4, 2);
+        TEST_VERIFY(stats.transformedVertexCount > 4);
+    }
+
+    DAVA_TEST (OptimizeVertexCacheTest)
+    {
+        using namespace MeshOptimizerTestDetails;
+
+        PolygonGroup* group = CreateGrid(false);
+        Vector<Triangle> trianglesBefore = GetTriangles(group);
+
+        MeshOptimizer::Statistics stats = MeshOptimizer::OptimizePolygonGroup(group, MeshOptimizer::Options());
+        TEST_VERIFY(stats.optimizedGroupsCount == 1);
+        TEST_VERIFY(stats.after.acmr < stats.before.acmr);
+        TEST_VERIFY(stats.after.acmr < 1.f);
+        TEST_VERIFY(stats.removedVertexCount == 0);
+
+        // same set of triangles with same winding
+        TEST_VERIFY(GetTriangles(group) == trianglesBefore);
+
+        // vertex fetch order: vertices appear in index buffer in increasing order of first use
+        int32 maxIndex = -1;
+        for (int32 i = 0; i < group->GetIndexCount(); ++i)
+        {
+            int32 index = 0;
+            group->GetIndex(i, index);
+            TEST_VERIFY(index <= maxIndex + 1);
+            maxIndex = std::max(maxIndex, index);
+        }
+
+        SafeRelease(group);
+    }
+
+    DAVA_TEST (WeldVerticesTest)
+    {
+        using namespace MeshOptimizerTestDetails;
+
+        PolygonGroup* group = CreateGrid(true);
+        Vector<Triangle> trianglesBefore = GetTriangles(group);
+
+        uint32 removed = MeshOptimizer::WeldVertices(group);
+        TEST_VERIFY(removed == uint32(GRID_SIZE * GRID_SIZE * 4 - (GRID_SIZE + 1) * (GRID_SIZE + 1)));
+        TEST_VERIFY(group->GetVertexCount() == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+        TEST_VERIFY(GetTriangles(group) == trianglesBefore);
+
+        SafeRelease(group);
+    }
+
+    DAVA_TEST (KeepTriangleOrderTest)
+    {
+        using namespace MeshOptimizerTestDetails;
+
+        PolygonGroup* group = CreateGrid(false);
+
+        Vector<Vector3> orderBefore;
+        for (int32 i = 0; i < group->GetIndexCount(); ++i)
+        {
+            int32 index = 0;
+            Vector3 coord;
+            group->GetIndex(i, index);
+            group->GetCoord(index, coord);
+            orderBefore.push_back(coord);
+        }
+
+        MeshOptimizer::OptimizePolygonGroup(group, MeshOptimizer::Options(), true);
+
+        for (int32 i = 0; i < group->GetIndexCount(); ++i)
+        {
+            int32 index = 0;
+            Vector3 coord;
+            group->GetIndex(i, index);
+            group->GetCoord(index, coord);
+            TEST_VERIFY(coord == orderBefore[i]);
+        }
+
+        SafeRelease(group);
+    }
+};
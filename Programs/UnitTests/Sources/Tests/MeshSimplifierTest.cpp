@@ -0,0 +1,84 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/3D/MeshSimplifier.h"
+
+using namespace DAVA;
+
+namespace MeshSimplifierTestDetails
+{
+const int32 GRID_SIZE = 30;
+
+// Flat grid of GRID_SIZE x GRID_SIZE quads with shared vertices
+PolygonGroup* CreateGrid()
+{
+    PolygonGroup* group = new PolygonGroup();
+    group->AllocateData(EVF_VERTEX, (GRID_SIZE + 1) * (GRID_SIZE + 1), GRID_SIZE * GRID_SIZE * 6);
+
+    for (int32 y = 0; y <= GRID_SIZE; ++y)
+    {
+        for (int32 x = 0; x <= GRID_SIZE; ++x)
+        {
+            group->SetCoord(y * (GRID_SIZE + 1) + x, Vector3(float32(x), float32(y), 0.f));
+        }
+    }
+
+    int32 index = 0;
+    for (int32 y = 0; y < GRID_SIZE; ++y)
+    {
+        for (int32 x = 0; x < GRID_SIZE; ++x)
+        {
+            int16 v0 = int16(y * (GRID_SIZE + 1) + x);
+            int16 v1 = v0 + 1;
+            int16 v2 = v0 + int16(GRID_SIZE + 1);
+            int16 v3 = v2 + 1;
+            for (int16 v : { v0, v1, v2, v1, v3, v2 })
+            {
+                group->SetIndex(index++, v);
+            }
+        }
+    }
+
+    return group;
+}
+}
+
+DAVA_TESTCLASS (MeshSimplifierTest)
+{
+    DAVA_TEST (SimplifyGridTest)
+    {
+        PolygonGroup* group = MeshSimplifierTestDetails::CreateGrid();
+
+        MeshSimplifier::Options options;
+        options.targetRatio = 0.25f;
+
+        float32 error = -1.f;
+        PolygonGroup* simplified = MeshSimplifier::Simplify(group, options, &error);
+        TEST_VERIFY(simplified != nullptr);
+        if (simplified != nullptr)
+        {
+            TEST_VERIFY(simplified->GetIndexCount() < group->GetIndexCount());
+            TEST_VERIFY(simplified->GetIndexCount() > 0);
+            TEST_VERIFY(simplified->GetVertexCount() < group->GetVertexCount());
+
+            // flat grid is simplified without geometric error, all triangles keep facing +Z
+            TEST_VERIFY(error >= 0.f && error < 1e-3f);
+            for (int32 t = 0; t < simplified->GetIndexCount() / 3; ++t)
+            {
+                Vector3 coords[3];
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    int32 index = 0;
+                    simplified->GetIndex(t * 3 + k, index);
+                    simplified->GetCoord(index, coords[k]);
+                }
+                TEST_VERIFY((coords[1] - coords[0]).CrossProduct(coords[2] - coords[0]).z > 0.f);
+            }
+
+            // grid borders are kept
+            TEST_VERIFY(simplified->GetBoundingBox().min == group->GetBoundingBox().min);
+            TEST_VERIFY(simplified->GetBoundingBox().max == group->GetBoundingBox().max);
+        }
+
+        SafeRelease(simplified);
+        SafeRelease(group);
+    }
+};
@@ -232,6 +232,109 @@ private:
     size_t pendingDelivered = 0; // Parcel index expected to be confirmed as delivered
 };
 
+// Many small packets sent at once are coalesced into few transport writes,
+// check that they arrive intact and in order when sent from shared buffers
+namespace NetworkTestDetails
+{
+const uint32 SMALL_PACKET_COUNT = 500;
+
+SharedBuffer CreateSmallPacket(uint32 index)
+{
+    // first bytes carry packet index, length varies to get frames of different size in one write
+    SharedBuffer buffer(sizeof(uint32) + index % 61);
+    Memcpy(buffer.GetData(), &index, sizeof(uint32));
+    for (size_t i = sizeof(uint32); i < buffer.GetSize(); ++i)
+    {
+        buffer.GetData()[i] = static_cast<uint8>(index + i);
+    }
+    return buffer;
+}
+
+bool IsSmallPacketValid(uint32 index, const void* buffer, size_t length)
+{
+    SharedBuffer expected = CreateSmallPacket(index);
+    return expected.GetSize() == length && 0 == Memcmp(expected.GetData(), buffer, length);
+}
+}
+
+class TestBurstServer : public DAVA::Net::NetService
+{
+public:
+    void OnPacketReceived(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) override
+    {
+        // Echo from shared buffer, network keeps it alive until sent
+        Send(SharedBuffer(buffer, length));
+        packetsReceived += 1;
+    }
+
+    size_t PacketsReceived() const
+    {
+        return packetsReceived;
+    }
+
+private:
+    size_t packetsReceived = 0;
+};
+
+class TestBurstClient : public DAVA::Net::NetService
+{
+public:
+    void ChannelOpen() override
+    {
+        // Send all packets at a time and drop own references to buffers right away
+        for (uint32 i = 0; i < NetworkTestDetails::SMALL_PACKET_COUNT; ++i)
+        {
+            Send(NetworkTestDetails::CreateSmallPacket(i));
+        }
+    }
+    void OnPacketReceived(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) override
+    {
+        // Echoed packets must come in order of sending
+        if (NetworkTestDetails::IsSmallPacketValid(packetsReceived, buffer, length))
+        {
+            packetsValid += 1;
+        }
+        packetsReceived += 1;
+    }
+    void OnPacketSent(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) override
+    {
+        // Shared buffers are released by network and must not be returned
+        unexpectedSent += 1;
+    }
+    void OnPacketDelivered(const std::shared_ptr<IChannel>& channel, uint32 packetId) override
+    {
+        packetsDelivered += 1;
+    }
+
+    bool IsTestDone() const
+    {
+        return packetsReceived >= NetworkTestDetails::SMALL_PACKET_COUNT && packetsDelivered >= NetworkTestDetails::SMALL_PACKET_COUNT;
+    }
+
+    size_t PacketsReceived() const
+    {
+        return packetsReceived;
+    }
+    size_t PacketsValid() const
+    {
+        return packetsValid;
+    }
+    size_t PacketsDelivered() const
+    {
+        return packetsDelivered;
+    }
+    size_t UnexpectedSent() const
+    {
+        return unexpectedSent;
+    }
+
+private:
+    size_t packetsReceived = 0;
+    size_t packetsValid = 0;
+    size_t packetsDelivered = 0;
+    size_t unexpectedSent = 0;
+};
+
 DAVA_TESTCLASS (NetworkTest)
 {
     //BEGIN_FILES_COVERED_BY_TESTS( )
@@ -244,21 +347,29 @@ DAVA_TESTCLASS (NetworkTest)
 
     enum eServiceTypes
     {
-        SERVICE_ECHO = 1000
+        SERVICE_ECHO = 1000,
+        SERVICE_BURST
     };
 
     enum
     {
         ECHO_SERVER_CONTEXT,
-        ECHO_CLIENT_CONTEXT
+        ECHO_CLIENT_CONTEXT,
+        BURST_SERVER_CONTEXT,
+        BURST_CLIENT_CONTEXT
     };
 
     static const uint16 ECHO_PORT = 55101;
+    static const uint16 BURST_PORT = 55102;
 
     bool echoTestDone = false;
     TestEchoServer echoServer;
     TestEchoClient echoClient;
 
+    bool burstTestDone = false;
+    TestBurstServer burstServer;
+    TestBurstClient burstClient;
+
     NetCore::TrackId serverId = NetCore::INVALID_TRACK_ID;
     NetCore::TrackId clientId = NetCore::INVALID_TRACK_ID;
 
@@ -278,13 +389,25 @@ DAVA_TESTCLASS (NetworkTest)
                 TEST_VERIFY(echoServer.BytesRecieved() == echoClient.BytesRecieved());
             }
         }
+        else if (testName == "TestSmallPackets")
+        {
+            burstTestDone = burstClient.IsTestDone();
+            if (burstTestDone)
+            {
+                TEST_VERIFY(burstServer.PacketsReceived() == NetworkTestDetails::SMALL_PACKET_COUNT);
+                TEST_VERIFY(burstClient.PacketsReceived() == NetworkTestDetails::SMALL_PACKET_COUNT);
+                TEST_VERIFY(burstClient.PacketsValid() == NetworkTestDetails::SMALL_PACKET_COUNT);
+                TEST_VERIFY(burstClient.PacketsDelivered() == NetworkTestDetails::SMALL_PACKET_COUNT);
+                TEST_VERIFY(burstClient.UnexpectedSent() == 0);
+            }
+        }
 
         TestClass::Update(timeElapsed, testName);
     }
 
     void TearDown(const String& testName) override
     {
-        if (testName == "TestEcho")
+        if (testName == "TestEcho" || testName == "TestSmallPackets")
         {
             // Check whether DestroyControllerBlocked() really blocks until controller is destroyed
             size_t nactive = NetCore::Instance()->ControllersCount();
@@ -305,6 +428,10 @@ DAVA_TESTCLASS (NetworkTest)
         {
             return echoTestDone;
         }
+        else if (testName == "TestSmallPackets")
+        {
+            return burstTestDone;
+        }
         return true;
     }
 
@@ -389,12 +516,30 @@ DAVA_TESTCLASS (NetworkTest)
         clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(ECHO_CLIENT_CONTEXT));
     }
 
+    DAVA_TEST (TestSmallPackets)
+    {
+        NetCore::Instance()->RegisterService(SERVICE_BURST, MakeFunction(this, &NetworkTest::CreateEcho), MakeFunction(this, &NetworkTest::DeleteEcho));
+
+        NetConfig serverConfig(SERVER_ROLE);
+        serverConfig.AddTransport(TRANSPORT_TCP, Endpoint(BURST_PORT));
+        serverConfig.AddService(SERVICE_BURST);
+
+        NetConfig clientConfig = serverConfig.Mirror(IPAddress("127.0.0.1"));
+
+        serverId = NetCore::Instance()->CreateController(serverConfig, reinterpret_cast<void*>(BURST_SERVER_CONTEXT));
+        clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(BURST_CLIENT_CONTEXT));
+    }
+
     IChannelListener* CreateEcho(uint32 serviceId, void* context)
     {
         if (ECHO_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
             return &echoServer;
         else if (ECHO_CLIENT_CONTEXT == reinterpret_cast<intptr_t>(context))
             return &echoClient;
+        else if (BURST_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &burstServer;
+        else if (BURST_CLIENT_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &burstClient;
         return nullptr;
     }
 
@@ -0,0 +1,229 @@
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+#include <Reflection/ReflectedFieldPath.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+#include "UnitTests/UnitTests.h"
+
+namespace ReflectedFieldPathTestDetails
+{
+using namespace DAVA;
+
+struct PathBaseA : public virtual ReflectionBase
+{
+    int32 a = 1;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(PathBaseA)
+    {
+        ReflectionRegistrator<PathBaseA>::Begin()
+        .Field("a", &PathBaseA::a)
+        .End();
+    }
+};
+
+struct PathBaseB : public virtual ReflectionBase
+{
+    String b = "b";
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(PathBaseB)
+    {
+        ReflectionRegistrator<PathBaseB>::Begin()
+        .Field("b", &PathBaseB::b)
+        .End();
+    }
+};
+
+struct PathTransform : public PathBaseA, public PathBaseB
+{
+    float32 x = 0.f;
+    float32 scale = 1.f;
+
+    int32 GetId() const
+    {
+        return 7;
+    }
+
+    float32 GetScale() const
+    {
+        return scale;
+    }
+
+    void SetScale(float32 s)
+    {
+        scale = s;
+    }
+
+    bool operator==(const PathTransform& t) const
+    {
+        return (a == t.a && b == t.b && x == t.x && scale == t.scale);
+    }
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(PathTransform, PathBaseA, PathBaseB)
+    {
+        ReflectionRegistrator<PathTransform>::Begin()
+        .Field("x", &PathTransform::x)
+        .Field("id", &PathTransform::GetId, nullptr)
+        .Field("scale", &PathTransform::GetScale, &PathTransform::SetScale)
+        .End();
+    }
+};
+
+struct PathHolder : public ReflectionBase
+{
+    PathTransform transform;
+    PathTransform* parent = nullptr;
+    Vector<PathTransform> children;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(PathHolder)
+    {
+        ReflectionRegistrator<PathHolder>::Begin()
+        .Field("transform", &PathHolder::transform)
+        .Field("parent", &PathHolder::parent)
+        .Field("children", &PathHolder::children)
+        .End();
+    }
+};
+} // namespace ReflectedFieldPathTestDetails
+
+DAVA_TESTCLASS (ReflectedFieldPathTest)
+{
+    DAVA_TEST (GetSetValue)
+    {
+        using namespace DAVA;
+        using namespace ReflectedFieldPathTestDetails;
+
+        PathHolder h1;
+        PathHolder h2;
+        Reflection r1 = Reflection::Create(&h1);
+        Reflection r2 = Reflection::Create(&h2);
+
+        ReflectedFieldPath xPath(r1, { FastName("transform"), FastName("x") });
+        ReflectedFieldPath scalePath(r1, { FastName("transform"), FastName("scale") });
+        ReflectedFieldPath bPath(r1, { FastName("transform"), FastName("b") });
+        ReflectedFieldPath idPath(r1, { FastName("transform"), FastName("id") });
+        TEST_VERIFY(xPath.IsValid());
+        TEST_VERIFY(scalePath.IsValid());
+        TEST_VERIFY(bPath.IsValid());
+        TEST_VERIFY(idPath.IsValid());
+        TEST_VERIFY(xPath.GetValueType() == Type::Instance<float32>());
+
+        // compiled path is reused for another object of the same type
+        TEST_VERIFY(xPath.SetValue(r2, 5.f));
+        TEST_VERIFY(h2.transform.x == 5.f);
+        TEST_VERIFY(h1.transform.x == 0.f);
+
+        float32 x = 0.f;
+        TEST_VERIFY(xPath.GetValue(r2, x));
+        TEST_VERIFY(x == 5.f);
+        TEST_VERIFY(xPath.GetValue(r2) == r2.GetField("transform").GetField("x").GetValue());
+
+        // getter/setter field
+        TEST_VERIFY(scalePath.SetValue(r1, 3.f));
+        TEST_VERIFY(h1.transform.GetScale() == 3.f);
+        float32 scale = 0.f;
+        TEST_VERIFY(scalePath.GetValue(r1, scale));
+        TEST_VERIFY(scale == 3.f);
+
+        // field of second base class
+        TEST_VERIFY(bPath.SetValue(r1, String("path")));
+        TEST_VERIFY(h1.transform.b == "path");
+        String b;
+        TEST_VERIFY(bPath.GetValue(r1, b));
+        TEST_VERIFY(b == "path");
+
+        // value of other type goes through Any
+        TEST_VERIFY(bPath.SetValue(r1, Any(String("any"))));
+        TEST_VERIFY(h1.transform.b == "any");
+
+        // readonly field
+        int32 id = 0;
+        TEST_VERIFY(idPath.GetValue(r1, id));
+        TEST_VERIFY(id == 7);
+        TEST_VERIFY(!idPath.SetValue(r1, 10));
+
+        // wrong type
+        int32 wrong = 0;
+        TEST_VERIFY(!xPath.GetValue(r1, wrong));
+
+        // reflection of field
+        Reflection xField = xPath.GetField(r2);
+        TEST_VERIFY(xField.IsValid());
+        TEST_VERIFY(xField.GetValue().Get<float32>() == 5.f);
+    }
+
+    DAVA_TEST (PointerAndInvalidPaths)
+    {
+        using namespace DAVA;
+        using namespace ReflectedFieldPathTestDetails;
+
+        PathTransform parent;
+        PathHolder h;
+        h.parent = &parent;
+        h.children.resize(1);
+
+        Reflection r = Reflection::Create(&h);
+
+        ReflectedFieldPath parentPath(r, { FastName("parent"), FastName("x") });
+        TEST_VERIFY(parentPath.IsValid());
+        TEST_VERIFY(parentPath.SetValue(r, 2.f));
+        TEST_VERIFY(parent.x == 2.f);
+
+        // null pointer in the middle of path
+        h.parent = nullptr;
+        float32 x = 0.f;
+        TEST_VERIFY(!parentPath.GetValue(r, x));
+        TEST_VERIFY(!parentPath.GetField(r).IsValid());
+
+        TEST_VERIFY(!ReflectedFieldPath(r, { FastName("children"), FastName("x") }).IsValid());
+        TEST_VERIFY(!ReflectedFieldPath(r, { FastName("transform"), FastName("unknown") }).IsValid());
+        TEST_VERIFY(!ReflectedFieldPath(r, {}).IsValid());
+        TEST_VERIFY(!ReflectedFieldPath().IsValid());
+
+        // object of other type
+        ReflectedFieldPath xPath(r, { FastName("transform"), FastName("x") });
+        PathTransform t;
+        TEST_VERIFY(!xPath.GetValue(Reflection::Create(&t), x));
+    }
+
+    DAVA_TEST (FieldPathPerformance)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        using namespace DAVA;
+        using namespace ReflectedFieldPathTestDetails;
+
+        const size_t count = 1000000;
+
+        PathHolder h;
+        Reflection r = Reflection::Create(&h);
+        FastName transformName("transform");
+        FastName scaleName("scale");
+
+        float32 res = 0.f;
+        int64 begin = SystemTimer::GetMs();
+        for (size_t i = 0; i < count; ++i)
+        {
+            Reflection f = r.GetField(transformName).GetField(scaleName);
+            f.SetValue(float32(i));
+            res += f.GetValue().Get<float32>();
+        }
+        int64 time = SystemTimer::GetMs() - begin;
+        Logger::Info("GetField: %lld ms, res = %f", time, res);
+
+        ReflectedFieldPath path(r, { transformName, scaleName });
+
+        res = 0.f;
+        begin = SystemTimer::GetMs();
+        for (size_t i = 0; i < count; ++i)
+        {
+            float32 v = 0.f;
+            path.SetValue(r, float32(i));
+            path.GetValue(r, v);
+            res += v;
+        }
+        time = SystemTimer::GetMs() - begin;
+        Logger::Info("ReflectedFieldPath: %lld ms, res = %f", time, res);
+#endif
+    }
+};
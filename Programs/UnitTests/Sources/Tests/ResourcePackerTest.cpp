@@ -188,6 +188,59 @@ DAVA_TESTCLASS (ResourcePackerTest)
         TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareTextFiles(outputDir + "eye_tut.txt", tagsOutputDir + "eye_tut.txt") == true);
     };
 
+    DAVA_TEST (ParallelPackingTest)
+    {
+        using namespace DAVA;
+
+        ClearWorkingFolders();
+
+        // directories are packed independently, so several of them are needed to pack in parallel
+        const uint32 directoriesCount = 6;
+        for (uint32 i = 0; i < directoriesCount; ++i)
+        {
+            FilePath directory = inputDir + Format("dir%u/", i);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CreateDirectory(directory, true) != FileSystem::DIRECTORY_CANT_CREATE);
+            for (uint32 k = 0; k <= i % psdBaseNames.size(); ++k)
+            {
+                const String fullName = psdBaseNames[k] + ".psd";
+                TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CopyFile(resourcesDir + fullName, directory + fullName) == true);
+            }
+        }
+
+        const FilePath serialOutputDir = rootDir + "SerialOutput/";
+        const FilePath parallelOutputDir = rootDir + "ParallelOutput/";
+        {
+            ResourcePacker2D packer;
+            packer.forceRepack = true;
+            packer.SetMaxThreads(1);
+            packer.InitFolders(inputDir, serialOutputDir);
+            packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+        {
+            ResourcePacker2D packer;
+            packer.forceRepack = true;
+            packer.SetMaxThreads(0);
+            packer.SetMaxImagesInFlightSize(1024 * 1024); // some directories have to wait for others
+            packer.InitFolders(inputDir, parallelOutputDir);
+            packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+
+        for (uint32 i = 0; i < directoriesCount; ++i)
+        {
+            const String directory = Format("dir%u/", i);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(serialOutputDir + directory + "texture0.png") == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareBinaryFiles(serialOutputDir + directory + "texture0.png", parallelOutputDir + directory + "texture0.png") == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareBinaryFiles(serialOutputDir + directory + "texture0.tex", parallelOutputDir + directory + "texture0.tex") == true);
+            for (uint32 k = 0; k <= i % psdBaseNames.size(); ++k)
+            {
+                const String fullName = psdBaseNames[k] + ".txt";
+                TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareTextFiles(serialOutputDir + directory + fullName, parallelOutputDir + directory + fullName) == true);
+            }
+        }
+    }
+
     DAVA_TEST (MissingTagTest)
     {
         using namespace DAVA;
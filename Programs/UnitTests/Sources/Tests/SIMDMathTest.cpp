@@ -0,0 +1,228 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Math/SIMD/SIMDMath.h"
+#include "Time/SystemTimer.h"
+
+using namespace DAVA;
+
+namespace SIMDMathTestDetails
+{
+// scalar implementations which are replaced by SIMD code in math classes
+Matrix4 ScalarMul(const Matrix4& a, const Matrix4& b)
+{
+    Matrix4 res;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        for (int32 k = 0; k < 4; ++k)
+        {
+            res._data[i][k] = a._data[i][0] * b._data[0][k] + a._data[i][1] * b._data[1][k] + a._data[i][2] * b._data[2][k] + a._data[i][3] * b._data[3][k];
+        }
+    }
+    return res;
+}
+
+AABBox3 ScalarTransformBox(const AABBox3& box, const Matrix4& transform)
+{
+    AABBox3 result;
+    result.min = transform.GetTranslationVector();
+    result.max = transform.GetTranslationVector();
+    for (int32 i = 0; i < 3; ++i)
+    {
+        for (int32 j = 0; j < 3; ++j)
+        {
+            float32 a = transform._data[j][i] * box.min.data[j];
+            float32 b = transform._data[j][i] * box.max.data[j];
+            result.min.data[i] += (a < b) ? a : b;
+            result.max.data[i] += (a < b) ? b : a;
+        }
+    }
+    return result;
+}
+
+// SIMD code may reorder and fuse operations, so results differ from scalar ones in last bits
+const float32 COMPARE_EPS = 0.001f;
+
+bool MatrixEqual(const Matrix4& a, const Matrix4& b)
+{
+    for (int32 k = 0; k < 16; ++k)
+    {
+        if (!FLOAT_EQUAL_EPS(a.data[k], b.data[k], COMPARE_EPS))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Matrix4 RandomTransform()
+{
+    Vector3 axis(Random::Instance()->RandFloat32InBounds(-1.f, 1.f), Random::Instance()->RandFloat32InBounds(-1.f, 1.f), 1.f);
+    axis.Normalize();
+
+    Vector3 translation(Random::Instance()->RandFloat32InBounds(-100.f, 100.f), Random::Instance()->RandFloat32InBounds(-100.f, 100.f), Random::Instance()->RandFloat32InBounds(-100.f, 100.f));
+    Vector3 scale(Random::Instance()->RandFloat32InBounds(0.5f, 2.f), Random::Instance()->RandFloat32InBounds(0.5f, 2.f), Random::Instance()->RandFloat32InBounds(0.5f, 2.f));
+    return Matrix4::MakeScale(scale) * Matrix4::MakeRotation(axis, Random::Instance()->RandFloat32InBounds(-PI, PI)) * Matrix4::MakeTranslation(translation);
+}
+}
+
+DAVA_TESTCLASS (SIMDMathTest)
+{
+    DAVA_TEST (MatrixTest)
+    {
+        using namespace SIMDMathTestDetails;
+
+        for (int32 i = 0; i < 1000; ++i)
+        {
+            Matrix4 a = RandomTransform();
+            Matrix4 b = RandomTransform();
+            TEST_VERIFY(MatrixEqual(a * b, ScalarMul(a, b)));
+
+            Matrix4 inv;
+            TEST_VERIFY(a.GetInverse(inv));
+
+            Matrix4 identity = a * inv;
+            for (int32 k = 0; k < 16; ++k)
+            {
+                float32 expected = (k % 5 == 0) ? 1.f : 0.f;
+                TEST_VERIFY(FLOAT_EQUAL_EPS(identity.data[k], expected, 0.001f));
+            }
+        }
+
+        Matrix4 singular;
+        singular.Zero();
+        Matrix4 inv;
+        TEST_VERIFY(!singular.GetInverse(inv));
+    }
+
+    DAVA_TEST (BoxAndQuaternionTest)
+    {
+        using namespace SIMDMathTestDetails;
+
+        for (int32 i = 0; i < 1000; ++i)
+        {
+            Matrix4 transform = RandomTransform();
+            AABBox3 box(Vector3(-1.f, -2.f, -3.f), Vector3(3.f, 2.f, 1.f));
+
+            AABBox3 transformed;
+            box.GetTransformedBox(transform, transformed);
+            AABBox3 expected = ScalarTransformBox(box, transform);
+            TEST_VERIFY(VECTOR_EQUAL_EPS(transformed.min, expected.min, COMPARE_EPS) && VECTOR_EQUAL_EPS(transformed.max, expected.max, COMPARE_EPS));
+
+            Vector3 point(box.max.x, box.min.y, 0.5f);
+            Vector3 transformedPoint;
+#if defined(__DAVAENGINE_SIMD_MATH__)
+            SIMDMath::TransformPoints(transform.data, point.data, transformedPoint.data, 1);
+#else
+            transformedPoint = point * transform;
+#endif
+            Vector3 expectedPoint = point * transform;
+            TEST_VERIFY(VECTOR_EQUAL_EPS(transformedPoint, expectedPoint, COMPARE_EPS));
+        }
+
+        Quaternion q1, q2, expected;
+        q1.Construct(Vector3(0.f, 0.f, 1.f), 0.f);
+        q2.Construct(Vector3(0.f, 0.f, 1.f), PI_05);
+        expected.Construct(Vector3(0.f, 0.f, 1.f), PI_05 * 0.5f);
+
+        Quaternion q;
+        q.Slerp(q1, q2, 0.5f);
+        TEST_VERIFY(QUATERNION_EQUAL_EPS(q, expected, 0.0001f));
+    }
+
+    DAVA_TEST (SIMDMathPerformance)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        using namespace SIMDMathTestDetails;
+
+        const int32 count = 4096;
+        const int32 repeats = 256;
+
+        Vector<Matrix4> matrices(count);
+        Vector<AABBox3> boxes(count, AABBox3(Vector3(-1.f, -1.f, -1.f), Vector3(1.f, 1.f, 1.f)));
+        Vector<Vector3> points(count, Vector3(1.f, 2.f, 3.f));
+        Vector<Quaternion> quaternions(count);
+        for (int32 i = 0; i < count; ++i)
+        {
+            matrices[i] = RandomTransform();
+            quaternions[i].Construct(Vector3(0.f, 0.f, 1.f), Random::Instance()->RandFloat32InBounds(-PI, PI));
+        }
+
+        float32 checksum = 0.f;
+
+        int64 begin = SystemTimer::GetUs();
+        for (int32 r = 0; r < repeats; ++r)
+        {
+            Matrix4 res;
+            for (int32 i = 0; i + 1 < count; ++i)
+            {
+                res = matrices[i] * matrices[i + 1];
+                checksum += res._30;
+            }
+        }
+        Logger::Info("Matrix4 multiply: %lld us", SystemTimer::GetUs() - begin);
+
+        begin = SystemTimer::GetUs();
+        for (int32 r = 0; r < repeats; ++r)
+        {
+            Matrix4 inv;
+            for (int32 i = 0; i < count; ++i)
+            {
+                matrices[i].GetInverse(inv);
+                checksum += inv._30;
+            }
+        }
+        Logger::Info("Matrix4 inverse: %lld us", SystemTimer::GetUs() - begin);
+
+        begin = SystemTimer::GetUs();
+        for (int32 r = 0; r < repeats; ++r)
+        {
+            AABBox3 res;
+            for (int32 i = 0; i < count; ++i)
+            {
+                boxes[i].GetTransformedBox(matrices[i], res);
+                checksum += res.min.x;
+            }
+        }
+        Logger::Info("AABBox3 transform: %lld us", SystemTimer::GetUs() - begin);
+
+        begin = SystemTimer::GetUs();
+        for (int32 r = 0; r < repeats; ++r)
+        {
+            for (int32 i = 0; i < count; ++i)
+            {
+                Vector3 res = points[i] * matrices[i];
+                checksum += res.x;
+            }
+        }
+        Logger::Info("Vector3 transform (scalar): %lld us", SystemTimer::GetUs() - begin);
+
+#if defined(__DAVAENGINE_SIMD_MATH__)
+        Vector<Vector3> transformed(count);
+        begin = SystemTimer::GetUs();
+        for (int32 r = 0; r < repeats; ++r)
+        {
+            SIMDMath::TransformPoints(matrices[r].data, points.front().data, transformed.front().data, count);
+            checksum += transformed[r].x;
+        }
+        Logger::Info("Vector3 batch transform: %lld us", SystemTimer::GetUs() - begin);
+#endif
+
+        begin = SystemTimer::GetUs();
+        for (int32 r = 0; r < repeats; ++r)
+        {
+            Quaternion res;
+            for (int32 i = 0; i + 1 < count; ++i)
+            {
+                res.Slerp(quaternions[i], quaternions[i + 1], 0.3f);
+                checksum += res.w;
+            }
+        }
+        Logger::Info("Quaternion slerp: %lld us", SystemTimer::GetUs() - begin);
+
+        Logger::Info("checksum %f", checksum);
+#endif
+    }
+};
@@ -0,0 +1,178 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Entity/ComponentUtils.h"
+#include "Scene3D/Components/ActionComponent.h"
+#include "Scene3D/Components/WaveComponent.h"
+#include "Scene3D/Components/WindComponent.h"
+#include "Scene3D/Lod/LodSystem.h"
+#include "Scene3D/Systems/ParticleEffectSystem.h"
+#include "Scene3D/Systems/SkeletonSystem.h"
+
+using namespace DAVA;
+
+namespace SceneProcessStagesTestDetails
+{
+class CountingSystem : public SceneSystem
+{
+public:
+    CountingSystem(Scene* scene)
+        : SceneSystem(scene)
+    {
+    }
+
+    void PrepareForRemove() override
+    {
+    }
+
+    void Process(float32 timeElapsed) override
+    {
+        ++processCount;
+    }
+
+    Atomic<uint32> processCount{ 0 };
+};
+
+uint32 GetStageIndex(const Vector<Vector<SceneSystem*>>& stages, const SceneSystem* system)
+{
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        if (std::find(stages[i].begin(), stages[i].end(), system) != stages[i].end())
+        {
+            return static_cast<uint32>(i);
+        }
+    }
+    return static_cast<uint32>(-1);
+}
+
+// checks stages of any scene, whatever systems it has
+void VerifyStages(Scene* scene)
+{
+    const Vector<SceneSystem*>& systems = scene->systemsToProcess;
+    const Vector<Vector<SceneSystem*>>& stages = scene->GetProcessStages();
+
+    size_t stagedCount = 0;
+    for (const Vector<SceneSystem*>& stage : stages)
+    {
+        TEST_VERIFY(!stage.empty());
+        stagedCount += stage.size();
+
+        // systems of one stage don't conflict
+        for (size_t i = 0; i < stage.size(); ++i)
+        {
+            for (size_t j = i + 1; j < stage.size(); ++j)
+            {
+                TEST_VERIFY(!stage[i]->IsProcessConflicting(stage[j]));
+            }
+        }
+    }
+    TEST_VERIFY(stagedCount == systems.size());
+
+    for (size_t i = 0; i < systems.size(); ++i)
+    {
+        uint32 stage = GetStageIndex(stages, systems[i]);
+        TEST_VERIFY(stage < stages.size());
+
+        // conflicting systems keep their order, and system is not placed later than needed
+        bool hasConflictInPreviousStage = (stage == 0);
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (systems[i]->IsProcessConflicting(systems[j]))
+            {
+                uint32 otherStage = GetStageIndex(stages, systems[j]);
+                TEST_VERIFY(otherStage < stage);
+                hasConflictInPreviousStage |= (otherStage + 1 == stage);
+            }
+        }
+        TEST_VERIFY(hasConflictInPreviousStage);
+    }
+}
+}
+
+DAVA_TESTCLASS (SceneProcessStagesTest)
+{
+    DAVA_TEST (StagesTest)
+    {
+        using namespace SceneProcessStagesTestDetails;
+
+        ScopedPtr<Scene> scene(new Scene(0));
+
+        CountingSystem* windWriter = new CountingSystem(scene);
+        CountingSystem* windReader = new CountingSystem(scene);
+        CountingSystem* waveWriter = new CountingSystem(scene);
+        CountingSystem* undeclared = new CountingSystem(scene);
+        CountingSystem* actionWriter = new CountingSystem(scene);
+
+        windWriter->SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<WindComponent>());
+        windReader->SetProcessAccess(ComponentUtils::MakeMask<WindComponent>(), ComponentMask());
+        waveWriter->SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<WaveComponent>());
+        actionWriter->SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<ActionComponent>(), SceneSystem::PROCESS_SHARED_RENDER_SYSTEM);
+
+        CountingSystem* systems[] = { windWriter, windReader, waveWriter, undeclared, actionWriter };
+        for (CountingSystem* system : systems)
+        {
+            scene->AddSystem(system, ComponentMask(), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        }
+
+        VerifyStages(scene);
+
+        // not neighbouring waveWriter joins windWriter, windReader waits for windWriter
+        const Vector<Vector<SceneSystem*>>& stages = scene->GetProcessStages();
+        TEST_VERIFY(GetStageIndex(stages, waveWriter) == GetStageIndex(stages, windWriter));
+        TEST_VERIFY(GetStageIndex(stages, windReader) == GetStageIndex(stages, windWriter) + 1);
+
+        // system without declared access is processed alone and doesn't let others pass it
+        uint32 undeclaredStage = GetStageIndex(stages, undeclared);
+        TEST_VERIFY(undeclaredStage < stages.size() && stages[undeclaredStage].size() == 1);
+        TEST_VERIFY(undeclaredStage > GetStageIndex(stages, windReader));
+        TEST_VERIFY(GetStageIndex(stages, actionWriter) > undeclaredStage);
+
+        scene->Update(0.f);
+        scene->SetParallelProcessEnabled(true);
+        scene->Update(0.f);
+
+        for (CountingSystem* system : systems)
+        {
+            TEST_VERIFY(system->processCount == 2);
+        }
+
+        for (CountingSystem* system : systems)
+        {
+            scene->RemoveSystem(system);
+            delete system;
+        }
+    }
+
+    DAVA_TEST (SharedStateTest)
+    {
+        using namespace SceneProcessStagesTestDetails;
+
+        ScopedPtr<Scene> scene(new Scene(0));
+
+        CountingSystem first(scene);
+        CountingSystem second(scene);
+        CountingSystem third(scene);
+        first.SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<WindComponent>(), SceneSystem::PROCESS_SHARED_RENDER_SYSTEM);
+        second.SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<WaveComponent>(), SceneSystem::PROCESS_SHARED_RENDER_SYSTEM);
+        third.SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<ActionComponent>());
+
+        // both change render system, so they can't be processed concurrently
+        TEST_VERIFY(first.IsProcessConflicting(&second));
+        TEST_VERIFY(!first.IsProcessConflicting(&third));
+        TEST_VERIFY(!second.IsProcessConflicting(&third));
+    }
+
+    DAVA_TEST (DefaultSceneStagesTest)
+    {
+        using namespace SceneProcessStagesTestDetails;
+
+        ScopedPtr<Scene> scene(new Scene());
+        TEST_VERIFY(scene->lodSystem->HasProcessAccess());
+        TEST_VERIFY(scene->particleEffectSystem->HasProcessAccess());
+        TEST_VERIFY(scene->skeletonSystem->HasProcessAccess());
+        VerifyStages(scene);
+
+        scene->SetParallelProcessEnabled(true);
+        scene->Update(0.016f);
+    }
+};
@@ -1,5 +1,8 @@
 #include "UnitTests/UnitTests.h"
 #include "Base/BaseTypes.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
 #include "Math/Color.h"
 #include "Math/MathDefines.h"
 #include "Reflection/ReflectionRegistrator.h"
@@ -90,6 +93,7 @@ DAVA_TESTCLASS (ScriptTest)
     DECLARE_COVERED_FILES("LuaScript.cpp")
     DECLARE_COVERED_FILES("LuaException.cpp")
     DECLARE_COVERED_FILES("LuaBridge.cpp")
+    DECLARE_COVERED_FILES("LuaBytecodeCache.cpp")
     END_FILES_COVERED_BY_TESTS();
 
     DAVA_TEST (DavaFunctionsTest)
@@ -632,6 +636,97 @@ end
         TEST_VERIFY(moveScript.ExecFunctionSafe("main") >= 0);
     }
 
+    DAVA_TEST (FunctionRefTest)
+    {
+        DAVA::LuaScript s;
+
+        const DAVA::String script = R"script(
+function concat(str, num, flag, obj)
+    return str .. tostring(num) .. tostring(flag) .. tostring(obj.intVal)
+end
+)script";
+
+        TEST_VERIFY(s.ExecStringSafe(script) >= 0);
+
+        DAVA::LuaFunctionRef undefinedFn = s.GetFunctionRef("undefined");
+        TEST_VERIFY(!undefinedFn.IsValid());
+        TEST_VERIFY(s.ExecFunctionSafe(undefinedFn) < 0);
+
+        DAVA::LuaFunctionRef concatFn = s.GetFunctionRef("concat");
+        TEST_VERIFY(concatFn.IsValid());
+
+        ReflClass obj;
+        obj.intVal = 7;
+        DAVA::Reflection objRef = DAVA::Reflection::Create(DAVA::ReflectedObject(&obj));
+        for (DAVA::int32 i = 0; i < 3; ++i)
+        {
+            DAVA::int32 nres = s.ExecFunction(concatFn, "a", i, true, objRef);
+            TEST_VERIFY(nres == 1);
+            TEST_VERIFY(s.GetResult<DAVA::String>(1).Get<DAVA::String>() == DAVA::Format("a%dtrue7", i));
+            s.Pop(nres);
+        }
+
+        s.ReleaseFunctionRef(concatFn);
+        TEST_VERIFY(!concatFn.IsValid());
+    }
+
+    DAVA_TEST (BytecodeCacheTest)
+    {
+        const DAVA::FilePath cacheDir = "~doc:/LuaBytecodeCache/";
+        const DAVA::FilePath scriptPath = "~doc:/LuaBytecodeCacheTest.lua";
+        DAVA::FileSystem::Instance()->DeleteDirectory(cacheDir);
+        DAVA::LuaScript::SetBytecodeCacheDirectory(cacheDir);
+
+        auto writeScript = [&scriptPath](const DAVA::String& script) {
+            DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(scriptPath, DAVA::File::CREATE | DAVA::File::WRITE));
+            file->WriteString(script, false);
+        };
+
+        auto execScript = [&scriptPath]() -> DAVA::int32 {
+            DAVA::LuaScript s;
+            DAVA::int32 nres = s.ExecScript(scriptPath);
+            DAVA::int32 result = (nres == 1) ? s.GetResult<DAVA::int32>(1).Get<DAVA::int32>() : -1;
+            s.Pop(nres);
+            return result;
+        };
+
+        writeScript("return 1");
+        TEST_VERIFY(execScript() == 1);
+        TEST_VERIFY(DAVA::FileSystem::Instance()->EnumerateFilesInDirectory(cacheDir).size() == 1);
+        TEST_VERIFY(execScript() == 1);
+        TEST_VERIFY(DAVA::FileSystem::Instance()->EnumerateFilesInDirectory(cacheDir).size() == 1);
+
+        // changed source should be compiled again
+        writeScript("return 2");
+        TEST_VERIFY(execScript() == 2);
+        TEST_VERIFY(DAVA::FileSystem::Instance()->EnumerateFilesInDirectory(cacheDir).size() == 2);
+
+        DAVA::LuaScript::SetBytecodeCacheDirectory(DAVA::FilePath());
+        DAVA::FileSystem::Instance()->DeleteDirectory(cacheDir);
+        DAVA::FileSystem::Instance()->DeleteFile(scriptPath);
+    }
+
+    DAVA_TEST (RequireModuleHeaderTest)
+    {
+        const DAVA::FilePath modulePath = "~doc:/LuaModuleHeaderTest.lua";
+        {
+            // UTF-8 BOM and shebang line should be skipped, error line numbers should be the same as in file
+            DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(modulePath, DAVA::File::CREATE | DAVA::File::WRITE));
+            file->WriteString("\xEF\xBB\xBF#!/usr/bin/lua\nreturn 5\n", false);
+        }
+
+        DAVA::LuaScript s;
+        DAVA::int32 nres = s.ExecString("return require('~doc:/LuaModuleHeaderTest')");
+        TEST_VERIFY(nres == 1);
+        if (nres == 1)
+        {
+            TEST_VERIFY(s.GetResult<DAVA::int32>(1).Get<DAVA::int32>() == 5);
+        }
+        s.Pop(nres);
+
+        DAVA::FileSystem::Instance()->DeleteFile(modulePath);
+    }
+
     DAVA_TEST (LuaExceptionTest)
     {
         try
@@ -0,0 +1,98 @@
+#include "FileSystem/FileSystem.h"
+#include "Render/RHI/rhi_ShaderSource.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace ShaderTranslationCacheTestDetails
+{
+const char* VERTEX_SOURCE =
+"vertex_in\n"
+"{\n"
+"    float3 pos   : POSITION;\n"
+"    float4 color : COLOR;\n"
+"};\n"
+"vertex_out\n"
+"{\n"
+"    float4 pos   : SV_POSITION;\n"
+"    float4 color : COLOR;\n"
+"};\n"
+"\n"
+"[unique][dynamic] property float4x4   XForm;\n"
+"\n"
+"vertex_out\n"
+"vp_main( vertex_in input )\n"
+"{\n"
+"    vertex_out output;\n"
+"    output.pos   = mul( float4(input.pos.xyz,1.0), XForm );\n"
+"    output.color = input.color * COLOR_SCALE;\n"
+"    return output;\n"
+"}\n";
+
+String GetKey(const std::vector<std::string>& defines)
+{
+    std::vector<char> text;
+    TEST_VERIFY(rhi::ShaderSource::PreProcess(VERTEX_SOURCE, defines, &text));
+    return rhi::ShaderSourceCache::GetTranslationKey(rhi::PROG_VERTEX, rhi::RHI_GLES2, text);
+}
+}
+
+DAVA_TESTCLASS (ShaderTranslationCacheTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("rhi_ShaderSource.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    const FilePath cacheFolder = "~doc:/ShaderTranslationCacheTest/";
+
+    ShaderTranslationCacheTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(cacheFolder);
+        rhi::ShaderSourceCache::SetTranslationCacheDirectory(cacheFolder);
+    }
+
+    ~ShaderTranslationCacheTest()
+    {
+        rhi::ShaderSourceCache::SetTranslationCacheDirectory(FilePath());
+        FileSystem::Instance()->DeleteDirectory(cacheFolder);
+    }
+
+    DAVA_TEST (TranslateAndLoadFromCacheTest)
+    {
+        using namespace ShaderTranslationCacheTestDetails;
+
+        const std::vector<std::string> defines = { "COLOR_SCALE", "1.0" };
+        const String key = GetKey(defines);
+        const FilePath path = rhi::ShaderSourceCache::GetTranslationPath(key);
+        TEST_VERIFY(!path.IsEmpty());
+        TEST_VERIFY(!FileSystem::Instance()->Exists(path));
+
+        bool fromCache = true;
+        std::unique_ptr<rhi::ShaderSource> translated(rhi::ShaderSourceCache::Translate("test-vp", rhi::PROG_VERTEX, VERTEX_SOURCE, defines, rhi::RHI_GLES2, &fromCache));
+        TEST_VERIFY(translated != nullptr);
+        TEST_VERIFY(!fromCache);
+        TEST_VERIFY(FileSystem::Instance()->Exists(path));
+
+        // same text and defines must give the same key and be loaded from cache
+        TEST_VERIFY(GetKey(defines) == key);
+        std::unique_ptr<rhi::ShaderSource> cached(rhi::ShaderSourceCache::Translate("test-vp", rhi::PROG_VERTEX, VERTEX_SOURCE, defines, rhi::RHI_GLES2, &fromCache));
+        TEST_VERIFY(cached != nullptr);
+        TEST_VERIFY(fromCache);
+
+        if (translated != nullptr && cached != nullptr)
+        {
+            TEST_VERIFY(cached->GetSourceCode(rhi::RHI_GLES2) == translated->GetSourceCode(rhi::RHI_GLES2));
+            TEST_VERIFY(cached->Properties().size() == translated->Properties().size());
+            TEST_VERIFY(cached->ConstBufferCount() == translated->ConstBufferCount());
+        }
+
+        // changed define changes pre-processed text, so shader is translated again
+        const std::vector<std::string> otherDefines = { "COLOR_SCALE", "0.5" };
+        TEST_VERIFY(GetKey(otherDefines) != key);
+        std::unique_ptr<rhi::ShaderSource> other(rhi::ShaderSourceCache::Translate("test-vp", rhi::PROG_VERTEX, VERTEX_SOURCE, otherDefines, rhi::RHI_GLES2, &fromCache));
+        TEST_VERIFY(other != nullptr);
+        TEST_VERIFY(!fromCache);
+    }
+};
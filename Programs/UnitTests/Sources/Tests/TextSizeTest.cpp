@@ -53,4 +53,37 @@ DAVA_TESTCLASS (TextSizeTest)
             TEST_VERIFY_WITH_MESSAGE(std::abs(size.dx - charsSum) < TEST_ACCURACY, testData[k].description);
         }
     }
+
+    DAVA_TEST (GlyphCacheTest)
+    {
+        FTFont* ftFont = static_cast<FTFont*>(font);
+        const WideString testString = L"Glyph cache test, justify test string";
+        const float32 fontSize = 18.f;
+
+        Vector<float32> firstSizes;
+        Vector<float32> secondSizes;
+        Font::StringMetrics first = ftFont->GetStringMetrics(fontSize, testString, &firstSizes);
+        Font::StringMetrics second = ftFont->GetStringMetrics(fontSize, testString, &secondSizes);
+        TEST_VERIFY(first.drawRect == second.drawRect);
+        TEST_VERIFY(FLOAT_EQUAL(first.width, second.width));
+        TEST_VERIFY(firstSizes == secondSizes);
+
+        const int32 width = 512;
+        const int32 height = 64;
+        Vector<uint8> missBuffer(width * height, 0);
+        Vector<uint8> hitBuffer(width * height, 0);
+        ftFont->DrawStringToBuffer(fontSize, missBuffer.data(), width, height, 3, 2, 400, 300, testString, true);
+        ftFont->DrawStringToBuffer(fontSize, hitBuffer.data(), width, height, 3, 2, 400, 300, testString, true);
+        TEST_VERIFY(missBuffer == hitBuffer);
+
+        ftFont->PrerasterizeString(fontSize + 1.f, testString);
+        FTFont::WaitPrerasterizeJobs();
+        Vector<float32> prerasterizedSizes;
+        ftFont->GetStringMetrics(fontSize + 1.f, testString, &prerasterizedSizes);
+        TEST_VERIFY(prerasterizedSizes.size() == testString.size());
+
+        Vector<uint8> prerasterizedBuffer(width * height, 0);
+        ftFont->DrawStringToBuffer(fontSize, prerasterizedBuffer.data(), width, height, 3, 2, 400, 300, testString, true);
+        TEST_VERIFY(prerasterizedBuffer == missBuffer);
+    }
 };
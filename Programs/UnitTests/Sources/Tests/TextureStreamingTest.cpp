@@ -0,0 +1,90 @@
+#include "UnitTests/UnitTests.h"
+#include "Base/BaseTypes.h"
+#include "Base/ScopedPtr.h"
+#include "Render/Texture.h"
+#include "Render/TextureDescriptor.h"
+#include "Render/TextureStreaming.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (TextureStreamingTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("TextureStreaming.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    Texture* CreateTexture()
+    {
+        Vector<uint8> data(16 * 16 * 4, 0xFF);
+        Texture* texture = Texture::CreateFromData(FORMAT_RGBA8888, data.data(), 16, 16, false);
+        texture->GetDescriptor()->compression[GPU_ORIGIN].format = FORMAT_RGBA8888;
+        return texture;
+    }
+
+    DAVA_TEST (MipSelectionTest)
+    {
+        // 1024 texture with resident 64x64 mip
+        const uint32 residentMip = 4;
+
+        // object over whole screen needs full resolution
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, residentMip, 1024.f) == 0);
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 512, residentMip, 512.f) == 0);
+
+        // each halving of screen size drops one mip
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, residentMip, 256.f) == 1);
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, residentMip, 128.f) == 2);
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, residentMip, 64.f) == 3);
+
+        // resident mip is never dropped
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, residentMip, 1.f) == residentMip);
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, residentMip, 0.f) == residentMip);
+        TEST_VERIFY(TextureStreaming::GetMipForScreenSize(1024, 1024, 0, 1.f) == 0);
+    }
+
+    DAVA_TEST (RegistrationTest)
+    {
+        ScopedPtr<Texture> small(CreateTexture());
+        ScopedPtr<Texture> large(CreateTexture());
+
+        TextureStreaming::Statistics initial = TextureStreaming::GetStatistics();
+
+        // only resident mips are counted at registration
+        TextureStreaming::RegisterTexture(small, GPU_ORIGIN, 1024, 1024, 4);
+        TextureStreaming::Statistics stats = TextureStreaming::GetStatistics();
+        TEST_VERIFY(stats.texturesCount == initial.texturesCount + 1);
+        const uint64 smallSize = 64 * 64 * 4 * 4 / 3; // mip chain of 64x64 RGBA8888
+        TEST_VERIFY(stats.residentSize - initial.residentSize == smallSize);
+
+        TextureStreaming::RegisterTexture(large, GPU_ORIGIN, 1024, 1024, 0);
+        stats = TextureStreaming::GetStatistics();
+        TEST_VERIFY(stats.texturesCount == initial.texturesCount + 2);
+        const uint64 largeSize = 1024 * 1024 * 4 * 4 / 3;
+        TEST_VERIFY(stats.residentSize - initial.residentSize == smallSize + largeSize);
+
+        TextureStreaming::UnregisterTexture(large);
+        TextureStreaming::UnregisterTexture(small);
+        stats = TextureStreaming::GetStatistics();
+        TEST_VERIFY(stats.texturesCount == initial.texturesCount);
+        TEST_VERIFY(stats.residentSize == initial.residentSize);
+        TEST_VERIFY(stats.loadingTasksCount == initial.loadingTasksCount);
+    }
+
+    DAVA_TEST (BudgetTest)
+    {
+        const uint64 initialBudget = TextureStreaming::GetMemoryBudget();
+
+        ScopedPtr<Texture> texture(CreateTexture());
+        TextureStreaming::RegisterTexture(texture, GPU_ORIGIN, 1024, 1024, 4);
+
+        // resident mips are kept and nothing is loaded when budget is exceeded
+        TextureStreaming::SetMemoryBudget(1024);
+        TEST_VERIFY(TextureStreaming::GetStatistics().memoryBudget == 1024);
+        TextureStreaming::BeginFrame();
+        TEST_VERIFY(TextureStreaming::GetStatistics().loadingTasksCount == 0);
+
+        TextureStreaming::UnregisterTexture(texture);
+        TextureStreaming::SetMemoryBudget(initialBudget);
+        TEST_VERIFY(TextureStreaming::GetStatistics().memoryBudget == initialBudget);
+    }
+};
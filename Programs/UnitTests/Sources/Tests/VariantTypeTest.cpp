@@ -0,0 +1,180 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (VariantTypeTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("VariantType.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    DAVA_TEST (InlineValuesTest)
+    {
+        VariantType v(Vector3(1.f, 2.f, 3.f));
+        VariantType copy(v);
+        TEST_VERIFY(copy.AsVector3() == Vector3(1.f, 2.f, 3.f));
+
+        copy.SetColor(Color(0.1f, 0.2f, 0.3f, 0.4f));
+        TEST_VERIFY(copy.AsColor() == Color(0.1f, 0.2f, 0.3f, 0.4f));
+        TEST_VERIFY(v.AsVector3() == Vector3(1.f, 2.f, 3.f));
+
+        AABBox3 box(Vector3(-1.f, -2.f, -3.f), Vector3(1.f, 2.f, 3.f));
+        v.SetAABBox3(box);
+        TEST_VERIFY(v.AsAABBox3() == box);
+
+        v.SetFastName(FastName("name"));
+        TEST_VERIFY(v.AsFastName() == FastName("name"));
+
+        Matrix4 m = Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f));
+        v.SetMatrix4(m);
+        copy = v;
+        TEST_VERIFY(copy.AsMatrix4() == m);
+    }
+
+    DAVA_TEST (CopyOnWriteTest)
+    {
+        VariantType str(String("first"));
+        VariantType strCopy(str);
+        TEST_VERIFY(strCopy.AsString() == "first");
+        TEST_VERIFY(&strCopy.AsString() == &str.AsString());
+
+        strCopy.SetString("second");
+        TEST_VERIFY(str.AsString() == "first");
+        TEST_VERIFY(strCopy.AsString() == "second");
+
+        // Modification through meta object doesn't change copies
+        strCopy = str;
+        *static_cast<String*>(strCopy.MetaObject()) = "third";
+        TEST_VERIFY(str.AsString() == "first");
+        TEST_VERIFY(strCopy.AsString() == "third");
+
+        const uint8 bytes[] = { 1, 2, 3, 4 };
+        VariantType array(bytes, 4);
+        VariantType arrayCopy(array);
+        TEST_VERIFY(array == arrayCopy);
+        arrayCopy.SetByteArray(bytes, 2);
+        TEST_VERIFY(array.AsByteArraySize() == 4);
+        TEST_VERIFY(arrayCopy.AsByteArraySize() == 2);
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetInt32("value", 1);
+        VariantType archiveVariant(static_cast<KeyedArchive*>(archive));
+        VariantType archiveCopy(archiveVariant);
+        TEST_VERIFY(archiveVariant == archiveCopy);
+
+        archiveCopy.AsKeyedArchive()->SetInt32("value", 2);
+        TEST_VERIFY(archiveVariant.AsKeyedArchive()->GetInt32("value") == 1);
+        TEST_VERIFY(archiveCopy.AsKeyedArchive()->GetInt32("value") == 2);
+
+        // Archive retained outside of variant is not shared
+        ScopedPtr<KeyedArchive> retained(SafeRetain(archiveVariant.AsKeyedArchive()));
+        VariantType retainedCopy(archiveVariant);
+        retained->SetInt32("value", 3);
+        TEST_VERIFY(archiveVariant.AsKeyedArchive()->GetInt32("value") == 3);
+        TEST_VERIFY(retainedCopy.AsKeyedArchive()->GetInt32("value") == 1);
+    }
+
+    DAVA_TEST (CachedNestedArchiveTest)
+    {
+        ScopedPtr<KeyedArchive> nested(new KeyedArchive());
+        nested->SetInt32("value", 1);
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetArchive("nested", nested);
+
+        // Pointer to nested archive is taken before outer archive is copied
+        KeyedArchive* cached = archive->GetArchive("nested");
+        ScopedPtr<KeyedArchive> copy(new KeyedArchive(*archive));
+        cached->SetInt32("value", 2);
+
+        TEST_VERIFY(archive->GetArchive("nested") == cached);
+        TEST_VERIFY(archive->GetArchive("nested")->GetInt32("value") == 2);
+        TEST_VERIFY(copy->GetArchive("nested")->GetInt32("value") == 1);
+        TEST_VERIFY(copy->GetArchive("nested") != cached);
+    }
+
+    DAVA_TEST (MoveTest)
+    {
+        VariantType str(String("moved"));
+        VariantType moved(std::move(str));
+        TEST_VERIFY(str.GetType() == VariantType::TYPE_NONE);
+        TEST_VERIFY(moved.AsString() == "moved");
+
+        VariantType vec(Vector2(1.f, 2.f));
+        moved = std::move(vec);
+        TEST_VERIFY(vec.GetType() == VariantType::TYPE_NONE);
+        TEST_VERIFY(moved.AsVector2() == Vector2(1.f, 2.f));
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetVariant("key", VariantType(String("value")));
+        TEST_VERIFY(archive->GetString("key") == "value");
+    }
+
+    DAVA_TEST (SerializationTest)
+    {
+        ScopedPtr<KeyedArchive> nested(new KeyedArchive());
+        nested->SetString("string", "nested");
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetString("string", "value");
+        archive->SetVector4("vector4", Vector4(1.f, 2.f, 3.f, 4.f));
+        archive->SetColor("color", Color(1.f, 0.f, 0.f, 1.f));
+        archive->SetMatrix3("matrix3", Matrix3(1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f));
+        archive->SetFastName("fastname", FastName("fastname"));
+        archive->SetArchive("archive", nested);
+
+        Vector<uint8> data(archive->Save(nullptr, 0));
+        archive->Save(data.data(), static_cast<uint32>(data.size()));
+
+        ScopedPtr<KeyedArchive> loaded(new KeyedArchive());
+        TEST_VERIFY(loaded->Load(data.data(), static_cast<uint32>(data.size())));
+        TEST_VERIFY(loaded->GetString("string") == "value");
+        TEST_VERIFY(loaded->GetVector4("vector4") == Vector4(1.f, 2.f, 3.f, 4.f));
+        TEST_VERIFY(loaded->GetColor("color") == Color(1.f, 0.f, 0.f, 1.f));
+        TEST_VERIFY(loaded->GetMatrix3("matrix3") == Matrix3(1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f));
+        TEST_VERIFY(loaded->GetFastName("fastname") == FastName("fastname"));
+        TEST_VERIFY(loaded->GetArchive("archive")->GetString("string") == "nested");
+    }
+
+    DAVA_TEST (ArchivePerformanceTest)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        for (int32 i = 0; i < 1000; ++i)
+        {
+            archive->SetString(Format("string%d", i), Format("some string value %d", i));
+            archive->SetVector3(Format("vector%d", i), Vector3(float32(i), 0.f, 0.f));
+            archive->SetColor(Format("color%d", i), Color::White);
+        }
+        Vector<uint8> data(archive->Save(nullptr, 0));
+        archive->Save(data.data(), static_cast<uint32>(data.size()));
+
+        const int32 count = 100;
+
+        int64 begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            ScopedPtr<KeyedArchive> loaded(new KeyedArchive());
+            loaded->Load(data.data(), static_cast<uint32>(data.size()));
+        }
+        Logger::Info("archive load: %lld ms", SystemTimer::GetMs() - begin);
+
+        begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            archive->Save(data.data(), static_cast<uint32>(data.size()));
+        }
+        Logger::Info("archive save: %lld ms", SystemTimer::GetMs() - begin);
+
+        begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            ScopedPtr<KeyedArchive> copy(new KeyedArchive(*archive));
+        }
+        Logger::Info("archive copy: %lld ms", SystemTimer::GetMs() - begin);
+#endif
+    }
+};
@@ -0,0 +1,213 @@
+#include "DAVAEngine.h"
+#include "FileSystem/YamlDocument.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace YamlDocumentTestDetail
+{
+const char8* TEST_YAML =
+"header:\n"
+"    version: 3\n"
+"    enabled: yes\n"
+"items:\n"
+"    - name: first\n"
+"      position: [10.5, -2.0]\n"
+"      color: [0.5, 0.25, 1.0]\n"
+"    - name: second\n"
+"      size: [1, 2, 3, 4]\n"
+"    - plain scalar\n"
+"empty: []\n";
+
+class CountingHandler : public YamlEventHandler
+{
+public:
+    void OnMapBegin() override
+    {
+        ++maps;
+    }
+    void OnMapEnd() override
+    {
+        --maps;
+    }
+    void OnArrayBegin() override
+    {
+        ++arrays;
+    }
+    void OnArrayEnd() override
+    {
+        --arrays;
+    }
+    void OnKey(const char8* key, uint32 length) override
+    {
+        ++keys;
+    }
+    void OnScalar(const char8* value, uint32 length) override
+    {
+        ++scalars;
+    }
+
+    int32 maps = 0;
+    int32 arrays = 0;
+    int32 keys = 0;
+    int32 scalars = 0;
+};
+
+bool IsEqual(const YamlNode* node, const YamlDocument::Node& docNode)
+{
+    if (node == nullptr || !docNode.IsValid() || node->GetType() != docNode.GetType() || node->GetCount() != docNode.GetCount())
+    {
+        return false;
+    }
+
+    if (node->GetType() == YamlNode::TYPE_STRING)
+    {
+        return node->AsString() == docNode.AsString();
+    }
+
+    for (uint32 i = 0; i < docNode.GetCount(); ++i)
+    {
+        const YamlNode* child = (node->GetType() == YamlNode::TYPE_MAP) ? node->Get(docNode.GetItemKeyName(i)) : node->Get(i);
+        if (!IsEqual(child, docNode.Get(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+DAVA_TESTCLASS (YamlDocumentTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("YamlDocument.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    DAVA_TEST (EventsTest)
+    {
+        using namespace YamlDocumentTestDetail;
+
+        CountingHandler handler;
+        TEST_VERIFY(YamlParser::ParseStringEvents(TEST_YAML, &handler));
+        TEST_VERIFY(handler.maps == 0 && handler.arrays == 0);
+        TEST_VERIFY(handler.keys == 10);
+        TEST_VERIFY(handler.scalars == 14);
+
+        CountingHandler brokenHandler;
+        TEST_VERIFY(!YamlParser::ParseStringEvents("key: [1, 2", &brokenHandler));
+    }
+
+    DAVA_TEST (AccessTest)
+    {
+        using namespace YamlDocumentTestDetail;
+
+        RefPtr<YamlDocument> document = YamlDocument::CreateFromString(TEST_YAML);
+        TEST_VERIFY(document.Valid());
+
+        YamlDocument::Node root = document->GetRootNode();
+        TEST_VERIFY(root.GetType() == YamlNode::TYPE_MAP);
+        TEST_VERIFY(root.GetCount() == 3);
+        TEST_VERIFY(String(root.GetItemKeyName(2)) == "empty");
+        TEST_VERIFY(root.Get("empty").GetType() == YamlNode::TYPE_ARRAY);
+        TEST_VERIFY(root.Get("empty").GetCount() == 0);
+        TEST_VERIFY(!root.Get("missing").IsValid());
+
+        YamlDocument::Node header = root.Get("header");
+        TEST_VERIFY(header.Get("version").AsInt32() == 3);
+        TEST_VERIFY(header.Get("enabled").AsBool());
+
+        YamlDocument::Node items = root.Get("items");
+        TEST_VERIFY(items.GetCount() == 3);
+        TEST_VERIFY(items.Get(0).Get("name").AsString() == "first");
+        TEST_VERIFY(items.Get(0).Get("position").AsVector2() == Vector2(10.5f, -2.f));
+        TEST_VERIFY(items.Get(0).Get("color").AsColor() == Color(0.5f, 0.25f, 1.f, 1.f));
+        TEST_VERIFY(items.Get(1).Get("size").AsVector4() == Vector4(1.f, 2.f, 3.f, 4.f));
+        TEST_VERIFY(items.Get(2).AsFastName() == FastName("plain scalar"));
+        TEST_VERIFY(!items.Get(3).IsValid());
+
+        TEST_VERIFY(!YamlDocument::CreateFromString("key: [1, 2").Valid());
+    }
+
+    DAVA_TEST (KeyLookupTest)
+    {
+        String yaml;
+        for (int32 i = 0; i < 100; ++i)
+        {
+            yaml += Format("key%d: %d\n", i, i);
+        }
+        yaml += "key7: duplicate\n";
+
+        RefPtr<YamlDocument> document = YamlDocument::CreateFromString(yaml);
+        TEST_VERIFY(document.Valid());
+
+        YamlDocument::Node root = document->GetRootNode();
+        TEST_VERIFY(root.GetCount() == 101);
+        for (int32 i = 0; i < 100; ++i)
+        {
+            TEST_VERIFY(root.Get(Format("key%d", i)).AsInt32() == i);
+        }
+
+        // first of duplicated keys is found, as with linear search
+        TEST_VERIFY(root.Get("key7").AsString() == "7");
+        TEST_VERIFY(root.Get(100).AsString() == "duplicate");
+        TEST_VERIFY(!root.Get("key100").IsValid());
+        TEST_VERIFY(!root.Get("").IsValid());
+        TEST_VERIFY(!root.Get("key1").Get("key1").IsValid());
+    }
+
+    DAVA_TEST (CompareWithYamlNodeTest)
+    {
+        using namespace YamlDocumentTestDetail;
+
+        const FilePath path("~res:/UI/UIBinaryPackageTest.yaml");
+        RefPtr<YamlParser> parser = YamlParser::Create(path);
+        RefPtr<YamlDocument> document = YamlDocument::Create(path);
+        TEST_VERIFY(parser.Valid() && document.Valid());
+        TEST_VERIFY(IsEqual(parser->GetRootNode(), document->GetRootNode()));
+    }
+
+    DAVA_TEST (ParsingPerformanceTest)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        FilePath largestPath;
+        uint64 largestSize = 0;
+        for (const FilePath& path : FileSystem::Instance()->EnumerateFilesInDirectory("~res:/"))
+        {
+            uint64 size = 0;
+            if (path.IsEqualToExtension(".yaml") && FileSystem::Instance()->GetFileSize(path, size) && size > largestSize)
+            {
+                largestPath = path;
+                largestSize = size;
+            }
+        }
+        Logger::Info("largest yaml: %s, %llu bytes", largestPath.GetAbsolutePathname().c_str(), largestSize);
+
+        const int32 count = 50;
+
+        int64 begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            RefPtr<YamlParser> parser = YamlParser::Create(largestPath);
+        }
+        Logger::Info("YamlParser: %lld ms", SystemTimer::GetMs() - begin);
+
+        begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            RefPtr<YamlDocument> document = YamlDocument::Create(largestPath);
+        }
+        Logger::Info("YamlDocument: %lld ms", SystemTimer::GetMs() - begin);
+
+        begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            YamlDocumentTestDetail::CountingHandler handler;
+            YamlParser::ParseEvents(largestPath, &handler);
+        }
+        Logger::Info("YamlParser::ParseEvents: %lld ms", SystemTimer::GetMs() - begin);
+#endif
+    }
+};
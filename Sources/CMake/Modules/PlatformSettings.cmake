@@ -14,6 +14,11 @@ if ( DAVA_MEMORY_PROFILER )
     append_property( PLATFORM_DEFINITIONS_${DAVA_PLATFORM_CURRENT} -DDAVA_MEMORY_PROFILING_ENABLE )  
 endif()
 
+if ( DAVA_DISABLE_SIMD_MATH )
+    # use scalar implementation of Matrix4, AABBox3 and Quaternion operations
+    append_property( PLATFORM_DEFINITIONS_${DAVA_PLATFORM_CURRENT} -DDAVA_DISABLE_SIMD_MATH )
+endif()
+
 
 if( APPLE )
     set(CMAKE_CONFIGURATION_TYPES "Debug;Release;RelWithDebinfo;AdHoc"  CACHE STRING
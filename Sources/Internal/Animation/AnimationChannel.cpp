@@ -1,6 +1,7 @@
 #include "AnimationChannel.h"
 #include "Base/BaseMath.h"
 #include "Debug/DVAssert.h"
+#include "Math/SIMD/SIMDMath.h"
 
 namespace DAVA
 {
@@ -9,6 +10,7 @@ uint32 AnimationChannel::Bind(const uint8* _data)
     keysData = nullptr;
     dimension = 0;
     keyStride = keysCount = 0;
+    startKey = 0;
 
     const uint8* dataptr = _data;
     if (_data != nullptr && *reinterpret_cast<const uint32*>(_data) == ANIMATION_CHANNEL_DATA_SIGNATURE)
@@ -27,6 +29,68 @@ uint32 AnimationChannel::Bind(const uint8* _data)
         keysCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
+        if (compression == COMPRESSION_QUANTIZED16)
+        {
+            if (dimension > MAX_DIMENSION || keysCount == 0 || interpolation == INTERPOLATION_BEZIER)
+            {
+                keysCount = 0;
+                return 0;
+            }
+
+            startTime = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            timeScale = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            segmentCount = *reinterpret_cast<const uint32*>(dataptr);
+            dataptr += 4;
+
+            if (segmentCount == 0)
+            {
+                keysCount = 0;
+                return 0;
+            }
+
+            float32 segmentLength = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            invSegmentLength = (segmentLength > 0.f) ? (1.f / segmentLength) : 0.f;
+
+            for (uint32 d = 0; d < MAX_DIMENSION; ++d)
+            {
+                rangeMin[d] = (d < dimension) ? reinterpret_cast<const float32*>(dataptr)[d] : 0.f;
+                rangeScale[d] = (d < dimension) ? reinterpret_cast<const float32*>(dataptr)[dimension + d] : 0.f;
+            }
+            dataptr += 2 * dimension * sizeof(float32);
+
+            segmentKeys = reinterpret_cast<const uint32*>(dataptr);
+            dataptr += segmentCount * sizeof(uint32);
+
+            for (uint32 s = 0; s < segmentCount; ++s)
+            {
+                if (segmentKeys[s] > keysCount)
+                {
+                    keysCount = 0;
+                    return 0;
+                }
+            }
+
+            keysTime = reinterpret_cast<const uint16*>(dataptr);
+            dataptr += keysCount * sizeof(uint16);
+
+            keysData = dataptr;
+            keyStride = uint32(sizeof(uint16)) * dimension;
+
+            uint32 size = uint32(keysData - _data) + keysCount * keyStride;
+            return (size + 3) & ~3u; //channels are aligned by 4 bytes
+        }
+        else if (compression != COMPRESSION_NONE)
+        {
+            keysCount = 0;
+            return 0;
+        }
+
         keysData = dataptr;
 
         keyStride = uint32(sizeof(float32)) * (dimension + 1);
@@ -46,6 +110,12 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
 {
     DVASSERT(dataSize >= GetDimension());
 
+    if (compression == COMPRESSION_QUANTIZED16)
+    {
+        EvaluateQuantized(time, outData);
+        return;
+    }
+
     uint32 k = startKey;
 
     if (KEY_TIME(k) > time)
@@ -119,4 +189,86 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
 #undef KEY_TIME
 #undef KEY_DATA
 #undef KEY_META
+
+float32 AnimationChannel::GetQuantizedKeyTime(uint32 key) const
+{
+    return startTime + float32(keysTime[key]) * timeScale;
+}
+
+void AnimationChannel::GetQuantizedKeyData(uint32 key, float32* outData) const
+{
+    const uint16* data = reinterpret_cast<const uint16*>(keysData + key * keyStride);
+    for (uint32 d = 0; d < uint32(dimension); ++d)
+        outData[d] = rangeMin[d] + float32(data[d]) * rangeScale[d];
+}
+
+void AnimationChannel::EvaluateQuantized(float32 time, float32* outData) const
+{
+    if (time <= startTime || keysCount == 1)
+    {
+        GetQuantizedKeyData(0, outData);
+        return;
+    }
+
+    // segment index gives first key after segment start, so only keys of one segment are scanned
+    float32 segmentPosition = (time - startTime) * invSegmentLength;
+    uint32 segment = (segmentPosition < float32(segmentCount)) ? uint32(segmentPosition) : (segmentCount - 1);
+    uint32 k = segmentKeys[segment];
+    while (k > 1 && GetQuantizedKeyTime(k - 1) > time)
+        --k;
+    while (k < keysCount && GetQuantizedKeyTime(k) <= time)
+        ++k;
+
+    if (k == keysCount)
+    {
+        GetQuantizedKeyData(keysCount - 1, outData);
+        return;
+    }
+
+    uint32 k0 = k - 1;
+    float32 time0 = GetQuantizedKeyTime(k0);
+    float32 time1 = GetQuantizedKeyTime(k);
+    float32 t = (time1 > time0) ? (time - time0) / (time1 - time0) : 0.f;
+
+    float32 v0[MAX_DIMENSION] = {};
+    float32 v1[MAX_DIMENSION] = {};
+
+    if (interpolation == INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        DVASSERT(dimension == 4); //should be quaternion
+
+        GetQuantizedKeyData(k0, v0);
+        GetQuantizedKeyData(k, v1);
+
+        Quaternion q0(v0);
+        Quaternion q(v1);
+        q.Slerp(q0, q, t);
+        q.Normalize();
+
+        Memcpy(outData, q.data, dimension * sizeof(float32));
+        return;
+    }
+
+    const uint16* data0 = reinterpret_cast<const uint16*>(keysData + k0 * keyStride);
+    const uint16* data1 = reinterpret_cast<const uint16*>(keysData + k * keyStride);
+    for (uint32 d = 0; d < uint32(dimension); ++d)
+    {
+        v0[d] = float32(data0[d]);
+        v1[d] = float32(data1[d]);
+    }
+
+#if defined(__DAVAENGINE_SIMD_MATH__)
+    using namespace SIMDMath;
+
+    // lerp of quantized values: min + (q0 + (q1 - q0) * t) * scale
+    Float4 q0 = Load(v0);
+    Float4 q = Add(q0, Mul(Sub(Load(v1), q0), Set1(t)));
+    Store(v0, Add(Load(rangeMin), Mul(q, Load(rangeScale))));
+#else
+    for (uint32 d = 0; d < uint32(dimension); ++d)
+        v0[d] = rangeMin[d] + Lerp(v0[d], v1[d], t) * rangeScale[d];
+#endif
+
+    Memcpy(outData, v0, dimension * sizeof(float32));
+}
 }
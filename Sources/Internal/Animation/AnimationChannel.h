@@ -18,14 +18,31 @@ public:
         INTERPOLATION_COUNT
     };
 
+    enum eCompression : uint16
+    {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_QUANTIZED16, // 16-bit key times and values with uniform-segment key index, see 'AnimationBinaryFormat.md'
+
+        COMPRESSION_COUNT
+    };
+
+    /** Max number of components in channel value. */
+    static const uint32 MAX_DIMENSION = 4;
+
     AnimationChannel() = default;
 
     uint32 Bind(const uint8* data);
     void Evaluate(float32 time, float32* outData, uint32 dataSize) const;
 
     uint32 GetDimension() const;
+    eCompression GetCompression() const;
 
 private:
+    void EvaluateQuantized(float32 time, float32* outData) const;
+
+    float32 GetQuantizedKeyTime(uint32 key) const;
+    void GetQuantizedKeyData(uint32 key, float32* outData) const;
+
     const DAVA::uint8* keysData = nullptr;
     mutable uint32 startKey = 0;
     uint32 keysCount = 0;
@@ -33,10 +50,25 @@ private:
     uint16 compression = 0;
     uint8 dimension = 0;
     eInterpolation interpolation = INTERPOLATION_COUNT;
+
+    //quantized data
+    float32 rangeMin[MAX_DIMENSION] = {};
+    float32 rangeScale[MAX_DIMENSION] = {};
+    const uint32* segmentKeys = nullptr;
+    const uint16* keysTime = nullptr;
+    float32 startTime = 0.f;
+    float32 timeScale = 0.f;
+    float32 invSegmentLength = 0.f;
+    uint32 segmentCount = 0;
 };
 
 inline uint32 AnimationChannel::GetDimension() const
 {
     return uint32(dimension);
 }
-}
\ No newline at end of file
+
+inline AnimationChannel::eCompression AnimationChannel::GetCompression() const
+{
+    return eCompression(compression);
+}
+}
@@ -57,7 +57,7 @@ AnimationClip* AnimationClip::Load(const FilePath& fileName)
         FileHeader header;
         file->Read(&header);
 
-        if (header.signature == ANIMATION_CLIP_FILE_SIGNATURE && header.version == 1)
+        if (header.signature == ANIMATION_CLIP_FILE_SIGNATURE && (header.version == 1 || header.version == ANIMATION_CLIP_FILE_VERSION))
         {
             clip = new AnimationClip();
             clip->filepath = fileName;
@@ -0,0 +1,350 @@
+#include "AnimationClipCompressor.h"
+#include "AnimationChannel.h"
+#include "AnimationClip.h"
+#include "AnimationTrack.h"
+
+#include "Base/BaseMath.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FilePath.h"
+#include "Logger/Logger.h"
+#include "Utils/CRC32.h"
+
+namespace DAVA
+{
+namespace AnimationClipCompressorDetails
+{
+const float32 QUANTIZATION_MAX = 65535.f;
+
+template <class T>
+void WriteToBuffer(Vector<uint8>& buffer, const T* value, uint32 count = 1)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+}
+
+void AlignBuffer(Vector<uint8>& buffer)
+{
+    buffer.resize((buffer.size() + 3) & ~size_t(3), 0);
+}
+
+struct ChannelKeys
+{
+    uint32 dimension = 0;
+    bool spherical = false;
+    Vector<float32> times;
+    Vector<float32> values; // [key * dimension + component]
+
+    const float32* GetValue(uint32 key) const
+    {
+        return values.data() + key * dimension;
+    }
+
+    void Interpolate(uint32 k0, uint32 k1, float32 time, float32* outValue) const
+    {
+        float32 t = (times[k1] > times[k0]) ? (time - times[k0]) / (times[k1] - times[k0]) : 0.f;
+        if (spherical)
+        {
+            Quaternion q(GetValue(k1));
+            q.Slerp(Quaternion(GetValue(k0)), q, t);
+            q.Normalize();
+            Memcpy(outValue, q.data, sizeof(q.data));
+        }
+        else
+        {
+            for (uint32 d = 0; d < dimension; ++d)
+                outValue[d] = Lerp(GetValue(k0)[d], GetValue(k1)[d], t);
+        }
+    }
+
+    float32 GetError(const float32* value, uint32 key) const
+    {
+        const float32* reference = GetValue(key);
+        float32 error = 0.f;
+        float32 negatedError = 0.f; // q and -q are the same orientation
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            error = Max(error, Abs(value[d] - reference[d]));
+            negatedError = Max(negatedError, Abs(value[d] + reference[d]));
+        }
+        return spherical ? Min(error, negatedError) : error;
+    }
+};
+
+/** Return indices of keys which can't be restored by interpolation of kept neighbours within `tolerance`. */
+Vector<uint32> ReduceKeys(const ChannelKeys& keys, float32 tolerance)
+{
+    uint32 keysCount = uint32(keys.times.size());
+
+    Vector<uint32> keptKeys = { 0 };
+    float32 value[AnimationChannel::MAX_DIMENSION];
+
+    uint32 anchor = 0;
+    for (uint32 candidate = anchor + 2; candidate < keysCount; ++candidate)
+    {
+        for (uint32 k = anchor + 1; k < candidate; ++k)
+        {
+            keys.Interpolate(anchor, candidate, keys.times[k], value);
+            if (keys.GetError(value, k) > tolerance)
+            {
+                anchor = candidate - 1;
+                keptKeys.push_back(anchor);
+                break;
+            }
+        }
+    }
+
+    if (keysCount > 1)
+    {
+        // constant channel is stored as single key
+        bool isConstant = (keptKeys.size() == 1);
+        for (uint32 k = 1; k < keysCount && isConstant; ++k)
+            isConstant = (keys.GetError(keys.GetValue(k), 0) <= tolerance);
+
+        if (!isConstant)
+            keptKeys.push_back(keysCount - 1);
+    }
+
+    return keptKeys;
+}
+
+void WriteQuantizedChannel(const ChannelKeys& keys, const Vector<uint32>& keptKeys, Vector<uint8>& outData)
+{
+    uint32 dimension = keys.dimension;
+    uint32 keysCount = uint32(keptKeys.size());
+
+    float32 startTime = keys.times[keptKeys.front()];
+    float32 endTime = keys.times[keptKeys.back()];
+    float32 timeScale = (endTime - startTime) / QUANTIZATION_MAX;
+
+    float32 rangeMin[AnimationChannel::MAX_DIMENSION];
+    float32 rangeMax[AnimationChannel::MAX_DIMENSION];
+    float32 rangeScale[AnimationChannel::MAX_DIMENSION];
+    for (uint32 d = 0; d < dimension; ++d)
+    {
+        rangeMin[d] = std::numeric_limits<float32>::max();
+        rangeMax[d] = -std::numeric_limits<float32>::max();
+        for (uint32 k : keptKeys)
+        {
+            rangeMin[d] = Min(rangeMin[d], keys.GetValue(k)[d]);
+            rangeMax[d] = Max(rangeMax[d], keys.GetValue(k)[d]);
+        }
+        rangeScale[d] = (rangeMax[d] - rangeMin[d]) / QUANTIZATION_MAX;
+    }
+
+    auto Quantize = [](float32 value, float32 min, float32 scale) {
+        return (scale > 0.f) ? uint16(Clamp(std::round((value - min) / scale), 0.f, QUANTIZATION_MAX)) : uint16(0);
+    };
+
+    Vector<uint16> keysTime(keysCount);
+    Vector<uint16> keysData(keysCount * dimension);
+    for (uint32 k = 0; k < keysCount; ++k)
+    {
+        keysTime[k] = Quantize(keys.times[keptKeys[k]], startTime, timeScale);
+        for (uint32 d = 0; d < dimension; ++d)
+            keysData[k * dimension + d] = Quantize(keys.GetValue(keptKeys[k])[d], rangeMin[d], rangeScale[d]);
+    }
+
+    // about one key per segment, index of segment is first key after segment start
+    uint32 segmentCount = Max(keysCount - 1, 1u);
+    float32 segmentLength = (endTime - startTime) / float32(segmentCount);
+    Vector<uint32> segmentKeys(segmentCount);
+    uint32 key = 0;
+    for (uint32 s = 0; s < segmentCount; ++s)
+    {
+        float32 segmentStart = startTime + float32(s) * segmentLength;
+        while (key < keysCount && startTime + float32(keysTime[key]) * timeScale <= segmentStart)
+            ++key;
+        segmentKeys[s] = key;
+    }
+
+    uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+    uint8 dimension8 = uint8(dimension);
+    uint8 interpolation = uint8(keys.spherical ? AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR : AnimationChannel::INTERPOLATION_LINEAR);
+    uint16 compression = AnimationChannel::COMPRESSION_QUANTIZED16;
+
+    WriteToBuffer(outData, &signature);
+    WriteToBuffer(outData, &dimension8);
+    WriteToBuffer(outData, &interpolation);
+    WriteToBuffer(outData, &compression);
+    WriteToBuffer(outData, &keysCount);
+    WriteToBuffer(outData, &startTime);
+    WriteToBuffer(outData, &timeScale);
+    WriteToBuffer(outData, &segmentCount);
+    WriteToBuffer(outData, &segmentLength);
+    WriteToBuffer(outData, rangeMin, dimension);
+    WriteToBuffer(outData, rangeScale, dimension);
+    WriteToBuffer(outData, segmentKeys.data(), segmentCount);
+    WriteToBuffer(outData, keysTime.data(), keysCount);
+    WriteToBuffer(outData, keysData.data(), keysCount * dimension);
+    AlignBuffer(outData);
+}
+
+/** Write compressed channel or copy it as is. Return size of source channel data or 0 on error. */
+uint32 ProcessChannel(const uint8* data, const uint8* dataEnd, float32 tolerance, Vector<uint8>& outData)
+{
+    const uint32 CHANNEL_HEADER_SIZE = 12;
+    if (uint32(dataEnd - data) < CHANNEL_HEADER_SIZE)
+        return 0;
+
+    AnimationChannel channel;
+    uint32 channelSize = channel.Bind(data);
+    if (channelSize == 0 || channelSize > uint32(dataEnd - data))
+        return 0;
+
+    uint32 dimension = data[4];
+    AnimationChannel::eInterpolation interpolation = AnimationChannel::eInterpolation(data[5]);
+    uint32 keysCount = *reinterpret_cast<const uint32*>(data + 8);
+
+    bool canCompress = channel.GetCompression() == AnimationChannel::COMPRESSION_NONE && keysCount > 0 && dimension > 0 && dimension <= AnimationChannel::MAX_DIMENSION;
+    canCompress = canCompress && (interpolation == AnimationChannel::INTERPOLATION_LINEAR || (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR && dimension == 4));
+    if (!canCompress)
+    {
+        outData.insert(outData.end(), data, data + channelSize);
+        return channelSize;
+    }
+
+    ChannelKeys keys;
+    keys.dimension = dimension;
+    keys.spherical = (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+    keys.times.resize(keysCount);
+    keys.values.resize(keysCount * dimension);
+
+    const float32* keysData = reinterpret_cast<const float32*>(data + CHANNEL_HEADER_SIZE);
+    for (uint32 k = 0; k < keysCount; ++k)
+    {
+        const float32* key = keysData + k * (dimension + 1);
+        keys.times[k] = key[0];
+        Memcpy(keys.values.data() + k * dimension, key + 1, dimension * sizeof(float32));
+    }
+
+    WriteQuantizedChannel(keys, ReduceKeys(keys, tolerance), outData);
+    return channelSize;
+}
+
+uint32 CopyAlignedString(const uint8* data, const uint8* dataEnd, Vector<uint8>& outData)
+{
+    const uint8* stringEnd = std::find(data, dataEnd, uint8(0));
+    if (stringEnd == dataEnd)
+        return 0;
+
+    uint32 stringBytes = (uint32(stringEnd - data) + 1 + 3) & ~3u;
+    if (stringBytes > uint32(dataEnd - data))
+        return 0;
+
+    outData.insert(outData.end(), data, data + stringBytes);
+    return stringBytes;
+}
+}
+
+bool AnimationClipCompressor::CompressData(const uint8* data, uint32 size, Vector<uint8>& outData, const Settings& settings)
+{
+    using namespace AnimationClipCompressorDetails;
+
+    //binary file format described in 'AnimationBinaryFormat.md'
+    outData.clear();
+    outData.reserve(size);
+
+    const uint8* dataptr = data;
+    const uint8* dataEnd = data + size;
+
+    if (size < 8)
+        return false;
+
+    uint32 nodeCount = *reinterpret_cast<const uint32*>(dataptr + 4);
+    outData.insert(outData.end(), dataptr, dataptr + 8); //duration, node count
+    dataptr += 8;
+
+    for (uint32 n = 0; n < nodeCount; ++n)
+    {
+        for (uint32 s = 0; s < 2; ++s) //uid, name
+        {
+            uint32 stringBytes = CopyAlignedString(dataptr, dataEnd, outData);
+            if (stringBytes == 0)
+                return false;
+            dataptr += stringBytes;
+        }
+
+        if (uint32(dataEnd - dataptr) < 8 || *reinterpret_cast<const uint32*>(dataptr) != AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE)
+            return false;
+
+        uint32 channelCount = *reinterpret_cast<const uint32*>(dataptr + 4);
+        outData.insert(outData.end(), dataptr, dataptr + 8); //signature, channel count
+        dataptr += 8;
+
+        for (uint32 c = 0; c < channelCount; ++c)
+        {
+            if (uint32(dataEnd - dataptr) < 4)
+                return false;
+
+            AnimationTrack::eChannelTarget target = AnimationTrack::eChannelTarget(*dataptr);
+            outData.insert(outData.end(), dataptr, dataptr + 4); //target, pad
+            dataptr += 4;
+
+            float32 tolerance = settings.positionTolerance;
+            if (target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
+                tolerance = settings.orientationTolerance;
+            else if (target == AnimationTrack::CHANNEL_TARGET_SCALE)
+                tolerance = settings.scaleTolerance;
+
+            uint32 channelSize = ProcessChannel(dataptr, dataEnd, tolerance, outData);
+            if (channelSize == 0)
+                return false;
+            dataptr += channelSize;
+        }
+    }
+
+    outData.insert(outData.end(), dataptr, dataEnd); //markers
+    return true;
+}
+
+bool AnimationClipCompressor::Compress(const FilePath& srcPath, const FilePath& dstPath, const Settings& settings)
+{
+    Vector<uint8> data;
+    AnimationClip::FileHeader header;
+    {
+        ScopedPtr<File> file(File::Create(srcPath, File::OPEN | File::READ));
+        if (!file)
+        {
+            Logger::Error("[AnimationClipCompressor] Can't open animation file. File: %s", srcPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        file->Read(&header);
+        if (header.signature != AnimationClip::ANIMATION_CLIP_FILE_SIGNATURE || header.version > AnimationClip::ANIMATION_CLIP_FILE_VERSION)
+        {
+            Logger::Error("[AnimationClipCompressor] Wrong animation file format. File: %s", srcPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        data.resize(header.dataSize);
+        if (file->Read(data.data(), header.dataSize) != header.dataSize || CRC32::ForBuffer(data.data(), header.dataSize) != header.crc32)
+        {
+            Logger::Error("[AnimationClipCompressor] Mismatch CRC32 of animation data. Possibly file corrupted. File: %s", srcPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+    }
+
+    Vector<uint8> compressedData;
+    if (!CompressData(data.data(), uint32(data.size()), compressedData, settings))
+    {
+        Logger::Error("[AnimationClipCompressor] Failed to parse animation data. File: %s", srcPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    ScopedPtr<File> file(File::Create(dstPath, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[AnimationClipCompressor] Can't create animation file. File: %s", dstPath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    header.version = AnimationClip::ANIMATION_CLIP_FILE_VERSION;
+    header.dataSize = uint32(compressedData.size());
+    header.crc32 = CRC32::ForBuffer(compressedData.data(), compressedData.size());
+
+    file->Write(&header);
+    file->Write(compressedData.data(), header.dataSize);
+    return true;
+}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+class FilePath;
+
+/**
+    Offline converter of animation clips into compressed channel encoding (`AnimationChannel::COMPRESSION_QUANTIZED16`).
+
+    For every linear and spherical-linear channel:
+    - keys which can be restored by interpolation of neighbours within tolerance are removed;
+    - key times and values are quantized to 16 bits in ranges of the channel;
+    - uniform-segment index is built, so `AnimationChannel::Evaluate` finds keys in constant time.
+    Tolerances are absolute per component (units for position and scale, quaternion components for orientation).
+    Quantization adds error up to half of range/65535 per component.
+    Bezier and already compressed channels are copied as is.
+*/
+class AnimationClipCompressor final
+{
+public:
+    struct Settings
+    {
+        float32 positionTolerance = 0.001f;
+        float32 orientationTolerance = 0.0005f;
+        float32 scaleTolerance = 0.0005f;
+    };
+
+    /** Compress clip file `srcPath` into `dstPath`. Paths can be equal. Return false and log error on failure. */
+    static bool Compress(const FilePath& srcPath, const FilePath& dstPath, const Settings& settings);
+
+    /** Compress clip data which follows `AnimationClip::FileHeader`. */
+    static bool CompressData(const uint8* data, uint32 size, Vector<uint8>& outData, const Settings& settings);
+};
+}
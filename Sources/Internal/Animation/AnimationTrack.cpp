@@ -18,6 +18,12 @@ uint32 AnimationTrack::Bind(const uint8* _data)
         uint32 channelsCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
+        // each target is animated by one channel, so bigger count means malformed data
+        if (channelsCount > CHANNEL_TARGET_COUNT)
+        {
+            return 0;
+        }
+
         channels.resize(channelsCount);
 
         for (uint32 c = 0; c < channelsCount; ++c)
@@ -28,7 +34,7 @@ uint32 AnimationTrack::Bind(const uint8* _data)
             dataptr += 3; //pad
 
             uint32 boundData = channels[c].channel.Bind(dataptr);
-            if (boundData == 0)
+            if (boundData == 0 || channels[c].target >= CHANNEL_TARGET_COUNT || channels[c].channel.GetDimension() > AnimationChannel::MAX_DIMENSION)
             {
                 channels.clear();
                 return 0;
@@ -47,6 +53,18 @@ void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, ui
     channels[channel].channel.Evaluate(time, outData, dataSize);
 }
 
+void AnimationTrack::EvaluateChannels(float32 time, float32* outData, uint32 dataSize) const
+{
+    DVASSERT(dataSize >= GetChannelsCount() * AnimationChannel::MAX_DIMENSION);
+
+    float32* channelData = outData;
+    for (uint32 c = 0, count = Min(GetChannelsCount(), dataSize / AnimationChannel::MAX_DIMENSION); c < count; ++c)
+    {
+        channels[c].channel.Evaluate(time, channelData, AnimationChannel::MAX_DIMENSION);
+        channelData += AnimationChannel::MAX_DIMENSION;
+    }
+}
+
 uint32 AnimationTrack::GetChannelsCount() const
 {
     return uint32(channels.size());
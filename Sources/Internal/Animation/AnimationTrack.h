@@ -21,6 +21,14 @@ public:
     uint32 Bind(const uint8* data);
     void Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize) const;
 
+    /**
+        Evaluate all channels in one pass.
+        Value of channel `c` is written to `outData + c * AnimationChannel::MAX_DIMENSION`,
+        so `dataSize` should be at least `GetChannelsCount() * AnimationChannel::MAX_DIMENSION`.
+        Channels which don't fit into `dataSize` are not evaluated.
+    */
+    void EvaluateChannels(float32 time, float32* outData, uint32 dataSize) const;
+
     uint32 GetChannelsCount() const;
     eChannelTarget GetChannelTarget(uint32 channel) const;
 
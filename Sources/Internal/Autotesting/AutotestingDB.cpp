@@ -214,7 +214,7 @@ String AutotestingDB::YamlToString(const KeyedArchive* archive)
         {
         case VariantType::TYPE_BOOLEAN:
         {
-            if (obj.second->boolValue)
+            if (obj.second->AsBool())
             {
                 result += Format("  t%s: {string: \"true\"}\\n", obj.first.c_str());
             }
@@ -226,22 +226,17 @@ String AutotestingDB::YamlToString(const KeyedArchive* archive)
         break;
         case VariantType::TYPE_INT32:
         {
-            result += Format("  %s: {string: \"%d\"}\\n", obj.first.c_str(), obj.second->int32Value);
+            result += Format("  %s: {string: \"%d\"}\\n", obj.first.c_str(), obj.second->AsInt32());
         }
         break;
         case VariantType::TYPE_FLOAT:
         {
-            result += Format("  %s: {string: \"%f\"}\\n", obj.first.c_str(), obj.second->floatValue);
+            result += Format("  %s: {string: \"%f\"}\\n", obj.first.c_str(), obj.second->AsFloat());
         }
         break;
         case VariantType::TYPE_STRING:
         {
-            result += Format("  %s: {string: \"%s\"}\\n", obj.first.c_str(), obj.second->stringValue->c_str());
-        }
-        break;
-        case VariantType::TYPE_WIDE_STRING:
-        {
-            result += Format("  %s: {string: \"%s\"}\\n", obj.first.c_str(), obj.second->wideStringValue->c_str());
+            result += Format("  %s: {string: \"%s\"}\\n", obj.first.c_str(), obj.second->AsString().c_str());
         }
         break;
 
@@ -8,6 +8,7 @@
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "Scripting/Private/LuaBytecodeCache.h"
 #include "Utils/Utils.h"
 #include "UI/RichContent/UIRichContentComponent.h"
 #include "UI/ScrollHelper.h"
@@ -953,7 +954,7 @@ bool AutotestingSystemLua::LoadScriptFromFile(const FilePath& luaFilePath)
     file->Read(data, static_cast<uint32>(file->GetSize()));
     uint32 fileSize = static_cast<uint32>(file->GetSize());
     file->Release();
-    bool result = luaL_loadbuffer(luaState, data, fileSize, luaFilePath.GetAbsolutePathname().c_str()) == LUA_OK;
+    bool result = LuaBytecodeCache::LoadBuffer(luaState, data, fileSize, luaFilePath.GetAbsolutePathname().c_str()) == LUA_OK;
     delete[] data;
     if (!result)
     {
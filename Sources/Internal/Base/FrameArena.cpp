@@ -0,0 +1,158 @@
+#include "Base/FrameArena.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/ThreadLocalPtr.h"
+#include "Debug/DVAssert.h"
+
+#if defined(DAVA_MEMORY_PROFILING_ENABLE)
+#include "MemoryManager/MemoryManager.h"
+#endif
+
+namespace DAVA
+{
+namespace FrameArenaDetail
+{
+Atomic<uint32> globalFrameIndex(0);
+
+ThreadLocalPtr<FrameArena>& GetThreadArenaPtr()
+{
+    static ThreadLocalPtr<FrameArena> threadArena;
+    return threadArena;
+}
+
+void* AllocatePage(size_t size)
+{
+#if defined(DAVA_MEMORY_PROFILING_ENABLE)
+    return MemoryManager::Instance()->Allocate(size, ALLOC_POOL_FRAME_ARENA);
+#else
+    return ::operator new(size);
+#endif
+}
+
+void FreePage(void* ptr)
+{
+#if defined(DAVA_MEMORY_PROFILING_ENABLE)
+    MemoryManager::Instance()->Deallocate(ptr);
+#else
+    ::operator delete(ptr);
+#endif
+}
+}
+
+FrameArena::FrameArena(size_t pageSize_)
+    : pageSize(pageSize_)
+{
+    DVASSERT(pageSize > 0);
+}
+
+FrameArena::~FrameArena()
+{
+    FreePages();
+}
+
+void* FrameArena::Allocate(size_t size, size_t align)
+{
+    DVASSERT(align > 0 && (align & (align - 1)) == 0);
+
+    if (isThreadArena)
+    {
+        RewindThreadArena();
+    }
+
+    while (currentPage < pages.size())
+    {
+        const Page& page = pages[currentPage];
+        uintptr_t begin = reinterpret_cast<uintptr_t>(page.data) + pageOffset;
+        uintptr_t aligned = (begin + align - 1) & ~(uintptr_t(align) - 1);
+        size_t offset = pageOffset + static_cast<size_t>(aligned - begin);
+
+        if (offset + size <= page.size)
+        {
+            pageOffset = offset + size;
+            usedSize += size;
+            peakSize = std::max(peakSize, usedSize);
+            return page.data + offset;
+        }
+
+        ++currentPage;
+        pageOffset = 0;
+    }
+
+    AddPage(size + align);
+    return Allocate(size, align);
+}
+
+void FrameArena::Reset()
+{
+    if (pages.size() > 1)
+    {
+        // frame data didn't fit into single page, replace pages with one page of total size
+        size_t totalSize = reservedSize;
+        FreePages();
+        AddPage(totalSize);
+    }
+
+    currentPage = 0;
+    pageOffset = 0;
+    usedSize = 0;
+}
+
+FrameArena* FrameArena::GetThreadArena()
+{
+    ThreadLocalPtr<FrameArena>& threadArena = FrameArenaDetail::GetThreadArenaPtr();
+
+    FrameArena* arena = threadArena.Get();
+    if (arena == nullptr)
+    {
+        arena = new FrameArena();
+        arena->isThreadArena = true;
+        arena->frameIndex = FrameArenaDetail::globalFrameIndex.Get();
+        threadArena.Reset(arena);
+    }
+    return arena;
+}
+
+void FrameArena::ReleaseThreadArena()
+{
+    FrameArenaDetail::GetThreadArenaPtr().Reset();
+}
+
+void FrameArena::NextFrame()
+{
+    FrameArenaDetail::globalFrameIndex.Increment();
+}
+
+void FrameArena::AddPage(size_t minSize)
+{
+    Page page;
+    page.size = std::max(minSize, pageSize);
+    page.data = static_cast<uint8*>(FrameArenaDetail::AllocatePage(page.size));
+
+    pages.push_back(page);
+    reservedSize += page.size;
+    currentPage = pages.size() - 1;
+    pageOffset = 0;
+}
+
+void FrameArena::FreePages()
+{
+    for (Page& page : pages)
+    {
+        FrameArenaDetail::FreePage(page.data);
+    }
+
+    pages.clear();
+    reservedSize = 0;
+    currentPage = 0;
+    pageOffset = 0;
+}
+
+void FrameArena::RewindThreadArena()
+{
+    uint32 globalFrameIndex = FrameArenaDetail::globalFrameIndex.Get();
+    if (frameIndex != globalFrameIndex)
+    {
+        frameIndex = globalFrameIndex;
+        Reset();
+    }
+}
+} // namespace DAVA
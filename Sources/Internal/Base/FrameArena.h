@@ -0,0 +1,171 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace DAVA
+{
+/**
+    Linear allocator for temporary data which lives no longer than one frame.
+
+    Memory is taken from large pages by bumping an offset, single deallocations are no-ops and
+    all memory is reclaimed at once by `Reset`. If frame data didn't fit into the first page,
+    pages are merged into one large page on `Reset`, so the next frame is served without extra page allocations.
+
+    Each thread has its own arena returned by `GetThreadArena`, so allocations don't need synchronization.
+    Thread arenas are rewound lazily on first allocation after `NextFrame`, which is called by engine once per frame.
+    Thread arena is freed by `ReleaseThreadArena`, which is called on exit of `Thread` and on engine cleanup for main thread;
+    threads created bypassing `Thread` should call it by themselves.
+    Memory allocated from thread arena must not be used after the end of the frame and must not be passed
+    to asynchronous jobs which can outlive the frame.
+
+    Pages are tracked by memory profiler in `ALLOC_POOL_FRAME_ARENA` pool.
+
+    ```
+    FrameVector<uint16> indices;
+    indices.reserve(count);
+    ```
+*/
+class FrameArena final
+{
+public:
+    static const size_t DEFAULT_PAGE_SIZE = 256 * 1024;
+    static const size_t DEFAULT_ALIGN = 16;
+
+    explicit FrameArena(size_t pageSize = DEFAULT_PAGE_SIZE);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /** Allocate `size` bytes aligned by `align`, which should be power of two. */
+    void* Allocate(size_t size, size_t align = DEFAULT_ALIGN);
+
+    /** Forget all allocations. */
+    void Reset();
+
+    /** Return size of memory allocated since last `Reset`. */
+    size_t GetUsedSize() const;
+    /** Return maximum size of memory allocated between two resets. */
+    size_t GetPeakSize() const;
+    /** Return total size of allocated pages. */
+    size_t GetReservedSize() const;
+
+    /** Return arena of the calling thread. */
+    static FrameArena* GetThreadArena();
+
+    /** Free arena of the calling thread, next `GetThreadArena` call will create a new one. */
+    static void ReleaseThreadArena();
+
+    /** Start new frame, memory allocated from thread arenas during previous frame becomes invalid. */
+    static void NextFrame();
+
+private:
+    struct Page
+    {
+        uint8* data = nullptr;
+        size_t size = 0;
+    };
+
+    void AddPage(size_t minSize);
+    void FreePages();
+    void RewindThreadArena();
+
+    Vector<Page> pages;
+    size_t currentPage = 0;
+    size_t pageOffset = 0;
+    size_t pageSize = 0;
+
+    size_t usedSize = 0;
+    size_t peakSize = 0;
+    size_t reservedSize = 0;
+
+    uint32 frameIndex = 0;
+    bool isThreadArena = false;
+};
+
+inline size_t FrameArena::GetUsedSize() const
+{
+    return usedSize;
+}
+
+inline size_t FrameArena::GetPeakSize() const
+{
+    return peakSize;
+}
+
+inline size_t FrameArena::GetReservedSize() const
+{
+    return reservedSize;
+}
+
+/**
+    STL allocator which takes memory from `FrameArena`, by default from the arena of the calling thread.
+    Container which uses it should be destroyed or cleared in the same frame.
+*/
+template <typename T>
+class FrameArenaAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = FrameArenaAllocator<U>;
+    };
+
+    FrameArenaAllocator()
+        : arena(FrameArena::GetThreadArena())
+    {
+    }
+
+    explicit FrameArenaAllocator(FrameArena* arena_)
+        : arena(arena_)
+    {
+    }
+
+    template <typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U>& other) DAVA_NOEXCEPT
+    : arena(other.arena)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T) > FrameArena::DEFAULT_ALIGN ? alignof(T) : FrameArena::DEFAULT_ALIGN));
+    }
+
+    void deallocate(T*, size_t)
+    {
+    }
+
+    template <typename U>
+    bool operator==(const FrameArenaAllocator<U>& other) const
+    {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const FrameArenaAllocator<U>& other) const
+    {
+        return arena != other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class FrameArenaAllocator;
+
+    FrameArena* arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+} // namespace DAVA
@@ -1,4 +1,6 @@
 #include "CommandLine/CommandLineParser.h"
+#include "Concurrency/Thread.h"
+#include "Concurrency/ThreadLocalPtr.h"
 #include "Logger/Logger.h"
 
 #include "Engine/Engine.h"
@@ -10,6 +12,12 @@ namespace DAVA
 {
 const int32 INVALID_POSITION = -1;
 
+ThreadLocalPtr<Vector<CommandLineParser::Flag>>& CommandLineParser::GetThreadFlags()
+{
+    static ThreadLocalPtr<Vector<Flag>> threadFlags;
+    return threadFlags;
+}
+
 CommandLineParser::CommandLineParser()
     : isVerbose(false)
     , isExtendedOutput(false)
@@ -17,21 +25,35 @@ CommandLineParser::CommandLineParser()
 {
 }
 
+const Vector<CommandLineParser::Flag>& CommandLineParser::GetCurrentFlags() const
+{
+    const Vector<Flag>* threadFlags = GetThreadFlags().Get();
+    return (threadFlags != nullptr) ? *threadFlags : flags;
+}
+
 void CommandLineParser::SetFlags(const Vector<String>& tokens)
 {
     ClearFlags();
 
+    Vector<Flag>* currentFlagsPtr = &flags;
+    if (!Thread::IsMainThread())
+    {
+        currentFlagsPtr = new Vector<Flag>();
+        GetThreadFlags().Reset(currentFlagsPtr);
+    }
+
+    Vector<Flag>& currentFlags = *currentFlagsPtr;
     for (auto& token : tokens)
     {
         if ((token.length() >= 1) && (token[0] == '-'))
         {
-            flags.emplace_back(token);
+            currentFlags.emplace_back(token);
         }
         else
         {
-            if (!flags.empty())
+            if (!currentFlags.empty())
             {
-                flags.back().params.push_back(token);
+                currentFlags.back().params.push_back(token);
             }
             else
             {
@@ -43,7 +65,14 @@ void CommandLineParser::SetFlags(const Vector<String>& tokens)
 
 void CommandLineParser::ClearFlags()
 {
-    flags.clear();
+    if (Thread::IsMainThread())
+    {
+        flags.clear();
+    }
+    else
+    {
+        GetThreadFlags().Reset();
+    }
 }
 
 void CommandLineParser::SetVerbose(bool _isVerbose)
@@ -82,7 +111,7 @@ CommandLineParser::~CommandLineParser()
 
 bool CommandLineParser::IsFlagSet(const String& s) const
 {
-    for (auto& flag : flags)
+    for (auto& flag : GetCurrentFlags())
     {
         if (flag.name == s)
             return true;
@@ -103,7 +132,7 @@ String CommandLineParser::GetParamForFlag(const String& flag)
 
 Vector<String> CommandLineParser::GetParamsForFlag(const String& flagname)
 {
-    for (auto& flag : flags)
+    for (auto& flag : GetCurrentFlags())
     {
         if (flag.name == flagname)
             return flag.params;
@@ -6,6 +6,9 @@
 
 namespace DAVA
 {
+template <typename T>
+class ThreadLocalPtr;
+
 class CommandLineParser : public StaticSingleton<CommandLineParser>
 {
 public:
@@ -21,6 +24,11 @@ public:
     void SetUseTeamcityOutput(bool use);
     bool UseTeamcityOutput() const;
 
+    /**
+        Set flags which are checked by `IsFlagSet` and `GetParamsForFlag`.
+        Flags set from non-main thread are visible only in that thread, so several threads can work with their own flags.
+        Thread which didn't set its own flags (or cleared them) sees flags of main thread.
+    */
     void SetFlags(const Vector<String>& arguments);
     void ClearFlags();
 
@@ -50,6 +58,9 @@ private:
         Vector<String> params;
     };
 
+    static ThreadLocalPtr<Vector<Flag>>& GetThreadFlags();
+    const Vector<Flag>& GetCurrentFlags() const;
+
     Vector<Flag> flags;
     bool isVerbose;
     bool isExtendedOutput;
@@ -1,5 +1,6 @@
 #include <thread>
 #include "Concurrency/Thread.h"
+#include "Base/FrameArena.h"
 #include "Concurrency/LockGuard.h"
 #include "Logger/Logger.h"
 
@@ -143,6 +144,8 @@ void Thread::ThreadFunction(void* param)
 
     t->threadFunc();
 
+    FrameArena::ReleaseThreadArena();
+
     // Zero id to mark thread as finished in thread list obtained through GetThreadList() function.
     // This prevents from retrieving invalid Thread instance through Thread::Current()
     // as system can reuse thread ids.
@@ -30,6 +30,7 @@ const char* UI_TEXTBLOCK_PREPARE = "UI::TextBlock::Prepare";
 
 //Scene
 const char* SCENE_UPDATE = "Scene::Update";
+const char* SCENE_SYSTEMS_STAGE = "Scene::SystemsStage";
 const char* SCENE_DRAW = "Scene::Draw";
 const char* SCENE_STATIC_OCCLUSION_SYSTEM = "StaticOcclusionSystem";
 const char* SCENE_ANIMATION_SYSTEM = "AnimationSystem";
@@ -30,6 +30,7 @@ extern const char* UI_TEXTBLOCK_PREPARE;
 
 //Scene
 extern const char* SCENE_UPDATE;
+extern const char* SCENE_SYSTEMS_STAGE;
 extern const char* SCENE_DRAW;
 extern const char* SCENE_STATIC_OCCLUSION_SYSTEM;
 extern const char* SCENE_ANIMATION_SYSTEM;
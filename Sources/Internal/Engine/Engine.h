@@ -254,6 +254,10 @@ public:
         | max_command_buffer_count        |                            | 0              |
         | max_packet_list_count           |                            | 0              |
         | shader_const_buffer_size        |                            | 0              |
+        | shader_translation_cache        | Translated shaders folder  | ""             |
+
+        If `shader_translation_cache` is set, shaders translated for host api are kept there between runs,
+        see rhi::ShaderSourceCache::SetTranslationCacheDirectory.
 
         For more info on render options ask RHI guys.
     
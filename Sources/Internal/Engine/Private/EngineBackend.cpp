@@ -16,6 +16,7 @@
 #include "ReflectionDeclaration/ReflectionDeclaration.h"
 #include "Autotesting/AutotestingSystem.h"
 #include "Base/AllocatorFactory.h"
+#include "Base/FrameArena.h"
 #include "Base/ObjectFactory.h"
 #include "Core/PerformanceSettings.h"
 #include "Debug/ProfilerCPU.h"
@@ -55,6 +56,7 @@
 #include "Render/Image/ImageConverter.h"
 #include "Render/Renderer.h"
 #include "Render/RHI/rhi_ShaderSource.h"
+#include "Render/ShaderCache.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
 #include "Sound/SoundEvent.h"
 #include "Sound/SoundSystem.h"
@@ -361,6 +363,7 @@ void EngineBackend::OnGameLoopStopped()
     if (!IsConsoleMode())
     {
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        ShaderDescriptorCache::SaveVariantsList("~doc:/ShaderVariants.txt");
     }
 
     Logger::Info("EngineBackend::OnGameLoopStopped: leave");
@@ -392,6 +395,8 @@ void EngineBackend::OnEngineCleanup()
     SafeDelete(dispatcher);
     SafeDelete(platformCore);
 
+    FrameArena::ReleaseThreadArena();
+
     DAVA_MEMORY_PROFILER_FINISH();
 }
 
@@ -427,6 +432,7 @@ void EngineBackend::OnFrameConsole()
     // Notify memory profiler about new frame
     DAVA_MEMORY_PROFILER_UPDATE();
 
+    FrameArena::NextFrame();
     globalFrameIndex += 1;
 }
 
@@ -471,6 +477,7 @@ int32 EngineBackend::OnFrame()
     // Notify memory profiler about new frame
     DAVA_MEMORY_PROFILER_UPDATE();
 
+    FrameArena::NextFrame();
     globalFrameIndex += 1;
     return Renderer::GetDesiredFPS();
 }
@@ -809,6 +816,11 @@ void EngineBackend::InitRenderer(Window* w)
 
     w->InitCustomRenderParams(rendererParams);
 
+    String shaderTranslationCache = options->GetString("shader_translation_cache");
+    if (!shaderTranslationCache.empty())
+    {
+        rhi::ShaderSourceCache::SetTranslationCacheDirectory(shaderTranslationCache);
+    }
     rhi::ShaderSourceCache::Load("~doc:/ShaderSource.bin");
     Renderer::Initialize(renderer, rendererParams);
     context->renderSystem2D->Init();
@@ -10,6 +10,31 @@ SceneSystem::SceneSystem(Scene* scene_)
 {
 }
 
+void SceneSystem::SetProcessAccess(const ComponentMask& readComponents, const ComponentMask& writeComponents, uint32 sharedState)
+{
+    processReadComponents = readComponents;
+    processWriteComponents = writeComponents;
+    processSharedState = sharedState;
+    hasProcessAccess = true;
+}
+
+bool SceneSystem::IsProcessConflicting(const SceneSystem* other) const
+{
+    if (!hasProcessAccess || !other->hasProcessAccess)
+    {
+        return true;
+    }
+
+    if ((processSharedState & other->processSharedState) != 0)
+    {
+        return true;
+    }
+
+    ComponentMask used = processReadComponents | processWriteComponents;
+    ComponentMask otherUsed = other->processReadComponents | other->processWriteComponents;
+    return (processWriteComponents & otherUsed).any() || (other->processWriteComponents & used).any();
+}
+
 void SceneSystem::RegisterEntity(Entity* entity)
 {
     const ComponentMask& requiredComponents = this->GetRequiredComponents();
@@ -25,6 +25,28 @@ public:
     inline void SetRequiredComponents(const ComponentMask& requiredComponents);
     inline const ComponentMask& GetRequiredComponents() const;
 
+    /** Scene state outside of components which can be changed by `Process` of system with declared access. */
+    enum eProcessSharedState : uint32
+    {
+        PROCESS_SHARED_RENDER_SYSTEM = 1 << 0, ///< `RenderSystem` of scene: marking objects for update, adding to render, debug drawer
+    };
+
+    /**
+        \brief Declare components which are read and written by `Process`.
+                System with declared access can be processed concurrently with other systems
+                which don't write components it uses and don't change same shared state, see `Scene::SetParallelProcessEnabled`.
+                Such system may read scene state which is changed only by systems without declared access (e.g. `TransformSingleComponent`, camera),
+                should not touch other scene state and should not call user callbacks in `Process`,
+                and should not wait for all worker jobs or for main-thread jobs (`JobManager::ParallelFor` can be used to split own work).
+                Should be called before system is added to scene.
+        \param[in] sharedState combination of `eProcessSharedState` flags.
+     */
+    void SetProcessAccess(const ComponentMask& readComponents, const ComponentMask& writeComponents, uint32 sharedState = 0);
+    inline bool HasProcessAccess() const;
+
+    /** Return true if `Process` of this system can't be run concurrently with `Process` of `other`. */
+    bool IsProcessConflicting(const SceneSystem* other) const;
+
     /**
         \brief  This function is called when any entity registered to scene.
                 It sorts out is entity has all necessary components and we need to call AddEntity.
@@ -133,8 +155,13 @@ protected:
 
 private:
     ComponentMask requiredComponents;
+    ComponentMask processReadComponents;
+    ComponentMask processWriteComponents;
+    uint32 processSharedState = 0;
     Scene* scene = nullptr;
 
+    bool hasProcessAccess = false;
+
     bool locked = false;
 };
 
@@ -153,4 +180,9 @@ inline const ComponentMask& SceneSystem::GetRequiredComponents() const
 {
     return requiredComponents;
 }
+
+inline bool SceneSystem::HasProcessAccess() const
+{
+    return hasProcessAccess;
+}
 }
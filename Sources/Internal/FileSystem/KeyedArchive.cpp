@@ -687,7 +687,7 @@ void KeyedArchive::Dump() const
         {
         case VariantType::TYPE_BOOLEAN:
         {
-            if (obj.second->boolValue)
+            if (obj.second->AsBool())
             {
                 Logger::FrameworkDebug("%s : true", obj.first.c_str());
             }
@@ -699,47 +699,42 @@ void KeyedArchive::Dump() const
         break;
         case VariantType::TYPE_INT8:
         {
-            Logger::FrameworkDebug("%s : %hhd", obj.first.c_str(), obj.second->int8Value);
+            Logger::FrameworkDebug("%s : %hhd", obj.first.c_str(), obj.second->AsInt8());
         }
         break;
         case VariantType::TYPE_UINT8:
         {
-            Logger::FrameworkDebug("%s : %hu", obj.first.c_str(), obj.second->uint8Value);
+            Logger::FrameworkDebug("%s : %hu", obj.first.c_str(), obj.second->AsUInt8());
         }
         break;
         case VariantType::TYPE_INT16:
         {
-            Logger::FrameworkDebug("%s : %hd", obj.first.c_str(), obj.second->int16Value);
+            Logger::FrameworkDebug("%s : %hd", obj.first.c_str(), obj.second->AsInt16());
         }
         break;
         case VariantType::TYPE_UINT16:
         {
-            Logger::FrameworkDebug("%s : %hu", obj.first.c_str(), obj.second->uint16Value);
+            Logger::FrameworkDebug("%s : %hu", obj.first.c_str(), obj.second->AsUInt16());
         }
         break;
         case VariantType::TYPE_INT32:
         {
-            Logger::FrameworkDebug("%s : %d", obj.first.c_str(), obj.second->int32Value);
+            Logger::FrameworkDebug("%s : %d", obj.first.c_str(), obj.second->AsInt32());
         }
         break;
         case VariantType::TYPE_UINT32:
         {
-            Logger::FrameworkDebug("%s : %u", obj.first.c_str(), obj.second->uint32Value);
+            Logger::FrameworkDebug("%s : %u", obj.first.c_str(), obj.second->AsUInt32());
         }
         break;
         case VariantType::TYPE_FLOAT:
         {
-            Logger::FrameworkDebug("%s : %f", obj.first.c_str(), obj.second->floatValue);
+            Logger::FrameworkDebug("%s : %f", obj.first.c_str(), obj.second->AsFloat());
         }
         break;
         case VariantType::TYPE_STRING:
         {
-            Logger::FrameworkDebug("%s : %s", obj.first.c_str(), obj.second->stringValue->c_str());
-        }
-        break;
-        case VariantType::TYPE_WIDE_STRING:
-        {
-            Logger::FrameworkDebug("%s : %S", obj.first.c_str(), obj.second->wideStringValue->c_str());
+            Logger::FrameworkDebug("%s : %s", obj.first.c_str(), obj.second->AsString().c_str());
         }
         break;
 
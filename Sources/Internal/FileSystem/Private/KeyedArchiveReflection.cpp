@@ -499,28 +499,28 @@ ReflectedObject KeyedArchiveElementValueWrapper::GetValueObject(const ReflectedO
         result = ReflectedObject(value->AsKeyedArchive());
         break;
     case VariantType::TYPE_VECTOR2:
-        result = ReflectedObject(value->vector2Value);
+        result = ReflectedObject(static_cast<Vector2*>(value->MetaObject()));
         break;
     case VariantType::TYPE_VECTOR3:
-        result = ReflectedObject(value->vector3Value);
+        result = ReflectedObject(static_cast<Vector3*>(value->MetaObject()));
         break;
     case VariantType::TYPE_VECTOR4:
-        result = ReflectedObject(value->vector4Value);
+        result = ReflectedObject(static_cast<Vector4*>(value->MetaObject()));
         break;
     case VariantType::TYPE_MATRIX2:
-        result = ReflectedObject(value->matrix2Value);
+        result = ReflectedObject(static_cast<Matrix2*>(value->MetaObject()));
         break;
     case VariantType::TYPE_MATRIX3:
-        result = ReflectedObject(value->matrix3Value);
+        result = ReflectedObject(static_cast<Matrix3*>(value->MetaObject()));
         break;
     case VariantType::TYPE_MATRIX4:
-        result = ReflectedObject(value->matrix4Value);
+        result = ReflectedObject(static_cast<Matrix4*>(value->MetaObject()));
         break;
     case VariantType::TYPE_COLOR:
-        result = ReflectedObject(value->colorValue);
+        result = ReflectedObject(static_cast<Color*>(value->MetaObject()));
         break;
     case VariantType::TYPE_AABBOX3:
-        result = ReflectedObject(value->aabbox3);
+        result = ReflectedObject(static_cast<AABBox3*>(value->MetaObject()));
         break;
     default:
         break;
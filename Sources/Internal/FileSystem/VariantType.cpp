@@ -16,8 +16,94 @@
 #include "Base/FastName.h"
 #include "Math/AABBox3.h"
 
+#include <atomic>
+#include <new>
+#include <type_traits>
+
 namespace DAVA
 {
+namespace VariantTypeDetails
+{
+/** Storage shared between copies of variant, it is copied before modification */
+struct SharedStorage
+{
+    virtual ~SharedStorage() = default;
+    std::atomic<int32> refCount{ 1 };
+};
+
+template <typename T>
+struct SharedValue : public SharedStorage
+{
+    explicit SharedValue(const T& value_)
+        : value(value_)
+    {
+    }
+    T value;
+};
+
+using SharedString = SharedValue<String>;
+using SharedByteArray = SharedValue<Vector<uint8>>;
+using SharedFilePath = SharedValue<FilePath>;
+
+bool IsSharedType(VariantType::eVariantType type)
+{
+    return type == VariantType::TYPE_STRING ||
+    type == VariantType::TYPE_BYTE_ARRAY ||
+    type == VariantType::TYPE_FILEPATH;
+}
+
+bool IsInlineType(VariantType::eVariantType type)
+{
+    return type == VariantType::TYPE_VECTOR2 ||
+    type == VariantType::TYPE_VECTOR3 ||
+    type == VariantType::TYPE_VECTOR4 ||
+    type == VariantType::TYPE_MATRIX2 ||
+    type == VariantType::TYPE_COLOR ||
+    type == VariantType::TYPE_FASTNAME ||
+    type == VariantType::TYPE_AABBOX3;
+}
+
+void RetainShared(void* storage)
+{
+    static_cast<SharedStorage*>(storage)->refCount++;
+}
+
+void ReleaseShared(void* storage)
+{
+    SharedStorage* shared = static_cast<SharedStorage*>(storage);
+    if (shared != nullptr && --shared->refCount == 0)
+    {
+        delete shared;
+    }
+}
+
+bool IsUniqueShared(void* storage)
+{
+    return storage != nullptr && static_cast<SharedStorage*>(storage)->refCount == 1;
+}
+
+template <typename T>
+const T& GetSharedValue(void* storage)
+{
+    return static_cast<SharedValue<T>*>(storage)->value;
+}
+
+/** Return value which isn't shared with other variants, `storage` is replaced by copy if it is shared */
+template <typename T>
+T& GetUniqueSharedValue(void*& storage)
+{
+    SharedValue<T>* shared = static_cast<SharedValue<T>*>(storage);
+    if (!IsUniqueShared(shared))
+    {
+        SharedValue<T>* copy = new SharedValue<T>(shared->value);
+        ReleaseShared(shared);
+        storage = copy;
+        shared = copy;
+    }
+    return shared->value;
+}
+}
+
 const String VariantType::TYPENAME_UNKNOWN = "unknown";
 const String VariantType::TYPENAME_BOOLEAN = "bool";
 const String VariantType::TYPENAME_INT8 = "int8";
@@ -89,9 +175,7 @@ VariantType::VariantType(const VariantType& var)
 
 VariantType::VariantType(VariantType&& value)
 {
-    type = value.type;
-    int64Value = value.int64Value;
-    value.type = TYPE_NONE;
+    MoveFrom(value);
 }
 
 VariantType::VariantType(bool value)
@@ -319,27 +403,62 @@ void VariantType::SetFloat64(float64 value)
     float64Value = value;
 }
 
+template <class T>
+void VariantType::SetInlineValue(VariantType::eVariantType nextType, const T& value)
+{
+    static_assert(sizeof(T) <= INLINE_VALUE_SIZE, "Value doesn't fit into inline storage");
+    static_assert(std::is_trivially_destructible<T>::value, "Inline value is released without destructor call");
+
+    if (nextType != type)
+    {
+        ReleasePointer();
+        type = nextType;
+    }
+    new (inlineValue) T(value);
+}
+
+template <class T>
+void VariantType::SetSharedValue(VariantType::eVariantType nextType, const T& value)
+{
+    using namespace VariantTypeDetails;
+
+    if (nextType == type && IsUniqueShared(pointerValue))
+    {
+        static_cast<SharedValue<T>*>(pointerValue)->value = value;
+    }
+    else
+    {
+        // Value can be stored in current shared storage, so it is copied before release
+        SharedValue<T>* shared = new SharedValue<T>(value);
+        ReleasePointer();
+        pointerValue = shared;
+        type = nextType;
+    }
+}
+
 void VariantType::SetString(const String& value)
 {
-    SetValueWithAllocation(TYPE_STRING, value);
+    SetSharedValue(TYPE_STRING, value);
 }
 void VariantType::SetWideString(const WideString& value)
 {
-    SetValueWithAllocation(TYPE_STRING, String(UTF8Utils::EncodeToUTF8(value)));
+    SetSharedValue(TYPE_STRING, String(UTF8Utils::EncodeToUTF8(value)));
 }
 
 void VariantType::SetByteArray(const uint8* array, int32 arraySizeInBytes)
 {
-    if (type != TYPE_BYTE_ARRAY)
+    using namespace VariantTypeDetails;
+
+    if (type == TYPE_BYTE_ARRAY && IsUniqueShared(pointerValue))
     {
-        ReleasePointer();
-        auto vec = new Vector<uint8>(array, array + arraySizeInBytes);
-        pointerValue = static_cast<void*>(vec);
-        type = TYPE_BYTE_ARRAY;
+        static_cast<SharedByteArray*>(pointerValue)->value.assign(array, array + arraySizeInBytes);
     }
     else
     {
-        (static_cast<Vector<uint8>*>(pointerValue))->assign(array, array + arraySizeInBytes);
+        SharedByteArray* shared = new SharedByteArray(Vector<uint8>(array, array + arraySizeInBytes));
+        ReleasePointer();
+        pointerValue = shared;
+        type = TYPE_BYTE_ARRAY;
     }
 }
 
@@ -396,22 +515,22 @@ void VariantType::SetUInt64(const uint64& value)
 
 void VariantType::SetVector2(const Vector2& value)
 {
-    SetValueWithAllocation(TYPE_VECTOR2, value);
+    SetInlineValue(TYPE_VECTOR2, value);
 }
 
 void VariantType::SetVector3(const Vector3& value)
 {
-    SetValueWithAllocation(TYPE_VECTOR3, value);
+    SetInlineValue(TYPE_VECTOR3, value);
 }
 
 void VariantType::SetVector4(const Vector4& value)
 {
-    SetValueWithAllocation(TYPE_VECTOR4, value);
+    SetInlineValue(TYPE_VECTOR4, value);
 }
 
 void VariantType::SetMatrix2(const Matrix2& value)
 {
-    SetValueWithAllocation(TYPE_MATRIX2, value);
+    SetInlineValue(TYPE_MATRIX2, value);
 }
 
 void VariantType::SetMatrix3(const Matrix3& value)
@@ -425,31 +544,51 @@ void VariantType::SetMatrix4(const Matrix4& value)
 
 void VariantType::SetColor(const DAVA::Color& value)
 {
-    SetValueWithAllocation(TYPE_COLOR, value);
+    SetInlineValue(TYPE_COLOR, value);
 }
 
 void VariantType::SetFastName(const DAVA::FastName& value)
 {
-    SetValueWithAllocation(TYPE_FASTNAME, value);
+    SetInlineValue(TYPE_FASTNAME, value);
 }
 
 void VariantType::SetAABBox3(const DAVA::AABBox3& value)
 {
-    SetValueWithAllocation(TYPE_AABBOX3, value);
+    SetInlineValue(TYPE_AABBOX3, value);
 }
 
 void VariantType::SetFilePath(const FilePath& value)
 {
-    SetValueWithAllocation(TYPE_FILEPATH, value);
+    SetSharedValue(TYPE_FILEPATH, value);
 }
 
 void VariantType::SetVariant(const VariantType& var)
 {
+    using namespace VariantTypeDetails;
+
     if (this == &var)
     {
         return;
     }
 
+    if (IsSharedType(var.type))
+    {
+        void* shared = var.pointerValue;
+        RetainShared(shared);
+        ReleasePointer();
+        pointerValue = shared;
+        type = var.type;
+        return;
+    }
+
+    if (IsInlineType(var.type))
+    {
+        ReleasePointer();
+        Memcpy(inlineValue, var.inlineValue, INLINE_VALUE_SIZE);
+        type = var.type;
+        return;
+    }
+
     ReleasePointer();
     type = TYPE_NONE;
 
@@ -500,22 +639,6 @@ void VariantType::SetVariant(const VariantType& var)
         SetFloat64(var.float64Value);
     }
     break;
-    case TYPE_STRING:
-    {
-        SetString(var.AsString());
-    }
-    break;
-    case TYPE_WIDE_STRING:
-    {
-        SetWideString(var.AsWideString());
-    }
-    break;
-    case TYPE_BYTE_ARRAY:
-    {
-        const Vector<uint8>* ar = static_cast<const Vector<uint8>*>(var.pointerValue);
-        SetByteArray(ar->data(), static_cast<int32>(ar->size()));
-    }
-    break;
     case TYPE_KEYED_ARCHIVE:
     {
         SetKeyedArchive(var.AsKeyedArchive());
@@ -531,26 +654,6 @@ void VariantType::SetVariant(const VariantType& var)
         SetUInt64(var.AsUInt64());
     }
     break;
-    case TYPE_VECTOR2:
-    {
-        SetVector2(var.AsVector2());
-    }
-    break;
-    case TYPE_VECTOR3:
-    {
-        SetVector3(var.AsVector3());
-    }
-    break;
-    case TYPE_VECTOR4:
-    {
-        SetVector4(var.AsVector4());
-    }
-    break;
-    case TYPE_MATRIX2:
-    {
-        SetMatrix2(var.AsMatrix2());
-    }
-    break;
     case TYPE_MATRIX3:
     {
         SetMatrix3(var.AsMatrix3());
@@ -561,26 +664,6 @@ void VariantType::SetVariant(const VariantType& var)
         SetMatrix4(var.AsMatrix4());
     }
     break;
-    case TYPE_COLOR:
-    {
-        SetColor(var.AsColor());
-    }
-    break;
-    case TYPE_FASTNAME:
-    {
-        SetFastName(var.AsFastName());
-    }
-    break;
-    case TYPE_AABBOX3:
-    {
-        SetAABBox3(var.AsAABBox3());
-    }
-    break;
-    case TYPE_FILEPATH:
-    {
-        SetFilePath(var.AsFilePath());
-    }
-    break;
 
     default:
     {
@@ -646,7 +729,7 @@ float64 VariantType::AsFloat64() const
 const String& VariantType::AsString() const
 {
     DVASSERT(type == TYPE_STRING);
-    return *stringValue;
+    return VariantTypeDetails::GetSharedValue<String>(pointerValue);
 }
 
 WideString VariantType::AsWideString() const
@@ -654,7 +737,7 @@ WideString VariantType::AsWideString() const
     DVASSERT(type == TYPE_STRING);
     if (type == TYPE_STRING)
     {
-        return UTF8Utils::EncodeToWideString(*stringValue);
+        return UTF8Utils::EncodeToWideString(VariantTypeDetails::GetSharedValue<String>(pointerValue));
     }
     return L""; // no warning
 }
@@ -662,15 +745,15 @@ WideString VariantType::AsWideString() const
 const uint8* VariantType::AsByteArray() const
 {
     DVASSERT(type == TYPE_BYTE_ARRAY);
-    const auto vec = static_cast<const Vector<uint8>*>(pointerValue);
-    return vec->empty() ? nullptr : vec->data();
+    const Vector<uint8>& vec = VariantTypeDetails::GetSharedValue<Vector<uint8>>(pointerValue);
+    return vec.empty() ? nullptr : vec.data();
 }
 
 int32 VariantType::AsByteArraySize() const
 {
     DVASSERT(type == TYPE_BYTE_ARRAY);
-    const auto vec = static_cast<const Vector<uint8>*>(pointerValue);
-    return static_cast<int32>(vec->size());
+    const Vector<uint8>& vec = VariantTypeDetails::GetSharedValue<Vector<uint8>>(pointerValue);
+    return static_cast<int32>(vec.size());
 }
 
 KeyedArchive* VariantType::AsKeyedArchive() const
@@ -694,25 +777,25 @@ uint64 VariantType::AsUInt64() const
 const Vector2& VariantType::AsVector2() const
 {
     DVASSERT(type == TYPE_VECTOR2);
-    return *vector2Value;
+    return *reinterpret_cast<const Vector2*>(inlineValue);
 }
 
 const Vector3& VariantType::AsVector3() const
 {
     DVASSERT(type == TYPE_VECTOR3);
-    return *vector3Value;
+    return *reinterpret_cast<const Vector3*>(inlineValue);
 }
 
 const Vector4& VariantType::AsVector4() const
 {
     DVASSERT(type == TYPE_VECTOR4);
-    return *vector4Value;
+    return *reinterpret_cast<const Vector4*>(inlineValue);
 }
 
 const Matrix2& VariantType::AsMatrix2() const
 {
     DVASSERT(type == TYPE_MATRIX2);
-    return *matrix2Value;
+    return *reinterpret_cast<const Matrix2*>(inlineValue);
 }
 
 const Matrix3& VariantType::AsMatrix3() const
@@ -736,25 +819,25 @@ const Matrix4& VariantType::AsMatrix4() const
 const Color& VariantType::AsColor() const
 {
     DVASSERT(type == TYPE_COLOR);
-    return *colorValue;
+    return *reinterpret_cast<const Color*>(inlineValue);
 }
 
 const FastName& VariantType::AsFastName() const
 {
     DVASSERT(type == TYPE_FASTNAME);
-    return *fastnameValue;
+    return *reinterpret_cast<const FastName*>(inlineValue);
 }
 
 const AABBox3& VariantType::AsAABBox3() const
 {
     DVASSERT(type == TYPE_AABBOX3);
-    return *aabbox3;
+    return *reinterpret_cast<const AABBox3*>(inlineValue);
 }
 
 const FilePath& VariantType::AsFilePath() const
 {
     DVASSERT(type == TYPE_FILEPATH);
-    return *filepathValue;
+    return VariantTypeDetails::GetSharedValue<FilePath>(pointerValue);
 }
 
 bool VariantType::Write(File* fp) const
@@ -851,9 +934,10 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_STRING:
     {
-        uint32 len = static_cast<uint32>(stringValue->length());
+        const String& stringValue = AsString();
+        uint32 len = static_cast<uint32>(stringValue.length());
 
-        uint32 slen = static_cast<uint32>(strlen(stringValue->c_str())); //we meet situations when string was "aa\0\0"
+        uint32 slen = static_cast<uint32>(strlen(stringValue.c_str())); //we meet situations when string was "aa\0\0"
         if (slen != len)
         {
             DVASSERT(false);
@@ -866,33 +950,17 @@ bool VariantType::Write(File* fp) const
             return false;
         }
 
-        written = fp->Write(stringValue->c_str(), len);
+        written = fp->Write(stringValue.c_str(), len);
         if (written != len)
         {
             return false;
         }
     }
     break;
-    case TYPE_WIDE_STRING:
-    {
-        uint32 len = static_cast<uint32>(wideStringValue->length());
-        written = fp->Write(&len, 4);
-        if (written != 4)
-        {
-            return false;
-        }
-
-        written = fp->Write(wideStringValue->c_str(), len * sizeof(wchar_t));
-        if (written != len * static_cast<uint32>(sizeof(wchar_t)))
-        {
-            return false;
-        }
-    }
-    break;
     case TYPE_BYTE_ARRAY:
     {
-        const Vector<uint8>* container = static_cast<const Vector<uint8>*>(pointerValue);
-        uint32 len = static_cast<uint32>(container->size());
+        const Vector<uint8>& container = VariantTypeDetails::GetSharedValue<Vector<uint8>>(pointerValue);
+        uint32 len = static_cast<uint32>(container.size());
         written = fp->Write(&len, 4);
         if (written != 4)
         {
@@ -900,8 +968,7 @@ bool VariantType::Write(File* fp) const
         }
         if (0 != len)
         {
-            container = static_cast<const Vector<uint8>*>(pointerValue);
-            written = fp->Write(&(container->front()), len);
+            written = fp->Write(container.data(), len);
             if (written != len)
             {
                 return false;
@@ -912,7 +979,7 @@ bool VariantType::Write(File* fp) const
     case TYPE_KEYED_ARCHIVE:
     {
         DynamicMemoryFile* pF = DynamicMemoryFile::Create(File::WRITE | File::APPEND);
-        (static_cast<const KeyedArchive*>(pointerValue))->Save(pF);
+        AsKeyedArchive()->Save(pF);
         uint32 len = static_cast<uint32>(pF->GetSize());
         written = fp->Write(&len, 4);
         if (written != 4)
@@ -949,7 +1016,7 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_VECTOR2:
     {
-        written = fp->Write(vector2Value, sizeof(Vector2));
+        written = fp->Write(inlineValue, sizeof(Vector2));
         if (written != sizeof(Vector2))
         {
             return false;
@@ -958,7 +1025,7 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_VECTOR3:
     {
-        written = fp->Write(vector3Value, sizeof(Vector3));
+        written = fp->Write(inlineValue, sizeof(Vector3));
         if (written != sizeof(Vector3))
         {
             return false;
@@ -967,7 +1034,7 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_VECTOR4:
     {
-        written = fp->Write(vector4Value, sizeof(Vector4));
+        written = fp->Write(inlineValue, sizeof(Vector4));
         if (written != sizeof(Vector4))
         {
             return false;
@@ -976,7 +1043,7 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_MATRIX2:
     {
-        written = fp->Write(matrix2Value, sizeof(Matrix2));
+        written = fp->Write(inlineValue, sizeof(Matrix2));
         if (written != sizeof(Matrix2))
         {
             return false;
@@ -1004,7 +1071,7 @@ bool VariantType::Write(File* fp) const
     case TYPE_COLOR:
     {
         uint32 size = static_cast<uint32>(sizeof(Color));
-        written = fp->Write(colorValue->color, size);
+        written = fp->Write(AsColor().color, size);
         if (written != size)
         {
             return false;
@@ -1013,14 +1080,15 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_FASTNAME:
     {
-        int32 len = static_cast<int32>(strlen(fastnameValue->c_str()));
+        const FastName& fastnameValue = AsFastName();
+        int32 len = static_cast<int32>(strlen(fastnameValue.c_str()));
         written = fp->Write(&len, 4);
         if (written != 4)
         {
             return false;
         }
 
-        written = fp->Write(fastnameValue->c_str(), len);
+        written = fp->Write(fastnameValue.c_str(), len);
         if (written != len)
         {
             return false;
@@ -1029,7 +1097,7 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_AABBOX3:
     {
-        written = fp->Write(aabbox3, sizeof(AABBox3));
+        written = fp->Write(inlineValue, sizeof(AABBox3));
         if (written != sizeof(AABBox3))
         {
             return false;
@@ -1038,7 +1106,7 @@ bool VariantType::Write(File* fp) const
     break;
     case TYPE_FILEPATH:
     {
-        String str = filepathValue->GetAbsolutePathname();
+        String str = AsFilePath().GetAbsolutePathname();
         uint32 len = static_cast<uint32>(str.length());
         written = fp->Write(&len, 4);
         if (written != 4)
@@ -1064,13 +1132,17 @@ bool VariantType::Write(File* fp) const
 
 bool VariantType::Read(File* fp, KeyedArchive * dictionary)
 {
-    uint32 read = fp->Read(&type, 1);
+    using namespace VariantTypeDetails;
+
+    eVariantType readType = TYPE_NONE;
+    uint32 read = fp->Read(&readType, 1);
     if (read != 1)
     {
         return false;
     }
 
     ReleasePointer();
+    type = readType;
     switch (type)
     {
     case TYPE_BOOLEAN:
@@ -1164,7 +1236,7 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
 
             const std::string& key = dictionary->GetString(std::string(keyHash, 4));
 
-            stringValue = new String(key);
+            pointerValue = new SharedString(key);
 
             return true;
         }
@@ -1177,21 +1249,23 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
                 return false;
             }
 
-            stringValue = new String(len, '\0');
-            read = fp->Read(&(*stringValue)[0], len);
+            SharedString* shared = new SharedString(String(len, '\0'));
+            pointerValue = shared;
+            String& stringValue = shared->value;
+            read = fp->Read(&stringValue[0], len);
             if (read != len)
             {
-                delete stringValue;
-                stringValue = nullptr;
+                stringValue.clear();
+                return false;
             }
 
-            uint32 slen = static_cast<uint32>(strlen(stringValue->c_str())); //we meet situations when string was "aa\0\0"
+            uint32 slen = static_cast<uint32>(strlen(stringValue.c_str())); //we meet situations when string was "aa\0\0"
             if (slen != len)
             {
-                stringValue->resize(slen);
+                stringValue.resize(slen);
             }
 
-            return (read == len);
+            return true;
         }
     }
     case TYPE_WIDE_STRING:
@@ -1203,8 +1277,10 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
             return false;
         }
 
-        wideStringValue = new WideString();
-        wideStringValue->resize(len);
+        // wide string is stored as utf8 string
+        type = TYPE_NONE;
+        WideString wideStringValue;
+        wideStringValue.resize(len);
         for (uint32 k = 0; k < len; ++k)
         {
             wchar_t c;
@@ -1213,12 +1289,9 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
             {
                 return false;
             }
-            (*wideStringValue)[k] = c;
+            wideStringValue[k] = c;
         }
-        // convert into utf8 string
-        String* str = new String(UTF8Utils::EncodeToUTF8(*wideStringValue));
-        delete wideStringValue;
-        stringValue = str;
+        pointerValue = new SharedString(UTF8Utils::EncodeToUTF8(wideStringValue));
         type = TYPE_STRING;
     }
     break;
@@ -1231,11 +1304,11 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
             return false;
         }
 
-        pointerValue = static_cast<void*>(new Vector<uint8>(len));
+        SharedByteArray* shared = new SharedByteArray(Vector<uint8>(len));
+        pointerValue = shared;
         if (0 != len)
         {
-            Vector<uint8>* container = static_cast<Vector<uint8>*>(pointerValue);
-            read = fp->Read(&container->front(), len);
+            read = fp->Read(shared->value.data(), len);
             if (read != len)
             {
                 return false;
@@ -1283,8 +1356,8 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
     break;
     case TYPE_VECTOR2:
     {
-        vector2Value = new Vector2;
-        read = fp->Read(vector2Value, sizeof(Vector2));
+        new (inlineValue) Vector2();
+        read = fp->Read(inlineValue, sizeof(Vector2));
         if (read != sizeof(Vector2))
         {
             return false;
@@ -1293,8 +1366,8 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
     break;
     case TYPE_VECTOR3:
     {
-        vector3Value = new Vector3;
-        read = fp->Read(vector3Value, sizeof(Vector3));
+        new (inlineValue) Vector3();
+        read = fp->Read(inlineValue, sizeof(Vector3));
         if (read != sizeof(Vector3))
         {
             return false;
@@ -1303,8 +1376,8 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
     break;
     case TYPE_VECTOR4:
     {
-        vector4Value = new Vector4;
-        read = fp->Read(vector4Value, sizeof(Vector4));
+        new (inlineValue) Vector4();
+        read = fp->Read(inlineValue, sizeof(Vector4));
         if (read != sizeof(Vector4))
         {
             return false;
@@ -1313,8 +1386,8 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
     break;
     case TYPE_MATRIX2:
     {
-        matrix2Value = new Matrix2;
-        read = fp->Read(matrix2Value, sizeof(Matrix2));
+        new (inlineValue) Matrix2();
+        read = fp->Read(inlineValue, sizeof(Matrix2));
         if (read != sizeof(Matrix2))
         {
             return false;
@@ -1343,7 +1416,7 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
     break;
     case TYPE_COLOR:
     {
-        colorValue = new Color;
+        Color* colorValue = new (inlineValue) Color();
         read = fp->Read(colorValue->color, sizeof(Color));
         if (read != sizeof(float32) * 4)
         {
@@ -1362,7 +1435,7 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
 
             const std::string& key = dictionary->GetString(std::string(keyHash, 4));
 
-            fastnameValue = new FastName(key);
+            new (inlineValue) FastName(key);
         }
         else
         {
@@ -1375,7 +1448,7 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
 
             Vector<char> buf(len + 1, 0);
             read = fp->Read(buf.data(), len);
-            fastnameValue = new FastName(buf.data());
+            new (inlineValue) FastName(buf.data());
             if (read != len)
             {
                 return false;
@@ -1386,8 +1459,8 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
 
     case TYPE_AABBOX3:
     {
-        aabbox3 = new AABBox3;
-        read = fp->Read(aabbox3, sizeof(AABBox3));
+        new (inlineValue) AABBox3();
+        read = fp->Read(inlineValue, sizeof(AABBox3));
         if (read != sizeof(AABBox3))
         {
             return false;
@@ -1405,7 +1478,7 @@ bool VariantType::Read(File* fp, KeyedArchive * dictionary)
 
         Vector<char> buf(len + 1, 0);
         read = fp->Read(buf.data(), len);
-        filepathValue = new FilePath(buf.data());
+        pointerValue = new SharedFilePath(FilePath(buf.data()));
         return (read == len);
     }
     case TYPE_UNKNOWN1:
@@ -1445,9 +1518,11 @@ void VariantType::ReleasePointer()
     {
         switch (type)
         {
+        case TYPE_STRING:
         case TYPE_BYTE_ARRAY:
+        case TYPE_FILEPATH:
         {
-            delete static_cast<const Vector<uint8>*>(pointerValue);
+            VariantTypeDetails::ReleaseShared(pointerValue);
         }
         break;
         case TYPE_KEYED_ARCHIVE:
@@ -1455,26 +1530,6 @@ void VariantType::ReleasePointer()
             static_cast<KeyedArchive*>(pointerValue)->Release();
         }
         break;
-        case TYPE_VECTOR2:
-        {
-            delete vector2Value;
-        }
-        break;
-        case TYPE_VECTOR3:
-        {
-            delete vector3Value;
-        }
-        break;
-        case TYPE_VECTOR4:
-        {
-            delete vector4Value;
-        }
-        break;
-        case TYPE_MATRIX2:
-        {
-            delete matrix2Value;
-        }
-        break;
         case TYPE_MATRIX3:
         {
             delete matrix3Value;
@@ -1485,40 +1540,9 @@ void VariantType::ReleasePointer()
             delete matrix4Value;
         }
         break;
-
-        case TYPE_STRING:
-        {
-            delete stringValue;
-        }
-        break;
-
-        case TYPE_WIDE_STRING:
-        {
-            delete wideStringValue;
-        }
-        break;
-        case TYPE_COLOR:
-        {
-            delete colorValue;
-        }
-        break;
-        case TYPE_FASTNAME:
-        {
-            delete fastnameValue;
-        }
-        break;
-        case TYPE_AABBOX3:
-        {
-            delete aabbox3;
-        }
-        break;
-        case TYPE_FILEPATH:
-        {
-            delete filepathValue;
-        }
-        break;
         default:
         {
+            // Inline values are trivially destructible
             break;
         }
         }
@@ -1529,12 +1553,26 @@ void VariantType::ReleasePointer()
     }
 }
 
+void VariantType::MoveFrom(VariantType& other)
+{
+    // All stored types can be moved bitwise
+    Memcpy(inlineValue, other.inlineValue, INLINE_VALUE_SIZE);
+    type = other.type;
+
+    other.pointerValue = nullptr;
+    other.type = TYPE_NONE;
+}
+
 bool VariantType::operator==(const VariantType& other) const
 {
     if (type != other.type)
     {
         return false;
     }
+    if (VariantTypeDetails::IsSharedType(type) && pointerValue == other.pointerValue)
+    {
+        return true;
+    }
     bool isEqual = false;
 
     switch (type)
@@ -1712,10 +1750,11 @@ VariantType& VariantType::operator=(const VariantType& other)
 
 VariantType& VariantType::operator=(VariantType&& other)
 {
-    type = other.type;
-    int64Value = other.int64Value;
-    other.type = TYPE_NONE;
-
+    if (this != &other)
+    {
+        ReleasePointer();
+        MoveFrom(other);
+    }
     return *this;
 }
 
@@ -1768,27 +1807,31 @@ void* VariantType::MetaObject()
     case TYPE_FLOAT64:
         ret = &float64Value;
         break;
+    // Value can be modified through returned pointer, so shared values are detached from other variants
     case TYPE_STRING:
-        ret = stringValue;
+        ret = &VariantTypeDetails::GetUniqueSharedValue<String>(pointerValue);
         break;
-    case TYPE_WIDE_STRING:
-        ret = wideStringValue;
+    case TYPE_BYTE_ARRAY:
+        ret = &VariantTypeDetails::GetUniqueSharedValue<Vector<uint8>>(pointerValue);
+        break;
+    case TYPE_FILEPATH:
+        ret = &VariantTypeDetails::GetUniqueSharedValue<FilePath>(pointerValue);
+        break;
+    case TYPE_KEYED_ARCHIVE:
+        ret = &pointerValue;
         break;
     case TYPE_VECTOR2:
-    case TYPE_BYTE_ARRAY:
     case TYPE_VECTOR3:
     case TYPE_VECTOR4:
     case TYPE_MATRIX2:
-    case TYPE_MATRIX3:
-    case TYPE_MATRIX4:
     case TYPE_COLOR:
     case TYPE_FASTNAME:
     case TYPE_AABBOX3:
-    case TYPE_FILEPATH:
-        ret = pointerValue;
+        ret = inlineValue;
         break;
-    case TYPE_KEYED_ARCHIVE:
-        ret = &pointerValue;
+    case TYPE_MATRIX3:
+    case TYPE_MATRIX4:
+        ret = pointerValue;
         break;
     default:
     {
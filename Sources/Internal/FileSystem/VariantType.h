@@ -28,6 +28,12 @@ class FilePath;
 /**
  \ingroup filesystem
  \brief Class to store value of all basic types in one instance. Can be used for various serialization / deserialization purposes.
+
+ Scalars and small fixed-size types (vectors, Matrix2, Color, AABBox3, FastName) are stored inline without allocation.
+ Strings, byte arrays and file paths are stored in shared storage, which is copied only before
+ modification (copy-on-write), so copying of variants and archives doesn't copy these values.
+ Keyed archives are copied with variant, because AsKeyedArchive returns pointer which can be modified.
+ Matrix3 and Matrix4 are allocated in heap to keep size of variant small.
  */
 class VariantType
 {
@@ -129,45 +135,6 @@ public:
     };
     eVariantType type = TYPE_NONE;
 
-    union {
-        bool boolValue;
-        int8 int8Value;
-        uint8 uint8Value;
-
-        int16 int16Value;
-        uint16 uint16Value;
-
-        int32 int32Value;
-        uint32 uint32Value;
-
-        float32 floatValue;
-        float64 float64Value;
-
-        int64 int64Value;
-        uint64 uint64Value;
-
-        Vector2* vector2Value;
-        Vector3* vector3Value;
-        Vector4* vector4Value;
-
-        Matrix2* matrix2Value;
-        Matrix3* matrix3Value;
-        Matrix4* matrix4Value;
-
-        void* pointerValue = nullptr;
-
-        KeyedArchive* keyedArchiveValue;
-
-        String* stringValue;
-        WideString* wideStringValue;
-        FilePath* filepathValue;
-
-        Color* colorValue;
-        FastName* fastnameValue;
-
-        AABBox3* aabbox3;
-    };
-
     struct PairTypeName
     {
         eVariantType variantType;
@@ -423,6 +390,7 @@ public:
 
     /**
 	 \brief Function to return keyed archive from variable. Returns pointer to the KeyedArchive inside.
+	 Archive is never shared with copies of variable, so it can be modified.
 	 \returns value of variable, or generate assert if variable type is different
 	 */
     KeyedArchive* AsKeyedArchive() const;
@@ -547,6 +515,13 @@ private:
     VariantType(void*);
 
     void ReleasePointer();
+    void MoveFrom(VariantType& other);
+
+    template <class T>
+    void SetInlineValue(VariantType::eVariantType nextType, const T& value);
+
+    template <class T>
+    void SetSharedValue(VariantType::eVariantType nextType, const T& value);
 
     template <class T>
     void SetValueWithAllocation(VariantType::eVariantType nextType, const T& value)
@@ -565,6 +540,33 @@ private:
             *(static_cast<T*>(pointerValue)) = value;
         }
     }
+
+    static const size_t INLINE_VALUE_SIZE = 24;
+
+    union {
+        bool boolValue;
+        int8 int8Value;
+        uint8 uint8Value;
+
+        int16 int16Value;
+        uint16 uint16Value;
+
+        int32 int32Value;
+        uint32 uint32Value;
+
+        float32 floatValue;
+        float64 float64Value;
+
+        int64 int64Value;
+        uint64 uint64Value;
+
+        Matrix3* matrix3Value;
+        Matrix4* matrix4Value;
+
+        void* pointerValue = nullptr; // heap allocated matrix or shared storage
+
+        uint8 inlineValue[INLINE_VALUE_SIZE]; // storage of small fixed-size types
+    };
 };
 
 VariantType::eVariantType VariantType::GetType() const
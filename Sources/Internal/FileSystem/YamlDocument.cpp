@@ -0,0 +1,303 @@
+#include "FileSystem/YamlDocument.h"
+#include "FileSystem/FilePath.h"
+#include "FileSystem/YamlParser.h"
+#include "Base/Hash.h"
+#include "Debug/DVAssert.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace DAVA
+{
+/** Fills document storage from parser events. */
+class YamlDocument::Builder : public YamlEventHandler
+{
+public:
+    explicit Builder(YamlDocument* document_)
+        : document(document_)
+    {
+        // empty key and value of containers
+        document->chars.push_back('\0');
+    }
+
+    void OnMapBegin() override
+    {
+        BeginContainer(YamlNode::TYPE_MAP);
+    }
+
+    void OnMapEnd() override
+    {
+        EndContainer();
+    }
+
+    void OnArrayBegin() override
+    {
+        BeginContainer(YamlNode::TYPE_ARRAY);
+    }
+
+    void OnArrayEnd() override
+    {
+        EndContainer();
+    }
+
+    void OnKey(const char8* key, uint32 length) override
+    {
+        lastKey = AddChars(key, length);
+    }
+
+    void OnScalar(const char8* value, uint32 length) override
+    {
+        uint32 offset = AddChars(value, length);
+        AddNode({ YamlNode::TYPE_STRING, offset, length });
+    }
+
+private:
+    struct Frame
+    {
+        uint32 node;
+        size_t pendingBegin;
+    };
+
+    uint32 AddChars(const char8* str, uint32 length)
+    {
+        uint32 offset = static_cast<uint32>(document->chars.size());
+        document->chars.insert(document->chars.end(), str, str + length);
+        document->chars.push_back('\0');
+        return offset;
+    }
+
+    uint32 AddNode(const NodeData& data)
+    {
+        uint32 node = static_cast<uint32>(document->nodes.size());
+        document->nodes.push_back(data);
+        if (!frames.empty())
+        {
+            bool inMap = (document->nodes[frames.back().node].type == YamlNode::TYPE_MAP);
+            pending.push_back({ node, inMap ? lastKey : 0 });
+        }
+        return node;
+    }
+
+    void BeginContainer(YamlNode::eType type)
+    {
+        uint32 node = AddNode({ type, 0, 0 });
+        frames.push_back({ node, pending.size() });
+    }
+
+    // children of nested containers are already moved, so children of ended container are on top of pending stack
+    void EndContainer()
+    {
+        Frame frame = frames.back();
+        frames.pop_back();
+
+        NodeData& data = document->nodes[frame.node];
+        data.first = static_cast<uint32>(document->children.size());
+        data.count = static_cast<uint32>(pending.size() - frame.pendingBegin);
+
+        document->children.insert(document->children.end(), pending.begin() + frame.pendingBegin, pending.end());
+        pending.resize(frame.pendingBegin);
+
+        document->keys.resize(document->children.size(), { 0, 0 });
+        if (data.type == YamlNode::TYPE_MAP)
+        {
+            auto begin = document->keys.begin() + data.first;
+            for (uint32 i = 0; i < data.count; ++i)
+            {
+                const char8* key = document->chars.data() + document->children[data.first + i].key;
+                begin[i] = { HashValue_N(key, static_cast<uint32>(strlen(key))), i };
+            }
+            // equal hashes keep child order, so first of duplicated keys is found first
+            std::sort(begin, begin + data.count, [](const KeyIndex& l, const KeyIndex& r) {
+                return (l.hash != r.hash) ? (l.hash < r.hash) : (l.child < r.child);
+            });
+        }
+    }
+
+    YamlDocument* document = nullptr;
+    Vector<Frame> frames;
+    Vector<ChildData> pending;
+    uint32 lastKey = 0;
+};
+
+RefPtr<YamlDocument> YamlDocument::Create(const FilePath& fileName)
+{
+    RefPtr<YamlDocument> document(new YamlDocument());
+    Builder builder(document.Get());
+    if (!YamlParser::ParseEvents(fileName, &builder))
+    {
+        return RefPtr<YamlDocument>();
+    }
+    return document;
+}
+
+RefPtr<YamlDocument> YamlDocument::CreateFromString(const String& data)
+{
+    RefPtr<YamlDocument> document(new YamlDocument());
+    Builder builder(document.Get());
+    if (!YamlParser::ParseStringEvents(data, &builder))
+    {
+        return RefPtr<YamlDocument>();
+    }
+    return document;
+}
+
+YamlDocument::Node YamlDocument::GetRootNode() const
+{
+    return nodes.empty() ? Node() : Node(this, 0);
+}
+
+YamlDocument::Node::Node(const YamlDocument* document_, uint32 index_)
+    : document(document_)
+    , index(index_)
+{
+}
+
+bool YamlDocument::Node::IsValid() const
+{
+    return document != nullptr;
+}
+
+YamlNode::eType YamlDocument::Node::GetType() const
+{
+    DVASSERT(IsValid());
+    return document->nodes[index].type;
+}
+
+uint32 YamlDocument::Node::GetCount() const
+{
+    if (IsValid() && GetType() != YamlNode::TYPE_STRING)
+    {
+        return document->nodes[index].count;
+    }
+    return 0;
+}
+
+YamlDocument::Node YamlDocument::Node::Get(uint32 i) const
+{
+    if (i < GetCount())
+    {
+        const NodeData& data = document->nodes[index];
+        return Node(document, document->children[data.first + i].node);
+    }
+    return Node();
+}
+
+YamlDocument::Node YamlDocument::Node::Get(int32 i) const
+{
+    return Get(static_cast<uint32>(i));
+}
+
+YamlDocument::Node YamlDocument::Node::Get(const char8* key) const
+{
+    if (IsValid() && GetType() == YamlNode::TYPE_MAP)
+    {
+        const NodeData& data = document->nodes[index];
+        const uint32 hash = HashValue_N(key, static_cast<uint32>(strlen(key)));
+
+        auto begin = document->keys.begin() + data.first;
+        auto end = begin + data.count;
+        auto it = std::lower_bound(begin, end, hash, [](const KeyIndex& l, uint32 h) { return l.hash < h; });
+        for (; it != end && it->hash == hash; ++it)
+        {
+            const ChildData& child = document->children[data.first + it->child];
+            if (strcmp(document->chars.data() + child.key, key) == 0)
+            {
+                return Node(document, child.node);
+            }
+        }
+    }
+    return Node();
+}
+
+YamlDocument::Node YamlDocument::Node::Get(const String& key) const
+{
+    return Get(key.c_str());
+}
+
+const char8* YamlDocument::Node::GetItemKeyName(uint32 i) const
+{
+    if (i < GetCount() && GetType() == YamlNode::TYPE_MAP)
+    {
+        const NodeData& data = document->nodes[index];
+        return document->chars.data() + document->children[data.first + i].key;
+    }
+    return "";
+}
+
+const char8* YamlDocument::Node::AsCString() const
+{
+    DVASSERT(IsValid() && GetType() == YamlNode::TYPE_STRING);
+    if (IsValid() && GetType() == YamlNode::TYPE_STRING)
+    {
+        return document->chars.data() + document->nodes[index].first;
+    }
+    return "";
+}
+
+uint32 YamlDocument::Node::GetLength() const
+{
+    if (IsValid() && GetType() == YamlNode::TYPE_STRING)
+    {
+        return document->nodes[index].count;
+    }
+    return 0;
+}
+
+String YamlDocument::Node::AsString() const
+{
+    return String(AsCString(), GetLength());
+}
+
+FastName YamlDocument::Node::AsFastName() const
+{
+    return FastName(AsCString());
+}
+
+bool YamlDocument::Node::AsBool() const
+{
+    const char8* value = AsCString();
+    return (strcmp(value, "true") == 0 || strcmp(value, "yes") == 0);
+}
+
+int32 YamlDocument::Node::AsInt32() const
+{
+    return static_cast<int32>(strtol(AsCString(), nullptr, 10));
+}
+
+uint32 YamlDocument::Node::AsUInt32() const
+{
+    return static_cast<uint32>(strtoul(AsCString(), nullptr, 10));
+}
+
+float32 YamlDocument::Node::AsFloat() const
+{
+    return strtof(AsCString(), nullptr);
+}
+
+float32 YamlDocument::Node::GetFloat(uint32 i, float32 defaultValue) const
+{
+    Node item = Get(i);
+    return item.IsValid() ? item.AsFloat() : defaultValue;
+}
+
+Vector2 YamlDocument::Node::AsVector2() const
+{
+    return Vector2(GetFloat(0, 0.f), GetFloat(1, 0.f));
+}
+
+Vector3 YamlDocument::Node::AsVector3() const
+{
+    return Vector3(GetFloat(0, 0.f), GetFloat(1, 0.f), GetFloat(2, 0.f));
+}
+
+Vector4 YamlDocument::Node::AsVector4() const
+{
+    return Vector4(GetFloat(0, 0.f), GetFloat(1, 0.f), GetFloat(2, 0.f), GetFloat(3, 0.f));
+}
+
+Color YamlDocument::Node::AsColor() const
+{
+    const Color& white = Color::White;
+    return Color(GetFloat(0, white.r), GetFloat(1, white.g), GetFloat(2, white.b), GetFloat(3, white.a));
+}
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseObject.h"
+#include "Base/BaseMath.h"
+#include "Base/FastName.h"
+#include "Base/RefPtr.h"
+#include "FileSystem/YamlNode.h"
+
+namespace DAVA
+{
+class FilePath;
+
+/**
+    \ingroup yaml
+    Read-only yaml document with flat storage, lightweight alternative of `YamlParser` for loading code.
+
+    All nodes are stored in one array, children of each container are stored contiguously in another one,
+    and all keys and scalar values are stored as null-terminated strings in single character buffer.
+    Keys of each map are also indexed by hash, so lookup by key is a binary search instead of string scan.
+    Document is built directly from `YamlParser::ParseEvents`, so loading requires only a few allocations
+    regardless of document size, and strings are accessed without copying.
+
+    Nodes are accessed through `YamlDocument::Node` handles, which are valid while document is alive.
+    Conversions of scalars follow `YamlNode` rules.
+*/
+class YamlDocument : public BaseObject
+{
+public:
+    class Node
+    {
+    public:
+        Node() = default;
+
+        bool IsValid() const;
+        YamlNode::eType GetType() const;
+
+        /** Return number of children of map or array node, 0 for scalar. */
+        uint32 GetCount() const;
+        /** Return child by index or invalid node. */
+        Node Get(uint32 index) const;
+        Node Get(int32 index) const;
+        /** Return child of map node by key or invalid node. */
+        Node Get(const char8* key) const;
+        Node Get(const String& key) const;
+        /** Return key of child of map node by index or empty string. */
+        const char8* GetItemKeyName(uint32 index) const;
+
+        /** Return scalar value as null-terminated string, empty string for containers. */
+        const char8* AsCString() const;
+        uint32 GetLength() const;
+        String AsString() const;
+        FastName AsFastName() const;
+        bool AsBool() const;
+        int32 AsInt32() const;
+        uint32 AsUInt32() const;
+        float32 AsFloat() const;
+        Vector2 AsVector2() const;
+        Vector3 AsVector3() const;
+        Vector4 AsVector4() const;
+        Color AsColor() const;
+
+    private:
+        friend class YamlDocument;
+
+        Node(const YamlDocument* document_, uint32 index_);
+        float32 GetFloat(uint32 index, float32 defaultValue) const;
+
+        const YamlDocument* document = nullptr;
+        uint32 index = 0;
+    };
+
+    /** Parse file. Return nullptr on parsing error. */
+    static RefPtr<YamlDocument> Create(const FilePath& fileName);
+    /** Parse data string. Return nullptr on parsing error. */
+    static RefPtr<YamlDocument> CreateFromString(const String& data);
+
+    /** Return root node, which is invalid for empty document. */
+    Node GetRootNode() const;
+
+private:
+    class Builder;
+
+    struct NodeData
+    {
+        YamlNode::eType type;
+        uint32 first; // offset of value in `chars` for scalar, index of first child in `children` for container
+        uint32 count; // length of scalar or number of children
+    };
+
+    struct ChildData
+    {
+        uint32 node;
+        uint32 key; // offset of key in `chars`, only for children of map
+    };
+
+    // parallel to `children`, entries of each map are sorted by hash and then by child position
+    struct KeyIndex
+    {
+        uint32 hash;
+        uint32 child; // position of child in its container
+    };
+
+    YamlDocument() = default;
+
+    Vector<NodeData> nodes;
+    Vector<ChildData> children;
+    Vector<KeyIndex> keys;
+    Vector<char8> chars;
+};
+}
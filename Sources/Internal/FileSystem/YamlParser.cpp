@@ -9,63 +9,28 @@
 
 namespace DAVA
 {
-bool YamlParser::Parse(const String& data)
+namespace YamlParserDetail
 {
-    YamlDataHolder dataHolder;
-    dataHolder.fileSize = static_cast<uint32>(data.size());
-    dataHolder.data = const_cast<uint8*>(reinterpret_cast<const uint8*>(data.c_str()));
-    dataHolder.dataOffset = 0;
-
-    return Parse(&dataHolder);
-}
-
-bool YamlParser::Parse(const FilePath& pathName)
+/** Read events from initialized `parser` and pass them to `handler`. Return false on parsing error or unbalanced document. */
+bool ProcessEvents(yaml_parser_t* parser, YamlEventHandler* handler)
 {
-    RefPtr<File> yamlFile(File::Create(pathName, File::OPEN | File::READ));
-    if (!yamlFile)
+    struct Level
     {
-        Logger::Error("[YamlParser::Parse] Can't Open file %s for read", pathName.GetAbsolutePathname().c_str());
-        return false;
-    }
-
-    YamlDataHolder dataHolder;
-    dataHolder.fileSize = static_cast<uint32>(yamlFile->GetSize());
-    dataHolder.data = new uint8[dataHolder.fileSize];
-    dataHolder.dataOffset = 0;
-    yamlFile->Read(dataHolder.data, dataHolder.fileSize);
+        bool isMap;
+        bool expectKey;
+    };
+    Vector<Level> levels;
 
-    bool result = Parse(&dataHolder);
-    SafeDeleteArray(dataHolder.data);
-    return result;
-}
-
-bool YamlParser::Parse(YamlDataHolder* dataHolder)
-{
-    yaml_parser_t parser;
     yaml_event_t event;
+    bool done = false;
+    bool failed = false;
 
-    int done = 0;
-
-    /* Create the Parser object. */
-    yaml_parser_initialize(&parser);
-
-    yaml_parser_set_encoding(&parser, YAML_UTF8_ENCODING);
-
-    /* Set a string input. */
-    //yaml_parser_set_input_string(&parser, (const unsigned char*)pathName.c_str(), pathName.length());
-
-    yaml_parser_set_input(&parser, read_handler, dataHolder);
-
-    String lastMapKey;
-    bool isKeyPresent = false;
-
-    /* Read the event sequence. */
     while (!done)
     {
-        /* Get the next event. */
-        if (!yaml_parser_parse(&parser, &event))
+        if (!yaml_parser_parse(parser, &event))
         {
-            Logger::Error("[YamlParser::Parse] error: type: %d %s line: %d pos: %d", parser.error, parser.problem, parser.problem_mark.line, parser.problem_mark.column);
+            Logger::Error("[YamlParser::Parse] error: type: %d %s line: %d pos: %d", parser->error, parser->problem, parser->problem_mark.line, parser->problem_mark.column);
+            failed = true;
             break;
         }
 
@@ -77,109 +42,66 @@ bool YamlParser::Parse(YamlDataHolder* dataHolder)
 
         case YAML_SCALAR_EVENT:
         {
-            String scalarValue = reinterpret_cast<const char*>(event.data.scalar.value);
-
-            if (objectStack.empty())
+            const char8* value = reinterpret_cast<const char8*>(event.data.scalar.value);
+            uint32 length = static_cast<uint32>(event.data.scalar.length);
+            if (!levels.empty() && levels.back().isMap)
             {
-                RefPtr<YamlNode> node = YamlNode::CreateStringNode();
-                node->Set(scalarValue);
-                rootObject = node;
-            }
-            else
-            {
-                RefPtr<YamlNode> topContainer = objectStack.top();
-                DVASSERT(topContainer->GetType() != YamlNode::TYPE_STRING);
-                if (topContainer->GetType() == YamlNode::TYPE_MAP)
+                Level& level = levels.back();
+                if (level.expectKey)
                 {
-                    if (!isKeyPresent)
-                    {
-                        lastMapKey = scalarValue;
-                    }
-                    else
-                    {
-                        topContainer->Add(lastMapKey, scalarValue);
-                    }
-                    isKeyPresent = !isKeyPresent;
+                    handler->OnKey(value, length);
                 }
-                else if (topContainer->GetType() == YamlNode::TYPE_ARRAY)
+                else
                 {
-                    topContainer->Add(scalarValue);
+                    handler->OnScalar(value, length);
                 }
+                level.expectKey = !level.expectKey;
+            }
+            else
+            {
+                handler->OnScalar(value, length);
             }
         }
         break;
 
-        case YAML_DOCUMENT_START_EVENT:
-            //Logger::FrameworkDebug("document start:");
-            break;
-
-        case YAML_DOCUMENT_END_EVENT:
-            //Logger::FrameworkDebug("document end:");
-            break;
-
         case YAML_SEQUENCE_START_EVENT:
+        case YAML_MAPPING_START_EVENT:
         {
-            RefPtr<YamlNode> node = YamlNode::CreateArrayNode();
-            if (objectStack.empty())
+            if (!levels.empty() && levels.back().isMap)
             {
-                rootObject = node;
+                levels.back().expectKey = true;
+            }
+
+            bool isMap = (event.type == YAML_MAPPING_START_EVENT);
+            levels.push_back({ isMap, true });
+            if (isMap)
+            {
+                handler->OnMapBegin();
             }
             else
             {
-                RefPtr<YamlNode> topContainer = objectStack.top();
-                DVASSERT(topContainer->GetType() != YamlNode::TYPE_STRING);
-                if (topContainer->GetType() == YamlNode::TYPE_MAP)
-                {
-                    DVASSERT(isKeyPresent);
-                    topContainer->AddNodeToMap(lastMapKey, node);
-                    isKeyPresent = false;
-                }
-                else if (topContainer->GetType() == YamlNode::TYPE_ARRAY)
-                {
-                    topContainer->AddNodeToArray(node);
-                }
+                handler->OnArrayBegin();
             }
-            objectStack.push(node);
         }
         break;
 
         case YAML_SEQUENCE_END_EVENT:
+        case YAML_MAPPING_END_EVENT:
         {
-            objectStack.pop();
-        }
-        break;
-
-        case YAML_MAPPING_START_EVENT:
-        {
-            RefPtr<YamlNode> node = YamlNode::CreateMapNode();
-            if (objectStack.empty())
+            levels.pop_back();
+            if (event.type == YAML_MAPPING_END_EVENT)
             {
-                rootObject = node;
+                handler->OnMapEnd();
             }
             else
             {
-                RefPtr<YamlNode> topContainer = objectStack.top();
-                if (topContainer->GetType() == YamlNode::TYPE_MAP)
-                {
-                    DVASSERT(isKeyPresent);
-                    topContainer->AddNodeToMap(lastMapKey, node);
-                    isKeyPresent = false;
-                }
-                else if (topContainer->GetType() == YamlNode::TYPE_ARRAY)
-                {
-                    topContainer->AddNodeToArray(node);
-                }
+                handler->OnArrayEnd();
             }
-            objectStack.push(node);
-        }
-        break;
-
-        case YAML_MAPPING_END_EVENT:
-        {
-            objectStack.pop();
         }
         break;
 
+        case YAML_DOCUMENT_START_EVENT:
+        case YAML_DOCUMENT_END_EVENT:
         case YAML_NO_EVENT:
         case YAML_STREAM_END_EVENT:
         case YAML_STREAM_START_EVENT:
@@ -187,19 +109,182 @@ bool YamlParser::Parse(YamlDataHolder* dataHolder)
             break;
         };
 
-        /* Are we finished? */
         done = (event.type == YAML_STREAM_END_EVENT);
 
         /* The application is responsible for destroying the event object. */
         yaml_event_delete(&event);
     }
 
-    /* Destroy the Parser object. */
+    return !failed && levels.empty();
+}
+
+bool ParseBuffer(const uint8* data, size_t size, YamlEventHandler* handler)
+{
+    yaml_parser_t parser;
+    yaml_parser_initialize(&parser);
+    yaml_parser_set_encoding(&parser, YAML_UTF8_ENCODING);
+    yaml_parser_set_input_string(&parser, data, size);
+
+    bool result = ProcessEvents(&parser, handler);
+
+    yaml_parser_delete(&parser);
+    return result;
+}
+
+/** Builds `YamlNode` tree from parser events. */
+class NodeBuilder : public YamlEventHandler
+{
+public:
+    RefPtr<YamlNode> rootObject;
+
+    void OnMapBegin() override
+    {
+        PushContainer(YamlNode::CreateMapNode());
+    }
+
+    void OnMapEnd() override
+    {
+        objectStack.pop_back();
+    }
+
+    void OnArrayBegin() override
+    {
+        PushContainer(YamlNode::CreateArrayNode());
+    }
+
+    void OnArrayEnd() override
+    {
+        objectStack.pop_back();
+    }
+
+    void OnKey(const char8* key, uint32 length) override
+    {
+        lastMapKey.assign(key, length);
+    }
+
+    void OnScalar(const char8* value, uint32 length) override
+    {
+        String scalarValue(value, length);
+        if (objectStack.empty())
+        {
+            RefPtr<YamlNode> node = YamlNode::CreateStringNode();
+            node->Set(scalarValue);
+            rootObject = node;
+        }
+        else
+        {
+            YamlNode* topContainer = objectStack.back();
+            if (topContainer->GetType() == YamlNode::TYPE_MAP)
+            {
+                topContainer->Add(lastMapKey, scalarValue);
+            }
+            else
+            {
+                topContainer->Add(scalarValue);
+            }
+        }
+    }
+
+private:
+    void PushContainer(const RefPtr<YamlNode>& node)
+    {
+        if (objectStack.empty())
+        {
+            rootObject = node;
+        }
+        else
+        {
+            YamlNode* topContainer = objectStack.back();
+            if (topContainer->GetType() == YamlNode::TYPE_MAP)
+            {
+                topContainer->AddNodeToMap(lastMapKey, node);
+            }
+            else
+            {
+                topContainer->AddNodeToArray(node);
+            }
+        }
+        objectStack.push_back(node.Get());
+    }
+
+    Vector<YamlNode*> objectStack;
+    String lastMapKey;
+};
+}
+
+bool YamlParser::Parse(const String& data)
+{
+    YamlDataHolder dataHolder;
+    dataHolder.fileSize = static_cast<uint32>(data.size());
+    dataHolder.data = const_cast<uint8*>(reinterpret_cast<const uint8*>(data.c_str()));
+    dataHolder.dataOffset = 0;
+
+    return Parse(&dataHolder);
+}
+
+bool YamlParser::Parse(const FilePath& pathName)
+{
+    RefPtr<File> yamlFile(File::Create(pathName, File::OPEN | File::READ));
+    if (!yamlFile)
+    {
+        Logger::Error("[YamlParser::Parse] Can't Open file %s for read", pathName.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    YamlDataHolder dataHolder;
+    dataHolder.fileSize = static_cast<uint32>(yamlFile->GetSize());
+    dataHolder.data = new uint8[dataHolder.fileSize];
+    dataHolder.dataOffset = 0;
+    yamlFile->Read(dataHolder.data, dataHolder.fileSize);
+
+    bool result = Parse(&dataHolder);
+    SafeDeleteArray(dataHolder.data);
+    return result;
+}
+
+bool YamlParser::Parse(YamlDataHolder* dataHolder)
+{
+    yaml_parser_t parser;
+    yaml_parser_initialize(&parser);
+    yaml_parser_set_encoding(&parser, YAML_UTF8_ENCODING);
+    yaml_parser_set_input(&parser, read_handler, dataHolder);
+
+    YamlParserDetail::NodeBuilder builder;
+    bool result = YamlParserDetail::ProcessEvents(&parser, &builder);
+
     yaml_parser_delete(&parser);
 
-    DVASSERT(objectStack.size() == 0);
+    DVASSERT(result);
 
-    return objectStack.empty();
+    rootObject = builder.rootObject;
+    return result;
+}
+
+bool YamlParser::ParseEvents(const FilePath& fileName, YamlEventHandler* handler)
+{
+    DVASSERT(handler != nullptr);
+
+    RefPtr<File> yamlFile(File::Create(fileName, File::OPEN | File::READ));
+    if (!yamlFile)
+    {
+        Logger::Error("[YamlParser::ParseEvents] Can't Open file %s for read", fileName.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    Vector<uint8> data(static_cast<size_t>(yamlFile->GetSize()));
+    if (!data.empty() && yamlFile->Read(data.data(), static_cast<uint32>(data.size())) != data.size())
+    {
+        Logger::Error("[YamlParser::ParseEvents] Can't read file %s", fileName.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    return YamlParserDetail::ParseBuffer(data.data(), data.size(), handler);
+}
+
+bool YamlParser::ParseStringEvents(const String& data, YamlEventHandler* handler)
+{
+    DVASSERT(handler != nullptr);
+    return YamlParserDetail::ParseBuffer(reinterpret_cast<const uint8*>(data.data()), data.size(), handler);
 }
 
 YamlParser::YamlParser()
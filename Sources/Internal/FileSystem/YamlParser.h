@@ -12,6 +12,39 @@ class YamlNode;
 	\defgroup yaml Yaml configs
  */
 
+/**
+    \ingroup yaml
+    Receiver of events produced by `YamlParser::ParseEvents`.
+
+    Keys and scalars are passed as pointers to null-terminated parser buffers which are valid only during the call,
+    so handler can process document without building `YamlNode` tree and copying strings.
+    Scalar or container which follows `OnKey` is value of that key, container events are balanced if parsing succeeds.
+*/
+class YamlEventHandler
+{
+public:
+    virtual ~YamlEventHandler() = default;
+
+    virtual void OnMapBegin()
+    {
+    }
+    virtual void OnMapEnd()
+    {
+    }
+    virtual void OnArrayBegin()
+    {
+    }
+    virtual void OnArrayEnd()
+    {
+    }
+    virtual void OnKey(const char8* key, uint32 length)
+    {
+    }
+    virtual void OnScalar(const char8* value, uint32 length)
+    {
+    }
+};
+
 /** 
 	\ingroup yaml
 	\brief this class is yaml parser and it used if you want to parse yaml file
@@ -38,6 +71,11 @@ public:
     // Get the root node.
     YamlNode* GetRootNode() const;
 
+    /** Parse file and pass its content to `handler` without building node tree. Return false on parsing error. */
+    static bool ParseEvents(const FilePath& fileName, YamlEventHandler* handler);
+    /** Parse data string and pass its content to `handler` without building node tree. Return false on parsing error. */
+    static bool ParseStringEvents(const String& data, YamlEventHandler* handler);
+
     struct YamlDataHolder
     {
         uint32 fileSize;
@@ -67,8 +105,6 @@ protected:
 
 private:
     RefPtr<YamlNode> rootObject;
-
-    Stack<RefPtr<YamlNode>> objectStack;
 };
 };
 
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+namespace DAVA
+{
+namespace SignalDetail
+{
+/**
+    Contiguous array of signal connections with in-place storage for first `N` elements.
+    Heap memory is allocated only when more than `N` connections are stored.
+*/
+template <typename T, size_t N>
+class ConnectionStorage final
+{
+public:
+    ConnectionStorage() = default;
+    ConnectionStorage(const ConnectionStorage&) = delete;
+    ConnectionStorage& operator=(const ConnectionStorage&) = delete;
+
+    ~ConnectionStorage()
+    {
+        Clear();
+        if (data != InlineData())
+        {
+            ::operator delete(data);
+        }
+    }
+
+    size_t Size() const
+    {
+        return size;
+    }
+
+    T& operator[](size_t i)
+    {
+        return data[i];
+    }
+
+    const T& operator[](size_t i) const
+    {
+        return data[i];
+    }
+
+    T* begin()
+    {
+        return data;
+    }
+
+    T* end()
+    {
+        return data + size;
+    }
+
+    const T* begin() const
+    {
+        return data;
+    }
+
+    const T* end() const
+    {
+        return data + size;
+    }
+
+    void Insert(size_t pos, T&& value)
+    {
+        Reserve(size + 1);
+        new (data + size) T(std::move(value));
+        ++size;
+
+        std::rotate(data + pos, data + size - 1, data + size);
+    }
+
+    void Erase(size_t pos)
+    {
+        std::move(data + pos + 1, data + size, data + pos);
+        Shrink(size - 1);
+    }
+
+    template <typename Pred>
+    void RemoveIf(Pred pred)
+    {
+        T* newEnd = std::remove_if(data, data + size, pred);
+        Shrink(static_cast<size_t>(newEnd - data));
+    }
+
+    void Clear()
+    {
+        Shrink(0);
+    }
+
+private:
+    T* InlineData()
+    {
+        return reinterpret_cast<T*>(&inlineStorage);
+    }
+
+    void Reserve(size_t count)
+    {
+        if (count > capacity)
+        {
+            size_t newCapacity = std::max(count, capacity * 2);
+            T* newData = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                new (newData + i) T(std::move(data[i]));
+                data[i].~T();
+            }
+
+            if (data != InlineData())
+            {
+                ::operator delete(data);
+            }
+
+            data = newData;
+            capacity = newCapacity;
+        }
+    }
+
+    void Shrink(size_t newSize)
+    {
+        for (size_t i = newSize; i < size; ++i)
+        {
+            data[i].~T();
+        }
+        size = newSize;
+    }
+
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inlineStorage;
+    T* data = reinterpret_cast<T*>(&inlineStorage);
+    size_t size = 0;
+    size_t capacity = N;
+};
+} // namespace SignalDetail
+} // namespace DAVA
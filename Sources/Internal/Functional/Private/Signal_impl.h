@@ -34,7 +34,6 @@ TrackedObject* GetTrackedObject(T* obj)
 template <typename... Args>
 Signal<Args...>::Signal()
 {
-    connectionsMediumPos = connections.end();
 }
 
 template <typename... Args>
@@ -113,6 +112,28 @@ void Signal<Args...>::OnTrackedObjectDestroyed(TrackedObject* obj)
     Disconnect(obj);
 }
 
+template <typename... Args>
+typename Signal<Args...>::Connection* Signal<Args...>::FindConnection(Token token)
+{
+    for (Connection& c : connections)
+    {
+        if (c.token == token && !c.flags.test(Connection::Deleted))
+        {
+            return &c;
+        }
+    }
+
+    for (Connection& c : addedConnections)
+    {
+        if (c.token == token && !c.flags.test(Connection::Deleted))
+        {
+            return &c;
+        }
+    }
+
+    return nullptr;
+}
+
 template <typename... Args>
 void Signal<Args...>::AddSlot(Connection&& c, Group group)
 {
@@ -121,64 +142,97 @@ void Signal<Args...>::AddSlot(Connection&& c, Group group)
         Watch(c.tracked);
     }
 
-    // now search a place for connection
-    // depending on given group
-    if (Group::High == group)
+    c.group = group;
+
+    if (emitDepth > 0)
     {
-        // for High priority just place it front
-        connections.push_front(std::move(c));
+        // connections array can't be changed while emitting,
+        // new connection will be inserted when emission is finished
+        addedConnections.push_back(std::move(c));
     }
-    else if (Group::Medium == group)
+    else
     {
-        // for Medium insert in special tracked position
-        connections.insert(connectionsMediumPos, std::move(c));
+        InsertSlot(std::move(c));
     }
-    else
+}
+
+template <typename... Args>
+void Signal<Args...>::InsertSlot(Connection&& c)
+{
+    // High priority connections are placed front,
+    // Medium and Low ones - after the last connection of the same group
+    auto begin = connections.begin();
+    auto end = connections.end();
+    auto pos = end;
+
+    if (Group::High == c.group)
+    {
+        pos = begin;
+    }
+    else if (Group::Medium == c.group)
+    {
+        pos = std::find_if(begin, end, [](const Connection& i) { return Group::Low == i.group; });
+    }
+
+    connections.Insert(static_cast<size_t>(pos - begin), std::move(c));
+}
+
+template <typename... Args>
+void Signal<Args...>::RemoveSlot(Connection& c)
+{
+    if (!c.flags.test(Connection::Deleted))
     {
-        // for Low priority just place it back
-        connections.push_back(std::move(c));
+        TrackedObject* tracked = c.tracked;
 
-        // set new position for medium priority
-        // it should be less than first low
-        if (connectionsMediumPos == connections.end())
+        c.object = nullptr;
+        c.tracked = nullptr;
+        c.flags.set(Connection::Deleted, true);
+        hasDeletedConnections = true;
+
+        // same object can be tracked by several connections,
+        // so stop watching only after the last of them is removed
+        if (nullptr != tracked && !IsTracked(tracked))
         {
-            connectionsMediumPos--;
+            Unwatch(tracked);
         }
     }
 }
 
 template <typename... Args>
-typename Signal<Args...>::ConnectionIt Signal<Args...>::RemoveSlot(ConnectionIt& it)
+void Signal<Args...>::EraseDeletedSlots()
 {
-    if (!it->flags.test(Connection::Deleted))
+    // We shouldn't really erase connections while signal is emitting,
+    // they are only marked as 'deleted' and skipped by Emit()
+    if (0 == emitDepth && hasDeletedConnections)
     {
-        if (nullptr != it->tracked)
-        {
-            Unwatch(it->tracked);
-            it->tracked = nullptr;
-        }
+        auto isDeleted = [](const Connection& c) { return c.flags.test(Connection::Deleted); };
 
-        it->object = nullptr;
-        it->flags.set(Connection::Deleted, true);
+        connections.RemoveIf(isDeleted);
+        addedConnections.erase(std::remove_if(addedConnections.begin(), addedConnections.end(), isDeleted), addedConnections.end());
+        hasDeletedConnections = false;
     }
+}
 
-    // We shouldn't really erase specified by 'it' connection
-    // if it's in Emitting state. This must be done in order
-    // not to break Emit() processing cycle with wrond iterator.
-    // (avoiding crash when we are erasing list item by iterator
-    // and that performing operator++() under the same iterator)
-    if (!it->flags.test(Connection::Emiting))
+template <typename... Args>
+bool Signal<Args...>::IsTracked(TrackedObject* tracked) const
+{
+    for (const Connection& c : connections)
     {
-        // not in Emitting state: we can safely
-        // erase it and return next one
-        return connections.erase(it);
+        if (c.tracked == tracked)
+        {
+            return true;
+        }
     }
-    else
+
+    for (const Connection& c : addedConnections)
     {
-        // in Emiting state: it was marked as Deleted
-        // so just return next one
-        return ++it;
+        if (c.tracked == tracked)
+        {
+            return true;
+        }
     }
+
+    return false;
 }
 
 template <typename... Args>
@@ -186,15 +240,11 @@ void Signal<Args...>::Disconnect(Token token)
 {
     DVASSERT(SignalTokenProvider::IsValid(token));
 
-    auto it = connections.begin();
-    auto end = connections.end();
-    for (; it != end; it++)
+    Connection* c = FindConnection(token);
+    if (nullptr != c)
     {
-        if (it->token == token)
-        {
-            RemoveSlot(it);
-            break;
-        }
+        RemoveSlot(*c);
+        EraseDeletedSlots();
     }
 }
 
@@ -203,30 +253,39 @@ void Signal<Args...>::Disconnect(void* obj)
 {
     DVASSERT(nullptr != obj);
 
-    auto it = connections.begin();
-    auto end = connections.end();
-    for (; it != end;)
+    for (Connection& c : connections)
     {
-        if (it->object == obj || it->tracked == obj)
+        if (c.object == obj || c.tracked == obj)
         {
-            it = RemoveSlot(it);
+            RemoveSlot(c);
         }
-        else
+    }
+
+    for (Connection& c : addedConnections)
+    {
+        if (c.object == obj || c.tracked == obj)
         {
-            it++;
+            RemoveSlot(c);
         }
     }
+
+    EraseDeletedSlots();
 }
 
 template <typename... Args>
 void Signal<Args...>::DisconnectAll()
 {
-    auto it = connections.begin();
-    auto end = connections.end();
-    for (; it != end;)
+    for (Connection& c : connections)
+    {
+        RemoveSlot(c);
+    }
+
+    for (Connection& c : addedConnections)
     {
-        it = RemoveSlot(it);
+        RemoveSlot(c);
     }
+
+    EraseDeletedSlots();
 }
 
 template <typename... Args>
@@ -235,17 +294,17 @@ void Signal<Args...>::Track(Token token, TrackedObject* tracked)
     DVASSERT(SignalTokenProvider::IsValid(token));
     DVASSERT(nullptr != tracked);
 
-    auto it = connections.rbegin();
-    auto rend = connections.rend();
-    for (; it != rend; ++it)
+    Connection* c = FindConnection(token);
+    if (nullptr != c && c->tracked != tracked)
     {
-        if (it->token == token && it->tracked != tracked)
-        {
-            if (nullptr != it->tracked)
-                Unwatch(it->tracked);
+        TrackedObject* prevTracked = c->tracked;
+
+        c->tracked = tracked;
+        Watch(tracked);
 
-            it->tracked = tracked;
-            Watch(tracked);
+        if (nullptr != prevTracked && !IsTracked(prevTracked))
+        {
+            Unwatch(prevTracked);
         }
     }
 }
@@ -255,24 +314,29 @@ void Signal<Args...>::Block(Token token, bool block)
 {
     DVASSERT(SignalTokenProvider::IsValid(token));
 
-    for (auto& c : connections)
+    Connection* c = FindConnection(token);
+    if (nullptr != c)
     {
-        if (c.token == token)
-        {
-            c.flags.set(Connection::Blocked, block);
-            break;
-        }
+        c->flags.set(Connection::Blocked, block);
     }
 }
 
 template <typename... Args>
 void Signal<Args...>::Block(void* obj, bool block)
 {
-    for (auto& c : connections)
+    for (Connection& c : connections)
     {
         if (c.object == obj)
         {
-            c.blocked = block;
+            c.flags.set(Connection::Blocked, block);
+        }
+    }
+
+    for (Connection& c : addedConnections)
+    {
+        if (c.object == obj)
+        {
+            c.flags.set(Connection::Blocked, block);
         }
     }
 }
@@ -282,38 +346,40 @@ bool Signal<Args...>::IsBlocked(Token token) const
 {
     DVASSERT(SignalTokenProvider::IsValid(token));
 
-    for (auto& c : connections)
-    {
-        return c.flags.test(Connection::Blocked);
-    }
-
-    return false;
+    Connection* c = const_cast<Signal*>(this)->FindConnection(token);
+    return (nullptr != c && c->flags.test(Connection::Blocked));
 }
 
 template <typename... Args>
 void Signal<Args...>::Emit(Args... args)
 {
-    auto it = connections.begin();
-    auto end = connections.end();
+    emitDepth++;
 
-    while (it != end)
+    // connections array isn't reallocated or reordered during emission,
+    // so it is safe to keep reference to connection while its slot is invoked
+    size_t count = connections.Size();
+    for (size_t i = 0; i < count; ++i)
     {
-        if (!it->flags.test(Connection::Blocked))
+        Connection& c = connections[i];
+        if (c.flags.none())
         {
-            it->flags.set(Connection::Emiting, true);
-            it->fn(args...);
-            it->flags.set(Connection::Emiting, false);
+            c.fn(args...);
         }
+    }
 
-        if (it->flags.test(Connection::Deleted))
-        {
-            // erase slots that are already marked as 'deleted'
-            // see RemoveSlot() function for more description
-            it = RemoveSlot(it);
-        }
-        else
+    emitDepth--;
+
+    if (0 == emitDepth)
+    {
+        EraseDeletedSlots();
+
+        if (!addedConnections.empty())
         {
-            it++;
+            for (Connection& c : addedConnections)
+            {
+                InsertSlot(std::move(c));
+            }
+            addedConnections.clear();
         }
     }
 }
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "Debug/DVAssert.h"
-#include "Base/List.h"
+#include "Base/BaseTypes.h"
 #include "Base/Token.h"
 #include "Functional/Function.h"
 #include "Functional/TrackedObject.h"
 #include "Functional/Private/SignalBase.h"
+#include "Functional/Private/SignalStorage.h"
 
 namespace DAVA
 {
@@ -356,12 +357,17 @@ public:
         3. Signal::Group::Low, while order within the group corresponds to the connection order
 
         This method will skip slots, that are blocked with Signal::Block() method.
+        Slots disconnected during emission aren't invoked anymore, slots connected during
+        emission will be invoked starting from the next Emit() call.
     */
     void Emit(Args... args);
 
 private:
     using ConnectionFn = Function<void(Args...)>;
 
+    /** Count of connections which are stored without heap allocation */
+    static const size_t INLINE_CONNECTIONS_COUNT = 4;
+
     /** Internal structure that contains info about connected slot */
     struct Connection
     {
@@ -369,24 +375,31 @@ private:
         Token token; //< connection unique token
         TrackedObject* tracked; //< TrackedObject, that is try-casted from `object`
         ConnectionFn fn; //< slot function
+        Group group; //< slot group, connections are sorted by group
 
-        std::bitset<3> flags;
+        std::bitset<2> flags;
 
         enum Flags
         {
-            Emiting,
             Blocked,
             Deleted
         };
     };
 
-    using ConnectionIt = typename List<Connection>::iterator;
-
-    List<Connection> connections;
-    ConnectionIt connectionsMediumPos;
+    // Connections are stored in flat array sorted by group.
+    // While signal is emitting array isn't reordered: removed connections are only marked as deleted
+    // and new connections are kept in `addedConnections` until the outermost Emit() finishes.
+    SignalDetail::ConnectionStorage<Connection, INLINE_CONNECTIONS_COUNT> connections;
+    Vector<Connection> addedConnections;
+    uint32 emitDepth = 0;
+    bool hasDeletedConnections = false;
 
+    Connection* FindConnection(Token token);
     void AddSlot(Connection&& slot, Group group);
-    ConnectionIt RemoveSlot(ConnectionIt& it);
+    void InsertSlot(Connection&& slot);
+    void RemoveSlot(Connection& c);
+    void EraseDeletedSlots();
+    bool IsTracked(TrackedObject* tracked) const;
 
     void OnTrackedObjectDestroyed(TrackedObject* object) override;
 };
@@ -9,8 +9,40 @@
 #include "Job/JobThread.h"
 #include "Platform/DeviceInfo.h"
 
+#include <atomic>
+
 namespace DAVA
 {
+namespace JobManagerDetails
+{
+struct ParallelForState
+{
+    ParallelForState(uint32 count_, const Function<void(uint32)>& fn_)
+        : count(count_)
+        , fn(fn_)
+    {
+    }
+
+    const uint32 count;
+    const Function<void(uint32)>& fn; // is called only until all indices are executed, so caller's function is still alive
+    std::atomic<uint32> nextIndex{ 0 };
+    std::atomic<uint32> executedCount{ 0 };
+    Semaphore executedSem;
+};
+
+void ExecuteParallelFor(ParallelForState& state)
+{
+    for (uint32 index = state.nextIndex++; index < state.count; index = state.nextIndex++)
+    {
+        state.fn(index);
+        if (++state.executedCount == state.count)
+        {
+            state.executedSem.Post();
+        }
+    }
+}
+}
+
 JobManager::JobManager(Engine* e)
     : engine(e)
     , mainJobIDCounter(1)
@@ -262,6 +294,31 @@ void JobManager::WaitWorkerJobs()
     }
 }
 
+void JobManager::ParallelFor(uint32 count, const Function<void(uint32)>& fn)
+{
+    using namespace JobManagerDetails;
+
+    if (count < 2 || workerThreads.empty())
+    {
+        for (uint32 index = 0; index < count; ++index)
+        {
+            fn(index);
+        }
+        return;
+    }
+
+    // Worker-thread jobs may start after this call has returned, so state is shared with them
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>(count, fn);
+    uint32 jobsCount = Min(count - 1, GetWorkersCount());
+    for (uint32 i = 0; i < jobsCount; ++i)
+    {
+        CreateWorkerJob([state]() { ExecuteParallelFor(*state); });
+    }
+
+    ExecuteParallelFor(*state);
+    state->executedSem.Wait();
+}
+
 bool JobManager::HasWorkerJobs()
 {
     return !workerQueue.IsEmpty();
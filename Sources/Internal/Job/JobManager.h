@@ -65,6 +65,16 @@ public:
     /*! Wait until all worker-thread jobs are executed. */
     void WaitWorkerJobs();
 
+    /*! Execute function for every index in range [0, count) on worker-threads and the calling thread,
+        and wait until all of them are executed. Unlike WaitWorkerJobs, only these jobs are waited for:
+        indices which were not taken by worker-threads yet are executed by the calling thread, so the call
+        doesn't wait for other jobs in the queue. Main-thread jobs are not executed during the wait,
+        so function must not wait for main-thread jobs.
+		\param [in] count Count of indices.
+		\param [in] fn Function to execute for each index.
+	*/
+    void ParallelFor(uint32 count, const Function<void(uint32)>& fn);
+
     /*!  Check in there are some not executed worker-thread jobs.
 		\return Return true if there are some jobs, otherwise false.
 	*/
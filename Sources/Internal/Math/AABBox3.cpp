@@ -10,6 +10,9 @@ void AABBox3::GetTransformedBox(const Matrix4& transform, AABBox3& result) const
         return;
     }
 
+#if defined(__DAVAENGINE_SIMD_MATH__)
+    SIMDMath::TransformBox(transform.data, min.data, max.data, result.min.data, result.max.data);
+#else
     result.min.x = transform.data[12];
     result.min.y = transform.data[13];
     result.min.z = transform.data[14];
@@ -37,6 +40,7 @@ void AABBox3::GetTransformedBox(const Matrix4& transform, AABBox3& result) const
             }
         };
     }
+#endif
 }
 
 void AABBox3::GetCorners(Vector3* cornersArray) const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Neon/NeonMath.h"
+#include "Math/SIMD/SIMDMath.h"
 #include "Base/Any.h"
 #include "Math/Matrix3.h"
 #include "Debug/DVAssert.h"
@@ -370,6 +371,9 @@ inline void Matrix4::Transpose()
 
 inline bool Matrix4::GetInverse(Matrix4& out) const
 {
+#if defined(__DAVAENGINE_SIMD_MATH__)
+    return SIMDMath::Matrix4Inverse(data, out.data);
+#else
     /// Calculates the inverse of this Matrix
     /// The inverse is calculated using Cramers rule.
     /// If no inverse exists then 'false' is returned.
@@ -402,6 +406,7 @@ inline bool Matrix4::GetInverse(Matrix4& out) const
     out(3, 3) = d * (m(0, 0) * (m(1, 1) * m(2, 2) - m(2, 1) * m(1, 2)) + m(1, 0) * (m(2, 1) * m(0, 2) - m(0, 1) * m(2, 2)) + m(2, 0) * (m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2)));
 
     return true;
+#endif
 }
 inline bool Matrix4::Inverse()
 {
@@ -453,7 +458,11 @@ inline Matrix4 Matrix4::operator*(const Matrix4& m) const
 {
 //matrixMultiplicationCounter++;
 	
-#ifdef __DAVAENGINE_ARM_7__
+#if defined(__DAVAENGINE_SIMD_MATH__)
+    Matrix4 res;
+    SIMDMath::Matrix4Mul(this->data, m.data, res.data);
+    return res;
+#elif defined(__DAVAENGINE_ARM_7__)
     Matrix4 res;
     NEON_Matrix4Mul(this->data, m.data, res.data);
     return res;
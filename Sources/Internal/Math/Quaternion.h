@@ -396,10 +396,14 @@ inline void Quaternion::Slerp(const Quaternion& q1, const Quaternion& q2, float3
         scale1 = t;
     }
 
+#if defined(__DAVAENGINE_SIMD_MATH__)
+    SIMDMath::QuaternionBlend(q1.data, scale0, q2t, scale1, data);
+#else
     x = scale0 * q1.x + scale1 * q2t[0];
     y = scale0 * q1.y + scale1 * q2t[1];
     z = scale0 * q1.z + scale1 * q2t[2];
     w = scale0 * q1.w + scale1 * q2t[3];
+#endif
 }
 
 inline void Quaternion::Construct(const Vector3& axis, float32 angle)
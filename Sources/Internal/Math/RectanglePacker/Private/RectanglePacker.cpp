@@ -1,10 +1,45 @@
 #include "Math/RectanglePacker/RectanglePacker.h"
 #include "Math/RectanglePacker/Spritesheet.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Render/Texture.h"
 #include "Logger/Logger.h"
 
+
 namespace DAVA
 {
+namespace RectanglePackerDetail
+{
+uint32 GetSortKey(const RectanglePacker::SpriteItem& item, SpriteSortOrder order)
+{
+    int32 w = item.defFile->GetFrameWidth(item.frameIndex);
+    int32 h = item.defFile->GetFrameHeight(item.frameIndex);
+    switch (order)
+    {
+    case SpriteSortOrder::MAX_SIDE:
+        return static_cast<uint32>(Max(w, h));
+    case SpriteSortOrder::HEIGHT:
+        return static_cast<uint32>(h);
+    case SpriteSortOrder::WIDTH:
+        return static_cast<uint32>(w);
+    case SpriteSortOrder::PERIMETER:
+        return static_cast<uint32>(w + h);
+    case SpriteSortOrder::AREA:
+    default:
+        return item.spriteWeight;
+    }
+}
+
+void SortSprites(Vector<RectanglePacker::SpriteItem>& sprites, SpriteSortOrder order)
+{
+    // stable sort keeps previous order of equal sprites, so results are deterministic
+    std::stable_sort(sprites.begin(), sprites.end(), [order](const RectanglePacker::SpriteItem& a, const RectanglePacker::SpriteItem& b) {
+        return GetSortKey(a, order) > GetSortKey(b, order);
+    });
+}
+}
+
 RectanglePacker::RectanglePacker()
 {
 }
@@ -12,6 +47,7 @@ RectanglePacker::RectanglePacker()
 std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::Pack(RectanglePacker::PackTask& packTask) const
 {
     DVASSERT(packAlgorithms.empty() == false, "Packing algorithm was not specified");
+    DVASSERT(sortOrders.empty() == false, "Sort order was not specified");
     Vector<SpriteItem> spritesToPack;
     for (const std::shared_ptr<SpriteDefinition>& defFile : packTask.spriteList)
     {
@@ -26,8 +62,7 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::Pack(RectanglePack
         }
     }
 
-    std::stable_sort(spritesToPack.begin(), spritesToPack.end(),
-                     [](const SpriteItem& a, const SpriteItem& b) { return a.spriteWeight > b.spriteWeight; });
+    RectanglePackerDetail::SortSprites(spritesToPack, SpriteSortOrder::AREA);
 
     return PackSprites(spritesToPack, packTask);
 }
@@ -59,24 +94,22 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::PackSprites(Vector
                 if (wasFullyPacked && sheetWeight >= bestSheetWeight)
                     continue;
 
-                for (const PackingAlgorithm alg : packAlgorithms)
-                {
-                    std::unique_ptr<SpritesheetLayout> sheet = SpritesheetLayout::Create(xResolution, yResolution, useTwoSideMargin, texturesMargin, alg);
-
-                    Vector<SpriteItem> tempSpritesRemaining = spritesToPack;
-                    uint32 spritesWeight = TryToPack(sheet.get(), tempSpritesRemaining, wasFullyPacked);
+                Vector<PackAttempt> attempts;
+                TryAlgorithms(spritesToPack, xResolution, yResolution, wasFullyPacked, attempts);
 
-                    bool nowFullyPacked = tempSpritesRemaining.empty();
+                for (PackAttempt& attempt : attempts)
+                {
+                    bool nowFullyPacked = attempt.spritesRemaining.empty();
 
                     if (wasFullyPacked && !nowFullyPacked)
                         continue;
 
-                    if (nowFullyPacked || spritesWeight > bestSpritesWeight || (spritesWeight == bestSpritesWeight && sheetWeight < bestSheetWeight))
+                    if (nowFullyPacked || attempt.spritesWeight > bestSpritesWeight || (attempt.spritesWeight == bestSpritesWeight && sheetWeight < bestSheetWeight))
                     {
-                        bestSpritesWeight = spritesWeight;
+                        bestSpritesWeight = attempt.spritesWeight;
                         bestSheetWeight = sheetWeight;
-                        bestSheet = std::move(sheet);
-                        bestSpritesRemaining.swap(tempSpritesRemaining);
+                        bestSheet = std::move(attempt.sheet);
+                        bestSpritesRemaining.swap(attempt.spritesRemaining);
 
                         if (nowFullyPacked)
                         {
@@ -104,6 +137,45 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::PackSprites(Vector
     return packResult;
 }
 
+void RectanglePacker::TryAlgorithms(const Vector<SpriteItem>& spritesToPack, uint32 xResolution, uint32 yResolution, bool fullPackOnly, Vector<PackAttempt>& attempts) const
+{
+    // every attempt depends only on its sort order and algorithm, so attempts can be done in any order
+    // and results are compared later in sort orders and algorithms order
+    const size_t attemptsCount = sortOrders.size() * packAlgorithms.size();
+    attempts.resize(attemptsCount);
+
+    auto tryAlgorithm = [&](size_t index)
+    {
+        PackAttempt& attempt = attempts[index];
+        attempt.sheet = SpritesheetLayout::Create(xResolution, yResolution, useTwoSideMargin, texturesMargin, packAlgorithms[index % packAlgorithms.size()]);
+        attempt.spritesRemaining = spritesToPack;
+        RectanglePackerDetail::SortSprites(attempt.spritesRemaining, sortOrders[index / packAlgorithms.size()]);
+        attempt.spritesWeight = TryToPack(attempt.sheet.get(), attempt.spritesRemaining, fullPackOnly);
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (parallelAlgorithms && jobManager != nullptr)
+    {
+        // shares worker threads with caller, so nested packing from worker jobs doesn't oversubscribe CPU
+        jobManager->ParallelFor(static_cast<uint32>(attemptsCount), [&tryAlgorithm](uint32 index) {
+            tryAlgorithm(index);
+        });
+    }
+    else
+    {
+        for (size_t i = 0; i < attemptsCount; ++i)
+        {
+            tryAlgorithm(i);
+            if (attempts[i].spritesRemaining.empty())
+            {
+                // next attempts will be skipped anyway
+                attempts.resize(i + 1);
+                break;
+            }
+        }
+    }
+}
+
 uint32 RectanglePacker::TryToPack(SpritesheetLayout* sheet, Vector<SpriteItem>& tempSortVector, bool fullPackOnly) const
 {
     uint32 weight = 0;
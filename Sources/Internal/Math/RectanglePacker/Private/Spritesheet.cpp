@@ -13,6 +13,8 @@ ENUM_DECLARE(DAVA::PackingAlgorithm)
     ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT), "ALG_MAXRECTS_BEST_SHORT_SIDE_FIT");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT), "ALG_MAXRECTS_BEST_LONG_SIDE_FIT");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT), "ALG_MAXRRECT_BEST_CONTACT_POINT");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT), "ALG_SKYLINE_BOTTOM_LEFT");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::PackingAlgorithm::ALG_SKYLINE_MIN_WASTE), "ALG_SKYLINE_MIN_WASTE");
 };
 
 namespace DAVA
@@ -32,6 +34,11 @@ public:
     {
         return rootNode.cell.marginsRect.dx * rootNode.cell.marginsRect.dy;
     }
+    uint32 GetUsedArea() const override
+    {
+        return usedArea;
+    }
+    void RemoveSprite(const void* searchPtr) override;
 
 private:
     struct SpritesheetNode
@@ -48,6 +55,7 @@ private:
     const int32 spritesMargin;
     const int32 splitter;
     SpritesheetNode rootNode;
+    uint32 usedArea = 0;
 };
 
 BasicSpritesheetLayout::BasicSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 margin)
@@ -171,6 +179,7 @@ bool BasicSpritesheetLayout::AddSprite(const Size2i& spriteSize, const void* spr
     SpritesheetNode* node = Insert(&rootNode, spriteSize, spritePtr);
     if (node != nullptr)
     {
+        usedArea += node->cell.marginsRect.dx * node->cell.marginsRect.dy;
         Logger::FrameworkDebug("sprite set to (%d, %d), sprite size [%d x %d]", node->cell.marginsRect.dx, node->cell.marginsRect.dy, spriteSize.dx, spriteSize.dy);
         return true;
     }
@@ -186,6 +195,17 @@ const SpriteBoundsRect* BasicSpritesheetLayout::GetSpriteBoundsRect(const void*
     return (res ? &res->cell : nullptr);
 }
 
+void BasicSpritesheetLayout::RemoveSprite(const void* searchPtr)
+{
+    SpritesheetNode* node = const_cast<SpritesheetNode*>(SearchNodeForPtr(&rootNode, searchPtr));
+    if (node != nullptr && node != &rootNode)
+    {
+        usedArea -= node->cell.marginsRect.dx * node->cell.marginsRect.dy;
+        // layout itself is never used as sprite pointer, so node stays occupied and can't be found
+        node->spritePtr = this;
+    }
+}
+
 const BasicSpritesheetLayout::SpritesheetNode* BasicSpritesheetLayout::SearchNodeForPtr(const SpritesheetNode* node, const void* imagePtr) const
 {
     if (imagePtr == node->spritePtr)
@@ -225,6 +245,11 @@ public:
     {
         return sheetRect.dx * sheetRect.dy;
     }
+    uint32 GetUsedArea() const override
+    {
+        return usedArea;
+    }
+    void RemoveSprite(const void* searchPtr) override;
 
 protected:
     virtual const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const = 0;
@@ -239,6 +264,7 @@ protected:
     Rect2i sheetRect;
     List<SpriteBoundsRect> freeRects;
     UnorderedMap<const void*, SpriteBoundsRect> spriteRects;
+    uint32 usedArea = 0;
 };
 
 MaxRectsSpritesheetLayout::MaxRectsSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 margin)
@@ -266,6 +292,7 @@ bool MaxRectsSpritesheetLayout::AddSprite(const Size2i& spriteSize, const void*
 
     const SpriteBoundsRect* newSpriteRect = InsertNewSpriteRect(bestFreeRect, spriteSize, spritePtr);
     DVASSERT(newSpriteRect != nullptr);
+    usedArea += newSpriteRect->marginsRect.dx * newSpriteRect->marginsRect.dy;
 
     SplitIntersectedFreeRects(newSpriteRect);
     RemoveRedundantFreeRects();
@@ -436,6 +463,17 @@ const SpriteBoundsRect* MaxRectsSpritesheetLayout::GetSpriteBoundsRect(const voi
     return (result == spriteRects.end() ? nullptr : &(result->second));
 }
 
+void MaxRectsSpritesheetLayout::RemoveSprite(const void* searchPtr)
+{
+    auto result = spriteRects.find(searchPtr);
+    if (result != spriteRects.end())
+    {
+        // free rects are not restored, place is reused only when layout is recreated
+        usedArea -= result->second.marginsRect.dx * result->second.marginsRect.dy;
+        spriteRects.erase(result);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 struct MaxRectsSpritesheetLayout_BL : public MaxRectsSpritesheetLayout
@@ -608,6 +646,239 @@ protected:
 
 //////////////////////////////////////////////////////////////////////////
 
+class SkylineSpritesheetLayout : public SpritesheetLayout
+{
+public:
+    explicit SkylineSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 spritesMargin, bool minWaste);
+
+    // SpritesheetLayout
+    bool AddSprite(const Size2i& spriteSize, const void* searchPtr) override;
+    const SpriteBoundsRect* GetSpriteBoundsRect(const void* searchPtr) const override;
+    const Rect2i& GetRect() const override
+    {
+        return sheetRect;
+    }
+    uint32 GetWeight() const override
+    {
+        return sheetRect.dx * sheetRect.dy;
+    }
+    uint32 GetUsedArea() const override
+    {
+        return usedArea;
+    }
+    void RemoveSprite(const void* searchPtr) override;
+
+private:
+    // top edge of occupied area, segments go from left to right and cover whole sheet width
+    struct SkylineSegment
+    {
+        int32 x;
+        int32 y;
+        int32 width;
+    };
+
+    bool FitCell(int32 x, int32 y, const Size2i& spriteSize, SpriteBoundsRect& cell) const;
+    bool FitSegment(size_t segmentIndex, const Size2i& spriteSize, SpriteBoundsRect& cell, int32& wastedArea) const;
+    void AddSkylineLevel(size_t segmentIndex, const Rect2i& rect);
+
+    const int32 edgePixel;
+    const int32 spritesMargin;
+    const int32 splitter;
+    const bool minWaste;
+
+    Rect2i sheetRect;
+    Vector<SkylineSegment> skyline;
+    UnorderedMap<const void*, SpriteBoundsRect> spriteRects;
+    uint32 usedArea = 0;
+};
+
+SkylineSpritesheetLayout::SkylineSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 margin, bool minWaste_)
+    : edgePixel(duplicateEdgePixel ? 1 : 0)
+    , spritesMargin(margin)
+    , splitter(spritesMargin + edgePixel + edgePixel)
+    , minWaste(minWaste_)
+{
+    sheetRect = Rect2i(0, 0, w, h);
+    skyline.push_back({ 0, 0, static_cast<int32>(w) });
+}
+
+bool SkylineSpritesheetLayout::FitCell(int32 x, int32 y, const Size2i& spriteSize, SpriteBoundsRect& cell) const
+{
+    // edge pixels and margins are added like in other layouts:
+    // sprites near sheet borders get the rest of space instead of margin
+    cell = SpriteBoundsRect();
+    cell.leftEdgePixel = (x > 0) ? edgePixel : 0;
+    cell.topEdgePixel = (y > 0) ? edgePixel : 0;
+
+    int32 restWidth = sheetRect.dx - x - cell.leftEdgePixel - spriteSize.dx;
+    int32 restHeight = sheetRect.dy - y - cell.topEdgePixel - spriteSize.dy;
+    if (restWidth < 0 || restHeight < 0)
+    {
+        return false;
+    }
+
+    if (restWidth <= splitter)
+    {
+        cell.rightEdgePixel = (restWidth >= edgePixel) ? edgePixel : 0;
+        cell.rightMargin = restWidth - cell.rightEdgePixel;
+    }
+    else
+    {
+        cell.rightEdgePixel = edgePixel;
+        cell.rightMargin = spritesMargin;
+    }
+
+    if (restHeight <= splitter)
+    {
+        cell.bottomEdgePixel = (restHeight >= edgePixel) ? edgePixel : 0;
+        cell.bottomMargin = restHeight - cell.bottomEdgePixel;
+    }
+    else
+    {
+        cell.bottomEdgePixel = edgePixel;
+        cell.bottomMargin = spritesMargin;
+    }
+
+    cell.spriteRect = Rect2i(x + cell.leftEdgePixel, y + cell.topEdgePixel, spriteSize.dx, spriteSize.dy);
+    cell.marginsRect = Rect2i(x, y, spriteSize.dx + cell.leftEdgePixel + cell.rightEdgePixel + cell.rightMargin, spriteSize.dy + cell.topEdgePixel + cell.bottomEdgePixel + cell.bottomMargin);
+    return true;
+}
+
+bool SkylineSpritesheetLayout::FitSegment(size_t segmentIndex, const Size2i& spriteSize, SpriteBoundsRect& cell, int32& wastedArea) const
+{
+    const int32 x = skyline[segmentIndex].x;
+
+    // width of cell doesn't depend on its vertical position
+    if (!FitCell(x, 0, spriteSize, cell))
+    {
+        return false;
+    }
+
+    const int32 cellWidth = cell.marginsRect.dx;
+    int32 y = 0;
+    for (size_t i = segmentIndex; i < skyline.size() && skyline[i].x < x + cellWidth; ++i)
+    {
+        y = Max(y, skyline[i].y);
+    }
+
+    wastedArea = 0;
+    for (size_t i = segmentIndex; i < skyline.size() && skyline[i].x < x + cellWidth; ++i)
+    {
+        int32 segmentRight = Min(skyline[i].x + skyline[i].width, x + cellWidth);
+        wastedArea += (segmentRight - skyline[i].x) * (y - skyline[i].y);
+    }
+
+    return FitCell(x, y, spriteSize, cell);
+}
+
+void SkylineSpritesheetLayout::AddSkylineLevel(size_t segmentIndex, const Rect2i& rect)
+{
+    skyline.insert(skyline.begin() + segmentIndex, { rect.x, rect.y + rect.dy, rect.dx });
+
+    // cut segments covered by new one
+    for (size_t i = segmentIndex + 1; i < skyline.size();)
+    {
+        const SkylineSegment& prev = skyline[i - 1];
+        SkylineSegment& segment = skyline[i];
+        int32 overlap = prev.x + prev.width - segment.x;
+        if (overlap <= 0)
+        {
+            break;
+        }
+
+        segment.x += overlap;
+        segment.width -= overlap;
+        if (segment.width > 0)
+        {
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // merge neighbours of the same height
+    for (size_t i = 1; i < skyline.size();)
+    {
+        if (skyline[i - 1].y == skyline[i].y)
+        {
+            skyline[i - 1].width += skyline[i].width;
+            skyline.erase(skyline.begin() + i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+bool SkylineSpritesheetLayout::AddSprite(const Size2i& spriteSize, const void* spritePtr)
+{
+    size_t bestSegment = skyline.size();
+    SpriteBoundsRect bestCell;
+    int32 bestTop = 0;
+    int32 bestWaste = 0;
+
+    for (size_t i = 0; i < skyline.size(); ++i)
+    {
+        SpriteBoundsRect cell;
+        int32 waste = 0;
+        if (FitSegment(i, spriteSize, cell, waste))
+        {
+            int32 top = cell.marginsRect.y + cell.marginsRect.dy;
+            bool better = false;
+            if (bestSegment == skyline.size())
+            {
+                better = true;
+            }
+            else if (minWaste)
+            {
+                better = waste < bestWaste || (waste == bestWaste && top < bestTop);
+            }
+            else
+            {
+                better = top < bestTop || (top == bestTop && waste < bestWaste);
+            }
+
+            if (better)
+            {
+                bestSegment = i;
+                bestCell = cell;
+                bestTop = top;
+                bestWaste = waste;
+            }
+        }
+    }
+
+    if (bestSegment == skyline.size())
+    {
+        return false;
+    }
+
+    auto insertResult = spriteRects.insert(std::make_pair(spritePtr, bestCell));
+    DVASSERT(insertResult.second == true, "Second attempt to insert same sprite");
+
+    AddSkylineLevel(bestSegment, bestCell.marginsRect);
+    usedArea += bestCell.marginsRect.dx * bestCell.marginsRect.dy;
+    return true;
+}
+
+const SpriteBoundsRect* SkylineSpritesheetLayout::GetSpriteBoundsRect(const void* searchPtr) const
+{
+    auto result = spriteRects.find(searchPtr);
+    return (result == spriteRects.end() ? nullptr : &(result->second));
+}
+
+void SkylineSpritesheetLayout::RemoveSprite(const void* searchPtr)
+{
+    auto result = spriteRects.find(searchPtr);
+    if (result != spriteRects.end())
+    {
+        usedArea -= result->second.marginsRect.dx * result->second.marginsRect.dy;
+        spriteRects.erase(result);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 std::unique_ptr<SpritesheetLayout> SpritesheetLayout::Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg)
 {
     switch (alg)
@@ -624,6 +895,10 @@ std::unique_ptr<SpritesheetLayout> SpritesheetLayout::Create(uint32 w, uint32 h,
         return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_LSF(w, h, duplicateEdgePixel, spritesMargin));
     case PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT:
         return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_CP(w, h, duplicateEdgePixel, spritesMargin));
+    case PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT:
+        return std::unique_ptr<SpritesheetLayout>(new SkylineSpritesheetLayout(w, h, duplicateEdgePixel, spritesMargin, false));
+    case PackingAlgorithm::ALG_SKYLINE_MIN_WASTE:
+        return std::unique_ptr<SpritesheetLayout>(new SkylineSpritesheetLayout(w, h, duplicateEdgePixel, spritesMargin, true));
     default:
         DVASSERT(false, Format("Unknown algorithm id: %d", alg).c_str());
         return nullptr;
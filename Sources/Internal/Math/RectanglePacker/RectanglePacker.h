@@ -7,6 +7,16 @@
 
 namespace DAVA
 {
+/** Order in which sprites are added into spritesheet, all orders are descending */
+enum class SpriteSortOrder
+{
+    AREA,
+    MAX_SIDE,
+    HEIGHT,
+    WIDTH,
+    PERIMETER
+};
+
 class RectanglePacker final
 {
 public:
@@ -55,6 +65,13 @@ public:
         uint32 frameIndex = 0;
     };
 
+    struct PackAttempt
+    {
+        std::unique_ptr<SpritesheetLayout> sheet;
+        Vector<SpriteItem> spritesRemaining;
+        uint32 spritesWeight = 0;
+    };
+
     static const uint32 DEFAULT_TEXTURE_SIZE = 2048;
     static const uint32 DEFAULT_MARGIN = 1;
 
@@ -66,6 +83,16 @@ public:
     // set visible 1 pixel border for each texture
     void SetTwoSideMargin(bool val = true);
     void SetTexturesMargin(uint32 margin);
+    /**
+        Try every combination of sort order and algorithm for each sheet size. Default is AREA order only.
+        Combinations are compared in sort orders order and then in algorithms order.
+    */
+    void SetSortOrders(const Vector<SpriteSortOrder>& orders);
+    /**
+        Try all combinations of sort orders and algorithms for each sheet size concurrently, on JobManager worker threads.
+        Best sheet is selected in combinations order, so result is the same as for sequential packing.
+    */
+    void SetParallelAlgorithms(bool value);
 
     /** Pack sprites from packTask and return PackResult with spritesheets data */
     std::unique_ptr<PackResult> Pack(PackTask& packTask) const;
@@ -73,13 +100,16 @@ public:
 private:
     std::unique_ptr<PackResult> PackSprites(Vector<SpriteItem>& spritesToPack, PackTask& packTask) const;
     uint32 TryToPack(SpritesheetLayout* sheet, Vector<SpriteItem>& tempSortVector, bool fullPackOnly) const;
+    void TryAlgorithms(const Vector<SpriteItem>& spritesToPack, uint32 xResolution, uint32 yResolution, bool fullPackOnly, Vector<PackAttempt>& attempts) const;
     void CreateSpritesIndex(RectanglePacker::PackTask& packTask, RectanglePacker::PackResult* packResult) const;
 
     Vector<PackingAlgorithm> packAlgorithms;
+    Vector<SpriteSortOrder> sortOrders = { SpriteSortOrder::AREA };
     uint32 maxTextureSize = DEFAULT_TEXTURE_SIZE;
     bool onlySquareTextures = false;
     bool useTwoSideMargin = false;
     uint32 texturesMargin = 1;
+    bool parallelAlgorithms = false;
 };
 
 inline void RectanglePacker::SetUseOnlySquareTextures(bool value)
@@ -101,10 +131,21 @@ inline void RectanglePacker::SetTexturesMargin(uint32 margin)
     texturesMargin = margin;
 }
 
+inline void RectanglePacker::SetParallelAlgorithms(bool value)
+{
+    parallelAlgorithms = value;
+}
+
 inline void RectanglePacker::SetAlgorithms(const Vector<PackingAlgorithm>& algorithms)
 {
     packAlgorithms = algorithms;
 }
+
+inline void RectanglePacker::SetSortOrders(const Vector<SpriteSortOrder>& orders)
+{
+    sortOrders = orders;
+}
+
 inline uint32 RectanglePacker::SpriteDefinition::GetFrameCount() const
 {
     return static_cast<uint32>(frameRects.size());
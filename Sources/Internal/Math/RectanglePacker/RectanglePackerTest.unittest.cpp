@@ -136,4 +136,138 @@ DAVA_TESTCLASS (RectanglePackerTest)
         TEST_VERIFY(packResult->resultSheets.size() == 1);
         TEST_VERIFY(packResult->resultErrors.size() == 1);
     }
+
+    DAVA_TEST (ParallelAlgorithmsTest)
+    {
+        RectanglePacker::PackTask packTask;
+        for (int32 i = 0; i < 40; i++)
+        {
+            auto spriteDef = std::make_shared<RectanglePacker::SpriteDefinition>();
+            spriteDef->frameRects.push_back(Rect2i(0, 0, 16 + (i * 37) % 200, 16 + (i * 53) % 120));
+            packTask.spriteList.push_back(spriteDef);
+        }
+
+        RectanglePacker rectanglePacker;
+        rectanglePacker.SetMaxTextureSize(512);
+        rectanglePacker.SetAlgorithms({
+        PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT,
+        PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
+        PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
+        PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT,
+        PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT,
+        PackingAlgorithm::ALG_BASIC
+        });
+
+        auto serialResult = rectanglePacker.Pack(packTask);
+        rectanglePacker.SetParallelAlgorithms(true);
+        auto parallelResult = rectanglePacker.Pack(packTask);
+
+        TEST_VERIFY(serialResult->Success() && parallelResult->Success());
+        TEST_VERIFY(serialResult->resultSheets.size() == parallelResult->resultSheets.size());
+        for (size_t i = 0; i < serialResult->resultSheets.size(); ++i)
+        {
+            TEST_VERIFY(serialResult->resultSheets[i]->GetRect() == parallelResult->resultSheets[i]->GetRect());
+        }
+
+        for (size_t i = 0; i < packTask.spriteList.size(); ++i)
+        {
+            const RectanglePacker::SpriteIndexedData& serialData = serialResult->resultIndexedSprites[i];
+            const RectanglePacker::SpriteIndexedData& parallelData = parallelResult->resultIndexedSprites[i];
+            TEST_VERIFY(serialData.frameToSheetIndex == parallelData.frameToSheetIndex);
+            TEST_VERIFY(serialData.frameToPackedInfo[0]->spriteRect == parallelData.frameToPackedInfo[0]->spriteRect);
+        }
+    }
+
+    DAVA_TEST (SkylineTest)
+    {
+        RectanglePacker::PackTask packTask;
+        for (int32 i = 0; i < 16; i++)
+        {
+            auto spriteDef = std::make_shared<RectanglePacker::SpriteDefinition>();
+            spriteDef->frameRects.push_back(Rect2i(0, 0, 256, 256));
+            packTask.spriteList.push_back(spriteDef);
+        }
+
+        for (PackingAlgorithm algorithm : { PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT, PackingAlgorithm::ALG_SKYLINE_MIN_WASTE })
+        {
+            RectanglePacker rectanglePacker;
+            rectanglePacker.SetMaxTextureSize(1024);
+            rectanglePacker.SetTexturesMargin(0);
+            rectanglePacker.SetAlgorithms({ algorithm });
+
+            auto packResult = rectanglePacker.Pack(packTask);
+            TEST_VERIFY(packResult->Success());
+            TEST_VERIFY(packResult->resultSheets.size() == 1);
+            TEST_VERIFY(packResult->resultSheets[0]->GetRect() == Rect2i(0, 0, 1024, 1024));
+            TEST_VERIFY(FLOAT_EQUAL(packResult->resultSheets[0]->GetOccupancy(), 1.f));
+        }
+    }
+
+    DAVA_TEST (SortOrdersTest)
+    {
+        RectanglePacker::PackTask packTask;
+        for (int32 i = 0; i < 40; i++)
+        {
+            auto spriteDef = std::make_shared<RectanglePacker::SpriteDefinition>();
+            spriteDef->frameRects.push_back(Rect2i(0, 0, 16 + (i * 37) % 200, 16 + (i * 53) % 120));
+            packTask.spriteList.push_back(spriteDef);
+        }
+
+        RectanglePacker rectanglePacker;
+        rectanglePacker.SetMaxTextureSize(512);
+        rectanglePacker.SetTwoSideMargin(true);
+        rectanglePacker.SetAlgorithms({
+        PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT,
+        PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT,
+        PackingAlgorithm::ALG_SKYLINE_MIN_WASTE
+        });
+        rectanglePacker.SetSortOrders({ SpriteSortOrder::AREA, SpriteSortOrder::MAX_SIDE, SpriteSortOrder::HEIGHT, SpriteSortOrder::WIDTH, SpriteSortOrder::PERIMETER });
+
+        auto serialResult = rectanglePacker.Pack(packTask);
+        rectanglePacker.SetParallelAlgorithms(true);
+        auto parallelResult = rectanglePacker.Pack(packTask);
+
+        TEST_VERIFY(serialResult->Success() && parallelResult->Success());
+        TEST_VERIFY(serialResult->resultSheets.size() == parallelResult->resultSheets.size());
+        for (size_t i = 0; i < serialResult->resultSheets.size(); ++i)
+        {
+            TEST_VERIFY(serialResult->resultSheets[i]->GetRect() == parallelResult->resultSheets[i]->GetRect());
+            TEST_VERIFY(serialResult->resultSheets[i]->GetUsedArea() == parallelResult->resultSheets[i]->GetUsedArea());
+        }
+
+        // packed sprites must not overlap each other
+        for (size_t i = 0; i < packTask.spriteList.size(); ++i)
+        {
+            const RectanglePacker::SpriteIndexedData& data = serialResult->resultIndexedSprites[i];
+            for (size_t j = i + 1; j < packTask.spriteList.size(); ++j)
+            {
+                const RectanglePacker::SpriteIndexedData& otherData = serialResult->resultIndexedSprites[j];
+                if (data.frameToSheetIndex[0] == otherData.frameToSheetIndex[0])
+                {
+                    Rect2i intersection = data.frameToPackedInfo[0]->spriteRect.Intersection(otherData.frameToPackedInfo[0]->spriteRect);
+                    TEST_VERIFY(intersection.dx <= 0 || intersection.dy <= 0);
+                }
+            }
+        }
+    }
+
+    DAVA_TEST (RemoveSpriteTest)
+    {
+        Rect2i frames[2] = { Rect2i(0, 0, 64, 32), Rect2i(0, 0, 32, 64) };
+        for (PackingAlgorithm algorithm : { PackingAlgorithm::ALG_BASIC, PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT, PackingAlgorithm::ALG_SKYLINE_BOTTOM_LEFT })
+        {
+            std::unique_ptr<SpritesheetLayout> sheet = SpritesheetLayout::Create(128, 128, false, 0, algorithm);
+            TEST_VERIFY(sheet->GetUsedArea() == 0);
+
+            TEST_VERIFY(sheet->AddSprite(Size2i(64, 32), &frames[0]));
+            TEST_VERIFY(sheet->AddSprite(Size2i(32, 64), &frames[1]));
+            TEST_VERIFY(sheet->GetUsedArea() == 64 * 32 * 2);
+
+            sheet->RemoveSprite(&frames[0]);
+            TEST_VERIFY(sheet->GetSpriteBoundsRect(&frames[0]) == nullptr);
+            TEST_VERIFY(sheet->GetSpriteBoundsRect(&frames[1]) != nullptr);
+            TEST_VERIFY(sheet->GetUsedArea() == 64 * 32);
+            TEST_VERIFY(FLOAT_EQUAL(sheet->GetOccupancy(), (64.f * 32.f) / (128.f * 128.f)));
+        }
+    }
 };
@@ -13,7 +13,9 @@ enum class PackingAlgorithm
     ALG_MAXRECTS_BEST_AREA_FIT,
     ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
     ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
-    ALG_MAXRRECT_BEST_CONTACT_POINT
+    ALG_MAXRRECT_BEST_CONTACT_POINT,
+    ALG_SKYLINE_BOTTOM_LEFT,
+    ALG_SKYLINE_MIN_WASTE
 };
 
 struct SpriteBoundsRect
@@ -35,6 +37,16 @@ struct SpritesheetLayout
     virtual const SpriteBoundsRect* GetSpriteBoundsRect(const void* searchPtr) const = 0;
     virtual const Rect2i& GetRect() const = 0;
     virtual uint32 GetWeight() const = 0;
+    /** Area occupied by sprites including their edge pixels and margins */
+    virtual uint32 GetUsedArea() const = 0;
+    /** Forget sprite, its place stays occupied until layout is recreated */
+    virtual void RemoveSprite(const void* searchPtr) = 0;
+
+    float32 GetOccupancy() const
+    {
+        uint32 weight = GetWeight();
+        return (weight > 0) ? static_cast<float32>(GetUsedArea()) / static_cast<float32>(weight) : 0.f;
+    }
 
     static std::unique_ptr<SpritesheetLayout> Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg);
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+#include <arm_neon.h>
+
+namespace DAVA
+{
+namespace SIMDMath
+{
+using Float4 = float32x4_t;
+
+inline Float4 Load(const float32* p)
+{
+    return vld1q_f32(p);
+}
+
+inline void Store(float32* p, Float4 v)
+{
+    vst1q_f32(p, v);
+}
+
+inline Float4 Set(float32 x, float32 y, float32 z, float32 w)
+{
+    const float32 v[4] = { x, y, z, w };
+    return vld1q_f32(v);
+}
+
+inline Float4 Set1(float32 v)
+{
+    return vdupq_n_f32(v);
+}
+
+inline float32 GetX(Float4 v)
+{
+    return vgetq_lane_f32(v, 0);
+}
+
+inline Float4 Add(Float4 a, Float4 b)
+{
+    return vaddq_f32(a, b);
+}
+
+inline Float4 Sub(Float4 a, Float4 b)
+{
+    return vsubq_f32(a, b);
+}
+
+inline Float4 Mul(Float4 a, Float4 b)
+{
+    return vmulq_f32(a, b);
+}
+
+/** Return a < b ? a : b per component. */
+inline Float4 Min(Float4 a, Float4 b)
+{
+    return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+
+/** Return a > b ? a : b per component. */
+inline Float4 Max(Float4 a, Float4 b)
+{
+    return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+
+/** Return (v[X], v[Y], v[Z], v[W]). */
+template <int X, int Y, int Z, int W>
+inline Float4 Swizzle(Float4 v)
+{
+    Float4 r = vdupq_n_f32(vgetq_lane_f32(v, X));
+    r = vsetq_lane_f32(vgetq_lane_f32(v, Y), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(v, Z), r, 2);
+    return vsetq_lane_f32(vgetq_lane_f32(v, W), r, 3);
+}
+
+/** Return (a[X], a[Y], b[Z], b[W]). */
+template <int X, int Y, int Z, int W>
+inline Float4 Shuffle(Float4 a, Float4 b)
+{
+    Float4 r = vdupq_n_f32(vgetq_lane_f32(a, X));
+    r = vsetq_lane_f32(vgetq_lane_f32(a, Y), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(b, Z), r, 2);
+    return vsetq_lane_f32(vgetq_lane_f32(b, W), r, 3);
+}
+} // namespace SIMDMath
+} // namespace DAVA
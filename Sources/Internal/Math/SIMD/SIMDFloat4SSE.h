@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+#include <emmintrin.h>
+
+namespace DAVA
+{
+namespace SIMDMath
+{
+using Float4 = __m128;
+
+inline Float4 Load(const float32* p)
+{
+    return _mm_loadu_ps(p);
+}
+
+inline void Store(float32* p, Float4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+
+inline Float4 Set(float32 x, float32 y, float32 z, float32 w)
+{
+    return _mm_setr_ps(x, y, z, w);
+}
+
+inline Float4 Set1(float32 v)
+{
+    return _mm_set1_ps(v);
+}
+
+inline float32 GetX(Float4 v)
+{
+    return _mm_cvtss_f32(v);
+}
+
+inline Float4 Add(Float4 a, Float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline Float4 Sub(Float4 a, Float4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline Float4 Mul(Float4 a, Float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+/** Return a < b ? a : b per component. */
+inline Float4 Min(Float4 a, Float4 b)
+{
+    return _mm_min_ps(a, b);
+}
+
+/** Return a > b ? a : b per component. */
+inline Float4 Max(Float4 a, Float4 b)
+{
+    return _mm_max_ps(a, b);
+}
+
+/** Return (v[X], v[Y], v[Z], v[W]). */
+template <int X, int Y, int Z, int W>
+inline Float4 Swizzle(Float4 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+/** Return (a[X], a[Y], b[Z], b[W]). */
+template <int X, int Y, int Z, int W>
+inline Float4 Shuffle(Float4 a, Float4 b)
+{
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+} // namespace SIMDMath
+} // namespace DAVA
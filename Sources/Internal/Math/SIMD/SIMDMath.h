@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+/**
+    \ingroup math
+    Vectorized implementation of core Matrix4, AABBox3 and Quaternion operations.
+
+    Backend is selected at build time:
+    - SSE2 on x86/x64 (also used in SSE4/AVX2 builds, 4x4 matrix ops don't benefit from wider registers);
+    - NEON on ARM if compiler targets NEON;
+    - scalar code of math classes is used if no backend is available or `DAVA_DISABLE_SIMD_MATH` is defined
+      (`DAVA_DISABLE_SIMD_MATH` cmake option).
+
+    When backend is available `__DAVAENGINE_SIMD_MATH__` is defined and math classes call functions below.
+    Multiplication, point and box transforms perform the same float operations in the same order as scalar code,
+    matrix inverse uses block-wise algorithm which matches scalar result within float tolerance.
+
+    All matrices are row-major 4x4 float arrays (`Matrix4::data`), points are packed xyz triples,
+    quaternions are xyzw. Pointers don't need to be aligned.
+*/
+
+#if !defined(DAVA_DISABLE_SIMD_MATH)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define __DAVAENGINE_SIMD_SSE__
+#define __DAVAENGINE_SIMD_MATH__
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define __DAVAENGINE_SIMD_NEON__
+#define __DAVAENGINE_SIMD_MATH__
+#endif
+#endif
+
+#if defined(__DAVAENGINE_SIMD_MATH__)
+
+#if defined(__DAVAENGINE_SIMD_SSE__)
+#include "Math/SIMD/SIMDFloat4SSE.h"
+#elif defined(__DAVAENGINE_SIMD_NEON__)
+#include "Math/SIMD/SIMDFloat4NEON.h"
+#endif
+
+namespace DAVA
+{
+namespace SIMDMath
+{
+/** out = a * b, `out` can be the same as `a` or `b`. */
+inline void Matrix4Mul(const float32* a, const float32* b, float32* out)
+{
+    Float4 b0 = Load(b);
+    Float4 b1 = Load(b + 4);
+    Float4 b2 = Load(b + 8);
+    Float4 b3 = Load(b + 12);
+
+    Float4 r[4];
+    for (int32 i = 0; i < 4; ++i)
+    {
+        const float32* row = a + i * 4;
+        Float4 res = Mul(Set1(row[0]), b0);
+        res = Add(res, Mul(Set1(row[1]), b1));
+        res = Add(res, Mul(Set1(row[2]), b2));
+        r[i] = Add(res, Mul(Set1(row[3]), b3));
+    }
+
+    Store(out, r[0]);
+    Store(out + 4, r[1]);
+    Store(out + 8, r[2]);
+    Store(out + 12, r[3]);
+}
+
+namespace Detail
+{
+// products of 2x2 matrices stored in Float4 as (m00, m01, m10, m11)
+inline Float4 Mat2Mul(Float4 a, Float4 b)
+{
+    return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+
+// adj(a) * b
+inline Float4 Mat2AdjMul(Float4 a, Float4 b)
+{
+    return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+}
+
+// a * adj(b)
+inline Float4 Mat2MulAdj(Float4 a, Float4 b)
+{
+    return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+} // namespace Detail
+
+/**
+    Calculate inverse of `m` using block-wise inversion of 2x2 sub-matrices.
+    Return false and leave `out` untouched if `m` is singular.
+*/
+inline bool Matrix4Inverse(const float32* m, float32* out)
+{
+    using namespace Detail;
+
+    Float4 r0 = Load(m);
+    Float4 r1 = Load(m + 4);
+    Float4 r2 = Load(m + 8);
+    Float4 r3 = Load(m + 12);
+
+    // sub-matrices | A B |
+    //              | C D |
+    Float4 A = Shuffle<0, 1, 0, 1>(r0, r1);
+    Float4 B = Shuffle<2, 3, 2, 3>(r0, r1);
+    Float4 C = Shuffle<0, 1, 0, 1>(r2, r3);
+    Float4 D = Shuffle<2, 3, 2, 3>(r2, r3);
+
+    // determinants of sub-matrices as (|A|, |B|, |C|, |D|)
+    Float4 detSub = Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                        Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+    Float4 detA = Swizzle<0, 0, 0, 0>(detSub);
+    Float4 detB = Swizzle<1, 1, 1, 1>(detSub);
+    Float4 detC = Swizzle<2, 2, 2, 2>(detSub);
+    Float4 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+    Float4 D_C = Mat2AdjMul(D, C);
+    Float4 A_B = Mat2AdjMul(A, B);
+
+    // adjugates of inverse blocks | X Y |
+    //                             | Z W |
+    Float4 X_ = Sub(Mul(detD, A), Mat2Mul(B, D_C));
+    Float4 W_ = Sub(Mul(detA, D), Mat2Mul(C, A_B));
+    Float4 Y_ = Sub(Mul(detB, C), Mat2MulAdj(D, A_B));
+    Float4 Z_ = Sub(Mul(detC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A|*|D| + |B|*|C| - tr((A#B)(D#C))
+    Float4 tr = Mul(A_B, Swizzle<0, 2, 1, 3>(D_C));
+    tr = Add(tr, Swizzle<2, 3, 0, 1>(tr));
+    tr = Add(tr, Swizzle<1, 0, 3, 2>(tr));
+    float32 det = GetX(Sub(Add(Mul(detA, detD), Mul(detB, detC)), tr));
+    if (det == 0.f)
+    {
+        return false;
+    }
+
+    float32 rdet = 1.f / det;
+    Float4 rdetSigned = Set(rdet, -rdet, -rdet, rdet);
+    X_ = Mul(X_, rdetSigned);
+    Y_ = Mul(Y_, rdetSigned);
+    Z_ = Mul(Z_, rdetSigned);
+    W_ = Mul(W_, rdetSigned);
+
+    // adjugate shuffle is combined with store shuffle
+    Store(out, Shuffle<3, 1, 3, 1>(X_, Y_));
+    Store(out + 4, Shuffle<2, 0, 2, 0>(X_, Y_));
+    Store(out + 8, Shuffle<3, 1, 3, 1>(Z_, W_));
+    Store(out + 12, Shuffle<2, 0, 2, 0>(Z_, W_));
+    return true;
+}
+
+/** Transform `count` points by matrix `m` (`point * m` with w = 1), `in` and `out` can be the same array. */
+inline void TransformPoints(const float32* m, const float32* in, float32* out, uint32 count)
+{
+    Float4 r0 = Load(m);
+    Float4 r1 = Load(m + 4);
+    Float4 r2 = Load(m + 8);
+    Float4 r3 = Load(m + 12);
+
+    float32 res[4];
+    for (uint32 i = 0; i < count; ++i, in += 3, out += 3)
+    {
+        Float4 p = Mul(Set1(in[0]), r0);
+        p = Add(p, Mul(Set1(in[1]), r1));
+        p = Add(p, Mul(Set1(in[2]), r2));
+        Store(res, Add(p, r3));
+
+        out[0] = res[0];
+        out[1] = res[1];
+        out[2] = res[2];
+    }
+}
+
+/** Calculate axis-aligned box which contains box (`min`, `max`) transformed by matrix `m`. */
+inline void TransformBox(const float32* m, const float32* min, const float32* max, float32* outMin, float32* outMax)
+{
+    Float4 resMin = Load(m + 12);
+    Float4 resMax = resMin;
+    for (int32 j = 0; j < 3; ++j)
+    {
+        Float4 row = Load(m + j * 4);
+        Float4 a = Mul(row, Set1(min[j]));
+        Float4 b = Mul(row, Set1(max[j]));
+
+        // select `a` for min and `b` for max only if a < b, same as scalar code
+        resMin = Add(resMin, Min(a, b));
+        resMax = Add(resMax, Max(b, a));
+    }
+
+    float32 res[4];
+    Store(res, resMin);
+    outMin[0] = res[0];
+    outMin[1] = res[1];
+    outMin[2] = res[2];
+
+    Store(res, resMax);
+    outMax[0] = res[0];
+    outMax[1] = res[1];
+    outMax[2] = res[2];
+}
+
+/** out = q1 * scale1 + q2 * scale2, used to interpolate quaternions. */
+inline void QuaternionBlend(const float32* q1, float32 scale1, const float32* q2, float32 scale2, float32* out)
+{
+    Store(out, Add(Mul(Set1(scale1), Load(q1)), Mul(Set1(scale2), Load(q2))));
+}
+} // namespace SIMDMath
+} // namespace DAVA
+
+#endif // defined(__DAVAENGINE_SIMD_MATH__)
@@ -149,6 +149,7 @@ MemoryManager::MemoryManager()
     RegisterAllocPoolName(ALLOC_POOL_LUA, "lua engine");
     RegisterAllocPoolName(ALLOC_POOL_SQLITE, "sqlite");
     RegisterAllocPoolName(ALLOC_POOL_PHYSICS, "physics");
+    RegisterAllocPoolName(ALLOC_POOL_FRAME_ARENA, "frame arena");
 }
 
 MemoryManager* MemoryManager::Instance()
@@ -1171,4 +1172,5 @@ ENUM_DECLARE(DAVA::ePredefAllocPools)
     ENUM_ADD_DESCR(DAVA::ALLOC_POOL_LUA, "ALLOC_POOL_LUA");
     ENUM_ADD_DESCR(DAVA::ALLOC_POOL_SQLITE, "ALLOC_POOL_SQLITE");
     ENUM_ADD_DESCR(DAVA::ALLOC_POOL_PHYSICS, "ALLOC_POOL_PHYSICS");
+    ENUM_ADD_DESCR(DAVA::ALLOC_POOL_FRAME_ARENA, "ALLOC_POOL_FRAME_ARENA");
 };
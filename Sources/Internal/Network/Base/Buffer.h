@@ -5,6 +5,8 @@
 #include "Base/Platform.h"
 #include <libuv/uv.h>
 
+#include <memory>
+
 namespace DAVA
 {
 namespace Net
@@ -52,6 +54,57 @@ inline Buffer CreateBuffer(const void* rawBuffer, std::size_t size)
 #endif
 }
 
+/*
+ Reference counted byte buffer which can be handed off to network without copying.
+ Network holds its own reference until data have been sent, so sender may drop its reference right after Send call.
+*/
+class SharedBuffer
+{
+public:
+    SharedBuffer() = default;
+    explicit SharedBuffer(size_t size);
+    SharedBuffer(const void* data, size_t size);
+    explicit SharedBuffer(Vector<uint8>&& data);
+
+    uint8* GetData() const;
+    size_t GetSize() const;
+    bool IsEmpty() const;
+
+private:
+    std::shared_ptr<Vector<uint8>> storage;
+};
+
+//////////////////////////////////////////////////////////////////////////
+inline SharedBuffer::SharedBuffer(size_t size)
+    : storage(std::make_shared<Vector<uint8>>(size))
+{
+}
+
+inline SharedBuffer::SharedBuffer(const void* data, size_t size)
+    : storage(std::make_shared<Vector<uint8>>(static_cast<const uint8*>(data), static_cast<const uint8*>(data) + size))
+{
+}
+
+inline SharedBuffer::SharedBuffer(Vector<uint8>&& data)
+    : storage(std::make_shared<Vector<uint8>>(std::move(data)))
+{
+}
+
+inline uint8* SharedBuffer::GetData() const
+{
+    return (storage != nullptr && !storage->empty()) ? storage->data() : nullptr;
+}
+
+inline size_t SharedBuffer::GetSize() const
+{
+    return storage != nullptr ? storage->size() : 0;
+}
+
+inline bool SharedBuffer::IsEmpty() const
+{
+    return GetSize() == 0;
+}
+
 } // namespace Net
 } // namespace DAVA
 
@@ -2,6 +2,7 @@
 
 #include "Base/BaseTypes.h"
 #include "Network/NetworkCommon.h"
+#include "Network/Base/Buffer.h"
 
 #include <memory>
 
@@ -24,7 +25,7 @@ struct IChannelListener
     virtual void OnChannelClosed(const std::shared_ptr<IChannel>& channel, const char8* message) = 0;
     // Some data arrived into channel
     virtual void OnPacketReceived(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) = 0;
-    // Buffer has been sent and can be reused or freed
+    // Buffer has been sent and can be reused or freed; not called for buffers sent as SharedBuffer, network releases them itself
     virtual void OnPacketSent(const std::shared_ptr<IChannel>& channel, const void* buffer, size_t length) = 0;
     // Data packet with given ID has been delivered to other side
     virtual void OnPacketDelivered(const std::shared_ptr<IChannel>& channel, uint32 packetId) = 0;
@@ -40,6 +41,8 @@ struct IChannel
     virtual ~IChannel();
 
     virtual bool Send(const void* data, size_t length, uint32 flags, uint32* packetId) = 0;
+    // Send data without copying, channel keeps reference to buffer until it has been sent
+    virtual bool Send(const SharedBuffer& buffer, uint32 flags, uint32* packetId) = 0;
     virtual const Endpoint& RemoteEndpoint() const = 0;
 };
 
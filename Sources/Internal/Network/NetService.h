@@ -42,6 +42,7 @@ public:
 
 protected:
     bool Send(const void* data, size_t length, uint32* packetId = NULL);
+    bool Send(const SharedBuffer& buffer, uint32* packetId = NULL);
     template <typename T>
     bool Send(const T* value, uint32* packetId = NULL);
 
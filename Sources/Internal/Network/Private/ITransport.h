@@ -33,6 +33,9 @@ struct IServerListener
 //////////////////////////////////////////////////////////////////////////
 struct IClientListener;
 
+// Maximum number of buffers which can be passed to IClientTransport::Send in one call
+const size_t MAX_TRANSPORT_SEND_BUFFERS = 32;
+
 struct IClientTransport
 {
     virtual ~IClientTransport();
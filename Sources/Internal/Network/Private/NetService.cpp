@@ -51,5 +51,13 @@ bool NetService::Send(const void* data, size_t length, uint32* packetId)
                              false;
 }
 
+bool NetService::Send(const SharedBuffer& buffer, uint32* packetId)
+{
+    DVASSERT(!buffer.IsEmpty() && true == IsChannelOpen());
+    return IsChannelOpen() ? channel->Send(buffer, 0, packetId)
+                             :
+                             false;
+}
+
 } // namespace Net
 } // namespace DAVA
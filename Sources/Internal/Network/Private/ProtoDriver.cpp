@@ -20,11 +20,9 @@ ProtoDriver::ProtoDriver(IOLoop* aLoop, eNetworkRole aRole, const ServiceRegistr
     , registrar(aRegistrar)
     , serviceContext(aServiceContext)
     , transport(NULL)
-    , whatIsSending()
     , pendingPong(false)
 {
     DVASSERT(loop != NULL);
-    Memset(&curPacket, 0, sizeof(curPacket));
 }
 
 ProtoDriver::~ProtoDriver()
@@ -56,32 +54,38 @@ void ProtoDriver::SendData(uint32 channelId, const void* buffer, size_t length,
     if (outPacketId != NULL)
         *outPacketId = packet.packetId;
 
-    // This method may be invoked from different threads
-    if (true == senderLock.TryLock())
-    {
-        // TODO: consider optimization when called from IOLoop's thread
-        curPacket = packet;
-        loop->Post(MakeFunction(this, &ProtoDriver::SendCurPacket));
-    }
-    else
-    {
-        EnqueuePacket(&packet);
-    }
+    PostPacket(&packet);
+}
+
+void ProtoDriver::SendData(uint32 channelId, const SharedBuffer& buffer, uint32* outPacketId)
+{
+    DVASSERT(transport != NULL && false == buffer.IsEmpty());
+
+    Packet packet;
+    PreparePacket(&packet, channelId, buffer.GetData(), buffer.GetSize());
+    packet.sharedData = buffer;
+    if (outPacketId != NULL)
+        *outPacketId = packet.packetId;
+
+    PostPacket(&packet);
 }
 
 void ProtoDriver::SendControl(uint32 code, uint32 channelId, uint32 packetId)
 {
     ProtoHeader header;
     proto.EncodeControlFrame(&header, code, channelId, packetId);
-    if (true == senderLock.TryLock()) // Control frame can be sent directly without queueing
-    {
-        curControl = header;
-        SendCurControl();
-    }
-    else
+
+    // No need for mutex locking as control frames are always sent from handlers.
+    // Frames are only queued here and sent by StartSending, so frames produced by one handler go in one write
+    controlQueue.push_back(header);
+}
+
+void ProtoDriver::StartSending()
+{
+    // Called from IOLoop's thread only
+    if (true == HasQueuedFrames() && true == senderLock.TryLock())
     {
-        // No need for mutex locking as control frames are always sent from handlers
-        controlQueue.push_back(header);
+        SendNextBatch();
     }
 }
 
@@ -119,6 +123,7 @@ void ProtoDriver::OnConnected(const Endpoint& endp)
                 SendControl(TYPE_CHANNEL_QUERY, channel->channelId, 0);
             }
         }
+        StartSending();
     }
 }
 
@@ -178,34 +183,23 @@ bool ProtoDriver::OnDataReceived(const void* buffer, size_t length)
         buffer = static_cast<const uint8*>(buffer) + result.decodedSize;
     } while (status != ProtoDecoder::DECODE_INVALID && true == canContinue && length > 0);
     canContinue = canContinue && (status != ProtoDecoder::DECODE_INVALID);
+    if (true == canContinue)
+    {
+        // Send acknowledgements and replies for all frames decoded from buffer at once
+        StartSending();
+    }
     return canContinue;
 }
 
 void ProtoDriver::OnSendComplete()
 {
-    if (SENDING_DATA_FRAME == whatIsSending)
+    for (Packet& packet : batchPackets)
     {
-        curPacket.sentLength += curPacket.chunkLength;
-        if (curPacket.sentLength == curPacket.dataLength)
-        {
-            std::shared_ptr<Channel> ch = GetChannel(curPacket.channelId);
-            ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
-            curPacket.data = NULL;
-        }
+        PacketSent(&packet);
     }
+    batchPackets.clear();
 
-    if (true == DequeueControl(&curControl)) // First send control packets if any
-    {
-        SendCurControl();
-    }
-    else if (curPacket.data != NULL || true == DequeuePacket(&curPacket)) // Send current packet further or send new packet
-    {
-        SendCurPacket();
-    }
-    else
-    {
-        senderLock.Unlock(); // Nothing to send, unlock sender
-    }
+    SendNextBatch(); // Send rest of current packet and everything queued meanwhile, or unlock sender
 }
 
 bool ProtoDriver::OnTimeout()
@@ -214,6 +208,7 @@ bool ProtoDriver::OnTimeout()
     {
         pendingPong = true;
         SendControl(TYPE_PING, 0, 0);
+        StartSending();
         return true;
     }
     return false;
@@ -312,47 +307,108 @@ bool ProtoDriver::ProcessDeliveryAck(ProtoDecoder::DecodeResult* result)
 
 void ProtoDriver::ClearQueues()
 {
+    for (Packet& packet : batchPackets)
+    {
+        PacketSent(&packet);
+    }
+    batchPackets.clear();
+
     if (curPacket.data != NULL)
     {
-        std::shared_ptr<Channel> ch = GetChannel(curPacket.channelId);
-        ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
+        PacketSent(&curPacket);
+        curPacket = Packet();
+    }
 
-        curPacket.data = NULL;
+    Deque<Packet> queue;
+    {
+        LockGuard<Mutex> lock(queueMutex);
+        queue.swap(dataQueue);
     }
-    for (Deque<Packet>::iterator i = dataQueue.begin(), e = dataQueue.end(); i != e; ++i)
+    for (Packet& packet : queue)
     {
-        Packet& packet = *i;
-        std::shared_ptr<Channel> ch = GetChannel(packet.channelId);
-        ch->service->OnPacketSent(ch, packet.data, packet.dataLength);
+        PacketSent(&packet);
     }
-    dataQueue.clear();
+
     pendingAckQueue.clear();
     controlQueue.clear();
     senderLock.Unlock();
 }
 
-void ProtoDriver::SendCurPacket()
+void ProtoDriver::SendNextBatch()
 {
-    DVASSERT(curPacket.sentLength < curPacket.dataLength);
+    DVASSERT(batchPackets.empty());
 
-    whatIsSending = SENDING_DATA_FRAME;
-    curPacket.chunkLength = proto.EncodeDataFrame(&header, curPacket.channelId, curPacket.packetId, curPacket.dataLength, curPacket.sentLength);
+    size_t frameCount = 0;
+    size_t bufferCount = 0;
+    size_t dataSize = 0;
+    uint32 startedPacketIds[MAX_BATCH_FRAMES];
+    size_t startedPacketCount = 0;
 
-    Buffer buffers[2];
-    buffers[0] = CreateBuffer(&header);
-    buffers[1] = CreateBuffer(curPacket.data + curPacket.sentLength, curPacket.chunkLength);
-    if (0 == transport->Send(buffers, 2) && 0 == curPacket.sentLength)
+    // Control frames go first: they are small and carry acknowledgements and pings
+    while (frameCount < MAX_BATCH_FRAMES && true == DequeueControl(&batchHeaders[frameCount]))
     {
-        pendingAckQueue.push_back(curPacket.packetId);
+        batchBuffers[bufferCount++] = CreateBuffer(&batchHeaders[frameCount]);
+        frameCount += 1;
+    }
+
+    // Data frames of different packets are not interleaved as other side assembles one packet at a time
+    while (frameCount < MAX_BATCH_FRAMES && dataSize < MAX_BATCH_DATA_SIZE)
+    {
+        if (NULL == curPacket.data && false == DequeuePacket(&curPacket))
+            break;
+
+        if (0 == curPacket.encodedLength)
+        {
+            startedPacketIds[startedPacketCount++] = curPacket.packetId;
+        }
+
+        ProtoHeader* header = &batchHeaders[frameCount];
+        size_t chunkLength = proto.EncodeDataFrame(header, curPacket.channelId, curPacket.packetId, curPacket.dataLength, curPacket.encodedLength);
+        batchBuffers[bufferCount++] = CreateBuffer(header);
+        batchBuffers[bufferCount++] = CreateBuffer(curPacket.data + curPacket.encodedLength, chunkLength);
+        curPacket.encodedLength += chunkLength;
+        dataSize += chunkLength;
+        frameCount += 1;
+
+        if (curPacket.encodedLength == curPacket.dataLength)
+        {
+            batchPackets.push_back(std::move(curPacket));
+            curPacket = Packet();
+        }
+    }
+
+    if (0 == frameCount)
+    {
+        senderLock.Unlock(); // Nothing to send, unlock sender
+
+        // Other thread may have queued packet after queue has been checked but before sender was unlocked
+        if (true == HasQueuedFrames() && true == senderLock.TryLock())
+        {
+            SendNextBatch();
+        }
+        return;
+    }
+
+    if (0 == transport->Send(batchBuffers, bufferCount))
+    {
+        pendingAckQueue.insert(pendingAckQueue.end(), startedPacketIds, startedPacketIds + startedPacketCount);
     }
 }
 
-void ProtoDriver::SendCurControl()
+void ProtoDriver::PacketSent(Packet* packet)
 {
-    whatIsSending = SENDING_CONTROL_FRAME;
+    // Shared buffer is owned by network, service must not get its raw pointer back as it may try to free it
+    if (false == packet->sharedData.IsEmpty())
+    {
+        packet->sharedData = SharedBuffer();
+        return;
+    }
 
-    Buffer buffer = CreateBuffer(&curControl);
-    transport->Send(&buffer, 1);
+    std::shared_ptr<Channel> ch = GetChannel(packet->channelId);
+    if (ch != NULL && ch->service != NULL)
+    {
+        ch->service->OnPacketSent(ch, packet->data, packet->dataLength);
+    }
 }
 
 void ProtoDriver::PreparePacket(Packet* packet, uint32 channelId, const void* buffer, size_t length)
@@ -364,18 +420,28 @@ void ProtoDriver::PreparePacket(Packet* packet, uint32 channelId, const void* bu
     packet->channelId = channelId;
     packet->packetId = ++nextPacketId;
     packet->dataLength = length;
-    packet->sentLength = 0;
-    packet->chunkLength = 0;
+    packet->encodedLength = 0;
     packet->data = static_cast<uint8*>(const_cast<void*>(buffer));
 }
 
+void ProtoDriver::PostPacket(Packet* packet)
+{
+    // This method may be invoked from different threads, so packet is always queued first.
+    // Packets queued before IOLoop gets to posted SendNextBatch are coalesced into the same write
+    EnqueuePacket(packet);
+    if (true == senderLock.TryLock())
+    {
+        loop->Post(MakeFunction(this, &ProtoDriver::SendNextBatch));
+    }
+}
+
 bool ProtoDriver::EnqueuePacket(Packet* packet)
 {
     bool queueWasEmpty = false;
 
     LockGuard<Mutex> lock(queueMutex);
     queueWasEmpty = dataQueue.empty();
-    dataQueue.push_back(*packet);
+    dataQueue.push_back(std::move(*packet));
     return queueWasEmpty;
 }
 
@@ -384,7 +450,7 @@ bool ProtoDriver::DequeuePacket(Packet* dest)
     LockGuard<Mutex> lock(queueMutex);
     if (false == dataQueue.empty())
     {
-        *dest = dataQueue.front();
+        *dest = std::move(dataQueue.front());
         dataQueue.pop_front();
         return true;
     }
@@ -403,5 +469,14 @@ bool ProtoDriver::DequeueControl(ProtoHeader* dest)
     return false;
 }
 
+bool ProtoDriver::HasQueuedFrames()
+{
+    if (false == controlQueue.empty())
+        return true;
+
+    LockGuard<Mutex> lock(queueMutex);
+    return false == dataQueue.empty();
+}
+
 } // namespace Net
 } // namespace DAVA
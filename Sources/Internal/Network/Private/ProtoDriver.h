@@ -5,6 +5,7 @@
 #include <Concurrency/Mutex.h>
 #include <Concurrency/Spinlock.h>
 
+#include <Network/Base/Buffer.h>
 #include <Network/Base/Endpoint.h>
 #include <Network/NetworkCommon.h>
 #include <Network/IChannel.h>
@@ -24,12 +25,12 @@ class ProtoDriver
 private:
     struct Packet
     {
-        uint32 channelId;
-        uint32 packetId;
+        uint32 channelId = 0;
+        uint32 packetId = 0;
         uint8* data = nullptr; // Data
-        size_t dataLength; //  and its length
-        size_t sentLength; // Number of bytes that have been already transfered
-        size_t chunkLength; // Number of bytes transfered during last operation
+        size_t dataLength = 0; //  and its length
+        size_t encodedLength = 0; // Number of bytes that have been already put into frames
+        SharedBuffer sharedData; // Keeps data alive while packet is being sent if it has been sent from shared buffer
     };
 
     struct Channel : public IChannel
@@ -38,6 +39,7 @@ private:
         ~Channel() override;
 
         bool Send(const void* data, size_t length, uint32 flags, uint32* packetId) override;
+        bool Send(const SharedBuffer& buffer, uint32 flags, uint32* packetId) override;
         const Endpoint& RemoteEndpoint() const override;
 
         bool confirmed; // Channel is confirmed by other side
@@ -47,11 +49,9 @@ private:
         IChannelListener* service = nullptr;
     };
 
-    enum eSendingFrameType
-    {
-        SENDING_DATA_FRAME = false,
-        SENDING_CONTROL_FRAME = true
-    };
+    // Limits for frames coalesced into one transport write
+    static const size_t MAX_BATCH_FRAMES = MAX_TRANSPORT_SEND_BUFFERS / 2;
+    static const size_t MAX_BATCH_DATA_SIZE = 256 * 1024;
 
 public:
     ProtoDriver(IOLoop* aLoop, eNetworkRole aRole, const ServiceRegistrar& aRegistrar, void* aServiceContext);
@@ -59,6 +59,7 @@ public:
 
     void SetTransport(IClientTransport* aTransport, const uint32* sourceChannels, size_t channelCount);
     void SendData(uint32 channelId, const void* buffer, size_t length, uint32* outPacketId);
+    void SendData(uint32 channelId, const SharedBuffer& buffer, uint32* outPacketId);
 
     void ReleaseServices();
 
@@ -71,6 +72,7 @@ public:
 private:
     std::shared_ptr<Channel>& GetChannel(uint32 channelId);
     void SendControl(uint32 code, uint32 channelId, uint32 packetId);
+    void StartSending();
 
     bool ProcessDataPacket(ProtoDecoder::DecodeResult* result);
     bool ProcessChannelQuery(ProtoDecoder::DecodeResult* result);
@@ -80,13 +82,15 @@ private:
 
     void ClearQueues();
 
-    void SendCurPacket();
-    void SendCurControl();
+    void SendNextBatch();
+    void PacketSent(Packet* packet);
 
     void PreparePacket(Packet* packet, uint32 channelId, const void* buffer, size_t length);
+    void PostPacket(Packet* packet);
     bool EnqueuePacket(Packet* packet);
     bool DequeuePacket(Packet* dest);
     bool DequeueControl(ProtoHeader* dest);
+    bool HasQueuedFrames();
 
 private:
     IOLoop* loop = nullptr;
@@ -98,18 +102,19 @@ private:
 
     Spinlock senderLock;
     Mutex queueMutex;
-    eSendingFrameType whatIsSending;
     bool pendingPong;
 
-    Packet curPacket;
+    Packet curPacket; // Packet which is being split into data frames, can span several batches
+    Vector<Packet> batchPackets; // Packets whose last frame is in the current batch
     Deque<Packet> dataQueue;
     Deque<uint32> pendingAckQueue;
-
-    ProtoHeader curControl;
     Deque<ProtoHeader> controlQueue;
 
+    // Frames of current batch, they are sent to transport by single vectored write
+    ProtoHeader batchHeaders[MAX_BATCH_FRAMES];
+    Buffer batchBuffers[MAX_BATCH_FRAMES * 2];
+
     ProtoDecoder proto;
-    ProtoHeader header;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -130,6 +135,15 @@ inline bool ProtoDriver::Channel::Send(const void* data, size_t length, uint32 f
     return true;
 }
 
+inline bool ProtoDriver::Channel::Send(const SharedBuffer& buffer, uint32 flags, uint32* outPacketId)
+{
+    if (driver != nullptr)
+    {
+        driver->SendData(channelId, buffer, outPacketId);
+    }
+    return true;
+}
+
 inline const Endpoint& ProtoDriver::Channel::RemoteEndpoint() const
 {
     return remoteEndpoint;
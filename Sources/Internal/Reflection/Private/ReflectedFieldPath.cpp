@@ -0,0 +1,102 @@
+#include "Reflection/ReflectedFieldPath.h"
+#include "Reflection/ReflectedTypeDB.h"
+
+namespace DAVA
+{
+ReflectedFieldPath::ReflectedFieldPath(const Reflection& root, const Vector<FastName>& path)
+{
+    if (!root.IsValid() || path.empty())
+    {
+        return;
+    }
+
+    ReflectedObject owner = root.valueWrapper->GetValueObject(root.object);
+    rootType = owner.GetReflectedType();
+
+    Reflection current = root;
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        ReflectedObject expectedOwner = current.valueWrapper->GetValueObject(current.object);
+        Reflection field = current.GetField(path[i]);
+
+        // fields of containers and custom structures don't keep owner object
+        // and can't be reached without structure wrapper lookup
+        if (!field.IsValid() || field.object != expectedOwner)
+        {
+            steps.clear();
+            rootType = nullptr;
+            return;
+        }
+
+        if (i > 0)
+        {
+            steps.push_back({ current.valueWrapper, expectedOwner.GetReflectedType() });
+        }
+
+        current = field;
+    }
+
+    steps.shrink_to_fit();
+    valueWrapper = current.valueWrapper;
+    meta = current.meta;
+    valueType = current.GetValueType();
+}
+
+ReflectedObject ReflectedFieldPath::GetFieldOwner(const Reflection& root) const
+{
+    if (nullptr == valueWrapper || !root.IsValid())
+    {
+        return ReflectedObject();
+    }
+
+    ReflectedObject owner = root.valueWrapper->GetValueObject(root.object);
+    if (owner.GetReflectedType() != rootType)
+    {
+        return ReflectedObject();
+    }
+
+    for (const Step& step : steps)
+    {
+        owner = step.valueWrapper->GetValueObject(owner);
+        if (!owner.IsValid() || owner.GetReflectedType() != step.ownerType)
+        {
+            return ReflectedObject();
+        }
+    }
+
+    return owner;
+}
+
+Reflection ReflectedFieldPath::GetField(const Reflection& root) const
+{
+    ReflectedObject owner = GetFieldOwner(root);
+    if (owner.IsValid())
+    {
+        return Reflection(owner, valueWrapper, nullptr, meta);
+    }
+
+    return Reflection();
+}
+
+Any ReflectedFieldPath::GetValue(const Reflection& root) const
+{
+    ReflectedObject owner = GetFieldOwner(root);
+    if (owner.IsValid())
+    {
+        return valueWrapper->GetValue(owner);
+    }
+
+    return Any();
+}
+
+bool ReflectedFieldPath::SetValue(const Reflection& root, const Any& value) const
+{
+    ReflectedObject owner = GetFieldOwner(root);
+    if (owner.IsValid())
+    {
+        return valueWrapper->SetValue(owner, value);
+    }
+
+    return false;
+}
+} // namespace DAVA
@@ -53,6 +53,32 @@ public:
         return ReflectedObject(ptr);
     }
 
+    inline bool GetValueTo(const ReflectedObject& object, const Type* type, void* out) const override
+    {
+        using ValueT = typename ValueWrapperDefault<T>::ValueT;
+
+        if (type == Type::Instance<ValueT>())
+        {
+            C* cls = object.GetPtr<C>();
+            return ValueWrapper::AssignValue(static_cast<ValueT*>(out), cls->*field);
+        }
+
+        return false;
+    }
+
+    inline bool SetValueFrom(const ReflectedObject& object, const Type* type, const void* in) const override
+    {
+        using ValueT = typename ValueWrapperDefault<T>::ValueT;
+
+        if (!object.IsConst() && type == Type::Instance<ValueT>())
+        {
+            C* cls = object.GetPtr<C>();
+            return ValueWrapperDefault<T>::SetValueFromInternal(&(cls->*field), in);
+        }
+
+        return false;
+    }
+
 protected:
     T C::*field;
 };
@@ -71,6 +71,33 @@ public:
         return false;
     }
 
+    bool GetValueTo(const ReflectedObject& object, const Type* type, void* out) const override
+    {
+        using ValueT = typename std::decay<GetT>::type;
+
+        if (type == Type::Instance<ValueT>())
+        {
+            C* cls = object.GetPtr<C>();
+            return AssignValue(static_cast<ValueT*>(out), getter(cls));
+        }
+
+        return false;
+    }
+
+    bool SetValueFrom(const ReflectedObject& object, const Type* type, const void* in) const override
+    {
+        using ValueT = typename std::decay<SetT>::type;
+
+        if (!IsReadonly(object) && type == Type::Instance<ValueT>())
+        {
+            C* cls = object.GetPtr<C>();
+            setter(cls, *static_cast<const ValueT*>(in));
+            return true;
+        }
+
+        return false;
+    }
+
     ReflectedObject GetValueObject(const ReflectedObject& object) const override
     {
         auto is_pointer = std::integral_constant<bool, std::is_pointer<GetT>::value>();
@@ -11,6 +11,7 @@ class ValueWrapperDefault : public ValueWrapper
 {
 public:
     static const bool isConst = std::is_const<T>::value;
+    using ValueT = typename std::remove_cv<T>::type;
 
     ValueWrapperDefault() = default;
 
@@ -60,12 +61,37 @@ public:
         return object;
     }
 
+    bool GetValueTo(const ReflectedObject& object, const Type* type, void* out) const override
+    {
+        if (type == Type::Instance<ValueT>())
+        {
+            return AssignValue(static_cast<ValueT*>(out), *object.GetPtr<const T>());
+        }
+
+        return false;
+    }
+
+    bool SetValueFrom(const ReflectedObject& object, const Type* type, const void* in) const override
+    {
+        if (!object.IsConst() && type == Type::Instance<ValueT>())
+        {
+            return SetValueFromInternal(object.GetPtr<T>(), in);
+        }
+
+        return false;
+    }
+
 protected:
     inline bool SetValueInternal(T* ptr, const Any& value) const
     {
         return SetValueInternalImpl<isConst>::fn(ptr, value);
     }
 
+    inline bool SetValueFromInternal(T* ptr, const void* in) const
+    {
+        return SetValueInternalImpl<isConst>::fn(ptr, in);
+    }
+
 private:
     template <bool isConst, typename U = void>
     struct SetValueInternalImpl
@@ -74,6 +100,11 @@ private:
         {
             return false;
         }
+
+        inline static bool fn(T* ptr, const void* in)
+        {
+            return false;
+        }
     };
 
     template <typename U>
@@ -84,6 +115,11 @@ private:
             *ptr = value.Get<T>();
             return true;
         }
+
+        inline static bool fn(T* ptr, const void* in)
+        {
+            return AssignValue(ptr, *static_cast<const T*>(in));
+        }
     };
 };
 } // namespace DAVA
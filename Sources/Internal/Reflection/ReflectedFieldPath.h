@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "Reflection/Reflection.h"
+
+namespace DAVA
+{
+class ReflectedType;
+
+/**
+    \ingroup reflection
+    Path to nested field of reflected structure, resolved once and reused for many objects of the same type.
+
+    `Reflection::GetField` looks field up by name and creates temporary Reflection on each step,
+    `ReflectedFieldPath` keeps value wrappers found on compilation and only walks through field owners on access.
+    Values are copied directly by value wrappers when requested type exactly matches field type,
+    otherwise they are passed through `Any`.
+
+    Only fields of reflected classes can be compiled into path, paths through containers are not supported
+    and `IsValid` returns false for them. Access to object which reflected type differs from the one
+    used for compilation fails.
+
+    ```
+    ReflectedFieldPath path(Reflection::Create(&obj), { FastName("transform"), FastName("position") });
+
+    Vector3 position;
+    for (auto& o : objects)
+    {
+        path.GetValue(Reflection::Create(&o), position);
+    }
+    ```
+*/
+class ReflectedFieldPath final
+{
+public:
+    ReflectedFieldPath() = default;
+    ReflectedFieldPath(const Reflection& root, const Vector<FastName>& path);
+
+    bool IsValid() const;
+    const Type* GetValueType() const;
+
+    /** Returns reflection of field for `root` object or invalid Reflection if `root` doesn't match the path */
+    Reflection GetField(const Reflection& root) const;
+
+    Any GetValue(const Reflection& root) const;
+    bool SetValue(const Reflection& root, const Any& value) const;
+
+    template <typename T>
+    bool GetValue(const Reflection& root, T& value) const;
+
+    template <typename T>
+    bool SetValue(const Reflection& root, const T& value) const;
+
+private:
+    struct Step
+    {
+        const ValueWrapper* valueWrapper;
+        const ReflectedType* ownerType; //!< expected type of object returned by `valueWrapper`
+    };
+
+    ReflectedObject GetFieldOwner(const Reflection& root) const;
+
+    const ReflectedType* rootType = nullptr;
+    Vector<Step> steps;
+    const ValueWrapper* valueWrapper = nullptr;
+    const ReflectedMeta* meta = nullptr;
+    const Type* valueType = nullptr;
+};
+
+inline bool ReflectedFieldPath::IsValid() const
+{
+    return (nullptr != valueWrapper);
+}
+
+inline const Type* ReflectedFieldPath::GetValueType() const
+{
+    return valueType;
+}
+
+template <typename T>
+bool ReflectedFieldPath::GetValue(const Reflection& root, T& value) const
+{
+    ReflectedObject owner = GetFieldOwner(root);
+    if (owner.IsValid())
+    {
+        if (valueWrapper->GetValueTo(owner, Type::Instance<T>(), &value))
+        {
+            return true;
+        }
+
+        Any v = valueWrapper->GetValue(owner);
+        if (v.CanGet<T>())
+        {
+            value = v.Get<T>();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+bool ReflectedFieldPath::SetValue(const Reflection& root, const T& value) const
+{
+    ReflectedObject owner = GetFieldOwner(root);
+    if (owner.IsValid())
+    {
+        if (valueWrapper->SetValueFrom(owner, Type::Instance<T>(), &value))
+        {
+            return true;
+        }
+
+        return valueWrapper->SetValue(owner, Any(value));
+    }
+
+    return false;
+}
+} // namespace DAVA
@@ -115,6 +115,8 @@ struct ReflectionBase : Type::Seed
 */
 class Reflection final
 {
+    friend class ReflectedFieldPath;
+
 public:
     struct Field;
     struct FieldCaps;
@@ -240,6 +242,45 @@ public:
     virtual bool SetValueWithCast(const ReflectedObject& object, const Any& value) const = 0;
 
     virtual ReflectedObject GetValueObject(const ReflectedObject& object) const = 0;
+
+    /**
+        Copy value to `out` without boxing it into Any, if value type is exactly `type`.
+        Returns false if wrapper doesn't support typed access, caller should use `GetValue` then.
+    */
+    virtual bool GetValueTo(const ReflectedObject& object, const Type* type, void* out) const
+    {
+        return false;
+    }
+
+    /**
+        Assign value from `in` without boxing it into Any, if value type is exactly `type`.
+        Returns false if wrapper doesn't support typed access or value is readonly.
+    */
+    virtual bool SetValueFrom(const ReflectedObject& object, const Type* type, const void* in) const
+    {
+        return false;
+    }
+
+protected:
+    template <typename T, typename V>
+    static bool AssignValue(T* out, V&& value)
+    {
+        return AssignValueImpl(out, std::forward<V>(value), std::is_copy_assignable<T>());
+    }
+
+private:
+    template <typename T, typename V>
+    static bool AssignValueImpl(T* out, V&& value, std::true_type)
+    {
+        *out = std::forward<V>(value);
+        return true;
+    }
+
+    template <typename T, typename V>
+    static bool AssignValueImpl(T* out, V&& value, std::false_type)
+    {
+        return false;
+    }
 };
 
 class EnumWrapper
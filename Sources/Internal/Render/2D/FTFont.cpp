@@ -1,4 +1,8 @@
 #include "Render/2D/FTFont.h"
+#include "Base/Hash.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/UniqueLock.h"
 #include "Debug/DVAssert.h"
 #include "Engine/Engine.h"
 #include "FileSystem/File.h"
@@ -6,6 +10,7 @@
 #include "FileSystem/LocalizationSystem.h"
 #include "FileSystem/YamlNode.h"
 #include "FileSystem/YamlParser.h"
+#include "Job/JobManager.h"
 #include "Logger/Logger.h"
 #include "Render/2D/FontManager.h"
 #include "Render/2D/Private/FTManager.h"
@@ -14,6 +19,8 @@
 #include "UI/UIControlSystem.h"
 #include "Utils/UTF8Utils.h"
 
+#include <atomic>
+
 namespace DAVA
 {
 #ifdef USE_FILEPATH_IN_MAP
@@ -40,6 +47,9 @@ public:
                                    float32 ascendScale, float32 descendScale,
                                    Vector<float32>* charSizes = NULL,
                                    bool contentScaleIncluded = false);
+    Font::StringMetrics GetStringMetrics(const WideString& str, float32 size, float32 ascendScale, float32 descendScale, Vector<float32>* charSizes);
+    void PrerasterizeString(const WideString& str, float32 size, float32 ascendScale, float32 descendScale);
+    static void WaitPrerasterizeJobs();
     uint32 GetFontHeight(float32 size, float32 ascendScale, float32 descendScale);
     bool IsCharAvaliable(char16 ch);
 
@@ -51,21 +61,81 @@ private:
     FilePath fontPath;
     FT_StreamRec stream;
 
-    struct Glyph
+    /** Glyph data required for string layout, box is calculated for zero pen position */
+    struct GlyphMetrics
     {
         FT_UInt index = 0;
-        FT_Glyph image = nullptr; /* the glyph image */
-        FT_Pos delta = 0; /* delta caused by hinting */
+        bool hasOutline = false;
+        FT_Vector advance = { 0, 0 }; // in 26.6 format
+        FT_BBox box = { 0, 0, 0, 0 }; // in 26.6 format
+    };
+
+    /** Rendered glyph for pen position inside of pixel, it is the same for all pixels */
+    struct GlyphBitmap
+    {
+        bool rendered = false;
+        int32 left = 0;
+        int32 top = 0;
+        int32 width = 0;
+        int32 height = 0;
+        Vector<uint8> data;
+    };
+
+    struct StringMetricsKey
+    {
+        WideString str;
+        uint32 size = 0;
+        float32 ascendScale = 1.f;
+        float32 descendScale = 1.f;
+        bool drawNondefGlyph = false;
 
-        bool operator<(const Glyph& right) const
+        bool operator==(const StringMetricsKey& other) const
         {
-            return image < right.image;
-        };
+            return size == other.size && ascendScale == other.ascendScale && descendScale == other.descendScale && drawNondefGlyph == other.drawNondefGlyph && str == other.str;
+        }
     };
-    Vector<Glyph> glyphs;
+
+    struct StringMetricsKeyHash
+    {
+        std::size_t operator()(const StringMetricsKey& key) const
+        {
+            std::size_t seed = HashValue_N(reinterpret_cast<const char*>(key.str.data()), static_cast<uint32>(key.str.size() * sizeof(WideString::value_type)));
+            HashCombine(seed, key.size);
+            HashCombine(seed, key.ascendScale);
+            HashCombine(seed, key.descendScale);
+            return seed;
+        }
+    };
+
+    /** Measured string in physical pixels */
+    struct StringMetricsEntry
+    {
+        Font::StringMetrics metrics;
+        Vector<float32> charSizes;
+    };
+
+    // Caches are shared by all fonts created from the same file and accessed under drawStringMutex
+    UnorderedMap<uint64, GlyphMetrics> glyphMetricsCache;
+    UnorderedMap<uint64, GlyphBitmap> glyphBitmapsCache;
+    UnorderedMap<StringMetricsKey, StringMetricsEntry, StringMetricsKeyHash> stringMetricsCache;
+    uint32 glyphBitmapsCacheBytes = 0;
+
+    Vector<GlyphMetrics> glyphs;
 
     bool initialized = false;
 
+    bool DrawStringPhysical(const WideString& str, uint8* buffer, int32 bufWidth, int32 bufHeight,
+                            float32 size, bool realDraw, bool drawNondefGlyph,
+                            int32 offsetX, int32 offsetY,
+                            int32 justifyWidth, int32 spaceAddon,
+                            float32 ascendScale, float32 descendScale,
+                            Font::StringMetrics& metrics, Vector<float32>* charSizes);
+    const StringMetricsEntry* GetStringMetricsEntry(const StringMetricsKey& key, float32 size);
+    const GlyphMetrics& GetGlyphMetrics(float32 size, char16 ch);
+    const GlyphBitmap& GetGlyphBitmap(float32 size, const GlyphMetrics& glyph, const FT_Vector& pen);
+    void TrimGlyphCaches();
+    void PrerasterizeGlyphs(const StringMetricsKey& key, float32 size);
+
     void ClearString();
     int32 LoadString(float32 size, const WideString& str);
     void Prepare(FT_Face face, FT_Vector* advances);
@@ -74,12 +144,23 @@ private:
     inline int32 FtCeil(int32 val);
 
     static Mutex drawStringMutex;
+    static Mutex prerasterizeJobsMutex;
+    static ConditionVariable prerasterizeJobsFinished;
+    static std::atomic<uint32> prerasterizeJobsCount;
     static const int32 ftToPixelShift; // Int value for shift to convert FT point to pixel
     static const float32 ftToPixelScale; // Float value to convert FT point to pixel
+    static const uint32 maxGlyphMetricsCount;
+    static const uint32 maxGlyphBitmapsBytes;
+    static const uint32 maxStringMetricsCount;
+    static const uint32 maxPrerasterizeJobsCount;
 };
 
 const int32 FTInternalFont::ftToPixelShift = 6;
 const float32 FTInternalFont::ftToPixelScale = 1.f / 64.f;
+const uint32 FTInternalFont::maxGlyphMetricsCount = 16384;
+const uint32 FTInternalFont::maxGlyphBitmapsBytes = 4 * 1024 * 1024;
+const uint32 FTInternalFont::maxStringMetricsCount = 512;
+const uint32 FTInternalFont::maxPrerasterizeJobsCount = 4;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -99,6 +180,43 @@ void StreamClose(FT_Stream stream)
     File* file = reinterpret_cast<File*>(stream->descriptor.pointer);
     SafeRelease(file);
 }
+
+/** Size in 26.6 format floored to integer pixels, the same as used by FTManager */
+uint32 GetSizeKey(float32 size)
+{
+    return static_cast<FT_UInt>(size * 64.f) & -64;
+}
+
+FT_Pos PixFloor(FT_Pos val)
+{
+    return (val & -64) >> 6;
+}
+
+FT_Pos PixCeil(FT_Pos val)
+{
+    return ((val + 63) & -64) >> 6;
+}
+
+void ConvertMetricsToVirtual(Font::StringMetrics& metrics)
+{
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    metrics.drawRect.x = int32(std::floor(vcs->ConvertPhysicalToVirtualX(float32(metrics.drawRect.x))));
+    metrics.drawRect.y = int32(std::floor(vcs->ConvertPhysicalToVirtualY(float32(metrics.drawRect.y))));
+    metrics.drawRect.dx = int32(std::ceil(vcs->ConvertPhysicalToVirtualX(float32(metrics.drawRect.dx))));
+    metrics.drawRect.dy = int32(std::ceil(vcs->ConvertPhysicalToVirtualY(float32(metrics.drawRect.dy))));
+    metrics.baseline = vcs->ConvertPhysicalToVirtualX(metrics.baseline);
+    metrics.height = vcs->ConvertPhysicalToVirtualY(metrics.height);
+    metrics.width = vcs->ConvertPhysicalToVirtualX(metrics.width);
+}
+
+void ConvertCharSizesToVirtual(Vector<float32>& charSizes)
+{
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    for (float32& charSize : charSizes)
+    {
+        charSize = vcs->ConvertPhysicalToVirtualX(charSize);
+    }
+}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -138,6 +256,9 @@ FTFont* FTFont::Create(const FilePath& path)
 
 void FTFont::ClearCache()
 {
+    // Prerasterization jobs keep fonts alive and use FreeType manager
+    WaitPrerasterizeJobs();
+
     while (fontMap.size())
     {
         SafeRelease(fontMap.begin()->second);
@@ -192,7 +313,17 @@ Font::StringMetrics FTFont::GetStringMetrics(float32 size, const WideString& str
     {
         charSizes->clear();
     }
-    return internalFont->DrawString(str, 0, 0, 0, 0, 0, 0, 0, size, false, 0, 0, 0, 0, ascendScale, descendScale, charSizes);
+    return internalFont->GetStringMetrics(str, size, ascendScale, descendScale, charSizes);
+}
+
+void FTFont::PrerasterizeString(float32 size, const WideString& str) const
+{
+    internalFont->PrerasterizeString(str, size, ascendScale, descendScale);
+}
+
+void FTFont::WaitPrerasterizeJobs()
+{
+    FTInternalFont::WaitPrerasterizeJobs();
 }
 
 uint32 FTFont::GetFontHeight(float32 size) const
@@ -245,6 +376,9 @@ DAVA::float32 FTFont::GetDescendScale() const
 ////////////////////////////////////////////////////////////////////////////////
 
 Mutex FTInternalFont::drawStringMutex;
+Mutex FTInternalFont::prerasterizeJobsMutex;
+ConditionVariable FTInternalFont::prerasterizeJobsFinished;
+std::atomic<uint32> FTInternalFont::prerasterizeJobsCount{ 0 };
 
 /**
  /brief Wrap around FT_MulFix, because this function is written in assembler and
@@ -268,6 +402,7 @@ FTInternalFont::FTInternalFont(const FilePath& path)
     ftm = GetEngineContext()->fontManager->GetFT();
     DVASSERT(ftm);
 
+    LockGuard<Mutex> lock(drawStringMutex);
     FT_Face face = nullptr;
     FT_Error error = ftm->LookupFace(this, &face);
     initialized = (error == FT_Err_Ok && face != nullptr);
@@ -275,6 +410,7 @@ FTInternalFont::FTInternalFont(const FilePath& path)
 
 FTInternalFont::~FTInternalFont()
 {
+    LockGuard<Mutex> lock(drawStringMutex);
     ClearString();
     ftm->RemoveFace(this);
 }
@@ -346,8 +482,6 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
         return Font::StringMetrics();
     }
 
-    drawStringMutex.Lock();
-
     bool drawNondefGlyph = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DRAW_NONDEF_GLYPH);
 
     size = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size); // increase size for high dpi screens
@@ -359,15 +493,214 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
         offsetX = int32(GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalX(float32(offsetX)));
     }
 
+    Font::StringMetrics metrics;
+    {
+        LockGuard<Mutex> lock(drawStringMutex);
+        if (!DrawStringPhysical(str, static_cast<uint8*>(buffer), bufWidth, bufHeight, size, realDraw, drawNondefGlyph, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, metrics, charSizes))
+        {
+            return Font::StringMetrics();
+        }
+    }
+
+    if (charSizes)
+    {
+        FTFontDetails::ConvertCharSizesToVirtual(*charSizes);
+    }
+    if (!contentScaleIncluded)
+    {
+        FTFontDetails::ConvertMetricsToVirtual(metrics);
+    }
+    return metrics;
+}
+
+Font::StringMetrics FTInternalFont::GetStringMetrics(const WideString& str, float32 size, float32 ascendScale, float32 descendScale, Vector<float32>* charSizes)
+{
+    if (!initialized)
+    {
+        if (charSizes)
+        {
+            charSizes->assign(str.length(), 0.f);
+        }
+        return Font::StringMetrics();
+    }
+
+    size = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size); // increase size for high dpi screens
+
+    StringMetricsKey key;
+    key.str = str;
+    key.size = FTFontDetails::GetSizeKey(size);
+    key.ascendScale = ascendScale;
+    key.descendScale = descendScale;
+    key.drawNondefGlyph = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DRAW_NONDEF_GLYPH);
+
+    Font::StringMetrics metrics;
+    {
+        LockGuard<Mutex> lock(drawStringMutex);
+        const StringMetricsEntry* entry = GetStringMetricsEntry(key, size);
+        if (entry == nullptr)
+        {
+            return Font::StringMetrics();
+        }
+
+        metrics = entry->metrics;
+        if (charSizes)
+        {
+            *charSizes = entry->charSizes;
+        }
+    }
+
+    if (charSizes)
+    {
+        FTFontDetails::ConvertCharSizesToVirtual(*charSizes);
+    }
+    FTFontDetails::ConvertMetricsToVirtual(metrics);
+    return metrics;
+}
+
+void FTInternalFont::PrerasterizeString(const WideString& str, float32 size, float32 ascendScale, float32 descendScale)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (!initialized || str.empty() || jobManager == nullptr)
+    {
+        return;
+    }
+
+    // Prerasterization is only a hint, so strings are dropped instead of queueing behind already scheduled ones
+    if (prerasterizeJobsCount.fetch_add(1) >= maxPrerasterizeJobsCount)
+    {
+        --prerasterizeJobsCount;
+        return;
+    }
+
+    // UI state is read here, so job works only with physical values
+    StringMetricsKey key;
+    key.str = str;
+    key.ascendScale = ascendScale;
+    key.descendScale = descendScale;
+    key.drawNondefGlyph = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DRAW_NONDEF_GLYPH);
+    float32 physicalSize = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size);
+    key.size = FTFontDetails::GetSizeKey(physicalSize);
+
+    FTInternalFont* font = SafeRetain(this);
+    jobManager->CreateWorkerJob([font, key, physicalSize]() {
+        font->PrerasterizeGlyphs(key, physicalSize);
+
+        {
+            // All glyphs are cached at this point, so only layout is done under lock
+            LockGuard<Mutex> lock(drawStringMutex);
+            font->GetStringMetricsEntry(key, physicalSize);
+        }
+
+        // Font is released before job is counted as finished, so waiting thread may release FreeType manager
+        font->Release();
+        {
+            LockGuard<Mutex> lock(prerasterizeJobsMutex);
+            --prerasterizeJobsCount;
+        }
+        prerasterizeJobsFinished.NotifyAll();
+    });
+}
+
+void FTInternalFont::WaitPrerasterizeJobs()
+{
+    UniqueLock<Mutex> lock(prerasterizeJobsMutex);
+    prerasterizeJobsFinished.Wait(lock, []() { return prerasterizeJobsCount == 0; });
+}
+
+void FTInternalFont::PrerasterizeGlyphs(const StringMetricsKey& key, float32 size)
+{
+    // Pen is moved the same way as in DrawStringPhysical without justify, so bitmaps are rendered for the same subpixel positions.
+    // Glyph bitmaps depend only on pen position inside of pixel, so they are the same for any integer draw offset.
+    FT_Vector pen = { 0, 0 };
+    FT_Vector prevAdvance = { 0, 0 };
+    FT_UInt prevIndex = 0;
+    bool prevDrawn = false;
+
+    for (size_t i = 0; i < key.str.size(); ++i)
+    {
+        // Lock is taken per glyph, so measuring on main thread never waits for whole string
+        LockGuard<Mutex> lock(drawStringMutex);
+
+        FT_Size ft_size = nullptr;
+        if (ftm->LookupSize(this, size, &ft_size) != FT_Err_Ok)
+        {
+            return;
+        }
+
+        // Glyphs are copied and not kept between iterations, so caches can be trimmed at any glyph
+        TrimGlyphCaches();
+
+        if (i == 0)
+        {
+            pen.y = -FT_Pos(FT_MulFix_Wrapper(ft_size->face->bbox.yMin, ft_size->metrics.y_scale) * key.descendScale);
+        }
+
+        GlyphMetrics glyph = GetGlyphMetrics(size, key.str[i]);
+
+        // Kerning is added to advance of previous glyph, which moves pen only when that glyph is drawn
+        if (prevDrawn)
+        {
+            if (FT_HAS_KERNING(ft_size->face) > 0)
+            {
+                FT_Vector kern;
+                FT_Get_Kerning(ft_size->face, prevIndex, glyph.index, FT_KERNING_UNFITTED, &kern);
+                prevAdvance.x += kern.x;
+                prevAdvance.y += kern.y;
+            }
+            pen.x += prevAdvance.x;
+            pen.y += prevAdvance.y;
+        }
+
+        prevDrawn = false;
+        if (glyph.hasOutline && (glyph.index != 0 || key.drawNondefGlyph))
+        {
+            prevDrawn = GetGlyphBitmap(size, glyph, pen).rendered;
+        }
+        prevAdvance = glyph.advance;
+        prevIndex = glyph.index;
+    }
+}
+
+const FTInternalFont::StringMetricsEntry* FTInternalFont::GetStringMetricsEntry(const StringMetricsKey& key, float32 size)
+{
+    auto it = stringMetricsCache.find(key);
+    if (it != stringMetricsCache.end())
+    {
+        return &it->second;
+    }
+
+    StringMetricsEntry entry;
+    if (!DrawStringPhysical(key.str, nullptr, 0, 0, size, false, key.drawNondefGlyph, 0, 0, 0, 0, key.ascendScale, key.descendScale, entry.metrics, &entry.charSizes))
+    {
+        return nullptr;
+    }
+
+    if (stringMetricsCache.size() >= maxStringMetricsCount)
+    {
+        stringMetricsCache.clear();
+    }
+    return &stringMetricsCache.emplace(key, std::move(entry)).first->second;
+}
+
+bool FTInternalFont::DrawStringPhysical(const WideString& str, uint8* buffer, int32 bufWidth, int32 bufHeight,
+                                        float32 size, bool realDraw, bool drawNondefGlyph,
+                                        int32 offsetX, int32 offsetY,
+                                        int32 justifyWidth, int32 spaceAddon,
+                                        float32 ascendScale, float32 descendScale,
+                                        Font::StringMetrics& metrics, Vector<float32>* charSizes)
+{
     FT_Size ft_size = nullptr;
     FT_Error error = ftm->LookupSize(this, size, &ft_size);
 
     if (error != FT_Err_Ok)
     {
         Logger::Error("[FTInternalFont::DrawString] LookupSize error %d", error);
-        return Font::StringMetrics();
+        return false;
     }
 
+    // Glyphs of current string refer to cached bitmaps, so caches are trimmed only before string processing
+    TrimGlyphCaches();
+
     int32 faceBboxYMin = int32(FT_MulFix_Wrapper(ft_size->face->bbox.yMin, ft_size->metrics.y_scale) * descendScale); // draw offset
     int32 faceBboxYMax = int32(FT_MulFix_Wrapper(ft_size->face->bbox.yMax, ft_size->metrics.y_scale) * ascendScale); // baseline
 
@@ -378,8 +711,8 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
 
     int32 countSpace = LoadString(size, str);
     uint32 strLen = uint32(str.length());
-    FT_Vector* advances = new FT_Vector[strLen];
-    Prepare(ft_size->face, advances);
+    Vector<FT_Vector> advances(strLen);
+    Prepare(ft_size->face, advances.data());
 
     float32 baseSize = (faceBboxYMax - faceBboxYMin) * ftToPixelScale;
     int32 multilineOffsetY = int32(std::ceil(baseSize)) + offsetY * 2;
@@ -393,7 +726,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
         fixJustifyOffset = diff - justifyOffset * countSpace;
     }
 
-    Font::StringMetrics metrics;
+    metrics = Font::StringMetrics();
     metrics.baseline = faceBboxYMax * ftToPixelScale;
     metrics.height = baseSize;
     metrics.drawRect = Rect2i(0x7fffffff, 0x7fffffff, 0, int32(std::ceil(baseSize))); // Setup rect with maximum int32 value for x/y, and zero width
@@ -402,41 +735,39 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
 
     for (uint32 i = 0; i < strLen; ++i)
     {
-        Glyph& glyph = glyphs[i];
-        FT_Glyph image = nullptr;
+        const GlyphMetrics& glyph = glyphs[i];
+        const GlyphBitmap* bitmap = nullptr;
         FT_BBox bbox;
 
         bool skipGlyph = true;
-        if (glyph.image && (glyph.index != 0 || drawNondefGlyph))
+        if (glyph.hasOutline && (glyph.index != 0 || drawNondefGlyph))
         {
-            error = FT_Glyph_Copy(glyph.image, &image);
-            if (error == 0)
+            // Make justify offsets only for visible glyphs
+            if (i > 0 && (justifyOffset > 0 || fixJustifyOffset > 0))
             {
-                // Make justify offsets only for visible glyphs
-                if (i > 0 && (justifyOffset > 0 || fixJustifyOffset > 0))
+                if (str[i - 1] == L' ')
                 {
-                    if (str[i - 1] == L' ')
-                    {
-                        advances[i].x += justifyOffset << ftToPixelShift; //Increase advance of character
-                    }
-                    if (fixJustifyOffset > 0)
-                    {
-                        fixJustifyOffset--;
-                        advances[i].x += 1 << ftToPixelShift; //Increase advance of character
-                    }
+                    advances[i].x += justifyOffset << ftToPixelShift; //Increase advance of character
                 }
-
-                error = FT_Glyph_Transform(image, nullptr, &pen);
-                if (error == 0)
+                if (fixJustifyOffset > 0)
                 {
-                    FT_Glyph_Get_CBox(image, FT_GLYPH_BBOX_PIXELS, &bbox);
-                    if (realDraw)
-                    {
-                        error = FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1);
-                    }
+                    fixJustifyOffset--;
+                    advances[i].x += 1 << ftToPixelShift; //Increase advance of character
                 }
             }
-            skipGlyph = error != 0;
+
+            // Box of outline moved to pen position in pixels
+            bbox.xMin = FTFontDetails::PixFloor(glyph.box.xMin + pen.x);
+            bbox.yMin = FTFontDetails::PixFloor(glyph.box.yMin + pen.y);
+            bbox.xMax = FTFontDetails::PixCeil(glyph.box.xMax + pen.x);
+            bbox.yMax = FTFontDetails::PixCeil(glyph.box.yMax + pen.y);
+
+            skipGlyph = false;
+            if (realDraw)
+            {
+                bitmap = &GetGlyphBitmap(size, glyph, pen);
+                skipGlyph = !bitmap->rendered;
+            }
         }
 
         if (skipGlyph)
@@ -451,9 +782,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
         {
             if (charSizes)
             {
-                float32 charSize = float32(advances[i].x) * ftToPixelScale; // Convert to pixels
-                charSize = GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualX(charSize); // Convert to virtual space
-                charSizes->push_back(charSize);
+                charSizes->push_back(float32(advances[i].x) * ftToPixelScale); // Convert to pixels
             }
 
             layoutWidth += advances[i].x;
@@ -482,22 +811,20 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 metrics.drawRect.dy = Max(metrics.drawRect.dy, top + height);
             }
 
-            if (realDraw && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
+            // Buffer is null when bitmaps are only rendered into cache
+            if (realDraw && buffer != nullptr && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
             {
-                FT_BitmapGlyph bit = FT_BitmapGlyph(image);
-                FT_Bitmap* bitmap = &bit->bitmap;
-
                 if (glyph.index > 0)
                 {
-                    left = bit->left;
-                    top = multilineOffsetY - bit->top;
+                    left = bitmap->left + int32(pen.x >> ftToPixelShift);
+                    top = multilineOffsetY - (bitmap->top + int32(pen.y >> ftToPixelShift));
                     width = bitmap->width;
-                    height = bitmap->rows;
+                    height = bitmap->height;
                 }
 
                 if (top >= 0 && left >= 0)
                 {
-                    uint8* resultBuf = static_cast<uint8*>(buffer);
+                    uint8* resultBuf = buffer;
                     int32 realH = Min(height, bufHeight - top);
                     int32 realW = Min(width, bufWidth - left);
                     int32 ind = top * bufWidth + left;
@@ -520,7 +847,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                     }
                     else
                     {
-                        uint8* readBuf = bitmap->buffer;
+                        const uint8* readBuf = bitmap->data.data();
                         for (int32 h = 0; h < realH; h++)
                         {
                             for (int32 w = 0; w < realW; w++)
@@ -543,16 +870,8 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
             pen.x += advances[i].x;
             pen.y += advances[i].y;
         }
-
-        if (image)
-        {
-            FT_Done_Glyph(image);
-        }
     }
 
-    SafeDeleteArray(advances);
-    drawStringMutex.Unlock();
-
     if (metrics.drawRect.x == 0x7fffffff || metrics.drawRect.y == 0x7fffffff) // Empty string
     {
         metrics.drawRect.x = 0;
@@ -564,23 +883,99 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
     metrics.drawRect.dy += -metrics.drawRect.y + 1;
 
     // Transform width from FT points to pixels
-    float32 totalWidth = float32(layoutWidth) * ftToPixelScale;
+    metrics.width = float32(layoutWidth) * ftToPixelScale;
+    return true;
+}
 
-    if (!contentScaleIncluded)
+const FTInternalFont::GlyphMetrics& FTInternalFont::GetGlyphMetrics(float32 size, char16 ch)
+{
+    uint64 key = (uint64(FTFontDetails::GetSizeKey(size)) << 32) | uint64(ch);
+    auto it = glyphMetricsCache.find(key);
+    if (it != glyphMetricsCache.end())
+    {
+        return it->second;
+    }
+
+    GlyphMetrics glyph;
+    glyph.index = ftm->LookupGlyphIndex(this, ch);
+
+    FT_Glyph image = nullptr;
+    FT_Error error = ftm->LookupGlyph(this, size, glyph.index, &image);
+    if (error == FT_Err_Ok && image != nullptr)
     {
-        metrics.drawRect.x = int32(std::floor(GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualX(float32(metrics.drawRect.x))));
-        metrics.drawRect.y = int32(std::floor(GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualY(float32(metrics.drawRect.y))));
-        metrics.drawRect.dx = int32(std::ceil(GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualX(float32(metrics.drawRect.dx))));
-        metrics.drawRect.dy = int32(std::ceil(GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualY(float32(metrics.drawRect.dy))));
-        metrics.baseline = GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualX(metrics.baseline);
-        metrics.height = GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualY(metrics.height);
-        metrics.width = GetEngineContext()->uiControlSystem->vcs->ConvertPhysicalToVirtualX(totalWidth);
+        glyph.advance.x = image->advance.x >> 10; // Translate advances in
+        glyph.advance.y = image->advance.y >> 10; // 16.16 to 26.6 format
+
+        // Only outlines can be moved to pen position
+        glyph.hasOutline = (image->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (glyph.hasOutline)
+        {
+            FT_Glyph_Get_CBox(image, FT_GLYPH_BBOX_SUBPIXELS, &glyph.box);
+        }
     }
     else
     {
-        metrics.width = totalWidth;
+#if defined(__DAVAENGINE_DEBUG__)
+        Logger::Warning("[FTInternalFont::GetGlyphMetrics] LookupGlyph error %d, char = %u", error, uint32(ch));
+#endif //__DAVAENGINE_DEBUG__
+    }
+
+    return glyphMetricsCache.emplace(key, glyph).first->second;
+}
+
+const FTInternalFont::GlyphBitmap& FTInternalFont::GetGlyphBitmap(float32 size, const GlyphMetrics& glyph, const FT_Vector& pen)
+{
+    FT_Vector subpixelPen = { pen.x & 63, pen.y & 63 };
+    uint64 key = (uint64(FTFontDetails::GetSizeKey(size)) << 44) | (uint64(glyph.index) << 12) | (uint64(subpixelPen.x) << 6) | uint64(subpixelPen.y);
+    auto it = glyphBitmapsCache.find(key);
+    if (it != glyphBitmapsCache.end())
+    {
+        return it->second;
+    }
+
+    GlyphBitmap bitmap;
+    FT_Glyph image = nullptr;
+    if (ftm->LookupGlyph(this, size, glyph.index, &image) == FT_Err_Ok && image != nullptr)
+    {
+        // Cached glyph is owned by FreeType cache, so it is rendered from copy
+        FT_Glyph renderedImage = nullptr;
+        if (FT_Glyph_Copy(image, &renderedImage) == 0)
+        {
+            if (FT_Glyph_Transform(renderedImage, nullptr, &subpixelPen) == 0 && FT_Glyph_To_Bitmap(&renderedImage, FT_RENDER_MODE_NORMAL, 0, 1) == 0)
+            {
+                FT_BitmapGlyph bitmapGlyph = FT_BitmapGlyph(renderedImage);
+                const FT_Bitmap& ftBitmap = bitmapGlyph->bitmap;
+
+                bitmap.rendered = true;
+                bitmap.left = bitmapGlyph->left;
+                bitmap.top = bitmapGlyph->top;
+                bitmap.width = int32(ftBitmap.width);
+                bitmap.height = int32(ftBitmap.rows);
+                bitmap.data.resize(bitmap.width * bitmap.height);
+                for (int32 row = 0; row < bitmap.height; ++row)
+                {
+                    Memcpy(bitmap.data.data() + row * bitmap.width, ftBitmap.buffer + row * ftBitmap.pitch, bitmap.width);
+                }
+            }
+            FT_Done_Glyph(renderedImage);
+        }
+    }
+
+    glyphBitmapsCacheBytes += uint32(sizeof(GlyphBitmap) + bitmap.data.size());
+    return glyphBitmapsCache.emplace(key, std::move(bitmap)).first->second;
+}
+
+void FTInternalFont::TrimGlyphCaches()
+{
+    if (glyphMetricsCache.size() > maxGlyphMetricsCount)
+    {
+        glyphMetricsCache.clear();
+    }
+    if (glyphBitmapsCacheBytes > maxGlyphBitmapsBytes)
+    {
+        glyphBitmapsCache.clear();
+        glyphBitmapsCacheBytes = 0;
     }
-    return metrics;
 }
 
 bool FTInternalFont::IsCharAvaliable(char16 ch)
@@ -590,6 +985,7 @@ bool FTInternalFont::IsCharAvaliable(char16 ch)
         return false;
     }
 
+    LockGuard<Mutex> lock(drawStringMutex);
     uint32 index = ftm->LookupGlyphIndex(this, ch);
     return index != 0;
 }
@@ -602,6 +998,7 @@ uint32 FTInternalFont::GetFontHeight(float32 size, float32 ascendScale, float32
     }
 
     size = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size); // increase size for high dpi screens
+    LockGuard<Mutex> lock(drawStringMutex);
     FT_Size ft_size = nullptr;
     if (ftm->LookupSize(this, size, &ft_size) == FT_Err_Ok)
     {
@@ -627,11 +1024,9 @@ void FTInternalFont::Prepare(FT_Face face, FT_Vector* advances)
 
     for (uint32 i = 0; i < size; ++i)
     {
-        Glyph& glyph = glyphs[i];
+        const GlyphMetrics& glyph = glyphs[i];
 
-        advances[i] = glyph.image->advance;
-        advances[i].x >>= 10; // Translate advances in
-        advances[i].y >>= 10; // 16.16 to 26.6 format
+        advances[i] = glyph.advance;
 
         if (prevAdvance)
         {
@@ -645,7 +1040,6 @@ void FTInternalFont::Prepare(FT_Face face, FT_Vector* advances)
                 // See http://www.freetype.org/freetype2/docs/reference/ft2-base_interface.html#FT_Set_Transform
                 prevAdvance->x += kern.x;
                 prevAdvance->y += kern.y;
-                prevAdvance->x += glyph.delta;
             }
         }
         prevIndex = glyph.index;
@@ -664,6 +1058,7 @@ int32 FTInternalFont::LoadString(float32 size, const WideString& str)
 
     int32 spacesCount = 0;
     uint32 count = uint32(str.size());
+    glyphs.reserve(count);
     for (uint32 i = 0; i < count; ++i)
     {
         if (L' ' == str[i])
@@ -671,26 +1066,9 @@ int32 FTInternalFont::LoadString(float32 size, const WideString& str)
             spacesCount++;
         }
 
-        Glyph glyph;
-        glyph.index = ftm->LookupGlyphIndex(this, str[i]);
-        FT_Error error = ftm->LookupGlyph(this, size, glyph.index, &glyph.image);
-        if (error != FT_Err_Ok)
-        {
-#if defined(__DAVAENGINE_DEBUG__)
-            // DVASSERT(false); //This situation can be unnormal. Check it
-            Logger::Warning("[FTInternalFont::LoadString] LookupGlyph error %d, str = %s", error, UTF8Utils::EncodeToUTF8(str).c_str());
-#endif //__DAVAENGINE_DEBUG__
-        }
-
-        glyphs.push_back(glyph);
+        glyphs.push_back(GetGlyphMetrics(size, str[i]));
     }
 
-#if defined(__DAVAENGINE_DEBUG__)
-// Set<Glyph> tmp;
-// tmp.insert(glyphs.begin(), glyphs.end());
-// DVASSERT(tmp.size() == glyphs.size()); //This situation can be unnormal. Check it
-#endif //__DAVAENGINE_DEBUG__
-
     return spacesCount;
 }
 
@@ -54,6 +54,20 @@ public:
 	 */
     StringMetrics GetStringMetrics(float32 size, const WideString& str, Vector<float32>* charSizes = NULL) const override;
 
+    /**
+		\brief Measure string and render its glyphs into font cache on worker thread.
+		Subsequent GetStringMetrics and DrawStringToBuffer calls with the same size reuse cached data.
+		Called by TextBlock on text change. Request is dropped when too many strings are already in flight.
+		\param[in] size - font size
+		\param[in] str - string which will be drawn soon
+	*/
+    void PrerasterizeString(float32 size, const WideString& str) const;
+
+    /**
+		\brief Wait until all strings passed to PrerasterizeString are processed.
+	*/
+    static void WaitPrerasterizeJobs();
+
     /**
 		\brief Get height of highest symbol in font.
 		\returns height in pixels
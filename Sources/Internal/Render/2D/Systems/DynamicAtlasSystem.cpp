@@ -37,6 +37,9 @@ std::shared_ptr<TextureDescriptor> GetDescriptorIfValid(const FilePath& textureN
 /** Load first mipmap texture image . */
 Image* LoadBaseMipImageForTexture(std::shared_ptr<TextureDescriptor>& texDescriptor);
 
+/** Render sprite frame into atlas image, pink rect is rendered if sprite image wasn't loaded */
+void InsertFrameImage(Image* atlasImage, Image* spriteImage, const Rect2i& frameRect, const Rect2i& spriteRect);
+
 #ifdef DEBUG_DUMP_DYNAMIC_ATLASES
 /** Save image as file for debugging purpose */
 void DumpAtlasImage(Image* image);
@@ -46,15 +49,22 @@ void DumpAtlasImage(Image* image);
 struct DynamicAtlasSystem::DynamicAtlas
 {
     const static uint32 NEED_REBUILD_PERCENT = 50;
+    // Nearly full atlas rarely accepts new sprites, so its image copy isn't worth the memory
+    const static uint32 KEEP_IMAGE_MAX_OCCUPANCY_PERCENT = 90;
 
     RefPtr<Texture> texture;
     Vector<AtlasRegion*> regions;
 
+    // Kept for adding new regions into free space
+    std::unique_ptr<SpritesheetLayout> layout;
+    RefPtr<Image> image;
+
     uint32 capacity = 0;
     bool needRebuild = false;
 
     void RemoveRegion(AtlasRegion* region);
     void AddRegion(AtlasRegion* region);
+    bool IsImageWorthKeeping() const;
 };
 
 struct DynamicAtlasSystem::AtlasRegion
@@ -73,7 +83,11 @@ struct DynamicAtlasSystem::AtlasRegion
     Vector<int32> frameNewTextureIndex;
     Vector<Rect2i> frameSheetRects;
 
-    Vector<int32> sheetIndices;
+    // Atlases in order of sprite textures
+    Vector<DynamicAtlas*> textureAtlases;
+
+    /** Return sprite texture index for atlas, add atlas if it isn't used by region yet */
+    int32 GetTextureIndex(DynamicAtlas* atlas);
 };
 
 void DynamicAtlasSystem::DynamicAtlas::RemoveRegion(AtlasRegion* region)
@@ -85,6 +99,14 @@ void DynamicAtlasSystem::DynamicAtlas::RemoveRegion(AtlasRegion* region)
         auto regionIt = std::find(regions.begin(), regions.end(), region);
         DVASSERT(regionIt != regions.end());
         regions.erase(regionIt);
+        if (layout != nullptr)
+        {
+            // keys of removed frames can be reused by new regions
+            for (const Rect2i& frameRect : region->spriteDef->frameRects)
+            {
+                layout->RemoveSprite(&frameRect);
+            }
+        }
         needRebuild = (regions.size() * 100) / capacity < NEED_REBUILD_PERCENT;
     }
     else
@@ -109,6 +131,22 @@ void DynamicAtlasSystem::DynamicAtlas::AddRegion(AtlasRegion* region)
     }
 }
 
+bool DynamicAtlasSystem::DynamicAtlas::IsImageWorthKeeping() const
+{
+    return layout != nullptr && layout->GetOccupancy() * 100.f < KEEP_IMAGE_MAX_OCCUPANCY_PERCENT;
+}
+
+int32 DynamicAtlasSystem::AtlasRegion::GetTextureIndex(DynamicAtlas* atlas)
+{
+    auto it = std::find(textureAtlases.begin(), textureAtlases.end(), atlas);
+    if (it == textureAtlases.end())
+    {
+        textureAtlases.push_back(atlas);
+        return static_cast<int32>(textureAtlases.size() - 1);
+    }
+    return static_cast<int32>(std::distance(textureAtlases.begin(), it));
+}
+
 DynamicAtlasSystem::DynamicAtlasSystem()
 {
     rectanglePacker.SetUseOnlySquareTextures(false);
@@ -167,6 +205,31 @@ uint32 DynamicAtlasSystem::GetAtlasesCount() const
     return static_cast<uint32>(atlases.size());
 }
 
+float32 DynamicAtlasSystem::GetOccupancy() const
+{
+    uint64 usedArea = 0;
+    uint64 totalArea = 0;
+    for (const std::shared_ptr<DynamicAtlas>& atlas : atlases)
+    {
+        usedArea += atlas->layout->GetUsedArea();
+        totalArea += atlas->layout->GetWeight();
+    }
+    return (totalArea > 0) ? static_cast<float32>(usedArea) / static_cast<float32>(totalArea) : 0.f;
+}
+
+void DynamicAtlasSystem::SetIncrementalPacking(bool value)
+{
+    LockGuard<Mutex> lock(systemMutex);
+    incrementalPacking = value;
+    if (incrementalPacking == false)
+    {
+        for (std::shared_ptr<DynamicAtlas>& atlas : atlases)
+        {
+            atlas->image = nullptr;
+        }
+    }
+}
+
 bool DynamicAtlasSystem::IsValidPathAndType(const Sprite* sprite) const
 {
     auto spritePath = sprite->relativePathname.GetStringValue();
@@ -317,20 +380,30 @@ void DynamicAtlasSystem::PackSprites()
     int64 startPackTime = SystemTimer::GetMs();
     Logger::FrameworkDebug("[DynamicAtlasSystem] Start sprites packaging");
 
-    RectanglePacker::PackTask packTask;
-
     // Collect unpacked sprites list
+    Vector<AtlasRegion*> unpackedRegions;
     for (std::shared_ptr<AtlasRegion>& region : regions)
     {
         if (region->atlases.empty())
         {
             Logger::FrameworkDebug("[DynamicAtlasSystem] Add sprite: %s", region->sprite->relativePathname.GetStringValue().c_str());
-            packTask.spriteList.push_back(region->spriteDef);
+            unpackedRegions.push_back(region.get());
             unpackedCounter--;
         }
     }
     DVASSERT(unpackedCounter == 0);
 
+    if (incrementalPacking && unpackedRegions.empty() == false && atlases.empty() == false)
+    {
+        InsertIntoExistingAtlases(unpackedRegions);
+    }
+
+    RectanglePacker::PackTask packTask;
+    for (AtlasRegion* region : unpackedRegions)
+    {
+        packTask.spriteList.push_back(region->spriteDef);
+    }
+
     Logger::FrameworkDebug("[DynamicAtlasSystem] Pack sprites: %d from %d", static_cast<int32>(packTask.spriteList.size()), static_cast<int32>(regions.size()));
 
     // Pack collected sprites to atlases
@@ -351,9 +424,109 @@ void DynamicAtlasSystem::PackSprites()
 
     Logger::FrameworkDebug("[DynamicAtlasSystem] Total packaging time: %d", static_cast<int32>(SystemTimer::GetMs() - startPackTime));
     Logger::FrameworkDebug("[DynamicAtlasSystem] App textures count: %d", static_cast<int32>(Texture::GetTextureMap().size()));
+    Logger::FrameworkDebug("[DynamicAtlasSystem] Atlases occupancy: %.1f%%", GetOccupancy() * 100.f);
 }
 
-void DynamicAtlasSystem::CreateAtlases(const RectanglePacker::PackTask& packTask, const RectanglePacker::PackResult& packResult)
+void DynamicAtlasSystem::InsertIntoExistingAtlases(Vector<AtlasRegion*>& unpackedRegions)
+{
+    Vector<DynamicAtlas*> changedAtlases;
+    Vector<DynamicAtlas*> frameAtlases;
+
+    for (size_t regionIdx = 0; regionIdx < unpackedRegions.size();)
+    {
+        AtlasRegion* region = unpackedRegions[regionIdx];
+        RectanglePacker::SpriteDefinition* spriteDef = region->spriteDef.get();
+        uint32 frameCount = spriteDef->GetFrameCount();
+
+        // Find place for every frame, frames of one sprite can be placed into different atlases
+        frameAtlases.assign(frameCount, nullptr);
+        bool allFramesInserted = true;
+        for (uint32 frameIdx = 0; frameIdx < frameCount && allFramesInserted; frameIdx++)
+        {
+            allFramesInserted = false;
+            for (std::shared_ptr<DynamicAtlas>& atlas : atlases)
+            {
+                if (atlas->image != nullptr && atlas->layout->AddSprite(spriteDef->GetFrameSize(frameIdx), &spriteDef->frameRects[frameIdx]))
+                {
+                    frameAtlases[frameIdx] = atlas.get();
+                    allFramesInserted = true;
+                    break;
+                }
+            }
+        }
+
+        if (allFramesInserted == false)
+        {
+            // Sprite will be packed into new atlas, space of already placed frames is reused after rebuild only
+            for (uint32 frameIdx = 0; frameIdx < frameCount; frameIdx++)
+            {
+                if (frameAtlases[frameIdx] != nullptr)
+                {
+                    frameAtlases[frameIdx]->layout->RemoveSprite(&spriteDef->frameRects[frameIdx]);
+                }
+            }
+            ++regionIdx;
+            continue;
+        }
+
+        Logger::FrameworkDebug("[DynamicAtlasSystem] Insert sprite into existing atlas: %s", region->sprite->relativePathname.GetStringValue().c_str());
+
+        // Release old resources
+        Sprite* sprite = region->sprite;
+        for (int32 textureIdx = 0; textureIdx < sprite->textureCount; textureIdx++)
+        {
+            SafeRelease(sprite->textures[textureIdx]);
+        }
+        SafeDeleteArray(sprite->textures);
+        sprite->textureCount = 0;
+
+        Vector<RefPtr<Image>> images;
+        for (std::shared_ptr<TextureDescriptor>& textureDescriptor : region->textureDescriptors)
+        {
+            images.push_back(RefPtr<Image>(DynamicAtlasSystemDetails::LoadBaseMipImageForTexture(textureDescriptor)));
+        }
+
+        region->frameNewTextureIndex.resize(frameCount);
+        region->frameSheetRects.resize(frameCount);
+        region->textureAtlases.clear();
+
+        for (uint32 frameIdx = 0; frameIdx < frameCount; frameIdx++)
+        {
+            DynamicAtlas* atlas = frameAtlases[frameIdx];
+            const SpriteBoundsRect* packedInfo = atlas->layout->GetSpriteBoundsRect(&spriteDef->frameRects[frameIdx]);
+            DVASSERT(packedInfo != nullptr);
+
+            region->frameNewTextureIndex[frameIdx] = region->GetTextureIndex(atlas);
+            region->frameSheetRects[frameIdx] = packedInfo->spriteRect;
+            atlas->AddRegion(region);
+
+            Image* image = images[region->frameTextureIndex[frameIdx]].Get();
+            DynamicAtlasSystemDetails::InsertFrameImage(atlas->image.Get(), image, spriteDef->frameRects[frameIdx], packedInfo->spriteRect);
+
+            if (std::find(changedAtlases.begin(), changedAtlases.end(), atlas) == changedAtlases.end())
+            {
+                changedAtlases.push_back(atlas);
+            }
+        }
+
+        UpdateSpriteFromRegion(region);
+        unpackedRegions.erase(unpackedRegions.begin() + regionIdx);
+    }
+
+    // Textures can be updated only entirely
+    for (DynamicAtlas* atlas : changedAtlases)
+    {
+        Image* image = atlas->image.Get();
+        atlas->texture->TexImage(0, image->width, image->height, image->data, image->dataSize, rhi::TEXTURE_FACE_NONE);
+        if (atlas->IsImageWorthKeeping() == false)
+        {
+            atlas->image = nullptr;
+        }
+    }
+    Logger::FrameworkDebug("[DynamicAtlasSystem] Existing atlases updated: %d", static_cast<int32>(changedAtlases.size()));
+}
+
+void DynamicAtlasSystem::CreateAtlases(const RectanglePacker::PackTask& packTask, RectanglePacker::PackResult& packResult)
 {
     Vector<AtlasRegion*> packedRegions;
     packedRegions.reserve(packTask.spriteList.size());
@@ -398,13 +571,12 @@ void DynamicAtlasSystem::CreateAtlases(const RectanglePacker::PackTask& packTask
     {
         RectanglePacker::SpriteDefinition* spriteDef = spriteData.spriteDef.get();
         AtlasRegion* region = static_cast<AtlasRegion*>(spriteDef->dataPtr);
-        Vector<int32> sheetIndexToTextureIndexTable(finalImages.size(), -1);
 
         Vector<RefPtr<Image>> images;
         uint32 frameCount = spriteDef->GetFrameCount();
         region->frameNewTextureIndex.resize(frameCount);
         region->frameSheetRects.resize(frameCount);
-        region->sheetIndices.clear();
+        region->textureAtlases.clear();
 
         // Load sprite images
         for (std::shared_ptr<TextureDescriptor>& textureDescriptor : region->textureDescriptors)
@@ -422,37 +594,17 @@ void DynamicAtlasSystem::CreateAtlases(const RectanglePacker::PackTask& packTask
             DVASSERT(-1 < sheetIndex && sheetIndex < static_cast<int32>(packResult.resultSheets.size()));
             DVASSERT(packedInfo);
             // Build sprite textures index
-            DVASSERT(sheetIndex < static_cast<int32>(sheetIndexToTextureIndexTable.size()));
-            int32 newTextureIndex = sheetIndexToTextureIndexTable[sheetIndex];
-            if (newTextureIndex == -1)
-            {
-                newTextureIndex = static_cast<int32>(region->sheetIndices.size());
-                sheetIndexToTextureIndexTable[sheetIndex] = newTextureIndex;
-                region->sheetIndices.push_back(sheetIndex);
-            }
-            region->frameNewTextureIndex[frameIdx] = newTextureIndex;
+            DynamicAtlas* atlas = finalAtlases[sheetIndex].get();
+            region->frameNewTextureIndex[frameIdx] = region->GetTextureIndex(atlas);
 
             // Prepare geometric informations
             const Rect2i& spriteRect = packedInfo->spriteRect;
             region->frameSheetRects[frameIdx] = spriteRect;
-            finalAtlases[sheetIndex]->AddRegion(region);
-
-            RefPtr<Image> finalImage = finalImages[sheetIndex];
-            Rect2i& frameRect = spriteDef->frameRects[frameIdx];
-            RefPtr<Image> image = images[region->frameTextureIndex[frameIdx]];
+            atlas->AddRegion(region);
 
             // Render frames into atlas
-            if (image != nullptr)
-            {
-                DVASSERT(image->GetPixelFormat() == FORMAT_RGBA8888);
-                finalImage->InsertImage(image.Get(), spriteRect.x, spriteRect.y, frameRect.x, frameRect.y, frameRect.dx, frameRect.dy);
-            }
-            else
-            {
-                image = RefPtr<Image>(Image::Create(frameRect.dx, frameRect.dy, FORMAT_RGBA8888));
-                image->MakePink(false);
-                finalImage->InsertImage(image.Get(), spriteRect.x, spriteRect.y, 0, 0, frameRect.dx, frameRect.dy);
-            }
+            Image* image = images[region->frameTextureIndex[frameIdx]].Get();
+            DynamicAtlasSystemDetails::InsertFrameImage(finalImages[sheetIndex].Get(), image, spriteDef->frameRects[frameIdx], spriteRect);
         }
 
         DVASSERT(region->atlases.size() > 0);
@@ -470,6 +622,12 @@ void DynamicAtlasSystem::CreateAtlases(const RectanglePacker::PackTask& packTask
         atlasTexture->texDescriptor->pathname = Format("memoryfile_dynamic_atlas_%d", atlasCounter);
         atlasCounter++;
         finalAtlases[imageNum]->texture = atlasTexture;
+        // Layout keeps packed rects, so packResult shouldn't be used after that
+        finalAtlases[imageNum]->layout = std::move(packResult.resultSheets[imageNum]);
+        if (incrementalPacking && finalAtlases[imageNum]->IsImageWorthKeeping())
+        {
+            finalAtlases[imageNum]->image = finalImages[imageNum];
+        }
         finalImages[imageNum] = nullptr;
     }
     finalImages.clear();
@@ -478,34 +636,36 @@ void DynamicAtlasSystem::CreateAtlases(const RectanglePacker::PackTask& packTask
     // Update sprites
     for (AtlasRegion* region : packedRegions)
     {
-        // Update textures
-        Sprite* sprite = region->sprite;
-        const int32 textureCount = static_cast<int32>(region->sheetIndices.size());
-        DVASSERT(textureCount > 0);
-        DVASSERT(sprite->textures == nullptr);
-        sprite->textureCount = textureCount;
-        sprite->textures = new Texture*[textureCount];
-
-        // Fill frame textures
-        for (int32 textureIdx = 0; textureIdx < textureCount; textureIdx++)
-        {
-            uint32 sheetIndex = region->sheetIndices[textureIdx];
-            DVASSERT(sheetIndex < finalAtlases.size());
-            std::shared_ptr<DynamicAtlas>& atlas = finalAtlases[sheetIndex];
-            Texture* texture = atlas->texture.Get();
-            sprite->textures[textureIdx] = SafeRetain(texture);
-        }
-        // Update frames geometry
-        for (int32 frameIdx = 0; frameIdx < sprite->frameCount; frameIdx++)
-        {
-            sprite->frameTextureIndex[frameIdx] = region->frameNewTextureIndex[frameIdx];
-            auto& frameRectPacked = region->frameSheetRects[frameIdx];
-            sprite->UpdateFrameGeometry(frameRectPacked.x, frameRectPacked.y, frameIdx);
-        }
+        UpdateSpriteFromRegion(region);
     }
     Logger::FrameworkDebug("[DynamicAtlasSystem] Atlases ready");
 }
 
+void DynamicAtlasSystem::UpdateSpriteFromRegion(AtlasRegion* region)
+{
+    // Update textures
+    Sprite* sprite = region->sprite;
+    const int32 textureCount = static_cast<int32>(region->textureAtlases.size());
+    DVASSERT(textureCount > 0);
+    DVASSERT(sprite->textures == nullptr);
+    sprite->textureCount = textureCount;
+    sprite->textures = new Texture*[textureCount];
+
+    // Fill frame textures
+    for (int32 textureIdx = 0; textureIdx < textureCount; textureIdx++)
+    {
+        Texture* texture = region->textureAtlases[textureIdx]->texture.Get();
+        sprite->textures[textureIdx] = SafeRetain(texture);
+    }
+    // Update frames geometry
+    for (int32 frameIdx = 0; frameIdx < sprite->frameCount; frameIdx++)
+    {
+        sprite->frameTextureIndex[frameIdx] = region->frameNewTextureIndex[frameIdx];
+        auto& frameRectPacked = region->frameSheetRects[frameIdx];
+        sprite->UpdateFrameGeometry(frameRectPacked.x, frameRectPacked.y, frameIdx);
+    }
+}
+
 void DynamicAtlasSystem::ReleaseAllAtlases()
 {
     Vector<Sprite*> sprites;
@@ -642,6 +802,21 @@ Image* LoadBaseMipImageForTexture(std::shared_ptr<TextureDescriptor>& texDescrip
     return image;
 }
 
+void InsertFrameImage(Image* atlasImage, Image* spriteImage, const Rect2i& frameRect, const Rect2i& spriteRect)
+{
+    if (spriteImage != nullptr)
+    {
+        DVASSERT(spriteImage->GetPixelFormat() == FORMAT_RGBA8888);
+        atlasImage->InsertImage(spriteImage, spriteRect.x, spriteRect.y, frameRect.x, frameRect.y, frameRect.dx, frameRect.dy);
+    }
+    else
+    {
+        RefPtr<Image> pinkImage(Image::Create(frameRect.dx, frameRect.dy, FORMAT_RGBA8888));
+        pinkImage->MakePink(false);
+        atlasImage->InsertImage(pinkImage.Get(), spriteRect.x, spriteRect.y, 0, 0, frameRect.dx, frameRect.dy);
+    }
+}
+
 #ifdef DEBUG_DUMP_DYNAMIC_ATLASES
 
 void DumpAtlasImage(Image* image)
@@ -20,6 +20,7 @@ struct SpritesheetLayout;
  * Supports only images with uncompressed format (RGB888, RGBA8888).
  * Adds one pixel margin between regions to avoid artifacts. 
  * Automatically dispose atlas textures when all related sprites deleted.
+ * New sprites can be added into free space of existing atlases (see SetIncrementalPacking).
  * Call "Sprites::Reload()" removes sprite from atlas and load defaults.
  * 
  * Attention!!! 
@@ -49,8 +50,17 @@ public:
     /** Remove existing atlases and repack all regions */
     void RebuildAll();
 
+    /**
+     * Enable or disable adding of new sprites into existing atlases without their repacking. Disabled by default.
+     * RGBA copy of atlas image is kept in memory for that until atlas is nearly full,
+     * and changed atlases are uploaded to GPU again.
+     */
+    void SetIncrementalPacking(bool value);
+
     uint32 GetRegionsCount() const;
     uint32 GetAtlasesCount() const;
+    /** Return ratio of area occupied by sprites to whole area of atlases, 0 if there are no atlases */
+    float32 GetOccupancy() const;
 
 private:
     struct AtlasRegion;
@@ -80,8 +90,14 @@ private:
     /** Pack all unpacked sprites */
     void PackSprites();
 
+    /** Put regions into free space of existing atlases. Regions that don't fit are left in 'unpackedRegions' */
+    void InsertIntoExistingAtlases(Vector<AtlasRegion*>& unpackedRegions);
+
     /** Create atlases and update sprite textures */
-    void CreateAtlases(const RectanglePacker::PackTask& packTask, const RectanglePacker::PackResult& packResult);
+    void CreateAtlases(const RectanglePacker::PackTask& packTask, RectanglePacker::PackResult& packResult);
+
+    /** Set atlas textures and frames geometry of packed region to its sprite */
+    void UpdateSpriteFromRegion(AtlasRegion* region);
 
     /** Remove all atlases and release related resources*/
     void ReleaseAllAtlases();
@@ -98,6 +114,7 @@ private:
 
     int32 unpackedCounter = 0;
     bool needRebuild = false;
+    bool incrementalPacking = false;
 
     uint64 linkedThreadId = 0; // Identifier of thread that calls DynamicAtlasSystem::BeginAtlas() method
     Mutex systemMutex;
@@ -409,6 +409,45 @@ DAVA_TESTCLASS (DynamicAtlasSystemTest)
         TEST_VERIFY(dynamicAtlasSystem->GetRegionsCount() == 0);
     }
 
+    DAVA_TEST (IncrementalPackTest)
+    {
+        DynamicAtlasSystem* dynamicAtlasSystem = GetEngineContext()->dynamicAtlasSystem;
+
+        TEST_VERIFY(dynamicAtlasSystem->GetAtlasesCount() == 0);
+        TEST_VERIFY(dynamicAtlasSystem->GetRegionsCount() == 0);
+        TEST_VERIFY(dynamicAtlasSystem->GetOccupancy() == 0.f);
+
+        dynamicAtlasSystem->BeginAtlas({}, {});
+
+        RefPtr<Sprite> sprite001(Sprite::Create(SPRITE_01_WHITE));
+        RefPtr<Sprite> sprite004(Sprite::Create(SPRITE_04_WHITE_INNER));
+
+        dynamicAtlasSystem->EndAtlas();
+
+        TEST_VERIFY(dynamicAtlasSystem->GetAtlasesCount() == 1);
+        float32 occupancy = dynamicAtlasSystem->GetOccupancy();
+        TEST_VERIFY(occupancy > 0.f && occupancy <= 1.f);
+
+        // Atlas has free space for one more sprite, so it is used instead of new atlas
+        dynamicAtlasSystem->BeginAtlas({}, {});
+
+        RefPtr<Sprite> sprite005(Sprite::Create(SPRITE_05_WHITE_INNER));
+
+        dynamicAtlasSystem->EndAtlas();
+
+        TEST_VERIFY(dynamicAtlasSystem->GetAtlasesCount() == 1);
+        TEST_VERIFY(dynamicAtlasSystem->GetRegionsCount() == 3);
+        TEST_VERIFY(sprite005->GetTexture(0) == sprite001->GetTexture(0));
+        TEST_VERIFY(dynamicAtlasSystem->GetOccupancy() > occupancy);
+
+        sprite001 = nullptr;
+        sprite004 = nullptr;
+        sprite005 = nullptr;
+
+        TEST_VERIFY(dynamicAtlasSystem->GetAtlasesCount() == 0);
+        TEST_VERIFY(dynamicAtlasSystem->GetRegionsCount() == 0);
+    }
+
     DAVA_TEST (WhiteListAndBlackListTest)
     {
         DynamicAtlasSystem* dynamicAtlasSystem = GetEngineContext()->dynamicAtlasSystem;
@@ -1,5 +1,6 @@
 #include "RenderSystem2D.h"
 
+#include "Base/FrameArena.h"
 #include "Engine/Engine.h"
 #include "UI/UIControl.h"
 #include "UI/UIControlBackground.h"
@@ -765,7 +766,7 @@ void RenderSystem2D::Draw(Sprite* sprite, SpriteDrawState* drawState, const Colo
     }
 
     static uint16 spriteIndeces[] = { 0, 1, 2, 1, 3, 2 };
-    Vector<uint16> spriteClippedIndecex;
+    FrameVector<uint16> spriteClippedIndecex;
 
     SpriteDrawState* state = drawState;
     if (!state)
@@ -1541,8 +1542,7 @@ void RenderSystem2D::DrawRect(const Rect& rect, const Color& color)
 
 void RenderSystem2D::DrawGrid(const Rect& rect, const Vector2& gridSize, const Color& color)
 {
-    // TODO! review with Ivan/Victor whether it is not performance problem!
-    Vector<float32> gridVertices;
+    FrameVector<float32> gridVertices;
     int32 verLinesCount = static_cast<int32>(std::ceil(rect.dx / gridSize.x));
     int32 horLinesCount = static_cast<int32>(std::ceil(rect.dy / gridSize.y));
     gridVertices.resize((horLinesCount + verLinesCount) * 4);
@@ -1566,7 +1566,7 @@ void RenderSystem2D::DrawGrid(const Rect& rect, const Vector2& gridSize, const C
         gridVertices[curVertexIndex++] = rect.y + rect.dy;
     }
 
-    Vector<uint16> indices;
+    FrameVector<uint16> indices;
     for (int i = 0; i < curVertexIndex; ++i)
     {
         indices.push_back(i);
@@ -1636,7 +1636,7 @@ void RenderSystem2D::DrawLines(const Vector<float32>& linePoints, const Color& c
         return;
     }
 
-    Vector<uint16> indices;
+    FrameVector<uint16> indices;
     indices.reserve(ptCount);
     for (auto i = 0U; i < ptCount; ++i)
     {
@@ -1681,7 +1681,7 @@ void RenderSystem2D::DrawPolygon(const Polygon2& polygon, bool closed, const Col
     auto ptCount = polygon.GetPointCount();
     if (ptCount >= 2)
     {
-        Vector<uint16> indices;
+        FrameVector<uint16> indices;
         indices.reserve(ptCount + 1);
         auto i = 0;
         for (; i < ptCount - 1; ++i)
@@ -1715,7 +1715,7 @@ void RenderSystem2D::FillPolygon(const Polygon2& polygon, const Color& color)
     auto ptCount = polygon.GetPointCount();
     if (ptCount >= 3)
     {
-        Vector<uint16> indices;
+        FrameVector<uint16> indices;
         for (auto i = 1; i < ptCount - 1; ++i)
         {
             indices.push_back(0);
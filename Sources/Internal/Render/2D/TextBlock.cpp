@@ -1,5 +1,6 @@
 #include "Render/2D/TextBlock.h"
 #include "Engine/Engine.h"
+#include "Render/2D/FTFont.h"
 #include "UI/UIControlSystem.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
@@ -220,6 +221,12 @@ void TextBlock::SetText(const WideString& _string, const Vector2& requestedTextR
         requestedSize = requestedTextRectSize;
         logicalText = _string;
         NeedPrepare();
+
+        // Glyphs are rendered on worker thread while control waits for layout and draw
+        if (font != nullptr && font->GetFontType() == Font::TYPE_FT && !logicalText.empty())
+        {
+            static_cast<FTFont*>(font)->PrerasterizeString(fontSize * scale.y, logicalText);
+        }
     }
 }
 
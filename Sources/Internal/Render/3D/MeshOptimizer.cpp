@@ -0,0 +1,595 @@
+#include "Render/3D/MeshOptimizer.h"
+
+#include "Base/Hash.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Entity.h"
+
+#include <numeric>
+
+namespace DAVA
+{
+namespace MeshOptimizer
+{
+namespace MeshOptimizerDetails
+{
+const uint32 INVALID_INDEX = uint32(-1);
+
+bool CanOptimize(PolygonGroup* group)
+{
+    return (group->GetPrimitiveType() == rhi::PRIMITIVE_TRIANGLELIST)
+    && (group->indexFormat == EIF_16)
+    && (group->meshData != nullptr)
+    && (group->indexArray != nullptr)
+    && (group->GetIndexCount() >= 3)
+    && ((group->GetFormat() & EVF_VERTEX) != 0);
+}
+
+/**
+    Replace vertex data of `group` with `vertexData`, index data is kept.
+*/
+void ReplaceVertexData(PolygonGroup* group, const Vector<uint8>& vertexData, uint32 newVertexCount)
+{
+    Vector<int16> indexData(group->indexArray, group->indexArray + group->GetIndexCount());
+
+    int32 format = group->GetFormat();
+    int32 primitiveCount = group->GetPrimitiveCount();
+
+    group->ReleaseData();
+    group->AllocateData(format, int32(newVertexCount), int32(indexData.size()), primitiveCount);
+
+    Memcpy(group->meshData, vertexData.data(), vertexData.size());
+    Memcpy(group->indexArray, indexData.data(), indexData.size() * sizeof(int16));
+}
+
+/**
+    Rearrange vertices of `group` by `remap` table (old vertex -> new vertex or INVALID_INDEX for removed ones).
+*/
+void RemapVertices(PolygonGroup* group, const Vector<uint32>& remap, uint32 newVertexCount)
+{
+    const uint32 stride = uint32(group->vertexStride);
+    const uint32 vertexCount = uint32(group->GetVertexCount());
+
+    Vector<uint8> vertexData(newVertexCount * stride);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] != INVALID_INDEX)
+        {
+            Memcpy(vertexData.data() + remap[v] * stride, group->meshData + v * stride, stride);
+        }
+    }
+
+    uint16* indices = reinterpret_cast<uint16*>(group->indexArray);
+    for (int32 i = 0, count = group->GetIndexCount(); i < count; ++i)
+    {
+        DVASSERT(remap[indices[i]] != INVALID_INDEX);
+        indices[i] = uint16(remap[indices[i]]);
+    }
+
+    ReplaceVertexData(group, vertexData, newVertexCount);
+}
+
+uint32 FindNextVertexOnDeadEnd(Vector<uint16>& deadEndStack, const Vector<uint32>& liveTriangles, uint32& cursor, bool& isNewCluster)
+{
+    while (!deadEndStack.empty())
+    {
+        uint16 vertex = deadEndStack.back();
+        deadEndStack.pop_back();
+
+        if (liveTriangles[vertex] > 0)
+        {
+            return vertex;
+        }
+    }
+
+    for (uint32 vertexCount = uint32(liveTriangles.size()); cursor < vertexCount; ++cursor)
+    {
+        if (liveTriangles[cursor] > 0)
+        {
+            isNewCluster = true;
+            return cursor;
+        }
+    }
+
+    return INVALID_INDEX;
+}
+
+struct Cluster
+{
+    uint32 firstTriangle = 0;
+    uint32 trianglesCount = 0;
+    float32 sortKey = 0.f;
+};
+
+void CollectPolygonGroups(Map<PolygonGroup*, bool>& groups, Entity* entity)
+{
+    RenderObject* ro = GetRenderObject(entity);
+    if (ro != nullptr && (ro->GetType() == RenderObject::TYPE_MESH || ro->GetType() == RenderObject::TYPE_SKINNED_MESH))
+    {
+        for (uint32 i = 0, count = ro->GetRenderBatchCount(); i < count; ++i)
+        {
+            RenderBatch* batch = ro->GetRenderBatch(i);
+            PolygonGroup* group = batch->GetPolygonGroup();
+            if (group != nullptr)
+            {
+                NMaterial* material = batch->GetMaterial();
+                bool isBlended = (material != nullptr) && (material->GetEffectiveFlagValue(NMaterialFlagName::FLAG_BLENDING) != 0);
+                groups[group] |= isBlended;
+            }
+        }
+    }
+
+    for (int32 i = 0, count = entity->GetChildrenCount(); i < count; ++i)
+    {
+        CollectPolygonGroups(groups, entity->GetChild(i));
+    }
+}
+}
+
+void Statistics::Append(const Statistics& other)
+{
+    auto appendCacheStatistics = [](VertexCacheStatistics& to, const VertexCacheStatistics& from) {
+        to.vertexCount += from.vertexCount;
+        to.triangleCount += from.triangleCount;
+        to.transformedVertexCount += from.transformedVertexCount;
+        to.acmr = (to.triangleCount > 0) ? float32(to.transformedVertexCount) / float32(to.triangleCount) : 0.f;
+        to.atvr = (to.vertexCount > 0) ? float32(to.transformedVertexCount) / float32(to.vertexCount) : 0.f;
+    };
+
+    appendCacheStatistics(before, other.before);
+    appendCacheStatistics(after, other.after);
+    optimizedGroupsCount += other.optimizedGroupsCount;
+    skippedGroupsCount += other.skippedGroupsCount;
+    removedVertexCount += other.removedVertexCount;
+}
+
+VertexCacheStatistics AnalyzeVertexCache(const uint16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+    DVASSERT(indexCount % 3 == 0);
+    DVASSERT(cacheSize > 0);
+
+    VertexCacheStatistics stats;
+    stats.vertexCount = vertexCount;
+    stats.triangleCount = indexCount / 3;
+
+    // FIFO cache is simulated with timestamps: vertex is in cache if it was added less than `cacheSize` insertions ago
+    Vector<uint32> cacheTimestamps(vertexCount, 0);
+    uint32 timestamp = cacheSize + 1;
+
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        uint16 vertex = indices[i];
+        DVASSERT(vertex < vertexCount);
+
+        if (timestamp - cacheTimestamps[vertex] > cacheSize)
+        {
+            cacheTimestamps[vertex] = timestamp++;
+            ++stats.transformedVertexCount;
+        }
+    }
+
+    stats.acmr = (stats.triangleCount > 0) ? float32(stats.transformedVertexCount) / float32(stats.triangleCount) : 0.f;
+    stats.atvr = (stats.vertexCount > 0) ? float32(stats.transformedVertexCount) / float32(stats.vertexCount) : 0.f;
+    return stats;
+}
+
+VertexCacheStatistics AnalyzeVertexCache(PolygonGroup* group, uint32 cacheSize)
+{
+    DVASSERT(group->indexFormat == EIF_16);
+    return AnalyzeVertexCache(reinterpret_cast<const uint16*>(group->indexArray), uint32(group->GetIndexCount()), uint32(group->GetVertexCount()), cacheSize);
+}
+
+void OptimizeVertexCache(uint16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize, Vector<uint32>* clusters)
+{
+    using namespace MeshOptimizerDetails;
+
+    DVASSERT(indexCount % 3 == 0);
+    DVASSERT(cacheSize > 0);
+
+    if (clusters != nullptr)
+    {
+        clusters->clear();
+    }
+
+    const uint32 trianglesCount = indexCount / 3;
+    if (trianglesCount == 0)
+    {
+        return;
+    }
+
+    // vertex -> triangles adjacency
+    Vector<uint32> liveTriangles(vertexCount, 0);
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        DVASSERT(indices[i] < vertexCount);
+        ++liveTriangles[indices[i]];
+    }
+
+    Vector<uint32> adjacencyOffsets(vertexCount + 1, 0);
+    std::partial_sum(liveTriangles.begin(), liveTriangles.end(), adjacencyOffsets.begin() + 1);
+
+    Vector<uint32> adjacency(indexCount);
+    Vector<uint32> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        adjacency[adjacencyFill[indices[i]]++] = i / 3;
+    }
+
+    // Tipsify: fan around current vertex, then continue from the vertex which is expected to stay in cache
+    Vector<uint16> result(indexCount);
+    Vector<uint16> deadEndStack;
+    deadEndStack.reserve(indexCount);
+
+    Vector<bool> emitted(trianglesCount, false);
+    Vector<uint32> cacheTimestamps(vertexCount, 0);
+    uint32 timestamp = cacheSize + 1;
+
+    uint32 cursor = 0;
+    uint32 outputTriangle = 0;
+    bool isNewCluster = false;
+    uint32 current = FindNextVertexOnDeadEnd(deadEndStack, liveTriangles, cursor, isNewCluster);
+
+    while (current != INVALID_INDEX)
+    {
+        if (isNewCluster && clusters != nullptr)
+        {
+            clusters->push_back(outputTriangle);
+        }
+        isNewCluster = false;
+
+        size_t candidatesBegin = deadEndStack.size();
+
+        for (uint32 a = adjacencyOffsets[current]; a < adjacencyOffsets[current + 1]; ++a)
+        {
+            uint32 triangle = adjacency[a];
+            if (emitted[triangle])
+            {
+                continue;
+            }
+
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                uint16 vertex = indices[triangle * 3 + k];
+                result[outputTriangle * 3 + k] = vertex;
+
+                deadEndStack.push_back(vertex);
+                --liveTriangles[vertex];
+
+                if (timestamp - cacheTimestamps[vertex] > cacheSize)
+                {
+                    cacheTimestamps[vertex] = timestamp++;
+                }
+            }
+
+            emitted[triangle] = true;
+            ++outputTriangle;
+        }
+
+        uint32 next = INVALID_INDEX;
+        int32 bestPriority = -1;
+        for (size_t c = candidatesBegin; c < deadEndStack.size(); ++c)
+        {
+            uint16 vertex = deadEndStack[c];
+            if (liveTriangles[vertex] == 0)
+            {
+                continue;
+            }
+
+            // prefer vertex which will still be in cache after all its remaining triangles are emitted
+            int32 priority = 0;
+            uint32 age = timestamp - cacheTimestamps[vertex];
+            if (age + 2 * liveTriangles[vertex] <= cacheSize)
+            {
+                priority = int32(age);
+            }
+
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == INVALID_INDEX)
+        {
+            next = FindNextVertexOnDeadEnd(deadEndStack, liveTriangles, cursor, isNewCluster);
+        }
+
+        current = next;
+    }
+
+    DVASSERT(outputTriangle == trianglesCount);
+    std::copy(result.begin(), result.end(), indices);
+}
+
+void OptimizeOverdraw(PolygonGroup* group, uint16* indices, uint32 indexCount, const Vector<uint32>& hardClusters, uint32 cacheSize, float32 threshold)
+{
+    using namespace MeshOptimizerDetails;
+
+    DVASSERT(indexCount % 3 == 0);
+
+    const uint32 trianglesCount = indexCount / 3;
+    const uint32 vertexCount = uint32(group->GetVertexCount());
+    if (trianglesCount == 0 || hardClusters.empty())
+    {
+        return;
+    }
+
+    // split clusters further at points where local ACMR is good enough, so clusters become small enough to sort
+    const float32 acmrLimit = AnalyzeVertexCache(indices, indexCount, vertexCount, cacheSize).acmr * threshold;
+
+    Vector<Cluster> clusters;
+    Vector<uint32> cacheTimestamps(vertexCount, 0);
+    uint32 timestamp = cacheSize + 1;
+
+    for (size_t c = 0; c < hardClusters.size(); ++c)
+    {
+        uint32 begin = hardClusters[c];
+        uint32 end = (c + 1 < hardClusters.size()) ? hardClusters[c + 1] : trianglesCount;
+
+        uint32 clusterBegin = begin;
+        uint32 misses = 0;
+        timestamp += cacheSize + 1; // flush cache
+
+        for (uint32 t = begin; t < end; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                uint16 vertex = indices[t * 3 + k];
+                if (timestamp - cacheTimestamps[vertex] > cacheSize)
+                {
+                    cacheTimestamps[vertex] = timestamp++;
+                    ++misses;
+                }
+            }
+
+            bool isLast = (t + 1 == end);
+            float32 clusterAcmr = float32(misses) / float32(t - clusterBegin + 1);
+            if (isLast || clusterAcmr <= acmrLimit)
+            {
+                Cluster cluster;
+                cluster.firstTriangle = clusterBegin;
+                cluster.trianglesCount = t - clusterBegin + 1;
+                clusters.push_back(cluster);
+
+                clusterBegin = t + 1;
+                misses = 0;
+                timestamp += cacheSize + 1;
+            }
+        }
+    }
+
+    // sort clusters by view-independent occlusion potential: clusters facing away from mesh center are drawn first
+    Vector<Vector3> clusterCentroids(clusters.size());
+    Vector<Vector3> clusterNormals(clusters.size());
+    Vector3 meshCentroid;
+    float32 meshArea = 0.f;
+
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        Vector3 centroid;
+        Vector3 normal;
+        float32 area = 0.f;
+
+        for (uint32 t = clusters[c].firstTriangle, tEnd = t + clusters[c].trianglesCount; t < tEnd; ++t)
+        {
+            Vector3 p0, p1, p2;
+            group->GetCoord(indices[t * 3 + 0], p0);
+            group->GetCoord(indices[t * 3 + 1], p1);
+            group->GetCoord(indices[t * 3 + 2], p2);
+
+            Vector3 n = (p1 - p0).CrossProduct(p2 - p0);
+            float32 triangleArea = n.Length();
+
+            centroid += (p0 + p1 + p2) * (triangleArea / 3.f);
+            normal += n;
+            area += triangleArea;
+        }
+
+        meshCentroid += centroid;
+        meshArea += area;
+
+        clusterCentroids[c] = (area > 0.f) ? centroid / area : centroid;
+        clusterNormals[c] = normal;
+    }
+
+    if (meshArea > 0.f)
+    {
+        meshCentroid /= meshArea;
+    }
+
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        Vector3 normal = clusterNormals[c];
+        if (normal.SquareLength() > 0.f)
+        {
+            normal.Normalize();
+            clusters[c].sortKey = (clusterCentroids[c] - meshCentroid).DotProduct(normal);
+        }
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& l, const Cluster& r) {
+        return l.sortKey > r.sortKey;
+    });
+
+    Vector<uint16> result;
+    result.reserve(indexCount);
+    for (const Cluster& cluster : clusters)
+    {
+        const uint16* begin = indices + cluster.firstTriangle * 3;
+        result.insert(result.end(), begin, begin + cluster.trianglesCount * 3);
+    }
+
+    DVASSERT(result.size() == indexCount);
+    std::copy(result.begin(), result.end(), indices);
+}
+
+uint32 WeldVertices(PolygonGroup* group)
+{
+    using namespace MeshOptimizerDetails;
+
+    DVASSERT(CanOptimize(group));
+
+    const uint32 vertexCount = uint32(group->GetVertexCount());
+    const uint32 stride = uint32(group->vertexStride);
+    const uint8* data = group->meshData;
+
+    uint32 tableSize = 1;
+    while (tableSize < vertexCount * 2)
+    {
+        tableSize <<= 1;
+    }
+
+    // open addressing hash table of unique vertices
+    Vector<uint32> table(tableSize, INVALID_INDEX);
+    Vector<uint32> remap(vertexCount, INVALID_INDEX);
+    uint32 uniqueCount = 0;
+
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        const uint8* vertex = data + v * stride;
+        uint32 bucket = HashValue_N(reinterpret_cast<const char*>(vertex), stride) & (tableSize - 1);
+
+        while (table[bucket] != INVALID_INDEX && Memcmp(data + table[bucket] * stride, vertex, stride) != 0)
+        {
+            bucket = (bucket + 1) & (tableSize - 1);
+        }
+
+        if (table[bucket] == INVALID_INDEX)
+        {
+            table[bucket] = v;
+            remap[v] = uniqueCount++;
+        }
+        else
+        {
+            remap[v] = remap[table[bucket]];
+        }
+    }
+
+    if (uniqueCount == vertexCount)
+    {
+        return 0;
+    }
+
+    // first occurrence of each unique vertex keeps relative order, so `remap` is valid for compaction
+    Vector<uint8> vertexData(uniqueCount * stride);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        Memcpy(vertexData.data() + remap[v] * stride, data + v * stride, stride);
+    }
+
+    uint16* indices = reinterpret_cast<uint16*>(group->indexArray);
+    for (int32 i = 0, count = group->GetIndexCount(); i < count; ++i)
+    {
+        indices[i] = uint16(remap[indices[i]]);
+    }
+
+    ReplaceVertexData(group, vertexData, uniqueCount);
+    return vertexCount - uniqueCount;
+}
+
+uint32 OptimizeVertexFetch(PolygonGroup* group)
+{
+    using namespace MeshOptimizerDetails;
+
+    DVASSERT(CanOptimize(group));
+
+    const uint32 vertexCount = uint32(group->GetVertexCount());
+    const uint16* indices = reinterpret_cast<const uint16*>(group->indexArray);
+
+    Vector<uint32> remap(vertexCount, INVALID_INDEX);
+    uint32 usedCount = 0;
+    bool isIdentity = true;
+
+    for (int32 i = 0, count = group->GetIndexCount(); i < count; ++i)
+    {
+        uint16 vertex = indices[i];
+        if (remap[vertex] == INVALID_INDEX)
+        {
+            isIdentity = isIdentity && (vertex == usedCount);
+            remap[vertex] = usedCount++;
+        }
+    }
+
+    if (isIdentity && usedCount == vertexCount)
+    {
+        return 0;
+    }
+
+    RemapVertices(group, remap, usedCount);
+    return vertexCount - usedCount;
+}
+
+Statistics OptimizePolygonGroup(PolygonGroup* group, const Options& options, bool keepTriangleOrder)
+{
+    using namespace MeshOptimizerDetails;
+
+    DVASSERT(group != nullptr);
+
+    Statistics stats;
+    if (!CanOptimize(group))
+    {
+        stats.skippedGroupsCount = 1;
+        return stats;
+    }
+
+    stats.before = AnalyzeVertexCache(group, options.cacheSize);
+
+    if (options.weldVertices)
+    {
+        stats.removedVertexCount += WeldVertices(group);
+    }
+
+    if (options.optimizeVertexCache && !keepTriangleOrder)
+    {
+        uint16* indices = reinterpret_cast<uint16*>(group->indexArray);
+        uint32 indexCount = uint32(group->GetIndexCount());
+
+        Vector<uint32> clusters;
+        OptimizeVertexCache(indices, indexCount, uint32(group->GetVertexCount()), options.cacheSize, &clusters);
+
+        if (options.optimizeOverdraw)
+        {
+            OptimizeOverdraw(group, indices, indexCount, clusters, options.cacheSize, options.overdrawThreshold);
+        }
+    }
+
+    if (options.optimizeVertexFetch)
+    {
+        stats.removedVertexCount += OptimizeVertexFetch(group);
+    }
+
+    stats.after = AnalyzeVertexCache(group, options.cacheSize);
+    stats.optimizedGroupsCount = 1;
+
+    if (group->vertexBuffer.IsValid() || group->indexBuffer.IsValid())
+    {
+        group->BuildBuffers();
+    }
+
+    return stats;
+}
+
+Statistics OptimizeMeshesRecursive(Entity* entity, const Options& options)
+{
+    using namespace MeshOptimizerDetails;
+
+    DVASSERT(entity != nullptr);
+
+    // polygon group can be shared between batches, it should keep triangle order if any of them is blended
+    Map<PolygonGroup*, bool> groups;
+    CollectPolygonGroups(groups, entity);
+
+    Statistics stats;
+    for (const auto& entry : groups)
+    {
+        stats.Append(OptimizePolygonGroup(entry.first, options, entry.second));
+    }
+
+    return stats;
+}
+}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Render/3D/PolygonGroup.h"
+
+namespace DAVA
+{
+class Entity;
+
+/**
+    \ingroup render_3d
+    Offline geometry optimizations for triangle list polygon groups with 16-bit indices.
+
+    Full pipeline (see `OptimizePolygonGroup`) is:
+    - duplicate vertex welding (binary equal vertices are merged);
+    - post-transform vertex cache reordering of triangles (Tipsify);
+    - overdraw-aware ordering of triangle clusters produced by previous step;
+    - vertex fetch reordering: vertices are stored in order of first use by index buffer.
+
+    Vertex cache efficiency is reported as ACMR (average cache miss ratio, transformed vertices per triangle)
+    and ATVR (average transformed vertex ratio, transformed vertices per unique vertex, 1.0 is optimal).
+*/
+namespace MeshOptimizer
+{
+struct VertexCacheStatistics
+{
+    uint32 vertexCount = 0;
+    uint32 triangleCount = 0;
+    uint32 transformedVertexCount = 0;
+    float32 acmr = 0.f;
+    float32 atvr = 0.f;
+};
+
+struct Statistics
+{
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+    uint32 optimizedGroupsCount = 0;
+    uint32 skippedGroupsCount = 0;
+    uint32 removedVertexCount = 0;
+
+    void Append(const Statistics& other);
+};
+
+struct Options
+{
+    uint32 cacheSize = 16; //!< size of simulated post-transform FIFO cache
+    bool weldVertices = true;
+    bool optimizeVertexCache = true;
+    bool optimizeOverdraw = true;
+    bool optimizeVertexFetch = true;
+    float32 overdrawThreshold = 1.05f; //!< allowed ACMR degradation caused by splitting triangles into overdraw clusters
+};
+
+VertexCacheStatistics AnalyzeVertexCache(const uint16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize);
+VertexCacheStatistics AnalyzeVertexCache(PolygonGroup* group, uint32 cacheSize);
+
+/**
+    Reorder triangles in `indices` for post-transform vertex cache of `cacheSize` entries.
+    If `clusters` is not null it is filled with first triangle of each cluster of connected triangles in output order.
+*/
+void OptimizeVertexCache(uint16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize, Vector<uint32>* clusters = nullptr);
+
+/**
+    Reorder triangle clusters of cache optimized `indices` so that outer-facing clusters are drawn first.
+    `clusters` should be obtained from `OptimizeVertexCache`, clusters can be split further
+    while cluster ACMR is not worse than `threshold` * ACMR of whole index buffer.
+*/
+void OptimizeOverdraw(PolygonGroup* group, uint16* indices, uint32 indexCount, const Vector<uint32>& clusters, uint32 cacheSize, float32 threshold);
+
+/**
+    Merge binary equal vertices of `group`. Returns count of removed vertices.
+*/
+uint32 WeldVertices(PolygonGroup* group);
+
+/**
+    Reorder vertices of `group` in order of first reference by index buffer, unreferenced vertices are removed.
+    Returns count of removed vertices.
+*/
+uint32 OptimizeVertexFetch(PolygonGroup* group);
+
+/**
+    Apply steps enabled in `options` to `group`. If `keepTriangleOrder` is true triangles are not reordered
+    (used for alpha-blended geometry where triangle order is visible).
+    Geometry buffers are rebuilt if they have been created before.
+*/
+Statistics OptimizePolygonGroup(PolygonGroup* group, const Options& options, bool keepTriangleOrder = false);
+
+/**
+    Optimize all unique polygon groups in entity hierarchy. Returns accumulated statistics.
+*/
+Statistics OptimizeMeshesRecursive(Entity* entity, const Options& options);
+}
+}
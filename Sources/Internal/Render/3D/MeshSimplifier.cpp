@@ -0,0 +1,669 @@
+#include "Render/3D/MeshSimplifier.h"
+#include "Render/3D/MeshOptimizer.h"
+
+#include "Base/Hash.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/SkinnedMesh.h"
+#include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Lod/LodComponent.h"
+
+#include <numeric>
+
+namespace DAVA
+{
+namespace MeshSimplifier
+{
+namespace MeshSimplifierDetails
+{
+const uint32 INVALID_INDEX = uint32(-1);
+
+struct Quadric
+{
+    float64 a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+    float64 a11 = 0.0, a12 = 0.0, a13 = 0.0;
+    float64 a22 = 0.0, a23 = 0.0;
+    float64 a33 = 0.0;
+    float64 weight = 0.0;
+
+    void AddPlane(const Vector3& normal, float64 d, float64 w)
+    {
+        float64 a = normal.x, b = normal.y, c = normal.z;
+        a00 += w * a * a;
+        a01 += w * a * b;
+        a02 += w * a * c;
+        a03 += w * a * d;
+        a11 += w * b * b;
+        a12 += w * b * c;
+        a13 += w * b * d;
+        a22 += w * c * c;
+        a23 += w * c * d;
+        a33 += w * d * d;
+        weight += w;
+    }
+
+    void Add(const Quadric& q)
+    {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a03 += q.a03;
+        a11 += q.a11;
+        a12 += q.a12;
+        a13 += q.a13;
+        a22 += q.a22;
+        a23 += q.a23;
+        a33 += q.a33;
+        weight += q.weight;
+    }
+
+    // Weighted average of squared distances from `p` to accumulated planes
+    float64 Evaluate(const Vector3& p) const
+    {
+        float64 x = p.x, y = p.y, z = p.z;
+        float64 r = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x
+        + a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y
+        + a22 * z * z + 2.0 * a23 * z
+        + a33;
+
+        return (weight > 0.0) ? std::abs(r) / weight : 0.0;
+    }
+};
+
+struct Collapse
+{
+    uint32 from = 0;
+    uint32 to = 0;
+    float64 error = 0.0;
+    float64 cost = 0.0;
+};
+
+struct SourceData
+{
+    Vector<Vector3> positions;
+    Vector<uint32> positionIds; // vertex -> first vertex with equal position
+    Vector<bool> collapsible; // vertex lies inside of continuous surface
+    Vector<int32> dominantJoints;
+    Vector<Vector3> normals;
+    Vector<Vector2> texcoords;
+    float32 extent = 0.f;
+};
+
+bool CanSimplify(PolygonGroup* group)
+{
+    return (group != nullptr)
+    && (group->GetPrimitiveType() == rhi::PRIMITIVE_TRIANGLELIST)
+    && (group->indexFormat == EIF_16)
+    && (group->meshData != nullptr)
+    && (group->indexArray != nullptr)
+    && (group->GetIndexCount() >= 3)
+    && ((group->GetFormat() & EVF_VERTEX) != 0);
+}
+
+inline uint64 EdgeKey(uint32 a, uint32 b)
+{
+    return (uint64(a) << 32) | uint64(b);
+}
+
+void PrepareSourceData(PolygonGroup* group, const Vector<uint32>& indices, SourceData& data)
+{
+    const uint32 vertexCount = uint32(group->GetVertexCount());
+    const int32 format = group->GetFormat();
+
+    data.positions.resize(vertexCount);
+    AABBox3 bbox;
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        group->GetCoord(int32(v), data.positions[v]);
+        bbox.AddPoint(data.positions[v]);
+    }
+    Vector3 size = bbox.GetSize();
+    data.extent = Max(size.x, Max(size.y, size.z));
+
+    if (format & EVF_NORMAL)
+    {
+        data.normals.resize(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+            group->GetNormal(int32(v), data.normals[v]);
+    }
+
+    if (format & EVF_TEXCOORD0)
+    {
+        data.texcoords.resize(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+            group->GetTexcoord(0, int32(v), data.texcoords[v]);
+    }
+
+    if (format & EVF_HARD_JOINTINDEX)
+    {
+        data.dominantJoints.resize(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+            group->GetHardJointIndex(int32(v), data.dominantJoints[v]);
+    }
+    else if ((format & EVF_JOINTINDEX) && (format & EVF_JOINTWEIGHT))
+    {
+        data.dominantJoints.resize(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            int32 bestJoint = 0;
+            float32 bestWeight = -1.f;
+            for (int32 j = 0; j < int32(PolygonGroup::MAX_VERTEX_JOINTS_COUNT); ++j)
+            {
+                float32 weight = 0.f;
+                group->GetJointWeight(int32(v), j, weight);
+                if (weight > bestWeight)
+                {
+                    bestWeight = weight;
+                    group->GetJointIndex(int32(v), j, bestJoint);
+                }
+            }
+            data.dominantJoints[v] = bestJoint;
+        }
+    }
+
+    // vertices with equal positions (UV seams, hard edges) share position id
+    uint32 tableSize = 1;
+    while (tableSize < vertexCount * 2)
+    {
+        tableSize <<= 1;
+    }
+
+    Vector<uint32> table(tableSize, INVALID_INDEX);
+    Vector<uint32> wedgesCount(vertexCount, 0);
+    data.positionIds.resize(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        const Vector3& p = data.positions[v];
+        uint32 bucket = HashValue_N(reinterpret_cast<const char*>(p.data), sizeof(p.data)) & (tableSize - 1);
+        while (table[bucket] != INVALID_INDEX && data.positions[table[bucket]] != p)
+        {
+            bucket = (bucket + 1) & (tableSize - 1);
+        }
+
+        if (table[bucket] == INVALID_INDEX)
+        {
+            table[bucket] = v;
+        }
+
+        data.positionIds[v] = table[bucket];
+        ++wedgesCount[table[bucket]];
+    }
+
+    // border and non-manifold edges: directed edge without exactly one opposite edge
+    UnorderedMap<uint64, uint32> edges;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            uint32 a = data.positionIds[indices[i + k]];
+            uint32 b = data.positionIds[indices[i + (k + 1) % 3]];
+            ++edges[EdgeKey(a, b)];
+        }
+    }
+
+    Vector<bool> isBorder(vertexCount, false);
+    for (const auto& edge : edges)
+    {
+        uint32 a = uint32(edge.first >> 32);
+        uint32 b = uint32(edge.first & 0xffffffff);
+        auto opposite = edges.find(EdgeKey(b, a));
+        if (edge.second != 1 || opposite == edges.end() || opposite->second != 1)
+        {
+            isBorder[a] = true;
+            isBorder[b] = true;
+        }
+    }
+
+    data.collapsible.resize(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        uint32 positionId = data.positionIds[v];
+        data.collapsible[v] = (wedgesCount[positionId] == 1) && !isBorder[positionId];
+    }
+}
+
+bool IsFlipped(const SourceData& data, const Vector<uint32>& indices, const Vector<uint32>& adjacencyOffsets, const Vector<uint32>& adjacency, const Vector<uint32>& remap, uint32 from, uint32 to)
+{
+    // triangles are checked with collapses already accepted on this pass
+    const uint32 targetPositionId = data.positionIds[to];
+    const Vector3& target = data.positions[to];
+
+    for (uint32 a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; ++a)
+    {
+        const uint32* triangle = &indices[adjacency[a] * 3];
+
+        uint32 vertices[3] = { remap[triangle[0]], remap[triangle[1]], remap[triangle[2]] };
+        uint32 positionIds[3] = { data.positionIds[vertices[0]], data.positionIds[vertices[1]], data.positionIds[vertices[2]] };
+        if (positionIds[0] == targetPositionId || positionIds[1] == targetPositionId || positionIds[2] == targetPositionId)
+        {
+            continue; // will be removed by collapse
+        }
+
+        if (positionIds[0] == positionIds[1] || positionIds[1] == positionIds[2] || positionIds[0] == positionIds[2])
+        {
+            continue; // already removed by other collapse
+        }
+
+        Vector3 p[3];
+        Vector3 moved[3];
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            p[k] = data.positions[vertices[k]];
+            moved[k] = (vertices[k] == from) ? target : p[k];
+        }
+
+        Vector3 normalBefore = (p[1] - p[0]).CrossProduct(p[2] - p[0]);
+        Vector3 normalAfter = (moved[1] - moved[0]).CrossProduct(moved[2] - moved[0]);
+        // reject flips and folds: triangle normal shouldn't rotate more than ~75 degrees
+        if (normalBefore.DotProduct(normalAfter) <= 0.25f * normalBefore.Length() * normalAfter.Length())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SimplifyIndices(PolygonGroup* source, const Options& options, Vector<uint16>& resultIndices, float32& resultError)
+{
+    DVASSERT(CanSimplify(source));
+
+    const uint32 vertexCount = uint32(source->GetVertexCount());
+    Vector<uint32> indices(source->GetIndexCount());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] = uint16(source->indexArray[i]);
+    }
+
+    SourceData data;
+    PrepareSourceData(source, indices, data);
+
+    if (data.extent <= 0.f)
+    {
+        return false;
+    }
+
+    Vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        const Vector3& p0 = data.positions[indices[i]];
+        const Vector3& p1 = data.positions[indices[i + 1]];
+        const Vector3& p2 = data.positions[indices[i + 2]];
+
+        Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+        float32 area = normal.Length();
+        if (area > 0.f)
+        {
+            normal /= area;
+            float64 d = -normal.DotProduct(p0);
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                quadrics[data.positionIds[indices[i + k]]].AddPlane(normal, d, area);
+            }
+        }
+    }
+
+    const uint32 targetIndexCount = Max(uint32(float32(indices.size()) * options.targetRatio) / 3 * 3, 3u);
+    const float64 errorLimit = float64(options.maxError) * float64(options.maxError) * float64(data.extent) * float64(data.extent);
+    const float64 attributeScale = float64(data.extent) * float64(data.extent);
+
+    float64 reachedError = 0.0;
+    Vector<uint32> remap(vertexCount);
+    Vector<bool> touched(vertexCount);
+    Vector<Collapse> collapses;
+
+    while (indices.size() > targetIndexCount)
+    {
+        // vertex -> triangles adjacency of current index buffer
+        Vector<uint32> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32 index : indices)
+        {
+            ++adjacencyOffsets[index + 1];
+        }
+        std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+
+        Vector<uint32> adjacency(indices.size());
+        Vector<uint32> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency[adjacencyFill[indices[i]]++] = uint32(i / 3);
+        }
+
+        collapses.clear();
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            for (uint32 k = 0; k < 6; ++k)
+            {
+                uint32 from = indices[i + k % 3];
+                uint32 to = indices[i + (k < 3 ? (k + 1) % 3 : (k + 2) % 3)];
+                if (!data.collapsible[from] || data.positionIds[from] == data.positionIds[to])
+                {
+                    continue;
+                }
+
+                if (!data.dominantJoints.empty() && data.dominantJoints[from] != data.dominantJoints[to])
+                {
+                    continue;
+                }
+
+                Quadric q = quadrics[data.positionIds[from]];
+                q.Add(quadrics[data.positionIds[to]]);
+
+                Collapse collapse;
+                collapse.from = from;
+                collapse.to = to;
+                collapse.error = q.Evaluate(data.positions[to]);
+                collapse.cost = collapse.error;
+                if (!data.normals.empty())
+                {
+                    collapse.cost += options.normalWeight * attributeScale * (data.normals[from] - data.normals[to]).SquareLength();
+                }
+                if (!data.texcoords.empty())
+                {
+                    collapse.cost += options.texcoordWeight * attributeScale * (data.texcoords[from] - data.texcoords[to]).SquareLength();
+                }
+
+                if (collapse.error <= errorLimit)
+                {
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r) {
+            return l.cost < r.cost;
+        });
+
+        std::iota(remap.begin(), remap.end(), 0);
+        std::fill(touched.begin(), touched.end(), false);
+
+        const uint32 trianglesToRemove = uint32(indices.size() - targetIndexCount) / 3;
+        uint32 removedTriangles = 0;
+        uint32 collapsesCount = 0;
+
+        for (const Collapse& c : collapses)
+        {
+            if (touched[c.from] || touched[c.to])
+            {
+                continue;
+            }
+
+            if (IsFlipped(data, indices, adjacencyOffsets, adjacency, remap, c.from, c.to))
+            {
+                continue;
+            }
+
+            const uint32 targetPositionId = data.positionIds[c.to];
+            for (uint32 a = adjacencyOffsets[c.from]; a < adjacencyOffsets[c.from + 1]; ++a)
+            {
+                const uint32* triangle = &indices[adjacency[a] * 3];
+                for (uint32 k = 0; k < 3; ++k)
+                {
+                    if (data.positionIds[remap[triangle[k]]] == targetPositionId)
+                    {
+                        ++removedTriangles;
+                        break;
+                    }
+                }
+            }
+
+            remap[c.from] = c.to;
+            touched[c.from] = true;
+            touched[c.to] = true;
+
+            quadrics[data.positionIds[c.to]].Add(quadrics[data.positionIds[c.from]]);
+            reachedError = Max(reachedError, c.error);
+            ++collapsesCount;
+
+            if (removedTriangles >= trianglesToRemove)
+            {
+                break;
+            }
+        }
+
+        if (collapsesCount == 0)
+        {
+            break;
+        }
+
+        size_t writeIndex = 0;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            uint32 a = remap[indices[i]];
+            uint32 b = remap[indices[i + 1]];
+            uint32 c = remap[indices[i + 2]];
+
+            uint32 pa = data.positionIds[a];
+            uint32 pb = data.positionIds[b];
+            uint32 pc = data.positionIds[c];
+            if (pa != pb && pb != pc && pa != pc)
+            {
+                indices[writeIndex++] = a;
+                indices[writeIndex++] = b;
+                indices[writeIndex++] = c;
+            }
+        }
+        indices.resize(writeIndex);
+    }
+
+    if (indices.empty() || indices.size() == size_t(source->GetIndexCount()))
+    {
+        return false;
+    }
+
+    resultIndices.assign(indices.begin(), indices.end());
+    resultError = float32(std::sqrt(reachedError)) / data.extent;
+    return true;
+}
+
+PolygonGroup* CreateSimplifiedGroup(PolygonGroup* source, const Vector<uint16>& indices)
+{
+    PolygonGroup* group = new PolygonGroup();
+    group->SetPrimitiveType(rhi::PRIMITIVE_TRIANGLELIST);
+    group->AllocateData(source->GetFormat(), source->GetVertexCount(), int32(indices.size()));
+
+    Memcpy(group->meshData, source->meshData, source->GetVertexCount() * source->vertexStride);
+    Memcpy(group->indexArray, indices.data(), indices.size() * sizeof(uint16));
+
+    MeshOptimizer::Options optimizerOptions;
+    optimizerOptions.weldVertices = false;
+    MeshOptimizer::OptimizePolygonGroup(group, optimizerOptions);
+
+    group->RecalcAABBox();
+    return group;
+}
+
+struct LodTask
+{
+    RenderBatch* batch = nullptr;
+    int32 lodIndex = -1;
+    int32 switchIndex = -1;
+    uint32 lod = 0;
+    Options options;
+
+    bool simplified = false;
+    Vector<uint16> indices;
+    float32 error = 0.f;
+};
+}
+
+PolygonGroup* Simplify(PolygonGroup* source, const Options& options, float32* resultError)
+{
+    using namespace MeshSimplifierDetails;
+
+    if (!CanSimplify(source))
+    {
+        return nullptr;
+    }
+
+    Vector<uint16> indices;
+    float32 error = 0.f;
+    if (!SimplifyIndices(source, options, indices, error))
+    {
+        return nullptr;
+    }
+
+    if (resultError != nullptr)
+    {
+        *resultError = error;
+    }
+
+    return CreateSimplifiedGroup(source, indices);
+}
+
+uint32 GenerateLods(RenderObject* renderObject, const LodOptions& options)
+{
+    using namespace MeshSimplifierDetails;
+
+    DVASSERT(renderObject != nullptr);
+
+    if (options.lodCount == 0 || renderObject->GetMaxLodIndex() > 0)
+    {
+        return 0;
+    }
+
+    const uint32 lodCount = Min(options.lodCount, uint32(LodComponent::MAX_LOD_LAYERS - 1));
+
+    Vector<LodTask> tasks;
+    for (uint32 i = 0, count = renderObject->GetRenderBatchCount(); i < count; ++i)
+    {
+        int32 lodIndex = -1;
+        int32 switchIndex = -1;
+        RenderBatch* batch = renderObject->GetRenderBatch(i, lodIndex, switchIndex);
+
+        float32 ratio = 1.f;
+        for (uint32 lod = 1; lod <= lodCount; ++lod)
+        {
+            ratio *= options.lodRatio;
+
+            LodTask task;
+            task.batch = batch;
+            task.lodIndex = lodIndex;
+            task.switchIndex = switchIndex;
+            task.lod = lod;
+            task.options.targetRatio = ratio;
+            task.options.maxError = options.maxError * float32(lod) / float32(lodCount);
+            tasks.push_back(task);
+        }
+    }
+
+    auto simplifyFn = [](LodTask& task) {
+        PolygonGroup* group = task.batch->GetPolygonGroup();
+        if (CanSimplify(group))
+        {
+            task.simplified = SimplifyIndices(group, task.options, task.indices, task.error);
+        }
+    };
+
+    if (options.useWorkerJobs)
+    {
+        GetEngineContext()->jobManager->ParallelFor(static_cast<uint32>(tasks.size()), [&tasks, &simplifyFn](uint32 index) {
+            simplifyFn(tasks[index]);
+        });
+    }
+    else
+    {
+        std::for_each(tasks.begin(), tasks.end(), simplifyFn);
+    }
+
+    // lod is generated if at least one batch was simplified for it
+    uint32 generatedLods = 0;
+    for (uint32 lod = 1; lod <= lodCount; ++lod)
+    {
+        bool anySimplified = std::any_of(tasks.begin(), tasks.end(), [lod](const LodTask& task) {
+            return task.lod == lod && task.simplified;
+        });
+
+        if (!anySimplified)
+        {
+            break;
+        }
+        generatedLods = lod;
+    }
+
+    if (generatedLods == 0)
+    {
+        return 0;
+    }
+
+    SkinnedMesh* skinnedMesh = (renderObject->GetType() == RenderObject::TYPE_SKINNED_MESH) ? static_cast<SkinnedMesh*>(renderObject) : nullptr;
+
+    for (LodTask& task : tasks)
+    {
+        if (task.lod > generatedLods)
+        {
+            continue;
+        }
+
+        // batches without lod are shown on every lod, they should be bound to lod 0 now
+        if (task.lod == 1 && task.lodIndex == -1)
+        {
+            SkinnedMesh::JointTargets jointTargets;
+            if (skinnedMesh != nullptr)
+            {
+                jointTargets = skinnedMesh->GetJointTargets(task.batch);
+            }
+
+            ScopedPtr<RenderBatch> retainedBatch(SafeRetain(task.batch));
+            renderObject->RemoveRenderBatch(task.batch);
+            renderObject->AddRenderBatch(task.batch, 0, task.switchIndex);
+
+            if (skinnedMesh != nullptr)
+            {
+                skinnedMesh->SetJointTargets(task.batch, jointTargets);
+            }
+        }
+
+        PolygonGroup* sourceGroup = task.batch->GetPolygonGroup();
+        ScopedPtr<PolygonGroup> group(task.simplified ? CreateSimplifiedGroup(sourceGroup, task.indices) : SafeRetain(sourceGroup));
+        if (task.simplified && sourceGroup->vertexBuffer.IsValid())
+        {
+            group->BuildBuffers();
+        }
+
+        ScopedPtr<RenderBatch> lodBatch(task.batch->Clone());
+        lodBatch->SetPolygonGroup(group);
+        renderObject->AddRenderBatch(lodBatch, int32(task.lod), task.switchIndex);
+
+        if (skinnedMesh != nullptr)
+        {
+            skinnedMesh->SetJointTargets(lodBatch, skinnedMesh->GetJointTargets(task.batch));
+        }
+    }
+
+    return generatedLods;
+}
+
+uint32 GenerateLodsRecursive(Entity* entity, const LodOptions& options)
+{
+    DVASSERT(entity != nullptr);
+
+    uint32 count = 0;
+
+    RenderObject* renderObject = GetRenderObject(entity);
+    if (renderObject != nullptr && (renderObject->GetType() == RenderObject::TYPE_MESH || renderObject->GetType() == RenderObject::TYPE_SKINNED_MESH))
+    {
+        if (GenerateLods(renderObject, options) > 0)
+        {
+            ++count;
+
+            if (GetLodComponent(entity) == nullptr)
+            {
+                entity->AddComponent(new LodComponent());
+            }
+        }
+    }
+
+    for (int32 i = 0, childrenCount = entity->GetChildrenCount(); i < childrenCount; ++i)
+    {
+        count += GenerateLodsRecursive(entity->GetChild(i), options);
+    }
+
+    return count;
+}
+}
+}
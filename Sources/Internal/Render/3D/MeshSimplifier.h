@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Render/3D/PolygonGroup.h"
+
+namespace DAVA
+{
+class Entity;
+class RenderObject;
+
+/**
+    \ingroup render_3d
+    Offline mesh simplification with quadric error metrics (edge collapse) for triangle list polygon groups
+    with 16-bit indices, and automatic LOD generation on top of it.
+
+    Only vertices lying inside of continuous surface are collapsed: vertices on open borders,
+    on UV seams or hard normal edges (several vertices sharing one position) are kept, so texture mapping
+    and shading discontinuities are preserved. Collapses between vertices with different dominant joints
+    are rejected for skinned geometry.
+*/
+namespace MeshSimplifier
+{
+struct Options
+{
+    float32 targetRatio = 0.5f; //!< desired ratio of result index count to source index count
+    float32 maxError = 0.01f; //!< max geometric error relative to bounding box size
+    float32 normalWeight = 0.5f; //!< weight of normal deviation in collapse cost
+    float32 texcoordWeight = 1.f; //!< weight of texture coordinates deviation in collapse cost
+};
+
+/**
+    Create simplified copy of `source`. Returns nullptr if `source` can't be simplified.
+    If `resultError` is not null it receives reached relative geometric error.
+    Result polygon group has no geometry buffers, call `BuildBuffers` before rendering.
+*/
+PolygonGroup* Simplify(PolygonGroup* source, const Options& options, float32* resultError = nullptr);
+
+struct LodOptions
+{
+    uint32 lodCount = 2; //!< count of generated lods, in addition to lod 0
+    float32 lodRatio = 0.5f; //!< index count ratio between neighbouring lods
+    float32 maxError = 0.02f; //!< max relative geometric error of the last lod
+    bool useWorkerJobs = true; //!< simplify geometry on JobManager worker threads
+};
+
+/**
+    Generate lods 1..`options.lodCount` for mesh `renderObject` from its lod 0 batches.
+    Render objects which already have hand-authored lods are skipped.
+    Returns count of generated lods.
+*/
+uint32 GenerateLods(RenderObject* renderObject, const LodOptions& options);
+
+/**
+    Generate lods for all meshes in entity hierarchy, LodComponent is added to entities which got lods.
+    Returns count of render objects which got lods.
+*/
+uint32 GenerateLodsRecursive(Entity* entity, const LodOptions& options);
+}
+}
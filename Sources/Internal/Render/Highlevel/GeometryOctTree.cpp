@@ -40,6 +40,12 @@
 
 namespace DAVA
 {
+namespace GeometryOctTreeDetails
+{
+// tree depth is limited by BuildTreeRecursive, each traversed level leaves up to 7 siblings in stack
+const uint32 TRAVERSAL_STACK_SIZE = 8 * 12;
+}
+
 // Implementation
 
 static uint32 counter = 0;
@@ -53,6 +59,23 @@ void GeometryOctTree::BuildTree(PolygonGroup* _geometry)
     for (uint32 triangle = 0; triangle < trianglesCount; ++triangle)
         triangles[triangle] = static_cast<uint16>(triangle);
 
+    triangleVertices.resize(trianglesCount * 3);
+    for (uint32 triangle = 0; triangle < trianglesCount; ++triangle)
+    {
+        int32 ptIndex[3];
+        Vector3 ptCoord[3];
+        geometry->GetIndex(triangle * 3 + 0, ptIndex[0]);
+        geometry->GetIndex(triangle * 3 + 1, ptIndex[1]);
+        geometry->GetIndex(triangle * 3 + 2, ptIndex[2]);
+        geometry->GetCoord(ptIndex[0], ptCoord[0]);
+        geometry->GetCoord(ptIndex[1], ptCoord[1]);
+        geometry->GetCoord(ptIndex[2], ptCoord[2]);
+
+        triangleVertices[triangle * 3 + 0] = ptCoord[0];
+        triangleVertices[triangle * 3 + 1] = ptCoord[1] - ptCoord[0];
+        triangleVertices[triangle * 3 + 2] = ptCoord[2] - ptCoord[0];
+    }
+
     nodes.resize(16);
     nextFreeIndex = 1; // count 0 index already busy for root Node
     uint32 maxLevel = BuildTreeRecursive(geometry, 0, geometry->GetBoundingBox(), triangles, 0, static_cast<uint32>(triangles.size()));
@@ -128,6 +151,7 @@ uint32 GeometryOctTree::GetAllocatedMemorySize()
     size += static_cast<uint32>(nodes.size() * sizeof(GeometryOctTreeNode));
     for (auto& vector : leafs)
         size += static_cast<uint32>(vector.size() * sizeof(uint16));
+    size += static_cast<uint32>(triangleVertices.size() * sizeof(Vector3));
     return size;
 }
 
@@ -417,6 +441,295 @@ void GeometryOctTree::RecGetTrianglesInBox(const AABBox3& searchBBox, uint32 nod
     }
 }
 
+GeometryOctTree::RayPacket::RayPacket()
+{
+    for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+    {
+        originX[lane] = originY[lane] = originZ[lane] = 0.0f;
+        directionX[lane] = directionY[lane] = directionZ[lane] = 0.0f;
+        invDirectionX[lane] = invDirectionY[lane] = invDirectionZ[lane] = 0.0f;
+        t[lane] = -1.0f; // unused lanes never intersect anything
+        triangleIndex[lane] = static_cast<uint32>(-1);
+    }
+}
+
+void GeometryOctTree::RayPacket::SetRay(uint32 lane, const Vector3& origin, const Vector3& direction, float32 tMax)
+{
+    DVASSERT(lane < RAY_PACKET_SIZE);
+
+    originX[lane] = origin.x;
+    originY[lane] = origin.y;
+    originZ[lane] = origin.z;
+    directionX[lane] = direction.x;
+    directionY[lane] = direction.y;
+    directionZ[lane] = direction.z;
+    // finite value for axis parallel rays avoids NaN in slab test when origin lies on box plane
+    invDirectionX[lane] = (direction.x != 0.0f) ? 1.0f / direction.x : FLOAT_MAX;
+    invDirectionY[lane] = (direction.y != 0.0f) ? 1.0f / direction.y : FLOAT_MAX;
+    invDirectionZ[lane] = (direction.z != 0.0f) ? 1.0f / direction.z : FLOAT_MAX;
+    t[lane] = tMax;
+    triangleIndex[lane] = static_cast<uint32>(-1);
+    activeMask |= (1 << lane);
+}
+
+uint32 GeometryOctTree::IntersectPacketWithBox(const RayPacket& packet, uint32 laneMask, const AABBox3& box, float32* tNear) const
+{
+    uint32 resultMask = 0;
+    for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+    {
+        float32 tx0 = (box.min.x - packet.originX[lane]) * packet.invDirectionX[lane];
+        float32 tx1 = (box.max.x - packet.originX[lane]) * packet.invDirectionX[lane];
+        float32 ty0 = (box.min.y - packet.originY[lane]) * packet.invDirectionY[lane];
+        float32 ty1 = (box.max.y - packet.originY[lane]) * packet.invDirectionY[lane];
+        float32 tz0 = (box.min.z - packet.originZ[lane]) * packet.invDirectionZ[lane];
+        float32 tz1 = (box.max.z - packet.originZ[lane]) * packet.invDirectionZ[lane];
+
+        float32 tMin = Max(Max(Min(tx0, tx1), Min(ty0, ty1)), Min(tz0, tz1));
+        float32 tMax = Min(Min(Max(tx0, tx1), Max(ty0, ty1)), Max(tz0, tz1));
+
+        tNear[lane] = tMin;
+        bool isIntersection = (tMin <= tMax) & (tMax >= 0.0f) & (tMin <= packet.t[lane]);
+        resultMask |= static_cast<uint32>(isIntersection) << lane;
+    }
+    return resultMask & laneMask;
+}
+
+void GeometryOctTree::IntersectPacketWithLeaf(RayPacket& packet, uint32 leafIndex) const
+{
+    // Same test as Intersection::RayTriangle, evaluated for all lanes without branches
+    for (uint16 triangleIndex : leafs[leafIndex])
+    {
+        const Vector3& p0 = triangleVertices[triangleIndex * 3 + 0];
+        const Vector3& edge1 = triangleVertices[triangleIndex * 3 + 1];
+        const Vector3& edge2 = triangleVertices[triangleIndex * 3 + 2];
+
+        uint32 hitMask = 0;
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            float32 px = packet.directionY[lane] * edge2.z - packet.directionZ[lane] * edge2.y;
+            float32 py = packet.directionZ[lane] * edge2.x - packet.directionX[lane] * edge2.z;
+            float32 pz = packet.directionX[lane] * edge2.y - packet.directionY[lane] * edge2.x;
+
+            float32 det = px * edge1.x + py * edge1.y + pz * edge1.z;
+            float32 invDet = 1.0f / det;
+
+            float32 sx = packet.originX[lane] - p0.x;
+            float32 sy = packet.originY[lane] - p0.y;
+            float32 sz = packet.originZ[lane] - p0.z;
+            float32 u = (sx * px + sy * py + sz * pz) * invDet;
+
+            float32 qx = sy * edge1.z - sz * edge1.y;
+            float32 qy = sz * edge1.x - sx * edge1.z;
+            float32 qz = sx * edge1.y - sy * edge1.x;
+            float32 v = (packet.directionX[lane] * qx + packet.directionY[lane] * qy + packet.directionZ[lane] * qz) * invDet;
+            float32 t = (edge2.x * qx + edge2.y * qy + edge2.z * qz) * invDet;
+
+            bool isIntersection = (std::abs(det) >= EPSILON) & (u >= 0.0f) & (u <= 1.0f) & (v >= 0.0f) & ((u + v) <= 1.0f) & (t >= 0.0f) & (t < packet.t[lane]);
+            packet.t[lane] = isIntersection ? t : packet.t[lane];
+            packet.triangleIndex[lane] = isIntersection ? triangleIndex : packet.triangleIndex[lane];
+            hitMask |= static_cast<uint32>(isIntersection) << lane;
+        }
+        packet.hitMask |= hitMask;
+    }
+}
+
+bool GeometryOctTree::IntersectionWithRayPacket(RayPacket& packet) const
+{
+    using namespace GeometryOctTreeDetails;
+
+    struct StackEntry
+    {
+        uint32 nodeIndex;
+        uint32 laneMask;
+        AABBox3 box;
+        float32 tNear[RAY_PACKET_SIZE];
+    };
+
+    packet.hitMask = 0;
+    if (nodes.empty() || packet.activeMask == 0)
+    {
+        return false;
+    }
+
+    StackEntry stack[TRAVERSAL_STACK_SIZE];
+    uint32 stackSize = 0;
+
+    StackEntry& root = stack[stackSize];
+    root.nodeIndex = 0;
+    root.box = geometry->GetBoundingBox();
+    root.laneMask = IntersectPacketWithBox(packet, packet.activeMask, root.box, root.tNear);
+    stackSize += (root.laneMask != 0) ? 1 : 0;
+
+    while (stackSize > 0)
+    {
+        const StackEntry entry = stack[--stackSize];
+
+        // skip lanes which already found intersection closer than this node
+        uint32 laneMask = 0;
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            laneMask |= static_cast<uint32>(entry.tNear[lane] <= packet.t[lane]) << lane;
+        }
+        laneMask &= entry.laneMask;
+        if (laneMask == 0)
+        {
+            continue;
+        }
+
+        const GeometryOctTreeNode& node = nodes[entry.nodeIndex];
+        if (node.isLeaf)
+        {
+            IntersectPacketWithLeaf(packet, static_cast<uint32>(node.leafDataLocation));
+            continue;
+        }
+
+        // visit children in front to back order of first active ray
+        uint32 firstLane = 0;
+        while (((laneMask >> firstLane) & 1) == 0)
+        {
+            ++firstLane;
+        }
+        uint32 mirror = ((packet.directionX[firstLane] < 0.0f) ? 4 : 0) | ((packet.directionY[firstLane] < 0.0f) ? 2 : 0) | ((packet.directionZ[firstLane] < 0.0f) ? 1 : 0);
+
+        for (int32 order = 7; order >= 0; --order)
+        {
+            uint32 childBitIndex = static_cast<uint32>(order) ^ mirror;
+            if (((node.children >> childBitIndex) & 1) == 0)
+            {
+                continue;
+            }
+
+            DVASSERT(stackSize < TRAVERSAL_STACK_SIZE);
+            StackEntry& child = stack[stackSize];
+            child.box = GetChildBox(entry.box, childBitIndex);
+            child.laneMask = IntersectPacketWithBox(packet, laneMask, child.box, child.tNear);
+            if (child.laneMask != 0)
+            {
+                child.nodeIndex = GetChildNodeIndex(entry.nodeIndex, childBitIndex);
+                ++stackSize;
+            }
+        }
+    }
+
+    return packet.hitMask != 0;
+}
+
+uint32 GeometryOctTree::IntersectionWithRays(const Ray3* rays, uint32 count, RayHit* hits) const
+{
+    uint32 hitCount = 0;
+    for (uint32 first = 0; first < count; first += RAY_PACKET_SIZE)
+    {
+        uint32 packetSize = Min(count - first, RAY_PACKET_SIZE);
+
+        RayPacket packet;
+        for (uint32 lane = 0; lane < packetSize; ++lane)
+        {
+            packet.SetRay(lane, rays[first + lane].origin, rays[first + lane].direction, hits[first + lane].t);
+        }
+
+        if (IntersectionWithRayPacket(packet))
+        {
+            for (uint32 lane = 0; lane < packetSize; ++lane)
+            {
+                if ((packet.hitMask >> lane) & 1)
+                {
+                    hits[first + lane].t = packet.t[lane];
+                    hits[first + lane].triangleIndex = packet.triangleIndex[lane];
+                    ++hitCount;
+                }
+            }
+        }
+    }
+    return hitCount;
+}
+
+uint32 GeometryOctTree::GetTrianglesInBoxes(const AABBox3* boxes, uint32 count, Vector<uint16>& resultTriangles, BoxQueryResult* results) const
+{
+    using namespace GeometryOctTreeDetails;
+
+    struct StackEntry
+    {
+        uint32 nodeIndex;
+        bool isFullyInside;
+        AABBox3 box;
+    };
+
+    StackEntry stack[TRAVERSAL_STACK_SIZE];
+    const AABBox3& boundingBox = geometry->GetBoundingBox();
+
+    uint32 totalCount = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const AABBox3& searchBox = boxes[i];
+        const size_t offset = resultTriangles.size();
+
+        uint32 stackSize = 0;
+        if (!nodes.empty() && Intersection::BoxBox(searchBox, boundingBox))
+        {
+            stack[0].nodeIndex = 0;
+            stack[0].isFullyInside = searchBox.IsInside(boundingBox);
+            stack[0].box = boundingBox;
+            stackSize = 1;
+        }
+
+        while (stackSize > 0)
+        {
+            const StackEntry entry = stack[--stackSize];
+            const GeometryOctTreeNode& node = nodes[entry.nodeIndex];
+
+            if (node.isLeaf)
+            {
+                const Vector<uint16>& triangles = leafs[node.leafDataLocation];
+                if (entry.isFullyInside)
+                {
+                    resultTriangles.insert(resultTriangles.end(), triangles.begin(), triangles.end());
+                }
+                else
+                {
+                    for (uint16 triangleIndex : triangles)
+                    {
+                        const Vector3& p0 = triangleVertices[triangleIndex * 3 + 0];
+                        if (Intersection::BoxTriangle(searchBox, p0, p0 + triangleVertices[triangleIndex * 3 + 1], p0 + triangleVertices[triangleIndex * 3 + 2]))
+                        {
+                            resultTriangles.push_back(triangleIndex);
+                        }
+                    }
+                }
+                continue;
+            }
+
+            for (uint32 childBitIndex = 0; childBitIndex < 8; ++childBitIndex)
+            {
+                if (((node.children >> childBitIndex) & 1) == 0)
+                {
+                    continue;
+                }
+
+                AABBox3 childBox = GetChildBox(entry.box, childBitIndex);
+                if (entry.isFullyInside || Intersection::BoxBox(searchBox, childBox))
+                {
+                    DVASSERT(stackSize < TRAVERSAL_STACK_SIZE);
+                    StackEntry& child = stack[stackSize++];
+                    child.nodeIndex = GetChildNodeIndex(entry.nodeIndex, childBitIndex);
+                    child.isFullyInside = entry.isFullyInside || searchBox.IsInside(childBox);
+                    child.box = childBox;
+                }
+            }
+        }
+
+        // triangles can be referenced by several leafs
+        auto begin = resultTriangles.begin() + offset;
+        std::sort(begin, resultTriangles.end());
+        resultTriangles.erase(std::unique(begin, resultTriangles.end()), resultTriangles.end());
+
+        results[i].offset = static_cast<uint32>(offset);
+        results[i].count = static_cast<uint32>(resultTriangles.size() - offset);
+        totalCount += results[i].count;
+    }
+
+    return totalCount;
+}
+
 void GeometryOctTree::DebugDraw(const Matrix4& worldMatrix, uint32 flags, RenderHelper* renderHelper)
 {
     const AABBox3& boundingBox = geometry->GetBoundingBox();
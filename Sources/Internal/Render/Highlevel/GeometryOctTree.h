@@ -74,6 +74,44 @@ public:
     void CleanDebugTriangles();
     void AddDebugTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3);
 
+    static const uint32 RAY_PACKET_SIZE = 8;
+
+    /**
+        Rays in structure of arrays layout, traversed through the tree together.
+        Lanes are tested in branchless loops so compiler can vectorize them.
+    */
+    struct RayPacket
+    {
+        float32 originX[RAY_PACKET_SIZE];
+        float32 originY[RAY_PACKET_SIZE];
+        float32 originZ[RAY_PACKET_SIZE];
+        float32 directionX[RAY_PACKET_SIZE];
+        float32 directionY[RAY_PACKET_SIZE];
+        float32 directionZ[RAY_PACKET_SIZE];
+        float32 invDirectionX[RAY_PACKET_SIZE];
+        float32 invDirectionY[RAY_PACKET_SIZE];
+        float32 invDirectionZ[RAY_PACKET_SIZE];
+        float32 t[RAY_PACKET_SIZE]; //!< max ray parameter on input, parameter of closest intersection on output
+        uint32 triangleIndex[RAY_PACKET_SIZE];
+        uint32 activeMask = 0; //!< bit per lane, only active lanes are traversed
+        uint32 hitMask = 0; //!< bit per lane which got intersection closer than input `t`
+
+        RayPacket();
+        void SetRay(uint32 lane, const Vector3& origin, const Vector3& direction, float32 tMax);
+    };
+
+    struct RayHit
+    {
+        float32 t = FLOAT_MAX;
+        uint32 triangleIndex = static_cast<uint32>(-1);
+    };
+
+    struct BoxQueryResult
+    {
+        uint32 offset = 0; //!< position of first triangle in result buffer
+        uint32 count = 0;
+    };
+
 public:
     const uint32 MIN_TRIANGLES_IN_LEAF = 20;
 
@@ -84,6 +122,26 @@ public:
 
     void GetTrianglesInBox(const AABBox3& searchBox, Vector<uint16>& resultTriangles);
 
+    /**
+        Find closest intersections for active lanes of `packet`, intersections farther than `packet.t` are ignored.
+        Returns true if any lane got intersection. Doesn't modify tree, so can be called from several threads.
+    */
+    bool IntersectionWithRayPacket(RayPacket& packet) const;
+
+    /**
+        Find closest intersections of `count` rays, intersections farther than `hits[i].t` are ignored.
+        Rays are traversed in packets of RAY_PACKET_SIZE, so coherent rays should be adjacent in `rays`.
+        Returns count of rays that got closer intersection.
+    */
+    uint32 IntersectionWithRays(const Ray3* rays, uint32 count, RayHit* hits) const;
+
+    /**
+        Collect triangles intersecting each of `count` boxes. Triangles of box i are appended to `resultTriangles`
+        at range described by `results[i]`, sorted and without duplicates. Passing the same `resultTriangles`
+        to every call avoids allocations once buffer has grown. Returns total count of collected triangles.
+    */
+    uint32 GetTrianglesInBoxes(const AABBox3* boxes, uint32 count, Vector<uint16>& resultTriangles, BoxQueryResult* results) const;
+
     uint32 GetAllocatedMemorySize();
 
 private:
@@ -104,11 +162,16 @@ private:
 
     void RecGetTrianglesInBox(const AABBox3& searchBBox, uint32 nodeIndex, const AABBox3& boundingBox, Vector<uint16>& resultTriangles, bool isFullyInside);
 
+    inline uint32 GetChildNodeIndex(uint32 nodeIndex, uint32 childBitIndex) const;
+    uint32 IntersectPacketWithBox(const RayPacket& packet, uint32 laneMask, const AABBox3& box, float32* tNear) const;
+    void IntersectPacketWithLeaf(RayPacket& packet, uint32 leafIndex) const;
+
 private:
     Vector<Triangle> debugTriangles;
     Vector<AABBox3> debugBoxes;
     Vector<GeometryOctTreeNode> nodes;
     Vector<Vector<uint16>> leafs;
+    Vector<Vector3> triangleVertices; // first vertex and two edges of each triangle, for packet queries
     uint32 nextFreeIndex = 0;
     PolygonGroup* geometry = nullptr;
 };
@@ -118,6 +181,18 @@ inline uint32 GeometryOctTree::GetIndex(uint32 xdiv, uint32 ydiv, uint32 zdiv) c
     return zdiv + (ydiv * 2) + (xdiv * 4);
 }
 
+inline uint32 GeometryOctTree::GetChildNodeIndex(uint32 nodeIndex, uint32 childBitIndex) const
+{
+    const GeometryOctTreeNode& node = nodes[nodeIndex];
+    uint32 precedingChildren = static_cast<uint32>(node.children) & ((1u << childBitIndex) - 1);
+    uint32 count = 0;
+    for (; precedingChildren != 0; precedingChildren &= precedingChildren - 1)
+    {
+        ++count;
+    }
+    return nodeIndex + static_cast<uint32>(node.childrenPosition) + count;
+}
+
 inline AABBox3 GeometryOctTree::GetChildBox(const AABBox3& parentBox, uint32 childNodeIndex) const
 {
     Vector3 boundingBoxCenter = parentBox.min + parentBox.GetSize() / 2.0f;
@@ -1,4 +1,5 @@
 #include "Render/Highlevel/RenderBatchArray.h"
+#include "Base/FrameArena.h"
 #include "Render/Highlevel/RenderSystem.h"
 #include "Render/Highlevel/RenderPass.h"
 
@@ -58,7 +59,25 @@ void RenderBatchArray::Sort(Camera* camera)
                 batch->layerSortingKey = (distance & 0x0fffffff) | (batch->GetSortingKey() << 28);
             }
 
-            std::stable_sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            //VI: std::stable_sort takes temporary buffer from heap every frame, so order of equal keys is kept by batch index instead
+            FrameVector<std::pair<pointer_size, uint32>> sortKeys;
+            sortKeys.reserve(renderBatchArray.size());
+            for (uint32 i = 0, count = uint32(renderBatchArray.size()); i < count; ++i)
+            {
+                sortKeys.emplace_back(renderBatchArray[i]->layerSortingKey, i);
+            }
+
+            std::sort(sortKeys.begin(), sortKeys.end(), [](const std::pair<pointer_size, uint32>& a, const std::pair<pointer_size, uint32>& b) {
+                return (a.first > b.first) || (a.first == b.first && a.second < b.second);
+            });
+
+            FrameVector<RenderBatch*> sortedBatches;
+            sortedBatches.reserve(sortKeys.size());
+            for (const std::pair<pointer_size, uint32>& key : sortKeys)
+            {
+                sortedBatches.push_back(renderBatchArray[key.second]);
+            }
+            std::copy(sortedBatches.begin(), sortedBatches.end(), renderBatchArray.begin());
 
             sortFlags |= SORT_REQUIRED;
         }
@@ -4,9 +4,154 @@
 #include "Render/Highlevel/Frustum.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Highlevel/GeometryOctTree.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
+namespace RenderHierarchyDetails
+{
+const uint32 RAY_PACKET_SIZE = GeometryOctTree::RAY_PACKET_SIZE;
+const uint32 PACKETS_PER_JOB = 16;
+
+// Trace packet of world space segments against geometry of candidate objects, `collisions` keep closest hits
+void TracePacket(const Ray3* rays, uint32 count, RenderObject* const* candidates, uint32 candidatesCount, RayTraceCollision* collisions)
+{
+    for (uint32 c = 0; c < candidatesCount; ++c)
+    {
+        RenderObject* ro = candidates[c];
+        const Matrix4& inverseWorldTransform = ro->GetInverseWorldTransform();
+        const AABBox3& worldBBox = ro->GetWorldBoundingBox();
+
+        GeometryOctTree::RayPacket packet;
+        for (uint32 lane = 0; lane < count; ++lane)
+        {
+            const Ray3& ray = rays[lane];
+            float32 tMin, tMax;
+            if (Intersection::RayBox(ray, worldBBox, tMin, tMax) && (tMax >= 0.0f) && (tMin <= collisions[lane].t))
+            {
+                Vector3 rayOrigin = ray.origin * inverseWorldTransform;
+                Vector3 rayDirection = MultiplyVectorMat3x3(ray.direction, inverseWorldTransform);
+                packet.SetRay(lane, rayOrigin, rayDirection, collisions[lane].t);
+            }
+        }
+
+        if (packet.activeMask == 0)
+        {
+            continue;
+        }
+
+        uint32 activeBatchesCount = ro->GetActiveRenderBatchCount();
+        for (uint32 bi = 0; bi < activeBatchesCount; ++bi)
+        {
+            RenderBatch* rb = ro->GetActiveRenderBatch(bi);
+            DVASSERT(rb != nullptr);
+            PolygonGroup* geo = rb->GetPolygonGroup();
+
+            if (geo != nullptr && geo->octTree != nullptr && geo->octTree->IntersectionWithRayPacket(packet))
+            {
+                for (uint32 lane = 0; lane < count; ++lane)
+                {
+                    if ((packet.hitMask >> lane) & 1)
+                    {
+                        RayTraceCollision& collision = collisions[lane];
+                        collision.renderObject = ro;
+                        collision.geometry = geo;
+                        collision.t = packet.t[lane];
+                        collision.triangleIndex = packet.triangleIndex[lane];
+                    }
+                }
+            }
+        }
+
+        if (ro->GetType() == RenderObject::TYPE_LANDSCAPE)
+        {
+            Landscape* landscape = static_cast<Landscape*>(ro);
+            for (uint32 lane = 0; lane < count; ++lane)
+            {
+                if ((packet.activeMask >> lane) & 1)
+                {
+                    Ray3 rayInObjectSpace(Vector3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]),
+                                          Vector3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]));
+                    float32 currentT;
+                    if (landscape->RayTrace(rayInObjectSpace, currentT) && currentT < collisions[lane].t)
+                    {
+                        RayTraceCollision& collision = collisions[lane];
+                        collision.renderObject = ro;
+                        collision.geometry = nullptr;
+                        collision.t = currentT;
+                        collision.triangleIndex = 0;
+                    }
+                }
+            }
+        }
+    }
+}
+}
+
+uint32 RenderHierarchy::RayTraceBatch(const Ray3* rays, uint32 count, RayTraceCollision* collisions, const Vector<RenderObject*>& ignoreObjects)
+{
+    using namespace RenderHierarchyDetails;
+
+    const uint32 packetsCount = (count + RAY_PACKET_SIZE - 1) / RAY_PACKET_SIZE;
+
+    // broad phase on calling thread, hierarchies are not required to be thread safe
+    batchCandidates.clear();
+    batchCandidatesOffsets.resize(packetsCount + 1);
+    for (uint32 p = 0; p < packetsCount; ++p)
+    {
+        AABBox3 packetBox;
+        for (uint32 i = p * RAY_PACKET_SIZE, end = Min(count, (p + 1) * RAY_PACKET_SIZE); i < end; ++i)
+        {
+            packetBox.AddPoint(rays[i].origin);
+            packetBox.AddPoint(rays[i].origin + rays[i].direction);
+
+            collisions[i] = RayTraceCollision();
+            collisions[i].t = 1.0f;
+        }
+
+        size_t first = batchCandidates.size();
+        batchCandidatesOffsets[p] = static_cast<uint32>(first);
+        GetAllObjectsInBBox(packetBox, batchCandidates);
+
+        auto isIgnored = [&ignoreObjects](RenderObject* ro) {
+            return std::find(ignoreObjects.begin(), ignoreObjects.end(), ro) != ignoreObjects.end();
+        };
+        batchCandidates.erase(std::remove_if(batchCandidates.begin() + first, batchCandidates.end(), isIgnored), batchCandidates.end());
+    }
+    batchCandidatesOffsets[packetsCount] = static_cast<uint32>(batchCandidates.size());
+
+    auto tracePackets = [this, rays, count, collisions](uint32 firstPacket, uint32 lastPacket) {
+        for (uint32 p = firstPacket; p < lastPacket; ++p)
+        {
+            uint32 firstRay = p * RAY_PACKET_SIZE;
+            uint32 candidatesOffset = batchCandidatesOffsets[p];
+            TracePacket(rays + firstRay, Min(count - firstRay, RAY_PACKET_SIZE),
+                        batchCandidates.data() + candidatesOffset, batchCandidatesOffsets[p + 1] - candidatesOffset, collisions + firstRay);
+        }
+    };
+
+    if (packetsCount <= PACKETS_PER_JOB)
+    {
+        tracePackets(0, packetsCount);
+    }
+    else
+    {
+        uint32 jobsCount = (packetsCount + PACKETS_PER_JOB - 1) / PACKETS_PER_JOB;
+        GetEngineContext()->jobManager->ParallelFor(jobsCount, [&tracePackets, packetsCount](uint32 job) {
+            uint32 firstPacket = job * PACKETS_PER_JOB;
+            tracePackets(firstPacket, Min(firstPacket + PACKETS_PER_JOB, packetsCount));
+        });
+    }
+
+    uint32 hitCount = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        hitCount += (collisions[i].renderObject != nullptr) ? 1 : 0;
+    }
+    return hitCount;
+}
+
 void LinearRenderHierarchy::AddRenderObject(RenderObject* object)
 {
     renderObjectArray.push_back(object);
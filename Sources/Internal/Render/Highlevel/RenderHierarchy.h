@@ -51,6 +51,19 @@ public:
     {
     }
     virtual const AABBox3& GetWorldBoundingBox() const = 0;
+
+    /**
+        Trace `count` segments from `rays[i].origin` to `rays[i].origin + rays[i].direction` and write closest
+        intersection of each one to `collisions[i]`, `renderObject` of collision is nullptr if nothing was hit.
+        Rays are processed in packets, coherent rays (e.g. from one emitter) should be adjacent in `rays`.
+        Candidates for each packet are collected with GetAllObjectsInBBox on calling thread, geometry of candidates
+        is traced on JobManager worker threads. Returns count of rays that hit something.
+    */
+    uint32 RayTraceBatch(const Ray3* rays, uint32 count, RayTraceCollision* collisions, const Vector<RenderObject*>& ignoreObjects);
+
+private:
+    Vector<RenderObject*> batchCandidates;
+    Vector<uint32> batchCandidatesOffsets;
 };
 
 class LinearRenderHierarchy : public RenderHierarchy
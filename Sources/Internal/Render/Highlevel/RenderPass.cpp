@@ -12,6 +12,7 @@
 
 #include "Render/Renderer.h"
 #include "Render/Texture.h"
+#include "Render/TextureStreaming.h"
 #include "Render/Image/ImageSystem.h"
 #include "Render/PixelFormatDescriptor.h"
 #include "Render/VisibilityQueryResults.h"
@@ -127,8 +128,10 @@ void RenderPass::PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSys
     PrepareLayersArrays(visibilityArray, camera);
 }
 
-void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera)
+void RenderPass::PrepareLayersArrays(const Vector<RenderObject*>& objectsArray, Camera* camera)
 {
+    const bool streamTextures = TextureStreaming::IsEnabled();
+
     size_t size = objectsArray.size();
     for (size_t ro = 0; ro < size; ++ro)
     {
@@ -138,6 +141,12 @@ void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, C
             renderObject->PrepareToRender(camera);
         }
 
+        float32 screenSize = 0.f;
+        if (streamTextures)
+        {
+            screenSize = TextureStreaming::CalculateScreenSize(renderObject->GetWorldBoundingBox(), camera);
+        }
+
         uint32 batchCount = renderObject->GetActiveRenderBatchCount();
         for (uint32 batchIndex = 0; batchIndex < batchCount; ++batchIndex)
         {
@@ -148,6 +157,11 @@ void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, C
             if (material->PreBuildMaterial(passName))
             {
                 layersBatchArrays[material->GetRenderLayerID()].AddRenderBatch(batch);
+
+                if (streamTextures)
+                {
+                    TextureStreaming::RequestTextures(material->GetActiveTextures(), screenSize);
+                }
             }
         }
     }
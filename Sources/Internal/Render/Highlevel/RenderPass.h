@@ -38,7 +38,7 @@ protected:
 
     /*convinience*/
     void PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSystem);
-    void PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera);
+    void PrepareLayersArrays(const Vector<RenderObject*>& objectsArray, Camera* camera);
     void ClearLayersArrays();
 
     void SetupCameraParams(Camera* mainCamera, Camera* drawCamera, Vector4* externalClipPlane = NULL);
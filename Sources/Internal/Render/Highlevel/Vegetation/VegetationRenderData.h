@@ -20,6 +20,18 @@ struct VegetationVertex
     Vector3 texCoord2;
 };
 
+/**
+ \brief Per-instance data of vegetation cell drawn with instanced render batch.
+    Replaces material properties set for each cell on the non-instanced path.
+ */
+struct VegetationInstanceData
+{
+    Vector3 tilePos; //cell position + distance scale
+    Vector2 switchLodScale;
+    Vector4 waveOffsetX;
+    Vector4 waveOffsetY;
+};
+
 /////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -12,6 +12,7 @@
 #include "Render/TextureDescriptor.h"
 #include "Time/SystemTimer.h"
 #include "Job/JobManager.h"
+#include "Engine/Engine.h"
 
 #include "Render/Highlevel/Vegetation/VegetationGeometry.h"
 #include "Render/Highlevel/RenderPassNames.h"
@@ -54,6 +55,11 @@ static const float32 MAX_VISIBLE_SCALING_DISTANCE = 40.0f * 40.0f;
 static const uint32 DENSITY_MAP_SIZE = 128;
 static const float32 DENSITY_THRESHOLD = 0.0f;
 
+static const uint32 CULLING_ROOTS_PER_JOB = 128;
+static const uint8 CULLED_ROOT_MASK = 0x80;
+
+static const uint32 MIN_INSTANCE_BUFFER_SIZE = 64 * sizeof(VegetationInstanceData);
+
 //static const float32 MAX_VISIBLE_CLIPPING_DISTANCE = 130.0f * 130.0f; //meters * meters (square length)
 //static const float32 MAX_VISIBLE_SCALING_DISTANCE = 100.0f * 100.0f;
 
@@ -152,6 +158,7 @@ VegetationRenderObject::~VegetationRenderObject()
         rhi::DeleteIndexBuffer(indexBuffer);
     }
 
+    ReleaseInstanceDataBuffers();
     SafeDelete(vegetationGeometry);
 
     SafeRelease(heightmap);
@@ -183,6 +190,45 @@ RenderBatch* VegetationRenderObject::CreateRenderBatch()
     return batch;
 }
 
+RenderBatch* VegetationRenderObject::CreateInstancedRenderBatch(uint32 resolutionIndex, uint32 rdoIndex)
+{
+    DVASSERT(renderData);
+
+    ScopedPtr<NMaterial> batchMaterial(new NMaterial());
+    batchMaterial->SetParent(renderData->GetMaterial());
+    batchMaterial->AddFlag(NMaterialFlagName::FLAG_VEGETATION_USE_INSTANCING, 1);
+
+    const VegetationBufferItem& bufferItem = renderData->GetIndexBuffers()[resolutionIndex][rdoIndex];
+
+    RenderBatch* batch = new RenderBatch();
+    batch->SetMaterial(batchMaterial);
+    batch->vertexBuffer = vertexBuffer;
+    batch->indexBuffer = indexBuffer;
+    batch->vertexCount = vertexCount;
+    batch->startIndex = bufferItem.startIndex;
+    batch->indexCount = bufferItem.indexCount;
+    batch->vertexLayoutId = instancedVertexLayoutUID;
+
+    return batch;
+}
+
+void VegetationRenderObject::ReleaseInstanceDataBuffers()
+{
+    for (InstanceDataBuffer* buffer : freeInstanceDataBuffers)
+    {
+        rhi::DeleteVertexBuffer(buffer->buffer);
+        SafeDelete(buffer);
+    }
+    freeInstanceDataBuffers.clear();
+
+    for (InstanceDataBuffer* buffer : usedInstanceDataBuffers)
+    {
+        rhi::DeleteVertexBuffer(buffer->buffer);
+        SafeDelete(buffer);
+    }
+    usedInstanceDataBuffers.clear();
+}
+
 RenderObject* VegetationRenderObject::Clone(RenderObject* newObject)
 {
     if (!newObject)
@@ -426,6 +472,22 @@ void VegetationRenderObject::PrepareToRender(Camera* camera)
         return;
     }
 
+    int64 prepareStartTime = SystemTimer::GetUs();
+
+    if (useInstancing)
+    {
+        PrepareInstancedRenderBatches();
+    }
+    else
+    {
+        PrepareCellRenderBatches();
+    }
+
+    prepareTime = (SystemTimer::GetUs() - prepareStartTime) / 1000.f;
+}
+
+void VegetationRenderObject::PrepareCellRenderBatches()
+{
     size_t visibleCellCount = visibleCells.size();
     size_t renderBatchCount = GetRenderBatchCount();
     while (renderBatchCount < visibleCellCount)
@@ -433,12 +495,10 @@ void VegetationRenderObject::PrepareToRender(Camera* camera)
         AddRenderBatch(ScopedPtr<RenderBatch>(CreateRenderBatch()));
         ++renderBatchCount;
     }
-    activeRenderBatchArray.clear();
     Vector<Vector<VegetationBufferItem>>& indexRenderDataObject = renderData->GetIndexBuffers();
 
-    Vector3 posScale(0.0f, 0.0f, 0.0f);
-    Vector2 switchLodScale;
-    Vector4 vegetationAnimationOffset[2];
+    VegetationInstanceData instanceData;
+    instancedCellCount = 0;
 
     for (size_t cellIndex = 0; cellIndex < visibleCellCount; ++cellIndex)
     {
@@ -460,34 +520,142 @@ void VegetationRenderObject::PrepareToRender(Camera* camera)
 
         activeRenderBatchArray.emplace_back(rb);
 
-        float32 distanceScale = 1.0f;
+        FillInstanceData(treeNode, resolutionIndex, &instanceData);
+
+        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_SWITCH_LOD_SCALE, instanceData.switchLodScale.data);
+        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_TILEPOS, instanceData.tilePos.data);
+        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_VEGWAVEOFFSET_X, instanceData.waveOffsetX.data);
+        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_VEGWAVEOFFSET_Y, instanceData.waveOffsetY.data);
+#ifdef VEGETATION_DRAW_LOD_COLOR
+        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_LOD_COLOR, RESOLUTION_COLOR[resolutionIndex].color);
+#endif
+    }
+}
+
+void VegetationRenderObject::PrepareInstancedRenderBatches()
+{
+    Vector<Vector<VegetationBufferItem>>& indexRenderDataObject = renderData->GetIndexBuffers();
+    uint32 resolutionCount = static_cast<uint32>(indexRenderDataObject.size());
 
-        if (treeNode->data.cameraDistance > visibleClippingDistances.y)
+    //VI: cells sharing resolution and index buffer range are drawn with single instanced batch
+    if (GetRenderBatchCount() < static_cast<uint32>(instancedCells.size()))
+    {
+        ClearRenderBatches();
+        for (uint32 resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
         {
-            distanceScale = Clamp(1.0f - ((treeNode->data.cameraDistance - visibleClippingDistances.y) / (visibleClippingDistances.x - visibleClippingDistances.y)), 0.0f, 1.0f);
+            uint32 rdoCount = static_cast<uint32>(indexRenderDataObject[resolutionIndex].size());
+            for (uint32 rdoIndex = 0; rdoIndex < rdoCount; ++rdoIndex)
+            {
+                AddRenderBatch(ScopedPtr<RenderBatch>(CreateInstancedRenderBatch(resolutionIndex, rdoIndex)));
+            }
         }
+    }
 
-        posScale.x = treeNode->data.bbox.min.x - unitWorldSize[resolutionIndex].x * (indexBufferIndex % RESOLUTION_TILES_PER_ROW[resolutionIndex]);
-        posScale.y = treeNode->data.bbox.min.y - unitWorldSize[resolutionIndex].y * (indexBufferIndex / RESOLUTION_TILES_PER_ROW[resolutionIndex]);
-        posScale.z = distanceScale;
+    for (Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cells : instancedCells)
+    {
+        cells.clear();
+    }
+
+    for (AbstractQuadTreeNode<VegetationSpatialData>* treeNode : visibleCells)
+    {
+        uint32 resolutionIndex = MapCellSquareToResolutionIndex(treeNode->data.width * treeNode->data.height);
+        uint32 rdoIndex = treeNode->data.rdoIndex;
+        DVASSERT(rdoIndex < indexRenderDataObject[resolutionIndex].size());
 
-        switchLodScale.x = float32(resolutionIndex);
-        switchLodScale.y = Clamp(1.0f - (treeNode->data.cameraDistance / resolutionRanges[resolutionIndex].y), 0.0f, 1.0f);
+        instancedCells[instancedBatchOffset[resolutionIndex] + rdoIndex].push_back(treeNode);
+    }
 
-        for (uint32 i = 0; i < 4; ++i)
+    for (int32 i = static_cast<int32>(usedInstanceDataBuffers.size()) - 1; i >= 0; --i)
+    {
+        if (rhi::SyncObjectSignaled(usedInstanceDataBuffers[i]->syncObject))
         {
-            Vector2 animationOffset = treeNode->data.animationOffset[i] * layersAnimationAmplitude.data[i];
-            vegetationAnimationOffset[0].data[i] = animationOffset.x;
-            vegetationAnimationOffset[1].data[i] = animationOffset.y;
+            freeInstanceDataBuffers.push_back(usedInstanceDataBuffers[i]);
+            RemoveExchangingWithLast(usedInstanceDataBuffers, i);
         }
+    }
 
-        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_SWITCH_LOD_SCALE, switchLodScale.data);
-        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_TILEPOS, posScale.data);
-        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_VEGWAVEOFFSET_X, vegetationAnimationOffset[0].data);
-        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_VEGWAVEOFFSET_Y, vegetationAnimationOffset[1].data);
-#ifdef VEGETATION_DRAW_LOD_COLOR
-        mat->SetPropertyValue(VegetationPropertyNames::UNIFORM_LOD_COLOR, RESOLUTION_COLOR[resolutionIndex].color);
-#endif
+    instancedCellCount = 0;
+
+    for (uint32 resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
+    {
+        uint32 rdoCount = static_cast<uint32>(indexRenderDataObject[resolutionIndex].size());
+        for (uint32 rdoIndex = 0; rdoIndex < rdoCount; ++rdoIndex)
+        {
+            uint32 batchIndex = instancedBatchOffset[resolutionIndex] + rdoIndex;
+            const Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cells = instancedCells[batchIndex];
+            if (cells.empty())
+            {
+                continue;
+            }
+
+            uint32 instanceCount = static_cast<uint32>(cells.size());
+            uint32 instanceDataSize = instanceCount * sizeof(VegetationInstanceData);
+
+            InstanceDataBuffer* instanceDataBuffer = nullptr;
+            for (size_t b = 0, count = freeInstanceDataBuffers.size(); b < count; ++b)
+            {
+                if (freeInstanceDataBuffers[b]->bufferSize >= instanceDataSize)
+                {
+                    instanceDataBuffer = freeInstanceDataBuffers[b];
+                    RemoveExchangingWithLast(freeInstanceDataBuffers, b);
+                    break;
+                }
+            }
+
+            if (instanceDataBuffer == nullptr)
+            {
+                rhi::VertexBuffer::Descriptor instanceBufferDesc;
+                instanceBufferDesc.size = Max(uint32(NextPowerOf2(int32(instanceDataSize))), MIN_INSTANCE_BUFFER_SIZE);
+                instanceBufferDesc.usage = rhi::USAGE_DYNAMICDRAW;
+                instanceBufferDesc.needRestore = false;
+
+                instanceDataBuffer = new InstanceDataBuffer();
+                instanceDataBuffer->bufferSize = instanceBufferDesc.size;
+                instanceDataBuffer->buffer = rhi::CreateVertexBuffer(instanceBufferDesc);
+            }
+            usedInstanceDataBuffers.push_back(instanceDataBuffer);
+            instanceDataBuffer->syncObject = rhi::GetCurrentFrameSyncObject();
+
+            VegetationInstanceData* instanceData = static_cast<VegetationInstanceData*>(rhi::MapVertexBuffer(instanceDataBuffer->buffer, 0, instanceDataSize));
+            for (uint32 i = 0; i < instanceCount; ++i)
+            {
+                FillInstanceData(cells[i], resolutionIndex, instanceData + i);
+            }
+            rhi::UnmapVertexBuffer(instanceDataBuffer->buffer);
+
+            RenderBatch* rb = GetRenderBatch(batchIndex);
+            rb->instanceBuffer = instanceDataBuffer->buffer;
+            rb->instanceCount = instanceCount;
+            activeRenderBatchArray.emplace_back(rb);
+
+            instancedCellCount += instanceCount;
+        }
+    }
+}
+
+void VegetationRenderObject::FillInstanceData(AbstractQuadTreeNode<VegetationSpatialData>* treeNode, uint32 resolutionIndex, VegetationInstanceData* instanceData)
+{
+    uint32 indexBufferIndex = treeNode->data.rdoIndex;
+
+    float32 distanceScale = 1.0f;
+
+    if (treeNode->data.cameraDistance > visibleClippingDistances.y)
+    {
+        distanceScale = Clamp(1.0f - ((treeNode->data.cameraDistance - visibleClippingDistances.y) / (visibleClippingDistances.x - visibleClippingDistances.y)), 0.0f, 1.0f);
+    }
+
+    instanceData->tilePos.x = treeNode->data.bbox.min.x - unitWorldSize[resolutionIndex].x * (indexBufferIndex % RESOLUTION_TILES_PER_ROW[resolutionIndex]);
+    instanceData->tilePos.y = treeNode->data.bbox.min.y - unitWorldSize[resolutionIndex].y * (indexBufferIndex / RESOLUTION_TILES_PER_ROW[resolutionIndex]);
+    instanceData->tilePos.z = distanceScale;
+
+    instanceData->switchLodScale.x = float32(resolutionIndex);
+    instanceData->switchLodScale.y = Clamp(1.0f - (treeNode->data.cameraDistance / resolutionRanges[resolutionIndex].y), 0.0f, 1.0f);
+
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        Vector2 animationOffset = treeNode->data.animationOffset[i] * layersAnimationAmplitude.data[i];
+        instanceData->waveOffsetX.data[i] = animationOffset.x;
+        instanceData->waveOffsetY.data[i] = animationOffset.y;
     }
 }
 
@@ -518,6 +686,39 @@ void VegetationRenderObject::BuildSpatialStructure()
 
     uint32 halfSize = mapSize >> 1;
     BuildSpatialQuad(node, NULL, -1 * halfSize, -1 * halfSize, mapSize, mapSize, node->data.bbox);
+
+    cullingRoots = CullingRoots();
+    BuildCullingRoots(node);
+
+    uint32 rootsCount = static_cast<uint32>(cullingRoots.nodes.size());
+    cullingRoots.planeMask.resize(rootsCount);
+    cullingRoots.chunkCells.resize((rootsCount + CULLING_ROOTS_PER_JOB - 1) / CULLING_ROOTS_PER_JOB);
+}
+
+void VegetationRenderObject::BuildCullingRoots(AbstractQuadTreeNode<VegetationSpatialData>* node)
+{
+    if (node->data.IsRenderable())
+    {
+        //VI: subtree of empty renderable node has no visible cells
+        if (node->data.isVisible)
+        {
+            const AABBox3& bbox = node->data.bbox;
+            cullingRoots.nodes.push_back(node);
+            cullingRoots.minX.push_back(bbox.min.x);
+            cullingRoots.minY.push_back(bbox.min.y);
+            cullingRoots.minZ.push_back(bbox.min.z);
+            cullingRoots.maxX.push_back(bbox.max.x);
+            cullingRoots.maxY.push_back(bbox.max.y);
+            cullingRoots.maxZ.push_back(bbox.max.z);
+        }
+    }
+    else if (!node->IsTerminalLeaf())
+    {
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            BuildCullingRoots(node->children[i]);
+        }
+    }
 }
 
 void VegetationRenderObject::BuildSpatialQuad(AbstractQuadTreeNode<VegetationSpatialData>* node, AbstractQuadTreeNode<VegetationSpatialData>* firstRenderableParent,
@@ -583,6 +784,8 @@ void VegetationRenderObject::BuildSpatialQuad(AbstractQuadTreeNode<VegetationSpa
 
 Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& VegetationRenderObject::BuildVisibleCellList(Camera* forCamera)
 {
+    int64 cullingStartTime = SystemTimer::GetUs();
+
     Vector3 camPos = forCamera->GetPosition();
     Vector3 camDir = forCamera->GetDirection();
     camDir.z = 0.0f;
@@ -590,21 +793,97 @@ Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& VegetationRenderObject::Bu
     camDir.Normalize();
     camPos = camPos + camDir * cameraBias;
 
-    uint8 planeMask = 0x3F;
     Vector3 cameraPosXY = camPos;
     cameraPosXY.z = 0.0f;
 
     visibleCells.clear();
 
-    BuildVisibleCellList(cameraPosXY, forCamera->GetFrustum(), planeMask, quadTree.GetRoot(), visibleCells, true);
+    Frustum* frustum = forCamera->GetFrustum();
+    uint32 rootsCount = static_cast<uint32>(cullingRoots.nodes.size());
+    uint32 chunksCount = static_cast<uint32>(cullingRoots.chunkCells.size());
+
+    if (chunksCount == 1)
+    {
+        ClassifyCullingRoots(cameraPosXY, frustum, 0, rootsCount);
+    }
+    else if (chunksCount > 1)
+    {
+        GetEngineContext()->jobManager->ParallelFor(chunksCount, [this, &cameraPosXY, frustum, rootsCount](uint32 chunk) {
+            uint32 firstRoot = chunk * CULLING_ROOTS_PER_JOB;
+            ClassifyCullingRoots(cameraPosXY, frustum, firstRoot, Min(firstRoot + CULLING_ROOTS_PER_JOB, rootsCount));
+        });
+    }
+
+    //VI: chunks are merged in tree order, so result doesn't depend on jobs scheduling
+    for (const Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cells : cullingRoots.chunkCells)
+    {
+        visibleCells.insert(visibleCells.end(), cells.begin(), cells.end());
+    }
+
+    cullingTime = (SystemTimer::GetUs() - cullingStartTime) / 1000.f;
 
     return visibleCells;
 }
 
+void VegetationRenderObject::ClassifyCullingRoots(const Vector3& cameraPoint, Frustum* frustum, uint32 beginIndex, uint32 endIndex)
+{
+    const float32* minX = cullingRoots.minX.data();
+    const float32* minY = cullingRoots.minY.data();
+    const float32* minZ = cullingRoots.minZ.data();
+    const float32* maxX = cullingRoots.maxX.data();
+    const float32* maxY = cullingRoots.maxY.data();
+    const float32* maxZ = cullingRoots.maxZ.data();
+    uint8* planeMask = cullingRoots.planeMask.data();
+
+    //VI: any cell of root is not closer to camera than nearest point of root box
+    float32 clippingDistance = visibleClippingDistances.x;
+    for (uint32 i = beginIndex; i < endIndex; ++i)
+    {
+        float32 dx = Max(Max(minX[i] - cameraPoint.x, cameraPoint.x - maxX[i]), 0.0f);
+        float32 dy = Max(Max(minY[i] - cameraPoint.y, cameraPoint.y - maxY[i]), 0.0f);
+        planeMask[i] = (dx * dx + dy * dy > clippingDistance) ? CULLED_ROOT_MASK : 0;
+    }
+
+    //VI: nearest and farthest box corners are selected once per plane, so inner loop is branchless
+    int32 planeCount = frustum->GetPlaneCount();
+    for (int32 p = 0; p < planeCount; ++p)
+    {
+        const Plane& plane = frustum->GetPlane(p);
+        uint8 planeBit = uint8(1 << p);
+
+        const float32* nearX = (plane.n.x >= 0.0f) ? minX : maxX;
+        const float32* nearY = (plane.n.y >= 0.0f) ? minY : maxY;
+        const float32* nearZ = (plane.n.z >= 0.0f) ? minZ : maxZ;
+        const float32* farX = (plane.n.x >= 0.0f) ? maxX : minX;
+        const float32* farY = (plane.n.y >= 0.0f) ? maxY : minY;
+        const float32* farZ = (plane.n.z >= 0.0f) ? maxZ : minZ;
+
+        for (uint32 i = beginIndex; i < endIndex; ++i)
+        {
+            float32 nearDistance = plane.n.x * nearX[i] + plane.n.y * nearY[i] + plane.n.z * nearZ[i] + plane.d;
+            float32 farDistance = plane.n.x * farX[i] + plane.n.y * farY[i] + plane.n.z * farZ[i] + plane.d;
+
+            planeMask[i] |= (nearDistance > 0.0f) ? CULLED_ROOT_MASK : 0;
+            planeMask[i] |= (farDistance >= 0.0f) ? planeBit : 0;
+        }
+    }
+
+    Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cellList = cullingRoots.chunkCells[beginIndex / CULLING_ROOTS_PER_JOB];
+    cellList.clear();
+
+    for (uint32 i = beginIndex; i < endIndex; ++i)
+    {
+        if ((planeMask[i] & CULLED_ROOT_MASK) == 0)
+        {
+            BuildVisibleCellList(cameraPoint, frustum, planeMask[i], cullingRoots.nodes[i], cellList, planeMask[i] != 0);
+        }
+    }
+}
+
 void VegetationRenderObject::BuildVisibleCellList(const Vector3& cameraPoint, Frustum* frustum, uint8 planeMask,
                                                   AbstractQuadTreeNode<VegetationSpatialData>* node, Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cellList, bool evaluateVisibility)
 {
-    static Array<Vector3, 4> corners;
+    Array<Vector3, 4> corners;
     if (node)
     {
         Frustum::eFrustumResult result = Frustum::EFR_INSIDE;
@@ -889,6 +1168,34 @@ void VegetationRenderObject::CreateRenderData()
     vertexLayout.AddElement(rhi::VS_TEXCOORD, 2, rhi::VDT_FLOAT, 3);
     vertexLayoutUID = rhi::VertexLayout::UniqueId(vertexLayout);
 
+    useInstancing = rhi::DeviceCaps().isInstancingSupported;
+    if (useInstancing)
+    {
+        rhi::VertexLayout instancedVertexLayout;
+        instancedVertexLayout.AddStream(rhi::VDF_PER_VERTEX);
+        instancedVertexLayout.AddElement(rhi::VS_POSITION, 0, rhi::VDT_FLOAT, 3);
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 0, rhi::VDT_FLOAT, 2);
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 1, rhi::VDT_FLOAT, 3);
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 2, rhi::VDT_FLOAT, 3);
+        instancedVertexLayout.AddStream(rhi::VDF_PER_INSTANCE);
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 3, rhi::VDT_FLOAT, 3); //tile position + distance scale
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 4, rhi::VDT_FLOAT, 2); //lod switch scale
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 5, rhi::VDT_FLOAT, 4); //wave offset x
+        instancedVertexLayout.AddElement(rhi::VS_TEXCOORD, 6, rhi::VDT_FLOAT, 4); //wave offset y
+        instancedVertexLayoutUID = rhi::VertexLayout::UniqueId(instancedVertexLayout);
+    }
+
+    const Vector<Vector<VegetationBufferItem>>& indexRenderDataObject = renderData->GetIndexBuffers();
+    uint32 instancedBatchCount = 0;
+    instancedBatchOffset.resize(indexRenderDataObject.size());
+    for (size_t resolutionIndex = 0; resolutionIndex < indexRenderDataObject.size(); ++resolutionIndex)
+    {
+        instancedBatchOffset[resolutionIndex] = instancedBatchCount;
+        instancedBatchCount += static_cast<uint32>(indexRenderDataObject[resolutionIndex].size());
+    }
+    instancedCells.clear();
+    instancedCells.resize(useInstancing ? instancedBatchCount : 0);
+
     ClearRenderBatches();
 }
 
@@ -1132,6 +1439,9 @@ void VegetationRenderObject::RecalcBoundingBox()
 void VegetationRenderObject::CollectMetrics(VegetationMetrics& metrics)
 {
     metrics.renderBatchCount = 0;
+    metrics.instancedCellCount = 0;
+    metrics.cullingTime = 0.f;
+    metrics.prepareTime = 0.f;
     metrics.totalQuadTreeLeafCount = 0;
 
     metrics.quadTreeLeafCountPerLOD.clear();
@@ -1156,7 +1466,10 @@ void VegetationRenderObject::CollectMetrics(VegetationMetrics& metrics)
 
         size_t visibleCellCount = visibleCells.size();
 
-        metrics.renderBatchCount = static_cast<uint32>(visibleCells.size());
+        metrics.renderBatchCount = static_cast<uint32>(useInstancing ? activeRenderBatchArray.size() : visibleCells.size());
+        metrics.instancedCellCount = instancedCellCount;
+        metrics.cullingTime = cullingTime;
+        metrics.prepareTime = prepareTime;
         metrics.totalQuadTreeLeafCount = static_cast<uint32>(visibleCellCount);
 
         size_t maxLodCount = RESOLUTION_CELL_SQUARE.size();
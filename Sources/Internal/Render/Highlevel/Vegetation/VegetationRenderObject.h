@@ -51,6 +51,10 @@ struct VegetationMetrics
     Vector<uint32> quadTreeLeafCountPerLOD;
 
     uint32 renderBatchCount;
+    uint32 instancedCellCount; //cells drawn through instanced render batches
+
+    float32 cullingTime; //ms, visible cells list build
+    float32 prepareTime; //ms, render batches and instance data preparation
 
     bool isValid = false;
 };
@@ -149,6 +153,12 @@ private:
     void RebuildCustomGeometry();
 
     RenderBatch* CreateRenderBatch();
+    RenderBatch* CreateInstancedRenderBatch(uint32 resolutionIndex, uint32 rdoIndex);
+
+    void PrepareCellRenderBatches();
+    void PrepareInstancedRenderBatches();
+    void FillInstanceData(AbstractQuadTreeNode<VegetationSpatialData>* treeNode, uint32 resolutionIndex, VegetationInstanceData* instanceData);
+    void ReleaseInstanceDataBuffers();
 
     bool IsValidGeometryData() const;
     bool IsValidSpatialData() const;
@@ -158,8 +168,12 @@ private:
     void BuildSpatialStructure();
     void BuildSpatialQuad(AbstractQuadTreeNode<VegetationSpatialData>* node, AbstractQuadTreeNode<VegetationSpatialData>* firstRenderableParent, int16 x, int16 y, uint16 width, uint16 height, AABBox3& parentBox);
 
+    void BuildCullingRoots(AbstractQuadTreeNode<VegetationSpatialData>* node);
+
     Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& BuildVisibleCellList(Camera* forCamera);
 
+    void ClassifyCullingRoots(const Vector3& cameraPoint, Frustum* frustum, uint32 beginIndex, uint32 endIndex);
+
     void BuildVisibleCellList(const Vector3& cameraPoint, Frustum* frustum, uint8 planeMask, AbstractQuadTreeNode<VegetationSpatialData>* node,
                               Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cellList, bool evaluateVisibility);
 
@@ -213,6 +227,38 @@ private:
     AbstractQuadTree<VegetationSpatialData> quadTree;
     Vector<AbstractQuadTreeNode<VegetationSpatialData>*> visibleCells;
 
+    /**
+        First renderable nodes of quad tree, culled in parallel before descending into renderable subtrees.
+        Bounding boxes are stored as separate component arrays to keep plane tests in tight loops.
+     */
+    struct CullingRoots
+    {
+        Vector<AbstractQuadTreeNode<VegetationSpatialData>*> nodes;
+        Vector<float32> minX, minY, minZ;
+        Vector<float32> maxX, maxY, maxZ;
+        Vector<uint8> planeMask; //planes intersecting box, highest bit is set for culled box
+        Vector<Vector<AbstractQuadTreeNode<VegetationSpatialData>*>> chunkCells;
+    };
+    CullingRoots cullingRoots;
+
+    struct InstanceDataBuffer
+    {
+        rhi::HVertexBuffer buffer;
+        rhi::HSyncObject syncObject;
+        uint32 bufferSize;
+    };
+
+    bool useInstancing = false;
+    uint32 instancedVertexLayoutUID = 0;
+    Vector<uint32> instancedBatchOffset; //index of first instanced batch for resolution
+    Vector<Vector<AbstractQuadTreeNode<VegetationSpatialData>*>> instancedCells; //instanced batch - cells
+    Vector<InstanceDataBuffer*> freeInstanceDataBuffers;
+    Vector<InstanceDataBuffer*> usedInstanceDataBuffers;
+    uint32 instancedCellCount = 0;
+
+    float32 cullingTime = 0.f;
+    float32 prepareTime = 0.f;
+
     FilePath heightmapPath;
     FilePath lightmapTexturePath;
 
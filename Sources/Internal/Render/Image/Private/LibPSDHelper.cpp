@@ -77,8 +77,33 @@ eErrorCode LibPSDHelper::WriteFileAsCubeMap(const FilePath& fileName, const Vect
 
 DAVA::ImageInfo LibPSDHelper::GetImageInfo(File* infile) const
 {
+    // header: signature "8BPS", version, 6 reserved bytes, channels count, height and width, big-endian
+    const uint32 headerSize = 26;
+    const uint32 heightOffset = 14;
+    const uint32 widthOffset = 18;
+
     ImageInfo info;
 
+    uint8 header[headerSize];
+    infile->Seek(0, File::SEEK_FROM_START);
+    uint32 readSize = infile->Read(header, headerSize);
+    infile->Seek(0, File::SEEK_FROM_START);
+
+    if (readSize == headerSize && memcmp(header, "8BPS", 4) == 0)
+    {
+        auto readBigEndian = [&header](uint32 offset) {
+            return (uint32(header[offset]) << 24) | (uint32(header[offset + 1]) << 16) | (uint32(header[offset + 2]) << 8) | uint32(header[offset + 3]);
+        };
+
+        // layers are read as RGBA8888 images of document size
+        info.height = readBigEndian(heightOffset);
+        info.width = readBigEndian(widthOffset);
+        info.format = FORMAT_RGBA8888;
+        info.dataSize = info.width * info.height * PixelFormatDescriptor::GetPixelFormatSizeInBits(FORMAT_RGBA8888) / 8;
+        info.mipmapsCount = 1;
+        info.faceCount = 1;
+    }
+
     return info;
 }
 };
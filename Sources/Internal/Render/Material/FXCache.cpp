@@ -6,8 +6,7 @@
 
 #include "Logger/Logger.h"
 #include "Utils/Utils.h"
-#include "FileSystem/YamlParser.h"
-#include "FileSystem/YamlNode.h"
+#include "FileSystem/YamlDocument.h"
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Concurrency/Mutex.h"
 #include "Concurrency/LockGuard.h"
@@ -96,28 +95,28 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
     }
 
     FilePath fxPath(fxName.c_str());
-    RefPtr<YamlParser> parser(YamlParser::Create(fxPath));
-    YamlNode* rootNode = nullptr;
-    if (parser)
+    RefPtr<YamlDocument> document(YamlDocument::Create(fxPath));
+    YamlDocument::Node rootNode;
+    if (document.Valid())
     {
-        rootNode = parser->GetRootNode();
+        rootNode = document->GetRootNode();
     }
-    if (!rootNode)
+    if (!rootNode.IsValid())
     {
         Logger::Error("Can't load requested old-material-template-into-fx: %s", fxPath.GetAbsolutePathname().c_str());
         return FXCacheDetails::defaultFX;
     }
 
-    const YamlNode* materialTemplateNode = rootNode->Get("MaterialTemplate");
-    const YamlNode* renderTechniqueNode = nullptr;
-    if (materialTemplateNode) //multy-quality material
+    YamlDocument::Node materialTemplateNode = rootNode.Get("MaterialTemplate");
+    YamlDocument::Node renderTechniqueNode;
+    if (materialTemplateNode.IsValid()) //multy-quality material
     {
-        const YamlNode* qualityNode = nullptr;
+        YamlDocument::Node qualityNode;
         if (quality.IsValid())
         {
-            qualityNode = materialTemplateNode->Get(quality.c_str());
+            qualityNode = materialTemplateNode.Get(quality.c_str());
         }
-        if (qualityNode == nullptr)
+        if (!qualityNode.IsValid())
         {
             if ((quality.c_str() == nullptr) || (strlen(quality.c_str()) == 0))
             {
@@ -129,20 +128,20 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
                 Logger::Error("Template: %s do not support quality %s - loading first one.",
                               fxPath.GetAbsolutePathname().c_str(), quality.c_str());
             }
-            qualityNode = materialTemplateNode->Get(materialTemplateNode->GetCount() - 1);
+            qualityNode = materialTemplateNode.Get(materialTemplateNode.GetCount() - 1);
         }
-        RefPtr<YamlParser> parserTechnique(YamlParser::Create(qualityNode->AsString()));
-        if (parserTechnique)
+        RefPtr<YamlDocument> techniqueDocument(YamlDocument::Create(FilePath(qualityNode.AsString())));
+        if (techniqueDocument.Valid())
         {
-            renderTechniqueNode = parserTechnique->GetRootNode();
+            renderTechniqueNode = techniqueDocument->GetRootNode();
         }
-        if (!renderTechniqueNode)
+        if (!renderTechniqueNode.IsValid())
         {
             Logger::Error("Can't load technique from template: %s with quality %s", fxPath.GetAbsolutePathname().c_str(), quality.c_str());
             return FXCacheDetails::defaultFX;
         }
 
-        parser = parserTechnique;
+        document = techniqueDocument;
     }
     else //technique
     {
@@ -150,8 +149,8 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
     }
 
     //now load render technique
-    const YamlNode* stateNode = renderTechniqueNode->Get("RenderTechnique");
-    if (stateNode == nullptr)
+    YamlDocument::Node stateNode = renderTechniqueNode.Get("RenderTechnique");
+    if (!stateNode.IsValid())
     {
         return FXCacheDetails::defaultFX;
     }
@@ -161,67 +160,67 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
 
     RenderLayer::eRenderLayerID renderLayer = RenderLayer::RENDER_LAYER_OPAQUE_ID;
 
-    const YamlNode* layersNode = stateNode->Get("Layers");
-    if (layersNode)
+    YamlDocument::Node layersNode = stateNode.Get("Layers");
+    if (layersNode.IsValid())
     {
-        int32 count = layersNode->GetCount();
+        int32 count = layersNode.GetCount();
         DVASSERT(count == 1);
-        renderLayer = RenderLayer::GetLayerIDByName(FastName(layersNode->Get(0)->AsString().c_str()));
+        renderLayer = RenderLayer::GetLayerIDByName(FastName(layersNode.Get(0u).AsString().c_str()));
     }
 
-    for (uint32 k = 0; k < stateNode->GetCount(); ++k)
+    for (uint32 k = 0; k < stateNode.GetCount(); ++k)
     {
-        if (stateNode->GetItemKeyName(k) == "RenderPass")
+        if (strcmp(stateNode.GetItemKeyName(k), "RenderPass") == 0)
         {
             RenderPassDescriptor passDescriptor;
             passDescriptor.renderLayer = renderLayer;
 
-            const YamlNode* renderPassNode = stateNode->Get(k);
+            YamlDocument::Node renderPassNode = stateNode.Get(k);
 
             //name
-            const YamlNode* renderPassNameNode = renderPassNode->Get("Name");
-            if (renderPassNameNode)
+            YamlDocument::Node renderPassNameNode = renderPassNode.Get("Name");
+            if (renderPassNameNode.IsValid())
             {
-                passDescriptor.passName = renderPassNameNode->AsFastName();
+                passDescriptor.passName = renderPassNameNode.AsFastName();
             }
 
             //shader
-            const YamlNode* shaderNode = renderPassNode->Get("Shader");
-            if (!shaderNode)
+            YamlDocument::Node shaderNode = renderPassNode.Get("Shader");
+            if (!shaderNode.IsValid())
             {
                 Logger::Error("RenderPass:%s does not have shader", passDescriptor.passName.c_str());
                 break;
             }
-            passDescriptor.shaderFileName = shaderNode->AsFastName();
+            passDescriptor.shaderFileName = shaderNode.AsFastName();
 
-            const YamlNode* definesNode = renderPassNode->Get("UniqueDefines");
-            if (definesNode)
+            YamlDocument::Node definesNode = renderPassNode.Get("UniqueDefines");
+            if (definesNode.IsValid())
             {
-                int32 count = definesNode->GetCount();
+                int32 count = definesNode.GetCount();
                 for (int32 k = 0; k < count; ++k)
                 {
-                    const YamlNode* singleDefineNode = definesNode->Get(k);
-                    passDescriptor.templateDefines[FastName(singleDefineNode->AsString().c_str())] = 1;
+                    YamlDocument::Node singleDefineNode = definesNode.Get(k);
+                    passDescriptor.templateDefines[FastName(singleDefineNode.AsString().c_str())] = 1;
                 }
             }
 
             //state
-            const YamlNode* renderStateNode = renderPassNode->Get("RenderState");
-            if (renderStateNode)
+            YamlDocument::Node renderStateNode = renderPassNode.Get("RenderState");
+            if (renderStateNode.IsValid())
             {
-                const YamlNode* stateNode = renderStateNode->Get("state");
-                if (stateNode)
+                YamlDocument::Node stateNode = renderStateNode.Get("state");
+                if (stateNode.IsValid())
                 {
                     Vector<String> states;
-                    Split(stateNode->AsString(), "| ", states);
+                    Split(stateNode.AsString(), "| ", states);
                     passDescriptor.depthStateDescriptor.depthTestEnabled = false;
                     passDescriptor.depthStateDescriptor.depthWriteEnabled = false;
                     passDescriptor.cullMode = rhi::CULL_NONE;
                     bool hasBlend = false;
-                    const YamlNode* fillMode = renderStateNode->Get("fillMode");
-                    if (fillMode)
+                    YamlDocument::Node fillMode = renderStateNode.Get("fillMode");
+                    if (fillMode.IsValid())
                     {
-                        if (fillMode->AsString() == "FILLMODE_WIREFRAME")
+                        if (fillMode.AsString() == "FILLMODE_WIREFRAME")
                             passDescriptor.wireframe = true;
                     }
                     for (auto& state : states)
@@ -233,10 +232,10 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
                         else if (state == "STATE_CULL")
                         {
                             passDescriptor.cullMode = rhi::CULL_CW; //default
-                            const YamlNode* cullModeNode = renderStateNode->Get("cullMode");
-                            if (cullModeNode)
+                            YamlDocument::Node cullModeNode = renderStateNode.Get("cullMode");
+                            if (cullModeNode.IsValid())
                             {
-                                if (cullModeNode->AsString() == "FACE_FRONT")
+                                if (cullModeNode.AsString() == "FACE_FRONT")
                                     passDescriptor.cullMode = rhi::CULL_CCW;
                             }
                         }
@@ -247,83 +246,83 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
                         else if (state == "STATE_DEPTH_TEST")
                         {
                             passDescriptor.depthStateDescriptor.depthTestEnabled = true;
-                            const YamlNode* depthFuncNode = renderStateNode->Get("depthFunc");
-                            if (depthFuncNode)
+                            YamlDocument::Node depthFuncNode = renderStateNode.Get("depthFunc");
+                            if (depthFuncNode.IsValid())
                             {
-                                passDescriptor.depthStateDescriptor.depthFunc = GetCmpFuncByName(depthFuncNode->AsString());
+                                passDescriptor.depthStateDescriptor.depthFunc = GetCmpFuncByName(depthFuncNode.AsString());
                             }
                         }
                         else if (state == "STATE_STENCIL_TEST")
                         {
                             passDescriptor.depthStateDescriptor.stencilEnabled = 1;
 
-                            const YamlNode* stencilNode = renderStateNode->Get("stencil");
-                            if (stencilNode)
+                            YamlDocument::Node stencilNode = renderStateNode.Get("stencil");
+                            if (stencilNode.IsValid())
                             {
-                                const YamlNode* stencilRefNode = stencilNode->Get("ref");
-                                if (stencilRefNode)
+                                YamlDocument::Node stencilRefNode = stencilNode.Get("ref");
+                                if (stencilRefNode.IsValid())
                                 {
-                                    uint8 refValue = static_cast<uint8>(stencilRefNode->AsInt32());
+                                    uint8 refValue = static_cast<uint8>(stencilRefNode.AsInt32());
                                     passDescriptor.depthStateDescriptor.stencilBack.refValue = refValue;
                                     passDescriptor.depthStateDescriptor.stencilFront.refValue = refValue;
                                 }
 
-                                const YamlNode* stencilMaskNode = stencilNode->Get("mask");
-                                if (stencilMaskNode)
+                                YamlDocument::Node stencilMaskNode = stencilNode.Get("mask");
+                                if (stencilMaskNode.IsValid())
                                 {
-                                    uint8 maskValue = static_cast<uint8>(stencilMaskNode->AsInt32());
+                                    uint8 maskValue = static_cast<uint8>(stencilMaskNode.AsInt32());
                                     passDescriptor.depthStateDescriptor.stencilBack.readMask = maskValue;
                                     passDescriptor.depthStateDescriptor.stencilBack.writeMask = maskValue;
                                     passDescriptor.depthStateDescriptor.stencilFront.readMask = maskValue;
                                     passDescriptor.depthStateDescriptor.stencilFront.writeMask = maskValue;
                                 }
 
-                                const YamlNode* stencilFuncNode = stencilNode->Get("funcFront");
-                                if (stencilFuncNode)
+                                YamlDocument::Node stencilFuncNode = stencilNode.Get("funcFront");
+                                if (stencilFuncNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilFront.func = GetCmpFuncByName(stencilFuncNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilFront.func = GetCmpFuncByName(stencilFuncNode.AsString());
                                 }
 
-                                stencilFuncNode = stencilNode->Get("funcBack");
-                                if (stencilFuncNode)
+                                stencilFuncNode = stencilNode.Get("funcBack");
+                                if (stencilFuncNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilBack.func = GetCmpFuncByName(stencilFuncNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilBack.func = GetCmpFuncByName(stencilFuncNode.AsString());
                                 }
 
-                                const YamlNode* stencilPassNode = stencilNode->Get("passFront");
-                                if (stencilPassNode)
+                                YamlDocument::Node stencilPassNode = stencilNode.Get("passFront");
+                                if (stencilPassNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilFront.depthStencilPassOperation = GetStencilOpByName(stencilPassNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilFront.depthStencilPassOperation = GetStencilOpByName(stencilPassNode.AsString());
                                 }
 
-                                stencilPassNode = stencilNode->Get("passBack");
-                                if (stencilPassNode)
+                                stencilPassNode = stencilNode.Get("passBack");
+                                if (stencilPassNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilBack.depthStencilPassOperation = GetStencilOpByName(stencilPassNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilBack.depthStencilPassOperation = GetStencilOpByName(stencilPassNode.AsString());
                                 }
 
-                                const YamlNode* stencilFailNode = stencilNode->Get("failFront");
-                                if (stencilFailNode)
+                                YamlDocument::Node stencilFailNode = stencilNode.Get("failFront");
+                                if (stencilFailNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilFront.failOperation = GetStencilOpByName(stencilFailNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilFront.failOperation = GetStencilOpByName(stencilFailNode.AsString());
                                 }
 
-                                stencilFailNode = stencilNode->Get("failBack");
-                                if (stencilFailNode)
+                                stencilFailNode = stencilNode.Get("failBack");
+                                if (stencilFailNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilBack.failOperation = GetStencilOpByName(stencilFailNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilBack.failOperation = GetStencilOpByName(stencilFailNode.AsString());
                                 }
 
-                                const YamlNode* stencilZFailNode = stencilNode->Get("zFailFront");
-                                if (stencilZFailNode)
+                                YamlDocument::Node stencilZFailNode = stencilNode.Get("zFailFront");
+                                if (stencilZFailNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilFront.depthFailOperation = GetStencilOpByName(stencilZFailNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilFront.depthFailOperation = GetStencilOpByName(stencilZFailNode.AsString());
                                 }
 
-                                stencilZFailNode = stencilNode->Get("zFailBack");
-                                if (stencilZFailNode)
+                                stencilZFailNode = stencilNode.Get("zFailBack");
+                                if (stencilZFailNode.IsValid())
                                 {
-                                    passDescriptor.depthStateDescriptor.stencilBack.depthFailOperation = GetStencilOpByName(stencilZFailNode->AsString());
+                                    passDescriptor.depthStateDescriptor.stencilBack.depthFailOperation = GetStencilOpByName(stencilZFailNode.AsString());
                                 }
                             }
 
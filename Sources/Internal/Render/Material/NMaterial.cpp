@@ -1005,6 +1005,7 @@ void NMaterial::RebuildTextureBindings()
         //release existing
         rhi::ReleaseTextureSet(currRenderVariant->textureSet);
         rhi::ReleaseSamplerState(currRenderVariant->samplerState);
+        currRenderVariant->textures.clear();
 
         ShaderDescriptor* currShader = currRenderVariant->shader;
         if (!currShader->IsValid()) //cant build for empty shader
@@ -1026,6 +1027,7 @@ void NMaterial::RebuildTextureBindings()
                 {
                     textureDescr.fragmentTexture[i] = tex->handle;
                     samplerDescr.fragmentSampler[i] = tex->samplerState;
+                    currRenderVariant->textures.push_back(tex);
                 }
                 else
                 {
@@ -1053,6 +1055,7 @@ void NMaterial::RebuildTextureBindings()
             {
                 textureDescr.vertexTexture[i] = tex->handle;
                 samplerDescr.vertexSampler[i] = tex->samplerState;
+                currRenderVariant->textures.push_back(tex);
             }
             else
             {
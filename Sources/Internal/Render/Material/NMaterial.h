@@ -70,6 +70,7 @@ class RenderVariantInstance
     Vector<rhi::HConstBuffer> fragmentConstBuffers;
 
     Vector<MaterialBufferBinding*> materialBufferBindings;
+    Vector<Texture*> textures; // static textures bound to texture set
 
     uint32 renderLayer = 0;
     bool wireFrame = false;
@@ -183,6 +184,9 @@ public:
     // later add engine flags here
     bool PreBuildMaterial(const FastName& passName);
 
+    // static textures of active variant, valid after PreBuildMaterial
+    inline const Vector<Texture*>& GetActiveTextures() const;
+
     // RHI_COMPLETE - it's temporary solution to avoid FX loading and shaders compilation after loading
     void PreCacheFX();
     void PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName = FastName());
@@ -287,6 +291,12 @@ uint32 NMaterial::GetSortingKey() const
     return sortingKey;
 }
 
+const Vector<Texture*>& NMaterial::GetActiveTextures() const
+{
+    DVASSERT(activeVariantInstance != nullptr);
+    return activeVariantInstance->textures;
+}
+
 inline uint32 NMaterial::GetCurrentConfigIndex() const
 {
     return currentConfig;
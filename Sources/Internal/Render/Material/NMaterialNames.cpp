@@ -207,6 +207,8 @@ const FastName NMaterialFlagName::FLAG_LANDSCAPE_USE_INSTANCING("LANDSCAPE_USE_I
 const FastName NMaterialFlagName::FLAG_LANDSCAPE_LOD_MORPHING("LANDSCAPE_LOD_MORPHING");
 const FastName NMaterialFlagName::FLAG_LANDSCAPE_MORPHING_COLOR("LANDSCAPE_MORPHING_COLOR");
 
+const FastName NMaterialFlagName::FLAG_VEGETATION_USE_INSTANCING("VEGETATION_USE_INSTANCING");
+
 const FastName NMaterialFlagName::FLAG_HEIGHTMAP_FLOAT_TEXTURE("HEIGHTMAP_FLOAT_TEXTURE");
 
 const FastName NMaterialFlagName::FLAG_ILLUMINATION_USED = FastName("ILLUMINATION_USED");
@@ -245,6 +247,8 @@ Vector<FastName> RUNTIME_ONLY_FLAGS =
   NMaterialFlagName::FLAG_LANDSCAPE_LOD_MORPHING,
   NMaterialFlagName::FLAG_LANDSCAPE_MORPHING_COLOR,
 
+  NMaterialFlagName::FLAG_VEGETATION_USE_INSTANCING,
+
   NMaterialFlagName::FLAG_HEIGHTMAP_FLOAT_TEXTURE,
 };
 
@@ -14,6 +14,9 @@ using DAVA::DynamicMemoryFile;
 #include "Debug/ProfilerCPU.h"
 #include "Concurrency/Mutex.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Base/ScopedPtr.h"
+#include "Utils/MD5.h"
 using DAVA::Mutex;
 using DAVA::LockGuard;
 
@@ -139,6 +142,7 @@ private:
 };
 
 static ShaderFileCallback ShaderSourceFileCallback("~res:/Materials/Shaders");
+static Mutex shaderPreProcMutex;
 
 //==============================================================================
 
@@ -168,11 +172,11 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText)
 
 //------------------------------------------------------------------------------
 
-bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines)
+bool ShaderSource::PreProcess(const char* srcText, const std::vector<std::string>& defines, std::vector<char>* output)
 {
-    bool success = false;
+    // include-files callback is shared and caches files content, so pre-processing is serialized
+    LockGuard<Mutex> guard(shaderPreProcMutex);
     DAVA::PreProc pre_proc(&ShaderSourceFileCallback);
-    std::vector<char> src;
 
     DVASSERT(defines.size() % 2 == 0);
     for (size_t i = 0, n = defines.size() / 2; i != n; ++i)
@@ -182,7 +186,30 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
         pre_proc.AddDefine(name, value);
     }
 
-    if (pre_proc.Process(srcText, &src))
+    return pre_proc.Process(srcText, output);
+}
+
+//------------------------------------------------------------------------------
+
+bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines)
+{
+    std::vector<char> src;
+
+    if (!PreProcess(srcText, defines, &src))
+    {
+        DAVA::Logger::Error("failed to pre-process source-text");
+        return false;
+    }
+
+    return ConstructPreprocessed(progType, src, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+bool ShaderSource::ConstructPreprocessed(ProgType progType, const std::vector<char>& src, Api targetApi)
+{
+    bool success = false;
+
     {
         #if RHI_DUMP_SHADERSOURCE
         {
@@ -257,7 +284,7 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
                 InlineFunctions();
 
             // ugly workaround to save some memory
-            GetSourceCode(HostApi());
+            GetSourceCode(targetApi);
             delete ast;
             ast = nullptr;
         }
@@ -268,10 +295,6 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
             DAVA::Logger::Error("failed to parse shader source-text");
         }
     }
-    else
-    {
-        DAVA::Logger::Error("failed to pre-process source-text");
-    }
 
     return success;
 }
@@ -1742,10 +1765,11 @@ const DAVA::String& ShaderSource::GetSourceCode(Api targetApi) const
 
     if (code[targetApi].empty() && (ast != nullptr))
     {
-        static sl::Allocator alloc;
-        static sl::HLSLGenerator hlsl_gen(&alloc);
-        static sl::GLESGenerator gles_gen(&alloc);
-        static sl::MSLGenerator mtl_gen(&alloc);
+        // generators keep state while generating, so they are not shared between threads
+        sl::Allocator alloc;
+        sl::HLSLGenerator hlsl_gen(&alloc);
+        sl::GLESGenerator gles_gen(&alloc);
+        sl::MSLGenerator mtl_gen(&alloc);
 
         bool codeGenerated = false;
         const char* main = (type == PROG_VERTEX) ? "vp_main" : "fp_main";
@@ -1898,11 +1922,13 @@ void ShaderSource::Reset()
 
 void ShaderSource::AddIncludeDirectory(const char* dir)
 {
+    LockGuard<Mutex> guard(shaderPreProcMutex);
     ShaderSourceFileCallback.AddIncludeDirectory(dir);
 }
 
 void ShaderSource::PurgeIncludesCache()
 {
+    LockGuard<Mutex> guard(shaderPreProcMutex);
     ShaderSourceFileCallback.ClearCache();
 }
 
@@ -2048,9 +2074,9 @@ const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 //------------------------------------------------------------------------------
 const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines)
 {
-    ShaderSource* src = new ShaderSource(filename);
+    ShaderSource* src = Translate(filename, progType, srcText, defines, HostApi());
 
-    if (src->Construct(progType, srcText, defines))
+    if (src)
     {
         LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
@@ -2081,10 +2107,109 @@ const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, P
             Entry.push_back(e);
         }
     }
-    else
+
+    return src;
+}
+
+//------------------------------------------------------------------------------
+
+static Mutex translationCacheMutex;
+static DAVA::FilePath translationCacheDirectory;
+
+void ShaderSourceCache::SetTranslationCacheDirectory(const DAVA::FilePath& dir)
+{
+    LockGuard<Mutex> guard(translationCacheMutex);
+
+    translationCacheDirectory = dir;
+    if (!translationCacheDirectory.IsEmpty())
+    {
+        translationCacheDirectory.MakeDirectoryPathname();
+        DAVA::FileSystem::Instance()->CreateDirectory(translationCacheDirectory, true);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+DAVA::String ShaderSourceCache::GetTranslationKey(ProgType progType, Api targetApi, const std::vector<char>& preprocessedText)
+{
+    const uint32 header[] = { FormatVersion, uint32(targetApi), uint32(progType) };
+
+    DAVA::MD5 md5;
+    md5.Init();
+    md5.Update(reinterpret_cast<const DAVA::uint8*>(header), sizeof(header));
+    md5.Update(reinterpret_cast<const DAVA::uint8*>(preprocessedText.data()), uint32(preprocessedText.size()));
+    md5.Final();
+
+    return DAVA::MD5::HashToString(md5.GetDigest());
+}
+
+//------------------------------------------------------------------------------
+
+DAVA::FilePath ShaderSourceCache::GetTranslationPath(const DAVA::String& key)
+{
+    LockGuard<Mutex> guard(translationCacheMutex);
+
+    if (translationCacheDirectory.IsEmpty())
+        return DAVA::FilePath();
+
+    return translationCacheDirectory + (key + ".shader");
+}
+
+//------------------------------------------------------------------------------
+
+ShaderSource* ShaderSourceCache::Translate(const char* filename, ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api targetApi, bool* fromCache)
+{
+    using namespace DAVA;
+
+    if (fromCache)
+        *fromCache = false;
+
+    std::vector<char> text;
+    if (!ShaderSource::PreProcess(srcText, defines, &text))
+    {
+        Logger::Error("failed to pre-process source-text");
+        return nullptr;
+    }
+
+    FilePath path = GetTranslationPath(GetTranslationKey(progType, targetApi, text));
+    ShaderSource* src = new ShaderSource(filename);
+
+    if (!path.IsEmpty())
+    {
+        ScopedPtr<File> in(File::Create(path, File::READ | File::OPEN));
+        uint32 formatVersion = 0;
+        if (in && ReadUI4(in, &formatVersion) && formatVersion == FormatVersion && src->Load(targetApi, in))
+        {
+            if (fromCache)
+                *fromCache = true;
+            return src;
+        }
+    }
+
+    if (!src->ConstructPreprocessed(progType, text, targetApi))
     {
         delete src;
-        src = nullptr;
+        return nullptr;
+    }
+
+    if (!path.IsEmpty())
+    {
+        // write to unique temporary file and then move it, so concurrent writers and readers never see partial entry
+        FilePath tempPath = path + Format(".%llu.tmp", Thread::GetCurrentIdAsUInt64());
+        bool saved = false;
+        {
+            ScopedPtr<File> out(File::Create(tempPath, File::WRITE | File::CREATE));
+            saved = out && WriteUI4(out, FormatVersion) && src->Save(targetApi, out);
+        }
+
+        if (saved)
+            saved = FileSystem::Instance()->MoveFile(tempPath, path, true);
+
+        if (!saved)
+        {
+            FileSystem::Instance()->DeleteFile(tempPath);
+            Logger::Warning("failed to save translated shader to %s", path.GetStringValue().c_str());
+        }
     }
 
     return src;
@@ -8,6 +8,7 @@
 namespace DAVA
 {
 class File;
+class FilePath;
 }
 
 namespace sl
@@ -74,6 +75,7 @@ public:
     bool Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines);
     void InlineFunctions();
     bool Construct(ProgType progType, const char* srcText);
+    bool ConstructPreprocessed(ProgType progType, const std::vector<char>& preprocessedText, Api targetApi);
     bool Load(Api api, DAVA::File* in);
     bool Save(Api api, DAVA::File* out) const;
 
@@ -86,6 +88,7 @@ public:
     ShaderProp::Source ConstBufferSource(uint32 bufIndex) const;
     BlendState Blending() const;
 
+    static bool PreProcess(const char* srcText, const std::vector<std::string>& defines, std::vector<char>* output);
     static void PurgeIncludesCache();
     static void AddIncludeDirectory(const char* dir);
     void Dump() const;
@@ -127,6 +130,16 @@ public:
     static void Save(const char* fileName);
     static void Load(const char* fileName);
 
+    // Translation cache is a directory of files named by MD5 of format version, target api,
+    // program type and pre-processed source text (so defines and included files are taken into account).
+    // Such files don't depend on machine or host api and can be shared between developers and build agents.
+    static void SetTranslationCacheDirectory(const DAVA::FilePath& dir);
+    static DAVA::String GetTranslationKey(ProgType progType, Api targetApi, const std::vector<char>& preprocessedText);
+    static DAVA::FilePath GetTranslationPath(const DAVA::String& key);
+
+    // Translates source for `targetApi` using translation cache; is thread-safe, caller owns returned object.
+    static ShaderSource* Translate(const char* filename, ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api targetApi, bool* fromCache = nullptr);
+
 private:
     struct
     entry_t
@@ -9,6 +9,7 @@
 #include "Render/PixelFormatDescriptor.h"
 #include "Render/Image/Image.h"
 #include "Render/Texture.h"
+#include "Render/TextureStreaming.h"
 #include "Concurrency/Mutex.h"
 #include "Concurrency/LockGuard.h"
 #include "Platform/DeviceInfo.h"
@@ -121,6 +122,7 @@ void Uninitialize()
     DVASSERT(RendererDetails::initialized);
 
     VisibilityQueryResults::Cleanup();
+    TextureStreaming::Clear();
     FXCache::Uninitialize();
     ShaderDescriptorCache::Uninitialize();
     rhi::ShaderCache::Unitialize();
@@ -211,6 +213,7 @@ void BeginFrame()
     RendererDetails::ProcessSignals();
 
     DynamicBufferAllocator::BeginFrame();
+    TextureStreaming::BeginFrame();
 }
 
 void EndFrame()
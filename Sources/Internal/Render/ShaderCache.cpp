@@ -1,6 +1,7 @@
 #include "Render/ShaderCache.h"
 #include "Render/RHI/rhi_ShaderCache.h"
 #include "FileSystem/FileSystem.h"
+#include "Base/ScopedPtr.h"
 #include "Concurrency/LockGuard.h"
 #include "Logger/Logger.h"
 #include "Utils/StringFormat.h"
@@ -179,6 +180,39 @@ void SetLoadingNotifyEnabled(bool enable)
     loadingNotifyEnabled = enable;
 }
 
+void SaveVariantsList(const FilePath& path)
+{
+    DVASSERT(initialized);
+
+    Set<String> variants;
+    {
+        LockGuard<Mutex> guard(shaderCacheMutex);
+        for (const auto& it : shaderDescriptors)
+        {
+            Map<String, int32> sortedDefines;
+            for (const auto& define : it.second->defines)
+                sortedDefines.emplace(define.first.c_str(), define.second);
+
+            String line(it.second->sourceName.c_str());
+            for (const auto& define : sortedDefines)
+                line += Format(" %s=%d", define.first.c_str(), define.second);
+
+            variants.insert(line);
+        }
+    }
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    if (file)
+    {
+        for (const String& line : variants)
+            file->WriteLine(line);
+    }
+    else
+    {
+        Logger::Error("Failed to save shader variants list to %s", path.GetAbsolutePathname().c_str());
+    }
+}
+
 
 #define DUMP_SOURCES 0
 #define TRACE_CACHE_USAGE 0
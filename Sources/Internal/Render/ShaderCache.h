@@ -16,6 +16,9 @@ void ClearDynamicBindigs();
 void ReloadShaders();
 
 void SetLoadingNotifyEnabled(bool enable);
+
+// Writes every requested shader variant as `name DEFINE=value ...` line, list is used to pre-translate shaders offline.
+void SaveVariantsList(const FilePath& path);
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 Vector<size_t> BuildFlagsKey(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 size_t GetUniqueFlagKey(FastName flagName);
@@ -11,6 +11,7 @@
 #include "FileSystem/FileSystem.h"
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Render/RenderHelper.h"
+#include "Render/TextureStreaming.h"
 
 #if defined(__DAVAENGINE_IPHONE__)
 #include <CoreGraphics/CoreGraphics.h>
@@ -237,6 +238,7 @@ Texture::Texture()
     , textureType(rhi::TEXTURE_TYPE_2D)
     , isRenderTarget(false)
     , isPink(false)
+    , isStreamed(false)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
@@ -247,6 +249,10 @@ Texture::Texture()
 Texture::~Texture()
 {
     Renderer::GetSignals().needRestoreResources.Disconnect(this);
+    if (isStreamed)
+    {
+        TextureStreaming::UnregisterTexture(this);
+    }
     ReleaseTextureData();
     SafeDelete(texDescriptor);
 }
@@ -427,6 +433,7 @@ Texture* Texture::CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu)
 
     Texture* texture = new Texture();
     texture->texDescriptor->Initialize(descriptor);
+    texture->SetupStreaming(gpu);
 
     Vector<Image*>* images = new Vector<Image*>();
 
@@ -459,15 +466,27 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
+    if (!LoadImages(texDescriptor, gpu, GetBaseMipMap() + streamingMip, images))
+    {
+        return false;
+    }
+
+    isPink = false;
+    state = STATE_DATA_LOADED;
+
+    return true;
+}
+
+bool Texture::LoadImages(const TextureDescriptor* texDescriptor, eGPUFamily gpu, uint32 baseMipMap, Vector<Image*>* images)
+{
     DVASSERT(gpu != GPU_INVALID);
 
-    if (!IsLoadAvailable(gpu))
+    if (!IsLoadAvailable(texDescriptor, gpu))
     {
         Logger::Error("[Texture::LoadImages] Load not available: invalid requested GPU family (%s)", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu));
         return false;
     }
 
-    uint32 baseMipMap = GetBaseMipMap();
     ImageSystem::LoadingParams params;
     params.baseMipmap = baseMipMap;
     params.firstMipmapIndex = 0;
@@ -580,9 +599,6 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
         }
     }
 
-    isPink = false;
-    state = STATE_DATA_LOADED;
-
     return true;
 }
 
@@ -592,6 +608,48 @@ void Texture::ReleaseImages(Vector<Image*>* images)
     images->clear();
 }
 
+void Texture::SetupStreaming(eGPUFamily gpu)
+{
+    if (isStreamed)
+    {
+        TextureStreaming::UnregisterTexture(this);
+        isStreamed = false;
+    }
+    streamingMip = 0;
+
+    if (TextureStreaming::IsEnabled() && texDescriptor->GetQualityGroup().IsValid())
+    {
+        uint32 fullWidth = 0;
+        uint32 fullHeight = 0;
+        streamingMip = TextureStreaming::GetInitialMip(texDescriptor, gpu, GetBaseMipMap(), fullWidth, fullHeight);
+        if (streamingMip > 0)
+        {
+            TextureStreaming::RegisterTexture(this, gpu, fullWidth, fullHeight, streamingMip);
+            isStreamed = true;
+        }
+    }
+}
+
+void Texture::ResetStreaming()
+{
+    isStreamed = false;
+}
+
+void Texture::ApplyStreamedImages(uint32 mip, Vector<Image*>* images)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+    DVASSERT(isStreamed);
+
+    rhi::HTexture oldHandle = handle;
+    ReleaseTextureData();
+
+    streamingMip = mip;
+    SetParamsFromImages(images);
+    FlushDataToRenderer(images);
+
+    rhi::ReplaceTextureInAllTextureSets(oldHandle, handle);
+}
+
 void Texture::SetParamsFromImages(const Vector<Image*>* images)
 {
     DVASSERT(images->size() != 0);
@@ -827,6 +885,7 @@ void Texture::ReloadAs(eGPUFamily gpuFamily)
     bool loaded = false;
     if (descriptorReloaded && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::TEXTURE_LOAD_ENABLED))
     {
+        SetupStreaming(gpuForLoading);
         loaded = LoadImages(gpuForLoading, images);
     }
 
@@ -848,6 +907,11 @@ void Texture::ReloadAs(eGPUFamily gpuFamily)
 }
 
 bool Texture::IsLoadAvailable(const eGPUFamily gpuFamily) const
+{
+    return IsLoadAvailable(texDescriptor, gpuFamily);
+}
+
+bool Texture::IsLoadAvailable(const TextureDescriptor* texDescriptor, const eGPUFamily gpuFamily)
 {
     if (texDescriptor->IsCompressedFile())
     {
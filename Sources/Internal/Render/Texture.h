@@ -188,6 +188,21 @@ public:
 
     static eGPUFamily GetGPUForLoading(const eGPUFamily requestedGPU, const TextureDescriptor* descriptor);
 
+    /**
+        Load images of `descriptor` for `gpu` starting from `baseMipMap` level.
+        Doesn't touch any texture, so can be used from worker threads with own copy of descriptor.
+    */
+    static bool LoadImages(const TextureDescriptor* descriptor, eGPUFamily gpu, uint32 baseMipMap, Vector<Image*>* images);
+
+    /** Returns true if high mips of texture are loaded by TextureStreaming */
+    inline bool IsStreamed() const;
+    /** Count of high mips skipped by TextureStreaming */
+    inline uint32 GetStreamingMip() const;
+
+    /** Recreate texture from `images` loaded by TextureStreaming starting from `mip` level, takes ownership of `images` */
+    void ApplyStreamedImages(uint32 mip, Vector<Image*>* images);
+    void ResetStreaming();
+
 protected:
     void RestoreRenderResource();
 
@@ -199,11 +214,13 @@ protected:
 
     bool LoadImages(eGPUFamily gpu, Vector<Image*>* images);
 
+    void SetupStreaming(eGPUFamily gpu);
+
     void SetParamsFromImages(const Vector<Image*>* images);
 
     void FlushDataToRenderer(Vector<Image*>* images);
 
-    void ReleaseImages(Vector<Image*>* images);
+    static void ReleaseImages(Vector<Image*>* images);
 
     void MakePink(bool checkers = true);
 
@@ -211,6 +228,7 @@ protected:
     virtual ~Texture();
 
     bool IsLoadAvailable(const eGPUFamily gpuFamily) const;
+    static bool IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily);
 
 public: // properties for fast access
     rhi::HTexture handle;
@@ -229,6 +247,9 @@ public: // properties for fast access
 
     bool isRenderTarget : 1;
     bool isPink : 1;
+    bool isStreamed : 1;
+
+    uint32 streamingMip = 0;
 
     FastName debugInfo;
 
@@ -258,6 +279,16 @@ inline TextureDescriptor* Texture::GetDescriptor() const
 {
     return texDescriptor;
 }
+
+inline bool Texture::IsStreamed() const
+{
+    return isStreamed;
+}
+
+inline uint32 Texture::GetStreamingMip() const
+{
+    return streamingMip;
+}
 };
 
 #endif // __DAVAENGINE_TEXTUREGLES_H__
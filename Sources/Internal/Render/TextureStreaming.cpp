@@ -0,0 +1,506 @@
+#include "Render/TextureStreaming.h"
+#include "Render/Texture.h"
+#include "Render/TextureDescriptor.h"
+#include "Render/Renderer.h"
+#include "Render/PixelFormatDescriptor.h"
+#include "Render/Highlevel/Camera.h"
+#include "Render/Image/Image.h"
+#include "Render/Image/ImageSystem.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Thread.h"
+#include "Concurrency/UniqueLock.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+namespace TextureStreaming
+{
+namespace TextureStreamingDetails
+{
+const uint32 MAX_LOADING_TASKS = 4;
+const uint32 MAX_APPLIED_TASKS_PER_FRAME = 4; // creation of rhi textures is spread over frames to avoid hitches
+const uint32 UNUSED_FRAMES_BEFORE_EVICTION = 120;
+const float32 SCREEN_SIZE_TO_TEXTURE_SIZE = 2.f; // textures are usually tiled over objects, so required size is greater than object size
+
+struct StreamedTexture
+{
+    uint32 registrationId = 0;
+    eGPUFamily gpu = GPU_INVALID;
+    uint32 fullWidth = 0;
+    uint32 fullHeight = 0;
+    uint32 bitsPerPixel = 0;
+    uint32 residentMip = 0; // lowest resolution mip, always kept in memory
+    uint32 loadedMip = 0;
+    uint32 desiredMip = 0;
+    uint32 lastUsedFrame = 0;
+    float32 requestedSize = 0.f;
+    bool loading = false;
+};
+
+struct LoadingTask
+{
+    Texture* texture = nullptr;
+    uint32 registrationId = 0;
+    TextureDescriptor descriptor;
+    eGPUFamily gpu = GPU_INVALID;
+    uint32 baseMipMap = 0;
+    uint32 mip = 0;
+    Vector<Image*>* images = nullptr;
+    bool loaded = false;
+};
+
+bool enabled = false;
+uint64 memoryBudget = DEFAULT_MEMORY_BUDGET;
+uint64 residentSize = 0; // size of loaded mips and mips being loaded
+uint32 frameIndex = 0;
+uint32 registrationsCount = 0;
+uint32 loadingTasksCount = 0;
+
+UnorderedMap<Texture*, StreamedTexture> textures;
+
+// Mips are read and decoded on own thread instead of shared worker jobs,
+// so streaming never delays jobs which are waited for during frame
+Thread* loaderThread = nullptr;
+Mutex loadingQueueMutex;
+ConditionVariable loadingQueueCV;
+Deque<LoadingTask*> loadingQueue;
+
+Mutex completedTasksMutex;
+Vector<LoadingTask*> completedTasks;
+
+uint64 GetMipChainSize(const StreamedTexture& streamedTexture, uint32 mip)
+{
+    uint64 width = Max(streamedTexture.fullWidth >> mip, 1u);
+    uint64 height = Max(streamedTexture.fullHeight >> mip, 1u);
+    return width * height * streamedTexture.bitsPerPixel / 8 * 4 / 3;
+}
+
+void LoaderThreadFunc()
+{
+    Thread* thread = Thread::Current();
+    while (true)
+    {
+        LoadingTask* task = nullptr;
+        {
+            UniqueLock<Mutex> lock(loadingQueueMutex);
+            while (loadingQueue.empty() && !thread->IsCancelling())
+            {
+                loadingQueueCV.Wait(lock);
+            }
+
+            if (thread->IsCancelling())
+            {
+                break;
+            }
+
+            task = loadingQueue.front();
+            loadingQueue.pop_front();
+        }
+
+        task->loaded = Texture::LoadImages(&task->descriptor, task->gpu, task->baseMipMap, task->images);
+
+        LockGuard<Mutex> lock(completedTasksMutex);
+        completedTasks.push_back(task);
+    }
+}
+
+void StopLoaderThread()
+{
+    if (loaderThread != nullptr)
+    {
+        {
+            LockGuard<Mutex> lock(loadingQueueMutex);
+            loaderThread->Cancel();
+        }
+        loadingQueueCV.NotifyAll();
+        loaderThread->Join();
+        SafeRelease(loaderThread);
+    }
+}
+
+void StartLoading(Texture* texture, StreamedTexture& streamedTexture, uint32 mip)
+{
+    DVASSERT(streamedTexture.loading == false);
+
+    LoadingTask* task = new LoadingTask();
+    task->texture = SafeRetain(texture);
+    task->registrationId = streamedTexture.registrationId;
+    task->descriptor.Initialize(texture->GetDescriptor());
+    task->gpu = streamedTexture.gpu;
+    task->baseMipMap = texture->GetBaseMipMap() + mip;
+    task->mip = mip;
+    task->images = new Vector<Image*>();
+
+    streamedTexture.loading = true;
+    ++loadingTasksCount;
+
+    if (loaderThread == nullptr)
+    {
+        loaderThread = Thread::Create(&LoaderThreadFunc);
+        loaderThread->SetName("DAVA::TextureStreaming");
+        loaderThread->Start();
+    }
+
+    {
+        LockGuard<Mutex> lock(loadingQueueMutex);
+        loadingQueue.push_back(task);
+    }
+    loadingQueueCV.NotifyOne();
+}
+
+void ReleaseTask(LoadingTask* task)
+{
+    if (task->images != nullptr)
+    {
+        for (Image* image : *task->images)
+        {
+            SafeRelease(image);
+        }
+        SafeDelete(task->images);
+    }
+    SafeRelease(task->texture);
+    delete task;
+}
+
+void ApplyCompletedTasks()
+{
+    Vector<LoadingTask*> tasks;
+    {
+        LockGuard<Mutex> lock(completedTasksMutex);
+        size_t count = Min(completedTasks.size(), static_cast<size_t>(MAX_APPLIED_TASKS_PER_FRAME));
+        tasks.assign(completedTasks.begin(), completedTasks.begin() + count);
+        completedTasks.erase(completedTasks.begin(), completedTasks.begin() + count);
+    }
+
+    for (LoadingTask* task : tasks)
+    {
+        DVASSERT(loadingTasksCount > 0);
+        --loadingTasksCount;
+
+        auto found = textures.find(task->texture);
+        if (found != textures.end() && found->second.registrationId == task->registrationId)
+        {
+            StreamedTexture& streamedTexture = found->second;
+            streamedTexture.loading = false;
+
+            uint64 reservedSize = GetMipChainSize(streamedTexture, Min(task->mip, streamedTexture.loadedMip));
+            uint64 appliedSize = GetMipChainSize(streamedTexture, streamedTexture.loadedMip);
+            if (task->loaded)
+            {
+                appliedSize = GetMipChainSize(streamedTexture, task->mip);
+                streamedTexture.loadedMip = task->mip;
+                task->texture->ApplyStreamedImages(task->mip, task->images);
+                task->images = nullptr; // images are released by texture
+            }
+            else
+            {
+                Logger::Warning("[TextureStreaming] Can't load mip %u of %s", task->mip, task->descriptor.pathname.GetStringValue().c_str());
+            }
+
+            DVASSERT(residentSize >= reservedSize);
+            residentSize = residentSize - reservedSize + appliedSize;
+        }
+        // else texture was unregistered or reloaded during loading, so loaded data is outdated
+
+        ReleaseTask(task);
+    }
+}
+
+void UpdateDesiredMips()
+{
+    for (auto& entry : textures)
+    {
+        StreamedTexture& streamedTexture = entry.second;
+        if (streamedTexture.lastUsedFrame + 1 == frameIndex)
+        {
+            streamedTexture.desiredMip = GetMipForScreenSize(streamedTexture.fullWidth, streamedTexture.fullHeight, streamedTexture.residentMip, streamedTexture.requestedSize);
+        }
+        else if (frameIndex - streamedTexture.lastUsedFrame > UNUSED_FRAMES_BEFORE_EVICTION)
+        {
+            streamedTexture.desiredMip = streamedTexture.residentMip;
+        }
+        streamedTexture.requestedSize = 0.f;
+    }
+}
+
+// Start unloading of high mips of textures that are not needed at loaded resolution, least recently used first.
+// Memory is returned to budget when lower mips are loaded
+void EvictTextures(uint64 sizeToFree)
+{
+    Vector<std::pair<Texture*, StreamedTexture*>> candidates;
+    for (auto& entry : textures)
+    {
+        StreamedTexture& streamedTexture = entry.second;
+        if (!streamedTexture.loading && streamedTexture.desiredMip > streamedTexture.loadedMip)
+        {
+            candidates.emplace_back(entry.first, &streamedTexture);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<Texture*, StreamedTexture*>& l, const std::pair<Texture*, StreamedTexture*>& r) {
+        return l.second->lastUsedFrame < r.second->lastUsedFrame;
+    });
+
+    uint64 freedSize = 0;
+    for (const std::pair<Texture*, StreamedTexture*>& candidate : candidates)
+    {
+        if (freedSize >= sizeToFree || loadingTasksCount >= MAX_LOADING_TASKS)
+        {
+            break;
+        }
+
+        StreamedTexture& streamedTexture = *candidate.second;
+        freedSize += GetMipChainSize(streamedTexture, streamedTexture.loadedMip) - GetMipChainSize(streamedTexture, streamedTexture.desiredMip);
+        StartLoading(candidate.first, streamedTexture, streamedTexture.desiredMip);
+    }
+}
+
+void StartLoadingTasks()
+{
+    if (residentSize > memoryBudget)
+    {
+        EvictTextures(residentSize - memoryBudget);
+    }
+
+    if (loadingTasksCount >= MAX_LOADING_TASKS)
+    {
+        return;
+    }
+
+    Vector<std::pair<Texture*, StreamedTexture*>> candidates;
+    for (auto& entry : textures)
+    {
+        StreamedTexture& streamedTexture = entry.second;
+        if (!streamedTexture.loading && streamedTexture.desiredMip < streamedTexture.loadedMip)
+        {
+            candidates.emplace_back(entry.first, &streamedTexture);
+        }
+    }
+
+    // textures with greatest lack of resolution first
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<Texture*, StreamedTexture*>& l, const std::pair<Texture*, StreamedTexture*>& r) {
+        uint32 lackL = l.second->loadedMip - l.second->desiredMip;
+        uint32 lackR = r.second->loadedMip - r.second->desiredMip;
+        return (lackL != lackR) ? (lackL > lackR) : (l.second->lastUsedFrame > r.second->lastUsedFrame);
+    });
+
+    for (const std::pair<Texture*, StreamedTexture*>& candidate : candidates)
+    {
+        if (loadingTasksCount >= MAX_LOADING_TASKS)
+        {
+            break;
+        }
+
+        StreamedTexture& streamedTexture = *candidate.second;
+        uint64 requiredSize = GetMipChainSize(streamedTexture, streamedTexture.desiredMip) - GetMipChainSize(streamedTexture, streamedTexture.loadedMip);
+        if (residentSize + requiredSize > memoryBudget)
+        {
+            EvictTextures(residentSize + requiredSize - memoryBudget);
+            break;
+        }
+
+        residentSize += requiredSize;
+        StartLoading(candidate.first, streamedTexture, streamedTexture.desiredMip);
+    }
+}
+}
+
+void SetEnabled(bool enabled)
+{
+    TextureStreamingDetails::enabled = enabled;
+}
+
+bool IsEnabled()
+{
+    return TextureStreamingDetails::enabled;
+}
+
+void SetMemoryBudget(uint64 budget)
+{
+    TextureStreamingDetails::memoryBudget = budget;
+}
+
+uint64 GetMemoryBudget()
+{
+    return TextureStreamingDetails::memoryBudget;
+}
+
+float32 CalculateScreenSize(const AABBox3& worldBox, Camera* camera)
+{
+    const float32 framebufferHeight = static_cast<float32>(Renderer::GetFramebufferHeight());
+    if (camera->GetIsOrtho())
+    {
+        return framebufferHeight;
+    }
+
+    const float32 radius = (worldBox.max - worldBox.min).Length() * 0.5f;
+    const float32 distance = Max((worldBox.GetCenter() - camera->GetPosition()).Length() - radius, camera->GetZNear());
+
+    // _11 of projection matrix is cotangent of half of vertical field of view
+    return radius * camera->GetProjectionMatrix()._11 * framebufferHeight / distance;
+}
+
+uint32 GetMipForScreenSize(uint32 fullWidth, uint32 fullHeight, uint32 residentMip, float32 screenSize)
+{
+    const uint32 textureSize = Max(fullWidth, fullHeight);
+    const float32 requiredSize = screenSize * TextureStreamingDetails::SCREEN_SIZE_TO_TEXTURE_SIZE;
+
+    uint32 mip = 0;
+    while (mip < residentMip && static_cast<float32>(textureSize >> (mip + 1)) >= requiredSize)
+    {
+        ++mip;
+    }
+    return mip;
+}
+
+void RequestTextures(const Vector<Texture*>& requestedTextures, float32 screenSize)
+{
+    using namespace TextureStreamingDetails;
+
+    for (Texture* texture : requestedTextures)
+    {
+        if (texture->IsStreamed())
+        {
+            auto found = textures.find(texture);
+            DVASSERT(found != textures.end());
+
+            StreamedTexture& streamedTexture = found->second;
+            streamedTexture.requestedSize = Max(streamedTexture.requestedSize, screenSize);
+            streamedTexture.lastUsedFrame = frameIndex;
+        }
+    }
+}
+
+uint32 GetInitialMip(const TextureDescriptor* descriptor, eGPUFamily gpu, uint32 baseMipMap, uint32& fullWidth, uint32& fullHeight)
+{
+    if (descriptor->IsCubeMap() || descriptor->GetGenerateMipMaps() || !GPUFamilyDescriptor::IsGPUForDevice(gpu))
+    {
+        return 0;
+    }
+
+    Vector<FilePath> singleMipFiles;
+    descriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
+    const uint32 singleMipCount = static_cast<uint32>(singleMipFiles.size());
+
+    ImageInfo info = ImageSystem::GetImageInfo(descriptor->CreateMultiMipPathnameForGPU(gpu));
+    if (info.IsEmpty() || info.mipmapsCount < 2)
+    {
+        return 0;
+    }
+
+    const uint32 levelsCount = singleMipCount + info.mipmapsCount;
+    if (baseMipMap >= levelsCount)
+    {
+        return 0;
+    }
+
+    fullWidth = (info.width << singleMipCount) >> baseMipMap;
+    fullHeight = (info.height << singleMipCount) >> baseMipMap;
+
+    uint32 mip = 0;
+    while ((baseMipMap + mip + 1) < levelsCount && Max(fullWidth >> mip, fullHeight >> mip) > RESIDENT_MIP_SIZE && Min(fullWidth >> (mip + 1), fullHeight >> (mip + 1)) >= Texture::MINIMAL_WIDTH)
+    {
+        ++mip;
+    }
+    return mip;
+}
+
+void RegisterTexture(Texture* texture, eGPUFamily gpu, uint32 fullWidth, uint32 fullHeight, uint32 initialMip)
+{
+    using namespace TextureStreamingDetails;
+
+    DVASSERT(textures.count(texture) == 0);
+
+    StreamedTexture& streamedTexture = textures[texture];
+    streamedTexture.registrationId = ++registrationsCount;
+    streamedTexture.gpu = gpu;
+    streamedTexture.fullWidth = fullWidth;
+    streamedTexture.fullHeight = fullHeight;
+    streamedTexture.bitsPerPixel = PixelFormatDescriptor::GetPixelFormatSizeInBits(texture->GetDescriptor()->GetPixelFormatForGPU(gpu));
+    streamedTexture.residentMip = initialMip;
+    streamedTexture.loadedMip = initialMip;
+    streamedTexture.desiredMip = initialMip;
+    streamedTexture.lastUsedFrame = frameIndex;
+
+    residentSize += GetMipChainSize(streamedTexture, initialMip);
+}
+
+void UnregisterTexture(Texture* texture)
+{
+    using namespace TextureStreamingDetails;
+
+    auto found = textures.find(texture);
+    if (found != textures.end())
+    {
+        StreamedTexture& streamedTexture = found->second;
+
+        uint64 size = GetMipChainSize(streamedTexture, streamedTexture.loadedMip);
+        if (streamedTexture.loading)
+        {
+            // loading task reserved memory for higher mips
+            size = Max(size, GetMipChainSize(streamedTexture, streamedTexture.desiredMip));
+        }
+
+        residentSize -= Min(residentSize, size);
+        textures.erase(found);
+    }
+}
+
+void BeginFrame()
+{
+    using namespace TextureStreamingDetails;
+
+    ApplyCompletedTasks();
+
+    if (!textures.empty())
+    {
+        UpdateDesiredMips();
+        StartLoadingTasks();
+    }
+
+    ++frameIndex;
+}
+
+void Clear()
+{
+    using namespace TextureStreamingDetails;
+
+    StopLoaderThread();
+
+    for (LoadingTask* task : loadingQueue)
+    {
+        ReleaseTask(task);
+    }
+    loadingQueue.clear();
+
+    for (LoadingTask* task : completedTasks)
+    {
+        ReleaseTask(task);
+    }
+    completedTasks.clear();
+    loadingTasksCount = 0;
+
+    for (auto& entry : textures)
+    {
+        entry.first->ResetStreaming();
+    }
+    textures.clear();
+    residentSize = 0;
+}
+
+Statistics GetStatistics()
+{
+    using namespace TextureStreamingDetails;
+
+    Statistics statistics;
+    statistics.texturesCount = static_cast<uint32>(textures.size());
+    statistics.loadingTasksCount = loadingTasksCount;
+    statistics.residentSize = residentSize;
+    statistics.memoryBudget = memoryBudget;
+    return statistics;
+}
+}
+}
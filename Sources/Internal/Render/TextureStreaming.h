@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/AABBox3.h"
+#include "Render/GPUFamilyDescriptor.h"
+
+namespace DAVA
+{
+class Camera;
+class Texture;
+class TextureDescriptor;
+
+/**
+    \ingroup render
+    Streaming of mip levels for scene textures.
+
+    When streaming is enabled, textures of materials (textures with quality group) are created with small mips only,
+    higher mips are loaded by ImageSystem on streaming thread according to screen size of objects that use texture.
+    Screen size is requested by render passes for visible batches every frame. Textures which haven't been
+    requested for a while or are required at lower resolution drop high mips when memory budget is exceeded.
+*/
+namespace TextureStreaming
+{
+static const uint32 RESIDENT_MIP_SIZE = 64; //!< mips of this size and lower are loaded synchronously and never evicted
+static const uint64 DEFAULT_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+struct Statistics
+{
+    uint32 texturesCount = 0;
+    uint32 loadingTasksCount = 0;
+    uint64 residentSize = 0; //!< estimated size of loaded mips of streamed textures
+    uint64 memoryBudget = 0;
+};
+
+/** Enable streaming for textures created after this call */
+void SetEnabled(bool enabled);
+bool IsEnabled();
+
+void SetMemoryBudget(uint64 budget);
+uint64 GetMemoryBudget();
+
+/** Returns diameter in pixels of `worldBox` projected with `camera` */
+float32 CalculateScreenSize(const AABBox3& worldBox, Camera* camera);
+
+/** Returns mip level of `fullWidth` x `fullHeight` texture enough for object of `screenSize` pixels, but not lower than `residentMip` */
+uint32 GetMipForScreenSize(uint32 fullWidth, uint32 fullHeight, uint32 residentMip, float32 screenSize);
+
+/** Request streamed `textures` to be loaded with resolution enough for object of `screenSize` pixels */
+void RequestTextures(const Vector<Texture*>& textures, float32 screenSize);
+
+/**
+    Returns count of high mip levels that should be skipped at creation of `descriptor` texture,
+    or 0 if texture can't be streamed. Also returns size of texture without skipped levels.
+*/
+uint32 GetInitialMip(const TextureDescriptor* descriptor, eGPUFamily gpu, uint32 baseMipMap, uint32& fullWidth, uint32& fullHeight);
+
+void RegisterTexture(Texture* texture, eGPUFamily gpu, uint32 fullWidth, uint32 fullHeight, uint32 initialMip);
+void UnregisterTexture(Texture* texture);
+
+/** Apply loaded mips and start new loading tasks, should be called once per frame from main thread */
+void BeginFrame();
+void Clear();
+
+Statistics GetStatistics();
+}
+}
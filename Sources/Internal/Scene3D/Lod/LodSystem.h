@@ -9,12 +9,29 @@
 namespace DAVA
 {
 class Camera;
+class Transform;
 class LodComponent;
 class ParticleEffectComponent;
 
+/**
+    Selects lod layers of entities with LodComponent.
+
+    Every frame camera distances are evaluated for all lod entities at once, on worker jobs when there are many of them.
+    Only entities whose lod layer changed are then updated on the calling thread.
+
+    In `LOD_SELECTION_SCREEN_SIZE` mode squared camera distance is scaled by `(referenceRadius / radius)^2`,
+    where `radius` is radius of entity bounding sphere. Lod distances are treated as distances for object of `referenceRadius`
+    size, so bigger objects keep detailed layers longer and smaller objects switch to coarse layers earlier.
+*/
 class LodSystem : public SceneSystem
 {
 public:
+    enum eLodSelectionMode
+    {
+        LOD_SELECTION_DISTANCE = 0,
+        LOD_SELECTION_SCREEN_SIZE,
+    };
+
     LodSystem(Scene* scene);
 
     void Process(float32 timeElapsed) override;
@@ -31,38 +48,95 @@ public:
     void SetForceLodDistance(LodComponent* forComponent, float32 distance);
     float32 GetForceLodDistance(LodComponent* forComponent);
 
+    void SetLodSelectionMode(eLodSelectionMode mode);
+    eLodSelectionMode GetLodSelectionMode() const;
+
+    /** Set radius of object for which lod distances are specified in `LOD_SELECTION_SCREEN_SIZE` mode. */
+    void SetScreenSizeReferenceRadius(float32 radius);
+    float32 GetScreenSizeReferenceRadius() const;
+
 private:
     struct SlowStruct
     {
-        Array<float32, LodComponent::MAX_LOD_LAYERS> farSquares;
         Array<float32, LodComponent::MAX_LOD_LAYERS> nearSquares;
         Entity* entity = nullptr;
         int32 forceLodLayer = LodComponent::INVALID_LOD_LAYER;
         float32 forceLodDistance = LodComponent::INVALID_DISTANCE;
         LodComponent* lod = nullptr;
         ParticleEffectComponent* effect = nullptr;
+        float32 localRadius = 0.f;
         bool recursiveUpdate = false;
     };
     Vector<SlowStruct> slowVector;
 
-    struct FastStruct
+    enum eFastFlags : uint8
     {
-        float32 farSquare0;
-        Vector3 position;
-        int32 currentLod;
-        float32 nearSquare;
-        float32 farSquare;
-        bool effectStopped : 1;
-        bool isEffect : 1;
+        EFFECT_STOPPED = 1 << 0,
+        IS_EFFECT = 1 << 1,
     };
-    Vector<FastStruct> fastVector;
+
+    /**
+        Data read by per-frame evaluation. Every field is stored in separate array indexed the same way as `slowVector`.
+    */
+    struct FastArrays
+    {
+        Vector<float32> positionX;
+        Vector<float32> positionY;
+        Vector<float32> positionZ;
+        Vector<float32> distanceScale; //1 or (referenceRadius / radius)^2 in screen size mode
+        Vector<float32> nearSquare; //hysteresis range of current lod
+        Vector<float32> farSquare;
+        Vector<Array<float32, LodComponent::MAX_LOD_LAYERS>> farSquares;
+        Vector<int32> currentLod;
+        Vector<uint8> flags;
+
+        void PushBack(const Vector3& position, const Array<float32, LodComponent::MAX_LOD_LAYERS>& farSquares, uint8 flags);
+        void MoveFrom(size_t from, size_t to);
+        void PopBack();
+        void Clear();
+        size_t Size() const;
+    };
+    FastArrays fast;
     UnorderedMap<Entity*, int32> fastMap = UnorderedMap<Entity*, int32>(1024);
 
-    void UpdateDistances(LodComponent* from, LodSystem::SlowStruct* to);
+    struct LodChange
+    {
+        int32 index;
+        int32 lod;
+    };
+
+    struct EvaluationParams
+    {
+        Vector3 cameraPos;
+        float32 cameraZoomFactorSq;
+        float32 lodOffset;
+        float32 lodMult;
+    };
+
+    Vector<float32> distanceSquares;
+    Vector<Vector<LodChange>> chunkChanges;
+
+    void UpdateDistances(LodComponent* from, LodSystem::SlowStruct* to, int32 index);
+    void UpdateScreenSize(int32 index, const Transform& worldTransform);
+    void EvaluateLods(const EvaluationParams& params, int32 beginIndex, int32 endIndex, Vector<LodChange>& changes);
+    void ApplyLodChange(const LodChange& change);
 
     void SetEntityLod(Entity* entity, int32 currentLod);
     void SetEntityLodRecursive(Entity* entity, int32 currentLod);
 
     bool forceLodUsed = false;
+
+    eLodSelectionMode selectionMode = LOD_SELECTION_DISTANCE;
+    float32 screenSizeReferenceRadius = 1.f;
 };
+
+inline LodSystem::eLodSelectionMode LodSystem::GetLodSelectionMode() const
+{
+    return selectionMode;
+}
+
+inline float32 LodSystem::GetScreenSizeReferenceRadius() const
+{
+    return screenSizeReferenceRadius;
+}
 }
@@ -1,4 +1,5 @@
 #include "Scene3D/Lod/LodSystem.h"
+#include "Entity/ComponentUtils.h"
 #include "Debug/DVAssert.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/RenderComponent.h"
@@ -11,12 +12,23 @@
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Scene3D/Systems/EventSystem.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Math/SIMD/SIMDMath.h"
 
 namespace DAVA
 {
+namespace LodSystemDetail
+{
+const int32 LODS_PER_JOB = 2048;
+}
+
 LodSystem::LodSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    // lods are applied to render objects and particle effects, positions are taken from changed transforms of `TransformSingleComponent`
+    SetProcessAccess(ComponentUtils::MakeMask<TransformComponent>(), ComponentUtils::MakeMask<LodComponent, RenderComponent, ParticleEffectComponent>());
+
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::START_PARTICLE_EFFECT);
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::STOP_PARTICLE_EFFECT);
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::LOD_DISTANCE_CHANGED);
@@ -39,8 +51,16 @@ void LodSystem::Process(float32 timeElapsed)
                 if (iter != fastMap.end())
                 {
                     int32 index = iter->second;
-                    FastStruct* fast = &fastVector[index];
-                    fast->position = entity->GetComponent<TransformComponent>()->GetWorldTransform().GetTranslation();
+                    const Transform& worldTransform = entity->GetComponent<TransformComponent>()->GetWorldTransform();
+                    Vector3 position = worldTransform.GetTranslation();
+                    fast.positionX[index] = position.x;
+                    fast.positionY[index] = position.y;
+                    fast.positionZ[index] = position.z;
+
+                    if (selectionMode == LOD_SELECTION_SCREEN_SIZE)
+                    {
+                        UpdateScreenSize(index, worldTransform);
+                    }
                 }
             }
         }
@@ -63,128 +83,222 @@ void LodSystem::Process(float32 timeElapsed)
     currPSValue = Clamp(currPSValue, 0.0f, 1.0f);
     float32 lodOffset = PerformanceSettings::Instance()->GetPsPerformanceLodOffset() * (1 - currPSValue);
     float32 lodMult = 1.0f + (PerformanceSettings::Instance()->GetPsPerformanceLodMult() - 1.0f) * (1 - currPSValue);
+
+    EvaluationParams params;
+    params.cameraPos = camera->GetPosition();
+    params.cameraZoomFactorSq = camera->GetZoomFactor() * camera->GetZoomFactor();
     /*as we use square values - multiply it too*/
-    lodOffset *= lodOffset;
-    lodMult *= lodMult;
+    params.lodOffset = lodOffset * lodOffset;
+    params.lodMult = lodMult * lodMult;
 
-    Vector3 cameraPos = camera->GetPosition();
-    float32 cameraZoomFactorSq = camera->GetZoomFactor() * camera->GetZoomFactor();
+    int32 size = static_cast<int32>(fast.Size());
+    int32 chunksCount = (size + LodSystemDetail::LODS_PER_JOB - 1) / LodSystemDetail::LODS_PER_JOB;
+    distanceSquares.resize(size);
+    chunkChanges.resize(chunksCount);
 
-    int32 size = static_cast<int32>(fastVector.size());
-    for (int32 index = 0; index < size; ++index)
+    if (chunksCount == 1)
+    {
+        EvaluateLods(params, 0, size, chunkChanges[0]);
+    }
+    else if (chunksCount > 1)
     {
-        FastStruct& fast = fastVector[index];
-#if defined(__DAVAENGINE_IPHONE__) || defined(__DAVAENGINE_ANDROID__)
-        __builtin_prefetch(&fastVector[index + 1]);
-        __builtin_prefetch(&fastVector[index + 2]);
-        __builtin_prefetch(&fastVector[index + 3]);
-        __builtin_prefetch(&fastVector[index + 4]);
+        GetEngineContext()->jobManager->ParallelFor(static_cast<uint32>(chunksCount), [this, &params, size](uint32 chunk) {
+            int32 beginIndex = static_cast<int32>(chunk) * LodSystemDetail::LODS_PER_JOB;
+            int32 endIndex = Min(beginIndex + LodSystemDetail::LODS_PER_JOB, size);
+            EvaluateLods(params, beginIndex, endIndex, chunkChanges[chunk]);
+        });
+    }
+
+    //switch lods
+    for (int32 chunk = 0; chunk < chunksCount; ++chunk)
+    {
+        for (const LodChange& change : chunkChanges[chunk])
+        {
+            ApplyLodChange(change);
+        }
+    }
+}
+
+void LodSystem::EvaluateLods(const EvaluationParams& params, int32 beginIndex, int32 endIndex, Vector<LodChange>& changes)
+{
+    changes.clear();
+
+    const float32* positionX = fast.positionX.data();
+    const float32* positionY = fast.positionY.data();
+    const float32* positionZ = fast.positionZ.data();
+    const float32* distanceScale = fast.distanceScale.data();
+    float32* dstSquares = distanceSquares.data();
+
+    int32 index = beginIndex;
+
+#if defined(__DAVAENGINE_SIMD_MATH__)
+    {
+        using namespace SIMDMath;
+
+        // same operations in the same order as scalar loop below, so result doesn't depend on backend
+        const Float4 cameraX = Set1(params.cameraPos.x);
+        const Float4 cameraY = Set1(params.cameraPos.y);
+        const Float4 cameraZ = Set1(params.cameraPos.z);
+        const Float4 zoomFactorSq = Set1(params.cameraZoomFactorSq);
+        for (; index + 4 <= endIndex; index += 4)
+        {
+            Float4 dx = Sub(cameraX, Load(positionX + index));
+            Float4 dy = Sub(cameraY, Load(positionY + index));
+            Float4 dz = Sub(cameraZ, Load(positionZ + index));
+            Float4 lengthSq = Add(Add(Mul(dx, dx), Mul(dy, dy)), Mul(dz, dz));
+            Store(dstSquares + index, Mul(Mul(lengthSq, zoomFactorSq), Load(distanceScale + index)));
+        }
+    }
 #endif
 
-        if (fast.effectStopped)
+    //branchless loop over packed arrays, processes tail after SIMD loop or everything without SIMD backend
+    for (; index < endIndex; ++index)
+    {
+        float32 dx = params.cameraPos.x - positionX[index];
+        float32 dy = params.cameraPos.y - positionY[index];
+        float32 dz = params.cameraPos.z - positionZ[index];
+        dstSquares[index] = (dx * dx + dy * dy + dz * dz) * params.cameraZoomFactorSq * distanceScale[index];
+    }
+
+    for (index = beginIndex; index < endIndex; ++index)
+    {
+        uint8 flags = fast.flags[index];
+        if (flags & EFFECT_STOPPED)
         {
             //do not update inactive effects
+            continue;
+        }
+
+        int32 currentLod = fast.currentLod[index];
+        int32 newLod = 0;
+        if (forceLodUsed && (slowVector[index].forceLodLayer != LodComponent::INVALID_LOD_LAYER))
+        {
+            newLod = slowVector[index].forceLodLayer;
         }
         else
         {
-            int32 newLod = 0;
-            if (forceLodUsed && (slowVector[index].forceLodLayer != LodComponent::INVALID_LOD_LAYER))
+            float32 dst = dstSquares[index];
+            if (forceLodUsed && slowVector[index].forceLodDistance != LodComponent::INVALID_DISTANCE)
             {
-                newLod = slowVector[index].forceLodLayer;
+                const SlowStruct& slow = slowVector[index];
+                dst = slow.forceLodDistance * slow.forceLodDistance;
             }
-            else
-            {
-                float32 dst;
-                if (forceLodUsed && slowVector[index].forceLodDistance != LodComponent::INVALID_DISTANCE)
-                {
-                    SlowStruct& slow = slowVector[index];
-                    dst = slow.forceLodDistance * slow.forceLodDistance;
-                }
-                else
-                {
-                    dst = (cameraPos - fast.position).SquareLength();
-                    dst *= cameraZoomFactorSq;
-                }
 
-                if (fast.isEffect)
-                {
-                    if (dst > fast.farSquare0) //preserve lod 0 from degrade
-                        dst = dst * lodMult + lodOffset;
-                }
+            const Array<float32, LodComponent::MAX_LOD_LAYERS>& farSquares = fast.farSquares[index];
+            if (flags & IS_EFFECT)
+            {
+                if (dst > farSquares[0]) //preserve lod 0 from degrade
+                    dst = dst * params.lodMult + params.lodOffset;
+            }
 
-                if ((fast.currentLod != LodComponent::INVALID_LOD_LAYER) &&
-                    (dst >= fast.nearSquare) &&
-                    (dst <= fast.farSquare))
-                {
-                    newLod = fast.currentLod;
-                }
-                else
+            if ((currentLod != LodComponent::INVALID_LOD_LAYER) &&
+                (dst >= fast.nearSquare[index]) &&
+                (dst <= fast.farSquare[index]))
+            {
+                newLod = currentLod;
+            }
+            else
+            {
+                newLod = LodComponent::INVALID_LOD_LAYER;
+                for (int32 i = LodComponent::MAX_LOD_LAYERS - 1; i >= 0; --i)
                 {
-                    newLod = LodComponent::INVALID_LOD_LAYER;
-                    SlowStruct* slow = &slowVector[index];
-                    for (int32 i = LodComponent::MAX_LOD_LAYERS - 1; i >= 0; --i)
+                    if (dst < farSquares[i])
                     {
-                        if (dst < slow->farSquares[i])
-                        {
-                            newLod = i;
-                        }
+                        newLod = i;
                     }
                 }
             }
+        }
 
-            //switch lod
-            if (fast.currentLod != newLod)
-            {
-                fast.currentLod = newLod;
-                SlowStruct& slow = slowVector[index];
-                slow.lod->currentLod = fast.currentLod;
+        if (currentLod != newLod)
+        {
+            changes.push_back({ index, newLod });
+        }
+    }
+}
 
-                if (newLod == LodComponent::INVALID_LOD_LAYER)
-                {
-                    fast.nearSquare = fast.farSquare;
-                    fast.farSquare = std::numeric_limits<float32>::max();
-                }
-                else
-                {
-                    fast.nearSquare = slow.nearSquares[fast.currentLod];
-                    fast.farSquare = slow.farSquares[fast.currentLod];
-                }
+void LodSystem::ApplyLodChange(const LodChange& change)
+{
+    int32 index = change.index;
+    int32 newLod = change.lod;
 
-                ParticleEffectComponent* effect = slow.effect;
-                if (effect)
-                {
-                    effect->SetDesiredLodLevel(fast.currentLod);
-                }
-                else
-                {
-                    if (slow.recursiveUpdate)
-                    {
-                        SetEntityLodRecursive(slow.entity, fast.currentLod);
-                    }
-                    else
-                    {
-                        SetEntityLod(slow.entity, fast.currentLod);
-                    }
-                }
-            }
+    fast.currentLod[index] = newLod;
+    SlowStruct& slow = slowVector[index];
+    slow.lod->currentLod = newLod;
+
+    if (newLod == LodComponent::INVALID_LOD_LAYER)
+    {
+        fast.nearSquare[index] = fast.farSquare[index];
+        fast.farSquare[index] = std::numeric_limits<float32>::max();
+    }
+    else
+    {
+        fast.nearSquare[index] = slow.nearSquares[newLod];
+        fast.farSquare[index] = fast.farSquares[index][newLod];
+    }
+
+    ParticleEffectComponent* effect = slow.effect;
+    if (effect)
+    {
+        effect->SetDesiredLodLevel(newLod);
+    }
+    else
+    {
+        if (slow.recursiveUpdate)
+        {
+            SetEntityLodRecursive(slow.entity, newLod);
+        }
+        else
+        {
+            SetEntityLod(slow.entity, newLod);
         }
     }
 }
 
-void LodSystem::UpdateDistances(LodComponent* from, LodSystem::SlowStruct* to)
+void LodSystem::UpdateDistances(LodComponent* from, LodSystem::SlowStruct* to, int32 index)
 {
+    Array<float32, LodComponent::MAX_LOD_LAYERS>& farSquares = fast.farSquares[index];
+
     //lods will overlap +- 5%
     to->nearSquares[0] = 0.f;
-    to->farSquares[0] = from->GetLodLayerDistance(0) * 1.05f;
-    to->farSquares[0] *= to->farSquares[0];
+    farSquares[0] = from->GetLodLayerDistance(0) * 1.05f;
+    farSquares[0] *= farSquares[0];
 
     for (int32 i = 1; i < LodComponent::MAX_LOD_LAYERS; ++i)
     {
         to->nearSquares[i] = from->GetLodLayerDistance(i - 1) * 0.95f;
         to->nearSquares[i] *= to->nearSquares[i];
 
-        to->farSquares[i] = from->GetLodLayerDistance(i) * 1.05f;
-        to->farSquares[i] *= to->farSquares[i];
+        farSquares[i] = from->GetLodLayerDistance(i) * 1.05f;
+        farSquares[i] *= farSquares[i];
+    }
+}
+
+void LodSystem::UpdateScreenSize(int32 index, const Transform& worldTransform)
+{
+    SlowStruct& slow = slowVector[index];
+    const Vector3& scale = worldTransform.GetScale();
+    float32 maxScale = Max(Max(scale.x, scale.y), scale.z);
+
+    if (slow.localRadius <= 0.f)
+    {
+        //bounding box of lod entity is calculated once, radius follows transform scale later
+        AABBox3 bbox = slow.entity->GetWTMaximumBoundingBoxSlow();
+        if (!bbox.IsEmpty() && maxScale > 0.f)
+        {
+            slow.localRadius = bbox.GetSize().Length() * 0.5f / maxScale;
+        }
+    }
+
+    float32 radius = slow.localRadius * maxScale;
+    if (radius > 0.f)
+    {
+        float32 scaleFactor = screenSizeReferenceRadius / radius;
+        fast.distanceScale[index] = scaleFactor * scaleFactor;
+    }
+    else
+    {
+        fast.distanceScale[index] = 1.f;
     }
 }
 
@@ -197,25 +311,32 @@ void LodSystem::AddEntity(Entity* entity)
 
     lod->currentLod = LodComponent::INVALID_LOD_LAYER;
 
+    uint8 flags = 0;
+    if (effect != nullptr)
+    {
+        flags |= IS_EFFECT;
+        if (effect->IsStopped())
+        {
+            flags |= EFFECT_STOPPED;
+        }
+    }
+    fast.PushBack(position, Array<float32, LodComponent::MAX_LOD_LAYERS>(), flags);
+    int32 index = static_cast<int32>(fast.Size() - 1);
+
     SlowStruct slow;
     slow.entity = entity;
     slow.lod = lod;
     slow.effect = effect;
     slow.recursiveUpdate = lod->recursiveUpdate;
-    UpdateDistances(lod, &slow);
     slowVector.push_back(slow);
+    UpdateDistances(lod, &slowVector[index], index);
+
+    fastMap.insert(std::make_pair(entity, index));
 
-    FastStruct fast;
-    fast.farSquare0 = slow.farSquares[0];
-    fast.position = position;
-    fast.currentLod = LodComponent::INVALID_LOD_LAYER;
-    fast.nearSquare = -1.f;
-    fast.farSquare = -1.f;
-    fast.effectStopped = effect ? effect->IsStopped() : false;
-    fast.isEffect = effect != nullptr;
-
-    fastVector.push_back(fast);
-    fastMap.insert(std::make_pair(entity, static_cast<int32>(fastVector.size() - 1)));
+    if (selectionMode == LOD_SELECTION_SCREEN_SIZE)
+    {
+        UpdateScreenSize(index, transform->GetWorldTransform());
+    }
 }
 
 void LodSystem::RemoveEntity(Entity* entity)
@@ -232,9 +353,8 @@ void LodSystem::RemoveEntity(Entity* entity)
     slowVector.pop_back();
 
     //delete from fast
-    FastStruct& fastLast = fastVector.back();
-    fastVector[index] = fastLast;
-    fastVector.pop_back();
+    fast.MoveFrom(fast.Size() - 1, index);
+    fast.PopBack();
 
     //delete in fastMap
     fastMap.erase(entity);
@@ -256,8 +376,7 @@ void LodSystem::RegisterComponent(Entity* entity, Component* component)
             SlowStruct* slow = &slowVector[index];
             DVASSERT(slow->effect == nullptr);
             slow->effect = static_cast<ParticleEffectComponent*>(component);
-            FastStruct* fast = &fastVector[index];
-            fast->isEffect = slow->effect != nullptr;
+            fast.flags[index] |= IS_EFFECT;
         }
     }
 
@@ -275,8 +394,7 @@ void LodSystem::UnregisterComponent(Entity* entity, Component* component)
             SlowStruct* slow = &slowVector[index];
             DVASSERT(slow->effect != nullptr);
             slow->effect = nullptr;
-            FastStruct* fast = &fastVector[index];
-            fast->isEffect = false;
+            fast.flags[index] &= ~IS_EFFECT;
         }
     }
 
@@ -286,7 +404,7 @@ void LodSystem::UnregisterComponent(Entity* entity, Component* component)
 void LodSystem::PrepareForRemove()
 {
     slowVector.clear();
-    fastVector.clear();
+    fast.Clear();
     fastMap.clear();
 }
 
@@ -302,8 +420,14 @@ void LodSystem::ImmediateEvent(Component* component, uint32 event)
         if (iter != fastMap.end())
         {
             int32 index = iter->second;
-            FastStruct* fast = &fastVector[index];
-            fast->effectStopped = event == EventSystem::STOP_PARTICLE_EFFECT;
+            if (event == EventSystem::STOP_PARTICLE_EFFECT)
+            {
+                fast.flags[index] |= EFFECT_STOPPED;
+            }
+            else
+            {
+                fast.flags[index] &= ~EFFECT_STOPPED;
+            }
         }
     }
     break;
@@ -317,12 +441,11 @@ void LodSystem::ImmediateEvent(Component* component, uint32 event)
         {
             int32 index = iter->second;
             SlowStruct* slow = &slowVector[index];
-            UpdateDistances(lod, slow);
+            UpdateDistances(lod, slow, index);
 
-            FastStruct* fast = &fastVector[index];
             //force recalc nearSquare/farSquare on next Process
-            fast->nearSquare = -1.f;
-            fast->farSquare = -1.f;
+            fast.nearSquare[index] = -1.f;
+            fast.farSquare[index] = -1.f;
         }
     }
     break;
@@ -389,6 +512,46 @@ DAVA::float32 LodSystem::GetForceLodDistance(LodComponent* forComponent)
     return slow->forceLodDistance;
 }
 
+void LodSystem::SetLodSelectionMode(eLodSelectionMode mode)
+{
+    if (selectionMode != mode)
+    {
+        selectionMode = mode;
+
+        for (size_t index = 0, count = slowVector.size(); index < count; ++index)
+        {
+            if (selectionMode == LOD_SELECTION_SCREEN_SIZE)
+            {
+                TransformComponent* transform = slowVector[index].entity->GetComponent<TransformComponent>();
+                UpdateScreenSize(static_cast<int32>(index), transform->GetWorldTransform());
+            }
+            else
+            {
+                fast.distanceScale[index] = 1.f;
+            }
+
+            //force recalc nearSquare/farSquare on next Process
+            fast.nearSquare[index] = -1.f;
+            fast.farSquare[index] = -1.f;
+        }
+    }
+}
+
+void LodSystem::SetScreenSizeReferenceRadius(float32 radius)
+{
+    DVASSERT(radius > 0.f);
+    screenSizeReferenceRadius = radius;
+
+    if (selectionMode == LOD_SELECTION_SCREEN_SIZE)
+    {
+        for (size_t index = 0, count = slowVector.size(); index < count; ++index)
+        {
+            TransformComponent* transform = slowVector[index].entity->GetComponent<TransformComponent>();
+            UpdateScreenSize(static_cast<int32>(index), transform->GetWorldTransform());
+        }
+    }
+}
+
 void LodSystem::SetEntityLod(Entity* entity, int32 currentLod)
 {
     RenderObject* ro = GetRenderObject(entity);
@@ -408,4 +571,61 @@ void LodSystem::SetEntityLodRecursive(Entity* entity, int32 currentLod)
         SetEntityLodRecursive(entity->GetChild(i), currentLod);
     }
 }
+
+void LodSystem::FastArrays::PushBack(const Vector3& position, const Array<float32, LodComponent::MAX_LOD_LAYERS>& farSquares_, uint8 flags_)
+{
+    positionX.push_back(position.x);
+    positionY.push_back(position.y);
+    positionZ.push_back(position.z);
+    distanceScale.push_back(1.f);
+    nearSquare.push_back(-1.f);
+    farSquare.push_back(-1.f);
+    farSquares.push_back(farSquares_);
+    currentLod.push_back(LodComponent::INVALID_LOD_LAYER);
+    flags.push_back(flags_);
+}
+
+void LodSystem::FastArrays::MoveFrom(size_t from, size_t to)
+{
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    positionZ[to] = positionZ[from];
+    distanceScale[to] = distanceScale[from];
+    nearSquare[to] = nearSquare[from];
+    farSquare[to] = farSquare[from];
+    farSquares[to] = farSquares[from];
+    currentLod[to] = currentLod[from];
+    flags[to] = flags[from];
+}
+
+void LodSystem::FastArrays::PopBack()
+{
+    positionX.pop_back();
+    positionY.pop_back();
+    positionZ.pop_back();
+    distanceScale.pop_back();
+    nearSquare.pop_back();
+    farSquare.pop_back();
+    farSquares.pop_back();
+    currentLod.pop_back();
+    flags.pop_back();
+}
+
+void LodSystem::FastArrays::Clear()
+{
+    positionX.clear();
+    positionY.clear();
+    positionZ.clear();
+    distanceScale.clear();
+    nearSquare.clear();
+    farSquare.clear();
+    farSquares.clear();
+    currentLod.clear();
+    flags.clear();
+}
+
+size_t LodSystem::FastArrays::Size() const
+{
+    return positionX.size();
+}
 }
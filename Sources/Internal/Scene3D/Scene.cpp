@@ -4,7 +4,9 @@
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Entity/ComponentUtils.h"
+#include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
+#include "Job/JobManager.h"
 #include "Render/3D/StaticMesh.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Highlevel/Light.h"
@@ -550,6 +552,7 @@ void Scene::AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMa
 {
     sceneSystem->SetRequiredComponents(componentMask);
     systems.push_back(sceneSystem);
+    processStagesDirty = true;
 
     auto insertSystemBefore = [sceneSystem](Vector<SceneSystem*>& container, SceneSystem* beforeThisSystem)
     {
@@ -601,6 +604,7 @@ void Scene::RemoveSystem(SceneSystem* sceneSystem)
     sceneSystem->PrepareForRemove();
 
     RemoveSystem(systemsToProcess, sceneSystem);
+    processStagesDirty = true;
     RemoveSystem(systemsToInput, sceneSystem);
     RemoveSystem(systemsToFixedProcess, sceneSystem);
 
@@ -690,24 +694,34 @@ void Scene::Update(float32 timeElapsed)
         fixedUpdate.lastTime -= fixedUpdate.constantTime;
     }
 
-    for (SceneSystem* system : systemsToProcess)
+    if (parallelProcessEnabled)
     {
-        if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
+        if (processStagesDirty)
         {
-            updatableSystem->UpdatePreTransform(timeElapsed);
-            transformSystem->Process(timeElapsed);
-            updatableSystem->UpdatePostTransform(timeElapsed);
+            BuildProcessStages();
         }
-        else if (system == lodSystem)
+
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        for (const Vector<SceneSystem*>& stage : processStages)
         {
-            if (Renderer::GetOptions()->IsOptionEnabled(RenderOptions::UPDATE_LODS))
+            DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_SYSTEMS_STAGE);
+
+            // waits only for systems of this stage, main-thread jobs are not executed in the middle of update
+            jobManager->ParallelFor(static_cast<uint32>(stage.size()), [this, &stage, timeElapsed](uint32 index) {
+                ProcessSystem(stage[index], timeElapsed);
+            });
+
+            if (particleEffectSystem != nullptr)
             {
-                lodSystem->Process(timeElapsed);
+                particleEffectSystem->DispatchPlaybackComplete();
             }
         }
-        else
+    }
+    else
+    {
+        for (SceneSystem* system : systemsToProcess)
         {
-            system->Process(timeElapsed);
+            ProcessSystem(system, timeElapsed);
         }
     }
 
@@ -726,6 +740,77 @@ void Scene::Update(float32 timeElapsed)
     sceneGlobalTime += timeElapsed;
 }
 
+void Scene::ProcessSystem(SceneSystem* system, float32 timeElapsed)
+{
+    if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
+    {
+        updatableSystem->UpdatePreTransform(timeElapsed);
+        transformSystem->Process(timeElapsed);
+        updatableSystem->UpdatePostTransform(timeElapsed);
+    }
+    else if (system == lodSystem)
+    {
+        if (Renderer::GetOptions()->IsOptionEnabled(RenderOptions::UPDATE_LODS))
+        {
+            lodSystem->Process(timeElapsed);
+        }
+    }
+    else
+    {
+        system->Process(timeElapsed);
+    }
+}
+
+void Scene::BuildProcessStages()
+{
+    processStages.clear();
+
+    // system is placed into first stage after stages of all preceding systems it conflicts with,
+    // so conflicting systems keep their relative order and independent ones are grouped across whole list
+    Vector<uint32> systemStages(systemsToProcess.size());
+    for (size_t i = 0; i < systemsToProcess.size(); ++i)
+    {
+        SceneSystem* system = systemsToProcess[i];
+
+        uint32 stage = 0;
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (systemStages[j] >= stage && system->IsProcessConflicting(systemsToProcess[j]))
+            {
+                stage = systemStages[j] + 1;
+            }
+        }
+
+        if (stage == processStages.size())
+        {
+            processStages.emplace_back();
+        }
+        processStages[stage].push_back(system);
+        systemStages[i] = stage;
+    }
+
+    processStagesDirty = false;
+}
+
+void Scene::SetParallelProcessEnabled(bool enabled)
+{
+    parallelProcessEnabled = enabled;
+}
+
+bool Scene::IsParallelProcessEnabled() const
+{
+    return parallelProcessEnabled;
+}
+
+const Vector<Vector<SceneSystem*>>& Scene::GetProcessStages()
+{
+    if (processStagesDirty)
+    {
+        BuildProcessStages();
+    }
+    return processStages;
+}
+
 void Scene::Draw()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_DRAW)
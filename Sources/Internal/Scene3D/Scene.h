@@ -152,6 +152,19 @@ public:
     template <class T>
     T* GetSystem();
 
+    /**
+        Enable concurrent processing of systems with declared components access, see `SceneSystem::SetProcessAccess`.
+        Each system from `systemsToProcess` is placed into first stage after stages of preceding systems it conflicts with,
+        so systems which don't conflict are grouped into one stage even if they are not neighbours in `systemsToProcess`.
+        Systems of one stage are processed on worker threads, stages are processed in order. When disabled (default)
+        systems are processed strictly one by one on the calling thread.
+     */
+    void SetParallelProcessEnabled(bool enabled);
+    bool IsParallelProcessEnabled() const;
+
+    /** Return stages of systems processing which are used when parallel processing is enabled. */
+    const Vector<Vector<SceneSystem*>>& GetProcessStages();
+
     Vector<SceneSystem*> systems;
     Vector<SceneSystem*> systemsToProcess;
     Vector<SceneSystem*> systemsToInput;
@@ -260,6 +273,8 @@ public: // deprecated methods
 
 protected:
     void RegisterEntitiesInSystemRecursively(SceneSystem* system, Entity* entity);
+    void ProcessSystem(SceneSystem* system, float32 timeElapsed);
+    void BuildProcessStages();
 
     bool RemoveSystem(Vector<SceneSystem*>& storage, SceneSystem* system);
 
@@ -268,6 +283,10 @@ protected:
 
     float32 sceneGlobalTime = 0.f;
 
+    Vector<Vector<SceneSystem*>> processStages;
+    bool processStagesDirty = true;
+    bool parallelProcessEnabled = false;
+
     Vector<Camera*> cameras;
 
     NMaterial* sceneGlobalMaterial;
@@ -65,6 +65,17 @@ void SceneFileV2::EnableSaveForGame(bool _isSaveForGame)
     isSaveForGame = _isSaveForGame;
 }
 
+void SceneFileV2::EnableMeshOptimization(bool _isMeshOptimizationEnabled, const MeshOptimizer::Options& options)
+{
+    isMeshOptimizationEnabled = _isMeshOptimizationEnabled;
+    meshOptimizationOptions = options;
+}
+
+const MeshOptimizer::Statistics& SceneFileV2::GetMeshOptimizationStatistics() const
+{
+    return meshOptimizationStatistics;
+}
+
 void SceneFileV2::EnableDebugLog(bool _isDebugLogEnabled)
 {
     isDebugLogEnabled = _isDebugLogEnabled;
@@ -157,6 +168,16 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
     if (isSaveForGame)
     {
         scene->OptimizeBeforeExport();
+
+        if (isMeshOptimizationEnabled)
+        {
+            meshOptimizationStatistics = MeshOptimizer::OptimizeMeshesRecursive(scene, meshOptimizationOptions);
+            Logger::Info("SceneFileV2::SaveScene optimized %u polygon groups (%u skipped) in %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %u vertices removed",
+                         meshOptimizationStatistics.optimizedGroupsCount, meshOptimizationStatistics.skippedGroupsCount, filename.GetAbsolutePathname().c_str(),
+                         meshOptimizationStatistics.before.acmr, meshOptimizationStatistics.after.acmr,
+                         meshOptimizationStatistics.before.atvr, meshOptimizationStatistics.after.atvr,
+                         meshOptimizationStatistics.removedVertexCount);
+        }
     }
 
     Set<DataNode*> nodes;
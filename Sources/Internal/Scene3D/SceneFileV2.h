@@ -5,6 +5,7 @@
 #include "Base/BaseMath.h"
 #include "Render/3D/StaticMesh.h"
 #include "Render/3D/PolygonGroup.h"
+#include "Render/3D/MeshOptimizer.h"
 #include "Utils/Utils.h"
 #include "FileSystem/File.h"
 #include "Scene3D/SceneFile/SerializationContext.h"
@@ -131,6 +132,12 @@ public:
     bool DebugLogEnabled();
     void EnableSaveForGame(bool _isSaveForGame);
 
+    /**
+        Optimize meshes geometry with MeshOptimizer on save for game.
+    */
+    void EnableMeshOptimization(bool _isMeshOptimizationEnabled, const MeshOptimizer::Options& options = MeshOptimizer::Options());
+    const MeshOptimizer::Statistics& GetMeshOptimizationStatistics() const;
+
     //Material * GetMaterial(int32 index);
     //StaticMesh * GetStaticMesh(int32 index);
 
@@ -194,6 +201,9 @@ private:
 
     bool isDebugLogEnabled;
     bool isSaveForGame;
+    bool isMeshOptimizationEnabled = false;
+    MeshOptimizer::Options meshOptimizationOptions;
+    MeshOptimizer::Statistics meshOptimizationStatistics;
     eError lastError;
 
     SerializationContext serializationContext;
@@ -139,31 +139,34 @@ float32 SkeletonAnimation::GetDuration() const
 
 JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track)
 {
-    static const uint32 MAX_CHANNEL_VALUE_SIZE = 4;
+    static const uint32 MAX_CHANNEL_VALUE_SIZE = AnimationChannel::MAX_DIMENSION;
     DVASSERT(MAX_CHANNEL_VALUE_SIZE >= track->GetMaxChannelValueSize());
+    DVASSERT(track->GetChannelsCount() <= AnimationTrack::CHANNEL_TARGET_COUNT);
 
     JointTransform transform;
-    Array<float32, MAX_CHANNEL_VALUE_SIZE> workData;
+    Array<float32, MAX_CHANNEL_VALUE_SIZE * AnimationTrack::CHANNEL_TARGET_COUNT> workData;
+    track->EvaluateChannels(time, workData.data(), uint32(workData.size()));
+
     for (uint32 c = 0; c < track->GetChannelsCount(); ++c)
     {
-        track->Evaluate(time, c, workData.data(), uint32(workData.size()));
+        const float32* channelData = workData.data() + c * MAX_CHANNEL_VALUE_SIZE;
 
         AnimationTrack::eChannelTarget target = track->GetChannelTarget(c);
         switch (target)
         {
         case AnimationTrack::CHANNEL_TARGET_POSITION:
             DVASSERT(track->GetChannelValueSize(c) == 3);
-            transform.SetPosition(Vector3(workData.data()));
+            transform.SetPosition(Vector3(channelData));
             break;
 
         case AnimationTrack::CHANNEL_TARGET_ORIENTATION:
             DVASSERT(track->GetChannelValueSize(c) == 4);
-            transform.SetOrientation(Quaternion(workData.data()));
+            transform.SetOrientation(Quaternion(channelData));
             break;
 
         case AnimationTrack::CHANNEL_TARGET_SCALE:
             DVASSERT(track->GetChannelValueSize(c) == 1);
-            transform.SetScale(*workData.data());
+            transform.SetScale(*channelData);
             break;
 
         default:
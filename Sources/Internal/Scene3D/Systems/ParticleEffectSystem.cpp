@@ -2,6 +2,7 @@
 
 #include <limits>
 
+#include "Entity/ComponentUtils.h"
 #include "Math/MathConstants.h"
 #include "Scene3D/Components/ParticleEffectComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -124,6 +125,9 @@ ParticleEffectSystem::ParticleEffectSystem(Scene* scene, bool _is2DMode)
     , allowLodDegrade(false)
     , is2DMode(_is2DMode)
 {
+    // effects are added to render system and marked for update there
+    SetProcessAccess(ComponentUtils::MakeMask<TransformComponent>(), ComponentUtils::MakeMask<ParticleEffectComponent>(), PROCESS_SHARED_RENDER_SYSTEM);
+
     if (scene) //for 2d particles there would be no scene
     {
         scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::START_PARTICLE_EFFECT);
@@ -339,6 +343,7 @@ void ParticleEffectSystem::RemoveEntity(Entity* entity)
     ParticleEffectComponent* effect = entity->GetComponent<ParticleEffectComponent>();
     if (effect && effect->state != ParticleEffectComponent::STATE_STOPPED)
         RemoveFromActive(effect);
+    completedEffects.erase(std::remove(completedEffects.begin(), completedEffects.end(), effect), completedEffects.end());
 }
 
 void ParticleEffectSystem::RemoveComponent(Entity* entity, Component* component)
@@ -346,6 +351,7 @@ void ParticleEffectSystem::RemoveComponent(Entity* entity, Component* component)
     ParticleEffectComponent* effect = static_cast<ParticleEffectComponent*>(component);
     if (effect && effect->state != ParticleEffectComponent::STATE_STOPPED)
         RemoveFromActive(effect);
+    completedEffects.erase(std::remove(completedEffects.begin(), completedEffects.end(), effect), completedEffects.end());
 }
 
 void ParticleEffectSystem::PrepareForRemove()
@@ -361,9 +367,21 @@ void ParticleEffectSystem::PrepareForRemove()
         }
     }
     activeComponents.clear();
+    completedEffects.clear();
     globalExternalValues.clear();
 }
 
+void ParticleEffectSystem::DispatchPlaybackComplete()
+{
+    // callback may remove other completed effects from scene, they are erased from `completedEffects` then
+    while (!completedEffects.empty())
+    {
+        ParticleEffectComponent* effect = completedEffects.front();
+        completedEffects.erase(completedEffects.begin());
+        effect->playbackComplete(effect->GetEntity(), 0);
+    }
+}
+
 void ParticleEffectSystem::ImmediateEvent(Component* component, uint32 event)
 {
     DVASSERT(component->GetType()->Is<ParticleEffectComponent>());
@@ -405,6 +423,10 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     float32 speedMult = 1.0f + (perfSettings->GetPsPerformanceSpeedMult() - 1.0f) * (1 - currPSValue);
     float32 shortEffectTime = timeElapsed * speedMult;
 
+    // callbacks run user code, so they are not called from concurrently processed stage
+    Scene* scene = GetScene();
+    bool deferPlaybackComplete = (scene != nullptr && scene->IsParallelProcessEnabled());
+
     size_t componentsCount = activeComponents.size();
     for (size_t i = 0; i < componentsCount; i++)
     {
@@ -445,11 +467,19 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
             i--;
             effect->state = ParticleEffectComponent::STATE_STOPPED;
             if (!effect->playbackComplete.IsEmpty())
-                effect->playbackComplete(effect->GetEntity(), 0);
+            {
+                if (deferPlaybackComplete)
+                {
+                    completedEffects.push_back(effect);
+                }
+                else
+                {
+                    effect->playbackComplete(effect->GetEntity(), 0);
+                }
+            }
         }
         else
         {
-            Scene* scene = GetScene();
             if (scene)
                 scene->GetRenderSystem()->MarkForUpdate(effect->effectRenderObject);
         }
@@ -83,6 +83,12 @@ public:
 
     void PrebuildMaterials(ParticleEffectComponent* component);
 
+    /**
+        Call `playbackComplete` of effects completed during `Process`.
+        When scene processes systems in parallel, callbacks are deferred and called by scene on main thread after processing stage.
+     */
+    void DispatchPlaybackComplete();
+
 protected:
     void RunEffect(ParticleEffectComponent* effect);
     void AddToActive(ParticleEffectComponent* effect);
@@ -106,6 +112,7 @@ private:
 
     Map<String, float32> globalExternalValues;
     Vector<ParticleEffectComponent*> activeComponents;
+    Vector<ParticleEffectComponent*> completedEffects;
 
     struct EffectGlobalForcesData
     {
@@ -2,10 +2,12 @@
 
 #include "Animation/AnimationTrack.h"
 #include "Debug/ProfilerCPU.h"
+#include "Entity/ComponentUtils.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Components/RenderComponent.h"
 #include "Scene3D/Components/SkeletonComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
 #include "Scene3D/SkeletonAnimation/JointTransform.h"
@@ -19,6 +21,9 @@ namespace DAVA
 SkeletonSystem::SkeletonSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    // skinned meshes are marked for update and skeletons are drawn with debug drawer of render system
+    SetProcessAccess(ComponentUtils::MakeMask<TransformComponent>(), ComponentUtils::MakeMask<SkeletonComponent, RenderComponent>(), PROCESS_SHARED_RENDER_SYSTEM);
+
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::SKELETON_CONFIG_CHANGED);
 }
 
@@ -1,9 +1,12 @@
 #include "SpeedTreeUpdateSystem.h"
 #include "Scene3D/Entity.h"
+#include "Entity/ComponentUtils.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Scene3D/Components/RenderComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
 #include "Scene3D/Components/SpeedTreeComponent.h"
+#include "Scene3D/Components/WaveComponent.h"
+#include "Scene3D/Components/WindComponent.h"
 #include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
 #include "Scene3D/Systems/WindSystem.h"
 #include "Scene3D/Systems/WaveSystem.h"
@@ -25,6 +28,9 @@ namespace DAVA
 SpeedTreeUpdateSystem::SpeedTreeUpdateSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    // wind and waves are read through their systems
+    SetProcessAccess(ComponentUtils::MakeMask<TransformComponent, WindComponent, WaveComponent>(), ComponentUtils::MakeMask<SpeedTreeComponent, RenderComponent>());
+
     RenderOptions* options = Renderer::GetOptions();
     options->AddObserver(this);
     isAnimationEnabled = options->IsOptionEnabled(RenderOptions::SPEEDTREE_ANIMATIONS);
@@ -1,5 +1,6 @@
 #include "WaveSystem.h"
 #include "Scene3D/Entity.h"
+#include "Entity/ComponentUtils.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Scene3D/Components/WaveComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -32,6 +33,8 @@ WaveSystem::WaveSystem(Scene* scene)
     :
     SceneSystem(scene)
 {
+    SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<WaveComponent>());
+
     RenderOptions* options = Renderer::GetOptions();
     options->AddObserver(this);
     HandleEvent(options);
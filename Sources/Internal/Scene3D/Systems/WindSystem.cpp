@@ -1,6 +1,7 @@
 #include "Base/BaseMath.h"
 #include "WindSystem.h"
 #include "Scene3D/Entity.h"
+#include "Entity/ComponentUtils.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Scene3D/Components/WindComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -30,6 +31,8 @@ WindSystem::WindSystem(Scene* scene)
     :
     SceneSystem(scene)
 {
+    SetProcessAccess(ComponentMask(), ComponentUtils::MakeMask<WindComponent>());
+
     RenderOptions* options = Renderer::GetOptions();
     options->AddObserver(this);
     HandleEvent(options);
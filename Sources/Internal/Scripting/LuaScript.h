@@ -9,6 +9,26 @@
 namespace DAVA
 {
 struct ScriptState;
+class FastName;
+class Reflection;
+
+/**
+Prepared reference to global Lua function.
+Function can be called by reference without lookup by name.
+Reference is valid only for the script which created it.
+*/
+class LuaFunctionRef final
+{
+public:
+    /**
+    Return true if reference points to function.
+    */
+    bool IsValid() const;
+
+private:
+    friend class LuaScript;
+    int32 ref = 0; //!< Index of function in Lua registry table
+};
 
 /**
 Class for Lua script.
@@ -100,6 +120,24 @@ public:
     */
     int32 ExecFunctionSafe(const String& fName, const Vector<Any>& args);
 
+    /**
+    Run function by prepared reference with arguments and return number of
+    results in the stack.
+    Arguments of simple types, strings and reflections are pushed without
+    boxing to Any.
+    Throw LuaException on error.
+    */
+    template <typename... T>
+    int32 ExecFunction(const LuaFunctionRef& fRef, T&&... args);
+
+    /**
+    Run function by prepared reference with arguments and return number of
+    results in the stack.
+    Return -1 on error.
+    */
+    template <typename... T>
+    int32 ExecFunctionSafe(const LuaFunctionRef& fRef, T&&... args);
+
     /**
     Run `fName(...)` function with arguments and specified results types and 
     return vector of results.
@@ -169,6 +207,26 @@ public:
     */
     bool HasGlobalFunction(const String& vName);
 
+    /**
+    Find function in global table with name `fName` and return prepared
+    reference to it. Return invalid reference if function is not found.
+    */
+    LuaFunctionRef GetFunctionRef(const String& fName);
+
+    /**
+    Release prepared reference and make it invalid.
+    References which are not released are freed with script.
+    */
+    void ReleaseFunctionRef(LuaFunctionRef& fRef);
+
+    /**
+    Set directory for storing compiled scripts. Scripts loaded by `ExecScript`
+    and `require` are compiled once and then loaded from cache until their
+    sources are changed. Compiled scripts are always cached in memory, empty
+    path disables storing them on disk.
+    */
+    static void SetBytecodeCacheDirectory(const FilePath& directory);
+
     /**
     Dump current content of the stack to `ostream`.
     */
@@ -187,11 +245,35 @@ private:
     */
     void BeginCallFunction(const String& fName);
 
+    /**
+    Put function by prepared reference at top of the stack.
+    */
+    void BeginCallFunction(const LuaFunctionRef& fRef);
+
     /**
     Put any value at top of the stack.
     */
     void PushArg(const Any& any);
 
+    /**
+    Put value of specified type at top of the stack without boxing to Any.
+    */
+    void PushArg(bool value);
+    void PushArg(int32 value);
+    void PushArg(uint32 value);
+    void PushArg(float32 value);
+    void PushArg(float64 value);
+    void PushArg(const char8* value);
+    void PushArg(const String& value);
+    void PushArg(const FastName& value);
+    void PushArg(const Reflection& value);
+
+    /**
+    Put value of other types at top of the stack through Any.
+    */
+    template <typename T>
+    void PushArg(const T& value);
+
     /**
     Call Lua function with `nargs` arguments on top of stack, pop they
     and return number of function results in stack.
@@ -214,12 +296,26 @@ private:
     int32 errorHandlerRef; //<! Unique index of error handler function in global Lua namespace
 };
 
+inline bool LuaFunctionRef::IsValid() const
+{
+    return ref > 0;
+}
+
 template <typename... T>
 inline int32 LuaScript::ExecFunction(const String& fName, T&&... args)
 {
     BeginCallFunction(fName);
     const int32 size = sizeof...(args);
-    bool vargs[] = { true, (PushArg(Any(std::forward<T>(args))), true)... };
+    bool vargs[] = { true, (PushArg(std::forward<T>(args)), true)... };
+    return EndCallFunction(size);
+}
+
+template <typename... T>
+inline int32 LuaScript::ExecFunction(const LuaFunctionRef& fRef, T&&... args)
+{
+    BeginCallFunction(fRef);
+    const int32 size = sizeof...(args);
+    bool vargs[] = { true, (PushArg(std::forward<T>(args)), true)... };
     return EndCallFunction(size);
 }
 
@@ -237,6 +333,26 @@ inline int32 LuaScript::ExecFunctionSafe(const String& fName, T&&... args)
     }
 }
 
+template <typename... T>
+inline int32 LuaScript::ExecFunctionSafe(const LuaFunctionRef& fRef, T&&... args)
+{
+    try
+    {
+        return ExecFunction(fRef, std::forward<T>(args)...);
+    }
+    catch (const LuaException& e)
+    {
+        DAVA::Logger::Warning(Format("LuaException: %s", e.what()).c_str());
+        return -1;
+    }
+}
+
+template <typename T>
+inline void LuaScript::PushArg(const T& value)
+{
+    PushArg(Any(value));
+}
+
 template <typename T>
 inline Any LuaScript::GetResult(int32 index) const
 {
@@ -1,10 +1,13 @@
 #include "LuaBridge.h"
+#include "Base/ScopedPtr.h"
 #include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/KeyedArchive.h"
 #include "Logger/Logger.h"
 #include "Reflection/ReflectedTypeDB.h"
 #include "Scripting/LuaException.h"
+#include "Scripting/Private/LuaBytecodeCache.h"
 #include "Utils/StringFormat.h"
 #include "Utils/UTF8Utils.h"
 
@@ -75,7 +78,40 @@ int LuaModulesLoader(lua_State* L)
 {
     String module = lua_tostring(L, 1);
     FilePath path = path.CreateWithNewExtension(module, ".lua");
-    luaL_loadfile(L, path.GetAbsolutePathname().c_str());
+    String chunkName = "@" + path.GetAbsolutePathname();
+
+    ScopedPtr<File> file(File::Create(path, File::OPEN | File::READ));
+    if (!file)
+    {
+        lua_pushfstring(L, "cannot open %s", chunkName.c_str() + 1);
+        return 1;
+    }
+
+    Vector<char8> buffer(static_cast<size_t>(file->GetSize()));
+    if (file->Read(buffer.data(), static_cast<uint32>(buffer.size())) != buffer.size())
+    {
+        lua_pushfstring(L, "cannot read %s", chunkName.c_str() + 1);
+        return 1;
+    }
+
+    // Skip UTF-8 BOM and '#' first line (e.g. "#!/usr/bin/lua") like luaL_loadfile does,
+    // line break is kept so line numbers in error messages stay the same
+    const char8* source = buffer.data();
+    size_t size = buffer.size();
+    if (size >= 3 && memcmp(source, "\xEF\xBB\xBF", 3) == 0)
+    {
+        source += 3;
+        size -= 3;
+    }
+    if (size > 0 && source[0] == '#')
+    {
+        const char8* lineEnd = static_cast<const char8*>(memchr(source, '\n', size));
+        size_t skip = (lineEnd != nullptr) ? static_cast<size_t>(lineEnd - source) : size;
+        source += skip;
+        size -= skip;
+    }
+
+    LuaBytecodeCache::LoadBuffer(L, source, size, chunkName.c_str());
     return 1;
 }
 
@@ -818,6 +854,18 @@ Any LuaToAny(lua_State* L, int32 index, const Type* preferredType /*= nullptr*/)
 #undef THROWTYPE
 }
 
+void ReflectionToLua(lua_State* L, const Reflection& refl)
+{
+    if (refl.IsValid())
+    {
+        lua_pushdvreflection(L, refl);
+    }
+    else
+    {
+        lua_pushnil(L); // Push nil if reflection isn't valid
+    }
+}
+
 void AnyToLua(lua_State* L, const Any& value)
 {
 #define CANGET(t) (value.CanGet<t>())
@@ -860,15 +908,7 @@ void AnyToLua(lua_State* L, const Any& value)
     }
     else if CANGET(Reflection)
     {
-        Reflection ref = value.Get<Reflection>();
-        if (ref.IsValid())
-        {
-            lua_pushdvreflection(L, ref);
-        }
-        else
-        {
-            lua_pushnil(L); // Push nil if reflection isn't valid
-        }
+        ReflectionToLua(L, value.Get<Reflection>());
     }
     else IFPUSH(AnyFn, lua_pushdvanyfn) else // unknown type
     {
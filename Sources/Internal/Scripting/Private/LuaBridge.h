@@ -13,6 +13,8 @@ extern "C"
 
 namespace DAVA
 {
+class Reflection;
+
 namespace LuaBridge
 {
 /**
@@ -50,6 +52,12 @@ Put specified value as Lua variable to top of the stack.
 */
 void AnyToLua(lua_State* L, const Any& value);
 
+/**
+Put specified reflection as Lua variable to top of the stack.
+Invalid reflection is put as nil.
+*/
+void ReflectionToLua(lua_State* L, const Reflection& refl);
+
 /**
 Get string from top of stack and pop it.
 */
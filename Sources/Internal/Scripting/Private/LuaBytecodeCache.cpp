@@ -0,0 +1,165 @@
+#include "Scripting/Private/LuaBytecodeCache.h"
+#include "Base/ScopedPtr.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Utils/MD5.h"
+#include "Utils/StringFormat.h"
+
+extern "C"
+{
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace DAVA
+{
+namespace LuaBytecodeCache
+{
+namespace LuaBytecodeCacheDetails
+{
+using Bytecode = std::shared_ptr<const Vector<uint8>>;
+
+Mutex mutex;
+FilePath directory;
+UnorderedMap<String, Bytecode> chunks;
+
+String GetKey(const char8* source, size_t size, const char8* chunkName)
+{
+    // compiled chunks depend on Lua version and size of pointer
+    static const String version = Format("%s %u", LUA_VERSION, static_cast<uint32>(sizeof(void*)));
+
+    MD5 md5;
+    md5.Init();
+    md5.Update(reinterpret_cast<const uint8*>(version.data()), static_cast<uint32>(version.size() + 1));
+    md5.Update(reinterpret_cast<const uint8*>(chunkName), static_cast<uint32>(strlen(chunkName) + 1));
+    md5.Update(reinterpret_cast<const uint8*>(source), static_cast<uint32>(size));
+    md5.Final();
+    return MD5::HashToString(md5.GetDigest());
+}
+
+FilePath GetChunkPath(const String& key)
+{
+    return directory + (key + ".luac");
+}
+
+Bytecode FindChunk(const String& key)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    auto found = chunks.find(key);
+    if (found != chunks.end())
+    {
+        return found->second;
+    }
+
+    if (!directory.IsEmpty())
+    {
+        ScopedPtr<File> file(File::Create(GetChunkPath(key), File::OPEN | File::READ));
+        if (file)
+        {
+            auto bytecode = std::make_shared<Vector<uint8>>(static_cast<size_t>(file->GetSize()));
+            if (file->Read(bytecode->data(), static_cast<uint32>(bytecode->size())) == bytecode->size())
+            {
+                chunks[key] = bytecode;
+                return bytecode;
+            }
+        }
+    }
+
+    return Bytecode();
+}
+
+void AddChunk(const String& key, const Bytecode& bytecode)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    chunks[key] = bytecode;
+
+    if (!directory.IsEmpty())
+    {
+        ScopedPtr<File> file(File::Create(GetChunkPath(key), File::CREATE | File::WRITE));
+        if (!file || file->Write(bytecode->data(), static_cast<uint32>(bytecode->size())) != bytecode->size())
+        {
+            Logger::Warning("[LuaBytecodeCache] Can't write compiled chunk to %s", GetChunkPath(key).GetStringValue().c_str());
+        }
+    }
+}
+
+void RemoveChunk(const String& key)
+{
+    LockGuard<Mutex> lock(mutex);
+    chunks.erase(key);
+}
+
+int32 ChunkWriter(lua_State* L, const void* p, size_t size, void* ud)
+{
+    Vector<uint8>* bytecode = static_cast<Vector<uint8>*>(ud);
+    const uint8* data = static_cast<const uint8*>(p);
+    bytecode->insert(bytecode->end(), data, data + size);
+    return 0;
+}
+} // namespace LuaBytecodeCacheDetails
+
+void SetDirectory(const FilePath& directory)
+{
+    using namespace LuaBytecodeCacheDetails;
+
+    LockGuard<Mutex> lock(mutex);
+    LuaBytecodeCacheDetails::directory = directory;
+    if (!directory.IsEmpty())
+    {
+        LuaBytecodeCacheDetails::directory.MakeDirectoryPathname();
+        FileSystem::Instance()->CreateDirectory(LuaBytecodeCacheDetails::directory, true);
+    }
+}
+
+void Clear()
+{
+    using namespace LuaBytecodeCacheDetails;
+
+    LockGuard<Mutex> lock(mutex);
+    chunks.clear();
+}
+
+int32 LoadBuffer(lua_State* L, const char8* source, size_t size, const char8* chunkName)
+{
+    using namespace LuaBytecodeCacheDetails;
+
+    if (size > 0 && source[0] == LUA_SIGNATURE[0])
+    {
+        // already compiled chunk
+        return luaL_loadbuffer(L, source, size, chunkName);
+    }
+
+    String key = GetKey(source, size, chunkName);
+
+    Bytecode bytecode = FindChunk(key);
+    if (bytecode)
+    {
+        const char8* data = reinterpret_cast<const char8*>(bytecode->data());
+        if (luaL_loadbuffer(L, data, bytecode->size(), chunkName) == 0)
+        {
+            return 0;
+        }
+
+        // stored chunk is corrupted or compiled by incompatible Lua, compile it again
+        lua_pop(L, 1); // stack -1: error message
+        RemoveChunk(key);
+    }
+
+    int32 res = luaL_loadbuffer(L, source, size, chunkName); // stack +1: chunk or error message
+    if (res == 0)
+    {
+        auto compiled = std::make_shared<Vector<uint8>>();
+        if (lua_dump(L, &ChunkWriter, compiled.get()) == 0 && !compiled->empty())
+        {
+            AddChunk(key, compiled);
+        }
+    }
+    return res;
+}
+}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+struct lua_State;
+
+namespace DAVA
+{
+class FilePath;
+
+/**
+Cache of compiled Lua chunks shared by all Lua states.
+Chunks are keyed by MD5 of source, chunk name and Lua version, so changed
+sources are compiled again. Compiled chunks are kept in memory and optionally
+stored to disk in specified directory.
+*/
+namespace LuaBytecodeCache
+{
+/**
+Set directory for storing compiled chunks. Empty path disables disk cache.
+*/
+void SetDirectory(const FilePath& directory);
+
+/**
+Remove all compiled chunks from memory. Files on disk are kept.
+*/
+void Clear();
+
+/**
+Load chunk from `source` buffer with specified `chunkName` to top of the stack.
+Use compiled chunk from cache if it exists, otherwise compile source and put
+result to cache. Return result of `luaL_loadbuffer`.
+*/
+int32 LoadBuffer(lua_State* L, const char8* source, size_t size, const char8* chunkName);
+}
+}
@@ -1,10 +1,13 @@
+#include "Base/FastName.h"
 #include "Base/ScopedPtr.h"
 #include "Debug/DVAssert.h"
 #include "Engine/Engine.h"
 #include "FileSystem/File.h"
+#include "Reflection/Reflection.h"
 #include "Scripting/LuaScript.h"
 #include "Scripting/LuaException.h"
 #include "Scripting/Private/LuaBridge.h"
+#include "Scripting/Private/LuaBytecodeCache.h"
 
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 #include "MemoryManager/MemoryProfiler.h"
@@ -156,7 +159,7 @@ int32 LuaScript::ExecScript(const FilePath& scriptPath)
         DAVA_THROW(LuaException, LUA_ERRFILE, Format("Error while reading file %s", scriptPath.GetStringValue().c_str()).c_str());
     }
 
-    int32 res = luaL_loadbuffer(state->lua, buffer.data(), buffer.size(), scriptPath.GetStringValue().c_str());
+    int32 res = LuaBytecodeCache::LoadBuffer(state->lua, buffer.data(), buffer.size(), scriptPath.GetStringValue().c_str());
     if (res != 0)
     {
         DAVA_THROW(LuaException, res, LuaBridge::PopString(state->lua)); // stack -1
@@ -306,6 +309,35 @@ bool LuaScript::HasGlobalFunction(const String& fName)
     return found;
 }
 
+LuaFunctionRef LuaScript::GetFunctionRef(const String& fName)
+{
+    LuaFunctionRef fRef;
+    lua_getglobal(state->lua, fName.c_str()); // stack +1: function
+    if (lua_isfunction(state->lua, -1))
+    {
+        fRef.ref = luaL_ref(state->lua, LUA_REGISTRYINDEX); // stack -1: store function in registry table
+    }
+    else
+    {
+        lua_pop(state->lua, 1); // stack -1
+    }
+    return fRef;
+}
+
+void LuaScript::ReleaseFunctionRef(LuaFunctionRef& fRef)
+{
+    if (fRef.IsValid())
+    {
+        luaL_unref(state->lua, LUA_REGISTRYINDEX, fRef.ref);
+        fRef.ref = 0;
+    }
+}
+
+void LuaScript::SetBytecodeCacheDirectory(const FilePath& directory)
+{
+    LuaBytecodeCache::SetDirectory(directory);
+}
+
 void LuaScript::DumpStack(std::ostream& os) const
 {
     LuaBridge::DumpStack(state->lua, os);
@@ -327,11 +359,69 @@ void LuaScript::BeginCallFunction(const String& fName)
     lua_getglobal(state->lua, fName.c_str()); // stack +1: main() function
 }
 
+void LuaScript::BeginCallFunction(const LuaFunctionRef& fRef)
+{
+    if (fRef.IsValid())
+    {
+        lua_rawgeti(state->lua, LUA_REGISTRYINDEX, fRef.ref); // stack +1: function
+    }
+    else
+    {
+        lua_pushnil(state->lua); // stack +1: call will fail with error
+    }
+}
+
 void LuaScript::PushArg(const Any& any)
 {
     LuaBridge::AnyToLua(state->lua, any); // stack +1: function arg
 }
 
+void LuaScript::PushArg(bool value)
+{
+    lua_pushboolean(state->lua, value); // stack +1: function arg
+}
+
+void LuaScript::PushArg(int32 value)
+{
+    lua_pushinteger(state->lua, value); // stack +1: function arg
+}
+
+void LuaScript::PushArg(uint32 value)
+{
+    lua_pushinteger(state->lua, value); // stack +1: function arg
+}
+
+void LuaScript::PushArg(float32 value)
+{
+    lua_pushnumber(state->lua, value); // stack +1: function arg
+}
+
+void LuaScript::PushArg(float64 value)
+{
+    lua_pushnumber(state->lua, value); // stack +1: function arg
+}
+
+void LuaScript::PushArg(const char8* value)
+{
+    lua_pushstring(state->lua, value); // stack +1: function arg
+}
+
+void LuaScript::PushArg(const String& value)
+{
+    lua_pushlstring(state->lua, value.c_str(), value.length()); // stack +1: function arg
+}
+
+void LuaScript::PushArg(const FastName& value)
+{
+    const char8* str = value.c_str();
+    lua_pushstring(state->lua, str != nullptr ? str : ""); // stack +1: function arg
+}
+
+void LuaScript::PushArg(const Reflection& value)
+{
+    LuaBridge::ReflectionToLua(state->lua, value); // stack +1: function arg
+}
+
 int32 LuaScript::EndCallFunction(int32 nargs)
 {
     int32 base = lua_gettop(state->lua) - nargs; // store function stack index
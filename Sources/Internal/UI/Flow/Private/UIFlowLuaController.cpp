@@ -37,7 +37,7 @@ UIFlowLuaController::UIFlowLuaController(const FilePath& scriptPath)
         return;
     }
 
-    hasProcess = script->HasGlobalFunction(PROCESS_FNAME);
+    processFn = script->GetFunctionRef(PROCESS_FNAME);
     hasProcessEvent = script->HasGlobalFunction(PROCESS_EVENT_FNAME);
 }
 
@@ -103,9 +103,9 @@ void UIFlowLuaController::Deactivate(UIFlowContext* context, UIControl* view)
 
 void UIFlowLuaController::Process(float32 elapsedTime)
 {
-    if (hasProcess)
+    if (processFn.IsValid())
     {
-        script->ExecFunctionSafe(PROCESS_FNAME, elapsedTime);
+        script->ExecFunctionSafe(processFn, elapsedTime);
     }
 }
 
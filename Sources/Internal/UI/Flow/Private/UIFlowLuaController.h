@@ -2,13 +2,13 @@
 
 #include "FileSystem/FilePath.h"
 #include "Reflection/Reflection.h"
+#include "Scripting/LuaScript.h"
 #include "UI/Flow/UIFlowController.h"
 
 namespace DAVA
 {
 class UIFlowContext;
 class UIControl;
-class LuaScript;
 
 /**
     Specialization of UIFlowController which use Lua script as Flow controller.
@@ -43,8 +43,8 @@ public:
 
 private:
     bool loaded = false;
-    bool hasProcess = false;
     bool hasProcessEvent = false;
     std::unique_ptr<LuaScript> script;
+    LuaFunctionRef processFn;
 };
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Layout of compiled UI package, written by `UIPackageCompiler` and read by `UIBinaryPackageLoader`.
+
+    All numbers are little-endian, strings are referenced by index in string table.
+    ```
+    Header          signature, format version, package version, MD5 of source yaml
+    Strings         count, [length, utf8 bytes]
+    Types           count, [permanent name]
+    Fields          count, [type, field name, field index in ReflectedStructure]
+    StyleProperties count, [full property name]
+    Imports         count, [package path]
+    StyleSheets     count, [selectors count, [selector], properties count, [style property, transition, function, time, value]]
+    Roots           count, [control name, control place, commands offset, commands size]
+    Commands        size, stream of commands
+    ```
+    Roots are top-level prototypes and controls in order of their completion, so prototypes
+    from the same package are always loaded before controls which use them.
+    Commands repeat calls of `AbstractUIPackageBuilder`, legacy properties are already converted.
+    MD5 of source yaml is used to ignore compiled package when yaml was edited after compilation.
+*/
+namespace UIPackageBinaryFormat
+{
+const uint32 SIGNATURE = 0x50495544; // "DUIP"
+const uint32 FORMAT_VERSION = 2;
+const uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+enum eCommand : uint8
+{
+    CMD_BEGIN_CONTROL_WITH_CLASS = 0,
+    CMD_BEGIN_CONTROL_WITH_CUSTOM_CLASS,
+    CMD_BEGIN_CONTROL_WITH_PROTOTYPE,
+    CMD_BEGIN_CONTROL_WITH_PATH,
+    CMD_END_CONTROL,
+    CMD_BEGIN_CONTROL_PROPERTIES,
+    CMD_END_CONTROL_PROPERTIES,
+    CMD_BEGIN_COMPONENT_PROPERTIES,
+    CMD_END_COMPONENT_PROPERTIES,
+    CMD_PROPERTY,
+    CMD_DATA_BINDING
+};
+
+enum eValueTag : uint8
+{
+    VALUE_EMPTY = 0,
+    VALUE_BOOL,
+    VALUE_INT32,
+    VALUE_UINT32,
+    VALUE_INT64,
+    VALUE_UINT64,
+    VALUE_FLOAT32,
+    VALUE_FASTNAME,
+    VALUE_STRING,
+    VALUE_WIDESTRING,
+    VALUE_VECTOR2,
+    VALUE_VECTOR3,
+    VALUE_VECTOR4,
+    VALUE_COLOR,
+    VALUE_RECT,
+    VALUE_FILEPATH,
+    VALUE_ENUM // int32 reinterpreted to field type
+};
+
+class Writer
+{
+public:
+    explicit Writer(Vector<uint8>& buffer_)
+        : buffer(buffer_)
+    {
+    }
+
+    template <typename T>
+    void Write(const T& value)
+    {
+        const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        const uint8* bytes = static_cast<const uint8*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+private:
+    Vector<uint8>& buffer;
+};
+
+class Reader
+{
+public:
+    Reader(const uint8* begin_, const uint8* end_)
+        : pos(begin_)
+        , end(end_)
+    {
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T value = T();
+        if (sizeof(T) <= static_cast<size_t>(end - pos))
+        {
+            Memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+        }
+        else
+        {
+            SetFailed();
+        }
+        return value;
+    }
+
+    const uint8* ReadBytes(size_t size)
+    {
+        if (size <= static_cast<size_t>(end - pos))
+        {
+            const uint8* bytes = pos;
+            pos += size;
+            return bytes;
+        }
+
+        SetFailed();
+        return nullptr;
+    }
+
+    void SetFailed()
+    {
+        failed = true;
+        pos = end;
+    }
+
+    bool IsFailed() const
+    {
+        return failed;
+    }
+
+    bool IsEnd() const
+    {
+        return pos == end;
+    }
+
+private:
+    const uint8* pos;
+    const uint8* end;
+    bool failed = false;
+};
+} // namespace UIPackageBinaryFormat
+} // namespace DAVA
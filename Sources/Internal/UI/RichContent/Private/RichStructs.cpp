@@ -5,6 +5,26 @@
 
 namespace DAVA
 {
+bool RichContentItem::operator==(const RichContentItem& other) const
+{
+    return type == other.type &&
+    direction == other.direction &&
+    newLineBefore == other.newLineBefore &&
+    stickBefore == other.stickBefore &&
+    stickHardBefore == other.stickHardBefore &&
+    classes == other.classes &&
+    text == other.text &&
+    path == other.path &&
+    controlName == other.controlName &&
+    prototypeName == other.prototypeName &&
+    name == other.name;
+}
+
+bool RichContentItem::operator!=(const RichContentItem& other) const
+{
+    return !(*this == other);
+}
+
 void RichContentAliasesLink::PutAlias(const RichContentAlias& alias)
 {
     aliases.push_back(alias);
@@ -26,9 +46,10 @@ void RichContentAliasesLink::RemoveAll()
     aliases.clear();
 }
 
-void RichContentLink::AddItem(const RefPtr<UIControl>& item)
+void RichContentLink::AddItem(const RefPtr<UIControl>& item, const RichContentItem& description)
 {
     richItems.push_back(item);
+    itemsDescriptions.push_back(description);
 }
 
 void RichContentLink::RemoveItems()
@@ -45,6 +66,7 @@ void RichContentLink::RemoveItems()
         }
     }
     richItems.clear();
+    itemsDescriptions.clear();
 }
 
 void RichContentLink::AddAliases(UIRichContentAliasesComponent* component)
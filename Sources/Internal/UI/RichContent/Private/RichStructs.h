@@ -2,6 +2,7 @@
 
 #include "Base/Vector.h"
 #include "Base/RefPtr.h"
+#include "Utils/BiDiHelper.h"
 
 namespace DAVA
 {
@@ -16,6 +17,32 @@ struct RichContentAlias final
     Map<String, String> attributes;
 };
 
+/** Description of single rich content control, result of parsing of rich text which doesn't depend on controls. */
+struct RichContentItem final
+{
+    enum class Type : uint8
+    {
+        TEXT,
+        IMAGE,
+        OBJECT
+    };
+
+    Type type = Type::TEXT;
+    String classes;
+    String text; // text for TEXT and sprite path for IMAGE
+    String path; // package path for OBJECT
+    String controlName;
+    String prototypeName;
+    String name;
+    BiDiHelper::Direction direction = BiDiHelper::Direction::NEUTRAL;
+    bool newLineBefore = false;
+    bool stickBefore = false;
+    bool stickHardBefore = false;
+
+    bool operator==(const RichContentItem& other) const;
+    bool operator!=(const RichContentItem& other) const;
+};
+
 struct RichContentAliasesLink final
 {
     UIRichContentAliasesComponent* component = nullptr;
@@ -32,8 +59,11 @@ struct RichContentLink final
     UIRichContentComponent* component = nullptr;
     Vector<RichContentAliasesLink> aliasesLinks;
     Vector<RefPtr<UIControl>> richItems;
+    Vector<RichContentItem> itemsDescriptions; // descriptions of richItems
+    bool itemsEditorMode = false; // flags which were used for richItems creation
+    bool itemsDebugDraw = false;
 
-    void AddItem(const RefPtr<UIControl>& item);
+    void AddItem(const RefPtr<UIControl>& item, const RichContentItem& description);
     void RemoveItems();
     void AddAliases(UIRichContentAliasesComponent* component);
     void RemoveAliases(UIRichContentAliasesComponent* component);
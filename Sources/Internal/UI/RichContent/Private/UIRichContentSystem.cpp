@@ -5,6 +5,7 @@
 #include "Logger/Logger.h"
 #include "Render/RenderOptions.h"
 #include "Render/Renderer.h"
+#include "Time/SystemTimer.h"
 #include "UI/RichContent/Private/RichStructs.h"
 #include "UI/RichContent/Private/XMLAliasesBuilder.h"
 #include "UI/RichContent/Private/XMLRichContentBuilder.h"
@@ -15,6 +16,30 @@
 
 namespace DAVA
 {
+namespace UIRichContentSystemDetails
+{
+/** Build key of parsed text, it contains everything that affects parsing result */
+String BuildParsedTextKey(const RichContentLink* link)
+{
+    String key = link->component->GetBaseClasses();
+    key += link->component->GetClassesInheritance() ? "\n1" : "\n0";
+    for (const RichContentAliasesLink& alink : link->aliasesLinks)
+    {
+        for (const RichContentAlias& alias : alink.aliases)
+        {
+            key += "\n" + alias.alias + "\n" + alias.tag;
+            for (const auto& attribute : alias.attributes)
+            {
+                key += "\n" + attribute.first + "=" + attribute.second;
+            }
+        }
+        key += "\n";
+    }
+    key += "\n" + link->component->GetText();
+    return key;
+}
+}
+
 UIRichContentSystem::UIRichContentSystem()
 {
     Engine* engine = Engine::Instance();
@@ -181,37 +206,152 @@ void UIRichContentSystem::Process(float32 elapsedTime)
             {
                 onBeginProcessComponent.Emit(l->component);
 
-                UIControl* root = l->component->GetControl();
-                l->RemoveItems();
+                int64 beginTime = SystemTimer::GetUs();
 
-                XMLRichContentBuilder builder(l.get(), isEditorMode, isDebugDraw);
-                XMLParserStatus parserStatus = builder.Build("<span>" + l->component->GetText() + "</span>");
+                Vector<RichContentItem> items;
+                XMLParserStatus parserStatus = ParseText(l.get(), items);
                 if (parserStatus.Success())
                 {
-                    for (const RefPtr<UIControl>& ctrl : builder.GetControls())
-                    {
-                        root->AddControl(ctrl.Get());
-                        l->AddItem(ctrl);
-                    }
+                    UpdateItems(l.get(), items);
                 }
                 else
                 {
+                    l->RemoveItems();
+
                     const String message = Format("Syntax error in rich content text: %s (%d:%d)", parserStatus.errorMessage.c_str(), parserStatus.errorLine, parserStatus.errorPosition);
                     onTextXMLParsingError.Emit(l->component, message);
                     Logger::Error(message.c_str());
                 }
 
+                statistics.rebuildsCount++;
+                statistics.lastRebuildTimeUs = SystemTimer::GetUs() - beginTime;
+                statistics.rebuildTimeUs += statistics.lastRebuildTimeUs;
+
                 onEndProcessComponent.Emit(l->component);
             }
         }
     }
 }
 
+XMLParserStatus UIRichContentSystem::ParseText(RichContentLink* link, Vector<RichContentItem>& items)
+{
+    String key = UIRichContentSystemDetails::BuildParsedTextKey(link);
+    auto it = parsedTexts.find(key);
+    if (it != parsedTexts.end())
+    {
+        statistics.cachedTextsCount++;
+        items = it->second;
+        return XMLParserStatus();
+    }
+
+    XMLRichContentBuilder builder(link);
+    XMLParserStatus parserStatus = builder.Build("<span>" + link->component->GetText() + "</span>");
+    statistics.parsedTextsCount++;
+    if (parserStatus.Success())
+    {
+        items = builder.GetItems();
+        if (parsedTextsCacheSize > 0)
+        {
+            if (parsedTexts.size() >= parsedTextsCacheSize)
+            {
+                parsedTexts.clear();
+            }
+            parsedTexts.emplace(std::move(key), items);
+        }
+    }
+    return parserStatus;
+}
+
+void UIRichContentSystem::UpdateItems(RichContentLink* link, const Vector<RichContentItem>& items)
+{
+    // Controls depend on flags, so all of them are recreated after flags change
+    if (link->itemsEditorMode != isEditorMode || link->itemsDebugDraw != isDebugDraw)
+    {
+        link->RemoveItems();
+        link->itemsEditorMode = isEditorMode;
+        link->itemsDebugDraw = isDebugDraw;
+    }
+
+    // Unchanged items at the beginning and at the end keep their controls
+    const Vector<RichContentItem>& oldItems = link->itemsDescriptions;
+    size_t prefix = 0;
+    while (prefix < oldItems.size() && prefix < items.size() && oldItems[prefix] == items[prefix])
+    {
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < oldItems.size() - prefix && suffix < items.size() - prefix && oldItems[oldItems.size() - 1 - suffix] == items[items.size() - 1 - suffix])
+    {
+        suffix++;
+    }
+
+    UIControl* root = link->component->GetControl();
+    Vector<RefPtr<UIControl>> oldControls;
+    oldControls.swap(link->richItems);
+    link->itemsDescriptions.clear();
+
+    for (size_t i = prefix; i < oldControls.size() - suffix; ++i)
+    {
+        root->RemoveControl(oldControls[i].Get());
+    }
+
+    for (size_t i = 0; i < prefix; ++i)
+    {
+        link->AddItem(oldControls[i], items[i]);
+    }
+
+    // New controls are placed before first kept trailing control
+    const UIControl* nextControl = suffix > 0 ? oldControls[oldControls.size() - suffix].Get() : nullptr;
+    for (size_t i = prefix; i < items.size() - suffix; ++i)
+    {
+        RefPtr<UIControl> ctrl = XMLRichContentBuilder::CreateControl(items[i], link, isEditorMode, isDebugDraw);
+        if (ctrl.Get() != nullptr)
+        {
+            if (nextControl != nullptr)
+            {
+                root->InsertChildBelow(ctrl, nextControl);
+            }
+            else
+            {
+                root->AddControl(ctrl);
+            }
+            link->AddItem(ctrl, items[i]);
+            statistics.createdItemsCount++;
+        }
+    }
+
+    for (size_t i = oldControls.size() - suffix; i < oldControls.size(); ++i)
+    {
+        link->AddItem(oldControls[i], items[items.size() - oldControls.size() + i]);
+    }
+
+    statistics.reusedItemsCount += uint32(prefix + suffix);
+}
+
 void UIRichContentSystem::SetEditorMode(bool editorMode)
 {
     isEditorMode = editorMode;
 }
 
+void UIRichContentSystem::ResetStatistics()
+{
+    statistics = Statistics();
+}
+
+void UIRichContentSystem::SetParsedTextsCacheSize(uint32 size)
+{
+    parsedTextsCacheSize = size;
+    if (parsedTexts.size() > parsedTextsCacheSize)
+    {
+        parsedTexts.clear();
+    }
+}
+
+void UIRichContentSystem::ClearParsedTextsCache()
+{
+    parsedTexts.clear();
+}
+
 void UIRichContentSystem::AddLink(UIRichContentComponent* component)
 {
     DVASSERT(component);
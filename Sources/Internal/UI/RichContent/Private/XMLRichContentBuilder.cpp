@@ -21,10 +21,8 @@
 
 namespace DAVA
 {
-XMLRichContentBuilder::XMLRichContentBuilder(RichContentLink* link_, bool editorMode /*= false*/, bool debugDraw /*= false*/)
-    : isEditorMode(editorMode)
-    , isDebugDraw(debugDraw)
-    , link(link_)
+XMLRichContentBuilder::XMLRichContentBuilder(RichContentLink* link_)
+    : link(link_)
 {
     DVASSERT(link);
     defaultClasses = link->component->GetBaseClasses();
@@ -35,52 +33,98 @@ XMLRichContentBuilder::XMLRichContentBuilder(RichContentLink* link_, bool editor
 
 XMLParserStatus XMLRichContentBuilder::Build(const String& text)
 {
-    controls.clear();
+    items.clear();
     direction = bidiHelper.GetDirectionUTF8String(text); // Detect text direction
     return XMLParser::ParseStringEx(text, this);
 }
 
-const Vector<RefPtr<UIControl>>& XMLRichContentBuilder::GetControls() const
+const Vector<RichContentItem>& XMLRichContentBuilder::GetItems() const
 {
-    return controls;
+    return items;
 }
 
-void XMLRichContentBuilder::PutClass(const String& clazz)
+RefPtr<UIControl> XMLRichContentBuilder::CreateControl(const RichContentItem& item, RichContentLink* link, bool editorMode, bool debugDraw)
 {
-    String compositeClass;
-    if (classesInheritance)
+    RefPtr<UIControl> ctrl;
+    bool autosize = true;
+    switch (item.type)
     {
-        compositeClass = GetClass();
-        if (!clazz.empty())
+    case RichContentItem::Type::TEXT:
+    {
+        ctrl.Set(new UIControl());
+        ctrl->SetInputEnabled(false, false);
+        UITextComponent* txt = ctrl->GetOrCreateComponent<UITextComponent>();
+        txt->SetText(item.text);
+        break;
+    }
+    case RichContentItem::Type::IMAGE:
+    {
+        ctrl.Set(new UIControl());
+        ctrl->SetInputEnabled(false, false);
+        UIControlBackground* bg = ctrl->GetOrCreateComponent<UIControlBackground>();
+        bg->SetDrawType(UIControlBackground::DRAW_STRETCH_BOTH);
+        bg->SetSprite(FilePath(item.text));
+        break;
+    }
+    case RichContentItem::Type::OBJECT:
+    {
+        // Check that we not load self as rich object
+        UIControl* parent = link->control;
+        while (parent != nullptr)
         {
-            compositeClass += " ";
+            UIControlSourceComponent* objComp = parent->GetComponent<UIControlSourceComponent>();
+            if (objComp)
+            {
+                if (item.path == objComp->GetPackagePath() &&
+                    item.controlName == objComp->GetControlName() &&
+                    item.prototypeName == objComp->GetPrototypeName())
+                {
+                    Logger::Error("Recursive object in rich content from '%s' with name '%s'!",
+                                  item.path.c_str(),
+                                  item.controlName.empty() ? item.prototypeName.c_str() : item.controlName.c_str());
+                    return RefPtr<UIControl>();
+                }
+            }
+            parent = parent->GetParent();
         }
-    }
-    compositeClass += clazz;
 
-    classesStack.push_back(compositeClass);
-}
+        DefaultUIPackageBuilder pkgBuilder;
+        pkgBuilder.SetEditorMode(editorMode);
+        UIPackageLoader().LoadPackage(item.path, &pkgBuilder);
+        UIPackage* pkg = pkgBuilder.GetPackage();
+        if (pkg != nullptr)
+        {
+            if (!item.controlName.empty())
+            {
+                ctrl = RefPtr<UIControl>::ConstructWithRetain(pkg->GetControl(item.controlName));
+            }
+            else if (!item.prototypeName.empty())
+            {
+                ctrl = RefPtr<UIControl>::ConstructWithRetain(pkg->GetPrototype(item.prototypeName));
+            }
+        }
+        if (ctrl.Get() == nullptr)
+        {
+            return RefPtr<UIControl>();
+        }
 
-void XMLRichContentBuilder::PopClass()
-{
-    classesStack.pop_back();
-}
+        if (!item.name.empty())
+        {
+            ctrl->SetName(item.name);
+        }
 
-const String& XMLRichContentBuilder::GetClass() const
-{
-    if (classesStack.empty())
-    {
-        static const String EMPTY;
-        return EMPTY;
+        UIControlSourceComponent* objComp = ctrl->GetOrCreateComponent<UIControlSourceComponent>();
+        objComp->SetPackagePath(item.path);
+        objComp->SetControlName(item.controlName);
+        objComp->SetPrototypeName(item.prototypeName);
+        autosize = false;
+        break;
+    }
     }
-    return classesStack.back();
-}
 
-void XMLRichContentBuilder::PrepareControl(UIControl* ctrl, bool autosize)
-{
-    ctrl->SetClassesFromString(ctrl->GetClassesAsString() + " " + GetClass());
+    ctrl->SetClassesFromString(ctrl->GetClassesAsString() + " " + item.classes);
 
-    if (isEditorMode)
+    if (editorMode)
     {
         UILayoutSourceRectComponent* src = ctrl->GetOrCreateComponent<UILayoutSourceRectComponent>();
         src->SetSize(ctrl->GetSize());
@@ -95,37 +139,37 @@ void XMLRichContentBuilder::PrepareControl(UIControl* ctrl, bool autosize)
     }
 
     UIFlowLayoutHintComponent* flh = ctrl->GetOrCreateComponent<UIFlowLayoutHintComponent>();
-    flh->SetContentDirection(direction);
-    if (needLineBreak)
+    flh->SetContentDirection(item.direction);
+    if (item.newLineBefore)
     {
         flh->SetNewLineBeforeThis(true);
     }
-    else if (!needSpace)
+    else if (item.stickBefore)
     {
         flh->SetStickItemBeforeThis(true);
-        if (!needSoftStick)
+        if (item.stickHardBefore)
         {
             flh->SetStickHardBeforeThis(true);
         }
     }
 
-    if (isDebugDraw)
+    if (debugDraw)
     {
         UIDebugRenderComponent* debug = ctrl->GetOrCreateComponent<UIDebugRenderComponent>();
         debug->SetEnabled(true);
-        if (needLineBreak)
+        if (item.newLineBefore)
         {
             debug->SetDrawColor(Color::Yellow);
         }
-        else if (!needSpace)
+        else if (item.stickBefore)
         {
-            if (needSoftStick)
+            if (item.stickHardBefore)
             {
-                debug->SetDrawColor(Color::Cyan);
+                debug->SetDrawColor(Color::Blue);
             }
             else
             {
-                debug->SetDrawColor(Color::Blue);
+                debug->SetDrawColor(Color::Cyan);
             }
         }
         else
@@ -134,14 +178,57 @@ void XMLRichContentBuilder::PrepareControl(UIControl* ctrl, bool autosize)
         }
     }
 
-    needSpace = false;
-    needLineBreak = false;
-    needSoftStick = false;
+    if (item.type == RichContentItem::Type::OBJECT)
+    {
+        link->component->onCreateObject.Emit(ctrl.Get());
+    }
+
+    return ctrl;
 }
 
-void XMLRichContentBuilder::AppendControl(UIControl* ctrl)
+void XMLRichContentBuilder::PutClass(const String& clazz)
 {
-    controls.emplace_back(RefPtr<UIControl>::ConstructWithRetain(ctrl));
+    String compositeClass;
+    if (classesInheritance)
+    {
+        compositeClass = GetClass();
+        if (!clazz.empty())
+        {
+            compositeClass += " ";
+        }
+    }
+    compositeClass += clazz;
+
+    classesStack.push_back(compositeClass);
+}
+
+void XMLRichContentBuilder::PopClass()
+{
+    classesStack.pop_back();
+}
+
+const String& XMLRichContentBuilder::GetClass() const
+{
+    if (classesStack.empty())
+    {
+        static const String EMPTY;
+        return EMPTY;
+    }
+    return classesStack.back();
+}
+
+void XMLRichContentBuilder::AppendItem(RichContentItem& item)
+{
+    item.classes = GetClass();
+    item.direction = direction;
+    item.newLineBefore = needLineBreak;
+    item.stickBefore = !needLineBreak && !needSpace;
+    item.stickHardBefore = item.stickBefore && !needSoftStick;
+    items.push_back(item);
+
+    needSpace = false;
+    needLineBreak = false;
+    needSoftStick = false;
 }
 
 void XMLRichContentBuilder::OnElementStarted(const String& elementName, const String& namespaceURI, const String& qualifedName, const Map<String, String>& attributes)
@@ -202,12 +289,10 @@ void XMLRichContentBuilder::ProcessTagBegin(const String& tag, const Map<String,
         if (needLineBreak)
         {
             // Append text with space for additional empty line
-            RefPtr<UIControl> ctrl(new UIControl());
-            PrepareControl(ctrl.Get(), true);
-            ctrl->SetInputEnabled(false, false);
-            UITextComponent* txt = ctrl->GetOrCreateComponent<UITextComponent>();
-            txt->SetText(" ");
-            AppendControl(ctrl.Get());
+            RichContentItem item;
+            item.type = RichContentItem::Type::TEXT;
+            item.text = " ";
+            AppendItem(item);
         }
         needLineBreak = true;
     }
@@ -221,94 +306,25 @@ void XMLRichContentBuilder::ProcessTagBegin(const String& tag, const Map<String,
     }
     else if (tag == "img")
     {
-        String src;
-        if (GetAttribute(attributes, "src", src))
+        RichContentItem item;
+        if (GetAttribute(attributes, "src", item.text))
         {
-            RefPtr<UIControl> img(new UIControl());
-            PrepareControl(img.Get(), true);
-            img->SetInputEnabled(false, false);
-            UIControlBackground* bg = img->GetOrCreateComponent<UIControlBackground>();
-            bg->SetDrawType(UIControlBackground::DRAW_STRETCH_BOTH);
-            bg->SetSprite(FilePath(src));
-            AppendControl(img.Get());
+            item.type = RichContentItem::Type::IMAGE;
+            AppendItem(item);
         }
     }
     else if (tag == "object")
     {
-        String path;
-        GetAttribute(attributes, "path", path);
-        String controlName;
-        GetAttribute(attributes, "control", controlName);
-        String prototypeName;
-        GetAttribute(attributes, "prototype", prototypeName);
-        String name;
-        GetAttribute(attributes, "name", name);
-
-        if (!path.empty() && (!controlName.empty() || !prototypeName.empty()))
+        RichContentItem item;
+        item.type = RichContentItem::Type::OBJECT;
+        GetAttribute(attributes, "path", item.path);
+        GetAttribute(attributes, "control", item.controlName);
+        GetAttribute(attributes, "prototype", item.prototypeName);
+        GetAttribute(attributes, "name", item.name);
+
+        if (!item.path.empty() && (!item.controlName.empty() || !item.prototypeName.empty()))
         {
-            // Check that we not load self as rich object
-            bool valid = true;
-            {
-                UIControl* ctrl = link->control;
-                while (ctrl != nullptr)
-                {
-                    UIControlSourceComponent* objComp = ctrl->GetComponent<UIControlSourceComponent>();
-                    if (objComp)
-                    {
-                        if (path == objComp->GetPackagePath() &&
-                            controlName == objComp->GetControlName() &&
-                            prototypeName == objComp->GetPrototypeName())
-                        {
-                            valid = false;
-                            break;
-                        }
-                    }
-                    ctrl = ctrl->GetParent();
-                }
-            }
-
-            if (valid)
-            {
-                DefaultUIPackageBuilder pkgBuilder;
-                pkgBuilder.SetEditorMode(isEditorMode);
-                UIPackageLoader().LoadPackage(path, &pkgBuilder);
-                UIControl* obj = nullptr;
-                UIPackage* pkg = pkgBuilder.GetPackage();
-                if (pkg != nullptr)
-                {
-                    if (!controlName.empty())
-                    {
-                        obj = pkg->GetControl(controlName);
-                    }
-                    else if (!prototypeName.empty())
-                    {
-                        obj = pkg->GetPrototype(prototypeName);
-                    }
-                }
-                if (obj != nullptr)
-                {
-                    if (!name.empty())
-                    {
-                        obj->SetName(name);
-                    }
-
-                    PrepareControl(obj, false);
-
-                    UIControlSourceComponent* objComp = obj->GetOrCreateComponent<UIControlSourceComponent>();
-                    objComp->SetPackagePath(path);
-                    objComp->SetControlName(controlName);
-                    objComp->SetPrototypeName(prototypeName);
-
-                    link->component->onCreateObject.Emit(obj);
-                    AppendControl(obj);
-                }
-            }
-            else
-            {
-                Logger::Error("Recursive object in rich content from '%s' with name '%s'!",
-                              path.c_str(),
-                              controlName.empty() ? prototypeName.c_str() : controlName.c_str());
-            }
+            AppendItem(item);
         }
     }
 }
@@ -375,12 +391,10 @@ void XMLRichContentBuilder::ProcessText(const String& text)
                 direction = wordDirection;
             }
 
-            RefPtr<UIControl> ctrl(new UIControl());
-            PrepareControl(ctrl.Get(), true);
-            ctrl->SetInputEnabled(false, false);
-            UITextComponent* txt = ctrl->GetOrCreateComponent<UITextComponent>();
-            txt->SetText(token);
-            AppendControl(ctrl.Get());
+            RichContentItem item;
+            item.type = RichContentItem::Type::TEXT;
+            item.text = token;
+            AppendItem(item);
 
             token.clear();
         }
@@ -9,20 +9,24 @@
 
 namespace DAVA
 {
+struct RichContentItem;
 struct RichContentLink;
 class UIControl;
 
 class XMLRichContentBuilder final : public XMLParserDelegate
 {
 public:
-    /** Constructor with specified RichContentLink pointer and editor mode and debug draw flags. */
-    XMLRichContentBuilder(RichContentLink* link_, bool editorMode = false, bool debugDraw = false);
+    /** Constructor with specified RichContentLink pointer. Base classes and aliases are taken from link. */
+    XMLRichContentBuilder(RichContentLink* link_);
 
-    /** Parse specified text and build list of controls. */
+    /** Parse specified text and build list of items descriptions. */
     XMLParserStatus Build(const String& text);
 
-    /** Return generated controls. */
-    const Vector<RefPtr<UIControl>>& GetControls() const;
+    /** Return generated items descriptions. */
+    const Vector<RichContentItem>& GetItems() const;
+
+    /** Create control for specified item description with editor mode and debug draw flags. Return nullptr if control can't be created. */
+    static RefPtr<UIControl> CreateControl(const RichContentItem& item, RichContentLink* link, bool editorMode, bool debugDraw);
 
 protected:
     // XMLParserDelegate interface implementation
@@ -38,10 +42,8 @@ private:
     /** Return top class from stack. */
     const String& GetClass() const;
 
-    /** Setup base parameters in specified control. */
-    void PrepareControl(UIControl* ctrl, bool autosize);
-    /** Append control to the controls list. */
-    void AppendControl(UIControl* ctrl);
+    /** Setup base parameters in specified item and append it to the items list. */
+    void AppendItem(RichContentItem& item);
     /** Process open tag. */
     void ProcessTagBegin(const String& tag, const Map<String, String>& attributes);
     /** Process close tag. */
@@ -55,14 +57,12 @@ private:
     bool needLineBreak = false;
     bool needSpace = false;
     bool needSoftStick = false;
-    bool isEditorMode = false;
-    bool isDebugDraw = false;
     bool classesInheritance = false;
     BiDiHelper::Direction direction = BiDiHelper::Direction::NEUTRAL;
     String fullText;
     String defaultClasses;
     Vector<String> classesStack;
-    Vector<RefPtr<UIControl>> controls;
+    Vector<RichContentItem> items;
     RichContentLink* link = nullptr;
     BiDiHelper bidiHelper;
 };
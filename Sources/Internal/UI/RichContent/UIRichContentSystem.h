@@ -3,6 +3,7 @@
 #include "Base/BaseTypes.h"
 #include "Base/Observer.h"
 #include "Base/RefPtr.h"
+#include "FileSystem/XMLParserStatus.h"
 #include "UI/UISystem.h"
 #include "Functional/Signal.h"
 
@@ -11,11 +12,32 @@ namespace DAVA
 class UIControl;
 class UIRichContentAliasesComponent;
 class UIRichContentComponent;
+struct RichContentItem;
 struct RichContentLink;
 
+/**
+    System builds child controls of controls with `UIRichContentComponent` from rich text.
+
+    Parsed texts are cached by text, base classes and aliases, so the same text in different controls
+    or reverted text are parsed once. On text update existing child controls are reused for unchanged
+    leading and trailing items and only changed items are recreated, so appending of content
+    (chats, news feeds) creates only controls for appended part.
+*/
 class UIRichContentSystem final : public UISystem, public Observer
 {
 public:
+    /** Counters of rich content rebuilding. */
+    struct Statistics
+    {
+        uint32 rebuildsCount = 0; //!< count of processed rich content components
+        uint32 parsedTextsCount = 0; //!< count of texts parsed from XML
+        uint32 cachedTextsCount = 0; //!< count of texts taken from parsed texts cache
+        uint32 createdItemsCount = 0; //!< count of created child controls
+        uint32 reusedItemsCount = 0; //!< count of child controls kept from previous build
+        int64 rebuildTimeUs = 0; //!< total rebuilding time in microseconds
+        int64 lastRebuildTimeUs = 0; //!< time of last rebuild in microseconds
+    };
+
     UIRichContentSystem();
     ~UIRichContentSystem() override;
 
@@ -30,6 +52,15 @@ public:
 
     void Process(float32 elapsedTime) override;
 
+    /** Return rebuilding counters collected since system creation or last `ResetStatistics` call. */
+    const Statistics& GetStatistics() const;
+    void ResetStatistics();
+
+    /** Set max count of parsed texts in cache, zero disables caching. Cache is cleared when limit is exceeded. */
+    void SetParsedTextsCacheSize(uint32 size);
+    uint32 GetParsedTextsCacheSize() const;
+    void ClearParsedTextsCache();
+
     // Error issues handling signals
     Signal<UIRichContentComponent* /* component */, const String& /* error message */> onTextXMLParsingError;
     Signal<UIRichContentAliasesComponent* /* component */, const String& /* alias name */, const String& /* error message */> onAliasXMLParsingError;
@@ -44,11 +75,16 @@ private:
     void RemoveLink(UIRichContentComponent* component);
     void AddAliases(UIControl* control, UIRichContentAliasesComponent* component);
     void RemoveAliases(UIControl* control, UIRichContentAliasesComponent* component);
+    XMLParserStatus ParseText(RichContentLink* link, Vector<RichContentItem>& items);
+    void UpdateItems(RichContentLink* link, const Vector<RichContentItem>& items);
 
     Vector<std::shared_ptr<RichContentLink>> links;
     Vector<std::shared_ptr<RichContentLink>> appendLinks;
     bool isEditorMode = false;
     bool isDebugDraw = false;
+    uint32 parsedTextsCacheSize = 256;
+    UnorderedMap<String, Vector<RichContentItem>> parsedTexts;
+    Statistics statistics;
 };
 
 inline bool UIRichContentSystem::IsEditorMode() const
@@ -60,4 +96,14 @@ inline bool UIRichContentSystem::IsDebugDraw() const
 {
     return isDebugDraw;
 }
+
+inline const UIRichContentSystem::Statistics& UIRichContentSystem::GetStatistics() const
+{
+    return statistics;
+}
+
+inline uint32 UIRichContentSystem::GetParsedTextsCacheSize() const
+{
+    return parsedTextsCacheSize;
+}
 }
@@ -134,4 +134,40 @@ DAVA_TESTCLASS (UIRichContentTest)
         richControl->RemoveComponent(ca2);
         TEST_VERIFY(richControl->GetComponentCount<UIRichContentAliasesComponent>() == 1);
     }
+
+    DAVA_TEST (IncrementalUpdateTest)
+    {
+        UIRichContentSystem* sys = GetEngineContext()->uiControlSystem->GetSystem<UIRichContentSystem>();
+        UIRichContentComponent* c = richControl->GetOrCreateComponent<UIRichContentComponent>();
+        DVASSERT(c);
+
+        c->SetText("First message<br/>");
+        UpdateRichContentSystem();
+        Vector<UIControl*> firstChildren;
+        for (const RefPtr<UIControl>& child : richControl->GetChildren())
+        {
+            firstChildren.push_back(child.Get());
+        }
+        TEST_VERIFY(firstChildren.size() == 2);
+
+        // Appended content keeps existing controls
+        sys->ResetStatistics();
+        c->SetText("First message<br/>Second message");
+        UpdateRichContentSystem();
+        const List<RefPtr<UIControl>>& children = richControl->GetChildren();
+        TEST_VERIFY(children.size() == 4);
+        TEST_VERIFY(children.front().Get() == firstChildren[0]);
+        TEST_VERIFY((++children.begin())->Get() == firstChildren[1]);
+        TEST_VERIFY(sys->GetStatistics().rebuildsCount == 1);
+        TEST_VERIFY(sys->GetStatistics().reusedItemsCount == 2);
+        TEST_VERIFY(sys->GetStatistics().createdItemsCount == 2);
+
+        // Previous text is taken from cache
+        c->SetText("First message<br/>");
+        UpdateRichContentSystem();
+        TEST_VERIFY(richControl->GetChildren().size() == 2);
+        TEST_VERIFY(richControl->GetChildren().front().Get() == firstChildren[0]);
+        TEST_VERIFY(sys->GetStatistics().cachedTextsCount == 1);
+        TEST_VERIFY(sys->GetStatistics().parsedTextsCount == 1);
+    }
 };
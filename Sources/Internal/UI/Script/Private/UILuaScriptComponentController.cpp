@@ -31,8 +31,8 @@ UILuaScriptComponentController::UILuaScriptComponentController(const FilePath& s
         script->ExecScript(scriptPath);
         loaded = true;
 
-        hasProcess = script->HasGlobalFunction(UILuaScriptComponentDetails::PROCESS_FNAME);
-        hasProcessEvent = script->HasGlobalFunction(UILuaScriptComponentDetails::PROCESS_EVENT_FNAME);
+        processFn = script->GetFunctionRef(UILuaScriptComponentDetails::PROCESS_FNAME);
+        processEventFn = script->GetFunctionRef(UILuaScriptComponentDetails::PROCESS_EVENT_FNAME);
     }
     catch (Exception& e)
     {
@@ -74,17 +74,17 @@ void UILuaScriptComponentController::ParametersChanged(UIScriptComponent* compon
 
 void UILuaScriptComponentController::Process(UIScriptComponent* component, float32 elapsedTime)
 {
-    if (hasProcess)
+    if (processFn.IsValid())
     {
         Reflection controlRef = Reflection::Create(ReflectedObject(component->GetControl()));
         Reflection componentRef = Reflection::Create(ReflectedObject(component));
-        script->ExecFunctionSafe(UILuaScriptComponentDetails::PROCESS_FNAME, controlRef, componentRef, elapsedTime);
+        script->ExecFunctionSafe(processFn, controlRef, componentRef, elapsedTime);
     }
 }
 
 bool UILuaScriptComponentController::ProcessEvent(UIScriptComponent* component, const FastName& eventName, const Vector<Any>& params)
 {
-    if (hasProcessEvent)
+    if (processEventFn.IsValid())
     {
         Reflection controlRef = Reflection::Create(ReflectedObject(component->GetControl()));
         Reflection componentRef = Reflection::Create(ReflectedObject(component));
@@ -2,13 +2,13 @@
 
 #include "FileSystem/FilePath.h"
 #include "Reflection/Reflection.h"
+#include "Scripting/LuaScript.h"
 #include "UI/Script/UIScriptComponentController.h"
 
 namespace DAVA
 {
 class UIContext;
 class UIControl;
-class LuaScript;
 
 /**
     Lua Script component controller implementation.
@@ -20,6 +20,9 @@ class LuaScript;
         - `parametersChanged(controlRef, componentRef)`.
         - `process(controlRef, componentRef, frameDelta)`,
         - `processEvent(controlRef, componentRef, eventName,  ...)` (must return true for avoid sending current event next),
+
+    `process` and `processEvent` are called every frame, so they are resolved once after script is loaded.
+    Other functions are looked up on each call, so script can define them later.
 */
 class UILuaScriptComponentController : public UIScriptComponentController
 {
@@ -40,9 +43,9 @@ public:
     bool ProcessEvent(UIScriptComponent* component, const FastName& eventName, const Vector<Any>& params = Vector<Any>()) override;
 
 private:
-    bool loaded = false;
-    bool hasProcess = false;
-    bool hasProcessEvent = false;
     std::unique_ptr<LuaScript> script;
+    bool loaded = false;
+    LuaFunctionRef processFn;
+    LuaFunctionRef processEventFn;
 };
 }
\ No newline at end of file
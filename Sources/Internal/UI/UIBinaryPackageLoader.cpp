@@ -0,0 +1,641 @@
+#include "UI/UIBinaryPackageLoader.h"
+
+#include "FileSystem/FilePath.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Reflection/ReflectedTypeDB.h"
+#include "UI/Private/UIPackageBinaryFormat.h"
+#include "UI/Styles/UIStyleSheetPropertyDataBase.h"
+#include "UI/UIPackage.h"
+#include "UI/UIPackageLoader.h"
+#include "Utils/MD5.h"
+#include "Utils/UTF8Utils.h"
+
+namespace DAVA
+{
+namespace UIBinaryPackageLoaderDetail
+{
+using namespace UIPackageBinaryFormat;
+
+enum eRootStatus : uint8
+{
+    STATUS_WAIT,
+    STATUS_LOADING,
+    STATUS_LOADED
+};
+
+struct FieldInfo
+{
+    const ReflectedStructure::Field* field = nullptr;
+    const Type* type = nullptr;
+};
+
+const Type* GetFieldType(const ReflectedStructure::Field* field)
+{
+    return field->valueWrapper->GetType(ReflectedObject())->Decay();
+}
+
+bool IsCompiledFromSource(const MD5::MD5Digest& sourceDigest, const FilePath& packagePath)
+{
+    // compiled package may be shipped without its source
+    if (!FileSystem::Instance()->Exists(packagePath))
+    {
+        return true;
+    }
+
+    MD5::MD5Digest digest;
+    MD5::ForFile(packagePath, digest);
+    return digest == sourceDigest;
+}
+}
+
+struct UIBinaryPackageLoader::PackageData
+{
+    struct StyleSheet
+    {
+        Vector<UIStyleSheetSelectorChain> selectorChains;
+        Vector<UIStyleSheetProperty> properties;
+    };
+
+    struct Root
+    {
+        uint32 name;
+        uint8 place;
+        uint32 offset;
+        uint32 size;
+        uint8 status;
+    };
+
+    Vector<uint8> buffer;
+    int32 version = 0;
+    MD5::MD5Digest sourceDigest;
+
+    Vector<String> strings;
+    Vector<FastName> fastNames;
+    Vector<const ReflectedType*> types;
+    Vector<UIBinaryPackageLoaderDetail::FieldInfo> fields;
+    Vector<uint32> imports;
+    Vector<StyleSheet> styleSheets;
+    Vector<Root> roots;
+    const uint8* commands = nullptr;
+
+    bool ReadString(UIPackageBinaryFormat::Reader& reader, uint32& index) const
+    {
+        index = reader.Read<uint32>();
+        if (index < strings.size() || index == UIPackageBinaryFormat::INVALID_INDEX)
+        {
+            return !reader.IsFailed();
+        }
+
+        reader.SetFailed();
+        return false;
+    }
+
+    const FastName& GetFastName(uint32 index)
+    {
+        static const FastName invalidName;
+        if (index == UIPackageBinaryFormat::INVALID_INDEX)
+        {
+            return invalidName;
+        }
+
+        if (!fastNames[index].IsValid())
+        {
+            fastNames[index] = FastName(strings[index]);
+        }
+        return fastNames[index];
+    }
+
+    const String& GetString(uint32 index) const
+    {
+        static const String emptyString;
+        return index == UIPackageBinaryFormat::INVALID_INDEX ? emptyString : strings[index];
+    }
+
+    Any ReadValue(UIPackageBinaryFormat::Reader& reader, const Type* fieldType);
+};
+
+Any UIBinaryPackageLoader::PackageData::ReadValue(UIPackageBinaryFormat::Reader& reader, const Type* fieldType)
+{
+    using namespace UIPackageBinaryFormat;
+
+    uint8 tag = reader.Read<uint8>();
+    switch (tag)
+    {
+    case VALUE_EMPTY:
+        return Any();
+    case VALUE_BOOL:
+        return Any(reader.Read<uint8>() != 0);
+    case VALUE_INT32:
+        return Any(reader.Read<int32>());
+    case VALUE_UINT32:
+        return Any(reader.Read<uint32>());
+    case VALUE_INT64:
+        return Any(reader.Read<int64>());
+    case VALUE_UINT64:
+        return Any(reader.Read<uint64>());
+    case VALUE_FLOAT32:
+        return Any(reader.Read<float32>());
+    case VALUE_VECTOR2:
+    {
+        Vector2 v;
+        v.x = reader.Read<float32>();
+        v.y = reader.Read<float32>();
+        return Any(v);
+    }
+    case VALUE_VECTOR3:
+    {
+        Vector3 v;
+        v.x = reader.Read<float32>();
+        v.y = reader.Read<float32>();
+        v.z = reader.Read<float32>();
+        return Any(v);
+    }
+    case VALUE_VECTOR4:
+    {
+        Vector4 v;
+        v.x = reader.Read<float32>();
+        v.y = reader.Read<float32>();
+        v.z = reader.Read<float32>();
+        v.w = reader.Read<float32>();
+        return Any(v);
+    }
+    case VALUE_COLOR:
+    {
+        Color c;
+        c.r = reader.Read<float32>();
+        c.g = reader.Read<float32>();
+        c.b = reader.Read<float32>();
+        c.a = reader.Read<float32>();
+        return Any(c);
+    }
+    case VALUE_RECT:
+    {
+        Rect r;
+        r.x = reader.Read<float32>();
+        r.y = reader.Read<float32>();
+        r.dx = reader.Read<float32>();
+        r.dy = reader.Read<float32>();
+        return Any(r);
+    }
+    case VALUE_ENUM:
+        return Any(reader.Read<int32>()).ReinterpretCast(fieldType);
+    default:
+        break;
+    }
+
+    uint32 index = reader.Read<uint32>();
+    if (index >= strings.size())
+    {
+        reader.SetFailed();
+        return Any();
+    }
+
+    switch (tag)
+    {
+    case VALUE_FASTNAME:
+        return Any(GetFastName(index));
+    case VALUE_STRING:
+        return Any(strings[index]);
+    case VALUE_WIDESTRING:
+        return Any(UTF8Utils::EncodeToWideString(strings[index]));
+    case VALUE_FILEPATH:
+        return Any(FilePath(strings[index]));
+    default:
+        reader.SetFailed();
+        return Any();
+    }
+}
+
+const String UIBinaryPackageLoader::BINARY_PACKAGE_EXTENSION(".uib");
+
+FilePath UIBinaryPackageLoader::GetBinaryPackagePath(const FilePath& packagePath)
+{
+    return FilePath::CreateWithNewExtension(packagePath, BINARY_PACKAGE_EXTENSION);
+}
+
+UIBinaryPackageLoader::UIBinaryPackageLoader()
+{
+}
+
+UIBinaryPackageLoader::~UIBinaryPackageLoader()
+{
+}
+
+bool UIBinaryPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+{
+    bool isBinaryPath = packagePath.GetExtension() == BINARY_PACKAGE_EXTENSION;
+    FilePath binaryPath = isBinaryPath ? packagePath : GetBinaryPackagePath(packagePath);
+
+    if (FileSystem::Instance()->Exists(binaryPath))
+    {
+        PackageData data;
+        if (!ReadPackage(binaryPath, data))
+        {
+            Logger::Warning("[UIBinaryPackageLoader] Compiled package %s is incompatible and will be ignored", binaryPath.GetStringValue().c_str());
+        }
+        else if (!isBinaryPath && !UIBinaryPackageLoaderDetail::IsCompiledFromSource(data.sourceDigest, packagePath))
+        {
+            Logger::Warning("[UIBinaryPackageLoader] Compiled package %s is outdated and will be ignored", binaryPath.GetStringValue().c_str());
+        }
+        else
+        {
+            return LoadPackage(data, packagePath, builder);
+        }
+    }
+
+    if (isBinaryPath)
+    {
+        return false;
+    }
+
+    return UIPackageLoader().LoadPackage(packagePath, builder);
+}
+
+bool UIBinaryPackageLoader::LoadControlByName(const FastName& name, AbstractUIPackageBuilder* builder)
+{
+    using namespace UIBinaryPackageLoaderDetail;
+
+    if (currentPackage == nullptr)
+    {
+        return false;
+    }
+
+    uint32 count = static_cast<uint32>(currentPackage->roots.size());
+    for (uint32 index = 0; index < count; index++)
+    {
+        PackageData::Root& root = currentPackage->roots[index];
+        if (root.place == AbstractUIPackageBuilder::TO_PROTOTYPES && currentPackage->GetFastName(root.name) == name)
+        {
+            switch (root.status)
+            {
+            case STATUS_WAIT:
+                return LoadRoot(*currentPackage, index, builder);
+
+            case STATUS_LOADED:
+                return true;
+
+            case STATUS_LOADING:
+                return false;
+
+            default:
+                DVASSERT(false);
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool UIBinaryPackageLoader::ReadPackage(const FilePath& binaryPath, PackageData& data) const
+{
+    using namespace UIPackageBinaryFormat;
+    using namespace UIBinaryPackageLoaderDetail;
+
+    if (!FileSystem::Instance()->ReadFileContents(binaryPath, data.buffer))
+    {
+        return false;
+    }
+
+    Reader reader(data.buffer.data(), data.buffer.data() + data.buffer.size());
+    if (reader.Read<uint32>() != SIGNATURE || reader.Read<uint32>() != FORMAT_VERSION)
+    {
+        return false;
+    }
+
+    data.version = reader.Read<int32>();
+    if (data.version < UIPackageLoader::MIN_SUPPORTED_VERSION || UIPackage::CURRENT_VERSION < data.version)
+    {
+        return false;
+    }
+
+    const uint8* sourceDigest = reader.ReadBytes(data.sourceDigest.digest.size());
+    if (sourceDigest == nullptr)
+    {
+        return false;
+    }
+    Memcpy(data.sourceDigest.digest.data(), sourceDigest, data.sourceDigest.digest.size());
+
+    uint32 stringsCount = reader.Read<uint32>();
+    data.strings.reserve(stringsCount);
+    for (uint32 i = 0; i < stringsCount && !reader.IsFailed(); i++)
+    {
+        uint32 length = reader.Read<uint32>();
+        const uint8* bytes = reader.ReadBytes(length);
+        if (bytes != nullptr)
+        {
+            data.strings.emplace_back(reinterpret_cast<const char8*>(bytes), length);
+        }
+    }
+    data.fastNames.resize(data.strings.size());
+
+    uint32 typesCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < typesCount && !reader.IsFailed(); i++)
+    {
+        uint32 name = reader.Read<uint32>();
+        const ReflectedType* type = name < data.strings.size() ? ReflectedTypeDB::GetByPermanentName(data.strings[name]) : nullptr;
+        if (type == nullptr || type->GetStructure() == nullptr)
+        {
+            return false;
+        }
+        data.types.push_back(type);
+    }
+
+    // fields are checked by names, so package is rejected if reflection of controls was changed
+    uint32 fieldsCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < fieldsCount && !reader.IsFailed(); i++)
+    {
+        uint32 type = reader.Read<uint32>();
+        uint32 name = reader.Read<uint32>();
+        uint32 index = reader.Read<uint32>();
+        if (type >= data.types.size() || name >= data.strings.size())
+        {
+            return false;
+        }
+
+        const Vector<std::unique_ptr<ReflectedStructure::Field>>& typeFields = data.types[type]->GetStructure()->fields;
+        if (index >= typeFields.size() || typeFields[index]->name != data.GetFastName(name))
+        {
+            return false;
+        }
+
+        FieldInfo info;
+        info.field = typeFields[index].get();
+        info.type = GetFieldType(info.field);
+        data.fields.push_back(info);
+    }
+
+    const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+    Vector<uint32> styleProperties;
+    uint32 stylePropertiesCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < stylePropertiesCount && !reader.IsFailed(); i++)
+    {
+        uint32 name = reader.Read<uint32>();
+        if (name >= data.strings.size() || !propertyDB->IsValidStyleSheetProperty(data.GetFastName(name)))
+        {
+            return false;
+        }
+        styleProperties.push_back(propertyDB->GetStyleSheetPropertyIndex(data.GetFastName(name)));
+    }
+
+    uint32 importsCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < importsCount && !reader.IsFailed(); i++)
+    {
+        uint32 path = reader.Read<uint32>();
+        if (path >= data.strings.size())
+        {
+            return false;
+        }
+        data.imports.push_back(path);
+    }
+
+    uint32 styleSheetsCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < styleSheetsCount && !reader.IsFailed(); i++)
+    {
+        PackageData::StyleSheet styleSheet;
+
+        uint32 selectorsCount = reader.Read<uint32>();
+        for (uint32 j = 0; j < selectorsCount && !reader.IsFailed(); j++)
+        {
+            uint32 selector = reader.Read<uint32>();
+            if (selector >= data.strings.size())
+            {
+                return false;
+            }
+            styleSheet.selectorChains.push_back(UIStyleSheetSelectorChain(data.strings[selector]));
+        }
+
+        uint32 propertiesCount = reader.Read<uint32>();
+        for (uint32 j = 0; j < propertiesCount && !reader.IsFailed(); j++)
+        {
+            uint32 property = reader.Read<uint32>();
+            bool transition = reader.Read<uint8>() != 0;
+            Interpolation::FuncType transitionFunction = static_cast<Interpolation::FuncType>(reader.Read<int32>());
+            float32 transitionTime = reader.Read<float32>();
+            if (property >= styleProperties.size())
+            {
+                return false;
+            }
+
+            uint32 propertyIndex = styleProperties[property];
+            const UIStyleSheetPropertyDescriptor& descr = propertyDB->GetStyleSheetPropertyByIndex(propertyIndex);
+            if (descr.field == nullptr)
+            {
+                return false;
+            }
+
+            Any value = data.ReadValue(reader, GetFieldType(descr.field));
+            styleSheet.properties.push_back(UIStyleSheetProperty(propertyIndex, value, transition, transitionFunction, transitionTime));
+        }
+
+        data.styleSheets.push_back(std::move(styleSheet));
+    }
+
+    uint32 rootsCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < rootsCount && !reader.IsFailed(); i++)
+    {
+        PackageData::Root root;
+        root.name = reader.Read<uint32>();
+        root.place = reader.Read<uint8>();
+        root.offset = reader.Read<uint32>();
+        root.size = reader.Read<uint32>();
+        root.status = STATUS_WAIT;
+        data.roots.push_back(root);
+    }
+
+    uint32 commandsSize = reader.Read<uint32>();
+    data.commands = reader.ReadBytes(commandsSize);
+
+    if (reader.IsFailed() || !reader.IsEnd())
+    {
+        return false;
+    }
+
+    for (const PackageData::Root& root : data.roots)
+    {
+        if ((root.name >= data.strings.size() && root.name != INVALID_INDEX) || uint64(root.offset) + root.size > commandsSize)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool UIBinaryPackageLoader::LoadPackage(PackageData& data, const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+{
+    builder->BeginPackage(packagePath, data.version);
+
+    for (uint32 path : data.imports)
+    {
+        builder->ProcessImportedPackage(data.strings[path], this);
+    }
+
+    for (const PackageData::StyleSheet& styleSheet : data.styleSheets)
+    {
+        builder->ProcessStyleSheet(styleSheet.selectorChains, styleSheet.properties);
+    }
+
+    // imported packages are loaded by this loader too, so current package is set after imports
+    PackageData* prevPackage = currentPackage;
+    currentPackage = &data;
+
+    bool result = true;
+    uint32 count = static_cast<uint32>(data.roots.size());
+    for (uint32 index = 0; index < count && result; index++)
+    {
+        if (data.roots[index].status == UIBinaryPackageLoaderDetail::STATUS_WAIT)
+        {
+            result = LoadRoot(data, index, builder);
+        }
+    }
+
+    currentPackage = prevPackage;
+
+    builder->EndPackage();
+    return result;
+}
+
+bool UIBinaryPackageLoader::LoadRoot(PackageData& data, uint32 rootIndex, AbstractUIPackageBuilder* builder)
+{
+    using namespace UIPackageBinaryFormat;
+    using namespace UIBinaryPackageLoaderDetail;
+
+    PackageData::Root& root = data.roots[rootIndex];
+    root.status = STATUS_LOADING;
+
+    const uint8* begin = data.commands + root.offset;
+    Reader reader(begin, begin + root.size);
+    while (!reader.IsEnd() && !reader.IsFailed())
+    {
+        eCommand command = static_cast<eCommand>(reader.Read<uint8>());
+        switch (command)
+        {
+        case CMD_BEGIN_CONTROL_WITH_CLASS:
+        {
+            uint32 name = 0, className = 0;
+            if (data.ReadString(reader, name) && data.ReadString(reader, className))
+            {
+                builder->BeginControlWithClass(data.GetFastName(name), data.GetString(className));
+            }
+            break;
+        }
+
+        case CMD_BEGIN_CONTROL_WITH_CUSTOM_CLASS:
+        {
+            uint32 name = 0, customClassName = 0, className = 0;
+            if (data.ReadString(reader, name) && data.ReadString(reader, customClassName) && data.ReadString(reader, className))
+            {
+                builder->BeginControlWithCustomClass(data.GetFastName(name), data.GetString(customClassName), data.GetString(className));
+            }
+            break;
+        }
+
+        case CMD_BEGIN_CONTROL_WITH_PROTOTYPE:
+        {
+            uint32 name = 0, packageName = 0, prototypeName = 0, customClassName = 0;
+            if (data.ReadString(reader, name) && data.ReadString(reader, packageName) && data.ReadString(reader, prototypeName) && data.ReadString(reader, customClassName))
+            {
+                const String* customClass = customClassName == INVALID_INDEX ? nullptr : &data.strings[customClassName];
+                builder->BeginControlWithPrototype(data.GetFastName(name), data.GetString(packageName), data.GetFastName(prototypeName), customClass, this);
+            }
+            break;
+        }
+
+        case CMD_BEGIN_CONTROL_WITH_PATH:
+        {
+            uint32 path = 0;
+            if (data.ReadString(reader, path))
+            {
+                builder->BeginControlWithPath(data.GetString(path));
+            }
+            break;
+        }
+
+        case CMD_END_CONTROL:
+            builder->EndControl(static_cast<AbstractUIPackageBuilder::eControlPlace>(reader.Read<uint8>()));
+            break;
+
+        case CMD_BEGIN_CONTROL_PROPERTIES:
+        {
+            uint32 type = reader.Read<uint32>();
+            if (type < data.types.size())
+            {
+                builder->BeginControlPropertiesSection(data.types[type]->GetPermanentName());
+            }
+            else
+            {
+                reader.SetFailed();
+            }
+            break;
+        }
+
+        case CMD_END_CONTROL_PROPERTIES:
+            builder->EndControlPropertiesSection();
+            break;
+
+        case CMD_BEGIN_COMPONENT_PROPERTIES:
+        {
+            uint32 type = reader.Read<uint32>();
+            uint32 index = reader.Read<uint32>();
+            if (type < data.types.size())
+            {
+                builder->BeginComponentPropertiesSection(data.types[type]->GetType(), index);
+            }
+            else
+            {
+                reader.SetFailed();
+            }
+            break;
+        }
+
+        case CMD_END_COMPONENT_PROPERTIES:
+            builder->EndComponentPropertiesSection();
+            break;
+
+        case CMD_PROPERTY:
+        {
+            uint32 field = reader.Read<uint32>();
+            if (field < data.fields.size())
+            {
+                const FieldInfo& info = data.fields[field];
+                Any value = data.ReadValue(reader, info.type);
+                if (!reader.IsFailed())
+                {
+                    builder->ProcessProperty(*info.field, value);
+                }
+            }
+            else
+            {
+                reader.SetFailed();
+            }
+            break;
+        }
+
+        case CMD_DATA_BINDING:
+        {
+            uint32 fieldName = 0, expression = 0;
+            if (data.ReadString(reader, fieldName) && data.ReadString(reader, expression))
+            {
+                builder->ProcessDataBinding(data.GetString(fieldName), data.GetString(expression), reader.Read<int32>());
+            }
+            break;
+        }
+
+        default:
+            reader.SetFailed();
+            break;
+        }
+    }
+
+    root.status = STATUS_LOADED;
+
+    if (reader.IsFailed())
+    {
+        Logger::Error("[UIBinaryPackageLoader] Compiled package is corrupted");
+        DVASSERT(false);
+        return false;
+    }
+    return true;
+}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "UI/AbstractUIPackageBuilder.h"
+
+namespace DAVA
+{
+class FilePath;
+
+/**
+    Loader of UI packages compiled by `UIPackageCompiler`.
+
+    Controls are created directly from commands of compiled package: yaml is not parsed,
+    reflected fields, types and style sheet properties are resolved once per package and
+    prototypes don't have to be searched in loading queue.
+
+    `LoadPackage` accepts either path of compiled package or path of yaml package. In the latter case
+    compiled package is searched next to yaml (see `GetBinaryPackagePath`) and yaml is loaded
+    by `UIPackageLoader` if there is no compiled package, it was compiled by incompatible engine version
+    or yaml was changed after compilation (compiled package keeps MD5 of its source yaml).
+    Compiled package is used without checks if yaml is absent, e.g. when only compiled packages are shipped.
+    Imported packages are loaded with the same rules, so both formats can be mixed.
+*/
+class UIBinaryPackageLoader : public AbstractUIPackageLoader
+{
+public:
+    static const String BINARY_PACKAGE_EXTENSION;
+
+    /** Return path of compiled package for yaml package `packagePath`. */
+    static FilePath GetBinaryPackagePath(const FilePath& packagePath);
+
+    UIBinaryPackageLoader();
+    ~UIBinaryPackageLoader() override;
+
+    bool LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder) override;
+    bool LoadControlByName(const FastName& name, AbstractUIPackageBuilder* builder) override;
+
+private:
+    struct PackageData;
+
+    bool ReadPackage(const FilePath& binaryPath, PackageData& data) const;
+    bool LoadPackage(PackageData& data, const FilePath& packagePath, AbstractUIPackageBuilder* builder);
+    bool LoadRoot(PackageData& data, uint32 rootIndex, AbstractUIPackageBuilder* builder);
+
+    PackageData* currentPackage = nullptr;
+};
+}
@@ -0,0 +1,145 @@
+#include <Base/BaseTypes.h>
+#include <FileSystem/FileSystem.h>
+#include <Time/SystemTimer.h>
+#include <UI/DefaultUIPackageBuilder.h>
+#include <UI/Layouts/UILinearLayoutComponent.h>
+#include <UI/UIBinaryPackageLoader.h>
+#include <UI/UIControl.h>
+#include <UI/UIControlBackground.h>
+#include <UI/UIControlPackageContext.h>
+#include <UI/UIPackage.h>
+#include <UI/UIPackageCompiler.h>
+#include <UI/UIPackageLoader.h>
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIBinaryPackageLoaderTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("UIBinaryPackageLoader.cpp")
+    DECLARE_COVERED_FILES("UIPackageCompiler.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    const FilePath yamlPath = "~res:/UI/UIBinaryPackageTest.yaml";
+    const FilePath binaryPath = "~doc:/UIBinaryPackageTest.uib";
+
+    UIBinaryPackageLoaderTest()
+    {
+        UIPackageCompiler().CompilePackage(yamlPath, binaryPath);
+    }
+
+    ~UIBinaryPackageLoaderTest()
+    {
+        FileSystem::Instance()->DeleteFile(binaryPath);
+    }
+
+    DAVA_TEST (LoadCompiledPackageTest)
+    {
+        TEST_VERIFY(FileSystem::Instance()->Exists(binaryPath));
+
+        DefaultUIPackageBuilder yamlBuilder;
+        TEST_VERIFY(UIPackageLoader().LoadPackage(yamlPath, &yamlBuilder));
+        DefaultUIPackageBuilder binaryBuilder;
+        TEST_VERIFY(UIBinaryPackageLoader().LoadPackage(binaryPath, &binaryBuilder));
+
+        UIPackage* yamlPackage = yamlBuilder.GetPackage();
+        UIPackage* binaryPackage = binaryBuilder.GetPackage();
+        TEST_VERIFY(binaryPackage->GetPrototypes().size() == yamlPackage->GetPrototypes().size());
+        TEST_VERIFY(binaryPackage->GetControls().size() == yamlPackage->GetControls().size());
+        TEST_VERIFY(binaryPackage->GetControlPackageContext()->GetSortedStyleSheets().size() == yamlPackage->GetControlPackageContext()->GetSortedStyleSheets().size());
+
+        UIControl* screen = binaryPackage->GetControl("Screen");
+        TEST_VERIFY(screen != nullptr);
+        TEST_VERIFY(screen->GetSize() == Vector2(1024.f, 768.f));
+
+        UILinearLayoutComponent* layout = screen->GetComponent<UILinearLayoutComponent>();
+        TEST_VERIFY(layout != nullptr);
+        TEST_VERIFY(layout->GetOrientation() == UILinearLayoutComponent::TOP_DOWN);
+        TEST_VERIFY(FLOAT_EQUAL(layout->GetSpacing(), 10.f));
+
+        // prototype which is used before its declaration
+        UIControl* okButton = screen->FindByName("OkButton");
+        TEST_VERIFY(okButton != nullptr);
+        TEST_VERIFY(okButton->GetSize() == Vector2(200.f, 64.f));
+
+        UIControl* icon = okButton->FindByPath("Icon");
+        TEST_VERIFY(icon != nullptr);
+        TEST_VERIFY(icon->GetPosition() == Vector2(8.f, 8.f));
+
+        UIControlBackground* bg = okButton->GetComponent<UIControlBackground>();
+        TEST_VERIFY(bg != nullptr);
+        TEST_VERIFY(bg->GetDrawType() == UIControlBackground::DRAW_FILL);
+        TEST_VERIFY(bg->GetColor() == Color(0.f, 1.f, 0.f, 1.f));
+    }
+
+    DAVA_TEST (FallbackToYamlTest)
+    {
+        // there is no compiled package next to yaml
+        DefaultUIPackageBuilder builder;
+        TEST_VERIFY(UIBinaryPackageLoader().LoadPackage("~res:/UI/UITextTest.yaml", &builder));
+        TEST_VERIFY(builder.GetPackage()->GetControl("NewText") != nullptr);
+    }
+
+    DAVA_TEST (OutdatedPackageTest)
+    {
+        const FilePath sourcePath = "~doc:/UIBinaryPackageOutdatedTest.yaml";
+        const FilePath compiledPath = UIBinaryPackageLoader::GetBinaryPackagePath(sourcePath);
+
+        FileSystem* fs = FileSystem::Instance();
+        TEST_VERIFY(fs->CopyFile(yamlPath, sourcePath, true));
+        TEST_VERIFY(UIPackageCompiler().CompilePackage(sourcePath, compiledPath));
+
+        {
+            DefaultUIPackageBuilder builder;
+            TEST_VERIFY(UIBinaryPackageLoader().LoadPackage(sourcePath, &builder));
+            TEST_VERIFY(builder.GetPackage()->GetControl("Screen") != nullptr);
+        }
+
+        // yaml is edited after compilation, so compiled package is ignored
+        TEST_VERIFY(fs->CopyFile("~res:/UI/UITextTest.yaml", sourcePath, true));
+        {
+            DefaultUIPackageBuilder builder;
+            TEST_VERIFY(UIBinaryPackageLoader().LoadPackage(sourcePath, &builder));
+            TEST_VERIFY(builder.GetPackage()->GetControl("Screen") == nullptr);
+            TEST_VERIFY(builder.GetPackage()->GetControl("NewText") != nullptr);
+        }
+
+        // compiled package without source is loaded as is
+        fs->DeleteFile(sourcePath);
+        {
+            DefaultUIPackageBuilder builder;
+            TEST_VERIFY(UIBinaryPackageLoader().LoadPackage(sourcePath, &builder));
+            TEST_VERIFY(builder.GetPackage()->GetControl("Screen") != nullptr);
+        }
+
+        fs->DeleteFile(compiledPath);
+    }
+
+    DAVA_TEST (LoadingPerformanceTest)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        const int32 count = 200;
+
+        int64 begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            DefaultUIPackageBuilder builder;
+            UIPackageLoader().LoadPackage(yamlPath, &builder);
+        }
+        Logger::Info("yaml package: %lld ms", SystemTimer::GetMs() - begin);
+
+        begin = SystemTimer::GetMs();
+        for (int32 i = 0; i < count; ++i)
+        {
+            DefaultUIPackageBuilder builder;
+            UIBinaryPackageLoader().LoadPackage(binaryPath, &builder);
+        }
+        Logger::Info("compiled package: %lld ms", SystemTimer::GetMs() - begin);
+#endif
+    }
+};
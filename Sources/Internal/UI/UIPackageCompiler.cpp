@@ -0,0 +1,633 @@
+#include "UI/UIPackageCompiler.h"
+
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FilePath.h"
+#include "Logger/Logger.h"
+#include "Reflection/ReflectedTypeDB.h"
+#include "UI/DefaultUIPackageBuilder.h"
+#include "UI/Private/UIPackageBinaryFormat.h"
+#include "UI/Styles/UIStyleSheetPropertyDataBase.h"
+#include "UI/UIPackageLoader.h"
+#include "UI/UIPackagesCache.h"
+#include "Utils/MD5.h"
+#include "Utils/UTF8Utils.h"
+
+namespace DAVA
+{
+namespace UIPackageCompilerDetail
+{
+using namespace UIPackageBinaryFormat;
+
+/**
+    Builder which records all calls made by `UIPackageLoader` and passes them to real builder.
+    Real builder is needed to know types of controls created from prototypes and paths.
+    Recorder is also passed as loader to real builder, so prototypes which are loaded on demand are recorded too.
+*/
+class PackageRecorder : public AbstractUIPackageBuilder, public AbstractUIPackageLoader
+{
+public:
+    PackageRecorder(AbstractUIPackageBuilder* builder_, AbstractUIPackageLoader* sourceLoader_)
+        : builder(builder_)
+        , sourceLoader(sourceLoader_)
+    {
+        frames.emplace_back();
+    }
+
+    bool IsValid() const
+    {
+        return valid;
+    }
+
+    void Save(const MD5::MD5Digest& sourceDigest, Vector<uint8>& buffer) const;
+
+    // AbstractUIPackageLoader
+    bool LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* packageBuilder) override
+    {
+        return sourceLoader->LoadPackage(packagePath, packageBuilder);
+    }
+
+    bool LoadControlByName(const FastName& name, AbstractUIPackageBuilder* /*packageBuilder*/) override
+    {
+        return sourceLoader->LoadControlByName(name, this);
+    }
+
+    // AbstractUIPackageBuilder
+    void BeginPackage(const FilePath& packagePath, int32 version) override
+    {
+        packageVersion = version;
+        builder->BeginPackage(packagePath, version);
+    }
+
+    void EndPackage() override
+    {
+        builder->EndPackage();
+    }
+
+    bool ProcessImportedPackage(const String& packagePath, AbstractUIPackageLoader* loader) override
+    {
+        imports.push_back(InternString(packagePath));
+        return builder->ProcessImportedPackage(packagePath, loader);
+    }
+
+    void ProcessStyleSheet(const Vector<UIStyleSheetSelectorChain>& selectorChains, const Vector<UIStyleSheetProperty>& properties) override;
+
+    const ReflectedType* BeginControlWithClass(const FastName& controlName, const String& className) override
+    {
+        Writer writer = BeginControl(controlName);
+        writer.Write(CMD_BEGIN_CONTROL_WITH_CLASS);
+        writer.Write(InternString(controlName));
+        writer.Write(InternString(className));
+        return builder->BeginControlWithClass(controlName, className);
+    }
+
+    const ReflectedType* BeginControlWithCustomClass(const FastName& controlName, const String& customClassName, const String& className) override
+    {
+        Writer writer = BeginControl(controlName);
+        writer.Write(CMD_BEGIN_CONTROL_WITH_CUSTOM_CLASS);
+        writer.Write(InternString(controlName));
+        writer.Write(InternString(customClassName));
+        writer.Write(InternString(className));
+        return builder->BeginControlWithCustomClass(controlName, customClassName, className);
+    }
+
+    const ReflectedType* BeginControlWithPrototype(const FastName& controlName, const String& packageName, const FastName& prototypeName, const String* customClassName, AbstractUIPackageLoader* /*loader*/) override
+    {
+        Writer writer = BeginControl(controlName);
+        writer.Write(CMD_BEGIN_CONTROL_WITH_PROTOTYPE);
+        writer.Write(InternString(controlName));
+        writer.Write(InternString(packageName));
+        writer.Write(InternString(prototypeName));
+        writer.Write(customClassName != nullptr ? InternString(*customClassName) : INVALID_INDEX);
+
+        // prototype can be loaded on demand, it is recorded as separate root
+        frames.emplace_back();
+        const ReflectedType* type = builder->BeginControlWithPrototype(controlName, packageName, prototypeName, customClassName, this);
+        DVASSERT(frames.back().depth == 0);
+        frames.pop_back();
+        return type;
+    }
+
+    const ReflectedType* BeginControlWithPath(const String& pathName) override
+    {
+        Writer writer = BeginControl(FastName());
+        writer.Write(CMD_BEGIN_CONTROL_WITH_PATH);
+        writer.Write(InternString(pathName));
+        return builder->BeginControlWithPath(pathName);
+    }
+
+    const ReflectedType* BeginUnknownControl(const FastName& controlName, const YamlNode* node) override
+    {
+        Logger::Error("[UIPackageCompiler] Unknown control %s", controlName.c_str());
+        valid = false;
+        BeginControl(controlName);
+        return builder->BeginUnknownControl(controlName, node);
+    }
+
+    void EndControl(eControlPlace controlPlace) override;
+
+    void BeginControlPropertiesSection(const String& name) override
+    {
+        const ReflectedType* type = ReflectedTypeDB::GetByPermanentName(name);
+        DVASSERT(type != nullptr);
+
+        // loader opens section for each property, consecutive sections of the same type are merged
+        if (pendingSectionEnd && sectionType == type)
+        {
+            pendingSectionEnd = false;
+        }
+        else
+        {
+            Writer writer = GetWriter();
+            writer.Write(CMD_BEGIN_CONTROL_PROPERTIES);
+            writer.Write(InternType(type));
+            sectionType = type;
+        }
+        builder->BeginControlPropertiesSection(name);
+    }
+
+    void EndControlPropertiesSection() override
+    {
+        pendingSectionEnd = true;
+        builder->EndControlPropertiesSection();
+    }
+
+    const ReflectedType* BeginComponentPropertiesSection(const Type* componentType, uint32 componentIndex) override
+    {
+        Writer writer = GetWriter();
+        writer.Write(CMD_BEGIN_COMPONENT_PROPERTIES);
+        writer.Write(InternType(ReflectedTypeDB::GetByType(componentType)));
+        writer.Write(componentIndex);
+
+        sectionType = builder->BeginComponentPropertiesSection(componentType, componentIndex);
+        return sectionType;
+    }
+
+    void EndComponentPropertiesSection() override
+    {
+        Writer writer = GetWriter();
+        writer.Write(CMD_END_COMPONENT_PROPERTIES);
+        sectionType = nullptr;
+        builder->EndComponentPropertiesSection();
+    }
+
+    void ProcessProperty(const ReflectedStructure::Field& field, const Any& value) override
+    {
+        Writer writer = GetWriter();
+        writer.Write(CMD_PROPERTY);
+        writer.Write(InternField(field));
+        WriteValue(writer, value);
+        builder->ProcessProperty(field, value);
+    }
+
+    void ProcessDataBinding(const String& fieldName, const String& expression, int32 bindingMode) override
+    {
+        Writer writer = GetWriter();
+        writer.Write(CMD_DATA_BINDING);
+        writer.Write(InternString(fieldName));
+        writer.Write(InternString(expression));
+        writer.Write(bindingMode);
+        builder->ProcessDataBinding(fieldName, expression, bindingMode);
+    }
+
+private:
+    struct Root
+    {
+        uint32 name;
+        uint8 place;
+        uint32 offset;
+        uint32 size;
+    };
+
+    struct Frame
+    {
+        Vector<uint8> commands;
+        uint32 name = INVALID_INDEX;
+        int32 depth = 0;
+    };
+
+    struct FieldRecord
+    {
+        uint32 type;
+        uint32 name;
+        uint32 index;
+    };
+
+    struct StyleSheetRecord
+    {
+        Vector<uint32> selectors;
+        Vector<uint8> properties;
+        uint32 propertiesCount;
+    };
+
+    Writer GetWriter();
+    Writer BeginControl(const FastName& controlName);
+    void WriteValue(Writer& writer, const Any& value);
+
+    uint32 InternString(const String& str);
+    uint32 InternString(const FastName& name);
+    uint32 InternType(const ReflectedType* type);
+    uint32 InternField(const ReflectedStructure::Field& field);
+    uint32 InternStyleProperty(uint32 propertyIndex);
+
+    AbstractUIPackageBuilder* builder = nullptr;
+    AbstractUIPackageLoader* sourceLoader = nullptr;
+
+    int32 packageVersion = 0;
+    bool valid = true;
+
+    Vector<String> strings;
+    UnorderedMap<String, uint32> stringIndices;
+    Vector<uint32> types;
+    Map<const ReflectedType*, uint32> typeIndices;
+    Vector<FieldRecord> fields;
+    Map<const ReflectedStructure::Field*, uint32> fieldIndices;
+    Vector<uint32> styleProperties;
+    Map<uint32, uint32> stylePropertyIndices;
+    Vector<uint32> imports;
+    Vector<StyleSheetRecord> styleSheets;
+
+    Vector<Root> roots;
+    Vector<uint8> commands;
+    Vector<Frame> frames;
+
+    const ReflectedType* sectionType = nullptr;
+    bool pendingSectionEnd = false;
+};
+
+Writer PackageRecorder::GetWriter()
+{
+    Frame& frame = frames.back();
+    if (pendingSectionEnd)
+    {
+        pendingSectionEnd = false;
+        sectionType = nullptr;
+        Writer(frame.commands).Write(CMD_END_CONTROL_PROPERTIES);
+    }
+    return Writer(frame.commands);
+}
+
+Writer PackageRecorder::BeginControl(const FastName& controlName)
+{
+    Writer writer = GetWriter();
+    Frame& frame = frames.back();
+    if (frame.depth == 0)
+    {
+        frame.name = InternString(controlName);
+    }
+    frame.depth++;
+    return writer;
+}
+
+void PackageRecorder::EndControl(eControlPlace controlPlace)
+{
+    Writer writer = GetWriter();
+    writer.Write(CMD_END_CONTROL);
+    writer.Write(static_cast<uint8>(controlPlace));
+
+    Frame& frame = frames.back();
+    DVASSERT(frame.depth > 0);
+    frame.depth--;
+    if (frame.depth == 0)
+    {
+        Root root;
+        root.name = frame.name;
+        root.place = static_cast<uint8>(controlPlace);
+        root.offset = static_cast<uint32>(commands.size());
+        root.size = static_cast<uint32>(frame.commands.size());
+        roots.push_back(root);
+
+        commands.insert(commands.end(), frame.commands.begin(), frame.commands.end());
+        frame.commands.clear();
+    }
+
+    builder->EndControl(controlPlace);
+}
+
+void PackageRecorder::ProcessStyleSheet(const Vector<UIStyleSheetSelectorChain>& selectorChains, const Vector<UIStyleSheetProperty>& properties)
+{
+    const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+
+    StyleSheetRecord record;
+    for (const UIStyleSheetSelectorChain& chain : selectorChains)
+    {
+        record.selectors.push_back(InternString(chain.ToString()));
+    }
+
+    Writer writer(record.properties);
+    for (const UIStyleSheetProperty& property : properties)
+    {
+        writer.Write(InternStyleProperty(property.propertyIndex));
+        writer.Write(static_cast<uint8>(property.transition ? 1 : 0));
+        writer.Write(static_cast<int32>(property.transitionFunction));
+        writer.Write(property.transitionTime);
+        WriteValue(writer, property.value);
+    }
+    record.propertiesCount = static_cast<uint32>(properties.size());
+    styleSheets.push_back(std::move(record));
+
+    builder->ProcessStyleSheet(selectorChains, properties);
+}
+
+void PackageRecorder::WriteValue(Writer& writer, const Any& value)
+{
+    if (value.IsEmpty())
+    {
+        writer.Write(VALUE_EMPTY);
+        return;
+    }
+
+    const Type* type = value.GetType();
+    if (type == Type::Instance<bool>())
+    {
+        writer.Write(VALUE_BOOL);
+        writer.Write(static_cast<uint8>(value.Get<bool>() ? 1 : 0));
+    }
+    else if (type == Type::Instance<int32>())
+    {
+        writer.Write(VALUE_INT32);
+        writer.Write(value.Get<int32>());
+    }
+    else if (type == Type::Instance<uint32>())
+    {
+        writer.Write(VALUE_UINT32);
+        writer.Write(value.Get<uint32>());
+    }
+    else if (type == Type::Instance<int64>())
+    {
+        writer.Write(VALUE_INT64);
+        writer.Write(value.Get<int64>());
+    }
+    else if (type == Type::Instance<uint64>())
+    {
+        writer.Write(VALUE_UINT64);
+        writer.Write(value.Get<uint64>());
+    }
+    else if (type == Type::Instance<float32>())
+    {
+        writer.Write(VALUE_FLOAT32);
+        writer.Write(value.Get<float32>());
+    }
+    else if (type == Type::Instance<FastName>())
+    {
+        writer.Write(VALUE_FASTNAME);
+        writer.Write(InternString(value.Get<FastName>()));
+    }
+    else if (type == Type::Instance<String>())
+    {
+        writer.Write(VALUE_STRING);
+        writer.Write(InternString(value.Get<String>()));
+    }
+    else if (type == Type::Instance<WideString>())
+    {
+        writer.Write(VALUE_WIDESTRING);
+        writer.Write(InternString(UTF8Utils::EncodeToUTF8(value.Get<WideString>())));
+    }
+    else if (type == Type::Instance<Vector2>())
+    {
+        const Vector2& v = value.Get<Vector2>();
+        writer.Write(VALUE_VECTOR2);
+        writer.Write(v.x);
+        writer.Write(v.y);
+    }
+    else if (type == Type::Instance<Vector3>())
+    {
+        const Vector3& v = value.Get<Vector3>();
+        writer.Write(VALUE_VECTOR3);
+        writer.Write(v.x);
+        writer.Write(v.y);
+        writer.Write(v.z);
+    }
+    else if (type == Type::Instance<Vector4>())
+    {
+        const Vector4& v = value.Get<Vector4>();
+        writer.Write(VALUE_VECTOR4);
+        writer.Write(v.x);
+        writer.Write(v.y);
+        writer.Write(v.z);
+        writer.Write(v.w);
+    }
+    else if (type == Type::Instance<Color>())
+    {
+        const Color& c = value.Get<Color>();
+        writer.Write(VALUE_COLOR);
+        writer.Write(c.r);
+        writer.Write(c.g);
+        writer.Write(c.b);
+        writer.Write(c.a);
+    }
+    else if (type == Type::Instance<Rect>())
+    {
+        const Rect& r = value.Get<Rect>();
+        writer.Write(VALUE_RECT);
+        writer.Write(r.x);
+        writer.Write(r.y);
+        writer.Write(r.dx);
+        writer.Write(r.dy);
+    }
+    else if (type == Type::Instance<FilePath>())
+    {
+        const FilePath& path = value.Get<FilePath>();
+        writer.Write(VALUE_FILEPATH);
+        writer.Write(InternString(path.IsEmpty() ? String() : path.GetFrameworkPath()));
+    }
+    else if (type->IsEnum() && type->GetSize() == sizeof(int32))
+    {
+        int32 v = 0;
+        Memcpy(&v, value.GetData(), sizeof(int32));
+        writer.Write(VALUE_ENUM);
+        writer.Write(v);
+    }
+    else
+    {
+        Logger::Error("[UIPackageCompiler] Unsupported value type %s", type->GetName());
+        valid = false;
+        writer.Write(VALUE_EMPTY);
+    }
+}
+
+uint32 PackageRecorder::InternString(const String& str)
+{
+    auto it = stringIndices.find(str);
+    if (it != stringIndices.end())
+    {
+        return it->second;
+    }
+
+    uint32 index = static_cast<uint32>(strings.size());
+    strings.push_back(str);
+    stringIndices.emplace(str, index);
+    return index;
+}
+
+uint32 PackageRecorder::InternString(const FastName& name)
+{
+    return name.IsValid() ? InternString(String(name.c_str())) : INVALID_INDEX;
+}
+
+uint32 PackageRecorder::InternType(const ReflectedType* type)
+{
+    DVASSERT(type != nullptr);
+
+    auto it = typeIndices.find(type);
+    if (it != typeIndices.end())
+    {
+        return it->second;
+    }
+
+    uint32 index = static_cast<uint32>(types.size());
+    types.push_back(InternString(type->GetPermanentName()));
+    typeIndices.emplace(type, index);
+    return index;
+}
+
+uint32 PackageRecorder::InternField(const ReflectedStructure::Field& field)
+{
+    auto it = fieldIndices.find(&field);
+    if (it != fieldIndices.end())
+    {
+        return it->second;
+    }
+
+    DVASSERT(sectionType != nullptr && sectionType->GetStructure() != nullptr);
+    const Vector<std::unique_ptr<ReflectedStructure::Field>>& typeFields = sectionType->GetStructure()->fields;
+    auto fieldIt = std::find_if(typeFields.begin(), typeFields.end(), [&field](const std::unique_ptr<ReflectedStructure::Field>& f) {
+        return f.get() == &field;
+    });
+    DVASSERT(fieldIt != typeFields.end());
+
+    FieldRecord record;
+    record.type = InternType(sectionType);
+    record.name = InternString(String(field.name.c_str()));
+    record.index = static_cast<uint32>(std::distance(typeFields.begin(), fieldIt));
+
+    uint32 index = static_cast<uint32>(fields.size());
+    fields.push_back(record);
+    fieldIndices.emplace(&field, index);
+    return index;
+}
+
+uint32 PackageRecorder::InternStyleProperty(uint32 propertyIndex)
+{
+    auto it = stylePropertyIndices.find(propertyIndex);
+    if (it != stylePropertyIndices.end())
+    {
+        return it->second;
+    }
+
+    const UIStyleSheetPropertyDescriptor& descr = UIStyleSheetPropertyDataBase::Instance()->GetStyleSheetPropertyByIndex(propertyIndex);
+
+    uint32 index = static_cast<uint32>(styleProperties.size());
+    styleProperties.push_back(InternString(descr.GetFullName()));
+    stylePropertyIndices.emplace(propertyIndex, index);
+    return index;
+}
+
+void PackageRecorder::Save(const MD5::MD5Digest& sourceDigest, Vector<uint8>& buffer) const
+{
+    DVASSERT(frames.size() == 1 && frames.back().depth == 0);
+
+    Writer writer(buffer);
+    writer.Write(SIGNATURE);
+    writer.Write(FORMAT_VERSION);
+    writer.Write(packageVersion);
+    writer.WriteBytes(sourceDigest.digest.data(), sourceDigest.digest.size());
+
+    writer.Write(static_cast<uint32>(strings.size()));
+    for (const String& str : strings)
+    {
+        writer.Write(static_cast<uint32>(str.size()));
+        writer.WriteBytes(str.data(), str.size());
+    }
+
+    writer.Write(static_cast<uint32>(types.size()));
+    for (uint32 type : types)
+    {
+        writer.Write(type);
+    }
+
+    writer.Write(static_cast<uint32>(fields.size()));
+    for (const FieldRecord& field : fields)
+    {
+        writer.Write(field.type);
+        writer.Write(field.name);
+        writer.Write(field.index);
+    }
+
+    writer.Write(static_cast<uint32>(styleProperties.size()));
+    for (uint32 property : styleProperties)
+    {
+        writer.Write(property);
+    }
+
+    writer.Write(static_cast<uint32>(imports.size()));
+    for (uint32 import : imports)
+    {
+        writer.Write(import);
+    }
+
+    writer.Write(static_cast<uint32>(styleSheets.size()));
+    for (const StyleSheetRecord& styleSheet : styleSheets)
+    {
+        writer.Write(static_cast<uint32>(styleSheet.selectors.size()));
+        for (uint32 selector : styleSheet.selectors)
+        {
+            writer.Write(selector);
+        }
+        writer.Write(styleSheet.propertiesCount);
+        writer.WriteBytes(styleSheet.properties.data(), styleSheet.properties.size());
+    }
+
+    writer.Write(static_cast<uint32>(roots.size()));
+    for (const Root& root : roots)
+    {
+        writer.Write(root.name);
+        writer.Write(root.place);
+        writer.Write(root.offset);
+        writer.Write(root.size);
+    }
+
+    writer.Write(static_cast<uint32>(commands.size()));
+    writer.WriteBytes(commands.data(), commands.size());
+}
+}
+
+UIPackageCompiler::UIPackageCompiler()
+    : packagesCache(MakeRef<UIPackagesCache>())
+{
+}
+
+UIPackageCompiler::~UIPackageCompiler()
+{
+}
+
+bool UIPackageCompiler::CompilePackage(const FilePath& packagePath, const FilePath& binaryPath)
+{
+    using namespace UIPackageCompilerDetail;
+
+    DefaultUIPackageBuilder builder(packagesCache);
+    UIPackageLoader loader;
+    PackageRecorder recorder(&builder, &loader);
+
+    if (!loader.LoadPackage(packagePath, &recorder) || !recorder.IsValid())
+    {
+        Logger::Error("[UIPackageCompiler] Can't compile package %s", packagePath.GetStringValue().c_str());
+        return false;
+    }
+
+    MD5::MD5Digest sourceDigest;
+    MD5::ForFile(packagePath, sourceDigest);
+
+    Vector<uint8> buffer;
+    recorder.Save(sourceDigest, buffer);
+
+    ScopedPtr<File> file(File::Create(binaryPath, File::CREATE | File::WRITE));
+    if (!file || file->Write(buffer.data(), static_cast<uint32>(buffer.size())) != buffer.size())
+    {
+        Logger::Error("[UIPackageCompiler] Can't write %s", binaryPath.GetStringValue().c_str());
+        return false;
+    }
+
+    return true;
+}
+}
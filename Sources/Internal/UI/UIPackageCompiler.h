@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/RefPtr.h"
+
+namespace DAVA
+{
+class FilePath;
+class UIPackagesCache;
+
+/**
+    Offline compiler of yaml UI packages into binary format loaded by `UIBinaryPackageLoader`.
+
+    Package is loaded by `UIPackageLoader` into `DefaultUIPackageBuilder` and all builder calls are recorded:
+    legacy properties are converted, reflected fields are stored as indices in their types, strings are interned
+    and prototypes from the same package are ordered before their first usage.
+    Custom data is used only by editor and is not stored, packages with unknown controls can't be compiled.
+
+    Compiler creates controls, so it should be used when engine is initialized (e.g. in console mode of tools).
+    Imported packages are cached between `CompilePackage` calls.
+*/
+class UIPackageCompiler final
+{
+public:
+    UIPackageCompiler();
+    ~UIPackageCompiler();
+
+    /** Compile yaml package `packagePath` into `binaryPath`. Return false and log error if package can't be compiled. */
+    bool CompilePackage(const FilePath& packagePath, const FilePath& binaryPath);
+
+private:
+    RefPtr<UIPackagesCache> packagesCache;
+};
+}